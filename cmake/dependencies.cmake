@@ -55,6 +55,18 @@ message(VERBOSE "FIND_LIBRARY_USE_LIB64_PATHS: " ${FIND_LIBRARY_USE_LIB64_PATHS}
 # Load direct physical package dependencies first, so we fail early.
 find_package(Protobuf REQUIRED)
 find_package(CUDAToolkit REQUIRED) # Required by Morpheus. Fail early if we don't have it.
+find_package(ZLIB REQUIRED) # Used to compress rotated output files
+
+if(MORPHEUS_USE_CUFILE)
+  # cuFile (GPUDirect Storage)
+  # - Ships with the CUDA toolkit
+  # =====
+  find_library(CUFILE_LIBRARY cufile HINTS "${CUDAToolkit_LIBRARY_DIR}")
+
+  if(NOT CUFILE_LIBRARY)
+    message(FATAL_ERROR "MORPHEUS_USE_CUFILE is set but libcufile was not found")
+  endif()
+endif()
 
 if(MORPHEUS_BUILD_BENCHMARKS)
   # google benchmark
@@ -112,6 +124,32 @@ include(deps/Configure_neo)
 set(CUDF_VERSION "${RAPIDS_VERSION}" CACHE STRING "Which version of cuDF to use")
 include(deps/Configure_cudf)
 
+if(MORPHEUS_USE_NVCOMP)
+  # nvCOMP
+  # - Expects package to pre-exist in the build environment, it is installed alongside cuDF
+  # =====
+  rapids_find_package(nvcomp REQUIRED
+          GLOBAL_TARGETS      nvcomp::nvcomp
+          BUILD_EXPORT_SET    ${PROJECT_NAME}-exports
+          INSTALL_EXPORT_SET  ${PROJECT_NAME}-exports
+          FIND_ARGS
+          CONFIG
+          )
+endif()
+
+if(MORPHEUS_USE_UCX)
+  # UCX
+  # - Expects package to pre-exist in the build environment, built with CUDA support for GPUDirect transfers
+  # =====
+  rapids_find_package(ucx REQUIRED
+          GLOBAL_TARGETS      ucx::ucp
+          BUILD_EXPORT_SET    ${PROJECT_NAME}-exports
+          INSTALL_EXPORT_SET  ${PROJECT_NAME}-exports
+          FIND_ARGS
+          CONFIG
+          )
+endif()
+
 # Triton-client
 # =====
 set(TRITONCLIENT_VERSION "${RAPIDS_VERSION}" CACHE STRING "Which version of TritonClient to use")
@@ -14,10 +14,23 @@
 
 add_library(cuda_utils
     SHARED
+      ${MORPHEUS_LIB_ROOT}/src/io/async_file_writer.cpp
+      ${MORPHEUS_LIB_ROOT}/src/io/device_file_sink.cpp
+      ${MORPHEUS_LIB_ROOT}/src/io/gpu_compressed_sink.cu
+      ${MORPHEUS_LIB_ROOT}/src/io/mapped_file.cpp
+      ${MORPHEUS_LIB_ROOT}/src/io/ucx_transport.cpp
       ${MORPHEUS_LIB_ROOT}/src/objects/dev_mem_info.cpp
       ${MORPHEUS_LIB_ROOT}/src/objects/table_info.cpp
+      ${MORPHEUS_LIB_ROOT}/src/objects/tensor_cast_view.cpp
+      ${MORPHEUS_LIB_ROOT}/src/objects/tensor_map.cpp
       ${MORPHEUS_LIB_ROOT}/src/objects/tensor_object.cpp
+      ${MORPHEUS_LIB_ROOT}/src/utilities/cuda_graph.cpp
+      ${MORPHEUS_LIB_ROOT}/src/utilities/device_affinity.cpp
+      ${MORPHEUS_LIB_ROOT}/src/utilities/device_annotation.cpp
+      ${MORPHEUS_LIB_ROOT}/src/utilities/host_memory.cpp
+      ${MORPHEUS_LIB_ROOT}/src/utilities/json_util.cu
       ${MORPHEUS_LIB_ROOT}/src/utilities/matx_util.cu
+      ${MORPHEUS_LIB_ROOT}/src/utilities/pipeline_drain.cpp
       ${MORPHEUS_LIB_ROOT}/src/utilities/tensor_util.cpp
       ${MORPHEUS_LIB_ROOT}/src/utilities/type_util_detail.cpp
       ${MORPHEUS_LIB_ROOT}/src/utilities/type_util.cu
@@ -32,10 +45,54 @@ target_link_libraries(cuda_utils
     PUBLIC
       neo::pyneo
       matx::matx
+      CUDA::cufft
       cudf::cudf
       Python3::NumPy
 )
 
+if (MORPHEUS_USE_CUFILE)
+  target_link_libraries(cuda_utils
+      PRIVATE
+        ${CUFILE_LIBRARY}
+  )
+
+  target_compile_definitions(cuda_utils
+      PRIVATE
+        MORPHEUS_USE_CUFILE
+  )
+endif()
+
+if (MORPHEUS_USE_NVCOMP)
+  target_link_libraries(cuda_utils
+      PRIVATE
+        nvcomp::nvcomp
+  )
+
+  target_compile_definitions(cuda_utils
+      PUBLIC
+        MORPHEUS_USE_NVCOMP
+  )
+endif()
+
+if (MORPHEUS_USE_UCX)
+  target_link_libraries(cuda_utils
+      PRIVATE
+        ucx::ucp
+  )
+
+  target_compile_definitions(cuda_utils
+      PUBLIC
+        MORPHEUS_USE_UCX
+  )
+endif()
+
+if (MORPHEUS_ENABLE_DEVICE_ANNOTATIONS)
+  target_compile_definitions(cuda_utils
+      PUBLIC
+        MORPHEUS_ENABLE_DEVICE_ANNOTATIONS
+  )
+endif()
+
 set_target_properties(cuda_utils
     PROPERTIES OUTPUT_NAME ${PROJECT_NAME}_utils
 )
@@ -29,28 +29,58 @@ add_library(morpheus
     ${MORPHEUS_LIB_ROOT}/src/messages/multi_inference_nlp.cpp
     ${MORPHEUS_LIB_ROOT}/src/messages/multi_response.cpp
     ${MORPHEUS_LIB_ROOT}/src/messages/multi_response_probs.cpp
+    ${MORPHEUS_LIB_ROOT}/src/objects/cpp_data_table.cpp
+    ${MORPHEUS_LIB_ROOT}/src/objects/feature_scaler.cpp
     ${MORPHEUS_LIB_ROOT}/src/objects/fiber_queue.cpp
     ${MORPHEUS_LIB_ROOT}/src/objects/file_types.cpp
+    ${MORPHEUS_LIB_ROOT}/src/objects/forest_model.cpp
+    ${MORPHEUS_LIB_ROOT}/src/objects/kafka_message_decoder.cpp
+    ${MORPHEUS_LIB_ROOT}/src/objects/load_generator.cpp
     ${MORPHEUS_LIB_ROOT}/src/objects/wrapped_tensor.cpp
     ${MORPHEUS_LIB_ROOT}/src/objects/python_data_table.cpp
     ${MORPHEUS_LIB_ROOT}/src/objects/rmm_tensor.cpp
     ${MORPHEUS_LIB_ROOT}/src/objects/table_info.cpp
     ${MORPHEUS_LIB_ROOT}/src/objects/tensor.cpp
+    ${MORPHEUS_LIB_ROOT}/src/objects/triton_shared_memory_pool.cpp
+    ${MORPHEUS_LIB_ROOT}/src/objects/view_data_table.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/add_classification.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/add_scores.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/admission.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/appshield_source.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/buffer.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/cloud_trail_source.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/coalesce.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/deserialize.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/drop_null.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/file_source.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/filter_detection.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/forest_inference.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/fused.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/generate_viz_frames.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/kafka_source.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/load_generator_source.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/monitor.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/multi_file_source.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/prefilter.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/preprocess_ae.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/preprocess_fil.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/preprocess_nlp.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/repartition.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/serialize.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/timeseries.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/triton_inference.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/ucx_source.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/validation.cpp
     ${MORPHEUS_LIB_ROOT}/src/stages/write_to_file.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/write_to_kafka.cpp
+    ${MORPHEUS_LIB_ROOT}/src/stages/write_to_ucx.cpp
     ${MORPHEUS_LIB_ROOT}/src/utilities/cudf_util.cpp
     ${MORPHEUS_LIB_ROOT}/src/utilities/cupy_util.cpp
+    ${MORPHEUS_LIB_ROOT}/src/utilities/device_memory.cpp
+    ${MORPHEUS_LIB_ROOT}/src/utilities/stage_metrics.cpp
     ${MORPHEUS_LIB_ROOT}/src/utilities/string_util.cpp
     ${MORPHEUS_LIB_ROOT}/src/utilities/table_util.cpp
+    ${MORPHEUS_LIB_ROOT}/src/utilities/vocabulary_cache.cpp
 )
 
 add_library(${PROJECT_NAME}::morpheus ALIAS morpheus)
@@ -58,8 +88,11 @@ add_library(${PROJECT_NAME}::morpheus ALIAS morpheus)
 target_link_libraries(morpheus
     PUBLIC
       ${cudf_helpers_target}
+      TritonClient::grpcclient_static
       TritonClient::httpclient_static
       RDKAFKA::RDKAFKA
+    PRIVATE
+      ZLIB::ZLIB
 )
 
 target_include_directories(morpheus
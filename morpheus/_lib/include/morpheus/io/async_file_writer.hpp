@@ -0,0 +1,121 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <boost/fiber/buffered_channel.hpp>
+
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** FileFlushPolicy**********************************/
+/**
+ * @brief When `AsyncFileWriter` hands buffered data to the OS.
+ */
+enum class FileFlushPolicy
+{
+    // Only full blocks are written until the writer is closed. Fewest and largest writes
+    None,
+    // Buffered data is also written whenever the queue runs empty, so readers of the file see every message soon
+    // after it was queued
+    Flush,
+    // Same as `Flush`, followed by an fdatasync so the data survives a crash of the host
+    FSync,
+};
+
+/**
+ * @brief Parses "none", "flush" or "fsync". Throws `std::invalid_argument` for anything else.
+ */
+FileFlushPolicy parse_file_flush_policy(const std::string &policy);
+
+/****** AsyncFileWriter**********************************/
+/**
+ * @brief Appends to a file from a dedicated thread. Callers queue already formatted data with `write`, which only
+ * blocks while `queue_size` writes are pending, and the writer thread coalesces the queued data into page aligned
+ * blocks of `block_bytes`. A disk stall therefore only backs up the caller once the queue is full.
+ *
+ * Errors raised by the writer thread are rethrown by the next call to `write` or `close`.
+ */
+class AsyncFileWriter
+{
+  public:
+    /**
+     * @brief Blocks are aligned to, and rounded up to a multiple of, this many bytes.
+     */
+    static constexpr std::size_t Alignment = 4096;
+
+    static constexpr std::size_t DefaultBlockBytes = 4 * 1024 * 1024;
+
+    /**
+     * @brief Opens `filename`, truncating it unless `append` is set, and starts the writer thread. Throws
+     * `std::runtime_error` if the file cannot be opened.
+     */
+    AsyncFileWriter(const std::string &filename,
+                    bool append,
+                    std::size_t queue_size,
+                    FileFlushPolicy policy  = FileFlushPolicy::Flush,
+                    std::size_t block_bytes = DefaultBlockBytes);
+
+    /**
+     * @brief Closes the writer, logging rather than throwing any pending error.
+     */
+    ~AsyncFileWriter();
+
+    AsyncFileWriter(const AsyncFileWriter &) = delete;
+    AsyncFileWriter &operator=(const AsyncFileWriter &) = delete;
+
+    /**
+     * @brief Queues `data` to be written, blocking while the queue is full.
+     */
+    void write(std::string data);
+
+    /**
+     * @brief Writes everything still queued, joins the writer thread and closes the file. Safe to call more than once.
+     */
+    void close();
+
+  private:
+    void run();
+
+    void append(const std::string &data);
+
+    void write_block();
+
+    void rethrow_error();
+
+    const std::string m_filename;
+    const FileFlushPolicy m_policy;
+    const std::size_t m_block_bytes;
+
+    int m_fd{-1};
+
+    std::unique_ptr<char, void (*)(void *)> m_block;
+    std::size_t m_block_used{0};
+
+    boost::fibers::buffered_channel<std::string> m_queue;
+    std::thread m_thread;
+
+    std::mutex m_error_mutex;
+    std::exception_ptr m_error{nullptr};
+};
+}  // namespace morpheus
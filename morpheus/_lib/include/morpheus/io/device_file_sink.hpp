@@ -0,0 +1,108 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cudf/io/data_sink.hpp>
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** DeviceFileSink***********************************/
+/**
+ * @brief cuDF data sink writing straight to a file descriptor, without any buffering on the host. Device writes go
+ * through cuFile (GPUDirect Storage) when the library is built with `MORPHEUS_USE_CUFILE` and the file can be
+ * registered with the driver. Otherwise they are copied out in blocks of `BounceBytes` through a pair of pinned
+ * buffers, the copy of a block overlapping the write of the previous one.
+ */
+#pragma GCC visibility push(default)
+class DeviceFileSink : public cudf::io::data_sink
+{
+  public:
+    static constexpr std::size_t BounceBytes = 4 * 1024 * 1024;
+
+    /**
+     * @brief Opens `filename`, truncating it unless `append` is set. Throws `std::runtime_error` if the file cannot be
+     * opened.
+     */
+    DeviceFileSink(const std::string &filename, bool append);
+
+    ~DeviceFileSink() override;
+
+    DeviceFileSink(const DeviceFileSink &) = delete;
+    DeviceFileSink &operator=(const DeviceFileSink &) = delete;
+
+    void host_write(void const *data, size_t size) override;
+
+    bool supports_device_write() const override
+    {
+        return true;
+    }
+
+    bool is_device_write_preferred(size_t size) const override
+    {
+        return true;
+    }
+
+    /**
+     * @brief Writes `size` bytes of `gpu_data` once the work already enqueued on `stream` has completed. Returns once
+     * the data has been handed to the OS.
+     */
+    void device_write(void const *gpu_data, size_t size, rmm::cuda_stream_view stream) override;
+
+    /**
+     * @brief Nothing is buffered, every write has already been handed to the OS.
+     */
+    void flush() override {}
+
+    size_t bytes_written() override
+    {
+        return m_bytes_written;
+    }
+
+    /**
+     * @brief Size of the file, including the contents it had when opened in append mode.
+     */
+    std::size_t file_size() const
+    {
+        return m_offset;
+    }
+
+    /**
+     * @brief Closes the file. Safe to call more than once.
+     */
+    void close();
+
+  private:
+    void write_all(const void *data, std::size_t size);
+
+    const std::string m_filename;
+
+    int m_fd{-1};
+    std::size_t m_offset{0};
+    std::size_t m_bytes_written{0};
+
+    // `CUfileHandle_t`, null when device writes use the bounce buffers
+    void *m_cufile_handle{nullptr};
+};
+
+#pragma GCC visibility pop
+}  // namespace morpheus
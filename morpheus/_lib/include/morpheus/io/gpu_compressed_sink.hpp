@@ -0,0 +1,126 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cudf/io/data_sink.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** GpuCompressionCodec******************************/
+/**
+ * @brief Codecs `GpuCompressedSink` can write. Both produce a sequence of independent members (frames), which the
+ * standard tools decompress as a single stream, so compressed output can be appended to.
+ */
+enum class GpuCompressionCodec
+{
+    // Concatenated gzip members, one per chunk of input, readable by `gzip -d` and python's `gzip` module
+    Gzip,
+    // Concatenated zstd frames, one per chunk of input
+    Zstd,
+};
+
+/**
+ * @brief Parses "gzip" or "zstd". Throws `std::invalid_argument` for anything else.
+ */
+GpuCompressionCodec parse_gpu_compression_codec(const std::string &codec);
+
+/****** GpuCompressedSink********************************/
+/**
+ * @brief cuDF data sink compressing everything written to it on the device with nvCOMP. Device writes, used by the
+ * CSV writer and `df_to_json`, are staged on the device, host writes are copied up first. `flush` compresses the
+ * staged bytes in chunks of `ChunkBytes` and copies only the compressed bytes back to the host, where they are
+ * collected until `release` is called.
+ *
+ * Only functional when the library is built with `MORPHEUS_USE_NVCOMP`, see `Available`. Otherwise the constructor
+ * throws `std::runtime_error`.
+ */
+#pragma GCC visibility push(default)
+class GpuCompressedSink : public cudf::io::data_sink
+{
+  public:
+#ifdef MORPHEUS_USE_NVCOMP
+    static constexpr bool Available = true;
+#else
+    static constexpr bool Available = false;
+#endif
+
+    /**
+     * @brief Uncompressed bytes per member (frame). The largest chunk nvCOMP's deflate implementation accepts.
+     */
+    static constexpr std::size_t ChunkBytes = 1 << 16;
+
+    explicit GpuCompressedSink(GpuCompressionCodec codec, rmm::cuda_stream_view stream = rmm::cuda_stream_per_thread);
+
+    void host_write(void const *data, size_t size) override;
+
+    bool supports_device_write() const override
+    {
+        return true;
+    }
+
+    bool is_device_write_preferred(size_t size) const override
+    {
+        return true;
+    }
+
+    /**
+     * @brief Copies `size` bytes of `gpu_data` to the staging buffer. Returns once the copy, which is ordered after
+     * the work already enqueued on `stream`, has completed.
+     */
+    void device_write(void const *gpu_data, size_t size, rmm::cuda_stream_view stream) override;
+
+    /**
+     * @brief Compresses the staged bytes, appending the result to the output returned by `release`.
+     */
+    void flush() override;
+
+    /**
+     * @brief Uncompressed bytes written to the sink so far.
+     */
+    size_t bytes_written() override
+    {
+        return m_bytes_written;
+    }
+
+    /**
+     * @brief Returns the compressed output of every call to `flush` since the last call to `release`. Bytes which
+     * have been written but not flushed stay staged.
+     */
+    std::string release();
+
+  private:
+    void compress(const uint8_t *data, std::size_t bytes);
+
+    GpuCompressionCodec m_codec;
+    rmm::cuda_stream_view m_stream;
+
+    rmm::device_buffer m_staged;
+    std::size_t m_bytes_written{0};
+
+    std::string m_output;
+};
+
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,54 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** MappedFile***************************************/
+/**
+ * @brief Read only mapping of a whole file. Readers given `data()` read straight from the page cache, so a file read
+ * repeatedly is only read from storage once, and no intermediate host buffer is filled. The mapping is advised for
+ * sequential access so the kernel reads ahead of the reader.
+ */
+class MappedFile
+{
+  public:
+    /**
+     * @brief Maps `filename`. Throws `std::runtime_error` if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string &filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    /**
+     * @brief Start of the mapping, `nullptr` for an empty file.
+     */
+    const char *data() const;
+
+    std::size_t size() const;
+
+  private:
+    void *m_data{nullptr};
+    std::size_t m_size{0};
+};
+}  // namespace morpheus
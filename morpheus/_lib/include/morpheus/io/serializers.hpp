@@ -19,18 +19,30 @@
 
 #include <morpheus/objects/table_info.hpp>
 
+#include <cudf/io/data_sink.hpp>
+
 #include <ostream>
 #include <string>
 #include <vector>
 
 namespace morpheus {
 
+#pragma GCC visibility push(default)
 std::string df_to_csv(const TableInfo& tbl, bool include_header);
 
 void df_to_csv(const TableInfo& tbl, std::ostream& out_stream, bool include_header);
 
+/**
+ * @brief Writes `tbl` to `sink`. Sinks supporting device writes receive the formatted output while it is still on the
+ * device, see `GpuCompressedSink`.
+ */
+void df_to_csv(const TableInfo& tbl, cudf::io::data_sink& sink, bool include_header);
+
 std::string df_to_json(const TableInfo& tbl);
 
 void df_to_json(const TableInfo& tbl, std::ostream& out_stream);
 
+void df_to_json(const TableInfo& tbl, cudf::io::data_sink& sink);
+#pragma GCC visibility pop
+
 }  // namespace morpheus
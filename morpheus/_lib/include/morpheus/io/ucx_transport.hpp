@@ -0,0 +1,196 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cudf/io/types.hpp>
+#include <cudf/table/table_view.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Same as the UCX handle typedefs, so the UCX headers are only needed by the implementation
+struct ucp_context;
+struct ucp_worker;
+struct ucp_ep;
+struct ucp_listener;
+
+namespace morpheus {
+// Defined by the implementation, the UCX callbacks
+struct UcxSender__Callbacks;
+struct UcxReceiver__Callbacks;
+
+/****** Component public implementations *******************/
+/****** UcxFrameHeader*************************************/
+/**
+ * @brief Describes one table sent between pipelines. The columns travel separately, as the single device buffer
+ * produced by `cudf::pack`: every column buffer and null mask back to back. `metadata` is the host side description of
+ * that layout, also produced by `cudf::pack`. A header with `end` set carries no table and tells the receiver the
+ * sender is done.
+ */
+struct UcxFrameHeader
+{
+    bool end{false};
+    uint64_t payload_tag{0};
+    uint64_t payload_bytes{0};
+    int32_t num_indices{0};
+    std::vector<std::string> column_names;  // Index columns first
+    std::vector<uint8_t> metadata;
+
+    std::vector<uint8_t> encode() const;
+
+    /**
+     * @brief Throws `std::runtime_error` when `data` is not a header written by this version.
+     */
+    static UcxFrameHeader decode(const uint8_t *data, std::size_t size);
+};
+
+/****** UcxReceivedTable***********************************/
+struct UcxReceivedTable
+{
+    cudf::io::table_with_metadata table;
+    int num_indices{0};
+};
+
+/****** UcxSender******************************************/
+/**
+ * @brief Sends tables to a `UcxReceiver`, possibly on another host, over whichever transports UCX selects: NVLink
+ * between devices of the same host, RDMA with GPUDirect between hosts, TCP otherwise. The columns are packed into one
+ * device buffer which UCX reads directly, no copy is made on the host when GPUDirect is available. Transports are
+ * selected with the UCX environment variables, e.g. `UCX_TLS`.
+ *
+ * Owns its UCX worker, every call must come from the same thread. Waiting on a transfer progresses the worker and
+ * yields the current fiber in between. Only functional when the library is built with `MORPHEUS_USE_UCX`, see
+ * `Available`. Otherwise the constructor throws `std::runtime_error`.
+ */
+#pragma GCC visibility push(default)
+class UcxSender
+{
+  public:
+#ifdef MORPHEUS_USE_UCX
+    static constexpr bool Available = true;
+#else
+    static constexpr bool Available = false;
+#endif
+
+    /**
+     * @brief Connects to the receiver listening on `host`:`port`.
+     */
+    UcxSender(const std::string &host, uint16_t port);
+
+    /**
+     * @brief Closes the connection without telling the receiver, which treats it as a failed sender, unless `close`
+     * was called.
+     */
+    ~UcxSender();
+
+    UcxSender(const UcxSender &)            = delete;
+    UcxSender &operator=(const UcxSender &) = delete;
+
+    /**
+     * @brief Sends the rows of `table`, index columns first. Returns once the packed buffer has been handed over and
+     * can be released. Throws `std::runtime_error` when the connection failed.
+     */
+    void send(const cudf::table_view &table, const std::vector<std::string> &column_names, int num_indices);
+
+    /**
+     * @brief Tells the receiver no more tables follow and closes the connection.
+     */
+    void close();
+
+    std::size_t bytes_sent() const;
+
+  private:
+    friend struct UcxSender__Callbacks;
+
+    void send_buffer(const void *data, std::size_t bytes, uint64_t tag, bool on_device);
+
+    ucp_context *m_context{nullptr};
+    ucp_worker *m_worker{nullptr};
+    ucp_ep *m_ep{nullptr};
+
+    uint64_t m_sender_id{0};
+    uint32_t m_sequence{0};
+    std::size_t m_bytes_sent{0};
+
+    bool m_failed{false};  // Set by the endpoint error handler
+};
+
+/****** UcxReceiver****************************************/
+/**
+ * @brief Listens on `port` for `num_senders` `UcxSender`s and receives their tables in the order each sender sent
+ * them. Tables of different senders are interleaved in arrival order. Received columns are copied out of the packed
+ * buffer, on the device, into a table of their own.
+ *
+ * Same threading rules and availability as `UcxSender`.
+ */
+class UcxReceiver
+{
+  public:
+#ifdef MORPHEUS_USE_UCX
+    static constexpr bool Available = true;
+#else
+    static constexpr bool Available = false;
+#endif
+
+    /**
+     * @param address local address to listen on, "0.0.0.0" listens on every interface
+     */
+    UcxReceiver(const std::string &address, uint16_t port, std::size_t num_senders = 1);
+
+    ~UcxReceiver();
+
+    UcxReceiver(const UcxReceiver &)            = delete;
+    UcxReceiver &operator=(const UcxReceiver &) = delete;
+
+    /**
+     * @brief Waits up to `timeout` for the next table from any sender. Returns nullopt when none arrived in time, or
+     * once every sender has closed, see `done`. Throws `std::runtime_error` when a sender disconnected without
+     * closing.
+     */
+    std::optional<UcxReceivedTable> receive(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Whether `num_senders` senders have closed.
+     */
+    bool done() const;
+
+    std::size_t bytes_received() const;
+
+  private:
+    friend struct UcxReceiver__Callbacks;
+
+    void receive_buffer(void *data, std::size_t bytes, uint64_t tag, bool on_device);
+
+    ucp_context *m_context{nullptr};
+    ucp_worker *m_worker{nullptr};
+    ucp_listener *m_listener{nullptr};
+
+    // Only touched by the worker's callbacks and `receive`, all on the same thread
+    std::vector<ucp_ep *> m_endpoints;
+    std::size_t m_num_senders;
+    std::size_t m_closed_senders{0};
+    std::size_t m_disconnected_senders{0};
+    std::size_t m_bytes_received{0};
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
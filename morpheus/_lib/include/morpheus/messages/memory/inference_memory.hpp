@@ -18,10 +18,10 @@
 #pragma once
 
 #include <morpheus/objects/tensor.hpp>
+#include <morpheus/objects/tensor_map.hpp>
 #include <morpheus/objects/tensor_object.hpp>
 
 #include <cstddef>
-#include <map>
 #include <string>
 
 namespace morpheus {
@@ -35,7 +35,7 @@ class InferenceMemory
     InferenceMemory(size_t count);
 
     std::size_t count{0};
-    std::map<std::string, TensorObject> inputs;
+    TensorMap inputs;
 
     /**
      * TODO(Documentation)
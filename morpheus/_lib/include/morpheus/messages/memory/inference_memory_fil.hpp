@@ -37,6 +37,10 @@ namespace morpheus {
 class InferenceMemoryFIL : public InferenceMemory
 {
   public:
+    // Slots of the tensors in `inputs`, fixed by the constructor
+    static constexpr std::size_t Input0Slot = 0;
+    static constexpr std::size_t SeqIdsSlot = 1;
+
     InferenceMemoryFIL(size_t count, TensorObject input__0, TensorObject seq_ids);
 
     /**
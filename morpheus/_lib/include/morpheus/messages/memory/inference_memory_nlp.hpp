@@ -35,6 +35,11 @@ namespace morpheus {
 class InferenceMemoryNLP : public InferenceMemory
 {
   public:
+    // Slots of the tensors in `inputs`, fixed by the constructor
+    static constexpr std::size_t InputIdsSlot  = 0;
+    static constexpr std::size_t InputMaskSlot = 1;
+    static constexpr std::size_t SeqIdsSlot    = 2;
+
     InferenceMemoryNLP(std::size_t count, TensorObject input_ids, TensorObject input_mask, TensorObject seq_ids);
 
     /**
@@ -18,6 +18,7 @@
 #pragma once
 
 #include <morpheus/objects/tensor.hpp>
+#include <morpheus/objects/tensor_map.hpp>
 
 #include <pybind11/pytypes.h>
 #include <cudf/io/types.hpp>
@@ -37,7 +38,7 @@ class ResponseMemory
     ResponseMemory(size_t count);
 
     size_t count{0};
-    std::map<std::string, TensorObject> outputs;
+    TensorMap outputs;
 
     /**
      * TODO(Documentation)
@@ -39,6 +39,9 @@ namespace morpheus {
 class ResponseMemoryProbs : public ResponseMemory
 {
   public:
+    // Slot of the tensor in `outputs`, fixed by the constructor
+    static constexpr std::size_t ProbsSlot = 0;
+
     ResponseMemoryProbs(size_t count, TensorObject probs);
 
     /**
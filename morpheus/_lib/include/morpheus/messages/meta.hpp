@@ -22,11 +22,92 @@
 #include <cudf/io/types.hpp>
 #include <pybind11/pybind11.h>
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace morpheus {
     /****** Component public implementations ******************/
+    /****** MessageCompletion**********************************/
+    /**
+     * @brief Held by every message created from the same source data. The source treats its data as processed once
+     * the last holder releases the completion, e.g. when the message reaches the end of the pipeline or is dropped by
+     * a filter. Sinks which finish asynchronously keep a reference until they are done, and call `fail` when they
+     * could not finish so the source does not treat the data as processed.
+     */
+#pragma GCC visibility push(default)
+    class MessageCompletion {
+    public:
+        virtual ~MessageCompletion() = default;
+
+        /**
+         * @brief Marks the data as not processed. Cannot be undone.
+         */
+        void fail();
+
+        bool failed() const;
+
+    private:
+        std::atomic<bool> m_failed{false};
+    };
+
+    /****** MessageTraceSpan***********************************/
+    /**
+     * @brief Time a traced message spent in one stage. Times are wall clock nanoseconds since the epoch, comparable
+     * with the timestamps of the source.
+     */
+    struct MessageTraceSpan {
+        std::string stage;
+        int64_t enter_ns{0};
+        int64_t exit_ns{0};
+    };
+
+    /****** MessageTrace***************************************/
+    /**
+     * @brief Records when the data of a message was produced and the time spent in each C++ stage it passed through.
+     * Shared by every message created from the same source data, including slices and inference messages. Sources
+     * only attach a trace to one in `sample_interval` messages, so untraced messages pay no more than a null check.
+     */
+    class MessageTrace {
+    public:
+        explicit MessageTrace(int64_t source_time_ns);
+
+        /**
+         * @brief Returns a new trace for one in every `sample_interval` calls and nullptr otherwise, or always when
+         * sampling is disabled.
+         */
+        static std::shared_ptr<MessageTrace> sample(int64_t source_time_ns);
+
+        /**
+         * @brief Traces one in every `interval` source messages. Zero, the default, disables tracing.
+         */
+        static void set_sample_interval(uint32_t interval);
+
+        static uint32_t sample_interval();
+
+        /**
+         * @brief Wall clock time in nanoseconds since the epoch.
+         */
+        static int64_t now_ns();
+
+        int64_t source_time_ns() const;
+
+        void record(const std::string &stage, int64_t enter_ns, int64_t exit_ns);
+
+        std::vector<MessageTraceSpan> spans() const;
+
+    private:
+        int64_t m_source_time_ns;
+
+        mutable std::mutex m_mutex;
+        std::vector<MessageTraceSpan> m_spans;
+    };
+#pragma GCC visibility pop
+
     /****** MessageMeta****************************************/
     /**
      * TODO(Documentation)
@@ -60,15 +141,73 @@ namespace morpheus {
         static std::shared_ptr<MessageMeta> create_from_cpp(cudf::io::table_with_metadata &&data_table,
                                                             int index_col_count = 0);
 
-    private:
-        MessageMeta(std::shared_ptr<IDataTable> data);
+        /**
+         * @brief Creates a message over the rows and columns of `view` without copying them. The table the view was
+         * taken from is kept alive, and is only copied if a Python stage asks for the DataFrame or columns are
+         * inserted. Does not need the GIL.
+         */
+        static std::shared_ptr<MessageMeta> create_from_view(TableInfo view);
 
         /**
-         * TODO(Documentation)
+         * @brief Device bytes kept alive by this message. A slice counts the whole table it was taken from. Messages
+         * created from Python count 0.
+         */
+        std::size_t device_bytes() const;
+
+        /**
+         * @brief Device bytes of every table created in C++ which is still alive, and the number of those tables.
+         */
+        static std::size_t live_device_bytes();
+
+        static std::size_t live_tables();
+
+        /**
+         * @brief Copies the rows of `meta` into a table of its own when it is a slice holding fewer than
+         * `min_fraction` of the rows of the table it was taken from, so the rest of that table can be freed. Returns
+         * `meta` unchanged otherwise, or when `min_fraction` is 0.
+         */
+        static std::shared_ptr<MessageMeta> compact_if_sparse(const std::shared_ptr<MessageMeta> &meta,
+                                                              double min_fraction);
+
+        /**
+         * @brief Appends the `column_names` columns which are not already in `data_table`, every row set to zero.
+         * Sources call this before `create_from_cpp` with the output columns of their pipeline, taken from
+         * `Config.output_columns`, so the columns are part of the table from the start: the table is not rebuilt and
+         * `set_meta` never changes the schema.
+         */
+        static void reserve_columns(cudf::io::table_with_metadata &data_table,
+                                    const std::vector<std::string> &column_names,
+                                    const std::vector<TypeId> &column_types);
+
+        /**
+         * @brief Keeps `completion` alive for the lifetime of this message.
+         */
+        void add_completion(std::shared_ptr<MessageCompletion> completion);
+
+        /**
+         * @brief Adds the completions of `other`. Stages which replace a message with a new MessageMeta, copying its
+         * rows, call this so the source data is not treated as processed when the original message is released.
+         */
+        void inherit_completions(const MessageMeta &other);
+
+        const std::vector<std::shared_ptr<MessageCompletion>> &completions() const;
+
+        /**
+         * @brief Attaches the trace of a sampled message. Also inherited by `inherit_completions`.
+         */
+        void set_trace(std::shared_ptr<MessageTrace> trace);
+
+        /**
+         * @brief The trace of this message, nullptr when it was not sampled.
          */
-        static pybind11::object cpp_to_py(cudf::io::table_with_metadata &&table, int index_col_count = 0);
+        const std::shared_ptr<MessageTrace> &trace() const;
+
+    private:
+        MessageMeta(std::shared_ptr<IDataTable> data);
 
         std::shared_ptr<IDataTable> m_data;
+        std::vector<std::shared_ptr<MessageCompletion>> m_completions;
+        std::shared_ptr<MessageTrace> m_trace;
     };
 
 
@@ -96,6 +235,13 @@ namespace morpheus {
          * TODO(Documentation)
          */
         static pybind11::object get_data_frame(MessageMeta& self);
+
+        /**
+         * @brief The source time and spans of the trace as a dict, None when the message was not sampled.
+         */
+        static pybind11::object get_trace(MessageMeta& self);
+
+        static std::size_t device_bytes(MessageMeta& self);
     };
 #pragma GCC visibility pop
 }
\ No newline at end of file
@@ -35,6 +35,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace morpheus {
@@ -78,11 +79,26 @@ class MultiMessage
      */
     void set_meta(const std::vector<std::string> &column_names, const std::vector<TensorObject> &tensors);
 
+    /**
+     * @brief Writes column `tensor_columns[i]` of the 2D `tensor` to `column_names[i]`. Same as calling
+     * `set_meta(column_names, tensors)` with a slice per column, without creating the slices. Every column is
+     * written by a single kernel launch.
+     */
+    void set_meta(const std::vector<std::string> &column_names,
+                  const TensorObject &tensor,
+                  const std::vector<std::size_t> &tensor_columns);
+
     /**
      * TODO(Documentation)
      */
     std::shared_ptr<MultiMessage> get_slice(size_t start, size_t stop) const;
 
+    /**
+     * @brief Creates one slice for each [start, stop) pair of `ranges`, all held in a single allocation. The returned
+     * pointers share ownership of that allocation, which is released along with the last of the slices.
+     */
+    std::vector<std::shared_ptr<MultiMessage>> get_slices(const std::vector<std::pair<size_t, size_t>> &ranges) const;
+
   protected:
     // This internal function is used to allow virtual overriding while `get_slice` allows for hiding of base class.
     // This allows users to avoid casting every class after calling get_slice but still supports calling `get_slice`
@@ -105,6 +121,31 @@ class MultiMessage
      * TODO(Documentation)
      */
     virtual std::shared_ptr<MultiMessage> internal_get_slice(size_t start, size_t stop) const;
+
+    /**
+     * @brief Builds the slice for rows [start, stop) by value. Derived classes hide this with a version returning
+     * their own type, which their `internal_get_slice` and `get_slices` are built on.
+     */
+    MultiMessage make_slice(size_t start, size_t stop) const;
+
+    /**
+     * @brief Moves `slices` into a single shared allocation and returns an aliasing pointer to each of them.
+     */
+    template <typename MessageT>
+    static std::vector<std::shared_ptr<MessageT>> share_slices(std::vector<MessageT> slices)
+    {
+        auto owner = std::make_shared<std::vector<MessageT>>(std::move(slices));
+
+        std::vector<std::shared_ptr<MessageT>> shared;
+        shared.reserve(owner->size());
+
+        for (auto &slice : *owner)
+        {
+            shared.emplace_back(owner, &slice);
+        }
+
+        return shared;
+    }
 };
 
 /****** MultiMessageInterfaceProxy**************************/
@@ -29,6 +29,8 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace morpheus {
 /****** Component public implementations********************/
@@ -56,6 +58,11 @@ class MultiInferenceMessage : public MultiMessage
      */
     const TensorObject get_input(const std::string &name) const;
 
+    /**
+     * @brief Returns the input stored in `slot` of `memory->inputs`, skipping the name lookup.
+     */
+    const TensorObject get_input(std::size_t slot) const;
+
     /**
      * TODO(Documentation)
      */
@@ -66,11 +73,22 @@ class MultiInferenceMessage : public MultiMessage
      */
     std::shared_ptr<MultiInferenceMessage> get_slice(std::size_t start, std::size_t stop) const;
 
+    /**
+     * @brief Same as `MultiMessage::get_slices`, returning this type.
+     */
+    std::vector<std::shared_ptr<MultiInferenceMessage>> get_slices(
+        const std::vector<std::pair<std::size_t, std::size_t>> &ranges) const;
+
   protected:
     /**
      * TODO(Documentation)
      */
     std::shared_ptr<MultiMessage> internal_get_slice(std::size_t start, std::size_t stop) const override;
+
+    /**
+     * @brief Builds the slice for rows [start, stop) by value.
+     */
+    MultiInferenceMessage make_slice(std::size_t start, std::size_t stop) const;
 };
 
 /****** MultiInferenceMessageInterfaceProxy****************/
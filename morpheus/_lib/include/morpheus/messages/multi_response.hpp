@@ -32,6 +32,8 @@
 #include <cstddef>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace morpheus {
 /****** Component public implementations *******************/
@@ -64,22 +66,48 @@ class MultiResponseMessage : public MultiMessage
      */
     const TensorObject get_output(const std::string &name) const;
 
+    /**
+     * @brief Returns the output stored in `slot` of `memory->outputs`, skipping the name lookup.
+     */
+    TensorObject get_output(std::size_t slot);
+
+    /**
+     * @brief Returns the output stored in `slot` of `memory->outputs`, skipping the name lookup.
+     */
+    const TensorObject get_output(std::size_t slot) const;
+
     /**
      * TODO(Documentation)
      */
     const void set_output(const std::string &name, const TensorObject &value);
 
+    /**
+     * @brief Copies `value` into the output stored in `slot` of `memory->outputs`, skipping the name lookup.
+     */
+    const void set_output(std::size_t slot, const TensorObject &value);
+
     /**
      * TODO(Documentation)
      * TODO(Devin) Should we be shadowing MultiMessage::get_slice?
      */
     std::shared_ptr<MultiResponseMessage> get_slice(std::size_t start, std::size_t stop) const;
 
+    /**
+     * @brief Same as `MultiMessage::get_slices`, returning this type.
+     */
+    std::vector<std::shared_ptr<MultiResponseMessage>> get_slices(
+        const std::vector<std::pair<std::size_t, std::size_t>> &ranges) const;
+
   protected:
     /**
      * TODO(Documentation)
      */
     std::shared_ptr<MultiMessage> internal_get_slice(std::size_t start, std::size_t stop) const override;
+
+    /**
+     * @brief Builds the slice for rows [start, stop) by value.
+     */
+    MultiResponseMessage make_slice(std::size_t start, std::size_t stop) const;
 };
 
 /****** MultiResponseMessageInterfaceProxy *************************/
@@ -27,7 +27,10 @@
 #include <pybind11/pytypes.h>
 #include <cudf/types.hpp>
 
+#include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace morpheus {
 /****** Component public implementations *******************/
@@ -59,11 +62,24 @@ class MultiResponseProbsMessage : public MultiResponseMessage
     /**
      * TODO(Documentation)
      */
-    std::shared_ptr<MultiResponseProbsMessage> get_slice(size_t start, size_t stop) const
-    {
-        // This can only cast down
-        return std::static_pointer_cast<MultiResponseProbsMessage>(this->internal_get_slice(start, stop));
-    }
+    std::shared_ptr<MultiResponseProbsMessage> get_slice(size_t start, size_t stop) const;
+
+    /**
+     * @brief Same as `MultiMessage::get_slices`, returning this type.
+     */
+    std::vector<std::shared_ptr<MultiResponseProbsMessage>> get_slices(
+        const std::vector<std::pair<size_t, size_t>> &ranges) const;
+
+  protected:
+    /**
+     * @brief Overridden so slices of this message keep its type.
+     */
+    std::shared_ptr<MultiMessage> internal_get_slice(size_t start, size_t stop) const override;
+
+    /**
+     * @brief Builds the slice for rows [start, stop) by value.
+     */
+    MultiResponseProbsMessage make_slice(size_t start, size_t stop) const;
 };
 
 /****** MultiResponseProbsMessageInterfaceProxy *************************/
@@ -0,0 +1,108 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/objects/table_info.hpp>
+
+#include <cudf/column/column.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/table/table.hpp>
+
+#include <pybind11/pybind11.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** CppDataTable***************************************/
+    /**
+     * @brief IDataTable which owns a cudf::table directly. Creating and reading from the table does not touch Python.
+     * The Python DataFrame is only created the first time `get_py_object` is called, the table is moved into it
+     * (without copying the device memory) and from then on the Python object is the source of truth, matching
+     * `PyDataTable`.
+     */
+    struct CppDataTable : public IDataTable {
+        CppDataTable(cudf::io::table_with_metadata &&table, int index_col_count = 0);
+        ~CppDataTable();
+
+        /**
+         * TODO(Documentation)
+         */
+        cudf::size_type count() const override;
+
+        /**
+         * TODO(Documentation)
+         */
+        TableInfo get_info() const override;
+
+        /**
+         * @brief Returns the Python DataFrame, creating it on the first call. Acquires the GIL.
+         */
+        const pybind11::object &get_py_object() const override;
+
+        /**
+         * @brief Appends zero initialized columns. Until the Python DataFrame has been created this is done entirely
+         * in C++ without the GIL.
+         */
+        void insert_columns(const std::vector<std::string> &column_names,
+                            const std::vector<TypeId> &column_types) const override;
+
+        /**
+         * @brief Bytes of the columns, including those inserted later. Still counted once the table has been moved
+         * into Python.
+         */
+        std::size_t device_bytes() const override;
+
+        /**
+         * @brief Whether or not the Python DataFrame has been created.
+         */
+        bool is_python() const;
+
+        /**
+         * @brief Device bytes of every `CppDataTable` alive in the process, and the number of tables.
+         */
+        static std::size_t live_device_bytes();
+
+        static std::size_t live_count();
+
+    private:
+        // Guards m_table, m_metadata, m_schema and the transfer of m_table into m_py_table. Never held while acquiring
+        // the GIL
+        mutable std::mutex m_mutex;
+
+        // Null once moved into the Python object
+        mutable std::unique_ptr<cudf::table> m_table;
+        mutable cudf::io::table_metadata m_metadata;
+        // Names of the current columns, shared by every view until the next insert_columns. Null until needed
+        mutable std::shared_ptr<const TableSchema> m_schema;
+        int m_index_col_count;
+        cudf::size_type m_num_rows;
+        mutable std::atomic<std::size_t> m_device_bytes{0};
+
+        // When there are no index columns, Python creates a RangeIndex. Hold the equivalent column so C++ views have
+        // the same layout as those created from Python
+        std::unique_ptr<cudf::column> m_range_index;
+
+        mutable pybind11::object m_py_table;
+    };
+}
@@ -17,10 +17,17 @@
 
 #pragma once
 
+#include <morpheus/utilities/type_util_detail.hpp>
+
 #include <cudf/types.hpp>
 
 #include <pybind11/pytypes.h>
 
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace morpheus {
     class TableInfo;
 
@@ -48,5 +55,18 @@ namespace morpheus {
          * TODO(Documentation)
          */
         virtual const pybind11::object &get_py_object() const = 0;
+
+        /**
+         * @brief Appends zero initialized columns to the table. Views from previous calls to `get_info` remain valid
+         * but do not contain the new columns.
+         */
+        virtual void insert_columns(const std::vector<std::string> &column_names,
+                                    const std::vector<TypeId> &column_types) const = 0;
+
+        /**
+         * @brief Device bytes kept alive by this table: its own columns, plus the table a view was taken from. Tables
+         * owned by Python are not accounted and return 0.
+         */
+        virtual std::size_t device_bytes() const = 0;
     };
 }
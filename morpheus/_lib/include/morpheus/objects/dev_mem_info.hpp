@@ -19,6 +19,7 @@
 
 #include <morpheus/utilities/type_util_detail.hpp>
 
+#include <rmm/cuda_stream_view.hpp>
 #include <rmm/device_buffer.hpp>
 
 #include <cstddef>
@@ -45,6 +46,11 @@ struct DevMemInfo
      * TODO(Documentation)
      */
     void *data() const;
+
+    /**
+     * @brief Stream the buffer was allocated on. Work on this memory should be enqueued there
+     */
+    rmm::cuda_stream_view stream() const;
 };
 
 }  // namespace morpheus
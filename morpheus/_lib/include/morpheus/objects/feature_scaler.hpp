@@ -0,0 +1,65 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** FeatureScaler***************************************/
+    /**
+     * @brief Per-feature normalization applied while features are packed with `MatxUtil::pack_columns`. Loaded from a
+     * JSON file mapping feature names to either `{"mean": m, "std": s}`, scaled to `(x - m) / s`, or
+     * `{"min": a, "max": b}`, scaled to `(x - a) / (b - a)`:
+     *
+     *     {"features": {"bytes": {"mean": 1024.0, "std": 96.5}, "hour": {"min": 0, "max": 23}}}
+     *
+     * A zero `std`, or equal `min` and `max`, only shifts the feature.
+     */
+#pragma GCC visibility push(default)
+    class FeatureScaler {
+    public:
+        /**
+         * @brief Parses `filename`. Throws `std::runtime_error` if the file cannot be read or a feature has neither
+         * statistic.
+         */
+        static std::shared_ptr<FeatureScaler> load_json(const std::string &filename);
+
+        /**
+         * @brief Shift of every column, in order. Columns the file has no entry for are left unscaled.
+         */
+        std::vector<float> shift(const std::vector<std::string> &columns) const;
+
+        /**
+         * @brief Scale of every column, in order. Columns the file has no entry for are left unscaled.
+         */
+        std::vector<float> scale(const std::vector<std::string> &columns) const;
+
+    private:
+        FeatureScaler() = default;
+
+        // Shift and scale keyed by feature name
+        std::map<std::string, std::pair<float, float>> m_coefficients;
+    };
+#pragma GCC visibility pop
+}  // namespace morpheus
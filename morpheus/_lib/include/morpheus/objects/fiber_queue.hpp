@@ -23,28 +23,83 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 
+#include <chrono>
 #include <memory>
 #include <cstddef>
+#include <optional>
+#include <vector>
 
 namespace morpheus {
+    class MessageMeta;
+
     /****** Component public implementations *******************/
-    /****** FiberQueue****************************************/
+    /****** TypedFiberQueue***********************************/
     /**
-     * TODO(Documentation)
+     * @brief Bounded multi-producer multi-consumer queue usable from fibers and threads alike. Instantiated for
+     * python objects (`FiberQueue`) and for `std::shared_ptr<MessageMeta>` (`MessageMetaFiberQueue`), which C++ stages
+     * can pop from without ever touching the GIL. Waiting operations sleep the calling fiber or thread and are woken
+     * as soon as they can complete or the queue is closed, they never poll.
      */
-    class FiberQueue {
+    template<typename ItemT>
+    class TypedFiberQueue {
     public:
-        FiberQueue(std::size_t max_size);
+        using clock_t = std::chrono::steady_clock;
+
+        TypedFiberQueue(std::size_t max_size);
 
         /**
-         * TODO(Documentation)
+         * @brief Pushes `item`. With `block` false returns `full` instead of waiting, a positive `timeout` in
+         * seconds returns `timeout` once it expires.
          */
-        boost::fibers::channel_op_status put(pybind11::object &&item, bool block = true, float timeout = 0.0);
+        boost::fibers::channel_op_status put(ItemT &&item, bool block = true, float timeout = 0.0);
 
         /**
-         * TODO(Documentation)
+         * @brief Pops into `item`. With `block` false returns `empty` instead of waiting, a positive `timeout` in
+         * seconds returns `timeout` once it expires.
+         */
+        boost::fibers::channel_op_status get(ItemT &item, bool block = true, float timeout = 0.0);
+
+        /**
+         * @brief Pushes `item`, returning `timeout` if there is no room by `deadline`.
+         */
+        boost::fibers::channel_op_status put_until(ItemT &&item, clock_t::time_point deadline);
+
+        /**
+         * @brief Pops into `item`, returning `timeout` if nothing arrived by `deadline`.
+         */
+        boost::fibers::channel_op_status get_until(ItemT &item, clock_t::time_point deadline);
+
+        /**
+         * @brief Pushes `items` in order, moving out of them. `block` and `timeout` apply to the whole call. Sets
+         * `put_count` to the number of items pushed and returns the status of the first push which failed, or success.
+         */
+        boost::fibers::channel_op_status put_many(std::vector<ItemT> &items,
+                                                  std::size_t &put_count,
+                                                  bool block = true,
+                                                  float timeout = 0.0);
+
+        /**
+         * @brief Same as `put_many` waiting until `deadline` at most.
+         */
+        boost::fibers::channel_op_status put_many_until(std::vector<ItemT> &items,
+                                                        std::size_t &put_count,
+                                                        clock_t::time_point deadline);
+
+        /**
+         * @brief Waits for one item like `get`, then appends it and up to `max_items - 1` more which are already
+         * queued to `items` without waiting again. Returns the status of the first pop.
+         */
+        boost::fibers::channel_op_status get_many(std::vector<ItemT> &items,
+                                                  std::size_t max_items,
+                                                  bool block = true,
+                                                  float timeout = 0.0);
+
+        /**
+         * @brief Same as `get_many` waiting for the first item until `deadline` at most.
          */
-        boost::fibers::channel_op_status get(pybind11::object &item, bool block = true, float timeout = 0.0);
+        boost::fibers::channel_op_status get_many_until(std::vector<ItemT> &items,
+                                                        std::size_t max_items,
+                                                        clock_t::time_point deadline);
 
         /**
          * TODO(Documentation)
@@ -62,13 +117,38 @@ namespace morpheus {
         void join();
 
     private:
-        boost::fibers::buffered_channel<pybind11::object> m_queue;
+        // A `deadline` is only used when blocking, without one the call waits until it can complete
+        boost::fibers::channel_op_status push(ItemT &&item,
+                                              bool block,
+                                              const std::optional<clock_t::time_point> &deadline);
+        boost::fibers::channel_op_status pop(ItemT &item,
+                                             bool block,
+                                             const std::optional<clock_t::time_point> &deadline);
+
+        boost::fibers::channel_op_status push_many(std::vector<ItemT> &items,
+                                                   std::size_t &put_count,
+                                                   bool block,
+                                                   const std::optional<clock_t::time_point> &deadline);
+        boost::fibers::channel_op_status pop_many(std::vector<ItemT> &items,
+                                                  std::size_t max_items,
+                                                  bool block,
+                                                  const std::optional<clock_t::time_point> &deadline);
+
+        boost::fibers::buffered_channel<ItemT> m_queue;
     };
 
+    using FiberQueue = TypedFiberQueue<pybind11::object>;
+    using MessageMetaFiberQueue = TypedFiberQueue<std::shared_ptr<MessageMeta>>;
+
+    extern template class TypedFiberQueue<pybind11::object>;
+    extern template class TypedFiberQueue<std::shared_ptr<MessageMeta>>;
+
 #pragma GCC visibility push(default)
     /****** FiberQueueInterfaceProxy *************************/
     /**
-     * @brief Interface proxy, used to insulate python bindings.
+     * @brief Interface proxy, used to insulate python bindings. A `timeout` of 0, the default, or None waits until
+     * the call can complete, a positive value waits that many seconds at most and a negative one raises. Both are
+     * ignored when `block` is false, which never waits.
      */
     struct FiberQueueInterfaceProxy {
         /**
@@ -79,17 +159,72 @@ namespace morpheus {
         /**
          * TODO(Documentation)
          */
-        static void put(morpheus::FiberQueue &self, pybind11::object item, bool block = true, float timeout = 0.0);
+        static void put(morpheus::FiberQueue &self,
+                        pybind11::object item,
+                        bool block = true,
+                        std::optional<float> timeout = 0.0);
 
         /**
          * TODO(Documentation)
          */
-        static pybind11::object get(morpheus::FiberQueue &self, bool block = true, float timeout = 0.0);
+        static pybind11::object get(morpheus::FiberQueue &self,
+                                    bool block = true,
+                                    std::optional<float> timeout = 0.0);
+
+        /**
+         * @brief Puts every item of `items` releasing the GIL once. Returns the number of items put, raising only if
+         * none could be.
+         */
+        static std::size_t put_many(morpheus::FiberQueue &self,
+                                    pybind11::iterable items,
+                                    bool block = true,
+                                    std::optional<float> timeout = 0.0);
+
+        /**
+         * @brief Gets between 1 and `max_items` items as a list releasing the GIL once. Raises like `get` when no item
+         * could be taken.
+         */
+        static pybind11::list get_many(morpheus::FiberQueue &self,
+                                       std::size_t max_items,
+                                       bool block = true,
+                                       std::optional<float> timeout = 0.0);
 
         /**
          * TODO(Documentation)
          */
         static void close(morpheus::FiberQueue &self);
     };
+
+    /****** MessageMetaFiberQueueInterfaceProxy **************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings. Takes the same arguments as `FiberQueueInterfaceProxy`.
+     */
+    struct MessageMetaFiberQueueInterfaceProxy {
+        /**
+         * @brief Create and initialize a MessageMetaFiberQueue, and return a shared pointer to the result.
+         */
+        static std::shared_ptr<morpheus::MessageMetaFiberQueue> init(std::size_t max_size);
+
+        static void put(morpheus::MessageMetaFiberQueue &self,
+                        std::shared_ptr<MessageMeta> item,
+                        bool block = true,
+                        std::optional<float> timeout = 0.0);
+
+        static std::shared_ptr<MessageMeta> get(morpheus::MessageMetaFiberQueue &self,
+                                                bool block = true,
+                                                std::optional<float> timeout = 0.0);
+
+        static std::size_t put_many(morpheus::MessageMetaFiberQueue &self,
+                                    pybind11::iterable items,
+                                    bool block = true,
+                                    std::optional<float> timeout = 0.0);
+
+        static pybind11::list get_many(morpheus::MessageMetaFiberQueue &self,
+                                       std::size_t max_items,
+                                       bool block = true,
+                                       std::optional<float> timeout = 0.0);
+
+        static void close(morpheus::MessageMetaFiberQueue &self);
+    };
 #pragma GCC visibility pop
-}
\ No newline at end of file
+}
@@ -24,7 +24,10 @@ namespace morpheus {
     enum class FileTypes : int32_t {
         Auto,
         JSON,
-        CSV
+        CSV,
+        PARQUET,
+        ORC,
+        ARROW
     };
 
     FileTypes determine_file_type(const std::string &filename);
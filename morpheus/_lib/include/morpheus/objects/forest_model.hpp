@@ -0,0 +1,81 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/objects/tensor_object.hpp>
+
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** ForestModel*****************************************/
+    /**
+     * @brief Tree ensemble held in device memory and evaluated in-process with `MatxUtil::predict_forest`, avoiding the
+     * round trip to an inference server for small gradient boosted models. Loaded from the JSON format written by
+     * XGBoost's `Booster.save_model("model.json")`; `gbtree` boosters with the `binary:logistic`, `binary:logitraw`,
+     * `reg:squarederror`, `reg:linear`, `multi:softprob` and `multi:softmax` objectives are supported.
+     * `multi:softmax` models output the class probabilities rather than the class.
+     */
+#pragma GCC visibility push(default)
+    class ForestModel {
+    public:
+        /**
+         * @brief Parses `filename` and copies the trees to the current device. Throws `std::runtime_error` if the file
+         * cannot be read or holds an unsupported model.
+         */
+        static std::shared_ptr<ForestModel> load_xgboost_json(const std::string &filename);
+
+        /**
+         * @brief Number of features the trees read. Inputs may have more columns, extra columns are ignored.
+         */
+        std::size_t num_features() const;
+
+        /**
+         * @brief Number of columns of the predictions, 1 except for multi-class models.
+         */
+        std::size_t num_outputs() const;
+
+        /**
+         * @brief Predicts every row of a 2D FLOAT32 or FLOAT64 tensor with at least `num_features()` columns.
+         * Enqueued on `rmm::cuda_stream_per_thread` without synchronizing.
+         * @return A [rows, num_outputs()] FLOAT32 tensor of probabilities, or of raw scores for regression and
+         * `binary:logitraw` models
+         */
+        TensorObject predict(const TensorObject &input) const;
+
+    private:
+        ForestModel() = default;
+
+        std::size_t m_num_features{0};
+        std::size_t m_num_trees{0};
+        std::size_t m_num_outputs{1};
+        float m_base_margin{0};
+        bool m_sigmoid{false};
+        bool m_softmax{false};
+
+        // Device copies of the flattened trees
+        std::unique_ptr<rmm::device_buffer> m_nodes;
+        std::unique_ptr<rmm::device_buffer> m_tree_roots;
+        std::unique_ptr<rmm::device_buffer> m_tree_outputs;
+    };
+#pragma GCC visibility pop
+}  // namespace morpheus
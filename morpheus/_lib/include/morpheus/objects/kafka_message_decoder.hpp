@@ -0,0 +1,99 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cudf/io/types.hpp>
+#include <librdkafka/rdkafkacpp.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** KafkaMessageDecoder*********************************/
+    /**
+     * @brief Decodes the payloads of a batch of Kafka messages straight into a table, one row per message. Used by
+     * KafkaSourceStage in place of its JSON reader for binary message formats. Called concurrently by the parse tasks
+     * of every partition.
+     */
+#pragma GCC visibility push(default)
+    class KafkaMessageDecoder {
+    public:
+        virtual ~KafkaMessageDecoder() = default;
+
+        /**
+         * @brief Decodes every message of `messages`. Returns a table without rows, or without a table, if no message
+         * could be decoded.
+         *
+         * @param message_is_decoded One entry per message, set to 1 by the caller. Cleared for every message left out
+         * of the table, so the rows stay matched with their messages.
+         */
+        virtual cudf::io::table_with_metadata decode(const std::vector<std::unique_ptr<RdKafka::Message>> &messages,
+                                                     std::vector<uint8_t> &message_is_decoded) = 0;
+
+        /**
+         * @brief Creates the decoder of `message_format`. Returns nullptr for "json", which is parsed by the stage.
+         *
+         * @param message_format One of "json", "avro" for bare Avro datums written with `avro_schema`, or
+         * "avro-confluent" for datums framed by the Confluent serializer with a magic byte and a schema id.
+         * @param avro_schema Writer schema of the datums, as Avro JSON. Required for "avro". For "avro-confluent" it is
+         * used for every schema id when `schema_registry_url` is empty.
+         * @param schema_registry_url Base URL of a Confluent schema registry, like "http://localhost:8081", used to
+         * look up the writer schema of each schema id.
+         */
+        static std::shared_ptr<KafkaMessageDecoder> create(const std::string &message_format,
+                                                           const std::string &avro_schema,
+                                                           const std::string &schema_registry_url);
+    };
+
+    /****** KafkaAvroDecoder************************************/
+    /**
+     * @brief Decodes Avro datums by wrapping each run of messages sharing a writer schema in an in-memory Avro object
+     * container file and reading it with `cudf::io::read_avro`, so datums are decoded on the GPU a batch at a time.
+     * Supports the record fields read by cuDF's Avro reader.
+     */
+    class KafkaAvroDecoder : public KafkaMessageDecoder {
+    public:
+        /**
+         * @param confluent_framing Whether payloads start with the Confluent magic byte and a big endian schema id.
+         */
+        KafkaAvroDecoder(std::string avro_schema, std::string schema_registry_url, bool confluent_framing);
+
+        cudf::io::table_with_metadata decode(const std::vector<std::unique_ptr<RdKafka::Message>> &messages,
+                                             std::vector<uint8_t> &message_is_decoded) override;
+
+    private:
+        /**
+         * @brief Writer schema of `schema_id`, fetched from the registry on first use.
+         */
+        std::string writer_schema(int32_t schema_id);
+
+        std::string m_avro_schema;
+        std::string m_schema_registry_url;
+        bool m_confluent_framing;
+
+        std::mutex m_mutex;
+        std::map<int32_t, std::string> m_schemas;
+    };
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,115 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cudf/io/types.hpp>
+#include <cudf/table/table.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** LoadGeneratorOptions********************************/
+    /**
+     * @brief How the number of rows in each generated batch is drawn around the mean `batch_size`.
+     */
+    enum class BatchSizeDistribution {
+        Fixed,        // Every batch holds `batch_size` rows
+        Uniform,      // Uniform in [1, 2 * batch_size - 1]
+        Exponential,  // Exponential with mean `batch_size`, capped at `MaxBatchSizeFactor * batch_size`
+    };
+
+    /**
+     * @brief Parses "fixed", "uniform" or "exponential". Throws `std::invalid_argument` otherwise.
+     */
+    BatchSizeDistribution parse_batch_size_distribution(const std::string &name);
+
+    struct LoadGeneratorOptions {
+        double rows_per_second{0.0};  // Zero generates batches as fast as they are consumed
+        std::size_t batch_size{256};
+        BatchSizeDistribution distribution{BatchSizeDistribution::Fixed};
+        double jitter{0.0};                       // Batches are due up to `jitter` of their interval early or late
+        std::vector<std::string> mutate_columns;  // String columns made unique in every batch
+        uint64_t seed{0};                         // Zero seeds from `std::random_device`
+    };
+
+    /****** LoadGenerator***************************************/
+    /**
+     * @brief Generates batches of rows from a template table, cycling through its rows, and schedules them at a target
+     * rate. Used by `LoadGeneratorSourceStage` and the benchmarks to drive a pipeline with a controlled, repeatable
+     * load from a small sample of real data.
+     *
+     * Each batch gets a fresh INT64 index counting every row generated so far, the index columns of the template are
+     * dropped. Caches keyed on string values, like the prefilter or the tokenizer, would only ever see the template's
+     * rows, so `mutate_columns` have "-<index>" appended to every value.
+     */
+#pragma GCC visibility push(default)
+    class LoadGenerator {
+    public:
+        using clock_t = std::chrono::steady_clock;
+
+        static constexpr std::size_t MaxBatchSizeFactor = 8;
+
+        LoadGenerator(cudf::io::table_with_metadata template_table, int index_col_count, LoadGeneratorOptions options);
+
+        /**
+         * @brief Draws the number of rows of the next batch, always at least 1.
+         */
+        std::size_t next_batch_size();
+
+        /**
+         * @brief Copies the next `rows` rows of the template, wrapping around to its first row as needed. The result
+         * has one index column.
+         */
+        cudf::io::table_with_metadata make_batch(std::size_t rows);
+
+        /**
+         * @brief Time at which a batch of `rows` rows, generated after every previously scheduled batch, is due when
+         * the first batch is due at `start`. Batches are scheduled back to back from `start` rather than from the time
+         * the previous batch was actually emitted, so falling behind never lowers the average rate. Jitter moves each
+         * batch around its place in the schedule without accumulating. Returns `start` when there is no target rate.
+         */
+        clock_t::time_point schedule(std::size_t rows, clock_t::time_point start);
+
+        double rows_per_second() const;
+
+        std::size_t rows_generated() const;
+
+        std::size_t template_rows() const;
+
+    private:
+        LoadGeneratorOptions m_options;
+
+        std::unique_ptr<cudf::table> m_template;
+        std::vector<std::string> m_column_names;
+        std::vector<cudf::size_type> m_mutate_column_idx;
+
+        std::size_t m_rows_generated{0};
+        std::size_t m_rows_scheduled{0};
+
+        std::mt19937_64 m_random;
+    };
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -21,6 +21,10 @@
 
 #include <pybind11/pybind11.h>
 
+#include <cstddef>
+#include <string>
+#include <vector>
+
 namespace morpheus {
     /****** Component public implementations *******************/
     /****** PyDataTable****************************************/
@@ -46,7 +50,26 @@ namespace morpheus {
          */
         const pybind11::object &get_py_object() const override;
 
+        /**
+         * TODO(Documentation)
+         */
+        void insert_columns(const std::vector<std::string> &column_names,
+                            const std::vector<TypeId> &column_types) const override;
+
+        /**
+         * @brief Always 0, the memory is managed by the Python DataFrame.
+         */
+        std::size_t device_bytes() const override;
+
     private:
         pybind11::object m_py_table;
     };
+
+    /****** Component public free function implementations******/
+    /**
+     * @brief Appends zero initialized columns to a cudf DataFrame. The GIL must be held by the caller.
+     */
+    void insert_py_columns(const pybind11::object &py_table,
+                           const std::vector<std::string> &column_names,
+                           const std::vector<TypeId> &column_types);
 }
\ No newline at end of file
@@ -23,26 +23,68 @@
 #include <cudf/table/table_view.hpp>
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace morpheus {
 /****** Component public implementations *******************/
+/****** TableSchema****************************************/
+/**
+ * @brief Index and column names of a table. Shared by every TableInfo taken from the same version of a table, so the
+ * names are not copied for each view, and the name to position map is built at most once per version, on the first
+ * lookup.
+ */
+class TableSchema
+{
+  public:
+    TableSchema(std::vector<std::string> index_names, std::vector<std::string> column_names);
+
+    const std::vector<std::string> &index_names() const;
+    const std::vector<std::string> &column_names() const;
+
+    /**
+     * @brief Position of the first column called `name` in `column_names()`, or -1 if there is none.
+     */
+    cudf::size_type find_column(const std::string &name) const;
+
+  private:
+    std::vector<std::string> m_index_names;
+    std::vector<std::string> m_column_names;
+
+    mutable std::once_flag m_lookup_once;
+    mutable std::unordered_map<std::string, cudf::size_type> m_lookup;
+};
+
 /****** TableInfo******************************************/
 struct TableInfo
 {
-    TableInfo() = default;
+    TableInfo();
 
     TableInfo(std::shared_ptr<const IDataTable> parent,
               cudf::table_view view,
               std::vector<std::string> index_names,
               std::vector<std::string> column_names);
 
+    /**
+     * @brief Creates a view sharing `schema` with other views of the same table. `view` must hold the index columns
+     * followed by the columns of the schema.
+     */
+    TableInfo(std::shared_ptr<const IDataTable> parent,
+              cudf::table_view view,
+              std::shared_ptr<const TableSchema> schema);
+
     /**
      * TODO(Documentation)
      */
     const pybind11::object &get_parent_table() const;
 
+    /**
+     * @brief The table this view was taken from, kept alive by the view.
+     */
+    const std::shared_ptr<const IDataTable> &get_parent() const;
+
     /**
      * TODO(Documentation)
      */
@@ -51,12 +93,17 @@ struct TableInfo
     /**
      * TODO(Documentation)
      */
-    std::vector<std::string> get_index_names() const;
+    const std::vector<std::string> &get_index_names() const;
 
     /**
      * TODO(Documentation)
      */
-    std::vector<std::string> get_column_names() const;
+    const std::vector<std::string> &get_column_names() const;
+
+    /**
+     * @brief Names of the view, shared with the other views of the same table version.
+     */
+    const std::shared_ptr<const TableSchema> &get_schema() const;
 
     /**
      * TODO(Documentation)
@@ -79,7 +126,8 @@ struct TableInfo
     pybind11::object as_py_object() const;
 
     /**
-     * TODO(Documentation)
+     * @brief Appends zero initialized columns to the parent table and refreshes this view to include them. Does not
+     * require the GIL when the parent is a C++ table.
      */
     void insert_columns(const std::vector<std::string> &column_names, const std::vector<TypeId> &column_types);
 
@@ -98,10 +146,22 @@ struct TableInfo
      */
     TableInfo get_slice(cudf::size_type start, cudf::size_type stop, std::vector<std::string> column_names = {}) const;
 
+    /**
+     * @brief Rows [start, stop) of every column. Shares the schema of this view, so no names are looked up or copied.
+     */
+    TableInfo get_row_slice(cudf::size_type start, cudf::size_type stop) const;
+
+    /**
+     * @brief Same as `get_slice` by name, but takes the positions of the columns in `get_column_names()`. Callers which
+     * resolved the positions once for a schema skip the name lookups.
+     */
+    TableInfo get_slice(cudf::size_type start,
+                        cudf::size_type stop,
+                        const std::vector<cudf::size_type> &column_indices) const;
+
   private:
     std::shared_ptr<const IDataTable> m_parent;
     cudf::table_view m_table_view;
-    std::vector<std::string> m_column_names;
-    std::vector<std::string> m_index_names;
+    std::shared_ptr<const TableSchema> m_schema;
 };
 }  // namespace morpheus
@@ -19,6 +19,7 @@
 
 #include <morpheus/objects/rmm_tensor.hpp>
 #include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/host_memory.hpp>
 #include <morpheus/utilities/matx_util.hpp>
 #include <morpheus/utilities/type_util.hpp>
 
@@ -26,6 +27,7 @@
 
 #include <cudf/types.hpp>
 
+#include <rmm/cuda_stream_view.hpp>
 #include <rmm/device_buffer.hpp>
 #include <rmm/device_uvector.hpp>
 
@@ -43,6 +45,7 @@ namespace morpheus {
 /**
  * TODO(Documentation)
  */
+#pragma GCC visibility push(default)
 class Tensor
 {
   public:
@@ -71,6 +74,12 @@ class Tensor
      */
     std::vector<uint8_t> get_host_data() const;
 
+    /**
+     * @brief Same as `TensorObject::copy_to_host_async`, queues a copy of the buffer into pinned host memory on
+     * `stream`. The buffer must not be read, or destroyed, until `stream` has been synchronized.
+     */
+    PinnedHostBuffer copy_to_host_async(rmm::cuda_stream_view stream) const;
+
     /**
      * TODO(Documentation)
      */
@@ -85,8 +94,16 @@ class Tensor
                                std::vector<TensorIndex> strides,
                                size_t offset = 0);
 
+    /**
+     * @brief Creates one row-major tensor for each pair of `dtypes` and `shapes`, all backed by a single device
+     * allocation. Each tensor starts at a 256 byte aligned offset.
+     */
+    static std::vector<TensorObject> create_packed(const std::vector<DType> &dtypes,
+                                                   const std::vector<std::vector<TensorIndex>> &shapes);
+
   private:
     size_t m_offset;
     std::shared_ptr<rmm::device_buffer> m_device_buffer;
 };
+#pragma GCC visibility pop
 }  // namespace morpheus
@@ -0,0 +1,80 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/host_memory.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstddef>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** TensorCastView****************************************/
+/**
+ * @brief Lazy version of `TensorObject::as_type`. Holds the source tensor and the target dtype, and does the
+ * conversion while writing to wherever the data is going next (a device buffer, a Triton shared memory region
+ * or a pinned host buffer). No intermediate device buffer is needed, and no extra pass over the data. Converting to
+ * the source dtype is a plain copy. The source must be compact.
+ */
+class TensorCastView
+{
+  public:
+    TensorCastView(TensorObject source, DataType dtype);
+
+    const TensorObject& source() const;
+
+    DataType dtype() const;
+
+    /**
+     * @brief True when the target dtype matches the source, so no conversion is done.
+     */
+    bool is_identity() const;
+
+    std::size_t count() const;
+
+    /**
+     * @brief Size of the converted data.
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Writes the converted data to `output`, any device accessible memory with room for `bytes()`. Enqueued
+     * on `stream` without synchronizing.
+     */
+    void copy_to(void* output, rmm::cuda_stream_view stream) const;
+
+    /**
+     * @brief Converts straight into a buffer from `PinnedHostPool`. Same as `TensorObject::copy_to_host_async`, the
+     * buffer must not be read, or destroyed, until `stream` has been synchronized.
+     */
+    PinnedHostBuffer copy_to_host_async(rmm::cuda_stream_view stream) const;
+
+    /**
+     * @brief Converts into a new tensor, same as `TensorObject::as_type`. A shallow copy of the source when
+     * `is_identity()`.
+     */
+    TensorObject materialize() const;
+
+  private:
+    TensorObject m_source;
+    DataType m_dtype;
+};
+}  // namespace morpheus
@@ -0,0 +1,97 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/objects/tensor_object.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** TensorMap****************************************/
+/**
+ * @brief Flat table of named tensors used by `InferenceMemory` and `ResponseMemory`. Messages hold a handful of
+ * tensors, so entries are kept in insertion order in a vector and found by a linear scan rather than a tree lookup.
+ * Entries are never removed, so the slot returned by `slot_of` stays valid for the lifetime of the table and can be
+ * used with `at` to skip the name lookup entirely.
+ */
+class TensorMap
+{
+  public:
+    using value_type     = std::pair<std::string, TensorObject>;
+    using iterator       = std::vector<value_type>::iterator;
+    using const_iterator = std::vector<value_type>::const_iterator;
+
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    TensorMap();
+
+    /**
+     * @brief Slot of the tensor called `name`, or `npos` if there is none.
+     */
+    std::size_t slot_of(const std::string& name) const;
+
+    /**
+     * @brief Same as `slot_of(name)` but checks `hint` first. Stages which see the same layout for every message can
+     * pass the slot found for the previous message to make the lookup a single comparison.
+     */
+    std::size_t slot_of(const std::string& name, std::size_t hint) const;
+
+    /**
+     * @brief Tensor stored in `slot`. The slot must be less than `size()`.
+     */
+    TensorObject& at(std::size_t slot);
+    const TensorObject& at(std::size_t slot) const;
+
+    /**
+     * @brief Name of the tensor stored in `slot`. The slot must be less than `size()`.
+     */
+    const std::string& name_at(std::size_t slot) const;
+
+    /**
+     * @brief Returns the tensor called `name`, appending an empty tensor if there is none.
+     */
+    TensorObject& operator[](const std::string& name);
+
+    /**
+     * @brief Appends `tensor` as `name` unless a tensor with that name already exists. Returns the entry and whether
+     * it was inserted.
+     */
+    std::pair<iterator, bool> emplace(const std::string& name, TensorObject tensor);
+
+    iterator find(const std::string& name);
+    const_iterator find(const std::string& name) const;
+
+    bool contains(const std::string& name) const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+  private:
+    std::vector<value_type> m_entries;
+};
+}  // namespace morpheus
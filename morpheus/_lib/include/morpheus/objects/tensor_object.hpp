@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <morpheus/utilities/host_memory.hpp>
 #include <morpheus/utilities/type_util_detail.hpp>
 
 #include <neo/core/memory.hpp>
@@ -30,6 +31,7 @@
 
 #include <glog/logging.h>  // for CHECK
 
+#include <rmm/cuda_stream_view.hpp>
 #include <rmm/device_uvector.hpp>
 
 #include <xtensor/xadapt.hpp>
@@ -498,11 +500,33 @@ struct TensorObject final
 
         out_data.resize(this->bytes());
 
-        NEO_CHECK_CUDA(cudaMemcpy(&out_data[0], this->data(), this->bytes(), cudaMemcpyDeviceToHost));
+        // Use the per-thread stream to avoid an implicit sync with every other stream
+        NEO_CHECK_CUDA(cudaMemcpyAsync(
+            out_data.data(), this->data(), this->bytes(), cudaMemcpyDeviceToHost, rmm::cuda_stream_per_thread));
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
 
         return out_data;
     }
 
+    /**
+     * @brief Queues a copy of the tensor into a pinned buffer from `PinnedHostPool` on `stream` and returns without
+     * waiting. The buffer must not be read, or destroyed, until `stream` has been synchronized. Several copies can be
+     * queued before a single synchronize.
+     */
+    PinnedHostBuffer copy_to_host_async(rmm::cuda_stream_view stream) const
+    {
+        auto host_buffer = PinnedHostPool::acquire(this->bytes());
+
+        if (!host_buffer.empty())
+        {
+            NEO_CHECK_CUDA(cudaMemcpyAsync(
+                host_buffer.data(), this->data(), this->bytes(), cudaMemcpyDeviceToHost, stream.value()));
+        }
+
+        return host_buffer;
+    }
+
     template <typename T, size_t N>
     T read_element(const TensorIndex (&idx)[N]) const
     {
@@ -598,8 +622,11 @@ struct TensorObject final
 
         DCHECK(this->bytes() == other.bytes()) << "Left and right bytes should be the same if all other test passed";
 
-        // Perform the copy operation
-        NEO_CHECK_CUDA(cudaMemcpy(this->data(), other.data(), this->bytes(), cudaMemcpyDeviceToDevice));
+        // Perform the copy operation. Use the per-thread stream to avoid an implicit sync with every other stream
+        NEO_CHECK_CUDA(cudaMemcpyAsync(
+            this->data(), other.data(), this->bytes(), cudaMemcpyDeviceToDevice, rmm::cuda_stream_per_thread));
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
 
         return *this;
     }
@@ -19,8 +19,11 @@ namespace morpheus {
         std::string name;
         size_t bytes;
         DType datatype;
+        // As reported by the model, -1 for dynamic dimensions
         std::vector<int> shape;
         std::string mapped_name;
         size_t offset;
+        // Second dimension is -1 in the model metadata. Only set for inputs
+        bool dynamic_width{false};
     };
 }
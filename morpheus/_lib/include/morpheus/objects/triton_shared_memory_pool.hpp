@@ -0,0 +1,80 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cuda_runtime.h>
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** TritonSharedMemoryRegion****************************/
+    /**
+     * @brief A single device allocation which can be registered with Triton as a CUDA shared memory region.
+     */
+    struct TritonSharedMemoryRegion {
+        std::string name;
+        uint8_t *data;
+        std::size_t bytes;
+        int device_id;
+        cudaIpcMemHandle_t ipc_handle;
+    };
+
+    /****** TritonSharedMemoryPool******************************/
+    /**
+     * @brief Fixed size pool of CUDA IPC regions used to exchange inputs and outputs with a co-located Triton server
+     * without leaving the GPU. Regions are allocated directly with `cudaMalloc` since IPC handles must refer to the base
+     * of an allocation. Registering the regions with the server is left to the caller.
+     */
+#pragma GCC visibility push(default)
+    class TritonSharedMemoryPool {
+    public:
+        TritonSharedMemoryPool(const std::string &name_prefix, std::size_t region_bytes, std::size_t region_count);
+        ~TritonSharedMemoryPool();
+
+        TritonSharedMemoryPool(const TritonSharedMemoryPool &) = delete;
+        TritonSharedMemoryPool &operator=(const TritonSharedMemoryPool &) = delete;
+
+        /**
+         * @brief All regions in the pool, used for registering/unregistering with the server.
+         */
+        const std::vector<TritonSharedMemoryRegion> &regions() const;
+
+        /**
+         * @brief Waits until a region is available and returns it. The region is given back to the pool when the
+         * returned pointer is destroyed. The pool must outlive all acquired regions.
+         */
+        std::shared_ptr<const TritonSharedMemoryRegion> acquire();
+
+    private:
+        void release(std::size_t idx);
+
+        std::vector<TritonSharedMemoryRegion> m_regions;
+        std::vector<std::size_t> m_free_regions;
+        boost::fibers::mutex m_mutex;
+        boost::fibers::condition_variable m_cv;
+    };
+#pragma GCC visibility pop
+}
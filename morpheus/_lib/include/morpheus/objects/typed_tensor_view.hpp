@@ -0,0 +1,233 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <glog/logging.h>  // for CHECK
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+// Lets the inline accessors be called from kernels when included from a .cu file
+#ifdef __CUDACC__
+    #define MORPHEUS_HOST_DEVICE __host__ __device__
+#else
+    #define MORPHEUS_HOST_DEVICE
+#endif
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** TypedTensorView****************************************/
+/**
+ * @brief Non-owning view of a tensor with the element type and rank fixed at compile time. Shape and stride (in
+ * elements) are held by value, so copying a view, indexing and slicing never allocate or make virtual calls, unlike
+ * `TensorObject`. The dtype and rank are checked once, when the view is created with `from`.
+ *
+ * `shape`, `stride`, `offset`, `ptr` and `operator()` only assert their arguments, compiling to plain arithmetic in
+ * release builds. `at` and `slice` always check their bounds. The view does not keep the memory alive, the
+ * `TensorObject` it was created from must outlive it. Tensor memory is normally on the device, so elements may
+ * only be dereferenced from device code.
+ */
+template <typename T, RankType Rank>
+class TypedTensorView
+{
+    static_assert(Rank > 0, "TypedTensorView requires a rank of at least 1");
+
+  public:
+    using value_type = T;
+    using index_type = std::array<TensorIndex, Rank>;
+
+    static constexpr RankType rank = Rank;
+
+    TypedTensorView() = default;
+
+    TypedTensorView(T* data, const index_type& shape, const index_type& stride) : m_data(data)
+    {
+        for (RankType i = 0; i < Rank; ++i)
+        {
+            m_shape[i]  = shape[i];
+            m_stride[i] = stride[i];
+        }
+    }
+
+    /**
+     * @brief Creates a view of `tensor`, checking its dtype matches `T` and its rank matches `Rank`.
+     */
+    static TypedTensorView from(const TensorObject& tensor)
+    {
+        CHECK(tensor.dtype() == DataType::create<std::remove_const_t<T>>())
+            << "TypedTensorView type must match tensor type. View type: '"
+            << DataType::create<std::remove_const_t<T>>().name() << "', tensor type: '" << tensor.dtype().name()
+            << "'";
+
+        CHECK(tensor.rank() == Rank) << "TypedTensorView rank must match tensor rank. View rank: " << Rank
+                                     << ", tensor rank: " << tensor.rank();
+
+        TypedTensorView view;
+        view.m_data = static_cast<T*>(tensor.data());
+
+        for (RankType i = 0; i < Rank; ++i)
+        {
+            view.m_shape[i]  = tensor.shape(i);
+            view.m_stride[i] = tensor.stride(i);
+        }
+
+        return view;
+    }
+
+    MORPHEUS_HOST_DEVICE T* data() const
+    {
+        return m_data;
+    }
+
+    MORPHEUS_HOST_DEVICE TensorIndex shape(RankType dim) const
+    {
+        assert(dim >= 0 && dim < Rank);
+        return m_shape[dim];
+    }
+
+    MORPHEUS_HOST_DEVICE TensorIndex stride(RankType dim) const
+    {
+        assert(dim >= 0 && dim < Rank);
+        return m_stride[dim];
+    }
+
+    MORPHEUS_HOST_DEVICE TensorIndex count() const
+    {
+        TensorIndex total = 1;
+        for (RankType i = 0; i < Rank; ++i)
+        {
+            total *= m_shape[i];
+        }
+        return total;
+    }
+
+    MORPHEUS_HOST_DEVICE bool is_compact() const
+    {
+        TensorIndex expected = 1;
+        for (RankType i = Rank - 1; i >= 0; --i)
+        {
+            if (m_stride[i] != expected)
+            {
+                return false;
+            }
+
+            expected *= m_shape[i];
+        }
+        return true;
+    }
+
+    /**
+     * @brief Offset in elements of the element at `idx` from `data()`. Takes exactly `Rank` indices.
+     */
+    template <typename... IndexT>
+    MORPHEUS_HOST_DEVICE TensorIndex offset(IndexT... idx) const
+    {
+        static_assert(sizeof...(IndexT) == Rank, "Number of indices must match the rank of the view");
+
+        const TensorIndex indices[Rank] = {static_cast<TensorIndex>(idx)...};
+
+        TensorIndex result = 0;
+        for (RankType i = 0; i < Rank; ++i)
+        {
+            assert(indices[i] >= 0 && indices[i] < m_shape[i]);
+            result += indices[i] * m_stride[i];
+        }
+        return result;
+    }
+
+    template <typename... IndexT>
+    MORPHEUS_HOST_DEVICE T* ptr(IndexT... idx) const
+    {
+        return m_data + this->offset(idx...);
+    }
+
+    template <typename... IndexT>
+    MORPHEUS_HOST_DEVICE T& operator()(IndexT... idx) const
+    {
+        return *this->ptr(idx...);
+    }
+
+    /**
+     * @brief Same as `ptr` but always checks `idx` is inside the view.
+     */
+    T* at(const index_type& idx) const
+    {
+        for (RankType i = 0; i < Rank; ++i)
+        {
+            CHECK(idx[i] >= 0 && idx[i] < m_shape[i])
+                << "Index is outside of the bounds of the view. Index=" << detail::array_to_str(idx.begin(), idx.end())
+                << ", Size=" << detail::array_to_str(m_shape, m_shape + Rank);
+        }
+
+        TensorIndex result = 0;
+        for (RankType i = 0; i < Rank; ++i)
+        {
+            result += idx[i] * m_stride[i];
+        }
+        return m_data + result;
+    }
+
+    /**
+     * @brief View of the elements from `min_dims` (inclusive) to `max_dims` (exclusive) with the same strides. Same
+     * as `TensorObject::slice`, a negative value selects the start or end of that dimension.
+     */
+    TypedTensorView slice(index_type min_dims, index_type max_dims) const
+    {
+        TypedTensorView view(*this);
+
+        TensorIndex result = 0;
+        for (RankType i = 0; i < Rank; ++i)
+        {
+            if (min_dims[i] < 0)
+            {
+                min_dims[i] = 0;
+            }
+
+            if (max_dims[i] < 0)
+            {
+                max_dims[i] = m_shape[i];
+            }
+
+            CHECK(min_dims[i] <= max_dims[i] && max_dims[i] <= m_shape[i])
+                << "Slice is outside of the bounds of the view. Min="
+                << detail::array_to_str(min_dims.begin(), min_dims.end())
+                << ", Max=" << detail::array_to_str(max_dims.begin(), max_dims.end())
+                << ", Size=" << detail::array_to_str(m_shape, m_shape + Rank);
+
+            view.m_shape[i] = max_dims[i] - min_dims[i];
+            result += min_dims[i] * m_stride[i];
+        }
+
+        view.m_data = m_data + result;
+
+        return view;
+    }
+
+  private:
+    T* m_data{nullptr};
+
+    // Plain arrays rather than std::array so the members can be read from device code
+    TensorIndex m_shape[Rank]{};
+    TensorIndex m_stride[Rank]{};
+};
+}  // namespace morpheus
@@ -0,0 +1,91 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/objects/cpp_data_table.hpp>
+#include <morpheus/objects/table_info.hpp>
+
+#include <pybind11/pybind11.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** ViewDataTable**************************************/
+    /**
+     * @brief IDataTable over rows and columns of another table, without copying them. The view keeps the table it was
+     * taken from alive. The rows are only copied, into a `CppDataTable`, the first time they must be owned: when the
+     * Python DataFrame is requested or columns are inserted. From then on the copy is the source of truth.
+     */
+    struct ViewDataTable : public IDataTable {
+        explicit ViewDataTable(TableInfo view);
+
+        /**
+         * TODO(Documentation)
+         */
+        cudf::size_type count() const override;
+
+        /**
+         * @brief Returns the view, or the info of the copy once one was made.
+         */
+        TableInfo get_info() const override;
+
+        /**
+         * @brief Copies the view and returns the Python DataFrame of the copy. Acquires the GIL.
+         */
+        const pybind11::object &get_py_object() const override;
+
+        /**
+         * @brief Copies the view and appends zero initialized columns to the copy.
+         */
+        void insert_columns(const std::vector<std::string> &column_names,
+                            const std::vector<TypeId> &column_types) const override;
+
+        /**
+         * @brief Bytes of the table the view was taken from, which it keeps alive, plus those of the copy once made.
+         */
+        std::size_t device_bytes() const override;
+
+        /**
+         * @brief Whether or not the rows have been copied.
+         */
+        bool is_owned() const;
+
+        /**
+         * @brief The table the view was taken from.
+         */
+        const std::shared_ptr<const IDataTable> &source() const;
+
+    private:
+        /**
+         * @brief Returns the copy of the view, making it on the first call.
+         */
+        std::shared_ptr<CppDataTable> owned() const;
+
+        // Kept after the copy is made, views returned by earlier calls to get_info still point into it
+        TableInfo m_view;
+
+        // Guards m_owned
+        mutable std::mutex m_mutex;
+        mutable std::shared_ptr<CppDataTable> m_owned;
+    };
+}  // namespace morpheus
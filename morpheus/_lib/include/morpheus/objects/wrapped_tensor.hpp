@@ -42,6 +42,21 @@ namespace morpheus {
 struct TensorObjectInterfaceProxy
 {
     static pybind11::dict cuda_array_interface(TensorObject &self);
+
+    /**
+     * @brief Implements `__dlpack__`, see `CupyUtil::to_dlpack`.
+     */
+    static pybind11::capsule dlpack(TensorObject &self, pybind11::object stream);
+
+    /**
+     * @brief Implements `__dlpack_device__`, returning the DLPack device type and the device id.
+     */
+    static pybind11::tuple dlpack_device(TensorObject &self);
+
+    /**
+     * @brief Creates a tensor from a DLPack capsule, or from any object implementing `__dlpack__`.
+     */
+    static TensorObject from_dlpack(pybind11::object obj);
 };
 #pragma GCC visibility pop
 }  // namespace morpheus
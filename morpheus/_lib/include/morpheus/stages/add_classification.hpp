@@ -19,12 +19,16 @@
 
 
 #include <morpheus/messages/multi_response_probs.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <neo/core/segment.hpp>
 #include <pyneo/node.hpp>
 
-#include <string>
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 
 namespace morpheus {
@@ -44,15 +48,21 @@ namespace morpheus {
         using base_t::writer_type_t;
 
         /**
-         * TODO(Documentation)
+         * @brief When `filter_threshold` is set, this stage also does the work of FilterDetectionsStage. Labels and
+         * detected rows are found in a single pass over probs, and only slices with a row above the filter
+         * threshold are emitted
          */
         AddClassificationsStage(const neo::Segment &parent,
                                 const std::string &name,
                                 float threshold,
                                 std::size_t num_class_labels,
-                                std::map<std::size_t, std::string> idx2label);
+                                std::map<std::size_t, std::string> idx2label,
+                                std::optional<float> filter_threshold = std::nullopt);
 
     private:
+        template<typename StageT>
+        friend class TypedFusedStageLink;
+
         /**
          * TODO(Documentation)
          */
@@ -61,6 +71,9 @@ namespace morpheus {
         float m_threshold;
         std::size_t m_num_class_labels;
         std::map<std::size_t, std::string> m_idx2label;
+        std::optional<float> m_filter_threshold;
+
+        std::shared_ptr<StageMetrics> m_metrics;
     };
 
     /****** AddClassificationStageInterfaceProxy******************/
@@ -78,7 +91,8 @@ namespace morpheus {
              const std::string &name,
              float threshold,
              std::size_t num_class_labels,
-             std::map<std::size_t, std::string> idx2label);
+             std::map<std::size_t, std::string> idx2label,
+             std::optional<float> filter_threshold = std::nullopt);
     };
 
 #pragma GCC visibility pop
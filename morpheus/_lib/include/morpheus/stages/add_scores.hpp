@@ -19,12 +19,15 @@
 
 
 #include <morpheus/messages/multi_response_probs.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <neo/core/segment.hpp>
 #include <pyneo/node.hpp>
 
-#include <string>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 
 namespace morpheus {
@@ -55,6 +58,8 @@ namespace morpheus {
 
         std::size_t m_num_class_labels;
         std::map<std::size_t, std::string> m_idx2label;
+
+        std::shared_ptr<StageMetrics> m_metrics;
     };
 
     /****** AddScoresStageInterfaceProxy******************/
@@ -0,0 +1,113 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** AdmissionStage********************************/
+    /**
+     * @brief Splits the rows of each message into priority lanes by the value of `key_column`, and emits the queued
+     * lane messages highest priority first, so high priority rows overtake a backlog of low priority ones. Lane `i`
+     * holds the rows whose key equals `lanes[i]`, a last lane holds the rows matching none of them and the rows of
+     * messages without the key column. Messages whose rows all fall in one lane are queued as they are, others are
+     * regrouped by lane with a single `cudf::partition`.
+     *
+     * Lanes from `protected_lanes` on can be shed: when their queue is full the oldest message is shed to make room,
+     * and when a message waited longer than `latency_slo_ms` in its queue it is shed on its way out. `shed_policy`
+     * "drop" sheds every such message, "sample" still emits `sample_fraction` of them. Protected lanes are never
+     * shed, a full protected lane blocks the input instead.
+     */
+#pragma GCC visibility push(default)
+    class AdmissionStage
+            : public neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>> {
+    public:
+        using base_t = neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>;
+        using base_t::operator_fn_t;
+        using base_t::reader_type_t;
+        using base_t::writer_type_t;
+
+        AdmissionStage(const neo::Segment &parent,
+                       const std::string &name,
+                       std::string key_column,
+                       std::vector<std::string> lanes,
+                       std::size_t lane_capacity,
+                       std::size_t protected_lanes,
+                       int32_t latency_slo_ms,
+                       std::string shed_policy,
+                       double sample_fraction);
+
+        /**
+         * @return number of rows shed from each lane, in lane order, the lane of unmatched rows last
+         */
+        std::vector<std::size_t> shed_counts() const;
+
+    private:
+        /**
+         * TODO(Documentation)
+         */
+        operator_fn_t build_operator();
+
+        std::string m_key_column;
+        std::vector<std::string> m_lanes;
+        std::size_t m_lane_capacity;
+        std::size_t m_protected_lanes;
+        int32_t m_latency_slo_ms;
+        bool m_sample;
+        double m_sample_fraction;
+
+        std::vector<std::atomic<std::size_t>> m_shed_rows;
+
+        std::shared_ptr<StageMetrics> m_metrics;
+    };
+
+    /****** AdmissionStageInterfaceProxy******************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings.
+     */
+    struct AdmissionStageInterfaceProxy {
+        /**
+         * @brief Create and initialize an AdmissionStage, and return the result.
+         */
+        static std::shared_ptr<AdmissionStage> init(neo::Segment &parent,
+                                                    const std::string &name,
+                                                    std::string key_column,
+                                                    std::vector<std::string> lanes,
+                                                    std::size_t lane_capacity,
+                                                    std::size_t protected_lanes,
+                                                    int32_t latency_slo_ms,
+                                                    std::string shed_policy,
+                                                    double sample_fraction);
+    };
+
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,101 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** AppShieldSourceStage********************************/
+/**
+ * @brief Reads the batches of AppShield plugin files found by the directory watcher of the Python
+ * `AppShieldSourceStage`. Files of a batch are parsed concurrently by `num_threads` threads, straight from a mapping
+ * of the file, and their nested `{"titles": [...], "data": [[...], ...]}` records flattened into the `cols_include`
+ * string columns, followed by the `snapshot_id`, `timestamp`, `source` and `plugin` columns taken from the path.
+ * Rows are grouped by source, emitting one `MessageMeta` per source of the batch, in the order they were first seen.
+ *
+ * Files whose plugin is not in `plugins_include` are never opened. Files which are not valid JSON are logged and
+ * skipped. `encoding` must be Latin-1 or UTF-8.
+ */
+#pragma GCC visibility push(default)
+class AppShieldSourceStage
+  : public neo::pyneo::PythonNode<std::vector<std::string>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::vector<std::string>, std::shared_ptr<MessageMeta>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    AppShieldSourceStage(const neo::Segment& parent,
+                         const std::string& name,
+                         std::vector<std::string> plugins_include,
+                         std::vector<std::string> cols_include,
+                         std::vector<std::string> cols_exclude,
+                         const std::string& encoding = "latin1",
+                         std::size_t num_threads     = 4);
+
+    /**
+     * @brief Parses the files of one batch, see the class description.
+     */
+    std::vector<std::shared_ptr<MessageMeta>> load_files(const std::vector<std::string>& filenames) const;
+
+  private:
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    std::vector<std::string> m_plugins_include;
+    std::vector<std::string> m_cols_include;
+    std::vector<std::string> m_cols_exclude;
+    bool m_latin1;
+    std::size_t m_num_threads;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** AppShieldSourceStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct AppShieldSourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize an AppShieldSourceStage, and return the result.
+     */
+    static std::shared_ptr<AppShieldSourceStage> init(neo::Segment& parent,
+                                                      const std::string& name,
+                                                      std::vector<std::string> plugins_include,
+                                                      std::vector<std::string> cols_include,
+                                                      std::vector<std::string> cols_exclude,
+                                                      const std::string& encoding,
+                                                      std::size_t num_threads);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
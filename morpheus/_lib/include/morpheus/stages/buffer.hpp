@@ -0,0 +1,94 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** BufferStage*****************************************/
+/**
+ * @brief Holds up to `count` messages between a fast upstream and a slow downstream, emitting them in order from a
+ * separate fiber. The tables held in device memory are kept under `device_memory_budget` bytes: a message arriving
+ * over the budget has its columns copied to pinned host memory and its device memory released. Spilled messages are
+ * copied back, in order, as soon as the budget allows, before the message ahead of them is handed to the downstream,
+ * so they are usually resident again by the time they are emitted.
+ *
+ * The upstream is only blocked when `count` messages are held, or when spilling would take the pinned host memory
+ * over `host_memory_budget` bytes. A budget of 0 is unlimited.
+ *
+ * Slices holding fewer than `compact_fraction` of the rows of the table they were taken from are copied into a table
+ * of their own on arrival, so buffering them does not keep the rest of that table alive. 0 disables compaction.
+ */
+#pragma GCC visibility push(default)
+class BufferStage : public neo::pyneo::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    BufferStage(const neo::Segment &parent,
+                const std::string &name,
+                std::size_t count,
+                std::size_t device_memory_budget,
+                std::size_t host_memory_budget = 0,
+                double compact_fraction        = 0.0);
+
+  private:
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    std::size_t m_count;
+    std::size_t m_device_memory_budget;
+    std::size_t m_host_memory_budget;
+    double m_compact_fraction;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** BufferStageInterfaceProxy***************************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct BufferStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a BufferStage, and return the result.
+     */
+    static std::shared_ptr<BufferStage> init(neo::Segment &parent,
+                                             const std::string &name,
+                                             std::size_t count,
+                                             std::size_t device_memory_budget,
+                                             std::size_t host_memory_budget,
+                                             double compact_fraction);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
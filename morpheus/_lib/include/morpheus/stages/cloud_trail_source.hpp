@@ -0,0 +1,113 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cudf/io/types.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** CloudTrailSourceStage*******************************/
+/**
+ * @brief Reads the batches of CloudTrail files found by the directory watcher of the Python `CloudTrailSourceStage`.
+ * Files are read by `num_threads` threads, inflated when gzipped, and their `Records[]`, or JSON lines, flattened
+ * like `pandas.json_normalize` with the dots removed from the column names. The flattened records of the whole batch
+ * are parsed at once by the cuDF JSON reader, then `userIdentityaccountId` is made a string, `event_dt` is parsed from
+ * `eventTime`, the rows are sorted by time and split by `user_column_name`, on the device.
+ *
+ * One `MessageMeta` is emitted per user of the batch, in the order of their first event, with the position of each
+ * record in its file in the `_index_` column, and an index continuing from the rows of the user emitted before.
+ * When `userid_filter` is not empty only that user is emitted.
+ */
+#pragma GCC visibility push(default)
+class CloudTrailSourceStage
+  : public neo::pyneo::PythonNode<std::vector<std::string>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::vector<std::string>, std::shared_ptr<MessageMeta>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    CloudTrailSourceStage(const neo::Segment &parent,
+                          const std::string &name,
+                          std::string user_column_name,
+                          std::string userid_filter = "",
+                          std::size_t repeat        = 1,
+                          std::size_t num_threads   = 4);
+
+    /**
+     * @brief Reads and flattens the records of `filenames` into a single table, with the `_index_` column first, and
+     * `event_dt` last when the records have an `eventTime`. Rows are in the order of the files, `repeat` is not
+     * applied. Returns an empty table when there are no records.
+     */
+    cudf::io::table_with_metadata read_records(const std::vector<std::string> &filenames) const;
+
+    /**
+     * @brief Reads one batch, see the class description.
+     */
+    std::vector<std::shared_ptr<MessageMeta>> load_files(const std::vector<std::string> &filenames);
+
+  private:
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    std::string m_user_column_name;
+    std::string m_userid_filter;
+    std::size_t m_repeat;
+    std::size_t m_num_threads;
+
+    // Rows emitted so far for each user, so their index keeps increasing across batches
+    std::map<std::string, int64_t> m_rows_per_user;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** CloudTrailSourceStageInterfaceProxy*****************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct CloudTrailSourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a CloudTrailSourceStage, and return the result.
+     */
+    static std::shared_ptr<CloudTrailSourceStage> init(neo::Segment &parent,
+                                                       const std::string &name,
+                                                       std::string user_column_name,
+                                                       std::string userid_filter,
+                                                       std::size_t repeat,
+                                                       std::size_t num_threads);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
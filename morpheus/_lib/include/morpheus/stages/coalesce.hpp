@@ -0,0 +1,79 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** CoalesceStage********************************/
+    /**
+     * @brief Merges small messages into messages of up to `batch_size` rows by concatenating their rows into a new
+     * MessageMeta. Buffered rows are emitted once adding the next message would exceed `batch_size`, once
+     * `timeout_ms` has passed since the oldest buffered message arrived, or when the input completes. Messages which
+     * already hold `batch_size` rows, and messages whose columns differ from the buffered ones, are never merged.
+     */
+#pragma GCC visibility push(default)
+    class CoalesceStage
+            : public neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>> {
+    public:
+        using base_t = neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>;
+        using base_t::operator_fn_t;
+        using base_t::reader_type_t;
+        using base_t::writer_type_t;
+
+        CoalesceStage(const neo::Segment &parent, const std::string &name, std::size_t batch_size, int32_t timeout_ms);
+
+    private:
+        /**
+         * TODO(Documentation)
+         */
+        operator_fn_t build_operator();
+
+        std::size_t m_batch_size;
+        int32_t m_timeout_ms;
+
+        std::shared_ptr<StageMetrics> m_metrics;
+    };
+
+    /****** CoalesceStageInterfaceProxy******************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings.
+     */
+    struct CoalesceStageInterfaceProxy {
+        /**
+         * @brief Create and initialize a CoalesceStage, and return the result.
+         */
+        static std::shared_ptr<CoalesceStage> init(neo::Segment &parent,
+                                                   const std::string &name,
+                                                   std::size_t batch_size,
+                                                   int32_t timeout_ms);
+    };
+
+#pragma GCC visibility pop
+}  // namespace morpheus
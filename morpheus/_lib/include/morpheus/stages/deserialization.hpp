@@ -20,6 +20,7 @@
 
 #include <morpheus/messages/meta.hpp>
 #include <morpheus/messages/multi.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <neo/core/segment.hpp>
 #include <pyneo/node.hpp>
@@ -46,12 +47,17 @@ namespace morpheus {
         DeserializeStage(const neo::Segment &parent, const std::string &name, size_t batch_size);
 
     private:
+        template<typename StageT>
+        friend class TypedFusedStageLink;
+
         /**
          * TODO(Documentation)
          */
         operator_fn_t build_operator();
 
         size_t m_batch_size;
+
+        std::shared_ptr<StageMetrics> m_metrics;
     };
 
     /****** DeserializationStageInterfaceProxy******************/
@@ -0,0 +1,81 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <memory>
+#include <string>
+
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** DropNullStage***************************************/
+    /**
+     * @brief Drops the rows of every message where `column` is null, using `cudf::drop_nulls` on the table of the
+     * message. Messages without nulls in the column are passed through unchanged, and messages left without any rows
+     * are not emitted. The new messages get a fresh range index unless the table has index columns.
+     */
+#pragma GCC visibility push(default)
+    class DropNullStage
+            : public neo::pyneo::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>> {
+    public:
+        using base_t = neo::pyneo::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+        using base_t::operator_fn_t;
+        using base_t::reader_type_t;
+        using base_t::writer_type_t;
+
+        DropNullStage(const neo::Segment &parent, const std::string &name, std::string column);
+
+    private:
+        template<typename StageT>
+        friend class TypedFusedStageLink;
+
+        /**
+         * TODO(Documentation)
+         */
+        operator_fn_t build_operator();
+
+        /**
+         * @brief Returns `meta` without the rows where `m_column` is null, or nullptr if no rows remain.
+         */
+        std::shared_ptr<MessageMeta> drop_nulls(std::shared_ptr<MessageMeta> meta) const;
+
+        std::string m_column;
+
+        std::shared_ptr<StageMetrics> m_metrics;
+    };
+
+    /****** DropNullStageInterfaceProxy*************************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings.
+     */
+    struct DropNullStageInterfaceProxy {
+        /**
+         * @brief Create and initialize a DropNullStage, and return the result.
+         */
+        static std::shared_ptr<DropNullStage> init(neo::Segment &parent, const std::string &name, std::string column);
+    };
+
+#pragma GCC visibility pop
+}  // namespace morpheus
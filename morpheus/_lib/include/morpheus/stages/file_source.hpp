@@ -17,12 +17,19 @@
 
 #pragma once
 
+#include <morpheus/io/mapped_file.hpp>
 #include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
 
 #include <pyneo/node.hpp>
 
+#include <cudf/io/types.hpp>
+
+#include <cstddef>
+#include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 
 namespace morpheus {
@@ -37,17 +44,63 @@ namespace morpheus {
         using base_t = neo::pyneo::PythonSource<std::shared_ptr<MessageMeta>>;
         using base_t::source_type_t;
 
-        FileSourceStage(const neo::Segment &parent, const std::string &name, std::string filename, int repeat = 1);
+        /**
+         * @brief Reads `filename` and emits it `repeat` times.
+         *
+         * @param chunk_bytes When greater than 0 the file is read in byte ranges of this size and every range is
+         * emitted as its own message as soon as it has been read, so device memory use is proportional to
+         * `chunk_bytes` rather than the size of the file. Rows are never split, the index continues across chunks and
+         * repeats, and every chunk is cast to the column types inferred for the first one. 0 reads the whole file at
+         * once.
+         * @param use_mmap Read through a read only mapping of the file rather than buffered reads. The file is mapped
+         * once for all repeats and chunks and cuDF parses the mapped pages directly, so a file replayed repeatedly is
+         * served from the page cache without being copied into a host buffer first.
+         * @param output_columns Output columns of this pipeline, mapping names to numpy type strings, created in every
+         * message. See `MessageMeta::reserve_columns`.
+         */
+        FileSourceStage(const neo::Segment &parent,
+                        const std::string &name,
+                        std::string filename,
+                        int repeat              = 1,
+                        std::size_t chunk_bytes = 0,
+                        bool use_mmap           = false,
+                        std::map<std::string, std::string> output_columns = {});
 
     private:
+        /**
+         * @brief Emits the whole file `m_repeat` times.
+         */
+        void emit_table(neo::Subscriber<source_type_t> &sub);
+
+        /**
+         * @brief Emits the file `m_chunk_bytes` at a time.
+         */
+        void emit_chunks(neo::Subscriber<source_type_t> &sub);
+
+        /**
+         * @brief Reads the rows starting within `m_chunk_bytes` of `offset`. CSV chunks after the first have no header
+         * and are named `column_names`.
+         */
+        cudf::io::table_with_metadata load_chunk(std::size_t offset, const std::vector<std::string> &column_names);
 
         /**
          * TODO(Documentation)
          */
         cudf::io::table_with_metadata load_table();
 
+        /**
+         * @brief The mapped file while a run holds one, otherwise the filename.
+         */
+        cudf::io::source_info make_source_info() const;
+
         std::string m_filename;
         int m_repeat{1};
+        std::size_t m_chunk_bytes{0};
+        bool m_use_mmap{false};
+        std::vector<std::string> m_output_column_names;
+        std::vector<TypeId> m_output_column_types;
+
+        std::unique_ptr<MappedFile> m_mapped_file;
     };
 
 
@@ -59,8 +112,13 @@ namespace morpheus {
         /**
          * @brief Create and initialize a FileSourceStage, and return the result.
          */
-        static std::shared_ptr<FileSourceStage>
-        init(neo::Segment &parent, const std::string &name, std::string filename, int repeat = 1);
+        static std::shared_ptr<FileSourceStage> init(neo::Segment &parent,
+                                                     const std::string &name,
+                                                     std::string filename,
+                                                     int repeat              = 1,
+                                                     std::size_t chunk_bytes = 0,
+                                                     bool use_mmap           = false,
+                                                     std::map<std::string, std::string> output_columns = {});
     };
 #pragma GCC visibility pop
 } // Morpheus
\ No newline at end of file
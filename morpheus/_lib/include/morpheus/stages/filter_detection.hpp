@@ -19,6 +19,7 @@
 
 
 #include <morpheus/messages/multi_response_probs.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <neo/core/segment.hpp>
 #include <pyneo/node.hpp>
@@ -43,13 +44,23 @@ namespace morpheus {
         using base_t::reader_type_t;
         using base_t::writer_type_t;
 
-        FilterDetectionsStage(const neo::Segment &parent, const std::string &name, float threshold);
+        /**
+         * @brief By default each contiguous run of detected rows is emitted as a slice of the input message. When
+         * `copy` is true the detected rows are instead compacted on the device into a single new message
+         */
+        FilterDetectionsStage(const neo::Segment &parent, const std::string &name, float threshold, bool copy = false);
 
     private:
+        template<typename StageT>
+        friend class TypedFusedStageLink;
+
         operator_fn_t build_operator();
 
         float m_threshold;
+        bool m_copy;
         std::size_t m_num_class_labels;
+
+        std::shared_ptr<StageMetrics> m_metrics;
         std::map<std::size_t, std::string> m_idx2label;
     };
 
@@ -63,7 +74,7 @@ namespace morpheus {
          * @brief Create and initialize a FilterDetectionStage, and return the result.
          */
         static std::shared_ptr<FilterDetectionsStage>
-        init(neo::Segment &parent, const std::string &name, float threshold);
+        init(neo::Segment &parent, const std::string &name, float threshold, bool copy = false);
     };
 
 #pragma GCC visibility pop
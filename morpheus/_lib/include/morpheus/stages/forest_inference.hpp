@@ -0,0 +1,81 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/messages/multi_inference.hpp>
+#include <morpheus/messages/multi_response_probs.hpp>
+#include <morpheus/objects/forest_model.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** ForestInferenceStage********************************/
+/**
+ * @brief In-process alternative to `InferenceClientStage` for small tree models. Evaluates a `ForestModel` on the
+ * `input__0` tensor of each message directly on the GPU, without copying the inputs to the host or sending them to
+ * a server, and writes the predictions to the `probs` output. The model is loaded onto the current device when the
+ * stage is created.
+ */
+#pragma GCC visibility push(default)
+class ForestInferenceStage
+  : public neo::pyneo::PythonNode<std::shared_ptr<MultiInferenceMessage>, std::shared_ptr<MultiResponseProbsMessage>>
+{
+  public:
+    using base_t =
+        neo::pyneo::PythonNode<std::shared_ptr<MultiInferenceMessage>, std::shared_ptr<MultiResponseProbsMessage>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    ForestInferenceStage(const neo::Segment &parent, const std::string &name, const std::string &model_filename);
+
+  private:
+    template <typename StageT>
+    friend class TypedFusedStageLink;
+
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    std::shared_ptr<ForestModel> m_model;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** ForestInferenceStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct ForestInferenceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a ForestInferenceStage, and return the result.
+     */
+    static std::shared_ptr<ForestInferenceStage> init(neo::Segment &parent,
+                                                      const std::string &name,
+                                                      const std::string &model_filename);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
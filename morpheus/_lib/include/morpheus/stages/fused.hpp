@@ -0,0 +1,278 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/messages/multi_inference.hpp>
+#include <morpheus/messages/multi_response.hpp>
+#include <morpheus/messages/multi_response_probs.hpp>
+
+#include <neo/core/segment.hpp>
+#include <neo/core/segment_object.hpp>
+#include <pyneo/node.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** FusedStageMessage *********************************/
+    /**
+     * @brief Every message type a fusable C++ stage consumes or produces. Messages are moved between the stages of a
+     * `FusedStage` as one of these, keeping the type the producing stage declared.
+     */
+    using FusedStageMessage = std::variant<std::shared_ptr<MessageMeta>,
+                                           std::shared_ptr<MultiMessage>,
+                                           std::shared_ptr<MultiInferenceMessage>,
+                                           std::shared_ptr<MultiResponseMessage>,
+                                           std::shared_ptr<MultiResponseProbsMessage>>;
+
+    /**
+     * @brief Names of the `FusedStageMessage` alternatives, in order.
+     */
+    constexpr std::array<const char *, std::variant_size_v<FusedStageMessage>> FusedStageMessageNames = {
+            "MessageMeta", "MultiMessage", "MultiInferenceMessage", "MultiResponseMessage", "MultiResponseProbsMessage"};
+
+    /**
+     * @brief Index of `MessageT` in `FusedStageMessage`. Fails to compile for types which are not alternatives.
+     */
+    template<typename MessageT, std::size_t Index = 0>
+    constexpr std::size_t fused_message_index() {
+        if constexpr (std::is_same_v<MessageT, std::variant_alternative_t<Index, FusedStageMessage>>) {
+            return Index;
+        } else {
+            return fused_message_index<MessageT, Index + 1>();
+        }
+    }
+
+    /**
+     * @brief Moves the message held by `message` out as `MessageT`. Conversions to a base class are moves, conversions
+     * to a derived class, such as the `MultiResponseMessage` declared by `InferenceClientStage` to the
+     * `MultiResponseProbsMessage` it actually emits, are checked with a dynamic cast.
+     */
+    template<typename MessageT>
+    MessageT fused_message_cast(FusedStageMessage &&message) {
+        using target_t = typename MessageT::element_type;
+
+        return std::visit(
+                [](auto &&held) -> MessageT {
+                    using held_t = typename std::decay_t<decltype(held)>::element_type;
+
+                    if constexpr (std::is_base_of_v<target_t, held_t>) {
+                        return MessageT(std::move(held));
+                    } else {
+                        if constexpr (std::is_base_of_v<held_t, target_t>) {
+                            if (auto cast = std::dynamic_pointer_cast<target_t>(held); cast) {
+                                // Downstream stages may rely on holding the only reference
+                                held.reset();
+                                return cast;
+                            }
+                        }
+
+                        throw std::runtime_error(
+                                std::string("Fused stage expected a ") +
+                                FusedStageMessageNames[fused_message_index<MessageT>()] + " but received a " +
+                                FusedStageMessageNames[fused_message_index<std::shared_ptr<held_t>>()]);
+                    }
+                },
+                std::move(message));
+    }
+
+    /****** FusedStageLink ************************************/
+    /**
+     * @brief One stage of a `FusedStage`, which runs the operator of a C++ stage that was never registered as a node.
+     */
+    class FusedStageLink {
+    public:
+        using stream_t = neo::Observable<FusedStageMessage>;
+
+        virtual ~FusedStageLink() = default;
+
+        /**
+         * @brief `FusedStageMessage` index of the messages the stage consumes.
+         */
+        virtual std::size_t input_index() const = 0;
+
+        /**
+         * @brief `FusedStageMessage` index of the messages the stage produces.
+         */
+        virtual std::size_t output_index() const = 0;
+
+        /**
+         * @brief Returns `input` passed through the operator of the stage. Every message the stage emits is handed to
+         * the subscriber of the returned stream by a direct call, there is no channel in between.
+         */
+        virtual std::shared_ptr<stream_t> apply(std::shared_ptr<stream_t> input) const = 0;
+    };
+
+    /****** TypedFusedStageLink *******************************/
+    /**
+     * @brief `FusedStageLink` for a stage of type `StageT`, which must either make `build_operator` public or befriend
+     * this class.
+     */
+    template<typename StageT>
+    class TypedFusedStageLink : public FusedStageLink {
+    public:
+        using reader_type_t = typename StageT::reader_type_t;
+        using writer_type_t = typename StageT::writer_type_t;
+
+        explicit TypedFusedStageLink(std::shared_ptr<StageT> stage) :
+                m_stage(std::move(stage)),
+                m_operator(m_stage->build_operator()) {}
+
+        std::size_t input_index() const override {
+            return fused_message_index<reader_type_t>();
+        }
+
+        std::size_t output_index() const override {
+            return fused_message_index<writer_type_t>();
+        }
+
+        std::shared_ptr<stream_t> apply(std::shared_ptr<stream_t> input) const override {
+            auto typed_input = std::make_shared<neo::Observable<reader_type_t>>(
+                    [input](neo::Subscriber<reader_type_t> &sub) {
+                        input->subscribe(neo::make_observer<FusedStageMessage>(
+                                [&sub](FusedStageMessage &&x) {
+                                    sub.on_next(fused_message_cast<reader_type_t>(std::move(x)));
+                                },
+                                [&sub](std::exception_ptr error_ptr) { sub.on_error(error_ptr); },
+                                [&sub]() { sub.on_completed(); }));
+                    });
+
+            // The operator subscribes to `typed_input` and emits straight into the subscriber of `typed_output`
+            auto typed_output = std::make_shared<neo::Observable<writer_type_t>>(
+                    [typed_input, op = m_operator](neo::Subscriber<writer_type_t> &sub) { op(*typed_input, sub); });
+
+            return std::make_shared<stream_t>([typed_output](neo::Subscriber<FusedStageMessage> &sub) {
+                typed_output->subscribe(neo::make_observer<writer_type_t>(
+                        [&sub](writer_type_t &&x) { sub.on_next(FusedStageMessage(std::move(x))); },
+                        [&sub](std::exception_ptr error_ptr) { sub.on_error(error_ptr); },
+                        [&sub]() { sub.on_completed(); }));
+            });
+        }
+
+    private:
+        // Keeps the stage alive, its operator refers to it
+        std::shared_ptr<StageT> m_stage;
+        typename StageT::operator_fn_t m_operator;
+    };
+
+    /****** FusedStage ****************************************/
+    /**
+     * @brief Runs the operators of several consecutive C++ stages in a single node. Each stage hands its output to the
+     * next one with a direct call, instead of through a channel and, when a python stage is not in between, without
+     * changing threads. Created by `FusedStageBuilder`, which instantiates it for the input type of the first stage and
+     * the output type of the last one.
+     *
+     * When given `device_ids`, the concurrent instances of the chain take the devices in turn, so each GPU runs its own
+     * copy of the chain on the messages it pulls from the shared input channel. Instances rebind their thread to their
+     * device before every stage, as fibers of instances on other devices may share it.
+     */
+#pragma GCC visibility push(default)
+    template<typename InputT, typename OutputT>
+    class FusedStage : public neo::pyneo::PythonNode<InputT, OutputT> {
+    public:
+        using base_t = neo::pyneo::PythonNode<InputT, OutputT>;
+        using typename base_t::operator_fn_t;
+        using typename base_t::reader_type_t;
+        using typename base_t::writer_type_t;
+
+        FusedStage(const neo::Segment &parent,
+                   const std::string &name,
+                   std::vector<std::shared_ptr<FusedStageLink>> links,
+                   std::vector<int> device_ids = {});
+
+    private:
+        /**
+         * TODO(Documentation)
+         */
+        operator_fn_t build_operator();
+
+        std::vector<std::shared_ptr<FusedStageLink>> m_links;
+        std::vector<int> m_device_ids;
+        std::atomic<std::size_t> m_next_instance{0};
+    };
+
+    /****** FusedStageBuilder *********************************/
+    /**
+     * @brief Collects the stages of a `FusedStage`. While a builder is capturing, fusable stages created on the same
+     * thread are added to it by `register_node` instead of being registered with their segment.
+     */
+    class FusedStageBuilder {
+    public:
+        ~FusedStageBuilder();
+
+        /**
+         * @brief Starts capturing stages on the calling thread. Only one builder can capture per thread.
+         */
+        void begin_capture();
+
+        /**
+         * @brief Stops capturing stages.
+         */
+        void end_capture();
+
+        /**
+         * @brief Number of stages captured so far.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Creates and registers the `FusedStage` running every captured stage in the order they were created.
+         * Throws `std::invalid_argument` if nothing was captured, or if a stage can not consume the messages of the
+         * stage before it. Non empty `device_ids` spread the concurrent instances of the stage across those devices.
+         */
+        std::shared_ptr<neo::SegmentObject> build(neo::Segment &parent,
+                                                  const std::string &name,
+                                                  std::vector<int> device_ids = {});
+
+        /**
+         * @brief Called by the interface proxies of fusable stages instead of `neo::Segment::register_node`. Registers
+         * `stage` with `parent` unless a builder is capturing on this thread, in which case it becomes the next stage
+         * of that builder.
+         */
+        template<typename StageT>
+        static void register_node(neo::Segment &parent, std::shared_ptr<StageT> stage) {
+            auto *builder = FusedStageBuilder::capturing();
+
+            if (builder == nullptr) {
+                parent.register_node<StageT>(stage);
+                return;
+            }
+
+            builder->m_links.emplace_back(std::make_shared<TypedFusedStageLink<StageT>>(std::move(stage)));
+        }
+
+    private:
+        static FusedStageBuilder *capturing();
+
+        std::vector<std::shared_ptr<FusedStageLink>> m_links;
+    };
+#pragma GCC visibility pop
+}  // namespace morpheus
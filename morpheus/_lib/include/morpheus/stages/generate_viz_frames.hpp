@@ -0,0 +1,109 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/multi_response_probs.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+struct GenerateVizFramesStage__State;
+
+/****** Component public implementations *******************/
+/****** GenerateVizFramesStage******************************/
+/**
+ * @brief Writes the visualization frames of the Python `GenerateVizFramesStage` as Arrow IPC, passing every message
+ * through unchanged. The `timestamp`, `src_ip`, `dest_ip`, `src_port`, `dest_port` and `data` columns are selected
+ * from the message, and `si` is set on the device to the label of the largest probability of each row, or `none`
+ * when no probability reaches 0.5. `labels` holds the label of every column of `probs`.
+ *
+ * Rows are grouped into one frame per second of `timestamp` (milliseconds), sorted by time. A second is written once
+ * a later second has been seen, the remaining ones when the input completes. Rows arriving after their second was
+ * written make another frame for the same second.
+ *
+ * When `out_socket` is empty every frame is written to `out_dir` as an Arrow IPC file named after its offset in
+ * seconds from the first frame, like `2.0.arrow`, with a counter appended for the extra frames of a second. Otherwise
+ * `out_socket`, as `host:port`, is connected to and a single Arrow IPC stream is written to it, one record batch per
+ * frame.
+ */
+#pragma GCC visibility push(default)
+class GenerateVizFramesStage
+  : public neo::pyneo::PythonNode<std::shared_ptr<MultiResponseProbsMessage>,
+                                  std::shared_ptr<MultiResponseProbsMessage>>
+{
+  public:
+    using base_t =
+        neo::pyneo::PythonNode<std::shared_ptr<MultiResponseProbsMessage>, std::shared_ptr<MultiResponseProbsMessage>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    GenerateVizFramesStage(const neo::Segment &parent,
+                           const std::string &name,
+                           std::string out_dir,
+                           std::string out_socket,
+                           std::vector<std::string> labels);
+
+  private:
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    /**
+     * @brief Adds the rows of `x` to the pending frames of `state`.
+     */
+    void add_rows(GenerateVizFramesStage__State &state, MultiResponseProbsMessage &x) const;
+
+    /**
+     * @brief Writes the pending frames of the seconds before `before`, every pending frame when `all` is set.
+     */
+    void write_frames(GenerateVizFramesStage__State &state, int64_t before, bool all) const;
+
+    std::string m_out_dir;
+    std::string m_out_socket;
+    std::vector<std::string> m_labels;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** GenerateVizFramesStageInterfaceProxy****************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct GenerateVizFramesStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a GenerateVizFramesStage, and return the result.
+     */
+    static std::shared_ptr<GenerateVizFramesStage> init(neo::Segment &parent,
+                                                        const std::string &name,
+                                                        std::string out_dir,
+                                                        std::string out_socket,
+                                                        std::vector<std::string> labels);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -18,16 +18,29 @@
 #pragma once
 
 #include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/kafka_message_decoder.hpp>
+#include <morpheus/stages/kafka_source_detail.hpp>
+#include <morpheus/utilities/pipeline_drain.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
 
 #include <neo/core/fiber_meta_data.hpp>
 #include <neo/core/task_queue.hpp>
 #include <pyneo/node.hpp>
 
 #include <cudf/io/types.hpp>
+#include <cudf/types.hpp>
 #include <librdkafka/rdkafkacpp.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 
@@ -44,14 +57,76 @@ namespace morpheus {
         using base_t = neo::pyneo::PythonSource<std::shared_ptr<MessageMeta>>;
         using base_t::source_type_t;
 
+        /**
+         * @param commit_on_completion Commit the offsets of a batch once every message created from it has been
+         * released downstream, rather than as soon as it was emitted. A crash then only replays batches which had not
+         * finished. Offsets are committed in order, so a slow batch holds back the commits of later ones. A batch
+         * failed downstream is logged and committed past. Only used when commits are not disabled and
+         * 'enable.auto.commit' is false. When the pipeline is drained, see
+         * `PipelineDrain`, the source completes first and keeps committing until every batch completed.
+         * @param topics Topics to subscribe to. Entries starting with '^' are regular expressions matched against
+         * every topic of the cluster, and topics created later, by librdkafka.
+         * @param topic_column When not empty, every row gets a string column of this name holding the topic it was
+         * read from, so one pipeline can serve several topics.
+         * @param start_timestamp_ms When not negative, every assigned partition starts at its first message stamped at
+         * or after this time, in milliseconds since the epoch, instead of its committed offset.
+         * @param start_offsets Offsets to start at keyed by "<topic>:<partition>". Takes precedence over
+         * `start_timestamp_ms` for the partitions listed.
+         * @param stop_timestamp_ms When not negative, a partition stops at its first message stamped at or after this
+         * time, or once it is caught up when that time has passed. The source completes once every partition stopped.
+         * Setting any of the replay options disables commits.
+         * @param device_id When not negative, the consumer thread and the threads running partition fibers and parse
+         * tasks use this CUDA device and are bound to the CPUs of the NUMA node closest to it, so batches are parsed
+         * and staged in pinned memory on the same socket as the GPU.
+         * @param drop_null_column When not empty, rows where this column is null are dropped with `cudf::drop_nulls`
+         * while the batch table is built, so a separate DropNullStage is not needed. Batches left without rows are not
+         * emitted.
+         * @param output_columns Output columns of this pipeline, mapping names to numpy type strings, created in every
+         * batch table so writing them never rebuilds the table or takes the GIL. See `MessageMeta::reserve_columns`.
+         * @param schema Column types, mapping names to JSON reader type names like "int64", "float64", "bool" or "str",
+         * given to `cudf::io::read_json` so batches skip type inference. Every batch has these columns, in this order,
+         * followed by any other payload fields. Columns missing from a batch are filled with nulls.
+         * @param schema_batches When `schema` is empty and this is above 0, the schema is learned from the first
+         * `schema_batches` batches and then frozen. Columns seen with different types are widened to int64, float64 or
+         * str. Columns which were always null while learning are left out of the schema.
+         * @param message_format Format of the message payloads, see `KafkaMessageDecoder::create`. The JSON pre-filter
+         * and the schema options only apply to "json".
+         * @param avro_schema Writer schema of Avro payloads, as Avro JSON.
+         * @param schema_registry_url Confluent schema registry used to look up the writer schemas of "avro-confluent"
+         * payloads.
+         * @param metadata_columns Columns filled from the metadata of each message rather than its payload, any of
+         * "_key" (string), "_ts" (timestamp in milliseconds), "_partition" (int32) and "_offset" (int64). Keys and
+         * timestamps are null when the message has none. Replace payload fields of the same name.
+         * @param max_in_flight_batches When above 0, partitions are paused once this many emitted batches are still
+         * held downstream, and resumed once half of them were released. librdkafka then stops fetching for them, so
+         * host memory stays bounded under overload. Must be above the number of batches downstream stages hold on to,
+         * like a BufferStage.
+         */
         KafkaSourceStage(const neo::Segment &parent,
                          const std::string &name,
                          size_t max_batch_size,
-                         std::string topic,
+                         std::vector<std::string> topics,
                          int32_t batch_timeout_ms,
                          std::map<std::string, std::string> config,
                          bool disable_commit = false,
-                         bool disable_pre_filtering = false);
+                         bool disable_pre_filtering = false,
+                         std::size_t max_batch_bytes = 0,
+                         bool adaptive_batching = false,
+                         bool commit_on_completion = false,
+                         std::string topic_column = "",
+                         int64_t start_timestamp_ms = -1,
+                         std::map<std::string, int64_t> start_offsets = {},
+                         int64_t stop_timestamp_ms = -1,
+                         int32_t device_id = -1,
+                         std::string drop_null_column = "",
+                         std::map<std::string, std::string> output_columns = {},
+                         std::map<std::string, std::string> schema = {},
+                         std::size_t schema_batches = 0,
+                         const std::string &message_format = "json",
+                         const std::string &avro_schema = "",
+                         const std::string &schema_registry_url = "",
+                         std::vector<std::string> metadata_columns = {},
+                         std::size_t max_in_flight_batches = 0);
 
         ~KafkaSourceStage() override = default;
 
@@ -66,21 +141,79 @@ namespace morpheus {
          */
         int32_t batch_timeout_ms();
 
+        /**
+         * @return maximum number of payload bytes in a batch, 0 if unlimited
+         */
+        std::size_t max_batch_bytes();
+
+        /**
+         * @return number of messages dropped by the json pre-filter
+         */
+        std::size_t rejected_message_count();
+
+        /**
+         * @return number of emitted batches still held downstream, only counted when `max_in_flight_batches` is set
+         */
+        std::size_t in_flight_batch_count();
+
+        /**
+         * @brief Replaces the decoder of the message payloads, nullptr parses them as JSON. Lets formats without a
+         * built-in decoder be plugged in from C++. Must be called before the pipeline starts.
+         */
+        void set_decoder(std::shared_ptr<KafkaMessageDecoder> decoder);
+
     private:
         /**
          * TODO(Documentation)
          */
         void start() override;
 
+        /**
+         * @brief Whether downstream holds too many batches for a partition to keep fetching. `paused` tells whether
+         * the partition is already paused, which lowers the threshold.
+         */
+        bool is_overloaded(bool paused);
+
+        /**
+         * @brief Number of messages a partition accumulates before emitting a batch. Equal to `max_batch_size()`
+         * unless adaptive batching is enabled.
+         */
+        std::size_t batch_size_target();
+
+        /**
+         * @brief Grows the batch size target when emitting a batch blocked on downstream and shrinks it otherwise.
+         */
+        void update_batch_size_target(std::chrono::nanoseconds emit_duration);
+
         /**
          * TODO(Documentation)
          */
         std::unique_ptr<RdKafka::Conf> build_kafka_conf(const std::map<std::string, std::string> &config_in);
 
         /**
-         * TODO(Documentation)
+         * @brief Starts the fiber of one partition on the task queue picked by `home_queue`. Partitions are spread
+         * across the queues in the order they were assigned.
+         */
+        neo::SharedFuture<bool> launch_task(std::size_t home_queue, std::function<bool()> &&task);
+
+        /**
+         * @brief Whether any of the replay options were set.
+         */
+        bool is_replay() const;
+
+        /**
+         * @brief Moves newly assigned partitions to their replay start offsets. Partitions without a start offset or
+         * start timestamp keep their committed offsets.
          */
-        neo::SharedFuture<bool> launch_tasks(std::vector<std::function<bool()>> &&tasks);
+        void seek_to_start(RdKafka::KafkaConsumer *consumer, std::vector<RdKafka::TopicPartition *> &partitions);
+
+        /**
+         * @brief Runs a task parsing one partition batch. The task stays on `home_queue`, the queue running the
+         * partition, unless that queue is noticeably busier than the least loaded one, in which case it moves there.
+         * Partitions wait on these futures in the order their batches were consumed, so moving a task never reorders
+         * a partition.
+         */
+        neo::SharedFuture<bool> dispatch_batch_task(std::size_t home_queue, std::function<bool()> &&task);
 
         /**
          * TODO(Documentation)
@@ -90,10 +223,16 @@ namespace morpheus {
         /**
          * TODO(Documentation)
          */
-        cudf::io::table_with_metadata load_table(const std::string &buffer);
+        cudf::io::table_with_metadata load_table(const char *buffer, std::size_t size);
 
         /**
-         * TODO(Documentation)
+         * @brief Merges the column types of a batch parsed without a schema. Freezes the schema once `m_schema_batches`
+         * batches were merged
+         */
+        void learn_schema(const cudf::io::table_with_metadata &table);
+
+        /**
+         * @brief Parses a batch of messages into a MessageMeta. Returns nullptr if no messages remain after filtering
          */
         std::shared_ptr<morpheus::MessageMeta>
         process_batch(std::vector<std::unique_ptr<RdKafka::Message>> &&message_batch);
@@ -101,13 +240,41 @@ namespace morpheus {
         size_t m_max_batch_size{128};
         uint32_t m_batch_timeout_ms{100};
 
-        std::string m_topic{"test_pcap"};
+        std::vector<std::string> m_topics{"test_pcap"};
+        std::string m_topic_column;
+        int64_t m_start_timestamp_ms{-1};
+        std::map<std::string, int64_t> m_start_offsets;
+        int64_t m_stop_timestamp_ms{-1};
+        int32_t m_device_id{-1};
+        std::string m_drop_null_column;
+        std::vector<std::string> m_metadata_columns;
+        std::size_t m_max_in_flight_batches{0};
+        std::shared_ptr<std::atomic<std::size_t>> m_in_flight_batches;  // Batches emitted and not yet released
+        std::shared_ptr<DrainProgress> m_drain_progress;
+        std::vector<std::string> m_output_column_names;
+        std::vector<TypeId> m_output_column_types;
         std::map<std::string, std::string> m_config;
 
+        // Column types read batches are pinned to. Learned in `m_learned_schema` until `m_frozen_schema` is set
+        std::mutex m_schema_mutex;
+        std::shared_ptr<const std::vector<std::pair<std::string, cudf::type_id>>> m_frozen_schema;
+        std::vector<std::pair<std::string, cudf::type_id>> m_learned_schema;
+        std::size_t m_schema_batches{0};
+        std::size_t m_schema_batches_seen{0};
+
+        // Decodes binary payloads in place of the JSON reader when set
+        std::shared_ptr<KafkaMessageDecoder> m_decoder;
+
         bool m_disable_commit{false};
         bool m_disable_pre_filtering{false};
         bool m_requires_commit{false};  // Whether or not manual committing is required
+        std::size_t m_max_batch_bytes{0};
+        bool m_adaptive_batching{false};
+        bool m_commit_on_completion{false};
+        std::atomic<std::size_t> m_batch_size_target;
+        std::atomic<std::size_t> m_rejected_message_count{0};
         std::vector<std::shared_ptr<neo::TaskQueue<neo::FiberMetaData>>> m_task_queues;
+        KafkaTaskQueueLoads m_task_queue_loads;  // Parse tasks queued or running on each queue
 
         void *m_rebalancer;
     };
@@ -124,11 +291,28 @@ namespace morpheus {
                 neo::Segment &parent,
                 const std::string &name,
                 size_t max_batch_size,
-                std::string topic,
+                std::vector<std::string> topics,
                 int32_t batch_timeout_ms,
                 std::map<std::string, std::string> config,
                 bool disable_commits,
-                bool disable_pre_filtering);
+                bool disable_pre_filtering,
+                std::size_t max_batch_bytes,
+                bool adaptive_batching,
+                bool commit_on_completion,
+                std::string topic_column,
+                int64_t start_timestamp_ms,
+                std::map<std::string, int64_t> start_offsets,
+                int64_t stop_timestamp_ms,
+                int32_t device_id,
+                std::string drop_null_column,
+                std::map<std::string, std::string> output_columns,
+                std::map<std::string, std::string> schema,
+                std::size_t schema_batches,
+                const std::string &message_format,
+                const std::string &avro_schema,
+                const std::string &schema_registry_url,
+                std::vector<std::string> metadata_columns,
+                std::size_t max_in_flight_batches);
     };
 #pragma GCC visibility pop
 }
\ No newline at end of file
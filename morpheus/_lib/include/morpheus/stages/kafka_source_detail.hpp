@@ -0,0 +1,497 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Pieces of KafkaSourceStage which do not need a broker, kept here so they can be tested on their own
+namespace morpheus {
+    /****** KafkaTopicUtil *************************************/
+    struct KafkaTopicUtil {
+        /**
+         * @brief Whether `topic` is a regular expression subscription, which librdkafka marks with a leading '^'.
+         */
+        static bool is_regex(const std::string &topic) {
+            return !topic.empty() && topic.front() == '^';
+        }
+
+        /**
+         * @brief Whether `topic` is one of `topics` or matches one of their regular expressions. Only used to pick
+         * which topics to log, so the ECMAScript syntax of std::regex standing in for the POSIX syntax of librdkafka is
+         * acceptable.
+         */
+        static bool is_subscribed(const std::vector<std::string> &topics, const std::string &topic) {
+            return std::any_of(topics.begin(), topics.end(), [&topic](const std::string &subscription) {
+                if (is_regex(subscription)) {
+                    return std::regex_search(topic, std::regex(subscription));
+                }
+
+                return subscription == topic;
+            });
+        }
+    };
+
+    /****** KafkaOffsetTracker *********************************/
+    /**
+     * @brief Batches of one partition emitted while committing on completion. Batches complete in any order, the
+     * commit offset only moves past a batch once it and every batch emitted before it have completed. A failed batch is
+     * logged, counted and committed past like any other, so a single bad batch never stops the partition from
+     * committing or replays it forever after a restart.
+     */
+    class KafkaOffsetTracker {
+    public:
+        /**
+         * @param name Name of the partition, used when logging failed batches
+         */
+        explicit KafkaOffsetTracker(std::string name = "") : m_name(std::move(name)) {}
+
+        /**
+         * @brief Records a batch holding the offsets `[first, next)`.
+         */
+        void emitted(int64_t first, int64_t next) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_batches.emplace(first, Batch{next});
+            ++m_in_flight;
+        }
+
+        void completed(int64_t first, bool failed) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto found = m_batches.find(first);
+
+            DCHECK(found != m_batches.end()) << "Completed a batch which was never emitted";
+
+            if (found == m_batches.end()) {
+                return;
+            }
+
+            found->second.completed = true;
+            found->second.failed = failed;
+            --m_in_flight;
+
+            while (!m_batches.empty() && m_batches.begin()->second.completed) {
+                auto &[batch_first, batch] = *m_batches.begin();
+
+                if (batch.failed) {
+                    LOG(ERROR) << "Batch of offsets [" << batch_first << ", " << batch.next << ") of " << m_name
+                               << " failed downstream, committing past it";
+
+                    ++m_failed_count;
+                }
+
+                m_commit_offset = batch.next;
+                m_batches.erase(m_batches.begin());
+            }
+        }
+
+        /**
+         * @brief Returns the offset to commit if it moved since the last call, otherwise -1.
+         */
+        int64_t take_commit_offset() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_commit_offset <= m_committed_offset) {
+                return -1;
+            }
+
+            m_committed_offset = m_commit_offset;
+
+            return m_committed_offset;
+        }
+
+        /**
+         * @brief Number of emitted batches which have not completed yet.
+         */
+        std::size_t in_flight() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_in_flight;
+        }
+
+        /**
+         * @brief Number of emitted batches, completed or not, still held until the batches before them complete.
+         */
+        std::size_t tracked() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_batches.size();
+        }
+
+        /**
+         * @brief Number of failed batches committed past so far.
+         */
+        std::size_t failed_count() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_failed_count;
+        }
+
+    private:
+        struct Batch {
+            int64_t next;  // Offset after the last message of the batch
+            bool completed{false};
+            bool failed{false};
+        };
+
+        std::string m_name;
+        std::mutex m_mutex;
+
+        // Batches keyed by their first offset, released in offset order once completed
+        std::map<int64_t, Batch> m_batches;
+
+        int64_t m_commit_offset{-1};
+        int64_t m_committed_offset{-1};
+        std::size_t m_in_flight{0};
+        std::size_t m_failed_count{0};
+    };
+
+    /****** KafkaTaskQueueLoads ********************************/
+    /**
+     * @brief Number of parse tasks queued or running on each task queue of the source, used to pick the queue of a
+     * new task.
+     */
+    class KafkaTaskQueueLoads {
+    public:
+        KafkaTaskQueueLoads() = default;
+
+        /**
+         * @param affinity_slack Tasks stay on their home queue unless it holds more than this many tasks more than
+         * the least loaded queue
+         */
+        KafkaTaskQueueLoads(std::size_t queue_count, std::size_t affinity_slack) :
+                m_loads(queue_count), m_affinity_slack(affinity_slack) {}
+
+        /**
+         * @brief Picks the queue of a task of the partition running on `home_queue` and counts the task on it. Every
+         * call must be matched by a call to `release` with the returned queue.
+         */
+        std::size_t acquire(std::size_t home_queue) {
+            home_queue %= m_loads.size();
+
+            std::size_t least_loaded = home_queue;
+
+            for (std::size_t i = 0; i < m_loads.size(); ++i) {
+                if (m_loads[i].load() < m_loads[least_loaded].load()) {
+                    least_loaded = i;
+                }
+            }
+
+            // Prefer the queue already running the partition, its fiber scheduler is the one most likely to be idle
+            // next
+            auto target = home_queue;
+
+            if (m_loads[home_queue].load() > m_loads[least_loaded].load() + m_affinity_slack) {
+                target = least_loaded;
+            }
+
+            ++m_loads[target];
+
+            return target;
+        }
+
+        void release(std::size_t queue) {
+            --m_loads[queue];
+        }
+
+        std::size_t load(std::size_t queue) const {
+            return m_loads[queue].load();
+        }
+
+    private:
+        std::vector<std::atomic<std::size_t>> m_loads;
+        std::size_t m_affinity_slack{0};
+    };
+
+    /****** KafkaBatchWindow ***********************************/
+    /**
+     * @brief Batches of one partition being parsed while the next one is consumed, emitted in the order they were
+     * consumed. Once more than `max_in_flight` are pending, the oldest one is emitted, which waits for it to be parsed.
+     */
+    template <typename BatchT>
+    class KafkaBatchWindow {
+    public:
+        KafkaBatchWindow(std::size_t max_in_flight, std::function<void(BatchT &&)> emit_fn) :
+                m_max_in_flight(max_in_flight), m_emit_fn(std::move(emit_fn)) {}
+
+        void push(BatchT batch) {
+            m_pending.emplace_back(std::move(batch));
+
+            while (m_pending.size() > m_max_in_flight) {
+                this->emit_oldest();
+            }
+        }
+
+        /**
+         * @brief Emits every pending batch, oldest first.
+         */
+        void flush() {
+            while (!m_pending.empty()) {
+                this->emit_oldest();
+            }
+        }
+
+        std::size_t size() const {
+            return m_pending.size();
+        }
+
+    private:
+        void emit_oldest() {
+            // Removed before emitting, so a throwing emit never emits the batch twice
+            auto batch = std::move(m_pending.front());
+            m_pending.pop_front();
+
+            m_emit_fn(std::move(batch));
+        }
+
+        std::size_t m_max_in_flight;
+        std::function<void(BatchT &&)> m_emit_fn;
+        std::deque<BatchT> m_pending;
+    };
+
+    /****** KafkaEventWatcher **********************************/
+    /**
+     * @brief Thread turning the eventfds librdkafka signals for partition queues into callbacks, so partition fibers
+     * can sleep until messages arrive instead of polling. Callbacks run on the watcher thread with the watcher locked,
+     * so they must be quick and must not call `add` or `remove`.
+     */
+    class KafkaEventWatcher {
+    public:
+        KafkaEventWatcher() {
+            m_epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+            m_stop_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+            if (m_epoll_fd < 0 || m_stop_fd < 0) {
+                auto error = std::runtime_error(std::string("Failed to create the Kafka event watcher: ") +
+                                                std::strerror(errno));
+
+                if (m_epoll_fd >= 0) {
+                    ::close(m_epoll_fd);
+                }
+
+                if (m_stop_fd >= 0) {
+                    ::close(m_stop_fd);
+                }
+
+                throw error;
+            }
+
+            this->add(m_stop_fd, nullptr);
+
+            m_thread = std::thread(&KafkaEventWatcher::run, this);
+        }
+
+        ~KafkaEventWatcher() {
+            ::eventfd_write(m_stop_fd, 1);
+
+            m_thread.join();
+
+            ::close(m_stop_fd);
+            ::close(m_epoll_fd);
+        }
+
+        KafkaEventWatcher(const KafkaEventWatcher &) = delete;
+        KafkaEventWatcher &operator=(const KafkaEventWatcher &) = delete;
+
+        /**
+         * @brief Calls `on_ready` each time `fd`, an eventfd, is written to. The count is cleared before the call
+         */
+        void add(int fd, std::function<void()> on_ready) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            epoll_event ev{};
+            ev.events = EPOLLIN;
+            ev.data.fd = fd;
+
+            if (::epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+                throw std::runtime_error(std::string("Failed to watch a Kafka queue eventfd: ") + std::strerror(errno));
+            }
+
+            m_events[fd] = std::move(on_ready);
+        }
+
+        /**
+         * @brief Stops watching `fd`. Its callback is never called once this returns
+         */
+        void remove(int fd) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            ::epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+
+            // epoll_wait may already have returned this fd, the lookup in run() skips it once it is gone from the map
+            m_events.erase(fd);
+        }
+
+    private:
+        void run() {
+            std::array<epoll_event, 16> ready;
+
+            while (true) {
+                auto count = ::epoll_wait(m_epoll_fd, ready.data(), ready.size(), -1);
+
+                if (count < 0) {
+                    if (errno != EINTR) {
+                        LOG(ERROR) << "Kafka event watcher failed: " << std::strerror(errno);
+                        return;
+                    }
+
+                    continue;
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                for (int i = 0; i < count; ++i) {
+                    auto fd = ready[i].data.fd;
+
+                    if (fd == m_stop_fd) {
+                        return;
+                    }
+
+                    auto found = m_events.find(fd);
+
+                    if (found != m_events.end()) {
+                        eventfd_t value;
+                        ::eventfd_read(fd, &value);
+
+                        found->second();
+                    }
+                }
+            }
+        }
+
+        int m_epoll_fd{-1};
+        int m_stop_fd{-1};
+
+        std::mutex m_mutex;
+        std::map<int, std::function<void()>> m_events;
+        std::thread m_thread;
+    };
+
+    /****** KafkaPartitionFibers *******************************/
+    /**
+     * @brief Fibers of the assigned partitions keyed by "<topic>:<partition>", so a cooperative rebalance only starts
+     * and stops the fibers of the partitions it assigns or revokes. `TaskT` holds the `running` and `reached_stop`
+     * flags of a fiber and the `future` it finishes. Not thread safe, guarded by the rebalancer.
+     */
+    template <typename TaskT>
+    class KafkaPartitionFibers {
+    public:
+        /**
+         * @brief Starts the fiber of `key` with `launch_fn`, which sets the future of the new task. A partition
+         * assigned twice keeps a single fiber, the one already running is stopped first.
+         */
+        std::shared_ptr<TaskT> start(const std::string &key,
+                                     const std::function<void(const std::shared_ptr<TaskT> &)> &launch_fn) {
+            this->stop({key});
+
+            auto task = std::make_shared<TaskT>();
+
+            launch_fn(task);
+
+            m_tasks[key] = task;
+
+            return task;
+        }
+
+        /**
+         * @brief Stops the fibers of `keys` and waits for them to finish. Other partitions keep running. Returns the
+         * stopped tasks
+         */
+        std::vector<std::shared_ptr<TaskT>> stop(const std::vector<std::string> &keys) {
+            std::vector<std::shared_ptr<TaskT>> stopping;
+
+            for (const auto &key : keys) {
+                auto found = m_tasks.find(key);
+
+                if (found != m_tasks.end()) {
+                    stopping.emplace_back(std::move(found->second));
+                    m_tasks.erase(found);
+                }
+            }
+
+            return wait_stopped(std::move(stopping));
+        }
+
+        std::vector<std::shared_ptr<TaskT>> stop_all() {
+            std::vector<std::shared_ptr<TaskT>> stopping;
+
+            for (auto &[key, task] : m_tasks) {
+                stopping.emplace_back(std::move(task));
+            }
+
+            m_tasks.clear();
+
+            return wait_stopped(std::move(stopping));
+        }
+
+        /**
+         * @brief True once every running fiber reached the stop timestamp of a replay, false without fibers.
+         */
+        bool all_reached_stop() const {
+            return !m_tasks.empty() && std::all_of(m_tasks.begin(), m_tasks.end(), [](const auto &entry) {
+                return entry.second->reached_stop.load();
+            });
+        }
+
+        bool contains(const std::string &key) const {
+            return m_tasks.find(key) != m_tasks.end();
+        }
+
+        std::size_t size() const {
+            return m_tasks.size();
+        }
+
+    private:
+        static std::vector<std::shared_ptr<TaskT>> wait_stopped(std::vector<std::shared_ptr<TaskT>> &&stopping) {
+            // Signal every fiber before waiting on any, so they wind down concurrently
+            for (auto &task : stopping) {
+                task->running = false;
+            }
+
+            for (auto &task : stopping) {
+                task->future.wait();
+            }
+
+            return std::move(stopping);
+        }
+
+        std::map<std::string, std::shared_ptr<TaskT>> m_tasks;
+    };
+}  // namespace morpheus
@@ -0,0 +1,130 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/load_generator.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** LoadGeneratorSourceStage****************************/
+/**
+ * @brief Emits synthetic batches generated by a `LoadGenerator` from a template at a target rows per second, to
+ * measure the latency and throughput of a pipeline under a known load. Completes once `total_rows` rows have been
+ * emitted or `duration_sec` seconds have passed, whichever comes first, zero disables either limit. Also completes
+ * once the pipeline is drained, see `PipelineDrain`.
+ *
+ * Batches are emitted when they are due in the schedule, or as soon as the downstream accepts them when the pipeline
+ * falls behind. Their trace is stamped with the time they were due rather than the time they were emitted, so time
+ * spent waiting on a saturated pipeline is counted in the latency instead of hidden by the source slowing down. Every
+ * batch is traced when `trace_all` is set, otherwise the trace sample interval applies. The `output_columns`, mapping
+ * names to numpy type strings, are created in every batch, see `MessageMeta::reserve_columns`.
+ */
+#pragma GCC visibility push(default)
+class LoadGeneratorSourceStage : public neo::pyneo::PythonSource<std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = neo::pyneo::PythonSource<std::shared_ptr<MessageMeta>>;
+    using base_t::source_type_t;
+
+    LoadGeneratorSourceStage(const neo::Segment &parent,
+                             const std::string &name,
+                             LoadGenerator generator,
+                             std::size_t total_rows,
+                             double duration_sec,
+                             bool trace_all,
+                             std::map<std::string, std::string> output_columns = {});
+
+    std::size_t rows_emitted() const;
+
+    /**
+     * @brief Largest delay between the time a batch was due and the time it was emitted.
+     */
+    int64_t max_lag_ns() const;
+
+  private:
+    void generate_all(neo::Subscriber<source_type_t> &sub);
+
+    LoadGenerator m_generator;
+    std::size_t m_total_rows;
+    double m_duration_sec;
+    bool m_trace_all;
+    std::vector<std::string> m_output_column_names;
+    std::vector<TypeId> m_output_column_types;
+
+    std::atomic<std::size_t> m_rows_emitted{0};
+    std::atomic<int64_t> m_max_lag_ns{0};
+};
+
+/****** LoadGeneratorSourceStageInterfaceProxy**************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct LoadGeneratorSourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a LoadGeneratorSourceStage using the rows of `filename` as the template, and
+     * return the result.
+     */
+    static std::shared_ptr<LoadGeneratorSourceStage> init_from_file(neo::Segment &parent,
+                                                                    const std::string &name,
+                                                                    const std::string &filename,
+                                                                    double rows_per_second,
+                                                                    std::size_t batch_size,
+                                                                    const std::string &distribution,
+                                                                    double jitter,
+                                                                    std::vector<std::string> mutate_columns,
+                                                                    std::size_t total_rows,
+                                                                    double duration_sec,
+                                                                    bool trace_all,
+                                                                    uint64_t seed,
+                                                                    std::map<std::string, std::string> output_columns);
+
+    /**
+     * @brief Create and initialize a LoadGeneratorSourceStage using a copy of the rows of `template_meta` as the
+     * template, and return the result.
+     */
+    static std::shared_ptr<LoadGeneratorSourceStage> init_from_meta(neo::Segment &parent,
+                                                                    const std::string &name,
+                                                                    std::shared_ptr<MessageMeta> template_meta,
+                                                                    double rows_per_second,
+                                                                    std::size_t batch_size,
+                                                                    const std::string &distribution,
+                                                                    double jitter,
+                                                                    std::vector<std::string> mutate_columns,
+                                                                    std::size_t total_rows,
+                                                                    double duration_sec,
+                                                                    bool trace_all,
+                                                                    uint64_t seed,
+                                                                    std::map<std::string, std::string> output_columns);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
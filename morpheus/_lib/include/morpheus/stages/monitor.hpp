@@ -0,0 +1,95 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** MonitorStage****************************************/
+/**
+ * @brief Pass through node counting the messages and rows going through it in the `StageMetrics` of the stage, with
+ * a couple of relaxed atomic increments per message and without the GIL. When `log_interval_ms` is greater than 0 a
+ * background thread writes one line with the rows seen and the throughput to stderr every interval, and a final line
+ * once the input completes.
+ *
+ * Instantiated for `MessageMeta` and `MultiMessage`, exposed to python as `MonitorMessageMetaStage` and
+ * `MonitorMultiMessageStage`.
+ */
+#pragma GCC visibility push(default)
+template <typename MessageT>
+class MonitorStage : public neo::pyneo::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessageT>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::shared_ptr<MessageT>, std::shared_ptr<MessageT>>;
+    using typename base_t::operator_fn_t;
+    using typename base_t::reader_type_t;
+    using typename base_t::writer_type_t;
+
+    MonitorStage(const neo::Segment &parent,
+                 const std::string &name,
+                 std::string description,
+                 std::string unit,
+                 std::size_t log_interval_ms);
+
+  private:
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    std::string m_description;
+    std::string m_unit;
+    std::size_t m_log_interval_ms;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** MonitorStageInterfaceProxy**************************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+template <typename MessageT>
+struct MonitorStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a MonitorStage, and return the result.
+     */
+    static std::shared_ptr<MonitorStage<MessageT>> init(neo::Segment &parent,
+                                                        const std::string &name,
+                                                        std::string description,
+                                                        std::string unit,
+                                                        std::size_t log_interval_ms);
+};
+
+extern template class MonitorStage<MessageMeta>;
+extern template class MonitorStage<MultiMessage>;
+extern template struct MonitorStageInterfaceProxy<MessageMeta>;
+extern template struct MonitorStageInterfaceProxy<MultiMessage>;
+#pragma GCC visibility pop
+}  // namespace morpheus
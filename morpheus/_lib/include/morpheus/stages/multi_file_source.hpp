@@ -0,0 +1,92 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <pyneo/node.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** MultiFileSourceStage********************************/
+    /**
+     * @brief Reads many CSV or JSON lines files, emitting one `MessageMeta` per file. `prefetch` files are read
+     * concurrently by worker threads, each on its own per-thread default stream, so reads of different files overlap
+     * and a pipeline replaying thousands of small files is limited by the storage rather than by sequential reads.
+     * cuDF reads through GPUDirect Storage when cuFile is available and enabled with `LIBCUDF_CUFILE_POLICY`.
+     */
+#pragma GCC visibility push(default)
+    class MultiFileSourceStage : public neo::pyneo::PythonSource<std::shared_ptr<MessageMeta>> {
+    public:
+        using base_t = neo::pyneo::PythonSource<std::shared_ptr<MessageMeta>>;
+        using base_t::source_type_t;
+
+        /**
+         * @param filenames Files to read. Entries containing `*`, `?` or `[` are expanded as globs, in sorted order.
+         * @param prefetch Number of files read concurrently, and the most files held in memory before being emitted.
+         * @param ordered Emit the files in the order given. Otherwise each file is emitted as soon as it was read.
+         * @param output_columns Output columns, mapping names to numpy type strings, created in every message along
+         * with the file's columns. See `MessageMeta::reserve_columns`.
+         */
+        MultiFileSourceStage(const neo::Segment &parent,
+                             const std::string &name,
+                             std::vector<std::string> filenames,
+                             std::size_t prefetch                              = 4,
+                             bool ordered                                      = true,
+                             std::map<std::string, std::string> output_columns = {});
+
+        /**
+         * @brief Expands every glob in `patterns`, keeping plain filenames as is. Throws `std::invalid_argument` if a
+         * glob matches nothing.
+         */
+        static std::vector<std::string> expand_filenames(const std::vector<std::string> &patterns);
+
+    private:
+        void emit_files(neo::Subscriber<source_type_t> &sub);
+
+        std::vector<std::string> m_filenames;
+        std::size_t m_prefetch;
+        bool m_ordered;
+        std::vector<std::string> m_output_column_names;
+        std::vector<TypeId> m_output_column_types;
+    };
+
+    /****** MultiFileSourceStageInterfaceProxy******************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings.
+     */
+    struct MultiFileSourceStageInterfaceProxy {
+        /**
+         * @brief Create and initialize a MultiFileSourceStage, and return the result.
+         */
+        static std::shared_ptr<MultiFileSourceStage> init(neo::Segment &parent,
+                                                          const std::string &name,
+                                                          std::vector<std::string> filenames,
+                                                          std::size_t prefetch = 4,
+                                                          bool ordered         = true,
+                                                          std::map<std::string, std::string> output_columns = {});
+    };
+#pragma GCC visibility pop
+}  // namespace morpheus
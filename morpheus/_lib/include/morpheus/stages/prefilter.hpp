@@ -0,0 +1,159 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <boost/fiber/buffered_channel.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** PrefilterStage********************************/
+    /**
+     * @brief Takes the rows whose `column` matches any of `patterns`, or equals any of `literals`, out of each message
+     * so they skip the stages which follow, typically preprocessing and inference of known benign traffic. Every
+     * pattern and literal is compiled into a single regular expression ahead of time and evaluated on the device in
+     * one pass per message. Null values never match.
+     *
+     * The matched rows are given `label_columns`, all set to false. With `forward_benign` they are queued for a
+     * `PrefilterMergeStage`, which emits them again further down the pipeline, otherwise they are dropped. Messages
+     * with no matching rows are forwarded as they are.
+     */
+#pragma GCC visibility push(default)
+    class PrefilterStage
+            : public neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>> {
+    public:
+        using base_t = neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>;
+        using base_t::operator_fn_t;
+        using base_t::reader_type_t;
+        using base_t::writer_type_t;
+
+        using benign_channel_t = boost::fibers::buffered_channel<std::shared_ptr<MultiMessage>>;
+
+        /**
+         * @param benign_queue_size Number of messages of matched rows queued for the merge stage, must be a power of 2.
+         */
+        PrefilterStage(const neo::Segment &parent,
+                       const std::string &name,
+                       std::string column,
+                       const std::vector<std::string> &patterns,
+                       const std::vector<std::string> &literals,
+                       std::vector<std::string> label_columns,
+                       bool forward_benign,
+                       std::size_t benign_queue_size);
+
+        /**
+         * @return number of rows which matched so far
+         */
+        std::size_t benign_count() const;
+
+        /**
+         * @brief Queue of the matched rows, closed once the input completes. Only filled with `forward_benign`.
+         */
+        benign_channel_t &benign_channel();
+
+    private:
+        /**
+         * TODO(Documentation)
+         */
+        operator_fn_t build_operator();
+
+        std::string m_column;
+        std::string m_pattern;
+        std::vector<std::string> m_label_columns;
+        bool m_forward_benign;
+
+        benign_channel_t m_benign_channel;
+        std::atomic<std::size_t> m_benign_rows{0};
+
+        std::shared_ptr<StageMetrics> m_metrics;
+    };
+
+    /****** PrefilterMergeStage***************************/
+    /**
+     * @brief Forwards its input along with the matched rows queued by `prefilter`, as they arrive. Completes once both
+     * its input and the prefilter completed.
+     */
+    class PrefilterMergeStage
+            : public neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>> {
+    public:
+        using base_t = neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>;
+        using base_t::operator_fn_t;
+        using base_t::reader_type_t;
+        using base_t::writer_type_t;
+
+        PrefilterMergeStage(const neo::Segment &parent,
+                            const std::string &name,
+                            std::shared_ptr<PrefilterStage> prefilter);
+
+    private:
+        /**
+         * TODO(Documentation)
+         */
+        operator_fn_t build_operator();
+
+        std::shared_ptr<PrefilterStage> m_prefilter;
+
+        std::shared_ptr<StageMetrics> m_metrics;
+    };
+
+    /****** PrefilterStageInterfaceProxy******************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings.
+     */
+    struct PrefilterStageInterfaceProxy {
+        /**
+         * @brief Create and initialize a PrefilterStage, and return the result.
+         */
+        static std::shared_ptr<PrefilterStage> init(neo::Segment &parent,
+                                                    const std::string &name,
+                                                    std::string column,
+                                                    std::vector<std::string> patterns,
+                                                    std::vector<std::string> literals,
+                                                    std::vector<std::string> label_columns,
+                                                    bool forward_benign,
+                                                    std::size_t benign_queue_size);
+    };
+
+    /****** PrefilterMergeStageInterfaceProxy*************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings.
+     */
+    struct PrefilterMergeStageInterfaceProxy {
+        /**
+         * @brief Create and initialize a PrefilterMergeStage, and return the result.
+         */
+        static std::shared_ptr<PrefilterMergeStage> init(neo::Segment &parent,
+                                                         const std::string &name,
+                                                         std::shared_ptr<PrefilterStage> prefilter);
+    };
+
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,91 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/messages/multi_inference.hpp>
+#include <morpheus/utilities/cuda_graph.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <pyneo/node.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** PreprocessAEStage***********************************/
+/**
+ * @brief Packs the autoencoder features of every message into a row-major FLOAT32 `input` tensor, next to the usual
+ * `seq_ids`, without going through pandas. When `scaling_file` is set every feature is normalized with the statistics
+ * it holds (see `FeatureScaler`) by the same kernel which packs the columns. Features must be numeric or boolean.
+ */
+#pragma GCC visibility push(default)
+class PreprocessAEStage
+  : public neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiInferenceMessage>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiInferenceMessage>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    PreprocessAEStage(const neo::Segment& parent,
+                      const std::string& name,
+                      std::vector<std::string> features,
+                      const std::string& scaling_file = "");
+
+  private:
+    template<typename StageT>
+    friend class TypedFusedStageLink;
+
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    std::vector<std::string> m_fea_cols;
+
+    // Empty when the features are packed unscaled
+    std::vector<float> m_shift;
+    std::vector<float> m_scale;
+
+    // Shared by every operator, keyed by the number of rows
+    std::shared_ptr<CudaGraphCache> m_graphs;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** PreprocessAEStageInferenceProxy*********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct PreprocessAEStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a PreprocessAEStage, and return the result.
+     */
+    static std::shared_ptr<PreprocessAEStage> init(neo::Segment& parent,
+                                                   const std::string& name,
+                                                   std::vector<std::string> features,
+                                                   const std::string& scaling_file);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -19,6 +19,8 @@
 
 #include <morpheus/messages/multi.hpp>
 #include <morpheus/messages/multi_inference.hpp>
+#include <morpheus/utilities/cuda_graph.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <pyneo/node.hpp>
 
@@ -44,6 +46,9 @@ class PreprocessFILStage
     PreprocessFILStage(const neo::Segment& parent, const std::string& name, const std::vector<std::string>& features);
 
   private:
+    template<typename StageT>
+    friend class TypedFusedStageLink;
+
     /**
      * TODO(Documentation)
      */
@@ -51,6 +56,11 @@ class PreprocessFILStage
 
     std::vector<std::string> m_fea_cols;
     std::string m_vocab_file;
+
+    // Shared by every operator, keyed by the number of rows
+    std::shared_ptr<CudaGraphCache> m_graphs;
+
+    std::shared_ptr<StageMetrics> m_metrics;
 };
 
 /****** PreprocessFILStageInferenceProxy********************/
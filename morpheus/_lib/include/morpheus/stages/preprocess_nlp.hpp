@@ -19,8 +19,10 @@
 
 #include <morpheus/messages/multi.hpp>
 #include <morpheus/messages/multi_inference.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <pyneo/node.hpp>
+#include <nvtext/subword_tokenize.hpp>
 
 #include <string>
 #include <memory>
@@ -52,6 +54,9 @@ namespace morpheus {
                            int stride = -1);
 
     private:
+        template<typename StageT>
+        friend class TypedFusedStageLink;
+
         /**
          * TODO(Documentation)
          */
@@ -63,6 +68,11 @@ namespace morpheus {
         bool m_do_lower_case;
         bool m_add_special_token;
         int m_stride{-1};
+
+        // Shared with any other stage using the same hash file, see VocabularyCache
+        std::shared_ptr<const nvtext::hashed_vocabulary> m_vocab;
+
+        std::shared_ptr<StageMetrics> m_metrics;
     };
 
 
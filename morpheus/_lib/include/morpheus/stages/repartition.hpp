@@ -0,0 +1,144 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <boost/fiber/buffered_channel.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** RepartitionStage********************************/
+    /**
+     * @brief Splits the rows of each message into `num_shards` shards by the hash of `key_column`, so every row with
+     * the same key always lands in the same shard. Shard 0 is emitted by the stage itself, the other shards are
+     * emitted by one `RepartitionShardSource` each. Rows keep their relative order within a shard, and messages whose
+     * rows all fall in one shard are forwarded as they are. Running a stateful stage, like `TimeSeriesStage`, after
+     * every shard lets it run `num_shards` ways in parallel while still seeing the rows of each key in order.
+     *
+     * Every shard must be consumed: once the queue of a shard holds `shard_queue_size` messages the stage blocks.
+     */
+#pragma GCC visibility push(default)
+    class RepartitionStage
+            : public neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>> {
+    public:
+        using base_t = neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>;
+        using base_t::operator_fn_t;
+        using base_t::reader_type_t;
+        using base_t::writer_type_t;
+
+        using shard_channel_t = boost::fibers::buffered_channel<std::shared_ptr<MultiMessage>>;
+
+        /**
+         * @param shard_queue_size Number of messages queued for each of the shards 1 to `num_shards - 1`, must be a
+         * power of 2.
+         */
+        RepartitionStage(const neo::Segment &parent,
+                         const std::string &name,
+                         std::string key_column,
+                         std::size_t num_shards,
+                         std::size_t shard_queue_size);
+
+        std::size_t num_shards() const;
+
+        /**
+         * @brief Queue of `shard`, between 1 and `num_shards() - 1`. Closed once the input completes.
+         */
+        shard_channel_t &shard_channel(std::size_t shard);
+
+    private:
+        /**
+         * TODO(Documentation)
+         */
+        operator_fn_t build_operator();
+
+        /**
+         * @brief Closes the queue of every shard, letting their sources complete.
+         */
+        void close_shards();
+
+        std::string m_key_column;
+        std::size_t m_num_shards;
+
+        std::vector<std::unique_ptr<shard_channel_t>> m_shard_channels;
+
+        std::shared_ptr<StageMetrics> m_metrics;
+    };
+
+    /****** RepartitionShardSource**************************/
+    /**
+     * @brief Emits the messages `RepartitionStage` queued for `shard`, in order, and completes once the input of the
+     * stage completed.
+     */
+    class RepartitionShardSource : public neo::pyneo::PythonSource<std::shared_ptr<MultiMessage>> {
+    public:
+        using base_t = neo::pyneo::PythonSource<std::shared_ptr<MultiMessage>>;
+        using base_t::source_type_t;
+
+        RepartitionShardSource(const neo::Segment &parent,
+                               const std::string &name,
+                               std::shared_ptr<RepartitionStage> stage,
+                               std::size_t shard);
+
+    private:
+        std::shared_ptr<RepartitionStage> m_stage;
+        std::size_t m_shard;
+    };
+
+    /****** RepartitionStageInterfaceProxy******************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings.
+     */
+    struct RepartitionStageInterfaceProxy {
+        /**
+         * @brief Create and initialize a RepartitionStage, and return the result.
+         */
+        static std::shared_ptr<RepartitionStage> init(neo::Segment &parent,
+                                                      const std::string &name,
+                                                      std::string key_column,
+                                                      std::size_t num_shards,
+                                                      std::size_t shard_queue_size);
+    };
+
+    /****** RepartitionShardSourceInterfaceProxy************/
+    /**
+     * @brief Interface proxy, used to insulate python bindings.
+     */
+    struct RepartitionShardSourceInterfaceProxy {
+        /**
+         * @brief Create and initialize a RepartitionShardSource, and return the result.
+         */
+        static std::shared_ptr<RepartitionShardSource> init(neo::Segment &parent,
+                                                            const std::string &name,
+                                                            std::shared_ptr<RepartitionStage> stage,
+                                                            std::size_t shard);
+    };
+
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -18,14 +18,21 @@
 #pragma once
 
 #include <morpheus/messages/multi.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <neo/core/segment.hpp>
 #include <pyneo/node.hpp>
 
+#include <cudf/types.hpp>
+
+#include <cstddef>
 #include <fstream>
 #include <memory>
+#include <mutex>
 #include <regex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace morpheus {
     /****** Component public implementations *******************/
@@ -45,9 +52,13 @@ namespace morpheus {
                        const std::string &name,
                        const std::vector<std::string> &include,
                        const std::vector<std::string> &exclude,
-                       bool fixed_columns = true);
+                       bool fixed_columns      = true,
+                       double compact_fraction = 0.0);
 
     private:
+        template<typename StageT>
+        friend class TypedFusedStageLink;
+
         void make_regex_objs(const std::vector<std::string> &regex_strs, std::vector<std::regex> &regex_objs);
 
         bool match_column(const std::vector<std::regex> &patterns, const std::string &column) const;
@@ -58,12 +69,33 @@ namespace morpheus {
 
         TableInfo get_meta(reader_type_t &msg);
 
+        /**
+         * @brief Positions of the columns to serialize for a table with `column_names`. The regexes are only evaluated
+         * the first time a schema is seen, later tables with the same columns reuse the cached positions.
+         */
+        std::vector<cudf::size_type> column_plan(const std::vector<std::string> &column_names);
+
         operator_fn_t build_operator();
 
+        /**
+         * @brief Columns selected for one schema, keyed by a hash of the column names in `m_column_plans`.
+         */
+        struct ColumnPlan {
+            std::vector<std::string> column_names;  // Compared on lookup, so hash collisions only cost a rebuild
+            std::vector<cudf::size_type> column_indices;
+        };
+
         bool m_fixed_columns;
+        double m_compact_fraction;
         std::vector<std::regex> m_include;
         std::vector<std::regex> m_exclude;
         std::vector<std::string> m_column_names;
+
+        // Only used when the columns are not fixed
+        std::mutex m_column_plans_mutex;
+        std::unordered_map<std::size_t, ColumnPlan> m_column_plans;
+
+        std::shared_ptr<StageMetrics> m_metrics;
     };
 
     /****** WriteToFileStageInterfaceProxy******************/
@@ -78,7 +110,8 @@ namespace morpheus {
                                                     const std::string &name,
                                                     const std::vector<std::string> &include,
                                                     const std::vector<std::string> &exclude,
-                                                    bool fixed_columns = true);
+                                                    bool fixed_columns      = true,
+                                                    double compact_fraction = 0.0);
     };
 
 #pragma GCC visibility pop
@@ -0,0 +1,101 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/multi_response.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** TimeSeriesStage*************************************/
+/**
+ * @brief Flags the rows of every message whose events fall in an anomalous time bin, as the Python `TimeSeriesStage`.
+ * Events are counted per user in a device resident ring of `resolution_sec` bins, updated incrementally as messages
+ * arrive, so the history is never re-binned. Messages are held until `min_window_sec` of events have been seen after
+ * their last row, then the windows of every user which completed are scored together with a single batched cuFFT
+ * plan. Results are written to the `ts_anomaly` column.
+ *
+ * The user of a message is read from the first row of `user_column`, a string column, all the messages share a
+ * single time series when it is empty. Messages of a user must arrive in order.
+ */
+#pragma GCC visibility push(default)
+class TimeSeriesStage
+  : public neo::pyneo::PythonNode<std::shared_ptr<MultiResponseMessage>, std::shared_ptr<MultiResponseMessage>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::shared_ptr<MultiResponseMessage>, std::shared_ptr<MultiResponseMessage>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    TimeSeriesStage(const neo::Segment& parent,
+                    const std::string& name,
+                    int64_t resolution_sec,
+                    double min_window_sec,
+                    bool hot_start,
+                    bool cold_end,
+                    double filter_percent,
+                    double zscore_threshold,
+                    std::string user_column);
+
+  private:
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    int64_t m_resolution_sec;
+    int32_t m_half_window_bins;
+    bool m_hot_start;
+    bool m_cold_end;
+    double m_filter_percent;
+    double m_zscore_threshold;
+    std::string m_user_column;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** TimeSeriesStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct TimeSeriesStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a TimeSeriesStage, and return the result.
+     */
+    static std::shared_ptr<TimeSeriesStage> init(neo::Segment& parent,
+                                                 const std::string& name,
+                                                 int64_t resolution_sec,
+                                                 double min_window_sec,
+                                                 bool hot_start,
+                                                 bool cold_end,
+                                                 double filter_percent,
+                                                 double zscore_threshold,
+                                                 std::string user_column);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
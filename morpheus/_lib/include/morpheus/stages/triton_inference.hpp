@@ -20,23 +20,67 @@
 #include <morpheus/messages/multi_inference.hpp>
 #include <morpheus/messages/multi_response.hpp>
 #include <morpheus/objects/triton_in_out.hpp>
+#include <morpheus/objects/triton_shared_memory_pool.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/pipeline_drain.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <neo/core/segment.hpp>
 #include <pyneo/node.hpp>
 
 #include <http_client.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <future>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 
 namespace morpheus {
+    class InferenceClientStage__ClientPool;
+    struct InferenceClientStage__ModelInfo;
+    class InferenceClientStage__RequestPool;
+    class InferenceClientStage__ResponseCache;
+
     /****** Component public implementations *******************/
+#pragma GCC visibility push(default)
+    /**
+     * @brief Transport used by InferenceClientStage to communicate with Triton.
+     */
+    enum class InferenceClientProtocol : int32_t {
+        HTTP,
+        GRPC
+    };
+
     /****** InferenceClientStage********************************/
     /**
-     * TODO(Documentation)
+     * @brief Sends inference requests to Triton. When `device_id` is not negative, the threads building requests and
+     * the client threads copying responses use that CUDA device and are bound to the CPUs of the NUMA node closest to
+     * it. When `batch_timeout_ms` is greater than 0, messages with fewer rows than the model's `max_batch_size` are
+     * held for up to that long so the rows of several consecutive messages can be sent in a single request. Each
+     * message is still emitted with its own response, in the order received.
+     *
+     * When `cache_size` is greater than 0, the outputs of up to that many distinct rows are kept on the device, keyed
+     * by a hash of all of the row's inputs, and rows which have been seen before are answered from the cache rather
+     * than sent to Triton. Rows repeated within a message are only sent once.
+     *
+     * Messages with more inference rows than message rows, where long messages were split into overlapping token
+     * windows, are answered with one row per message row. The outputs of the windows sharing a `seq_ids[:, 0]` are
+     * merged on the device with `window_reduction`, either the max or the mean.
+     *
+     * The handshake with the servers runs in the background from construction, and is shared by every stage sending
+     * the same model to the same servers. It is only waited for when the stage starts, where a failed handshake is
+     * raised. With `warmup` set, a batch of `max_batch_size` rows of zeros is then sent once, so the first real batch
+     * does not pay for the first allocations and for Triton loading the model onto the GPU.
+     *
+     * `server_url` may hold a comma separated list of servers hosting the same model. Their clients are shared by
+     * every operator instance of the stage, and each request goes to the healthy server with the fewest outstanding
+     * requests. A server whose request fails is skipped, and the request retried on another, until it passes a health
+     * check.
      */
-#pragma GCC visibility push(default)
     class InferenceClientStage
             : public neo::pyneo::PythonNode<std::shared_ptr<MultiInferenceMessage>, std::shared_ptr<MultiResponseMessage>> {
     public:
@@ -52,24 +96,68 @@ namespace morpheus {
                              bool force_convert_inputs,
                              bool use_shared_memory,
                              bool needs_logits,
-                             std::map<std::string, std::string> inout_mapping = {});
+                             std::map<std::string, std::string> inout_mapping = {},
+                             std::size_t max_concurrent_requests = 1,
+                             InferenceClientProtocol protocol = InferenceClientProtocol::HTTP,
+                             bool length_bucketing = false,
+                             int32_t device_id = -1,
+                             int32_t batch_timeout_ms = 0,
+                             std::size_t cache_size = 0,
+                             RowReduction window_reduction = RowReduction::MAX,
+                             bool warmup = false);
 
     private:
+        template<typename StageT>
+        friend class TypedFusedStageLink;
+
         /**
-         * TODO(Documentation)
+         * @brief Waits for the handshake and sets up the inputs/outputs, the client pool and the shared memory
+         * regions.
          */
-        bool is_default_grpc_port(std::string &server_url);
+        void connect_with_server();
 
         /**
-         * TODO(Documentation)
+         * @brief Sends a single batch of zeros with `m_max_batch_size` rows, discarding the outputs.
          */
-        void connect_with_server();
+        void warmup();
 
         /**
          * TODO(Documentation)
          */
         operator_fn_t build_operator();
 
+        /**
+         * @brief Sends a single message to Triton and returns its response.
+         */
+        writer_type_t infer_message(const reader_type_t &message);
+
+        /**
+         * @brief Same as `infer_rows`, only sending the rows whose outputs are not in the response cache, when there
+         * is one.
+         */
+        std::shared_ptr<ResponseMemory> infer_cached(const std::vector<TensorObject> &inputs,
+                                                     const TensorObject *input_mask,
+                                                     std::size_t count);
+
+        /**
+         * @brief Sends `count` rows to Triton, split into requests of at most `m_max_batch_size` rows, and returns the
+         * outputs for every row. `inputs` holds one tensor per model input, in the order of `m_model_inputs`. When
+         * `input_mask` is set, rows are bucketed by token length.
+         */
+        std::shared_ptr<ResponseMemory> infer_rows(const std::vector<TensorObject> &inputs,
+                                                   const TensorObject *input_mask,
+                                                   std::size_t count);
+
+        /**
+         * @brief Copies the outputs of a completed request to the device, applying logits if needed, and stores them
+         * in `outputs` in the order of `m_model_outputs`. Each output has the shape returned by Triton, of any rank.
+         * Called from the Triton client's worker thread when running asynchronously. When `shared_memory_region` is
+         * set, outputs are read from the region on the device instead of from the response.
+         */
+        void process_infer_result(triton::client::InferResult &results,
+                                  std::vector<TensorObject> &outputs,
+                                  const TritonSharedMemoryRegion *shared_memory_region = nullptr);
+
         std::string m_model_name;
         std::string m_server_url;
         bool m_force_convert_inputs;
@@ -77,12 +165,52 @@ namespace morpheus {
         bool m_needs_logits{true};
         std::map<std::string, std::string> m_inout_mapping;
 
+        // Number of mini-batch requests allowed in flight at once. A value of 1 uses the blocking `Infer` call
+        std::size_t m_max_concurrent_requests{1};
+        InferenceClientProtocol m_protocol{InferenceClientProtocol::HTTP};
+
+        // Sort rows by token length and trim the sequence dimension per request. Disabled at connect time when the
+        // model does not accept a dynamic sequence length
+        bool m_length_bucketing{false};
+
+        int32_t m_device_id{-1};
+
+        // How long a partial batch waits for more rows. Messages are never combined when 0
+        int32_t m_batch_timeout_ms{0};
+
+        // Number of rows whose outputs are cached, 0 disables the cache
+        std::size_t m_cache_size{0};
+
+        // How the outputs of the token windows of a single message row are merged
+        RowReduction m_window_reduction{RowReduction::MAX};
+
+        bool m_warmup{false};
+
+        // Started at construction, set up once by the first operator to start
+        std::shared_future<std::shared_ptr<const InferenceClientStage__ModelInfo>> m_model_info;
+        std::once_flag m_connect_once;
+
         // Below are settings created during handshake with server
         // std::shared_ptr<triton::client::InferenceServerHttpClient> m_client;
         std::vector<TritonInOut> m_model_inputs;
         std::vector<TritonInOut> m_model_outputs;
         triton::client::InferOptions m_options;
         int m_max_batch_size{-1};
+
+        // Clients for every server in `m_server_url`, created at connect time
+        std::shared_ptr<InferenceClientStage__ClientPool> m_client_pool;
+
+        // Request descriptors reused across mini-batches, created at connect time
+        std::shared_ptr<InferenceClientStage__RequestPool> m_request_pool;
+
+        // Only created when `m_cache_size` is set and the model has 2D inputs and outputs. Shared by every operator
+        std::shared_ptr<InferenceClientStage__ResponseCache> m_response_cache;
+
+        // Only created when `m_use_shared_memory` is set. Regions are registered with the server at connect time
+        std::unique_ptr<TritonSharedMemoryPool> m_shared_memory_pool;
+
+        std::shared_ptr<StageMetrics> m_metrics;
+        std::shared_ptr<DrainProgress> m_drain_progress;  // Messages received and not yet emitted
     };
 
 
@@ -101,7 +229,15 @@ namespace morpheus {
                                                           bool force_convert_inputs,
                                                           bool use_shared_memory,
                                                           bool needs_logits,
-                                                          std::map<std::string, std::string> inout_mapping);
+                                                          std::map<std::string, std::string> inout_mapping,
+                                                          std::size_t max_concurrent_requests,
+                                                          const std::string &protocol,
+                                                          bool length_bucketing,
+                                                          int32_t device_id,
+                                                          int32_t batch_timeout_ms,
+                                                          std::size_t cache_size,
+                                                          const std::string &window_reduction,
+                                                          bool warmup);
     };
 #pragma GCC visibility pop
 }
\ No newline at end of file
@@ -0,0 +1,348 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Pieces of InferenceClientStage which do not need a Triton server or a GPU, kept here so they can be tested on their
+// own
+namespace morpheus {
+    /****** InferenceServerUrls ********************************/
+    struct InferenceServerUrls {
+        /**
+         * @brief Splits a comma separated list of server URLs, ignoring whitespace and empty entries.
+         */
+        static std::vector<std::string> split(const std::string &server_urls) {
+            std::vector<std::string> result;
+            std::stringstream stream(server_urls);
+            std::string server_url;
+
+            while (std::getline(stream, server_url, ',')) {
+                server_url.erase(0, server_url.find_first_not_of(" \t"));
+                server_url.erase(server_url.find_last_not_of(" \t") + 1);
+
+                if (!server_url.empty()) {
+                    result.push_back(server_url);
+                }
+            }
+
+            return result;
+        }
+    };
+
+    /****** InferenceEndpointLoads *****************************/
+    /**
+     * @brief Routing state of the servers shared by a stage's client pool: the requests outstanding on each, and
+     * whether it is ejected. Requests go to the healthy server with the fewest outstanding, a server whose request
+     * fails is ejected for `ejection_time` and then health checked before it is used again. Not thread safe, the pool
+     * calls it under its lock.
+     */
+    class InferenceEndpointLoads {
+    public:
+        using clock_t = std::chrono::steady_clock;
+
+        InferenceEndpointLoads(std::size_t count, clock_t::duration ejection_time) :
+                m_endpoints(count),
+                m_ejection_time(ejection_time) {}
+
+        std::size_t size() const {
+            return m_endpoints.size();
+        }
+
+        /**
+         * @brief Counts a request against the healthy server with the fewest outstanding requests and returns its
+         * index. Ties go to the first server after the previous choice, so they are spread across servers. Returns
+         * `size()` when every server is ejected.
+         */
+        std::size_t acquire() {
+            std::size_t chosen = m_endpoints.size();
+
+            for (std::size_t n = 0; n < m_endpoints.size(); ++n) {
+                auto idx = (m_next + n) % m_endpoints.size();
+
+                if (m_endpoints[idx].healthy &&
+                    (chosen == m_endpoints.size() || m_endpoints[idx].outstanding < m_endpoints[chosen].outstanding)) {
+                    chosen = idx;
+                }
+            }
+
+            if (chosen < m_endpoints.size()) {
+                m_next = chosen + 1;
+                ++m_endpoints[chosen].outstanding;
+            }
+
+            return chosen;
+        }
+
+        /**
+         * @brief Ends a request to `idx`. A failed request ejects the server until `now + ejection_time`, unless it is
+         * the only one, there would be nothing left to send requests to. Returns true when this call ejected it.
+         */
+        bool release(std::size_t idx, bool failed, clock_t::time_point now = clock_t::now()) {
+            auto &endpoint = m_endpoints[idx];
+            --endpoint.outstanding;
+
+            if (!failed || !endpoint.healthy || m_endpoints.size() < 2) {
+                return false;
+            }
+
+            endpoint.healthy = false;
+            endpoint.retry_at = now + m_ejection_time;
+
+            return true;
+        }
+
+        /**
+         * @brief Ejected servers due for a health check at `now`. Their next check is pushed back by the ejection
+         * time, so other callers do not check the same server meanwhile.
+         */
+        std::vector<std::size_t> due_for_check(clock_t::time_point now = clock_t::now()) {
+            std::vector<std::size_t> due;
+
+            for (std::size_t idx = 0; idx < m_endpoints.size(); ++idx) {
+                auto &endpoint = m_endpoints[idx];
+
+                if (!endpoint.healthy && endpoint.retry_at <= now) {
+                    endpoint.retry_at = now + m_ejection_time;
+                    due.push_back(idx);
+                }
+            }
+
+            return due;
+        }
+
+        /**
+         * @brief Sends requests to `idx` again, once it passed its health check.
+         */
+        void restore(std::size_t idx) {
+            m_endpoints[idx].healthy = true;
+        }
+
+        bool healthy(std::size_t idx) const {
+            return m_endpoints[idx].healthy;
+        }
+
+        std::size_t outstanding(std::size_t idx) const {
+            return m_endpoints[idx].outstanding;
+        }
+
+        clock_t::duration ejection_time() const {
+            return m_ejection_time;
+        }
+
+    private:
+        struct Endpoint {
+            // Including asynchronous requests which have not completed
+            std::size_t outstanding{0};
+            bool healthy{true};
+            clock_t::time_point retry_at;
+        };
+
+        std::vector<Endpoint> m_endpoints;
+        clock_t::duration m_ejection_time;
+        std::size_t m_next{0};
+    };
+
+    /****** InferenceResponseCacheIndex ************************/
+    /**
+     * @brief Host side of the response cache: which keys, hashes of a row's inputs, have their outputs stored and in
+     * which slot of the cached output tensors, in least recently used order. Not thread safe, the cache calls it under
+     * its lock.
+     */
+    class InferenceResponseCacheIndex {
+    public:
+        struct Lookup {
+            // Rows found, and the slot holding each
+            std::vector<int32_t> hit_rows;
+            std::vector<int32_t> hit_slots;
+
+            // First row of each distinct key that was not found, followed by every row that was not found and the
+            // index of its key in `miss_rows`
+            std::vector<int32_t> miss_rows;
+            std::vector<int32_t> missed_rows;
+            std::vector<int32_t> missed_keys;
+        };
+
+        explicit InferenceResponseCacheIndex(std::size_t capacity) : m_capacity(capacity) {}
+
+        /**
+         * @brief Finds the rows with the keys in `keys`, making the keys found the most recently used.
+         */
+        Lookup lookup(const std::vector<uint64_t> &keys) {
+            Lookup result;
+            std::unordered_map<uint64_t, int32_t> first_miss;
+
+            for (std::size_t row = 0; row < keys.size(); ++row) {
+                auto found = m_index.find(keys[row]);
+
+                if (found != m_index.end()) {
+                    m_lru.splice(m_lru.begin(), m_lru, found->second);
+
+                    result.hit_rows.push_back(static_cast<int32_t>(row));
+                    result.hit_slots.push_back(found->second->slot);
+                    continue;
+                }
+
+                auto [miss, inserted] = first_miss.emplace(keys[row], static_cast<int32_t>(result.miss_rows.size()));
+
+                if (inserted) {
+                    result.miss_rows.push_back(static_cast<int32_t>(row));
+                }
+
+                result.missed_rows.push_back(static_cast<int32_t>(row));
+                result.missed_keys.push_back(miss->second);
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Gives a slot to the keys of the rows in `miss_rows`, evicting the least recently used keys once full,
+         * and returns the slots in the same order. Only the first `capacity` rows get one. A key stored since the
+         * lookup keeps its slot.
+         */
+        std::vector<int32_t> assign(const std::vector<uint64_t> &keys, const std::vector<int32_t> &miss_rows) {
+            const auto stored = std::min(miss_rows.size(), m_capacity);
+
+            std::vector<int32_t> slots;
+            slots.reserve(stored);
+
+            for (std::size_t i = 0; i < stored; ++i) {
+                const auto key = keys[miss_rows[i]];
+
+                auto found = m_index.find(key);
+
+                if (found != m_index.end()) {
+                    m_lru.splice(m_lru.begin(), m_lru, found->second);
+                    slots.push_back(found->second->slot);
+                    continue;
+                }
+
+                auto slot = static_cast<int32_t>(m_index.size());
+
+                if (m_index.size() == m_capacity) {
+                    slot = m_lru.back().slot;
+
+                    m_index.erase(m_lru.back().key);
+                    m_lru.pop_back();
+                }
+
+                m_lru.push_front(Entry{key, slot});
+                m_index[key] = m_lru.begin();
+                slots.push_back(slot);
+            }
+
+            return slots;
+        }
+
+        bool contains(uint64_t key) const {
+            return m_index.find(key) != m_index.end();
+        }
+
+        std::size_t size() const {
+            return m_index.size();
+        }
+
+        std::size_t capacity() const {
+            return m_capacity;
+        }
+
+    private:
+        struct Entry {
+            uint64_t key;
+            int32_t slot;
+        };
+
+        std::size_t m_capacity;
+        std::list<Entry> m_lru;
+        std::unordered_map<uint64_t, std::list<Entry>::iterator> m_index;
+    };
+
+    /****** InferenceSharedFutureCache *************************/
+    /**
+     * @brief Values computed once per key on a background thread and shared by every caller asking for the same key,
+     * such as the result of the handshake with the servers of a model. A value whose computation failed is forgotten
+     * once it completes, so the next `get` for its key starts again. Thread safe.
+     */
+    template<typename KeyT, typename ValueT>
+    class InferenceSharedFutureCache {
+    public:
+        using future_t = std::shared_future<ValueT>;
+
+        /**
+         * @brief Returns the value of `key`, started by `start_fn` on a background thread unless already started and
+         * neither failed.
+         */
+        future_t get(const KeyT &key, std::function<ValueT()> start_fn) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto found = m_futures.find(key);
+
+            if (found != m_futures.end()) {
+                if (!InferenceSharedFutureCache::has_failed(found->second)) {
+                    return found->second;
+                }
+
+                m_futures.erase(found);
+            }
+
+            auto future = std::async(std::launch::async, std::move(start_fn)).share();
+
+            m_futures.emplace(key, future);
+
+            return future;
+        }
+
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            return m_futures.size();
+        }
+
+    private:
+        static bool has_failed(const future_t &future) {
+            if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return false;
+            }
+
+            try {
+                future.get();
+            } catch (...) {
+                return true;
+            }
+
+            return false;
+        }
+
+        mutable std::mutex m_mutex;
+        std::map<KeyT, future_t> m_futures;
+    };
+}  // namespace morpheus
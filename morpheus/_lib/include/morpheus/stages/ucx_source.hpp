@@ -0,0 +1,88 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** UcxSourceStage**************************************/
+/**
+ * @brief Receives the tables sent by `num_senders` `WriteToUcxStage`s, on other processes or hosts, and emits each one
+ * as a MessageMeta as soon as it arrives. Completes once every sender has completed, and fails if a sender
+ * disconnects without completing. See `UcxReceiver` for the transports used.
+ */
+#pragma GCC visibility push(default)
+class UcxSourceStage : public neo::pyneo::PythonSource<std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = neo::pyneo::PythonSource<std::shared_ptr<MessageMeta>>;
+    using base_t::source_type_t;
+
+    /**
+     * @param address local address to listen on, "0.0.0.0" listens on every interface
+     * @param output_columns Output columns of this pipeline, mapping names to numpy type strings, created in every
+     * received table. See `MessageMeta::reserve_columns`.
+     */
+    UcxSourceStage(const neo::Segment &parent,
+                   const std::string &name,
+                   std::string address,
+                   uint16_t port,
+                   std::size_t num_senders                           = 1,
+                   std::map<std::string, std::string> output_columns = {});
+
+  private:
+    void receive_all(neo::Subscriber<source_type_t> &sub);
+
+    std::string m_address;
+    uint16_t m_port;
+    std::size_t m_num_senders;
+    std::vector<std::string> m_output_column_names;
+    std::vector<TypeId> m_output_column_types;
+};
+
+/****** UcxSourceStageInterfaceProxy************************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct UcxSourceStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a UcxSourceStage, and return the result.
+     */
+    static std::shared_ptr<UcxSourceStage> init(neo::Segment &parent,
+                                                const std::string &name,
+                                                std::string address,
+                                                uint16_t port,
+                                                std::size_t num_senders                           = 1,
+                                                std::map<std::string, std::string> output_columns = {});
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,117 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+struct ValidationStage__State;
+
+/****** Component public implementations *******************/
+/****** ValidationStage*************************************/
+/**
+ * @brief Compares every message against a file of expected results while passing it through. Each batch is joined
+ * on the device against the expected table, loaded once with `CuDFTableUtil::load_table`, by the `index_col` column,
+ * or by the index of the message when `index_col` is empty. Only running counts and up to `max_samples` mismatched
+ * rows are kept, the results are written as JSON to `results_file_name` once the input completes, with the same
+ * fields as the python `ValidationStage`.
+ *
+ * Columns are selected by `include` and `exclude`, lists of regular expressions matched from the start of the
+ * column name. Float columns match when `|res - val| <= abs_tol + rel_tol * |res|`, other columns must be equal,
+ * and nulls match nulls. Keys are expected to be unique.
+ */
+#pragma GCC visibility push(default)
+class ValidationStage : public neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MultiMessage>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    ValidationStage(const neo::Segment &parent,
+                    const std::string &name,
+                    std::string val_file_name,
+                    std::string results_file_name,
+                    std::vector<std::string> include,
+                    std::vector<std::string> exclude,
+                    std::string index_col,
+                    double abs_tol,
+                    double rel_tol,
+                    std::size_t max_samples);
+
+  private:
+    /**
+     * TODO(Documentation)
+     */
+    operator_fn_t build_operator();
+
+    /**
+     * @brief Joins the rows of `x` with the expected rows, adding them to the statistics in `state`.
+     */
+    void compare(ValidationStage__State &state, MultiMessage &x) const;
+
+    /**
+     * @brief Writes the statistics in `state` to `m_results_file_name`.
+     */
+    void write_results(const ValidationStage__State &state) const;
+
+    std::string m_val_file_name;
+    std::string m_results_file_name;
+    std::vector<std::string> m_include;
+    std::vector<std::string> m_exclude;
+    std::string m_index_col;
+    double m_abs_tol;
+    double m_rel_tol;
+    std::size_t m_max_samples;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** ValidationStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct ValidationStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a ValidationStage, and return the result.
+     */
+    static std::shared_ptr<ValidationStage> init(neo::Segment &parent,
+                                                 const std::string &name,
+                                                 std::string val_file_name,
+                                                 std::string results_file_name,
+                                                 std::vector<std::string> include,
+                                                 std::vector<std::string> exclude,
+                                                 std::string index_col,
+                                                 double abs_tol,
+                                                 double rel_tol,
+                                                 std::size_t max_samples);
+};
+#pragma GCC visibility pop
+}  // namespace morpheus
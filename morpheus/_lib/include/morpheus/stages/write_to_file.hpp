@@ -20,11 +20,14 @@
 #include <morpheus/io/serializers.hpp>
 #include <morpheus/messages/meta.hpp>
 #include <morpheus/objects/file_types.hpp>
+#include <morpheus/utilities/pipeline_drain.hpp>
 #include <morpheus/utilities/string_util.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <neo/core/segment.hpp>
 #include <pyneo/node.hpp>
 
+#include <cstddef>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -45,13 +48,41 @@ class WriteToFileStage : public neo::pyneo::PythonNode<std::shared_ptr<MessageMe
     using base_t::writer_type_t;
 
     /**
-     * TODO(Documentation)
+     * @brief Writes every message to `filename`. CSV and JSON are appended to the open stream. PARQUET, ORC and ARROW
+     * keep one chunked writer open for the lifetime of the stage, appending a row group (stripe, record batch) per
+     * message, and every message must have the same columns as the first. The index is not written to those formats.
+     *
+     * @param compression Empty for the writer's default. "none" or "snappy" for PARQUET and ORC, "none", "lz4" or
+     * "zstd" for ARROW. "none", "gzip" or "zstd" for CSV and JSON, which are compressed on the device with nvCOMP
+     * before being copied back to the host, see `GpuCompressedSink`. Requires building with `MORPHEUS_USE_NVCOMP`,
+     * and cannot be combined with `rotate_compression`. `rotate_bytes` then counts compressed bytes.
+     * @param queue_size CSV and JSON only. When greater than 0 formatted messages are handed to a dedicated writer
+     * thread through a queue of this many messages, so formatting overlaps the file writes and a slow disk only stalls
+     * the pipeline once the queue is full. 0 writes synchronously.
+     * @param flush_policy One of "none", "flush" or "fsync", see `FileFlushPolicy`. Only used when `queue_size` is
+     * greater than 0.
+     * @param rotate_bytes When greater than 0, a new file is started once the current one holds at least this many
+     * bytes. Messages are never split between files and every CSV file gets its own header.
+     * @param rotate_seconds When greater than 0, a new file is started once the current one has been open this long.
+     * Only checked when a message arrives.
+     * @param rotate_compression "gzip" compresses every finished file to `<name>.gz` on a background thread. Empty or
+     * "none" leaves them as is.
+     *
+     * When rotating, `filename` is a template: `{index}` is replaced by the zero padded index of the file and
+     * `{timestamp}` by the UTC time the file was started. Without either placeholder `.{index}` is inserted before
+     * the extension, e.g. `alerts.csv` becomes `alerts.00000.csv`, `alerts.00001.csv`, etc.
      */
     WriteToFileStage(const neo::Segment &parent,
                      const std::string &name,
                      const std::string &filename,
-                     std::ios::openmode mode = std::ios::out,
-                     FileTypes file_type     = FileTypes::Auto);
+                     std::ios::openmode mode               = std::ios::out,
+                     FileTypes file_type                   = FileTypes::Auto,
+                     const std::string &compression        = "",
+                     std::size_t queue_size                = 0,
+                     const std::string &flush_policy       = "flush",
+                     std::size_t rotate_bytes              = 0,
+                     std::size_t rotate_seconds            = 0,
+                     const std::string &rotate_compression = "");
 
   private:
     /**
@@ -59,23 +90,13 @@ class WriteToFileStage : public neo::pyneo::PythonNode<std::shared_ptr<MessageMe
      */
     void close();
 
-    void write_json(reader_type_t &msg)
-    {
-        // Call df_to_json passing our fstream
-        df_to_json(msg->get_info(), m_fstream);
-    }
-
-    void write_csv(reader_type_t &msg)
-    {
-        // Call df_to_csv passing our fstream
-        df_to_csv(msg->get_info(), m_fstream, m_is_first);
-    }
-
     operator_fn_t build_operator();
 
-    bool m_is_first;
-    std::ofstream m_fstream;
     std::function<void(reader_type_t &)> m_write_func;
+    std::function<void()> m_close_func;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+    std::shared_ptr<DrainProgress> m_drain_progress;
 };
 
 /****** WriteToFileStageInterfaceProxy******************/
@@ -90,8 +111,14 @@ struct WriteToFileStageInterfaceProxy
     static std::shared_ptr<WriteToFileStage> init(neo::Segment &parent,
                                                   const std::string &name,
                                                   const std::string &filename,
-                                                  const std::string &mode = "w",
-                                                  FileTypes file_type     = FileTypes::Auto);
+                                                  const std::string &mode               = "w",
+                                                  FileTypes file_type                   = FileTypes::Auto,
+                                                  const std::string &compression        = "",
+                                                  std::size_t queue_size                = 0,
+                                                  const std::string &flush_policy       = "flush",
+                                                  std::size_t rotate_bytes              = 0,
+                                                  std::size_t rotate_seconds            = 0,
+                                                  const std::string &rotate_compression = "");
 };
 
 #pragma GCC visibility pop
@@ -0,0 +1,101 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** WriteToKafkaStage********************************/
+/**
+ * @brief Produces every row of every message to `topic` as a JSON record, formatted by the native JSON writer. Each
+ * message is formatted into a single buffer which librdkafka references without copying until every record in it
+ * has been delivered. When the producer queue is full the stage polls until there is room, which stalls the
+ * upstream stages rather than buffering without bound. Messages are passed through unchanged, their completions are
+ * held until every record has been delivered and failed if any record could not be.
+ *
+ * Failed deliveries are counted and raised as an error by the next message, or on completion once the producer has
+ * been flushed.
+ */
+#pragma GCC visibility push(default)
+class WriteToKafkaStage : public neo::pyneo::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    /**
+     * @param config librdkafka producer configuration, must include "bootstrap.servers". "linger.ms" and
+     * "batch.num.messages" default to values favoring throughput when not set.
+     */
+    WriteToKafkaStage(const neo::Segment &parent,
+                      const std::string &name,
+                      std::string topic,
+                      std::map<std::string, std::string> config);
+
+    /**
+     * @return number of records acknowledged by the brokers
+     */
+    std::size_t delivered_message_count() const;
+
+    /**
+     * @return number of records which could not be delivered
+     */
+    std::size_t failed_message_count() const;
+
+  private:
+    operator_fn_t build_operator();
+
+    std::string m_topic;
+    std::map<std::string, std::string> m_config;
+
+    std::atomic<std::size_t> m_delivered_message_count{0};
+    std::atomic<std::size_t> m_failed_message_count{0};
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** WriteToKafkaStageInterfaceProxy******************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct WriteToKafkaStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a WriteToKafkaStage, and return the result.
+     */
+    static std::shared_ptr<WriteToKafkaStage> init(neo::Segment &parent,
+                                                   const std::string &name,
+                                                   std::string topic,
+                                                   std::map<std::string, std::string> config);
+};
+
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,75 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** WriteToUcxStage*************************************/
+/**
+ * @brief Sends every message to the `UcxSourceStage` listening on `host`:`port`, typically a pipeline on another host
+ * taking over the inference work. The columns are sent straight from device memory, see `UcxSender`. Messages are
+ * passed through unchanged once sent, and the receiver is told the stream ended when the input completes.
+ */
+#pragma GCC visibility push(default)
+class WriteToUcxStage : public neo::pyneo::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>
+{
+  public:
+    using base_t = neo::pyneo::PythonNode<std::shared_ptr<MessageMeta>, std::shared_ptr<MessageMeta>>;
+    using base_t::operator_fn_t;
+    using base_t::reader_type_t;
+    using base_t::writer_type_t;
+
+    WriteToUcxStage(const neo::Segment &parent, const std::string &name, std::string host, uint16_t port);
+
+  private:
+    operator_fn_t build_operator();
+
+    std::string m_host;
+    uint16_t m_port;
+
+    std::shared_ptr<StageMetrics> m_metrics;
+};
+
+/****** WriteToUcxStageInterfaceProxy***********************/
+/**
+ * @brief Interface proxy, used to insulate python bindings.
+ */
+struct WriteToUcxStageInterfaceProxy
+{
+    /**
+     * @brief Create and initialize a WriteToUcxStage, and return the result.
+     */
+    static std::shared_ptr<WriteToUcxStage> init(neo::Segment &parent,
+                                                 const std::string &name,
+                                                 std::string host,
+                                                 uint16_t port);
+};
+
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,104 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** CudaGraphCache *************************************/
+    /**
+     * @brief Replays fixed sequences of kernel launches as CUDA Graphs, one per key, typically the shape of the
+     * batch. The sequence of a key is captured once and every later call relaunches the cached executable graph with
+     * a single `cudaGraphLaunch`, without calling `launches` again.
+     *
+     * A replay writes to the addresses seen when the graph was captured, so `launches` must read every pointer that
+     * changes between calls, inputs and outputs alike, from `device_args`. This is a device copy of `host_args`, kept
+     * per key and refreshed before each launch. Outputs must be allocated by the caller before `run` and passed in
+     * `host_args`, and `launches` must not allocate.
+     *
+     * Keys run eagerly the first time they are seen, so one-off shapes never pay for instantiation, and once
+     * `max_graphs` keys are cached every new key runs eagerly. Sequences which cannot be captured, for instance
+     * because they synchronize or copy from pageable memory, fall back to eager execution for good.
+     *
+     * `launches` must only enqueue work on the stream it is given, must not yield the calling fiber, and must be safe
+     * to call twice, as it is run again eagerly when its capture fails. Graphs are only used once enabled with
+     * `set_enabled`.
+     */
+    class CudaGraphCache {
+    public:
+        using key_t = std::vector<int64_t>;
+        using launches_t = std::function<void(rmm::cuda_stream_view, const void *)>;
+
+        explicit CudaGraphCache(std::size_t max_graphs = 16);
+        ~CudaGraphCache();
+
+        CudaGraphCache(const CudaGraphCache &) = delete;
+        CudaGraphCache &operator=(const CudaGraphCache &) = delete;
+
+        /**
+         * @brief Enqueues `launches` on `rmm::cuda_stream_per_thread`, through the graph cached for `key` when there
+         * is one. Does not synchronize, `host_args` may be released once this returns. A key cached with arguments
+         * of a different size runs eagerly.
+         */
+        void run(const key_t &key, const std::vector<uint8_t> &host_args, const launches_t &launches);
+
+        /**
+         * @brief Number of times a sequence was captured, once per cached key unless a capture failed.
+         */
+        std::size_t capture_count();
+
+        /**
+         * @brief Process wide switch, off by default. When off `run` always calls `launches` directly.
+         */
+        static void set_enabled(bool enabled);
+
+        static bool enabled();
+
+    private:
+        struct Entry {
+            cudaGraphExec_t exec{nullptr};
+            bool eager{false};
+
+            // Device copy of the arguments of the last launch, read by the graph
+            std::unique_ptr<rmm::device_buffer> args;
+
+            // Recorded after each launch. The next launch waits on it before overwriting `args`, even from another
+            // stream
+            cudaEvent_t launched{nullptr};
+        };
+
+        std::size_t m_max_graphs;
+        std::size_t m_capture_count{0};
+
+        std::mutex m_mutex;
+        std::map<key_t, Entry> m_entries;
+    };
+}  // namespace morpheus
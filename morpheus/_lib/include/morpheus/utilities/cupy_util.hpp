@@ -38,13 +38,28 @@ struct CupyUtil
     static pybind11::module_ get_cp();
 
     /**
-     * TODO(Documentation)
+     * @brief Returns a cupy array viewing `tensor` without copying, exchanged through a DLPack capsule. Boolean
+     * tensors, which DLPack 0.5 cannot describe, go through `__cuda_array_interface__` instead.
      */
     static pybind11::object tensor_to_cupy(const TensorObject &tensor);
 
     /**
-     * TODO(Documentation)
+     * @brief Converts a cupy array, or any object implementing `__dlpack__`, to a tensor. See `from_dlpack`.
      */
     static TensorObject cupy_to_tensor(pybind11::object cupy_array);
+
+    /**
+     * @brief Exports `tensor` as a DLPack capsule without copying. The capsule keeps the tensor, and its memory, alive
+     * until the consumer is done with it. Work queued on the per-thread stream is made visible to `stream`, using the
+     * `__dlpack__` values: `None` or 1 for the legacy default stream, 2 for the per-thread default stream, -1 to skip
+     * synchronization, otherwise a `cudaStream_t`.
+     */
+    static pybind11::capsule to_dlpack(const TensorObject &tensor, pybind11::object stream = pybind11::none());
+
+    /**
+     * @brief Consumes a DLPack capsule. Tensors own their device memory, so the data is copied into a new buffer on
+     * the per-thread stream, which is synchronized before the capsule's memory is released.
+     */
+    static TensorObject from_dlpack(pybind11::capsule capsule);
 };
 }  // namespace morpheus
@@ -0,0 +1,62 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** DeviceAffinity *************************************/
+    /**
+     * @brief Places threads next to a GPU. On multi-socket hosts a GPU is attached to the PCIe root of one NUMA
+     * node, and host buffers or threads on the other sockets have every copy to and from that GPU cross the socket
+     * interconnect. The topology is read from sysfs, so hosts without NUMA information fall back to only selecting
+     * the CUDA device.
+     */
+    struct DeviceAffinity {
+        /**
+         * @brief NUMA node the GPU `device_id` is attached to, or -1 if unknown. Results are cached per device.
+         */
+        static int numa_node(int device_id);
+
+        /**
+         * @brief CPUs belonging to `numa_node`, empty if the node does not exist.
+         */
+        static std::vector<int> numa_cpus(int numa_node);
+
+        /**
+         * @brief Parses a sysfs cpu list such as "0-3,8,10-11" into the CPUs it holds.
+         */
+        static std::vector<int> parse_cpu_list(const std::string &cpu_list);
+
+        /**
+         * @brief Makes `device_id` the current CUDA device of the calling thread and restricts the thread to the
+         * CPUs of the NUMA node closest to it. Does nothing when `device_id` is negative. Called from a fiber this
+         * binds the thread running it, and with it every fiber sharing that thread. Repeat calls for the device the
+         * thread is already bound to return immediately, so tasks can call this every time they run.
+         */
+        static void bind_current_thread(int device_id);
+
+        /**
+         * @brief NUMA node the calling thread was bound to by `bind_current_thread`, or -1 if it was not bound.
+         * `PinnedHostPool` uses this to keep page-locked blocks on the node which allocated them.
+         */
+        static int current_numa_node();
+    };
+}  // namespace morpheus
@@ -0,0 +1,104 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <rmm/cuda_stream_view.hpp>
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** DeviceOperationStats *******************************/
+    /**
+     * @brief GPU time spent in a single annotated operation, measured between two events recorded on its stream.
+     */
+    struct DeviceOperationStats {
+        uint64_t count{0};
+        uint64_t total_ns{0};
+        uint64_t max_ns{0};
+    };
+
+    /****** DeviceAnnotation ***********************************/
+    /**
+     * @brief NVTX ranges and event based GPU timing for device work issued by `MatxUtil` and the stages. Operations
+     * are annotated with `MORPHEUS_DEVICE_RANGE`, which only expands to anything when the library is built with
+     * `MORPHEUS_ENABLE_DEVICE_ANNOTATIONS`. Timing is off by default even then, and is turned on with
+     * `set_timing_enabled`.
+     */
+    struct DeviceAnnotation {
+#ifdef MORPHEUS_ENABLE_DEVICE_ANNOTATIONS
+        static constexpr bool Enabled = true;
+#else
+        static constexpr bool Enabled = false;
+#endif
+
+        /**
+         * @brief Records a pair of events around every range opened after this call. Has no effect unless `Enabled`.
+         */
+        static void set_timing_enabled(bool enabled);
+
+        static bool timing_enabled();
+
+        /**
+         * @brief Timings of every operation seen since the last call to `reset`, keyed by range name. Waits for the
+         * events of ranges still in flight.
+         */
+        static std::map<std::string, DeviceOperationStats> stats();
+
+        static void reset();
+
+        /**
+         * @brief Opens an NVTX range for the lifetime of the object and, when timing is enabled, records an event on
+         * `stream` at construction and destruction. `name` must outlive the process, it is used as the key of the
+         * aggregated timings. Work enqueued by the operation must be on `stream` for the timing to be meaningful.
+         * Ranges are started and ended rather than pushed and popped, so they stay correct when a fiber yields while
+         * one is open.
+         */
+        class ScopedRange {
+        public:
+            explicit ScopedRange(const char *name, rmm::cuda_stream_view stream = rmm::cuda_stream_per_thread);
+            ~ScopedRange();
+
+            ScopedRange(const ScopedRange &) = delete;
+            ScopedRange &operator=(const ScopedRange &) = delete;
+
+        private:
+            const char *m_name;
+            rmm::cuda_stream_view m_stream;
+            uint64_t m_range{0};
+            void *m_start{nullptr};
+        };
+    };
+}  // namespace morpheus
+
+#define MORPHEUS_DEVICE_RANGE_CONCAT_IMPL(a, b) a##b
+#define MORPHEUS_DEVICE_RANGE_CONCAT(a, b) MORPHEUS_DEVICE_RANGE_CONCAT_IMPL(a, b)
+
+#ifdef MORPHEUS_ENABLE_DEVICE_ANNOTATIONS
+/**
+ * @brief Annotates the rest of the enclosing scope as the device operation `name`, optionally followed by the stream
+ * its work is enqueued on. Compiles to nothing unless built with `MORPHEUS_ENABLE_DEVICE_ANNOTATIONS`.
+ */
+#define MORPHEUS_DEVICE_RANGE(...)                                                                                     \
+    const ::morpheus::DeviceAnnotation::ScopedRange MORPHEUS_DEVICE_RANGE_CONCAT(morpheus_device_range_, __LINE__)(  \
+            __VA_ARGS__)
+#else
+#define MORPHEUS_DEVICE_RANGE(...) static_cast<void>(0)
+#endif
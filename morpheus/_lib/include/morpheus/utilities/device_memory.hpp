@@ -0,0 +1,95 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** DeviceMemoryStats **********************************/
+    /**
+     * @brief Device allocation counters for a single tag, in bytes unless stated otherwise.
+     */
+    struct DeviceMemoryStats {
+        std::size_t current_bytes{0};
+        std::size_t peak_bytes{0};
+        std::size_t total_bytes{0};
+        std::size_t allocation_count{0};
+    };
+
+    /****** DeviceMemory ***************************************/
+    /**
+     * @brief Process wide device memory resource stack. Once configured, every `rmm::device_buffer` created without
+     * an explicit memory resource (stage outputs, `MatxUtil` results, cuDF columns) is drawn from it, and all
+     * allocations are counted against the tag of the calling thread.
+     */
+    struct DeviceMemory {
+        /**
+         * @brief Allocations made while no tag is set are counted against this tag.
+         */
+        static constexpr const char *DefaultTag = "other";
+
+        /**
+         * @brief Installs the resource stack as the current device resource of the current device, or gives each of
+         * `device_ids` a stack of its own.
+         *
+         * @param resource One of "cuda" (plain cudaMalloc/cudaFree), "pool" or "arena".
+         * @param initial_pool_bytes Initial size of the pool, 0 uses the RMM default. Ignored unless `resource` is
+         * "pool".
+         * @param maximum_pool_bytes Size the pool may grow to, 0 for no limit. Ignored unless `resource` is "pool".
+         * @param device_ids Devices to configure, each with its own pool. Peer access is enabled between them, so a
+         * stage running on one device can read the messages produced on another. Throws `std::runtime_error` when a
+         * pair of them does not support it. Empty configures only the current device.
+         */
+        static void configure(const std::string &resource,
+                              std::size_t initial_pool_bytes = 0,
+                              std::size_t maximum_pool_bytes = 0,
+                              const std::vector<int> &device_ids = {});
+
+        /**
+         * @brief Name of the resource set by the last call to `configure`, empty if it was never called.
+         */
+        static std::string resource();
+
+        /**
+         * @brief Allocation counters for every tag seen since the last call to `configure`, summed over every device
+         * it configured.
+         */
+        static std::map<std::string, DeviceMemoryStats> stats();
+
+        /**
+         * @brief Sets the allocation tag of the calling thread for the lifetime of the object, restoring the
+         * previous tag on destruction. Stages running on fibers which yield while a tag is held can have allocations
+         * of other fibers on the same thread counted against it, making the attribution approximate.
+         */
+        class ScopedTag {
+        public:
+            explicit ScopedTag(const char *tag);
+            ~ScopedTag();
+
+            ScopedTag(const ScopedTag &) = delete;
+            ScopedTag &operator=(const ScopedTag &) = delete;
+
+        private:
+            const char *m_previous;
+        };
+    };
+}  // namespace morpheus
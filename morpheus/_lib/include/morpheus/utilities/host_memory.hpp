@@ -0,0 +1,105 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** PinnedHostBuffer ***********************************/
+    /**
+     * @brief Page-locked host buffer drawn from `PinnedHostPool`. Move only, the memory goes back to the pool when
+     * the buffer is destroyed. Copies between the device and a pinned buffer can be asynchronous and run at full
+     * PCIe bandwidth, unlike copies to pageable memory.
+     */
+    class PinnedHostBuffer {
+    public:
+        PinnedHostBuffer() = default;
+        ~PinnedHostBuffer();
+
+        PinnedHostBuffer(PinnedHostBuffer &&other) noexcept;
+        PinnedHostBuffer &operator=(PinnedHostBuffer &&other) noexcept;
+
+        PinnedHostBuffer(const PinnedHostBuffer &) = delete;
+        PinnedHostBuffer &operator=(const PinnedHostBuffer &) = delete;
+
+        uint8_t *data() const {
+            return m_data;
+        }
+
+        /**
+         * @brief Number of bytes requested, the underlying block may be larger.
+         */
+        std::size_t size() const {
+            return m_size;
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+    private:
+        friend struct PinnedHostPool;
+
+        PinnedHostBuffer(uint8_t *data, std::size_t size, std::size_t capacity, int numa_node);
+
+        void release();
+
+        uint8_t *m_data{nullptr};
+        std::size_t m_size{0};
+        std::size_t m_capacity{0};
+        int m_numa_node{-1};
+    };
+
+    /****** PinnedHostPool *************************************/
+    /**
+     * @brief Process wide cache of page-locked host blocks, used for device to host staging. Blocks are rounded up
+     * to a power of two so buffers of similar sizes share blocks, and released blocks are kept for reuse up to
+     * `MaxCachedBytes`. `cudaMallocHost` is slow and synchronizes the device, so steady state traffic should
+     * not allocate at all once the pool is warm. Blocks are cached per NUMA node of the acquiring thread, see
+     * `DeviceAffinity::bind_current_thread`, so a thread bound next to its GPU only reuses blocks allocated on its
+     * own node.
+     */
+    struct PinnedHostPool {
+        /**
+         * @brief Released blocks beyond this many bytes are freed instead of cached.
+         */
+        static constexpr std::size_t MaxCachedBytes = 256 * 1024 * 1024;
+
+        /**
+         * @brief Returns a buffer of at least `bytes`. Contents are not initialized.
+         */
+        static PinnedHostBuffer acquire(std::size_t bytes);
+
+        /**
+         * @brief Frees every cached block. Buffers still held go back to the pool when they are released.
+         */
+        static void clear();
+
+        /**
+         * @brief Total bytes of the blocks currently cached.
+         */
+        static std::size_t cached_bytes();
+
+    private:
+        friend class PinnedHostBuffer;
+
+        static void release(uint8_t *data, std::size_t capacity, int numa_node);
+    };
+}  // namespace morpheus
@@ -0,0 +1,61 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace morpheus {
+struct JsonUtil
+{
+    /**
+     * @brief Checks that a line is a single JSON object or array, optionally surrounded by whitespace. The grammar is
+     * fully checked: every key is a string followed by `:` and a value, no empty or trailing `,`, exact `true`,
+     * `false` and `null` literals, JSON number syntax and strings with valid escapes. Lines nested deeper than 64
+     * levels are rejected. This is the same check `validate_json_lines` runs on the device
+     * @param data Start of the line
+     * @param size Number of bytes in the line
+     * @return true when the line is valid
+     */
+    static bool is_valid_json_line(const char *data, std::size_t size);
+
+    /**
+     * @brief Checks each line of a buffer of newline delimited JSON on the device, one thread per line, with the same
+     * rules as `is_valid_json_line`.
+     * @param host_data Host buffer containing all of the lines. Should be pinned for best performance
+     * @param line_offsets Offset of the start of each line in `host_data` followed by the total size, N + 1 entries
+     * @return One entry per line, 1 when the line is valid and 0 otherwise
+     */
+    static std::vector<uint8_t> validate_json_lines(const char *host_data, const std::vector<std::size_t> &line_offsets);
+
+    /**
+     * @brief Decodes the JSON escape sequences (`\"`, `\\`, `\/`, `\b`, `\f`, `\n`, `\r`, `\t` and `\uXXXX`
+     * including surrogate pairs) left in a strings column by the cuDF JSON reader. Each string is read once to size
+     * the output and once to write it, with a single allocation for all of the output characters. Malformed sequences
+     * are copied unchanged.
+     * @param input Strings column to unescape
+     * @return New strings column with the same null mask
+     */
+    static std::unique_ptr<cudf::column> unescape_strings(const cudf::column_view &input);
+};
+}  // namespace morpheus
@@ -22,10 +22,87 @@
 #include <morpheus/objects/tensor_object.hpp>
 #include <morpheus/utilities/type_util_detail.hpp>
 
+#include <cudf/column/column_view.hpp>
+
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace morpheus {
+/**
+ * @brief Reductions supported by `MatxUtil::reduce_rows` and `MatxUtil::reduce_by_seq_ids`
+ */
+enum class RowReduction : int32_t
+{
+    MAX,
+    MIN,
+    SUM,
+    MEAN,
+};
+
+/**
+ * @brief One step of an expression applied by `MatxUtil::apply_elementwise`. `a` and `b` are the step's parameters:
+ * the factor for SCALE, the addend for OFFSET, the bounds for CLAMP and the level for THRESHOLD (giving 1 or 0)
+ */
+struct ElementwiseOp
+{
+    enum class Kind : int32_t
+    {
+        SIGMOID,
+        EXP,
+        LOG,
+        ABS,
+        SCALE,
+        OFFSET,
+        CLAMP,
+        THRESHOLD,
+    };
+
+    Kind kind;
+    double a{0};
+    double b{0};
+};
+
+/**
+ * @brief Node of a decision tree flattened for `MatxUtil::predict_forest`. Splits send rows where
+ * `input[feature] < value` to `left`, the others to `right` and rows where the feature is NaN to `missing`. Leaves
+ * have `left == -1` and hold their output in `value`. Child indices are absolute within the node array
+ */
+struct ForestNode
+{
+    int32_t feature;
+    float value;
+    int32_t left;
+    int32_t right;
+    int32_t missing;
+};
+
+/**
+ * @brief Bins spanned by the rows passed to `MatxUtil::time_bins`. `first` and `last` are the bins of the first and
+ * last row, `min` and `max` the extremes over every row
+ */
+struct TimeBinRange
+{
+    int32_t first;
+    int32_t last;
+    int32_t min;
+    int32_t max;
+};
+
+/**
+ * @brief Event window read by `MatxUtil::window_signals`. `counts` is a ring of `capacity` per-bin event counts, bin
+ * `b` living at `counts[b % capacity]`. Only bins in `[lo, hi]` hold counts, every other bin is read as zero
+ */
+struct TimeSeriesWindow
+{
+    const int32_t *counts;
+    int32_t capacity;
+    int32_t lo;
+    int32_t hi;
+    int32_t first_bin;
+};
+
 struct MatxUtil
 {
     /**
@@ -34,6 +111,167 @@ struct MatxUtil
      */
     static std::shared_ptr<rmm::device_buffer> cast(const DevMemInfo &input, TypeId output_type);
 
+    /**
+     * @brief Same as `cast` for `element_count` contiguous elements at `input`, but writes to `output` instead of a
+     * new buffer. `output` may be any device accessible memory, including pinned host memory, which fuses the
+     * conversion with a device to host copy. Enqueued on `stream` without synchronizing
+     */
+    static void cast_into(const void *input,
+                          TypeId input_type,
+                          std::size_t element_count,
+                          TypeId output_type,
+                          void *output,
+                          rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Narrows UINT32 columns to INT32 with a single kernel launch. The outputs share one newly allocated
+     * buffer, each starting at a 256 byte aligned offset
+     * @return One DevMemInfo per input, in the same order
+     */
+    static std::vector<DevMemInfo> narrow_to_int32(const std::vector<cudf::column_view> &inputs);
+
+    /**
+     * @brief Packs numeric or boolean columns, all with the same number of rows, into a row-major [rows, columns]
+     * float32 matrix with a single kernel launch. With up to 64 columns the launch is enqueued on
+     * `rmm::cuda_stream_per_thread` without synchronizing, so the columns must outlive it. Wider tables synchronize
+     * @return
+     */
+    static std::shared_ptr<rmm::device_buffer> pack_columns(const std::vector<cudf::column_view> &columns);
+
+    /**
+     * @brief Same as `pack_columns` but scales every value of column i to `(x - shift[i]) * scale[i]` in the same
+     * launch, so features normalized with per-feature statistics never take a separate pass. `shift` and `scale` must
+     * either hold one entry per column or be empty, in which case values are packed unchanged
+     * @return
+     */
+    static std::shared_ptr<rmm::device_buffer> pack_columns(const std::vector<cudf::column_view> &columns,
+                                                            const std::vector<float> &shift,
+                                                            const std::vector<float> &scale);
+
+    /**
+     * @brief Builds the arguments read back on the device by `pack_features`: the `packed` [rows, columns] float32
+     * and `seg_ids` [rows, 3] uint32 outputs, allocated by the caller, and the columns, validated as `pack_columns`
+     * does
+     * @return Host copy of the arguments, to be copied to the device
+     */
+    static std::vector<uint8_t> pack_features_args(const std::vector<cudf::column_view> &columns,
+                                                   const std::vector<float> &shift,
+                                                   const std::vector<float> &scale,
+                                                   float *packed,
+                                                   uint32_t *seg_ids);
+
+    /**
+     * @brief Writes `pack_columns(columns, shift, scale)` and `create_seg_ids(rows, columns.size(), TypeId::UINT32)`
+     * into the outputs given to `pack_features_args` with a single kernel launch. Every pointer is read from
+     * `device_args`, so a `CudaGraphCache` graph of the launch, captured once per shape, replays with new columns
+     * and outputs. Does not synchronize
+     */
+    static void pack_features(const void *device_args,
+                              std::size_t rows,
+                              std::size_t cols,
+                              rmm::cuda_stream_view stream);
+
+    /**
+     * @brief Gathers rows of a 2D tensor in the order given by `row_indices` (a device pointer with `rows` entries),
+     * keeping only the first `cols` columns. Enqueued on `rmm::cuda_stream_per_thread` without synchronizing
+     * @return A contiguous [rows, cols] buffer
+     */
+    static std::shared_ptr<rmm::device_buffer> gather_rows(const TensorObject &input,
+                                                           const int32_t *row_indices,
+                                                           std::size_t rows,
+                                                           std::size_t cols);
+
+    /**
+     * @brief Inverse of `gather_rows` for whole rows, row i of `input` is written to row `row_indices[i]`. Enqueued on
+     * `rmm::cuda_stream_per_thread` without synchronizing
+     * @return A contiguous buffer with the same shape as `input`
+     */
+    static std::shared_ptr<rmm::device_buffer> scatter_rows(const TensorObject &input, const int32_t *row_indices);
+
+    /**
+     * @brief Same as `scatter_rows`, writing into `output`, an existing contiguous buffer with the type and number of
+     * columns of `input` and more than `row_indices[i]` rows. Rows not in `row_indices` are left unchanged. Enqueued
+     * on `rmm::cuda_stream_per_thread` without synchronizing
+     */
+    static void scatter_rows_into(const TensorObject &input, const int32_t *row_indices, void *output);
+
+    /**
+     * @brief Writes column `input_columns[i]` of a strided 2D tensor to the contiguous array `outputs[i]`, with one
+     * kernel launch for up to 64 columns. Outputs have `output_type`, either the type of `input` or FLOAT32 for half
+     * inputs. Enqueued on `stream` without synchronizing
+     */
+    static void scatter_columns(const TensorObject &input,
+                                const std::vector<std::size_t> &input_columns,
+                                const std::vector<void *> &outputs,
+                                TypeId output_type,
+                                rmm::cuda_stream_view stream);
+
+    /**
+     * @brief 64-bit FNV-1a hash of the width and bytes of each row of a 2D tensor, written to `hashes` (a device
+     * pointer with one entry per row). When `combine` is set hashing continues from the values already in `hashes`,
+     * so the rows of several tensors can be hashed together. Enqueued on `rmm::cuda_stream_per_thread` without
+     * synchronizing
+     */
+    static void hash_rows(const TensorObject &input, uint64_t *hashes, bool combine);
+
+    /**
+     * @brief For each row of a 2D tensor, returns the index of the last non-zero element plus one. Used to find the
+     * number of tokens in each row of an attention mask
+     * @return
+     */
+    static std::vector<int32_t> row_lengths(const TensorObject &input);
+
+    /*
+     * The primitives below take a strided 2D FLOAT32 or FLOAT64 tensor, write row-major outputs and are enqueued on
+     * `rmm::cuda_stream_per_thread` without synchronizing.
+     */
+
+    /**
+     * @brief Reduces each row of a 2D tensor to a single value
+     * @return An Nx1 buffer with the same type as `input`
+     */
+    static std::shared_ptr<rmm::device_buffer> reduce_rows(const TensorObject &input, RowReduction reduction);
+
+    /**
+     * @brief Row-wise softmax
+     * @return A buffer with the same shape and type as `input`
+     */
+    static std::shared_ptr<rmm::device_buffer> softmax(const TensorObject &input);
+
+    /**
+     * @brief Column index of the largest value in each row, ties give the lowest column
+     * @return An Nx1 INT32 buffer
+     */
+    static std::shared_ptr<rmm::device_buffer> argmax(const TensorObject &input);
+
+    /**
+     * @brief The `k` largest values of each row in descending order, along with their column indices. `k` can be at
+     * most 32
+     * @return A [rows, k] array of values with the type of `input`, followed by a [rows, k] INT32 array of indices,
+     * sharing one buffer
+     */
+    static std::vector<DevMemInfo> top_k(const TensorObject &input, std::size_t k);
+
+    /**
+     * @brief Reduces the rows of `input` that belong to the same message, as given by the first column of `seq_ids`
+     * (sorted, INT32 or UINT32). Used to merge the results of overlapping token windows back into one row per message.
+     * Messages without any rows are set to 0
+     * @param first_message Id of the first output row. Slices of an inference message keep the ids of the whole message
+     * @return A [num_messages, cols] buffer with the same type as `input`
+     */
+    static std::shared_ptr<rmm::device_buffer> reduce_by_seq_ids(const TensorObject &input,
+                                                                 const TensorObject &seq_ids,
+                                                                 std::size_t num_messages,
+                                                                 RowReduction reduction,
+                                                                 std::size_t first_message = 0);
+
+    /**
+     * @brief Applies up to 8 ops in order to every element with a single kernel launch
+     * @return A buffer with the same shape and type as `input`
+     */
+    static std::shared_ptr<rmm::device_buffer> apply_elementwise(const TensorObject &input,
+                                                                 const std::vector<ElementwiseOp> &ops);
+
     /**
      * @brief Builds a Nx3 segment ID matrix
      * @return
@@ -46,6 +284,13 @@ struct MatxUtil
      */
     static std::shared_ptr<rmm::device_buffer> logits(const DevMemInfo &input);
 
+    /**
+     * @brief Writes the sigmoid of `element_count` values of type `type_id` from `input` to `output`, without
+     * allocating. `input` and `output` may be the same pointer to apply it in place. Enqueued on the per-thread
+     * default stream.
+     */
+    static void logits_into(const void *input, void *output, std::size_t element_count, TypeId type_id);
+
     /**
      * @brief Perform transpose
      * @return
@@ -54,7 +299,7 @@ struct MatxUtil
 
     /**
      * @brief Return an array of boolean where x[i,j] >= thresh_val, when by_row is true an Nx1 array will be returned
-     * with a true if any value in the row is above the threshold
+     * with a true if any value in the row is above the threshold. The output is always row-major
      * @return
      */
     static std::shared_ptr<rmm::device_buffer> threshold(const DevMemInfo &input,
@@ -63,5 +308,87 @@ struct MatxUtil
                                                          const std::vector<TensorIndex> &stride,
                                                          double thresh_val,
                                                          bool by_row);
+
+    /**
+     * @brief Same as above, reading the shape and strides from a 2D tensor in place, without copying it
+     * @return
+     */
+    static std::shared_ptr<rmm::device_buffer> threshold(const TensorObject &input, double thresh_val, bool by_row);
+
+    /**
+     * @brief Computes both thresholds of a 2D tensor in one pass: a row-major [rows, cols] array of `x[i,j] >
+     * thresh_val`, and an Nx1 array that is true when any value in the row is above `row_thresh_val`
+     * @return The element-wise result followed by the row-wise result, sharing one buffer
+     */
+    static std::vector<DevMemInfo> threshold_with_row_any(const TensorObject &input,
+                                                          double thresh_val,
+                                                          double row_thresh_val);
+
+    /**
+     * @brief Evaluates a tree ensemble on every row of `input` (one row per sample, one column per feature). Each row
+     * starts at `base_margin` for every output, and the leaf of each tree is added to output `tree_outputs[tree]`.
+     * With `sigmoid` set the sums are passed through a sigmoid. `nodes`, `tree_roots` and `tree_outputs` must be in
+     * device memory
+     * @return A [rows, num_outputs] FLOAT32 buffer
+     */
+    static std::shared_ptr<rmm::device_buffer> predict_forest(const TensorObject &input,
+                                                              const ForestNode *nodes,
+                                                              const int32_t *tree_roots,
+                                                              const int32_t *tree_outputs,
+                                                              std::size_t num_trees,
+                                                              std::size_t num_outputs,
+                                                              float base_margin,
+                                                              bool sigmoid);
+
+    /**
+     * @brief Writes the bin of every timestamp to `row_bins`: the number of `resolution_sec` intervals between
+     * `t0_sec` and the timestamp rounded to the nearest second (half to even). `ticks` holds `rows` timestamps of
+     * `ticks_per_second` units each, in device memory. Synchronizes to return the range of bins
+     */
+    static TimeBinRange time_bins(const int64_t *ticks,
+                                  std::size_t rows,
+                                  int64_t ticks_per_second,
+                                  int64_t t0_sec,
+                                  int64_t resolution_sec,
+                                  int32_t *row_bins);
+
+    /**
+     * @brief Adds one to the ring slot of every row whose bin is within `[lo, hi]`, the other rows are ignored. See
+     * `TimeSeriesWindow` for the layout of `counts`
+     */
+    static void add_to_histogram(
+        const int32_t *row_bins, std::size_t rows, int32_t lo, int32_t hi, int32_t *counts, std::size_t capacity);
+
+    /**
+     * @brief Gathers `length` consecutive bins starting at `first_bin` of every window, as FLOAT64 signals. Follows
+     * `numpy.histogram`, the last value also counts the bin following the window
+     * @return A [windows, length] FLOAT64 buffer
+     */
+    static std::shared_ptr<rmm::device_buffer> window_signals(const std::vector<TimeSeriesWindow> &windows,
+                                                              std::size_t length);
+
+    /**
+     * @brief Flags outliers of `num_signals` FLOAT64 signals of `length` values each, with a single batched cuFFT
+     * plan. The frequencies whose periodogram falls below its `filter_percent` percentile are removed, and values
+     * whose reconstruction error has a z-score of at least `zscore_threshold` are flagged. Matches `fftAD` of the
+     * Python `TimeSeriesStage`
+     * @return A [num_signals, length] BOOL8 buffer
+     */
+    static std::shared_ptr<rmm::device_buffer> fft_anomalies(const double *signals,
+                                                             std::size_t num_signals,
+                                                             std::size_t length,
+                                                             double filter_percent,
+                                                             double zscore_threshold);
+
+    /**
+     * @brief Sets `row_flags[row]` when the bin of the row falls in `[first_bin, first_bin + num_bins)` and is set in
+     * `bin_flags`, and clears it otherwise
+     */
+    static void flag_rows(const int32_t *row_bins,
+                          std::size_t rows,
+                          const bool *bin_flags,
+                          int32_t first_bin,
+                          std::size_t num_bins,
+                          bool *row_flags);
 };
 }  // namespace morpheus
@@ -0,0 +1,138 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** DrainStatus ****************************************/
+    /**
+     * @brief Point in time copy of the drain progress of one stage.
+     */
+    struct DrainStatus {
+        std::size_t in_flight{0};  // Units of work accepted and not yet finished, messages or Kafka batches
+        bool drained{false};       // Set once the stage finished everything it accepted and completed
+    };
+
+    /****** DrainProgress **************************************/
+    /**
+     * @brief Lock free drain progress of a single stage, registered by stage name with `PipelineDrain::track`.
+     */
+    class DrainProgress {
+    public:
+        void add(std::size_t count = 1) {
+            m_in_flight += count;
+        }
+
+        void remove(std::size_t count = 1) {
+            m_in_flight -= count;
+        }
+
+        void set_in_flight(std::size_t count) {
+            m_in_flight = count;
+        }
+
+        void set_drained() {
+            m_drained = true;
+        }
+
+        DrainStatus status() const {
+            return DrainStatus{m_in_flight.load(), m_drained.load()};
+        }
+
+        /**
+         * @brief Counts one unit of work in flight for the lifetime of the scope.
+         */
+        class Scope {
+        public:
+            explicit Scope(DrainProgress &progress) : m_progress(progress) {
+                m_progress.add();
+            }
+
+            ~Scope() {
+                m_progress.remove();
+            }
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+        private:
+            DrainProgress &m_progress;
+        };
+
+    private:
+        std::atomic<std::size_t> m_in_flight{0};
+        std::atomic<bool> m_drained{false};
+    };
+
+    /****** PipelineDrain **************************************/
+    /**
+     * @brief Process wide request to drain the running pipeline, for scaling in without losing or replaying data.
+     *
+     * Once requested, sources stop consuming, emit what they already consumed and complete. Completion then flows
+     * through the pipeline as it does at the end of a finite input: inference stages finish their outstanding
+     * requests and writers flush and close their files. Kafka sources committing on completion keep committing the
+     * offsets of batches released downstream after completing, until every batch was released or the deadline passed.
+     * Past the deadline stages stop waiting on in-flight work, and the caller is expected to stop the pipeline.
+     */
+    class PipelineDrain {
+    public:
+        using clock_t = std::chrono::steady_clock;
+
+        /**
+         * @brief Asks the sources to stop consuming. Work already consumed may take `timeout` to finish. Calling again
+         * only ever moves the deadline closer.
+         */
+        static void request(std::chrono::milliseconds timeout);
+
+        static bool requested();
+
+        /**
+         * @brief Whether a drain was requested and its deadline passed.
+         */
+        static bool expired();
+
+        /**
+         * @brief Deadline of the current drain, `clock_t::time_point::max()` when none was requested.
+         */
+        static clock_t::time_point deadline();
+
+        /**
+         * @brief Clears the request and the registered stages, so a pipeline built later in the same process runs
+         * normally.
+         */
+        static void reset();
+
+        /**
+         * @brief Returns the progress of the stage called `name`, creating it on first use.
+         */
+        static std::shared_ptr<DrainProgress> track(const std::string &name);
+
+        /**
+         * @brief Progress of every registered stage, keyed by stage name.
+         */
+        static std::map<std::string, DrainStatus> progress();
+    };
+}  // namespace morpheus
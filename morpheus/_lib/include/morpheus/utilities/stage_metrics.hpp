@@ -0,0 +1,207 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** StageMetricsSnapshot *******************************/
+    /**
+     * @brief Point in time copy of the counters of one stage. Times are in nanoseconds.
+     */
+    struct StageMetricsSnapshot {
+        uint64_t messages_in{0};
+        uint64_t rows_in{0};
+        uint64_t messages_out{0};
+        uint64_t rows_out{0};
+
+        // Time spent in on_next, excluding time blocked on downstream
+        uint64_t processing_ns{0};
+
+        // Time spent in the downstream on_next, which blocks once the downstream channel is full
+        uint64_t blocked_ns{0};
+
+        // Count of on_next calls whose processing time was at most the matching `StageMetrics::LatencyBucketsUs`
+        // bound and above the previous one. The last entry counts everything above the largest bound.
+        std::vector<uint64_t> latency_buckets;
+
+        // Time from the source timestamp of traced messages to the end of their on_next, bucketed by
+        // `StageMetrics::SourceLatencyBucketsMs` like `latency_buckets`
+        std::vector<uint64_t> source_latency_buckets;
+        uint64_t source_latency_ns{0};
+    };
+
+    /****** StageMetrics ***************************************/
+    /**
+     * @brief Lock free counters for a single C++ stage, registered by stage name. Stages hold the instance from `get`
+     * and wrap each on_next in a `StageMetrics::Scope`, which also marks the call with an NVTX range named after the
+     * stage. The counters are read while the pipeline runs with `snapshot_all` or `prometheus_text`.
+     */
+    class StageMetrics {
+    public:
+        /**
+         * @brief Upper bounds, in microseconds, of the on_next latency histogram buckets.
+         */
+        static constexpr std::array<uint64_t, 12> LatencyBucketsUs = {
+                10, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 50000, 100000, 1000000};
+
+        /**
+         * @brief Upper bounds, in milliseconds, of the histogram of the time since traced messages were produced.
+         */
+        static constexpr std::array<uint64_t, 13> SourceLatencyBucketsMs = {
+                1, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000, 60000};
+
+        explicit StageMetrics(std::string name);
+
+        /**
+         * @brief Returns the metrics of the stage called `name`, creating them on first use.
+         */
+        static std::shared_ptr<StageMetrics> get(const std::string &name);
+
+        /**
+         * @brief Snapshots of every registered stage, keyed by stage name.
+         */
+        static std::map<std::string, StageMetricsSnapshot> snapshot_all();
+
+        /**
+         * @brief Every registered stage, plus the device memory counters of `DeviceMemory::stats`, in the Prometheus
+         * text exposition format.
+         */
+        static std::string prometheus_text();
+
+        const std::string &name() const {
+            return m_name;
+        }
+
+        StageMetricsSnapshot snapshot() const;
+
+        void record_in(std::size_t rows);
+        void record_out(std::size_t rows, uint64_t blocked_ns);
+        void record_processing(uint64_t processing_ns);
+        void record_source_latency(uint64_t latency_ns);
+
+        /**
+         * @brief Forwards `message` to `output`, counting it and the time spent blocked on the downstream.
+         * @return The time blocked, in nanoseconds
+         */
+        template<typename SubscriberT, typename MessageT>
+        uint64_t emit(SubscriberT &output, MessageT &&message) {
+            const auto rows = message_rows(message);
+            const auto start = std::chrono::steady_clock::now();
+
+            output.on_next(std::forward<MessageT>(message));
+
+            const auto blocked_ns = elapsed_ns(start);
+            this->record_out(rows, blocked_ns);
+
+            return blocked_ns;
+        }
+
+        /**
+         * @brief Times a single call to on_next. Messages must be emitted through `emit` so the time blocked on the
+         * downstream is not counted as processing time. When the message carries a `MessageTrace`, the call is also
+         * recorded as a span of the trace and in the source latency histogram.
+         */
+        class Scope {
+        public:
+            template<typename MessageT>
+            Scope(StageMetrics &metrics, const MessageT &message) :
+                    m_metrics(metrics),
+                    m_start(std::chrono::steady_clock::now()),
+                    m_range(StageMetrics::range_start(metrics.name())),
+                    m_trace(message_trace(message)),
+                    m_enter_ns(m_trace ? MessageTrace::now_ns() : 0) {
+                m_metrics.record_in(message_rows(message));
+            }
+
+            ~Scope();
+
+            Scope(const Scope &) = delete;
+            Scope &operator=(const Scope &) = delete;
+
+            template<typename SubscriberT, typename MessageT>
+            void emit(SubscriberT &output, MessageT &&message) {
+                m_blocked_ns += m_metrics.emit(output, std::forward<MessageT>(message));
+            }
+
+        private:
+            StageMetrics &m_metrics;
+            std::chrono::steady_clock::time_point m_start;
+            uint64_t m_range;
+            uint64_t m_blocked_ns{0};
+            std::shared_ptr<MessageTrace> m_trace;
+            int64_t m_enter_ns;
+        };
+
+        /**
+         * @brief Number of rows in a message, the rows of the MessageMeta or the `mess_count` of a multi message.
+         */
+        template<typename MessageT>
+        static std::size_t message_rows(const std::shared_ptr<MessageT> &message) {
+            if constexpr (std::is_base_of_v<MessageMeta, MessageT>) {
+                return message->count();
+            } else {
+                return message->mess_count;
+            }
+        }
+
+        /**
+         * @brief The trace of the MessageMeta, or of the `meta` of a multi message. nullptr when not sampled.
+         */
+        template<typename MessageT>
+        static std::shared_ptr<MessageTrace> message_trace(const std::shared_ptr<MessageT> &message) {
+            if constexpr (std::is_base_of_v<MessageMeta, MessageT>) {
+                return message->trace();
+            } else {
+                return message->meta->trace();
+            }
+        }
+
+        static uint64_t elapsed_ns(std::chrono::steady_clock::time_point start);
+
+    private:
+        // NVTX process ranges rather than push/pop, since fibers can yield and resume on the same thread mid call
+        static uint64_t range_start(const std::string &name);
+        static void range_end(uint64_t range);
+
+        std::string m_name;
+
+        std::atomic<uint64_t> m_messages_in{0};
+        std::atomic<uint64_t> m_rows_in{0};
+        std::atomic<uint64_t> m_messages_out{0};
+        std::atomic<uint64_t> m_rows_out{0};
+        std::atomic<uint64_t> m_processing_ns{0};
+        std::atomic<uint64_t> m_blocked_ns{0};
+        std::array<std::atomic<uint64_t>, LatencyBucketsUs.size() + 1> m_latency_buckets{};
+        std::atomic<uint64_t> m_source_latency_ns{0};
+        std::array<std::atomic<uint64_t>, SourceLatencyBucketsMs.size() + 1> m_source_latency_buckets{};
+    };
+}  // namespace morpheus
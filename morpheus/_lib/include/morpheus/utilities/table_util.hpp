@@ -15,9 +15,13 @@
  * limitations under the License.
  */
 
+#include <morpheus/utilities/type_util_detail.hpp>
+
 #include <neo/channel/channel.hpp>
 #include <pyneo/utils.hpp>
+#include <cudf/column/column.hpp>
 #include <cudf/table/table.hpp>
+#include <cudf/io/json.hpp>
 #include <cudf/io/types.hpp>
 
 #include <pybind11/cast.h>
@@ -26,6 +30,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <string>
 #include <vector>
 
 #pragma once
@@ -36,10 +41,43 @@ namespace morpheus {
     /**
      * @brief Structure that encapsulates cuDF table utilities.
      */
+#pragma GCC visibility push(default)
     struct CuDFTableUtil {
         /**
          * TODO(Documentation)
          */
         static cudf::io::table_with_metadata load_table(const std::string &filename);
+
+        /**
+         * @brief Reads newline delimited json. The cuDF JSON reader leaves escape sequences in string values so the
+         * `data` column, if present, is unescaped on the device. Shared by all sources which read json.
+         */
+        static cudf::io::table_with_metadata load_json_table(cudf::io::json_reader_options &&json_options);
+
+        /**
+         * @brief Number of leading columns of a freshly read table to use as the index. The first column is used if it
+         * holds INT64 data and is named like an index ('Unnamed: 0' or containing 'id'), in which case 'Unnamed: 0' is
+         * renamed to an empty string. Returns 0 when a range index should be created instead.
+         */
+        static int get_index_col_count(cudf::io::table_with_metadata &data_table);
+
+        /**
+         * @brief Creates a numeric column with every row set to zero. Used when appending output columns to a table.
+         */
+        static std::unique_ptr<cudf::column> make_zeroed_column(TypeId type_id, cudf::size_type num_rows);
+
+        /**
+         * @brief Removes the rows of `data_table` where the column named `column_name` is null. The table is left as it
+         * is when the column has no nulls. Throws if there is no such column.
+         */
+        static void drop_nulls(cudf::io::table_with_metadata &data_table, const std::string &column_name);
+
+        /**
+         * @brief Device bytes held by `column` and its children. Sliced columns count the whole of their children.
+         */
+        static std::size_t device_bytes(const cudf::column_view &column);
+
+        static std::size_t device_bytes(const cudf::table_view &table);
     };
+#pragma GCC visibility pop
 }
\ No newline at end of file
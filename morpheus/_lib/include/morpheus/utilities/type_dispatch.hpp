@@ -0,0 +1,142 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** TypeList****************************************/
+/**
+ * @brief Compile-time list of element types. Primitives dispatch over the list of types they support, so their
+ * kernels are only instantiated for those types, and adding a dtype to a primitive is a change to its list.
+ */
+template <typename... Ts>
+struct TypeList
+{
+    static constexpr std::size_t size = sizeof...(Ts);
+};
+
+/**
+ * @brief Type tag passed to the functions given to `dispatch_type`
+ */
+template <typename T>
+struct TypeTag
+{
+    using type = T;
+};
+
+template <typename... ListsT>
+struct TypeListConcat;
+
+template <typename... Ts>
+struct TypeListConcat<TypeList<Ts...>>
+{
+    using type = TypeList<Ts...>;
+};
+
+template <typename... As, typename... Bs, typename... RestT>
+struct TypeListConcat<TypeList<As...>, TypeList<Bs...>, RestT...> : TypeListConcat<TypeList<As..., Bs...>, RestT...>
+{};
+
+/**
+ * @brief Concatenation of the given `TypeList`s
+ */
+template <typename... ListsT>
+using type_list_concat_t = typename TypeListConcat<ListsT...>::type;
+
+template <typename ListT, typename T>
+struct TypeListContains;
+
+/**
+ * @brief True if `T` is one of the types of `ListT`
+ */
+template <typename... Ts, typename T>
+struct TypeListContains<TypeList<Ts...>, T> : std::bool_constant<(std::is_same_v<Ts, T> || ...)>
+{};
+
+template <typename ListT, typename T>
+constexpr bool type_list_contains_v = TypeListContains<ListT, T>::value;
+
+using SignedIntegralTypes   = TypeList<int8_t, int16_t, int32_t, int64_t>;
+using UnsignedIntegralTypes = TypeList<uint8_t, uint16_t, uint32_t, uint64_t>;
+using IntegralTypes         = type_list_concat_t<SignedIntegralTypes, UnsignedIntegralTypes>;
+using FloatingPointTypes    = TypeList<float, double>;
+using NumericTypes          = type_list_concat_t<IntegralTypes, FloatingPointTypes>;
+
+// Every type with a cudf representation. The half types are added by the CUDA translation units which support them
+using CudfTypes = type_list_concat_t<NumericTypes, TypeList<bool>>;
+
+/**
+ * @brief True if `type_id` is the `TypeId` of one of the types of `ListT`
+ */
+template <typename... Ts>
+constexpr bool type_list_contains_id(TypeList<Ts...>, TypeId type_id)
+{
+    return ((type_id == TypeIdOf<Ts>::value) || ...);
+}
+
+/****** Component private implementations ******************/
+template <typename... Ts, typename FuncT>
+bool TypeDispatch__dispatch(TypeList<Ts...>, TypeId type_id, FuncT& func)
+{
+    static_assert(((TypeIdOf<Ts>::value != TypeId::EMPTY) && ...), "Every dispatched type must have a TypeId");
+
+    // Stops at the first match, which the compiler can lower to a jump table
+    return ((type_id == TypeIdOf<Ts>::value ? (func(TypeTag<Ts>{}), true) : false) || ...);
+}
+
+/****** Component public implementations *******************/
+/**
+ * @brief Calls `func` with a `TypeTag` for the type of `ListT` matching `type_id`. Throws `std::invalid_argument`
+ * with `message` for any other type. Unlike `cudf::type_dispatcher`, `func` is only instantiated for the types of
+ * `ListT`, so unsupported types need no overloads.
+ */
+template <typename ListT, typename FuncT>
+void dispatch_type(TypeId type_id, FuncT&& func, const char* message = "Unsupported tensor type")
+{
+    if (!TypeDispatch__dispatch(ListT{}, type_id, func))
+    {
+        throw std::invalid_argument(message);
+    }
+}
+
+/**
+ * @brief Calls `func` with a pair of `TypeTag`s, for each combination of `InputListT` and `OutputListT`
+ */
+template <typename InputListT, typename OutputListT, typename FuncT>
+void dispatch_type_pair(TypeId input_type,
+                        TypeId output_type,
+                        FuncT&& func,
+                        const char* message = "Unsupported tensor type")
+{
+    dispatch_type<InputListT>(
+        input_type,
+        [&](auto input_tag) {
+            dispatch_type<OutputListT>(
+                output_type, [&](auto output_tag) { func(input_tag, output_tag); }, message);
+        },
+        message);
+}
+}  // namespace morpheus
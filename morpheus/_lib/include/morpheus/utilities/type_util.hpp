@@ -37,6 +37,9 @@ struct DType : DataType  // NOLINT
     // Cudf representation
     cudf::type_id cudf_type_id() const;
 
+    // Type of the DataFrame column holding these values. Half types have no cudf type and are widened to FLOAT32
+    DType column_dtype() const;
+
     // Returns the triton string representation
     std::string triton_str() const;
 
@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <string>
 #include <tuple>
+#include <type_traits>
 
 #ifndef NDEBUG
 #include <cxxabi.h>
@@ -70,10 +71,81 @@ enum class TypeId : int32_t
     //   DECIMAL64,               ///< Fixed-point type with int64_t
     //   STRUCT,                  ///< Struct elements
 
+    // Not part of cudf, tensors only. Widened to FLOAT32 when written to a DataFrame
+    FLOAT16,   ///< 2 byte floating point
+    BFLOAT16,  ///< 2 byte brain floating point
+
     // `NUM_TYPE_IDS` must be last!
     NUM_TYPE_IDS  ///< Total number of type ids
 };
 
+/**
+ * @brief `TypeId` of the builtin type `T`, or `TypeId::EMPTY` when `T` has none. Matches on size and signedness, so
+ * every spelling of an integer type (`long`, `long long`, ...) maps to the same id
+ */
+template <typename T>
+constexpr TypeId TypeIdOf__builtin()
+{
+    // bool is an unsigned 8 bit integral type, it must be matched first
+    if constexpr (std::is_same_v<T, bool>)
+    {
+        return TypeId::BOOL8;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && size_in_bits<T>() == 8)
+    {
+        return TypeId::INT8;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && size_in_bits<T>() == 16)
+    {
+        return TypeId::INT16;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && size_in_bits<T>() == 32)
+    {
+        return TypeId::INT32;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && size_in_bits<T>() == 64)
+    {
+        return TypeId::INT64;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && size_in_bits<T>() == 8)
+    {
+        return TypeId::UINT8;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && size_in_bits<T>() == 16)
+    {
+        return TypeId::UINT16;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && size_in_bits<T>() == 32)
+    {
+        return TypeId::UINT32;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && size_in_bits<T>() == 64)
+    {
+        return TypeId::UINT64;
+    }
+    else if constexpr (std::is_floating_point_v<T> && size_in_bits<T>() == 32)
+    {
+        return TypeId::FLOAT32;
+    }
+    else if constexpr (std::is_floating_point_v<T> && size_in_bits<T>() == 64)
+    {
+        return TypeId::FLOAT64;
+    }
+    else
+    {
+        return TypeId::EMPTY;
+    }
+}
+
+/**
+ * @brief Compile-time `TypeId` of `T`. Specialize for element types which are not builtin, such as the half types
+ */
+template <typename T>
+struct TypeIdOf
+{
+    static constexpr TypeId value = TypeIdOf__builtin<T>();
+};
+
 struct DataType
 {
     DataType(TypeId tid);
@@ -98,57 +170,9 @@ struct DataType
     template <typename T>
     static DataType create()
     {
-        if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && size_in_bits<T>() == 8)
-        {
-            return DataType(TypeId::INT8);
-        }
-        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && size_in_bits<T>() == 16)
-        {
-            return DataType(TypeId::INT16);
-        }
-        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && size_in_bits<T>() == 32)
-        {
-            return DataType(TypeId::INT32);
-        }
-        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && size_in_bits<T>() == 64)
-        {
-            return DataType(TypeId::INT64);
-        }
-        else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && size_in_bits<T>() == 8)
-        {
-            return DataType(TypeId::UINT8);
-        }
-        else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && size_in_bits<T>() == 16)
-        {
-            return DataType(TypeId::UINT16);
-        }
-        else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && size_in_bits<T>() == 32)
-        {
-            return DataType(TypeId::UINT32);
-        }
-        else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && size_in_bits<T>() == 64)
-        {
-            return DataType(TypeId::UINT64);
-        }
-        else if constexpr (std::is_floating_point_v<T> && size_in_bits<T>() == 32)
-        {
-            return DataType(TypeId::FLOAT32);
-        }
-        else if constexpr (std::is_floating_point_v<T> && size_in_bits<T>() == 64)
-        {
-            return DataType(TypeId::FLOAT64);
-        }
-        else if constexpr (std::is_same_v<T, bool>)
-        {
-            return DataType(TypeId::BOOL8);
-        }
-        else
-        {
-            static_assert(!sizeof(T), "Type not implemented");
-        }
-
-        // To hide compiler warnings
-        return DataType(TypeId::EMPTY);
+        static_assert(TypeIdOf<T>::value != TypeId::EMPTY, "Type not implemented");
+
+        return DataType(TypeIdOf<T>::value);
     }
 
     // From numpy
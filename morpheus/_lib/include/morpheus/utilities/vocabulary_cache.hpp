@@ -0,0 +1,52 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <nvtext/subword_tokenize.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus {
+    /****** Component public implementations *******************/
+    /****** VocabularyCache*************************************/
+    /**
+     * @brief Process wide cache of hashed vocabularies used by the subword tokenizer, keyed by the hash file path.
+     * Each file is loaded onto the device once and shared read-only between all threads and stages using it. A
+     * vocabulary is freed once the last reference to it is released.
+     */
+#pragma GCC visibility push(default)
+    struct VocabularyCache {
+        /**
+         * @brief Returns the vocabulary for `vocab_hash_file`, loading it if no other stage currently holds it.
+         */
+        static std::shared_ptr<const nvtext::hashed_vocabulary> get(const std::string &vocab_hash_file);
+
+        /**
+         * @brief Device memory used by a single vocabulary, in bytes.
+         */
+        static std::size_t device_bytes(const nvtext::hashed_vocabulary &vocab);
+
+        /**
+         * @brief Device memory used by all vocabularies currently loaded, in bytes.
+         */
+        static std::size_t total_device_bytes();
+    };
+#pragma GCC visibility pop
+}  // namespace morpheus
@@ -0,0 +1,253 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/io/async_file_writer.hpp>
+
+#include <boost/fiber/channel_op_status.hpp>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>   // for open
+#include <unistd.h>  // for write, fdatasync, close
+
+namespace morpheus {
+// Component-private free functions.
+// ************ AsyncFileWriter__ ************ //
+static std::size_t AsyncFileWriter__channel_capacity(std::size_t queue_size)
+{
+    // Buffered channels require a power of two and hold one less than their capacity
+    std::size_t capacity = 2;
+
+    while (capacity < queue_size + 1)
+    {
+        capacity <<= 1;
+    }
+
+    return capacity;
+}
+
+static std::runtime_error AsyncFileWriter__errno_error(const std::string &action, const std::string &filename)
+{
+    return std::runtime_error("Failed to " + action + " '" + filename + "': " + std::strerror(errno));
+}
+
+// Component public implementations
+// ************ FileFlushPolicy **************************** //
+FileFlushPolicy parse_file_flush_policy(const std::string &policy)
+{
+    if (policy == "none")
+    {
+        return FileFlushPolicy::None;
+    }
+    if (policy == "flush")
+    {
+        return FileFlushPolicy::Flush;
+    }
+    if (policy == "fsync")
+    {
+        return FileFlushPolicy::FSync;
+    }
+
+    throw std::invalid_argument("Unknown flush policy '" + policy + "'. Must be one of 'none', 'flush' or 'fsync'");
+}
+
+// ************ AsyncFileWriter **************************** //
+AsyncFileWriter::AsyncFileWriter(const std::string &filename,
+                                 bool append,
+                                 std::size_t queue_size,
+                                 FileFlushPolicy policy,
+                                 std::size_t block_bytes) :
+  m_filename(filename),
+  m_policy(policy),
+  m_block_bytes((std::max(block_bytes, Alignment) + Alignment - 1) / Alignment * Alignment),
+  m_block(static_cast<char *>(std::aligned_alloc(Alignment, m_block_bytes)), &std::free),
+  m_queue(AsyncFileWriter__channel_capacity(queue_size))
+{
+    if (!m_block)
+    {
+        throw std::bad_alloc();
+    }
+
+    m_fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? O_APPEND : O_TRUNC), 0644);
+
+    if (m_fd < 0)
+    {
+        throw AsyncFileWriter__errno_error("open", filename);
+    }
+
+    m_thread = std::thread(&AsyncFileWriter::run, this);
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    try
+    {
+        this->close();
+    } catch (const std::exception &e)
+    {
+        LOG(ERROR) << "Error closing '" << m_filename << "': " << e.what();
+    }
+}
+
+void AsyncFileWriter::write(std::string data)
+{
+    if (m_queue.push(std::move(data)) != boost::fibers::channel_op_status::success)
+    {
+        // The writer thread closes the queue when it fails
+        this->rethrow_error();
+
+        throw std::runtime_error("Cannot write to '" + m_filename + "' after it was closed");
+    }
+}
+
+void AsyncFileWriter::close()
+{
+    m_queue.close();
+
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+
+    this->rethrow_error();
+}
+
+void AsyncFileWriter::run()
+{
+    try
+    {
+        std::string data;
+
+        while (true)
+        {
+            auto status = m_queue.try_pop(data);
+
+            if (status == boost::fibers::channel_op_status::empty)
+            {
+                // Caught up with the producer, hand over the partial block before waiting for more
+                if (m_policy != FileFlushPolicy::None)
+                {
+                    this->write_block();
+                }
+
+                if (m_policy == FileFlushPolicy::FSync && ::fdatasync(m_fd) != 0)
+                {
+                    throw AsyncFileWriter__errno_error("sync", m_filename);
+                }
+
+                status = m_queue.pop(data);
+            }
+
+            if (status != boost::fibers::channel_op_status::success)
+            {
+                // Closed and drained
+                break;
+            }
+
+            this->append(data);
+        }
+
+        this->write_block();
+
+        if (m_policy == FileFlushPolicy::FSync && ::fdatasync(m_fd) != 0)
+        {
+            throw AsyncFileWriter__errno_error("sync", m_filename);
+        }
+    } catch (...)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_error_mutex);
+            m_error = std::current_exception();
+        }
+
+        // Wakes any producer blocked on a full queue
+        m_queue.close();
+    }
+}
+
+void AsyncFileWriter::append(const std::string &data)
+{
+    std::size_t offset = 0;
+
+    while (offset < data.size())
+    {
+        auto count = std::min(data.size() - offset, m_block_bytes - m_block_used);
+
+        std::memcpy(m_block.get() + m_block_used, data.data() + offset, count);
+
+        m_block_used += count;
+        offset += count;
+
+        if (m_block_used == m_block_bytes)
+        {
+            this->write_block();
+        }
+    }
+}
+
+void AsyncFileWriter::write_block()
+{
+    std::size_t offset = 0;
+
+    while (offset < m_block_used)
+    {
+        auto written = ::write(m_fd, m_block.get() + offset, m_block_used - offset);
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw AsyncFileWriter__errno_error("write to", m_filename);
+        }
+
+        offset += static_cast<std::size_t>(written);
+    }
+
+    m_block_used = 0;
+}
+
+void AsyncFileWriter::rethrow_error()
+{
+    std::exception_ptr error;
+
+    {
+        std::lock_guard<std::mutex> lock(m_error_mutex);
+        error = std::exchange(m_error, nullptr);
+    }
+
+    // Reported once, later calls only see the closed queue
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+}  // namespace morpheus
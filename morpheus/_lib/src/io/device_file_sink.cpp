@@ -0,0 +1,238 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/io/device_file_sink.hpp>
+
+#include <morpheus/utilities/host_memory.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+
+#ifdef MORPHEUS_USE_CUFILE
+#include <cufile.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>   // for open
+#include <unistd.h>  // for pwrite, lseek, close
+
+namespace morpheus {
+// Component-private free functions.
+// ************ DeviceFileSink__ ************ //
+static std::runtime_error DeviceFileSink__errno_error(const std::string &action, const std::string &filename)
+{
+    return std::runtime_error("Failed to " + action + " '" + filename + "': " + std::strerror(errno));
+}
+
+#ifdef MORPHEUS_USE_CUFILE
+/**
+ * @brief Opens the cuFile driver once per process. False when GPUDirect Storage is not usable on this host.
+ */
+static bool DeviceFileSink__cufile_driver_open()
+{
+    static const bool is_open = []() {
+        auto status = cuFileDriverOpen();
+
+        if (status.err != CU_FILE_SUCCESS)
+        {
+            LOG(WARNING) << "cuFile driver unavailable (error " << status.err
+                         << "), device writes to files use pinned bounce buffers";
+            return false;
+        }
+
+        return true;
+    }();
+
+    return is_open;
+}
+#endif
+
+// Component public implementations
+// ************ DeviceFileSink **************************** //
+DeviceFileSink::DeviceFileSink(const std::string &filename, bool append) : m_filename(filename)
+{
+    // Writes are positioned explicitly, cuFile does not support O_APPEND
+    m_fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC), 0644);
+
+    if (m_fd < 0)
+    {
+        throw DeviceFileSink__errno_error("open", filename);
+    }
+
+    if (append)
+    {
+        auto end = ::lseek(m_fd, 0, SEEK_END);
+
+        if (end < 0)
+        {
+            ::close(m_fd);
+            throw DeviceFileSink__errno_error("seek", filename);
+        }
+
+        m_offset = static_cast<std::size_t>(end);
+    }
+
+#ifdef MORPHEUS_USE_CUFILE
+    if (DeviceFileSink__cufile_driver_open())
+    {
+        CUfileDescr_t descr{};
+        descr.handle.fd = m_fd;
+        descr.type      = CU_FILE_HANDLE_TYPE_OPAQUE_FD;
+
+        CUfileHandle_t handle;
+        auto status = cuFileHandleRegister(&handle, &descr);
+
+        if (status.err == CU_FILE_SUCCESS)
+        {
+            m_cufile_handle = handle;
+        }
+        else
+        {
+            VLOG(10) << "Could not register '" << filename << "' with cuFile (error " << status.err << ")";
+        }
+    }
+#endif
+}
+
+DeviceFileSink::~DeviceFileSink()
+{
+    this->close();
+}
+
+void DeviceFileSink::host_write(void const *data, size_t size)
+{
+    this->write_all(data, size);
+}
+
+void DeviceFileSink::device_write(void const *gpu_data, size_t size, rmm::cuda_stream_view stream)
+{
+    if (size == 0)
+    {
+        return;
+    }
+
+#ifdef MORPHEUS_USE_CUFILE
+    if (m_cufile_handle != nullptr)
+    {
+        // cuFile reads the device memory directly, it must be ready
+        stream.synchronize();
+
+        std::size_t written = 0;
+
+        while (written < size)
+        {
+            auto result = cuFileWrite(static_cast<CUfileHandle_t>(m_cufile_handle),
+                                      gpu_data,
+                                      size - written,
+                                      static_cast<off_t>(m_offset),
+                                      static_cast<off_t>(written));
+
+            if (result < 0)
+            {
+                throw std::runtime_error("Failed to write '" + m_filename + "' with cuFile (error " +
+                                         std::to_string(result) + ")");
+            }
+
+            written += static_cast<std::size_t>(result);
+            m_offset += static_cast<std::size_t>(result);
+        }
+
+        m_bytes_written += size;
+        return;
+    }
+#endif
+
+    const auto *src        = static_cast<const uint8_t *>(gpu_data);
+    const auto num_blocks = (size + BounceBytes - 1) / BounceBytes;
+
+    std::array<PinnedHostBuffer, 2> bounce{PinnedHostPool::acquire(std::min(size, BounceBytes)),
+                                           PinnedHostPool::acquire(num_blocks > 1 ? BounceBytes : 0)};
+
+    auto block_bytes = [&](std::size_t block) { return std::min(BounceBytes, size - block * BounceBytes); };
+
+    NEO_CHECK_CUDA(cudaMemcpyAsync(bounce[0].data(), src, block_bytes(0), cudaMemcpyDeviceToHost, stream));
+
+    for (std::size_t block = 0; block < num_blocks; ++block)
+    {
+        NEO_CHECK_CUDA(cudaStreamSynchronize(stream));
+
+        if (block + 1 < num_blocks)
+        {
+            // Copies the next block while this one is written
+            NEO_CHECK_CUDA(cudaMemcpyAsync(bounce[(block + 1) % 2].data(),
+                                           src + (block + 1) * BounceBytes,
+                                           block_bytes(block + 1),
+                                           cudaMemcpyDeviceToHost,
+                                           stream));
+        }
+
+        this->write_all(bounce[block % 2].data(), block_bytes(block));
+    }
+}
+
+void DeviceFileSink::close()
+{
+#ifdef MORPHEUS_USE_CUFILE
+    if (m_cufile_handle != nullptr)
+    {
+        cuFileHandleDeregister(static_cast<CUfileHandle_t>(m_cufile_handle));
+        m_cufile_handle = nullptr;
+    }
+#endif
+
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+void DeviceFileSink::write_all(const void *data, std::size_t size)
+{
+    const auto *it = static_cast<const char *>(data);
+
+    while (size > 0)
+    {
+        auto result = ::pwrite(m_fd, it, size, static_cast<off_t>(m_offset));
+
+        if (result < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            throw DeviceFileSink__errno_error("write", m_filename);
+        }
+
+        it += result;
+        size -= static_cast<std::size_t>(result);
+        m_offset += static_cast<std::size_t>(result);
+        m_bytes_written += static_cast<std::size_t>(result);
+    }
+}
+}  // namespace morpheus
@@ -0,0 +1,406 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/io/gpu_compressed_sink.hpp>
+
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/host_memory.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cuda_runtime.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+#include <thrust/iterator/transform_iterator.h>
+#include <thrust/scan.h>
+
+#ifdef MORPHEUS_USE_NVCOMP
+#include <nvcomp/deflate.h>
+#include <nvcomp/zstd.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace morpheus {
+// Component-private free functions.
+// ************ GpuCompressedSink__kernels ************ //
+// Fixed size of the gzip member header written before, and the trailer written after, every deflate stream
+constexpr std::size_t GpuCompressedSink__GzipHeaderBytes  = 10;
+constexpr std::size_t GpuCompressedSink__GzipTrailerBytes = 8;
+
+/**
+ * @brief One thread per chunk. Fills in the pointer and size arrays nvCOMP's batched API takes
+ */
+__global__ void GpuCompressedSink__chunk_kernel(const uint8_t *data,
+                                                std::size_t bytes,
+                                                std::size_t num_chunks,
+                                                uint8_t *compressed,
+                                                std::size_t max_compressed_bytes,
+                                                const void **uncompressed_ptrs,
+                                                std::size_t *uncompressed_bytes,
+                                                void **compressed_ptrs)
+{
+    std::size_t chunk = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+    if (chunk >= num_chunks)
+    {
+        return;
+    }
+
+    std::size_t start = chunk * GpuCompressedSink::ChunkBytes;
+
+    uncompressed_ptrs[chunk]  = data + start;
+    uncompressed_bytes[chunk] = min(GpuCompressedSink::ChunkBytes, bytes - start);
+    compressed_ptrs[chunk]    = compressed + chunk * max_compressed_bytes;
+}
+
+/**
+ * @brief One thread per chunk, a table driven CRC-32 of the uncompressed bytes as the gzip trailer requires. Chunks
+ * are small enough for the serial loop to take no longer than compressing them
+ */
+__global__ void GpuCompressedSink__crc32_kernel(const void *const *uncompressed_ptrs,
+                                                const std::size_t *uncompressed_bytes,
+                                                std::size_t num_chunks,
+                                                uint32_t *crcs)
+{
+    __shared__ uint32_t table[256];
+
+    for (uint32_t i = threadIdx.x; i < 256; i += blockDim.x)
+    {
+        uint32_t c = i;
+
+        for (int k = 0; k < 8; ++k)
+        {
+            c = (c & 1) != 0 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+
+        table[i] = c;
+    }
+
+    __syncthreads();
+
+    std::size_t chunk = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+    if (chunk >= num_chunks)
+    {
+        return;
+    }
+
+    const auto *data = static_cast<const uint8_t *>(uncompressed_ptrs[chunk]);
+    uint32_t crc     = 0xFFFFFFFFu;
+
+    for (std::size_t i = 0; i < uncompressed_bytes[chunk]; ++i)
+    {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+
+    crcs[chunk] = crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Size of a chunk once written to the output, the compressed bytes plus the framing around them
+ */
+struct GpuCompressedSink__MemberBytes
+{
+    std::size_t framing_bytes;
+
+    __device__ std::size_t operator()(std::size_t compressed_bytes) const
+    {
+        return compressed_bytes + framing_bytes;
+    }
+};
+
+/**
+ * @brief One block per chunk. Copies the compressed chunk to its place in the output, surrounded by the gzip header
+ * and trailer when `crcs` is set
+ */
+__global__ void GpuCompressedSink__pack_kernel(const void *const *compressed_ptrs,
+                                               const std::size_t *compressed_bytes,
+                                               const std::size_t *uncompressed_bytes,
+                                               const uint32_t *crcs,
+                                               const std::size_t *offsets,
+                                               uint8_t *output)
+{
+    const auto chunk = blockIdx.x;
+    const auto *src  = static_cast<const uint8_t *>(compressed_ptrs[chunk]);
+    const auto bytes = compressed_bytes[chunk];
+    auto *dst        = output + offsets[chunk];
+
+    if (crcs != nullptr)
+    {
+        if (threadIdx.x == 0)
+        {
+            // Magic, deflate, no flags, no modification time, no extra flags and an unknown OS
+            const uint8_t header[GpuCompressedSink__GzipHeaderBytes] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+
+            for (std::size_t i = 0; i < GpuCompressedSink__GzipHeaderBytes; ++i)
+            {
+                dst[i] = header[i];
+            }
+
+            // CRC-32 and size of the uncompressed data, both little endian
+            auto *trailer = dst + GpuCompressedSink__GzipHeaderBytes + bytes;
+            auto crc      = crcs[chunk];
+            auto size     = static_cast<uint32_t>(uncompressed_bytes[chunk]);
+
+            for (int i = 0; i < 4; ++i)
+            {
+                trailer[i]     = static_cast<uint8_t>(crc >> (8 * i));
+                trailer[4 + i] = static_cast<uint8_t>(size >> (8 * i));
+            }
+        }
+
+        dst += GpuCompressedSink__GzipHeaderBytes;
+    }
+
+    for (std::size_t i = threadIdx.x; i < bytes; i += blockDim.x)
+    {
+        dst[i] = src[i];
+    }
+}
+
+#ifdef MORPHEUS_USE_NVCOMP
+void GpuCompressedSink__check(nvcompStatus_t status, const char *operation)
+{
+    if (status != nvcompSuccess)
+    {
+        throw std::runtime_error(std::string(operation) + " failed with nvCOMP status " +
+                                 std::to_string(static_cast<int>(status)));
+    }
+}
+#endif
+
+// Component public implementations
+// ************ GpuCompressionCodec ************************ //
+GpuCompressionCodec parse_gpu_compression_codec(const std::string &codec)
+{
+    if (codec == "gzip")
+    {
+        return GpuCompressionCodec::Gzip;
+    }
+    if (codec == "zstd")
+    {
+        return GpuCompressionCodec::Zstd;
+    }
+
+    throw std::invalid_argument("Unknown GPU compression codec '" + codec + "'. Must be one of 'gzip' or 'zstd'");
+}
+
+// ************ GpuCompressedSink ************************** //
+GpuCompressedSink::GpuCompressedSink(GpuCompressionCodec codec, rmm::cuda_stream_view stream) :
+  m_codec(codec),
+  m_stream(stream),
+  m_staged(0, stream)
+{
+    if (!Available)
+    {
+        throw std::runtime_error("GPU compression requires Morpheus to be built with MORPHEUS_USE_NVCOMP");
+    }
+}
+
+void GpuCompressedSink::host_write(void const *data, size_t size)
+{
+    auto offset = m_staged.size();
+    m_staged.resize(offset + size, m_stream);
+
+    // Only small writes, like the CSV header, come from the host
+    NEO_CHECK_CUDA(cudaMemcpyAsync(
+        static_cast<uint8_t *>(m_staged.data()) + offset, data, size, cudaMemcpyHostToDevice, m_stream));
+    NEO_CHECK_CUDA(cudaStreamSynchronize(m_stream));
+
+    m_bytes_written += size;
+}
+
+void GpuCompressedSink::device_write(void const *gpu_data, size_t size, rmm::cuda_stream_view stream)
+{
+    auto offset = m_staged.size();
+
+    // Ordered after the writer's own work. Resizing on `stream` keeps the previous contents valid for the copy
+    m_staged.resize(offset + size, stream);
+
+    NEO_CHECK_CUDA(cudaMemcpyAsync(
+        static_cast<uint8_t *>(m_staged.data()) + offset, gpu_data, size, cudaMemcpyDeviceToDevice, stream));
+    NEO_CHECK_CUDA(cudaStreamSynchronize(stream));
+
+    m_bytes_written += size;
+}
+
+void GpuCompressedSink::flush()
+{
+    if (m_staged.size() == 0)
+    {
+        return;
+    }
+
+    this->compress(static_cast<const uint8_t *>(m_staged.data()), m_staged.size());
+
+    // Keeps the allocation for the next message
+    m_staged.resize(0, m_stream);
+}
+
+std::string GpuCompressedSink::release()
+{
+    return std::exchange(m_output, std::string());
+}
+
+void GpuCompressedSink::compress(const uint8_t *data, std::size_t bytes)
+{
+#ifdef MORPHEUS_USE_NVCOMP
+    MORPHEUS_DEVICE_RANGE("GpuCompressedSink::compress", m_stream);
+
+    const bool is_gzip           = m_codec == GpuCompressionCodec::Gzip;
+    const std::size_t num_chunks = (bytes + ChunkBytes - 1) / ChunkBytes;
+
+    std::size_t max_compressed_bytes = 0;
+    std::size_t temp_bytes           = 0;
+
+    if (is_gzip)
+    {
+        GpuCompressedSink__check(nvcompBatchedDeflateCompressGetMaxOutputChunkSize(
+                                     ChunkBytes, nvcompBatchedDeflateDefaultOpts, &max_compressed_bytes),
+                                 "nvcompBatchedDeflateCompressGetMaxOutputChunkSize");
+        GpuCompressedSink__check(nvcompBatchedDeflateCompressGetTempSize(
+                                     num_chunks, ChunkBytes, nvcompBatchedDeflateDefaultOpts, &temp_bytes),
+                                 "nvcompBatchedDeflateCompressGetTempSize");
+    }
+    else
+    {
+        GpuCompressedSink__check(nvcompBatchedZstdCompressGetMaxOutputChunkSize(
+                                     ChunkBytes, nvcompBatchedZstdDefaultOpts, &max_compressed_bytes),
+                                 "nvcompBatchedZstdCompressGetMaxOutputChunkSize");
+        GpuCompressedSink__check(
+            nvcompBatchedZstdCompressGetTempSize(num_chunks, ChunkBytes, nvcompBatchedZstdDefaultOpts, &temp_bytes),
+            "nvcompBatchedZstdCompressGetTempSize");
+    }
+
+    rmm::device_uvector<const void *> uncompressed_ptrs(num_chunks, m_stream);
+    rmm::device_uvector<std::size_t> uncompressed_bytes(num_chunks, m_stream);
+    rmm::device_uvector<void *> compressed_ptrs(num_chunks, m_stream);
+    rmm::device_uvector<std::size_t> compressed_bytes(num_chunks, m_stream);
+
+    rmm::device_buffer compressed(num_chunks * max_compressed_bytes, m_stream);
+    rmm::device_buffer temp(temp_bytes, m_stream);
+
+    const unsigned int threads = 128;
+    const auto blocks          = static_cast<unsigned int>((num_chunks + threads - 1) / threads);
+
+    GpuCompressedSink__chunk_kernel<<<blocks, threads, 0, m_stream.value()>>>(data,
+                                                                              bytes,
+                                                                              num_chunks,
+                                                                              static_cast<uint8_t *>(compressed.data()),
+                                                                              max_compressed_bytes,
+                                                                              uncompressed_ptrs.data(),
+                                                                              uncompressed_bytes.data(),
+                                                                              compressed_ptrs.data());
+    NEO_CHECK_CUDA(cudaGetLastError());
+
+    if (is_gzip)
+    {
+        GpuCompressedSink__check(nvcompBatchedDeflateCompressAsync(uncompressed_ptrs.data(),
+                                                                   uncompressed_bytes.data(),
+                                                                   ChunkBytes,
+                                                                   num_chunks,
+                                                                   temp.data(),
+                                                                   temp_bytes,
+                                                                   compressed_ptrs.data(),
+                                                                   compressed_bytes.data(),
+                                                                   nvcompBatchedDeflateDefaultOpts,
+                                                                   m_stream.value()),
+                                 "nvcompBatchedDeflateCompressAsync");
+    }
+    else
+    {
+        GpuCompressedSink__check(nvcompBatchedZstdCompressAsync(uncompressed_ptrs.data(),
+                                                                uncompressed_bytes.data(),
+                                                                ChunkBytes,
+                                                                num_chunks,
+                                                                temp.data(),
+                                                                temp_bytes,
+                                                                compressed_ptrs.data(),
+                                                                compressed_bytes.data(),
+                                                                nvcompBatchedZstdDefaultOpts,
+                                                                m_stream.value()),
+                                 "nvcompBatchedZstdCompressAsync");
+    }
+
+    // nvCOMP only writes raw deflate streams, each one becomes a gzip member. Zstd frames are written as is
+    rmm::device_uvector<uint32_t> crcs(is_gzip ? num_chunks : 0, m_stream);
+
+    if (is_gzip)
+    {
+        GpuCompressedSink__crc32_kernel<<<blocks, threads, 0, m_stream.value()>>>(
+            uncompressed_ptrs.data(), uncompressed_bytes.data(), num_chunks, crcs.data());
+        NEO_CHECK_CUDA(cudaGetLastError());
+    }
+
+    const auto framing_bytes =
+        is_gzip ? GpuCompressedSink__GzipHeaderBytes + GpuCompressedSink__GzipTrailerBytes : std::size_t{0};
+
+    auto member_bytes = thrust::make_transform_iterator(compressed_bytes.begin(),
+                                                        GpuCompressedSink__MemberBytes{framing_bytes});
+
+    rmm::device_uvector<std::size_t> offsets(num_chunks, m_stream);
+    thrust::exclusive_scan(
+        rmm::exec_policy(m_stream), member_bytes, member_bytes + num_chunks, offsets.begin(), std::size_t{0});
+
+    // The output ends with the last member
+    std::size_t last_member[2];
+    NEO_CHECK_CUDA(cudaMemcpyAsync(&last_member[0],
+                                   offsets.data() + num_chunks - 1,
+                                   sizeof(std::size_t),
+                                   cudaMemcpyDeviceToHost,
+                                   m_stream));
+    NEO_CHECK_CUDA(cudaMemcpyAsync(&last_member[1],
+                                   compressed_bytes.data() + num_chunks - 1,
+                                   sizeof(std::size_t),
+                                   cudaMemcpyDeviceToHost,
+                                   m_stream));
+    NEO_CHECK_CUDA(cudaStreamSynchronize(m_stream));
+
+    const auto output_bytes = last_member[0] + last_member[1] + framing_bytes;
+
+    rmm::device_buffer packed(output_bytes, m_stream);
+
+    GpuCompressedSink__pack_kernel<<<static_cast<unsigned int>(num_chunks), 256, 0, m_stream.value()>>>(
+        compressed_ptrs.data(),
+        compressed_bytes.data(),
+        uncompressed_bytes.data(),
+        is_gzip ? crcs.data() : nullptr,
+        offsets.data(),
+        static_cast<uint8_t *>(packed.data()));
+    NEO_CHECK_CUDA(cudaGetLastError());
+
+    // Only the compressed bytes cross the bus
+    auto host_buffer = PinnedHostPool::acquire(output_bytes);
+
+    NEO_CHECK_CUDA(
+        cudaMemcpyAsync(host_buffer.data(), packed.data(), output_bytes, cudaMemcpyDeviceToHost, m_stream));
+    NEO_CHECK_CUDA(cudaStreamSynchronize(m_stream));
+
+    m_output.append(reinterpret_cast<const char *>(host_buffer.data()), output_bytes);
+#else
+    throw std::runtime_error("GPU compression requires Morpheus to be built with MORPHEUS_USE_NVCOMP");
+#endif
+}
+}  // namespace morpheus
@@ -0,0 +1,103 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/io/mapped_file.hpp>
+
+#include <glog/logging.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap, madvise, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+
+namespace morpheus {
+// Component-private free functions.
+// ************ MappedFile__ ************ //
+static std::runtime_error MappedFile__errno_error(const std::string &action, const std::string &filename)
+{
+    return std::runtime_error("Failed to " + action + " '" + filename + "': " + std::strerror(errno));
+}
+
+// Component public implementations
+// ************ MappedFile **************************** //
+MappedFile::MappedFile(const std::string &filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+    {
+        throw MappedFile__errno_error("open", filename);
+    }
+
+    struct stat file_stat
+    {};
+
+    if (::fstat(fd, &file_stat) != 0)
+    {
+        auto error = MappedFile__errno_error("stat", filename);
+        ::close(fd);
+        throw error;
+    }
+
+    m_size = static_cast<std::size_t>(file_stat.st_size);
+
+    if (m_size > 0)
+    {
+        void *data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (data == MAP_FAILED)
+        {
+            auto error = MappedFile__errno_error("map", filename);
+            ::close(fd);
+            throw error;
+        }
+
+        m_data = data;
+
+        // Only a hint, the mapping works the same without it
+        if (::madvise(m_data, m_size, MADV_SEQUENTIAL) != 0)
+        {
+            LOG(WARNING) << "madvise failed for '" << filename << "': " << std::strerror(errno);
+        }
+    }
+
+    // The mapping keeps the file referenced
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(m_data, m_size);
+    }
+}
+
+const char *MappedFile::data() const
+{
+    return static_cast<const char *>(m_data);
+}
+
+std::size_t MappedFile::size() const
+{
+    return m_size;
+}
+}  // namespace morpheus
@@ -17,15 +17,44 @@
 
 #include <morpheus/io/serializers.hpp>
 
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/host_memory.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
 #include <pybind11/gil.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
+#include <cuda_runtime.h>
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/copying.hpp>
 #include <cudf/io/csv.hpp>
 #include <cudf/io/data_sink.hpp>
+#include <cudf/replace.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/strings/combine.hpp>
+#include <cudf/strings/convert/convert_booleans.hpp>
+#include <cudf/strings/convert/convert_integers.hpp>
+#include <cudf/strings/replace.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/unary.hpp>
+#include <cudf/utilities/traits.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
 #include <rmm/mr/device/per_device_resource.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <limits>
+#include <memory>
 #include <ostream>
-#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace morpheus {
 
@@ -75,19 +104,483 @@ class OStreamSink : public cudf::io::data_sink
     size_t m_bytest_written{0};
 };
 
+/**
+ * @brief Appends everything written to a string, saving the extra copy `std::ostringstream::str` makes.
+ */
+class StringSink : public cudf::io::data_sink
+{
+  public:
+    StringSink(std::string& output) : m_output(output) {}
+
+    void host_write(void const* data, size_t size) override
+    {
+        m_output.append(static_cast<char const*>(data), size);
+    }
+
+    void flush() override {}
+
+    size_t bytes_written() override
+    {
+        return m_output.size();
+    }
+
+  private:
+    std::string& m_output;
+};
+
+// Component-private free functions.
+// ************ Serializers__json ************ //
+// Rows formatted at a time by the JSON lines writer, bounds the size of the intermediate strings columns
+constexpr cudf::size_type JsonChunkRows = 1 << 16;
+
+/**
+ * @brief Escapes `value` for use inside a JSON string. Escapes the same characters as pandas, including the forward
+ * slash, except that non ASCII characters are written as UTF-8 rather than as `\u` escapes.
+ */
+std::string Serializers__escape_json(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+
+    for (char c : value)
+    {
+        switch (c)
+        {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '/':
+            escaped += "\\/";
+            break;
+        case '\b':
+            escaped += "\\b";
+            break;
+        case '\f':
+            escaped += "\\f";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        case '\r':
+            escaped += "\\r";
+            break;
+        case '\t':
+            escaped += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char code[7];
+                std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(c));
+                escaped += code;
+            }
+            else
+            {
+                escaped += c;
+            }
+        }
+    }
+
+    return escaped;
+}
+
+/**
+ * @brief Copies a strings column built on the host to the device. `offsets` holds one more entry than there are
+ * strings, the first being 0.
+ */
+std::unique_ptr<cudf::column> Serializers__upload_strings_column(const std::vector<cudf::size_type>& offsets,
+                                                                 const std::string& chars)
+{
+    auto offsets_column = cudf::make_numeric_column(cudf::data_type{cudf::type_id::INT32}, offsets.size());
+    auto chars_column   = cudf::make_numeric_column(cudf::data_type{cudf::type_id::INT8}, chars.size());
+
+    NEO_CHECK_CUDA(cudaMemcpyAsync(offsets_column->mutable_view().head(),
+                                   offsets.data(),
+                                   offsets.size() * sizeof(cudf::size_type),
+                                   cudaMemcpyHostToDevice,
+                                   rmm::cuda_stream_per_thread));
+
+    NEO_CHECK_CUDA(cudaMemcpyAsync(chars_column->mutable_view().head(),
+                                   chars.data(),
+                                   chars.size(),
+                                   cudaMemcpyHostToDevice,
+                                   rmm::cuda_stream_per_thread));
+
+    // The host vectors go out of scope on return
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    return cudf::make_strings_column(static_cast<cudf::size_type>(offsets.size() - 1),
+                                     std::move(offsets_column),
+                                     std::move(chars_column),
+                                     0,
+                                     rmm::device_buffer{});
+}
+
+std::unique_ptr<cudf::column> Serializers__make_strings_column(const std::vector<std::string>& values)
+{
+    std::vector<cudf::size_type> offsets{0};
+    std::string chars;
+
+    for (const auto& value : values)
+    {
+        chars += value;
+        offsets.push_back(static_cast<cudf::size_type>(chars.size()));
+    }
+
+    return Serializers__upload_strings_column(offsets, chars);
+}
+
+/**
+ * @brief Appends `value` formatted the way pandas' `to_json` does with its default `double_precision` of 10: at most
+ * 10 decimals, rounded like ujson and without trailing zeros but always at least one, and `%.10g` outside the range
+ * ujson formats itself. Non finite values are written as null.
+ */
+void Serializers__append_json_double(double value, std::string& output)
+{
+    constexpr int Precision   = 10;
+    constexpr double Pow10    = 1e10;
+    constexpr double MaxFixed = 1e16 - 1;
+    constexpr double MinFixed = 1e-15;
+
+    if (!std::isfinite(value))
+    {
+        output += "null";
+        return;
+    }
+
+    const bool negative    = value < 0;
+    const double magnitude = negative ? -value : value;
+
+    if (magnitude > MaxFixed || (magnitude != 0.0 && magnitude < MinFixed))
+    {
+        char buffer[32];
+        const auto length = std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+        output.append(buffer, length);
+        return;
+    }
+
+    // Same operations as ujson, so the rounding errors are the same too
+    auto whole        = static_cast<unsigned long long>(magnitude);
+    const double tmp  = (magnitude - static_cast<double>(whole)) * Pow10;
+    auto frac         = static_cast<unsigned long long>(tmp);
+    const double diff = tmp - static_cast<double>(frac);
+
+    if (diff > 0.5 || (diff == 0.5 && (frac == 0 || (frac & 1) != 0)))
+    {
+        ++frac;
+    }
+
+    if (static_cast<double>(frac) >= Pow10)
+    {
+        frac = 0;
+        ++whole;
+    }
+
+    if (negative)
+    {
+        output += '-';
+    }
+
+    output += std::to_string(whole);
+    output += '.';
+
+    if (frac == 0)
+    {
+        output += '0';
+        return;
+    }
+
+    const auto digits = std::to_string(frac);
+
+    // The leading zeros of the decimals are not part of `frac`, its trailing ones are dropped
+    output.append(Precision - digits.size(), '0');
+    output.append(digits, 0, digits.find_last_not_of('0') + 1);
+}
+
+/**
+ * @brief Formats a floating point column like pandas. `cudf::strings::from_floats` writes a different number of
+ * digits, so the values are copied to the host and formatted there. float32 values are widened first, as pandas does.
+ */
+std::unique_ptr<cudf::column> Serializers__format_json_floats(const cudf::column_view& column)
+{
+    auto widened = cudf::cast(column, cudf::data_type{cudf::type_id::FLOAT64});
+
+    // Written as null, same as NaN
+    if (widened->has_nulls())
+    {
+        widened = cudf::replace_nulls(widened->view(),
+                                      cudf::numeric_scalar<double>(std::numeric_limits<double>::quiet_NaN()));
+    }
+
+    std::vector<double> values(column.size());
+
+    NEO_CHECK_CUDA(cudaMemcpyAsync(values.data(),
+                                   widened->view().data<double>(),
+                                   values.size() * sizeof(double),
+                                   cudaMemcpyDeviceToHost,
+                                   rmm::cuda_stream_per_thread));
+
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    std::vector<cudf::size_type> offsets{0};
+    std::string chars;
+
+    offsets.reserve(values.size() + 1);
+
+    for (auto value : values)
+    {
+        Serializers__append_json_double(value, chars);
+        offsets.push_back(static_cast<cudf::size_type>(chars.size()));
+    }
+
+    return Serializers__upload_strings_column(offsets, chars);
+}
+
+/**
+ * @brief Lookup columns used by every call to the JSON lines writer. Created once and never freed.
+ */
+struct Serializers__JsonTables
+{
+    // Characters which must be escaped in JSON strings, and their escaped form
+    std::unique_ptr<cudf::column> escape_targets;
+    std::unique_ptr<cudf::column> escape_replacements;
+};
+
+const Serializers__JsonTables& Serializers__json_tables()
+{
+    static const auto* tables = []() {
+        std::vector<std::string> targets;
+        std::vector<std::string> replacements;
+
+        for (int c = 0; c < 0x20; ++c)
+        {
+            targets.emplace_back(1, static_cast<char>(c));
+        }
+        targets.emplace_back("\"");
+        targets.emplace_back("\\");
+        targets.emplace_back("/");
+
+        std::transform(targets.begin(), targets.end(), std::back_inserter(replacements), Serializers__escape_json);
+
+        auto* result                = new Serializers__JsonTables();
+        result->escape_targets      = Serializers__make_strings_column(targets);
+        result->escape_replacements = Serializers__make_strings_column(replacements);
+
+        return result;
+    }();
+
+    return *tables;
+}
+
+bool Serializers__is_json_supported(cudf::data_type type)
+{
+    return cudf::is_integral(type) || cudf::is_floating_point(type) || cudf::is_boolean(type) ||
+           cudf::is_timestamp(type) || type.id() == cudf::type_id::STRING;
+}
+
+/**
+ * @brief Formats `column` as JSON values. Strings are escaped, and only quoted when `quote` is set, nulls become
+ * `null`. Floats are formatted like pandas, timestamps are written as milliseconds since the epoch, same as pandas.
+ */
+std::unique_ptr<cudf::column> Serializers__format_json_values(const cudf::column_view& column, bool quote)
+{
+    const auto& tables = Serializers__json_tables();
+
+    std::unique_ptr<cudf::column> formatted;
+
+    if (column.type().id() == cudf::type_id::STRING)
+    {
+        formatted = cudf::strings::replace(cudf::strings_column_view{column},
+                                           cudf::strings_column_view{tables.escape_targets->view()},
+                                           cudf::strings_column_view{tables.escape_replacements->view()});
+
+        if (quote)
+        {
+            auto quotes = cudf::make_column_from_scalar(cudf::string_scalar("\""), column.size());
+
+            // Null strings stay null, and are replaced below
+            formatted = cudf::strings::concatenate(
+                cudf::table_view{{quotes->view(), formatted->view(), quotes->view()}});
+        }
+    }
+    else if (cudf::is_boolean(column.type()))
+    {
+        formatted = cudf::strings::from_booleans(column);
+    }
+    else if (cudf::is_floating_point(column.type()))
+    {
+        formatted = Serializers__format_json_floats(column);
+    }
+    else if (cudf::is_timestamp(column.type()))
+    {
+        auto millis = cudf::cast(column, cudf::data_type{cudf::type_id::TIMESTAMP_MILLISECONDS});
+
+        // Same storage as INT64, read it as such
+        cudf::column_view ticks{cudf::data_type{cudf::type_id::INT64},
+                                millis->size(),
+                                millis->view().head(),
+                                millis->view().null_mask(),
+                                millis->null_count()};
+
+        formatted = cudf::strings::from_integers(ticks);
+    }
+    else
+    {
+        formatted = cudf::strings::from_integers(column);
+    }
+
+    if (formatted->has_nulls())
+    {
+        formatted = cudf::replace_nulls(formatted->view(), cudf::string_scalar("null"));
+    }
+
+    return formatted;
+}
+
+/**
+ * @brief Writes `tbl` as JSON lines, one record per row without the index, byte for byte the same output as
+ * `to_json(orient="records", lines=True)` for ASCII data. Records are formatted a chunk at a time, on the device except
+ * for floats, and streamed to `sink`, as is when it supports device writes and through a pinned staging buffer
+ * otherwise. Returns false, without writing anything, when a column has a type which is not supported.
+ */
+bool Serializers__write_json_lines(const TableInfo& tbl, cudf::io::data_sink& sink)
+{
+    const auto& view        = tbl.get_view();
+    const auto num_indices  = tbl.num_indices();
+    const auto column_names = tbl.get_column_names();
+    const auto num_columns  = static_cast<cudf::size_type>(column_names.size());
+
+    // Strings without nulls are quoted by the surrounding fragments instead of a separate pass
+    std::vector<bool> quote_in_fragment(num_columns);
+
+    for (cudf::size_type i = 0; i < num_columns; ++i)
+    {
+        const auto& column = view.column(num_indices + i);
+
+        if (!Serializers__is_json_supported(column.type()))
+        {
+            return false;
+        }
+
+        quote_in_fragment[i] = column.type().id() == cudf::type_id::STRING && !column.has_nulls();
+    }
+
+    MORPHEUS_DEVICE_RANGE("df_to_json");
+
+    // Constant text around the values, `num_columns + 1` fragments
+    std::vector<std::string> fragments;
+
+    for (cudf::size_type i = 0; i <= num_columns; ++i)
+    {
+        std::string fragment = (i > 0 && quote_in_fragment[i - 1]) ? "\"" : "";
+
+        if (i == num_columns)
+        {
+            fragment += i == 0 ? "{}\n" : "}\n";
+        }
+        else
+        {
+            fragment += (i == 0 ? "{\"" : ",\"") + Serializers__escape_json(column_names[i]) + "\":";
+            fragment += quote_in_fragment[i] ? "\"" : "";
+        }
+
+        fragments.push_back(std::move(fragment));
+    }
+
+    for (cudf::size_type start = 0; start < view.num_rows(); start += JsonChunkRows)
+    {
+        const auto stop  = std::min(start + JsonChunkRows, view.num_rows());
+        const auto chunk = cudf::slice(view, {start, stop})[0];
+
+        std::vector<std::unique_ptr<cudf::column>> owned;
+        std::vector<cudf::column_view> parts;
+
+        for (cudf::size_type i = 0; i <= num_columns; ++i)
+        {
+            owned.push_back(cudf::make_column_from_scalar(cudf::string_scalar(fragments[i]), chunk.num_rows()));
+            parts.push_back(owned.back()->view());
+
+            if (i < num_columns)
+            {
+                owned.push_back(Serializers__format_json_values(chunk.column(num_indices + i), !quote_in_fragment[i]));
+                parts.push_back(owned.back()->view());
+            }
+        }
+
+        // Every record ends with a newline, so the characters of the result are the output as is
+        auto records = cudf::strings::concatenate(cudf::table_view{parts});
+        cudf::strings_column_view records_view{records->view()};
+
+        const auto bytes = static_cast<std::size_t>(records_view.chars_size());
+
+        if (sink.is_device_write_preferred(bytes))
+        {
+            sink.device_write(records_view.chars().head(), bytes, rmm::cuda_stream_per_thread);
+            continue;
+        }
+
+        auto host_buffer = PinnedHostPool::acquire(bytes);
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(host_buffer.data(),
+                                       records_view.chars().head(),
+                                       bytes,
+                                       cudaMemcpyDeviceToHost,
+                                       rmm::cuda_stream_per_thread));
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+        sink.host_write(host_buffer.data(), bytes);
+    }
+
+    sink.flush();
+
+    return true;
+}
+
+std::string Serializers__df_to_json_python(const TableInfo& tbl)
+{
+    std::string results;
+    // no cpp impl for to_json, instead python module converts to pandas and calls to_json
+    {
+        py::gil_scoped_acquire gil;
+        py::object StringIO = py::module_::import("io").attr("StringIO");
+
+        auto df         = tbl.as_py_object();
+        auto buffer     = StringIO();
+        py::dict kwargs = py::dict("orient"_a = "records", "lines"_a = true);
+        df.attr("to_json")(buffer, **kwargs);
+        buffer.attr("seek")(0);
+
+        py::object pyresults = buffer.attr("getvalue")();
+        results              = pyresults.cast<std::string>();
+    }
+
+    return results;
+}
+
+// Component public implementations
 std::string df_to_csv(const TableInfo& tbl, bool include_header)
 {
-    // Create an ostringstream and use that with the overload accepting an ostream
-    std::ostringstream out_stream;
+    std::string output;
+    StringSink sink(output);
 
-    df_to_csv(tbl, out_stream, include_header);
+    df_to_csv(tbl, sink, include_header);
 
-    return out_stream.str();
+    return output;
 }
 
 void df_to_csv(const TableInfo& tbl, std::ostream& out_stream, bool include_header)
 {
     OStreamSink sink(out_stream);
+
+    df_to_csv(tbl, sink, include_header);
+}
+
+void df_to_csv(const TableInfo& tbl, cudf::io::data_sink& sink, bool include_header)
+{
     auto destination     = cudf::io::sink_info(&sink);
     auto options_builder = cudf::io::csv_writer_options_builder(destination, tbl.get_view())
                                .include_header(include_header)
@@ -108,34 +601,40 @@ void df_to_csv(const TableInfo& tbl, std::ostream& out_stream, bool include_head
 
 std::string df_to_json(const TableInfo& tbl)
 {
-    std::string results;
-    // no cpp impl for to_json, instead python module converts to pandas and calls to_json
-    {
-        py::gil_scoped_acquire gil;
-        py::object StringIO = py::module_::import("io").attr("StringIO");
+    std::string output;
+    StringSink sink(output);
 
-        auto df         = tbl.as_py_object();
-        auto buffer     = StringIO();
-        py::dict kwargs = py::dict("orient"_a = "records", "lines"_a = true);
-        df.attr("to_json")(buffer, **kwargs);
-        buffer.attr("seek")(0);
-
-        py::object pyresults = buffer.attr("getvalue")();
-        results              = pyresults.cast<std::string>();
-    }
+    df_to_json(tbl, sink);
 
-    return results;
+    return output;
 }
 
 void df_to_json(const TableInfo& tbl, std::ostream& out_stream)
 {
-    // Unlike df_to_csv, we use the ostream overload to call the string overload because there is no C++ implementation
-    // of to_json
-    std::string output = df_to_json(tbl);
+    OStreamSink sink(out_stream);
+
+    df_to_json(tbl, sink);
+}
+
+void df_to_json(const TableInfo& tbl, cudf::io::data_sink& sink)
+{
+    if (Serializers__write_json_lines(tbl, sink))
+    {
+        return;
+    }
+
+    // Column types the native writer does not handle (lists, structs, decimals, ...) go through pandas
+    std::string output = Serializers__df_to_json_python(tbl);
+
+    // pandas only terminates the last record in newer versions, keep every message's output appendable
+    if (!output.empty() && output.back() != '\n')
+    {
+        output.push_back('\n');
+    }
 
-    // Now write the contents to the stream
-    out_stream.write(output.data(), output.size());
-    out_stream.flush();
+    // Now write the contents to the sink
+    sink.host_write(output.data(), output.size());
+    sink.flush();
 }
 
 }  // namespace morpheus
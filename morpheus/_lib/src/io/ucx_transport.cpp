@@ -0,0 +1,648 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/io/ucx_transport.hpp>
+
+#include <cudf/copying.hpp>
+#include <cudf/table/table.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+
+#ifdef MORPHEUS_USE_UCX
+#include <ucp/api/ucp.h>
+
+#include <netdb.h>       // for getaddrinfo
+#include <netinet/in.h>  // for sockaddr_in
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ UcxFrameHeader__Reader ************ //
+/**
+ * @brief Reads the fields of an encoded header, throwing rather than reading past its end.
+ */
+struct UcxFrameHeader__Reader
+{
+    const uint8_t *data;
+    std::size_t size;
+    std::size_t offset{0};
+
+    const uint8_t *take(std::size_t bytes)
+    {
+        if (bytes > size - offset)
+        {
+            throw std::runtime_error("Truncated UCX frame header");
+        }
+
+        const auto *start = data + offset;
+        offset += bytes;
+
+        return start;
+    }
+
+    template <typename T>
+    T read()
+    {
+        T value;
+        std::memcpy(&value, this->take(sizeof(T)), sizeof(T));
+
+        return value;
+    }
+};
+
+// Component-private free functions.
+// ************ UcxFrameHeader__ ************ //
+constexpr uint32_t UcxFrameHeader__Magic   = 0x5855524d;  // "MRUX"
+constexpr uint32_t UcxFrameHeader__Version = 1;
+
+template <typename T>
+static void UcxFrameHeader__write(std::vector<uint8_t> &out, const T &value)
+{
+    const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+static void UcxFrameHeader__write_bytes(std::vector<uint8_t> &out, const void *data, std::size_t size)
+{
+    UcxFrameHeader__write<uint64_t>(out, size);
+
+    const auto *bytes = static_cast<const uint8_t *>(data);
+    out.insert(out.end(), bytes, bytes + size);
+}
+
+// ************ UcxTransport__ ************ //
+// The top byte of a tag tells headers from payloads, the rest identifies the sender and the frame
+constexpr uint64_t UcxTransport__HeaderKind  = 1ULL << 56;
+constexpr uint64_t UcxTransport__PayloadKind = 2ULL << 56;
+constexpr uint64_t UcxTransport__KindMask    = 0xffULL << 56;
+constexpr uint64_t UcxTransport__FullMask    = ~0ULL;
+
+#ifdef MORPHEUS_USE_UCX
+static uint64_t UcxTransport__tag(uint64_t kind, uint64_t sender_id, uint32_t sequence)
+{
+    return kind | ((sender_id & 0xffffffffULL) << 24) | (sequence & 0xffffffU);
+}
+
+static void UcxTransport__check(ucs_status_t status, const std::string &action)
+{
+    if (status != UCS_OK)
+    {
+        throw std::runtime_error("UCX failed to " + action + ": " + ucs_status_string(status));
+    }
+}
+
+static void UcxTransport__destroy_worker(ucp_context_h &context, ucp_worker_h &worker)
+{
+    if (worker != nullptr)
+    {
+        ucp_worker_destroy(worker);
+        worker = nullptr;
+    }
+
+    if (context != nullptr)
+    {
+        ucp_cleanup(context);
+        context = nullptr;
+    }
+}
+
+static void UcxTransport__create_worker(ucp_context_h &context, ucp_worker_h &worker)
+{
+    ucp_params_t params{};
+    params.field_mask = UCP_PARAM_FIELD_FEATURES;
+    params.features   = UCP_FEATURE_TAG;
+
+    // Picks up the UCX_* environment variables, e.g. UCX_TLS
+    ucp_config_t *config = nullptr;
+    UcxTransport__check(ucp_config_read(nullptr, nullptr, &config), "read its configuration");
+
+    auto status = ucp_init(&params, config, &context);
+    ucp_config_release(config);
+    UcxTransport__check(status, "initialize");
+
+    ucp_worker_params_t worker_params{};
+    worker_params.field_mask  = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
+    worker_params.thread_mode = UCS_THREAD_MODE_SINGLE;
+
+    status = ucp_worker_create(context, &worker_params, &worker);
+
+    if (status != UCS_OK)
+    {
+        UcxTransport__destroy_worker(context, worker);
+        UcxTransport__check(status, "create a worker");
+    }
+}
+
+/**
+ * @brief Progresses `worker` until `request` completes, yielding the fiber whenever there was nothing to progress.
+ */
+static ucs_status_t UcxTransport__wait(ucp_worker_h worker, ucs_status_ptr_t request)
+{
+    if (request == nullptr)
+    {
+        // Completed immediately
+        return UCS_OK;
+    }
+
+    if (UCS_PTR_IS_ERR(request))
+    {
+        return UCS_PTR_STATUS(request);
+    }
+
+    ucs_status_t status;
+
+    while ((status = ucp_request_check_status(request)) == UCS_INPROGRESS)
+    {
+        if (ucp_worker_progress(worker) == 0)
+        {
+            boost::this_fiber::yield();
+        }
+    }
+
+    ucp_request_free(request);
+
+    return status;
+}
+
+static ucp_request_param_t UcxTransport__params(bool on_device)
+{
+    ucp_request_param_t params{};
+
+    // Pool allocated device memory is not always detected as such by UCX
+    params.op_attr_mask = UCP_OP_ATTR_FIELD_MEMORY_TYPE;
+    params.memory_type  = on_device ? UCS_MEMORY_TYPE_CUDA : UCS_MEMORY_TYPE_HOST;
+
+    return params;
+}
+
+static void UcxTransport__close_endpoint(ucp_worker_h worker, ucp_ep_h ep, bool force)
+{
+    ucp_request_param_t params{};
+    params.op_attr_mask = UCP_OP_ATTR_FIELD_FLAGS;
+    params.flags        = force ? UCP_EP_CLOSE_FLAG_FORCE : 0;
+
+    auto status = UcxTransport__wait(worker, ucp_ep_close_nbx(ep, &params));
+
+    if (status != UCS_OK && status != UCS_ERR_CONNECTION_RESET)
+    {
+        VLOG(10) << "Closing a UCX endpoint failed: " << ucs_status_string(status);
+    }
+}
+
+static sockaddr_in UcxTransport__resolve(const std::string &host, uint16_t port)
+{
+    addrinfo hints{};
+    hints.ai_family   = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo *result = nullptr;
+
+    if (::getaddrinfo(host.c_str(), nullptr, &hints, &result) != 0 || result == nullptr)
+    {
+        throw std::invalid_argument("Could not resolve '" + host + "'");
+    }
+
+    sockaddr_in address;
+    std::memcpy(&address, result->ai_addr, sizeof(address));
+    address.sin_port = htons(port);
+
+    ::freeaddrinfo(result);
+
+    return address;
+}
+
+// ************ UcxSender__Callbacks ************ //
+struct UcxSender__Callbacks
+{
+    static void on_error(void *arg, ucp_ep_h ep, ucs_status_t status)
+    {
+        LOG(ERROR) << "UCX connection to the receiver failed: " << ucs_status_string(status);
+
+        static_cast<UcxSender *>(arg)->m_failed = true;
+    }
+};
+
+// ************ UcxReceiver__Callbacks ************ //
+struct UcxReceiver__Callbacks
+{
+    static void on_connection(ucp_conn_request_h conn_request, void *arg)
+    {
+        auto *receiver = static_cast<UcxReceiver *>(arg);
+
+        ucp_ep_params_t params{};
+        params.field_mask = UCP_EP_PARAM_FIELD_CONN_REQUEST | UCP_EP_PARAM_FIELD_ERR_HANDLER |
+                            UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE;
+        params.conn_request    = conn_request;
+        params.err_mode        = UCP_ERR_HANDLING_MODE_PEER;
+        params.err_handler.cb  = UcxReceiver__Callbacks::on_error;
+        params.err_handler.arg = receiver;
+
+        ucp_ep_h ep = nullptr;
+        auto status = ucp_ep_create(receiver->m_worker, &params, &ep);
+
+        if (status != UCS_OK)
+        {
+            LOG(ERROR) << "Could not accept a UCX sender: " << ucs_status_string(status);
+            ucp_listener_reject(receiver->m_listener, conn_request);
+            return;
+        }
+
+        receiver->m_endpoints.push_back(ep);
+    }
+
+    static void on_error(void *arg, ucp_ep_h ep, ucs_status_t status)
+    {
+        // Also called when a sender disconnects after closing, `receive` tells the two apart
+        VLOG(10) << "UCX sender disconnected: " << ucs_status_string(status);
+
+        ++static_cast<UcxReceiver *>(arg)->m_disconnected_senders;
+    }
+};
+#endif
+
+// Component public implementations
+// ************ UcxFrameHeader **************************** //
+std::vector<uint8_t> UcxFrameHeader::encode() const
+{
+    std::vector<uint8_t> out;
+
+    UcxFrameHeader__write(out, UcxFrameHeader__Magic);
+    UcxFrameHeader__write(out, UcxFrameHeader__Version);
+    UcxFrameHeader__write<uint8_t>(out, end ? 1 : 0);
+    UcxFrameHeader__write(out, payload_tag);
+    UcxFrameHeader__write(out, payload_bytes);
+    UcxFrameHeader__write(out, num_indices);
+    UcxFrameHeader__write<uint32_t>(out, column_names.size());
+
+    for (const auto &name : column_names)
+    {
+        UcxFrameHeader__write_bytes(out, name.data(), name.size());
+    }
+
+    UcxFrameHeader__write_bytes(out, metadata.data(), metadata.size());
+
+    return out;
+}
+
+UcxFrameHeader UcxFrameHeader::decode(const uint8_t *data, std::size_t size)
+{
+    UcxFrameHeader__Reader reader{data, size};
+
+    if (reader.read<uint32_t>() != UcxFrameHeader__Magic)
+    {
+        throw std::runtime_error("Not a UCX frame header");
+    }
+
+    auto version = reader.read<uint32_t>();
+
+    if (version != UcxFrameHeader__Version)
+    {
+        throw std::runtime_error("Unsupported UCX frame header version " + std::to_string(version));
+    }
+
+    UcxFrameHeader header;
+    header.end           = reader.read<uint8_t>() != 0;
+    header.payload_tag   = reader.read<uint64_t>();
+    header.payload_bytes = reader.read<uint64_t>();
+    header.num_indices   = reader.read<int32_t>();
+
+    auto num_columns = reader.read<uint32_t>();
+
+    for (uint32_t i = 0; i < num_columns; ++i)
+    {
+        auto length = reader.read<uint64_t>();
+        header.column_names.emplace_back(reinterpret_cast<const char *>(reader.take(length)), length);
+    }
+
+    auto metadata_bytes = reader.read<uint64_t>();
+    const auto *metadata = reader.take(metadata_bytes);
+    header.metadata.assign(metadata, metadata + metadata_bytes);
+
+    return header;
+}
+
+#ifdef MORPHEUS_USE_UCX
+// ************ UcxSender **************************** //
+UcxSender::UcxSender(const std::string &host, uint16_t port)
+{
+    // Tells the tables of different senders apart at the receiver
+    m_sender_id = std::random_device{}();
+
+    auto address = UcxTransport__resolve(host, port);
+
+    UcxTransport__create_worker(m_context, m_worker);
+
+    ucp_ep_params_t params{};
+    params.field_mask = UCP_EP_PARAM_FIELD_FLAGS | UCP_EP_PARAM_FIELD_SOCK_ADDR | UCP_EP_PARAM_FIELD_ERR_HANDLER |
+                        UCP_EP_PARAM_FIELD_ERR_HANDLING_MODE;
+    params.flags            = UCP_EP_PARAMS_FLAGS_CLIENT_SERVER;
+    params.sockaddr.addr    = reinterpret_cast<const sockaddr *>(&address);
+    params.sockaddr.addrlen = sizeof(address);
+    params.err_mode         = UCP_ERR_HANDLING_MODE_PEER;
+    params.err_handler.cb   = UcxSender__Callbacks::on_error;
+    params.err_handler.arg  = this;
+
+    // Connects in the background, the first send waits for it
+    auto status = ucp_ep_create(m_worker, &params, &m_ep);
+
+    if (status != UCS_OK)
+    {
+        m_ep = nullptr;
+        UcxTransport__destroy_worker(m_context, m_worker);
+        UcxTransport__check(status, "connect to " + host + ":" + std::to_string(port));
+    }
+}
+
+UcxSender::~UcxSender()
+{
+    if (m_ep != nullptr)
+    {
+        UcxTransport__close_endpoint(m_worker, m_ep, true);
+    }
+
+    UcxTransport__destroy_worker(m_context, m_worker);
+}
+
+void UcxSender::send(const cudf::table_view &table, const std::vector<std::string> &column_names, int num_indices)
+{
+    CHECK(column_names.size() == table.num_columns()) << "Expected a name for every column";
+
+    // A single device buffer, UCX moves it in one transfer
+    auto packed = cudf::pack(table);
+    rmm::cuda_stream_default.synchronize();
+
+    UcxFrameHeader header;
+    header.payload_tag   = UcxTransport__tag(UcxTransport__PayloadKind, m_sender_id, m_sequence++);
+    header.payload_bytes = packed.gpu_data->size();
+    header.num_indices   = num_indices;
+    header.column_names  = column_names;
+    header.metadata.assign(packed.metadata_->data(), packed.metadata_->data() + packed.metadata_->size());
+
+    auto encoded = header.encode();
+
+    const auto header_tag = UcxTransport__tag(UcxTransport__HeaderKind, m_sender_id, 0);
+
+    this->send_buffer(encoded.data(), encoded.size(), header_tag, false);
+
+    if (header.payload_bytes > 0)
+    {
+        this->send_buffer(packed.gpu_data->data(), header.payload_bytes, header.payload_tag, true);
+    }
+
+    m_bytes_sent += encoded.size() + header.payload_bytes;
+}
+
+void UcxSender::close()
+{
+    if (m_ep == nullptr)
+    {
+        return;
+    }
+
+    UcxFrameHeader header;
+    header.end = true;
+
+    auto encoded          = header.encode();
+    const auto header_tag = UcxTransport__tag(UcxTransport__HeaderKind, m_sender_id, 0);
+
+    this->send_buffer(encoded.data(), encoded.size(), header_tag, false);
+
+    // Not forced, outstanding sends are flushed before disconnecting
+    UcxTransport__close_endpoint(m_worker, m_ep, false);
+    m_ep = nullptr;
+}
+
+void UcxSender::send_buffer(const void *data, std::size_t bytes, uint64_t tag, bool on_device)
+{
+    if (m_failed || m_ep == nullptr)
+    {
+        throw std::runtime_error("The UCX connection to the receiver is closed");
+    }
+
+    auto params = UcxTransport__params(on_device);
+
+    UcxTransport__check(UcxTransport__wait(m_worker, ucp_tag_send_nbx(m_ep, data, bytes, tag, &params)),
+                        "send to the receiver");
+}
+
+// ************ UcxReceiver **************************** //
+UcxReceiver::UcxReceiver(const std::string &address, uint16_t port, std::size_t num_senders) :
+  m_num_senders(num_senders)
+{
+    if (num_senders == 0)
+    {
+        throw std::invalid_argument("UcxReceiver needs at least one sender");
+    }
+
+    auto listen_address = UcxTransport__resolve(address, port);
+
+    UcxTransport__create_worker(m_context, m_worker);
+
+    ucp_listener_params_t params{};
+    params.field_mask       = UCP_LISTENER_PARAM_FIELD_SOCK_ADDR | UCP_LISTENER_PARAM_FIELD_CONN_HANDLER;
+    params.sockaddr.addr    = reinterpret_cast<const sockaddr *>(&listen_address);
+    params.sockaddr.addrlen = sizeof(listen_address);
+    params.conn_handler.cb  = UcxReceiver__Callbacks::on_connection;
+    params.conn_handler.arg = this;
+
+    auto status = ucp_listener_create(m_worker, &params, &m_listener);
+
+    if (status != UCS_OK)
+    {
+        m_listener = nullptr;
+        UcxTransport__destroy_worker(m_context, m_worker);
+        UcxTransport__check(status, "listen on " + address + ":" + std::to_string(port));
+    }
+
+    LOG(INFO) << "Listening for " << num_senders << " UCX sender(s) on " << address << ":" << port;
+}
+
+UcxReceiver::~UcxReceiver()
+{
+    for (auto *ep : m_endpoints)
+    {
+        UcxTransport__close_endpoint(m_worker, ep, true);
+    }
+
+    if (m_listener != nullptr)
+    {
+        ucp_listener_destroy(m_listener);
+    }
+
+    UcxTransport__destroy_worker(m_context, m_worker);
+}
+
+std::optional<UcxReceivedTable> UcxReceiver::receive(std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+    while (!this->done())
+    {
+        ucp_tag_recv_info_t info;
+        auto *message = ucp_tag_probe_nb(m_worker, UcxTransport__HeaderKind, UcxTransport__KindMask, 1, &info);
+
+        if (message != nullptr)
+        {
+            std::vector<uint8_t> encoded(info.length);
+            auto params = UcxTransport__params(false);
+
+            UcxTransport__check(
+                UcxTransport__wait(m_worker,
+                                   ucp_tag_msg_recv_nbx(m_worker, encoded.data(), encoded.size(), message, &params)),
+                "receive a frame header");
+
+            auto header = UcxFrameHeader::decode(encoded.data(), encoded.size());
+            m_bytes_received += encoded.size();
+
+            if (header.end)
+            {
+                ++m_closed_senders;
+                continue;
+            }
+
+            rmm::device_buffer payload(header.payload_bytes, rmm::cuda_stream_per_thread);
+
+            // UCX writes the buffer outside of any stream
+            rmm::cuda_stream_per_thread.synchronize();
+
+            if (header.payload_bytes > 0)
+            {
+                this->receive_buffer(payload.data(), header.payload_bytes, header.payload_tag, true);
+            }
+
+            m_bytes_received += header.payload_bytes;
+
+            auto view = cudf::unpack(header.metadata.data(), static_cast<const uint8_t *>(payload.data()));
+
+            UcxReceivedTable received;
+            received.num_indices = header.num_indices;
+
+            // Every column points into the packed buffer, copied so each column owns its memory
+            received.table.tbl                   = std::make_unique<cudf::table>(view);
+            received.table.metadata.column_names = std::move(header.column_names);
+
+            return received;
+        }
+
+        if (ucp_worker_progress(m_worker) != 0)
+        {
+            continue;
+        }
+
+        // Nothing left to progress, the end frame of every sender which closed has been received
+        if (m_disconnected_senders > m_closed_senders)
+        {
+            throw std::runtime_error("A UCX sender disconnected without closing");
+        }
+
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return std::nullopt;
+        }
+
+        boost::this_fiber::yield();
+    }
+
+    return std::nullopt;
+}
+
+void UcxReceiver::receive_buffer(void *data, std::size_t bytes, uint64_t tag, bool on_device)
+{
+    auto params = UcxTransport__params(on_device);
+
+    UcxTransport__check(
+        UcxTransport__wait(m_worker,
+                           ucp_tag_recv_nbx(m_worker, data, bytes, tag, UcxTransport__FullMask, &params)),
+        "receive a table");
+}
+#else
+static std::runtime_error UcxTransport__unavailable()
+{
+    return std::runtime_error("Sending tables between pipelines requires the library to be built with "
+                              "MORPHEUS_USE_UCX");
+}
+
+// ************ UcxSender **************************** //
+UcxSender::UcxSender(const std::string &host, uint16_t port)
+{
+    throw UcxTransport__unavailable();
+}
+
+UcxSender::~UcxSender() = default;
+
+void UcxSender::send(const cudf::table_view &table, const std::vector<std::string> &column_names, int num_indices)
+{
+    throw UcxTransport__unavailable();
+}
+
+void UcxSender::close() {}
+
+void UcxSender::send_buffer(const void *data, std::size_t bytes, uint64_t tag, bool on_device)
+{
+    throw UcxTransport__unavailable();
+}
+
+// ************ UcxReceiver **************************** //
+UcxReceiver::UcxReceiver(const std::string &address, uint16_t port, std::size_t num_senders) :
+  m_num_senders(num_senders)
+{
+    throw UcxTransport__unavailable();
+}
+
+UcxReceiver::~UcxReceiver() = default;
+
+std::optional<UcxReceivedTable> UcxReceiver::receive(std::chrono::milliseconds timeout)
+{
+    throw UcxTransport__unavailable();
+}
+
+void UcxReceiver::receive_buffer(void *data, std::size_t bytes, uint64_t tag, bool on_device)
+{
+    throw UcxTransport__unavailable();
+}
+#endif
+
+std::size_t UcxSender::bytes_sent() const
+{
+    return m_bytes_sent;
+}
+
+bool UcxReceiver::done() const
+{
+    return m_closed_senders >= m_num_senders;
+}
+
+std::size_t UcxReceiver::bytes_received() const
+{
+    return m_bytes_received;
+}
+}  // namespace morpheus
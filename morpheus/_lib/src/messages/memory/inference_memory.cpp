@@ -28,7 +28,7 @@ namespace morpheus {
     InferenceMemory::InferenceMemory(size_t count) : count(count) {}
 
     bool InferenceMemory::has_input(const std::string &name) const  {
-        return this->inputs.find(name) != this->inputs.end();
+        return this->inputs.contains(name);
     }
 
     /****** InferenceMemoryInterfaceProxy *************************/
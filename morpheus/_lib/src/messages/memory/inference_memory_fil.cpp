@@ -36,40 +36,29 @@ namespace morpheus {
 InferenceMemoryFIL::InferenceMemoryFIL(size_t count, TensorObject input__0, TensorObject seq_ids) :
   InferenceMemory(count)
 {
-    this->inputs["input__0"] = std::move(input__0);
-    this->inputs["seq_ids"]  = std::move(seq_ids);
+    // Must match the order of the slot constants
+    this->inputs.emplace("input__0", std::move(input__0));
+    this->inputs.emplace("seq_ids", std::move(seq_ids));
 }
 
 const TensorObject &InferenceMemoryFIL::get_input__0() const
 {
-    auto found = this->inputs.find("input__0");
-    if (found == this->inputs.end())
-    {
-        throw std::runtime_error("Tensor: 'input__0' not found in memory");
-    }
-
-    return found->second;
+    return this->inputs.at(Input0Slot);
 }
 
 void InferenceMemoryFIL::set_input__0(TensorObject input__0)
 {
-    this->inputs["input__0"] = std::move(input__0);
+    this->inputs.at(Input0Slot) = std::move(input__0);
 }
 
 const TensorObject &InferenceMemoryFIL::get_seq_ids() const
 {
-    auto found = this->inputs.find("seq_ids");
-    if (found == this->inputs.end())
-    {
-        throw std::runtime_error("Tensor: 'seq_ids' not found in memory");
-    }
-
-    return found->second;
+    return this->inputs.at(SeqIdsSlot);
 }
 
 void InferenceMemoryFIL::set_seq_ids(TensorObject seq_ids)
 {
-    this->inputs["seq_ids"] = std::move(seq_ids);
+    this->inputs.at(SeqIdsSlot) = std::move(seq_ids);
 }
 /****** InferenceMemoryFILInterfaceProxy *************************/
 std::shared_ptr<InferenceMemoryFIL> InferenceMemoryFILInterfaceProxy::init(cudf::size_type count,
@@ -34,57 +34,40 @@ InferenceMemoryNLP::InferenceMemoryNLP(std::size_t count,
                                        TensorObject seq_ids) :
   InferenceMemory(count)
 {
-    this->inputs["input_ids"]  = std::move(input_ids);
-    this->inputs["input_mask"] = std::move(input_mask);
-    this->inputs["seq_ids"]    = std::move(seq_ids);
+    // Must match the order of the slot constants
+    this->inputs.emplace("input_ids", std::move(input_ids));
+    this->inputs.emplace("input_mask", std::move(input_mask));
+    this->inputs.emplace("seq_ids", std::move(seq_ids));
 }
 
 const TensorObject &InferenceMemoryNLP::get_input_ids() const
 {
-    auto found = this->inputs.find("input_ids");
-    if (found == this->inputs.end())
-    {
-        throw std::runtime_error("Tensor: 'input_ids' not found in memory");
-    }
-
-    return found->second;
+    return this->inputs.at(InputIdsSlot);
 }
 
 void InferenceMemoryNLP::set_input_ids(TensorObject input_ids)
 {
-    this->inputs["input_ids"] = std::move(input_ids);
+    this->inputs.at(InputIdsSlot) = std::move(input_ids);
 }
 
 const TensorObject &InferenceMemoryNLP::get_input_mask() const
 {
-    auto found = this->inputs.find("input_mask");
-    if (found == this->inputs.end())
-    {
-        throw std::runtime_error("Tensor: 'input_mask' not found in memory");
-    }
-
-    return found->second;
+    return this->inputs.at(InputMaskSlot);
 }
 
 void InferenceMemoryNLP::set_input_mask(TensorObject input_mask)
 {
-    this->inputs["input_mask"] = std::move(input_mask);
+    this->inputs.at(InputMaskSlot) = std::move(input_mask);
 }
 
 const TensorObject &InferenceMemoryNLP::get_seq_ids() const
 {
-    auto found = this->inputs.find("seq_ids");
-    if (found == this->inputs.end())
-    {
-        throw std::runtime_error("Tensor: 'seq_ids' not found in memory");
-    }
-
-    return found->second;
+    return this->inputs.at(SeqIdsSlot);
 }
 
 void InferenceMemoryNLP::set_seq_ids(TensorObject seq_ids)
 {
-    this->inputs["seq_ids"] = std::move(seq_ids);
+    this->inputs.at(SeqIdsSlot) = std::move(seq_ids);
 }
 
 /****** InferenceMemoryNLPInterfaceProxy *************************/
@@ -33,29 +33,31 @@ ResponseMemory::ResponseMemory(size_t count) : count(count) {}
 
 bool ResponseMemory::has_output(const std::string &name) const
 {
-    return this->outputs.find(name) != this->outputs.end();
+    return this->outputs.contains(name);
 }
 
 /****** ResponseMemoryInterfaceProxy *************************/
 pybind11::object ResponseMemoryInterfaceProxy::get_output(ResponseMemory &self, const std::string &name)
 {
     // Directly return the tensor object
-    if (!self.has_output(name))
+    auto slot = self.outputs.slot_of(name);
+    if (slot == TensorMap::npos)
     {
         throw pybind11::key_error();
     }
 
-    return CupyUtil::tensor_to_cupy(self.outputs[name]);
+    return CupyUtil::tensor_to_cupy(self.outputs.at(slot));
 }
 
 TensorObject ResponseMemoryInterfaceProxy::get_output_tensor(ResponseMemory &self, const std::string &name)
 {
     // Directly return the tensor object
-    if (!self.has_output(name))
+    auto slot = self.outputs.slot_of(name);
+    if (slot == TensorMap::npos)
     {
         throw pybind11::key_error();
     }
 
-    return self.outputs[name];
+    return self.outputs.at(slot);
 }
 }  // namespace morpheus
@@ -34,23 +34,17 @@ namespace morpheus {
 /****** ResponseMemoryProbs****************************************/
 ResponseMemoryProbs::ResponseMemoryProbs(size_t count, TensorObject probs) : ResponseMemory(count)
 {
-    this->outputs["probs"] = std::move(probs);
+    this->outputs.emplace("probs", std::move(probs));
 }
 
 const TensorObject &ResponseMemoryProbs::get_probs() const
 {
-    auto found = this->outputs.find("probs");
-    if (found == this->outputs.end())
-    {
-        throw std::runtime_error("Tensor: 'probs' not found in memory");
-    }
-
-    return found->second;
+    return this->outputs.at(ProbsSlot);
 }
 
 void ResponseMemoryProbs::set_probs(TensorObject probs)
 {
-    this->outputs["probs"] = std::move(probs);
+    this->outputs.at(ProbsSlot) = std::move(probs);
 }
 
 /****** ResponseMemoryProbsInterfaceProxy *************************/
@@ -17,17 +17,29 @@
 
 #include <morpheus/messages/meta.hpp>
 
+#include <morpheus/objects/cpp_data_table.hpp>
 #include <morpheus/objects/python_data_table.hpp>
 #include <morpheus/objects/table_info.hpp>
+#include <morpheus/objects/view_data_table.hpp>
 #include <morpheus/utilities/cudf_util.hpp>
 #include <morpheus/utilities/table_util.hpp>
 
+#include <cudf/column/column.hpp>
 #include <cudf/io/types.hpp>
+#include <cudf/table/table.hpp>
 
+#include <glog/logging.h>
 #include <pybind11/gil.h>
 #include <pybind11/pytypes.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -47,7 +59,6 @@ struct MessageMetaImpl {
 // {
 //     MessageMetaPyImpl(pybind11::object&& pydf) : m_pydf(std::move(pydf)) {}
 
-//     MessageMetaPyImpl(cudf::io::table_with_metadata&& table) : m_pydf(std::move(cpp_to_py(std::move(table)))) {}
 
 //     pybind11::object get_py_table() const override
 //     {
@@ -91,7 +102,68 @@ struct MessageMetaImpl {
 
 // std::unique_ptr<MessageMetaImpl> m_data;
 
+    struct MessageTrace__Sampler {
+        std::atomic<uint32_t> interval{0};
+        std::atomic<uint64_t> count{0};
+    };
+
+    static MessageTrace__Sampler &MessageTrace__sampler() {
+        static MessageTrace__Sampler sampler;
+        return sampler;
+    }
+
 /****** Component public implementations *******************/
+/****** MessageCompletion **********************************/
+    void MessageCompletion::fail() {
+        m_failed = true;
+    }
+
+    bool MessageCompletion::failed() const {
+        return m_failed;
+    }
+
+/****** MessageTrace ***************************************/
+    MessageTrace::MessageTrace(int64_t source_time_ns) : m_source_time_ns(source_time_ns) {}
+
+    std::shared_ptr<MessageTrace> MessageTrace::sample(int64_t source_time_ns) {
+        auto &sampler = MessageTrace__sampler();
+
+        const auto interval = sampler.interval.load(std::memory_order_relaxed);
+
+        if (interval == 0 || sampler.count.fetch_add(1, std::memory_order_relaxed) % interval != 0) {
+            return nullptr;
+        }
+
+        return std::make_shared<MessageTrace>(source_time_ns);
+    }
+
+    void MessageTrace::set_sample_interval(uint32_t interval) {
+        MessageTrace__sampler().interval.store(interval, std::memory_order_relaxed);
+    }
+
+    uint32_t MessageTrace::sample_interval() {
+        return MessageTrace__sampler().interval.load(std::memory_order_relaxed);
+    }
+
+    int64_t MessageTrace::now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    int64_t MessageTrace::source_time_ns() const {
+        return m_source_time_ns;
+    }
+
+    void MessageTrace::record(const std::string &stage, int64_t enter_ns, int64_t exit_ns) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_spans.push_back(MessageTraceSpan{stage, enter_ns, exit_ns});
+    }
+
+    std::vector<MessageTraceSpan> MessageTrace::spans() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_spans;
+    }
+
 /****** MessageMeta ****************************************/
     pybind11::object MessageMeta::get_py_table() const {
         return m_data->get_py_object();
@@ -113,33 +185,120 @@ struct MessageMetaImpl {
 
     std::shared_ptr<MessageMeta> MessageMeta::create_from_cpp(cudf::io::table_with_metadata &&data_table,
                                                               int index_col_count) {
-        // Convert to py first
-        pybind11::object py_dt = cpp_to_py(std::move(data_table), index_col_count);
+        // Stays in C++ until a python stage asks for the DataFrame. Does not need the GIL
+        auto data = std::make_unique<CppDataTable>(std::move(data_table), index_col_count);
 
-        auto data = std::make_unique<PyDataTable>(std::move(py_dt));
+        return std::shared_ptr<MessageMeta>(new MessageMeta(std::move(data)));
+    }
+
+    std::shared_ptr<MessageMeta> MessageMeta::create_from_view(TableInfo view) {
+        auto data = std::make_unique<ViewDataTable>(std::move(view));
 
         return std::shared_ptr<MessageMeta>(new MessageMeta(std::move(data)));
     }
 
-    MessageMeta::MessageMeta(std::shared_ptr<IDataTable> data) : m_data(std::move(data)) {}
+    std::size_t MessageMeta::device_bytes() const {
+        return m_data->device_bytes();
+    }
+
+    std::size_t MessageMeta::live_device_bytes() {
+        return CppDataTable::live_device_bytes();
+    }
+
+    std::size_t MessageMeta::live_tables() {
+        return CppDataTable::live_count();
+    }
+
+    std::shared_ptr<MessageMeta> MessageMeta::compact_if_sparse(const std::shared_ptr<MessageMeta> &meta,
+                                                                double min_fraction) {
+        if (min_fraction <= 0) {
+            return meta;
+        }
 
-    pybind11::object MessageMeta::cpp_to_py(cudf::io::table_with_metadata &&table, int index_col_count) {
-        pybind11::gil_scoped_acquire gil;
+        auto view_table = std::dynamic_pointer_cast<ViewDataTable>(meta->m_data);
 
-        // Now convert to a python TableInfo object
-        auto converted_table = proxy_table_from_table_with_metadata(std::move(table), index_col_count);
+        // Copies already own their rows. Python tables are not accounted
+        if (!view_table || view_table->is_owned() || !view_table->source() ||
+            view_table->source()->device_bytes() == 0) {
+            return meta;
+        }
 
-        // VLOG(10) << "Table. Num Col: " << converted_table.attr("_num_columns").str().cast<std::string>()
-        //          << ", Num Ind: " << converted_table.attr("_num_columns").cast<std::string>()
-        //          << ", Rows: " << converted_table.attr("_num_rows").cast<std::string>();
-        // pybind11::print("Table Created. Num Rows: {}, Num Cols: {}, Num Ind: {}",
-        //           converted_table.attr("_num_rows"),
-        //           converted_table.attr("_num_columns"),
-        //           converted_table.attr("_num_indices"));
+        const auto source_rows = view_table->source()->count();
 
-        return converted_table;
+        if (meta->count() >= min_fraction * source_rows) {
+            return meta;
+        }
+
+        auto info = meta->get_info();
+
+        // Index columns come first in the view, same as the layout CppDataTable expects
+        auto column_names = info.get_index_names();
+        auto data_columns = info.get_column_names();
+        column_names.insert(column_names.end(), data_columns.begin(), data_columns.end());
+
+        cudf::io::table_with_metadata table{std::make_unique<cudf::table>(info.get_view()), cudf::io::table_metadata{}};
+        table.metadata.column_names = std::move(column_names);
+
+        auto compacted = MessageMeta::create_from_cpp(std::move(table), info.num_indices());
+        compacted->inherit_completions(*meta);
+
+        return compacted;
+    }
+
+    void MessageMeta::reserve_columns(cudf::io::table_with_metadata &data_table,
+                                      const std::vector<std::string> &column_names,
+                                      const std::vector<TypeId> &column_types) {
+        CHECK(column_names.size() == column_types.size());
+
+        auto &names         = data_table.metadata.column_names;
+        const auto num_rows = data_table.tbl->num_rows();
+        std::vector<std::unique_ptr<cudf::column>> columns;
+
+        for (std::size_t i = 0; i < column_names.size(); ++i) {
+            if (std::find(names.begin(), names.end(), column_names[i]) != names.end()) {
+                continue;
+            }
+
+            if (columns.empty()) {
+                // Releasing the columns does not move their device memory
+                columns = data_table.tbl->release();
+            }
+
+            columns.emplace_back(CuDFTableUtil::make_zeroed_column(column_types[i], num_rows));
+            names.push_back(column_names[i]);
+        }
+
+        if (!columns.empty()) {
+            data_table.tbl = std::make_unique<cudf::table>(std::move(columns));
+        }
+    }
+
+    void MessageMeta::add_completion(std::shared_ptr<MessageCompletion> completion) {
+        m_completions.emplace_back(std::move(completion));
+    }
+
+    void MessageMeta::inherit_completions(const MessageMeta &other) {
+        m_completions.insert(m_completions.end(), other.m_completions.begin(), other.m_completions.end());
+
+        if (!m_trace) {
+            m_trace = other.m_trace;
+        }
     }
 
+    const std::vector<std::shared_ptr<MessageCompletion>> &MessageMeta::completions() const {
+        return m_completions;
+    }
+
+    void MessageMeta::set_trace(std::shared_ptr<MessageTrace> trace) {
+        m_trace = std::move(trace);
+    }
+
+    const std::shared_ptr<MessageTrace> &MessageMeta::trace() const {
+        return m_trace;
+    }
+
+    MessageMeta::MessageMeta(std::shared_ptr<IDataTable> data) : m_data(std::move(data)) {}
+
 /********** MessageMetaInterfaceProxy **********/
     std::shared_ptr<MessageMeta> MessageMetaInterfaceProxy::init_python(pybind11::object &&data_frame) {
         return MessageMeta::create_from_python(std::move(data_frame));
@@ -161,6 +320,30 @@ struct MessageMetaImpl {
         return self.get_py_table();
     }
 
+    pybind11::object MessageMetaInterfaceProxy::get_trace(MessageMeta &self) {
+        const auto &trace = self.trace();
+
+        if (!trace) {
+            return pybind11::none();
+        }
+
+        pybind11::list spans;
+
+        for (const auto &span: trace->spans()) {
+            spans.append(pybind11::make_tuple(span.stage, span.enter_ns, span.exit_ns));
+        }
+
+        pybind11::dict result;
+        result["source_time_ns"] = trace->source_time_ns();
+        result["spans"] = spans;
+
+        return result;
+    }
+
+    std::size_t MessageMetaInterfaceProxy::device_bytes(MessageMeta &self) {
+        return self.device_bytes();
+    }
+
     std::shared_ptr<MessageMeta> MessageMetaInterfaceProxy::init_cpp(const std::string &filename) {
         // Load the file
         auto df_with_meta = CuDFTableUtil::load_table(filename);
@@ -19,15 +19,79 @@
 
 #include <morpheus/messages/meta.hpp>
 #include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
 
+#include <cudf/column/column_view.hpp>
 #include <cudf/types.hpp>
 
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace morpheus {
+// Component-private free functions.
+/**
+ * @brief Queues a copy of `count` elements of type `type_id`, `row_stride` elements apart starting at `data`, into
+ * the column `cv` on the per-thread stream. Half types are widened to the FLOAT32 column while being copied. The caller
+ * synchronizes the stream
+ */
+void MultiMessage__copy_column(
+    const cudf::column_view &cv, const void *data, TypeId type_id, std::size_t count, TensorIndex row_stride)
+{
+    const auto column_dtype = DType(type_id).column_dtype();
+    const auto table_type   = cv.type().id();
+    const auto tensor_type  = column_dtype.cudf_type_id();
+    const auto item_size    = DType(type_id).item_size();
+
+    CHECK(count == cv.size() &&
+          (table_type == tensor_type || (table_type == cudf::type_id::BOOL8 && tensor_type == cudf::type_id::UINT8)));
+
+    const bool widen  = column_dtype.type_id() != type_id;
+    auto *column_data = const_cast<uint8_t *>(cv.data<uint8_t>());
+
+    if (widen && row_stride == 1)
+    {
+        // Widened straight from the tensor
+        MatxUtil::cast_into(data, type_id, count, column_dtype.type_id(), column_data, rmm::cuda_stream_per_thread);
+        return;
+    }
+
+    // Strided tensors which need widening are gathered first. Freed in stream order
+    rmm::device_buffer contiguous(widen ? count * item_size : 0, rmm::cuda_stream_per_thread);
+    void *copy_dst = widen ? contiguous.data() : column_data;
+
+    if (row_stride == 1)
+    {
+        // column major just use cudaMemcpy
+        NEO_CHECK_CUDA(
+            cudaMemcpyAsync(copy_dst, data, count * item_size, cudaMemcpyDeviceToDevice, rmm::cuda_stream_per_thread));
+    }
+    else
+    {
+        NEO_CHECK_CUDA(cudaMemcpy2DAsync(copy_dst,
+                                         item_size,
+                                         data,
+                                         row_stride * item_size,
+                                         item_size,
+                                         count,
+                                         cudaMemcpyDeviceToDevice,
+                                         rmm::cuda_stream_per_thread));
+    }
+
+    if (widen)
+    {
+        MatxUtil::cast_into(
+            contiguous.data(), type_id, count, column_dtype.type_id(), column_data, rmm::cuda_stream_per_thread);
+    }
+}
+
 /****** Component public implementations *******************/
 /****** MultiMessage****************************************/
 MultiMessage::MultiMessage(std::shared_ptr<morpheus::MessageMeta> m, size_t o, size_t c) :
@@ -54,9 +118,13 @@ TableInfo MultiMessage::get_meta(const std::vector<std::string> &column_names)
 {
     TableInfo info = this->meta->get_info();
 
-    TableInfo sliced_info = info.get_slice(this->mess_offset,
-                                           this->mess_offset + this->mess_count,
-                                           column_names.empty() ? info.get_column_names() : column_names);
+    if (column_names.empty())
+    {
+        // Every column in table order, no names need to be looked up
+        return info.get_row_slice(this->mess_offset, this->mess_offset + this->mess_count);
+    }
+
+    TableInfo sliced_info = info.get_slice(this->mess_offset, this->mess_offset + this->mess_count, column_names);
 
     return sliced_info;
 }
@@ -67,12 +135,31 @@ std::shared_ptr<MultiMessage> MultiMessage::get_slice(size_t start, size_t stop)
     return std::static_pointer_cast<MultiMessage>(this->internal_get_slice(start, stop));
 }
 
+std::vector<std::shared_ptr<MultiMessage>> MultiMessage::get_slices(
+    const std::vector<std::pair<size_t, size_t>> &ranges) const
+{
+    std::vector<MultiMessage> slices;
+    slices.reserve(ranges.size());
+
+    for (const auto &[start, stop] : ranges)
+    {
+        slices.emplace_back(this->make_slice(start, stop));
+    }
+
+    return share_slices(std::move(slices));
+}
+
 std::shared_ptr<MultiMessage> MultiMessage::internal_get_slice(size_t start, size_t stop) const
+{
+    return std::make_shared<MultiMessage>(this->make_slice(start, stop));
+}
+
+MultiMessage MultiMessage::make_slice(size_t start, size_t stop) const
 {
     auto mess_start = this->mess_offset + start;
     auto mess_stop  = this->mess_offset + stop;
 
-    return std::make_shared<MultiMessage>(this->meta, mess_start, mess_stop - mess_start);
+    return MultiMessage(this->meta, mess_start, mess_stop - mess_start);
 }
 
 void MultiMessage::set_meta(const std::string &col_name, TensorObject tensor)
@@ -83,45 +170,75 @@ void MultiMessage::set_meta(const std::string &col_name, TensorObject tensor)
 void MultiMessage::set_meta(const std::vector<std::string> &column_names, const std::vector<TensorObject> &tensors)
 {
     std::vector<TypeId> tensor_types{tensors.size()};
+    std::vector<TypeId> column_types{tensors.size()};
     for (size_t i = 0; i < tensors.size(); ++i)
     {
         tensor_types[i] = tensors[i].dtype().type_id();
+        column_types[i] = DType(tensors[i].dtype()).column_dtype().type_id();
     }
 
     TableInfo info = this->meta->get_info();
-    info.insert_missing_columns(column_names, tensor_types);
+    info.insert_missing_columns(column_names, column_types);
 
     TableInfo table_meta = this->get_meta(column_names);
     for (size_t i = 0; i < tensors.size(); ++i)
     {
-        const auto cv          = table_meta.get_column(i);
+        MultiMessage__copy_column(table_meta.get_column(i),
+                                  tensors[i].data(),
+                                  tensor_types[i],
+                                  tensors[i].count(),
+                                  tensors[i].stride(0));
+    }
+
+    // The table is shared with Python and other threads, wait once for all of the columns
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+}
+
+void MultiMessage::set_meta(const std::vector<std::string> &column_names,
+                            const TensorObject &tensor,
+                            const std::vector<std::size_t> &tensor_columns)
+{
+    CHECK(tensor.rank() == 2) << "Setting columns from a tensor requires a 2D tensor";
+    CHECK(column_names.size() == tensor_columns.size()) << "Must have one tensor column per column name";
+
+    const auto type_id     = tensor.dtype().type_id();
+    const auto column_type = DType(type_id).column_dtype();
+    const auto num_rows    = static_cast<std::size_t>(tensor.shape(0));
+
+    TableInfo info = this->meta->get_info();
+    info.insert_missing_columns(column_names, std::vector<TypeId>(column_names.size(), column_type.type_id()));
+
+    // Positions are resolved from the shared schema, rather than looking each name up again for the slice
+    std::vector<cudf::size_type> column_indices;
+    column_indices.reserve(column_names.size());
+
+    for (const auto &name : column_names)
+    {
+        column_indices.push_back(info.get_schema()->find_column(name));
+    }
+
+    TableInfo table_meta = info.get_slice(this->mess_offset, this->mess_offset + this->mess_count, column_indices);
+
+    std::vector<void *> outputs;
+    outputs.reserve(column_names.size());
+
+    for (size_t i = 0; i < tensor_columns.size(); ++i)
+    {
+        const auto &cv         = table_meta.get_column(i);
         const auto table_type  = cv.type().id();
-        const auto tensor_type = DType(tensor_types[i]).cudf_type_id();
-        const auto row_stride  = tensors[i].stride(0);
-
-        CHECK(tensors[i].count() == cv.size() && (table_type == tensor_type || (table_type == cudf::type_id::BOOL8 &&
-                                                                                tensor_type == cudf::type_id::UINT8)));
-
-        if (row_stride == 1)
-        {
-            // column major just use cudaMemcpy
-            NEO_CHECK_CUDA(cudaMemcpy(const_cast<uint8_t *>(cv.data<uint8_t>()),
-                                      tensors[i].data(),
-                                      tensors[i].bytes(),
-                                      cudaMemcpyDeviceToDevice));
-        }
-        else
-        {
-            const auto item_size = tensors[i].dtype().item_size();
-            NEO_CHECK_CUDA(cudaMemcpy2D(const_cast<uint8_t *>(cv.data<uint8_t>()),
-                                        item_size,
-                                        tensors[i].data(),
-                                        row_stride * item_size,
-                                        item_size,
-                                        cv.size(),
-                                        cudaMemcpyDeviceToDevice));
-        }
+        const auto tensor_type = column_type.cudf_type_id();
+
+        CHECK(num_rows == cv.size() && (table_type == tensor_type ||
+                                        (table_type == cudf::type_id::BOOL8 && tensor_type == cudf::type_id::UINT8)));
+
+        outputs.push_back(const_cast<uint8_t *>(cv.data<uint8_t>()));
     }
+
+    // Every column is written by a single launch, reading straight from the strided tensor
+    MatxUtil::scatter_columns(tensor, tensor_columns, outputs, column_type.type_id(), rmm::cuda_stream_per_thread);
+
+    // The table is shared with Python and other threads, wait once for all of the columns
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
 }
 
 /****** MultiMessageInterfaceProxy *************************/
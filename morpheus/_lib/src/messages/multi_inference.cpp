@@ -21,11 +21,13 @@
 #include <morpheus/messages/meta.hpp>
 #include <morpheus/messages/multi.hpp>
 #include <morpheus/objects/tensor.hpp>
+#include <morpheus/objects/tensor_map.hpp>
 #include <morpheus/utilities/cupy_util.hpp>
 
 #include <pybind11/pytypes.h>
 #include <cudf/types.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <utility>
@@ -47,17 +49,26 @@ MultiInferenceMessage::MultiInferenceMessage(std::shared_ptr<morpheus::MessageMe
 
 const TensorObject MultiInferenceMessage::get_input(const std::string &name) const
 {
-    CHECK(this->memory->has_input(name)) << "Cound not find input: " << name;
+    auto slot = this->memory->inputs.slot_of(name);
+
+    CHECK(slot != TensorMap::npos) << "Cound not find input: " << name;
+
+    return this->get_input(slot);
+}
+
+const TensorObject MultiInferenceMessage::get_input(std::size_t slot) const
+{
+    const auto &input = this->memory->inputs.at(slot);
 
     // check if we are getting the entire input
     if (this->offset == 0 && this->count == this->memory->count)
     {
-        return this->memory->inputs[name];
+        return input;
     }
 
     // TODO(MDD): This really needs to return the slice of the tensor
-    return this->memory->inputs[name].slice({static_cast<cudf::size_type>(this->offset), 0},
-                                            {static_cast<cudf::size_type>(this->offset + this->count), -1});
+    return input.slice({static_cast<cudf::size_type>(this->offset), 0},
+                       {static_cast<cudf::size_type>(this->offset + this->count), -1});
 }
 
 const void MultiInferenceMessage::set_input(const std::string &name, const TensorObject &value)
@@ -75,7 +86,26 @@ std::shared_ptr<MultiInferenceMessage> MultiInferenceMessage::get_slice(std::siz
     return std::static_pointer_cast<MultiInferenceMessage>(this->internal_get_slice(start, stop));
 }
 
+std::vector<std::shared_ptr<MultiInferenceMessage>> MultiInferenceMessage::get_slices(
+    const std::vector<std::pair<std::size_t, std::size_t>> &ranges) const
+{
+    std::vector<MultiInferenceMessage> slices;
+    slices.reserve(ranges.size());
+
+    for (const auto &[start, stop] : ranges)
+    {
+        slices.emplace_back(this->make_slice(start, stop));
+    }
+
+    return share_slices(std::move(slices));
+}
+
 std::shared_ptr<MultiMessage> MultiInferenceMessage::internal_get_slice(std::size_t start, std::size_t stop) const
+{
+    return std::make_shared<MultiInferenceMessage>(this->make_slice(start, stop));
+}
+
+MultiInferenceMessage MultiInferenceMessage::make_slice(std::size_t start, std::size_t stop) const
 {
     CHECK(this->mess_count == this->count) << "At this time, mess_count and count must be the same for slicing";
 
@@ -93,8 +123,7 @@ std::shared_ptr<MultiMessage> MultiInferenceMessage::internal_get_slice(std::siz
         mess_stop  = this->mess_offset + seq_ids.read_element<int32_t>({(TensorIndex)stop - 1, 0}) + 1;
     }
 
-    return std::make_shared<MultiInferenceMessage>(
-        this->meta, mess_start, mess_stop - mess_start, this->memory, start, stop - start);
+    return MultiInferenceMessage(this->meta, mess_start, mess_stop - mess_start, this->memory, start, stop - start);
 }
 
 /****** <MultiInferenceMessage>InterfaceProxy *************************/
@@ -21,6 +21,7 @@
 #include <morpheus/messages/meta.hpp>
 #include <morpheus/messages/multi.hpp>
 #include <morpheus/objects/tensor.hpp>
+#include <morpheus/objects/tensor_map.hpp>
 #include <morpheus/utilities/cupy_util.hpp>
 
 #include <cudf/types.hpp>
@@ -49,32 +50,40 @@ MultiResponseMessage::MultiResponseMessage(std::shared_ptr<morpheus::MessageMeta
 
 TensorObject MultiResponseMessage::get_output(const std::string &name)
 {
-    CHECK(this->memory->has_output(name)) << "Could not find output: " << name;
+    auto slot = this->memory->outputs.slot_of(name);
 
-    // check if we are getting the entire input
-    if (this->offset == 0 && this->count == this->memory->count)
-    {
-        return this->memory->outputs[name];
-    }
+    CHECK(slot != TensorMap::npos) << "Could not find output: " << name;
 
-    // TODO(MDD): This really needs to return the slice of the tensor
-    return this->memory->outputs[name].slice({static_cast<cudf::size_type>(this->offset), 0},
-                                             {static_cast<cudf::size_type>(this->offset + this->count), -1});
+    return this->get_output(slot);
 }
 
 const TensorObject MultiResponseMessage::get_output(const std::string &name) const
 {
-    CHECK(this->memory->has_output(name)) << "Could not find output: " << name;
+    auto slot = this->memory->outputs.slot_of(name);
+
+    CHECK(slot != TensorMap::npos) << "Could not find output: " << name;
+
+    return this->get_output(slot);
+}
+
+TensorObject MultiResponseMessage::get_output(std::size_t slot)
+{
+    return static_cast<const MultiResponseMessage &>(*this).get_output(slot);
+}
+
+const TensorObject MultiResponseMessage::get_output(std::size_t slot) const
+{
+    const auto &output = this->memory->outputs.at(slot);
 
     // check if we are getting the entire input
     if (this->offset == 0 && this->count == this->memory->count)
     {
-        return this->memory->outputs[name];
+        return output;
     }
 
     // TODO(MDD): This really needs to return the slice of the tensor
-    return this->memory->outputs[name].slice({static_cast<cudf::size_type>(this->offset), 0},
-                                             {static_cast<cudf::size_type>(this->offset + this->count), -1});
+    return output.slice({static_cast<cudf::size_type>(this->offset), 0},
+                        {static_cast<cudf::size_type>(this->offset + this->count), -1});
 }
 
 const void MultiResponseMessage::set_output(const std::string &name, const TensorObject &value)
@@ -86,21 +95,46 @@ const void MultiResponseMessage::set_output(const std::string &name, const Tenso
     slice = value;
 }
 
+const void MultiResponseMessage::set_output(std::size_t slot, const TensorObject &value)
+{
+    auto slice = this->get_output(slot);
+
+    slice = value;
+}
+
 std::shared_ptr<MultiResponseMessage> MultiResponseMessage::get_slice(std::size_t start, std::size_t stop) const
 {
     // This can only cast down
     return std::static_pointer_cast<MultiResponseMessage>(this->internal_get_slice(start, stop));
 }
 
+std::vector<std::shared_ptr<MultiResponseMessage>> MultiResponseMessage::get_slices(
+    const std::vector<std::pair<std::size_t, std::size_t>> &ranges) const
+{
+    std::vector<MultiResponseMessage> slices;
+    slices.reserve(ranges.size());
+
+    for (const auto &[start, stop] : ranges)
+    {
+        slices.emplace_back(this->make_slice(start, stop));
+    }
+
+    return share_slices(std::move(slices));
+}
+
 std::shared_ptr<MultiMessage> MultiResponseMessage::internal_get_slice(std::size_t start, std::size_t stop) const
+{
+    return std::make_shared<MultiResponseMessage>(this->make_slice(start, stop));
+}
+
+MultiResponseMessage MultiResponseMessage::make_slice(std::size_t start, std::size_t stop) const
 {
     CHECK(this->mess_count == this->count) << "At this time, mess_count and count must be the same for slicing";
 
     auto mess_start = this->mess_offset + start;
     auto mess_stop  = this->mess_offset + stop;
 
-    return std::make_shared<MultiResponseMessage>(
-        this->meta, mess_start, mess_stop - mess_start, this->memory, start, stop - start);
+    return MultiResponseMessage(this->meta, mess_start, mess_stop - mess_start, this->memory, start, stop - start);
 }
 
 /****** MultiResponseMessageInterfaceProxy *************************/
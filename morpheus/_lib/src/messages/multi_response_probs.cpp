@@ -50,6 +50,39 @@ void MultiResponseProbsMessage::set_probs(const TensorObject &probs)
     this->set_output("probs", probs);
 }
 
+std::shared_ptr<MultiResponseProbsMessage> MultiResponseProbsMessage::get_slice(size_t start, size_t stop) const
+{
+    // This can only cast down
+    return std::static_pointer_cast<MultiResponseProbsMessage>(this->internal_get_slice(start, stop));
+}
+
+std::vector<std::shared_ptr<MultiResponseProbsMessage>> MultiResponseProbsMessage::get_slices(
+    const std::vector<std::pair<size_t, size_t>> &ranges) const
+{
+    std::vector<MultiResponseProbsMessage> slices;
+    slices.reserve(ranges.size());
+
+    for (const auto &[start, stop] : ranges)
+    {
+        slices.emplace_back(this->make_slice(start, stop));
+    }
+
+    return share_slices(std::move(slices));
+}
+
+std::shared_ptr<MultiMessage> MultiResponseProbsMessage::internal_get_slice(size_t start, size_t stop) const
+{
+    return std::make_shared<MultiResponseProbsMessage>(this->make_slice(start, stop));
+}
+
+MultiResponseProbsMessage MultiResponseProbsMessage::make_slice(size_t start, size_t stop) const
+{
+    auto slice = MultiResponseMessage::make_slice(start, stop);
+
+    return MultiResponseProbsMessage(
+        std::move(slice.meta), slice.mess_offset, slice.mess_count, std::move(slice.memory), slice.offset, slice.count);
+}
+
 /****** MultiResponseProbsMessageInterfaceProxy *************************/
 /**
  * @brief Interface proxy, used to insulate python bindings.
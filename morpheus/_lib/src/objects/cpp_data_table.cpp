@@ -0,0 +1,205 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/objects/cpp_data_table.hpp>
+
+#include <morpheus/objects/python_data_table.hpp>
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/cudf_util.hpp>
+#include <morpheus/utilities/table_util.hpp>
+
+#include <cudf/column/column_view.hpp>
+#include <cudf/filling.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+
+#include <glog/logging.h>
+#include <pybind11/gil.h>
+#include <pybind11/pytypes.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+/****** Component-private classes **************************/
+/****** CppDataTable__Live *********************************/
+    struct CppDataTable__Live {
+        std::atomic<std::size_t> device_bytes{0};
+        std::atomic<std::size_t> count{0};
+    };
+
+    static CppDataTable__Live &CppDataTable__live() {
+        static CppDataTable__Live live;
+        return live;
+    }
+
+/****** Component public implementations *******************/
+/****** CppDataTable****************************************/
+    CppDataTable::CppDataTable(cudf::io::table_with_metadata &&table, int index_col_count) :
+            m_table(std::move(table.tbl)),
+            m_metadata(std::move(table.metadata)),
+            m_index_col_count(index_col_count),
+            m_num_rows(m_table->num_rows()) {
+        if (m_index_col_count == 0) {
+            m_range_index = cudf::sequence(m_num_rows, cudf::numeric_scalar<int64_t>(0));
+        }
+
+        m_device_bytes = CuDFTableUtil::device_bytes(m_table->view()) +
+                         (m_range_index ? CuDFTableUtil::device_bytes(m_range_index->view()) : 0);
+
+        auto &live = CppDataTable__live();
+        live.device_bytes += m_device_bytes;
+        ++live.count;
+    }
+
+    CppDataTable::~CppDataTable() {
+        auto &live = CppDataTable__live();
+        live.device_bytes -= m_device_bytes;
+        --live.count;
+
+        if (m_py_table) {
+            pybind11::gil_scoped_acquire gil;
+
+            // Clear out the python object
+            m_py_table = pybind11::object();
+        }
+    }
+
+    cudf::size_type CppDataTable::count() const {
+        if (this->is_python()) {
+            pybind11::gil_scoped_acquire gil;
+            return m_py_table.attr("_num_rows").cast<cudf::size_type>();
+        }
+
+        return m_num_rows;
+    }
+
+    TableInfo CppDataTable::get_info() const {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_table) {
+                std::vector<cudf::column_view> columns;
+
+                if (m_range_index) {
+                    columns.push_back(m_range_index->view());
+                }
+
+                auto table_view = m_table->view();
+                columns.insert(columns.end(), table_view.begin(), table_view.end());
+
+                if (!m_schema) {
+                    std::vector<std::string> index_names;
+                    std::vector<std::string> column_names;
+
+                    if (m_range_index) {
+                        index_names.emplace_back("");
+                    }
+
+                    auto const &names = m_metadata.column_names;
+                    index_names.insert(index_names.end(), names.begin(), names.begin() + m_index_col_count);
+                    column_names.insert(column_names.end(), names.begin() + m_index_col_count, names.end());
+
+                    m_schema = std::make_shared<TableSchema>(std::move(index_names), std::move(column_names));
+                }
+
+                return TableInfo(this->shared_from_this(), cudf::table_view(columns), m_schema);
+            }
+        }
+
+        // Already moved into Python, get the info from there
+        pybind11::gil_scoped_acquire gil;
+
+        return proxy_table_info_from_table(m_py_table, this->shared_from_this());
+    }
+
+    const pybind11::object &CppDataTable::get_py_object() const {
+        // Always take the GIL first to avoid a lock order inversion with m_mutex
+        pybind11::gil_scoped_acquire gil;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_table) {
+            // Moves the device memory into the Python columns, existing views remain valid
+            cudf::io::table_with_metadata table{std::move(m_table), m_metadata};
+
+            m_py_table = proxy_table_from_table_with_metadata(std::move(table), m_index_col_count);
+        }
+
+        return m_py_table;
+    }
+
+    void CppDataTable::insert_columns(const std::vector<std::string> &column_names,
+                                      const std::vector<TypeId> &column_types) const {
+        CHECK(column_names.size() == column_types.size());
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_table) {
+                // Releasing the columns does not move their device memory, existing views remain valid
+                auto columns = m_table->release();
+
+                std::size_t inserted_bytes = 0;
+
+                for (std::size_t i = 0; i < column_names.size(); ++i) {
+                    columns.emplace_back(CuDFTableUtil::make_zeroed_column(column_types[i], m_num_rows));
+                    m_metadata.column_names.push_back(column_names[i]);
+                    inserted_bytes += CuDFTableUtil::device_bytes(columns.back()->view());
+                }
+
+                m_device_bytes += inserted_bytes;
+                CppDataTable__live().device_bytes += inserted_bytes;
+
+                m_table = std::make_unique<cudf::table>(std::move(columns));
+
+                // Views taken before this call keep the old schema
+                m_schema.reset();
+
+                return;
+            }
+        }
+
+        // Already moved into Python. Safe to check without the lock since the table never moves back
+        pybind11::gil_scoped_acquire gil;
+
+        insert_py_columns(m_py_table, column_names, column_types);
+    }
+
+    std::size_t CppDataTable::device_bytes() const {
+        return m_device_bytes;
+    }
+
+    bool CppDataTable::is_python() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_table == nullptr;
+    }
+
+    std::size_t CppDataTable::live_device_bytes() {
+        return CppDataTable__live().device_bytes;
+    }
+
+    std::size_t CppDataTable::live_count() {
+        return CppDataTable__live().count;
+    }
+}  // namespace morpheus
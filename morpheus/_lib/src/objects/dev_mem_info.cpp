@@ -23,4 +23,8 @@ namespace morpheus {
     void *DevMemInfo::data() const {
         return static_cast<uint8_t *>(buffer->data()) + offset;
     }
+
+    rmm::cuda_stream_view DevMemInfo::stream() const {
+        return buffer->stream();
+    }
 }
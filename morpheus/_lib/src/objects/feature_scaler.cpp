@@ -0,0 +1,92 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/objects/feature_scaler.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+    // Component public implementations
+    // ************ FeatureScaler ************************* //
+    std::shared_ptr<FeatureScaler> FeatureScaler::load_json(const std::string &filename) {
+        std::ifstream file(filename);
+
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open feature scaling file '" + filename + "'");
+        }
+
+        auto scaler = std::shared_ptr<FeatureScaler>(new FeatureScaler());
+
+        try {
+            auto doc = nlohmann::json::parse(file);
+
+            for (const auto &[name, stats]: doc.at("features").items()) {
+                double shift = 0;
+                double range = 0;
+
+                if (stats.contains("mean") && stats.contains("std")) {
+                    shift = stats.at("mean").get<double>();
+                    range = stats.at("std").get<double>();
+                } else if (stats.contains("min") && stats.contains("max")) {
+                    shift = stats.at("min").get<double>();
+                    range = stats.at("max").get<double>() - shift;
+                } else {
+                    throw std::runtime_error("Feature '" + name + "' needs either 'mean' and 'std' or 'min' and 'max'");
+                }
+
+                const auto scale = range != 0 ? 1.0 / range : 1.0;
+
+                scaler->m_coefficients[name] = std::make_pair(static_cast<float>(shift), static_cast<float>(scale));
+            }
+        } catch (const nlohmann::json::exception &e) {
+            throw std::runtime_error("Unable to parse feature scaling file '" + filename + "': " + e.what());
+        }
+
+        return scaler;
+    }
+
+    std::vector<float> FeatureScaler::shift(const std::vector<std::string> &columns) const {
+        std::vector<float> result;
+        result.reserve(columns.size());
+
+        for (const auto &column: columns) {
+            auto found = m_coefficients.find(column);
+            result.push_back(found != m_coefficients.end() ? found->second.first : 0.0f);
+        }
+
+        return result;
+    }
+
+    std::vector<float> FeatureScaler::scale(const std::vector<std::string> &columns) const {
+        std::vector<float> result;
+        result.reserve(columns.size());
+
+        for (const auto &column: columns) {
+            auto found = m_coefficients.find(column);
+            result.push_back(found != m_coefficients.end() ? found->second.second : 1.0f);
+        }
+
+        return result;
+    }
+}  // namespace morpheus
@@ -17,158 +17,413 @@
 
 #include <morpheus/objects/fiber_queue.hpp>
 
+#include <morpheus/messages/meta.hpp>
+
 #include <boost/fiber/channel_op_status.hpp>
 
 #include <pybind11/pytypes.h>
 
 #include <chrono>
 #include <memory>
+#include <optional>
+#include <stdexcept>
 #include <utility>
+#include <vector>
 
 
 namespace morpheus {
-    /****** Component public implementations *******************/
-    /****** FiberQueue****************************************/
-    FiberQueue::FiberQueue(size_t max_size)  : m_queue(max_size) {}
+    // Component-private free functions.
+    // ************ FiberQueue__ ************ //
+    static std::chrono::microseconds FiberQueue__timeout(float timeout) {
+        // Microseconds, so fractional timeouts are not truncated to whole seconds
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<float>(timeout));
+    }
 
-    boost::fibers::channel_op_status FiberQueue::put(pybind11::object &&item, bool block, float timeout)  {
-        if (!block) {
-            return m_queue.try_push(std::move(item));
-        } else if (timeout > 0.0) {
-            return m_queue.push_wait_for(
-                    std::move(item),
-                    std::chrono::duration_cast<std::chrono::seconds>(std::chrono::duration<float>(timeout)));
-        } else {
-            // Blocking no timeout
-            return m_queue.push(std::move(item));
+    static std::optional<std::chrono::steady_clock::time_point> FiberQueue__deadline(bool block,
+                                                                                     std::optional<float> timeout) {
+        if (!block || !timeout.has_value()) {
+            return std::nullopt;
         }
-    }
 
-    boost::fibers::channel_op_status FiberQueue::get(pybind11::object &item, bool block, float timeout)  {
-        if (!block) {
-            return m_queue.try_pop(std::ref(item));
-        } else if (timeout > 0.0) {
-            return m_queue.pop_wait_for(
-                    std::ref(item),
-                    std::chrono::duration_cast<std::chrono::seconds>(std::chrono::duration<float>(timeout)));
-        } else {
-            // Blocking no timeout
-            return m_queue.pop(std::ref(item));
+        if (*timeout < 0.0) {
+            throw std::invalid_argument("'timeout' must be a non-negative number");
         }
-    }
 
-    void FiberQueue::close()  {
-        m_queue.close();
-    }
+        // Zero has always meant waiting until the call can complete, callers pass `block=False` to not wait
+        if (*timeout == 0.0) {
+            return std::nullopt;
+        }
 
-    bool FiberQueue::is_closed()  {
-        return m_queue.is_closed();
+        return std::chrono::steady_clock::now() + FiberQueue__timeout(*timeout);
     }
 
-    void FiberQueue::join()  {
-        // TODO(MDD): Not sure how to join a buffered channel
+    /**
+     * @brief Raises the python exception matching a failed channel operation, queue.Full and queue.Empty like the
+     * standard library queues, or Closed.
+     */
+    [[noreturn]] static void FiberQueue__raise(boost::fibers::channel_op_status status, bool is_put) {
+        const char *module = "queue";
+        const char *name = "Empty";
+
+        switch (status) {
+            case boost::fibers::channel_op_status::empty:
+                break;
+            case boost::fibers::channel_op_status::full:
+            case boost::fibers::channel_op_status::timeout:
+                name = is_put ? "Full" : "Empty";
+                break;
+            case boost::fibers::channel_op_status::closed:
+                module = "morpheus.utils.producer_consumer_queue";
+                name = "Closed";
+                break;
+            default:
+                throw std::runtime_error("Unknown channel status");
+        }
+
+        pybind11::object exc_class = pybind11::module_::import(module).attr(name);
+
+        PyErr_SetNone(exc_class.ptr());
+
+        throw pybind11::error_already_set();
     }
 
-    /****** FiberQueueInterfaceProxy *************************/
-    std::shared_ptr<morpheus::FiberQueue> FiberQueueInterfaceProxy::init(std::size_t max_size) {
-        if (max_size < 2 || ((max_size & (max_size - 1)) != 0)) {
-            throw std::invalid_argument("max_size must be greater than 1 and a power of 2.");
+    template<typename ItemT>
+    static void FiberQueue__put(TypedFiberQueue<ItemT> &self, ItemT &&item, bool block, std::optional<float> timeout) {
+        auto deadline = FiberQueue__deadline(block, timeout);
+
+        boost::fibers::channel_op_status status;
+
+        // Release the GIL and try to move it
+        {
+            pybind11::gil_scoped_release nogil;
+
+            status = deadline ? self.put_until(std::move(item), *deadline) : self.put(std::move(item), block);
         }
 
-        // Create a new shared_ptr
-        return std::make_shared<morpheus::FiberQueue>(max_size);
+        if (status != boost::fibers::channel_op_status::success) {
+            FiberQueue__raise(status, true);
+        }
     }
 
-    void FiberQueueInterfaceProxy::put(morpheus::FiberQueue &self, pybind11::object item, bool block, float timeout) {
+    template<typename ItemT>
+    static ItemT FiberQueue__get(TypedFiberQueue<ItemT> &self, bool block, std::optional<float> timeout) {
+        auto deadline = FiberQueue__deadline(block, timeout);
+
         boost::fibers::channel_op_status status;
 
+        ItemT item;
+
         // Release the GIL and try to move it
         {
             pybind11::gil_scoped_release nogil;
 
-            status = self.put(std::move(item), block, timeout);
+            status = deadline ? self.get_until(item, *deadline) : self.get(item, block);
         }
 
-        switch (status) {
-            case boost::fibers::channel_op_status::success:
-                return;
-            case boost::fibers::channel_op_status::empty: {
-                // Raise queue.Empty
-                pybind11::object exc_class = pybind11::module_::import("queue").attr("Empty");
+        if (status != boost::fibers::channel_op_status::success) {
+            FiberQueue__raise(status, false);
+        }
 
-                PyErr_SetNone(exc_class.ptr());
+        return item;
+    }
 
-                throw pybind11::error_already_set();
-            }
-            case boost::fibers::channel_op_status::full:
-            case boost::fibers::channel_op_status::timeout: {
-                // Raise queue.Full
-                pybind11::object exc_class = pybind11::module_::import("queue").attr("Empty");
+    template<typename ItemT>
+    static std::size_t FiberQueue__put_many(TypedFiberQueue<ItemT> &self,
+                                            pybind11::iterable items,
+                                            bool block,
+                                            std::optional<float> timeout) {
+        auto deadline = FiberQueue__deadline(block, timeout);
 
-                PyErr_SetNone(exc_class.ptr());
+        // Convert while holding the GIL, so the queue only ever moves items
+        std::vector<ItemT> batch;
 
-                throw pybind11::error_already_set();
-            }
-            case boost::fibers::channel_op_status::closed: {
-                // Raise queue.Full
-                pybind11::object exc_class = pybind11::module_::import(
-                        "morpheus.utils.producer_consumer_queue").attr("Closed");
+        for (auto item: items) {
+            batch.emplace_back(item.template cast<ItemT>());
+        }
 
-                PyErr_SetNone(exc_class.ptr());
+        boost::fibers::channel_op_status status;
+        std::size_t put_count = 0;
 
-                throw pybind11::error_already_set();
-            }
+        {
+            pybind11::gil_scoped_release nogil;
+
+            status = deadline ? self.put_many_until(batch, put_count, *deadline)
+                              : self.put_many(batch, put_count, block);
         }
 
+        if (put_count == 0 && !batch.empty() && status != boost::fibers::channel_op_status::success) {
+            FiberQueue__raise(status, true);
+        }
+
+        return put_count;
     }
 
-    pybind11::object FiberQueueInterfaceProxy::get(morpheus::FiberQueue &self, bool block, float timeout) {
+    template<typename ItemT>
+    static pybind11::list FiberQueue__get_many(TypedFiberQueue<ItemT> &self,
+                                               std::size_t max_items,
+                                               bool block,
+                                               std::optional<float> timeout) {
+        if (max_items == 0) {
+            throw std::invalid_argument("max_items must be greater than 0.");
+        }
+
+        auto deadline = FiberQueue__deadline(block, timeout);
+
         boost::fibers::channel_op_status status;
 
-        pybind11::object item;
+        std::vector<ItemT> batch;
 
-        // Release the GIL and try to move it
         {
             pybind11::gil_scoped_release nogil;
 
-            status = self.get(std::ref(item), block, timeout);
+            status = deadline ? self.get_many_until(batch, max_items, *deadline)
+                              : self.get_many(batch, max_items, block);
         }
 
-        switch (status) {
-            case boost::fibers::channel_op_status::success:
-                return item;
-            case boost::fibers::channel_op_status::empty: {
-                // Raise queue.Empty
-                pybind11::object exc_class = pybind11::module_::import("queue").attr("Empty");
+        if (status != boost::fibers::channel_op_status::success) {
+            FiberQueue__raise(status, false);
+        }
 
-                PyErr_SetNone(exc_class.ptr());
+        pybind11::list result;
 
-                throw pybind11::error_already_set();
-            }
-            case boost::fibers::channel_op_status::full:
-            case boost::fibers::channel_op_status::timeout: {
-                // Raise queue.Full
-                pybind11::object exc_class = pybind11::module_::import("queue").attr("Empty");
+        for (auto &item: batch) {
+            result.append(pybind11::cast(std::move(item)));
+        }
+
+        return result;
+    }
+
+    /****** Component public implementations *******************/
+    /****** TypedFiberQueue***********************************/
+    template<typename ItemT>
+    TypedFiberQueue<ItemT>::TypedFiberQueue(size_t max_size)  : m_queue(max_size) {}
 
-                PyErr_SetNone(exc_class.ptr());
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::put(ItemT &&item, bool block, float timeout)  {
+        return this->push(std::move(item), block, FiberQueue__deadline(block && timeout > 0.0, timeout));
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::get(ItemT &item, bool block, float timeout)  {
+        return this->pop(item, block, FiberQueue__deadline(block && timeout > 0.0, timeout));
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::put_until(ItemT &&item, clock_t::time_point deadline) {
+        return this->push(std::move(item), true, deadline);
+    }
 
-                throw pybind11::error_already_set();
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::get_until(ItemT &item, clock_t::time_point deadline) {
+        return this->pop(item, true, deadline);
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::put_many(std::vector<ItemT> &items,
+                                                                      std::size_t &put_count,
+                                                                      bool block,
+                                                                      float timeout) {
+        // The timeout covers the whole batch rather than each item
+        return this->push_many(items, put_count, block, FiberQueue__deadline(block && timeout > 0.0, timeout));
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::put_many_until(std::vector<ItemT> &items,
+                                                                            std::size_t &put_count,
+                                                                            clock_t::time_point deadline) {
+        return this->push_many(items, put_count, true, deadline);
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::get_many(std::vector<ItemT> &items,
+                                                                      std::size_t max_items,
+                                                                      bool block,
+                                                                      float timeout) {
+        return this->pop_many(items, max_items, block, FiberQueue__deadline(block && timeout > 0.0, timeout));
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::get_many_until(std::vector<ItemT> &items,
+                                                                            std::size_t max_items,
+                                                                            clock_t::time_point deadline) {
+        return this->pop_many(items, max_items, true, deadline);
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::push(ItemT &&item,
+                                                                  bool block,
+                                                                  const std::optional<clock_t::time_point> &deadline) {
+        if (!block) {
+            return m_queue.try_push(std::move(item));
+        } else if (deadline) {
+            return m_queue.push_wait_until(std::move(item), *deadline);
+        } else {
+            // Blocking no timeout
+            return m_queue.push(std::move(item));
+        }
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::pop(ItemT &item,
+                                                                 bool block,
+                                                                 const std::optional<clock_t::time_point> &deadline) {
+        if (!block) {
+            return m_queue.try_pop(std::ref(item));
+        } else if (deadline) {
+            return m_queue.pop_wait_until(std::ref(item), *deadline);
+        } else {
+            // Blocking no timeout
+            return m_queue.pop(std::ref(item));
+        }
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::push_many(
+            std::vector<ItemT> &items,
+            std::size_t &put_count,
+            bool block,
+            const std::optional<clock_t::time_point> &deadline) {
+        put_count = 0;
+
+        for (auto &item: items) {
+            auto status = this->push(std::move(item), block, deadline);
+
+            if (status != boost::fibers::channel_op_status::success) {
+                return status;
             }
-            case boost::fibers::channel_op_status::closed: {
-                // Raise queue.Full
-                pybind11::object exc_class = pybind11::module_::import(
-                        "morpheus.utils.producer_consumer_queue").attr("Closed");
 
-                PyErr_SetNone(exc_class.ptr());
+            ++put_count;
+        }
+
+        return boost::fibers::channel_op_status::success;
+    }
+
+    template<typename ItemT>
+    boost::fibers::channel_op_status TypedFiberQueue<ItemT>::pop_many(
+            std::vector<ItemT> &items,
+            std::size_t max_items,
+            bool block,
+            const std::optional<clock_t::time_point> &deadline) {
+        ItemT item;
+
+        auto status = this->pop(item, block, deadline);
+
+        if (status != boost::fibers::channel_op_status::success) {
+            return status;
+        }
+
+        items.emplace_back(std::move(item));
 
-                throw pybind11::error_already_set();
+        // Only wait for the first item, take whatever else is already queued
+        for (std::size_t taken = 1; taken < max_items; ++taken) {
+            ItemT next;
+
+            if (m_queue.try_pop(std::ref(next)) != boost::fibers::channel_op_status::success) {
+                break;
             }
-            default:
-                throw std::runtime_error("Unknown channel status");
+
+            items.emplace_back(std::move(next));
         }
+
+        return status;
+    }
+
+    template<typename ItemT>
+    void TypedFiberQueue<ItemT>::close()  {
+        m_queue.close();
+    }
+
+    template<typename ItemT>
+    bool TypedFiberQueue<ItemT>::is_closed()  {
+        return m_queue.is_closed();
+    }
+
+    template<typename ItemT>
+    void TypedFiberQueue<ItemT>::join()  {
+        // TODO(MDD): Not sure how to join a buffered channel
+    }
+
+    template class TypedFiberQueue<pybind11::object>;
+    template class TypedFiberQueue<std::shared_ptr<MessageMeta>>;
+
+    /****** FiberQueueInterfaceProxy *************************/
+    std::shared_ptr<morpheus::FiberQueue> FiberQueueInterfaceProxy::init(std::size_t max_size) {
+        if (max_size < 2 || ((max_size & (max_size - 1)) != 0)) {
+            throw std::invalid_argument("max_size must be greater than 1 and a power of 2.");
+        }
+
+        // Create a new shared_ptr
+        return std::make_shared<morpheus::FiberQueue>(max_size);
+    }
+
+    void FiberQueueInterfaceProxy::put(morpheus::FiberQueue &self,
+                                       pybind11::object item,
+                                       bool block,
+                                       std::optional<float> timeout) {
+        FiberQueue__put(self, std::move(item), block, timeout);
+    }
+
+    pybind11::object FiberQueueInterfaceProxy::get(morpheus::FiberQueue &self,
+                                                   bool block,
+                                                   std::optional<float> timeout) {
+        return FiberQueue__get(self, block, timeout);
+    }
+
+    std::size_t FiberQueueInterfaceProxy::put_many(morpheus::FiberQueue &self,
+                                                   pybind11::iterable items,
+                                                   bool block,
+                                                   std::optional<float> timeout) {
+        return FiberQueue__put_many(self, std::move(items), block, timeout);
+    }
+
+    pybind11::list FiberQueueInterfaceProxy::get_many(morpheus::FiberQueue &self,
+                                                      std::size_t max_items,
+                                                      bool block,
+                                                      std::optional<float> timeout) {
+        return FiberQueue__get_many(self, max_items, block, timeout);
     }
 
     void FiberQueueInterfaceProxy::close(morpheus::FiberQueue &self) {
         self.close();
     }
+
+    /****** MessageMetaFiberQueueInterfaceProxy **************/
+    std::shared_ptr<morpheus::MessageMetaFiberQueue> MessageMetaFiberQueueInterfaceProxy::init(std::size_t max_size) {
+        if (max_size < 2 || ((max_size & (max_size - 1)) != 0)) {
+            throw std::invalid_argument("max_size must be greater than 1 and a power of 2.");
+        }
+
+        return std::make_shared<morpheus::MessageMetaFiberQueue>(max_size);
+    }
+
+    void MessageMetaFiberQueueInterfaceProxy::put(morpheus::MessageMetaFiberQueue &self,
+                                                  std::shared_ptr<MessageMeta> item,
+                                                  bool block,
+                                                  std::optional<float> timeout) {
+        FiberQueue__put(self, std::move(item), block, timeout);
+    }
+
+    std::shared_ptr<MessageMeta> MessageMetaFiberQueueInterfaceProxy::get(morpheus::MessageMetaFiberQueue &self,
+                                                                           bool block,
+                                                                           std::optional<float> timeout) {
+        return FiberQueue__get(self, block, timeout);
+    }
+
+    std::size_t MessageMetaFiberQueueInterfaceProxy::put_many(morpheus::MessageMetaFiberQueue &self,
+                                                              pybind11::iterable items,
+                                                              bool block,
+                                                              std::optional<float> timeout) {
+        return FiberQueue__put_many(self, std::move(items), block, timeout);
+    }
+
+    pybind11::list MessageMetaFiberQueueInterfaceProxy::get_many(morpheus::MessageMetaFiberQueue &self,
+                                                                 std::size_t max_items,
+                                                                 bool block,
+                                                                 std::optional<float> timeout) {
+        return FiberQueue__get_many(self, max_items, block, timeout);
+    }
+
+    void MessageMetaFiberQueueInterfaceProxy::close(morpheus::MessageMetaFiberQueue &self) {
+        self.close();
+    }
 }
@@ -36,9 +36,16 @@ morpheus::FileTypes morpheus::determine_file_type(const std::string &filename) {
         return FileTypes::JSON;
     } else if (filename_path.extension() == ".csv") {
         return FileTypes::CSV;
+    } else if (filename_path.extension() == ".parquet") {
+        return FileTypes::PARQUET;
+    } else if (filename_path.extension() == ".orc") {
+        return FileTypes::ORC;
+    } else if (filename_path.extension() == ".arrow" || filename_path.extension() == ".feather") {
+        return FileTypes::ARROW;
     } else {
         throw std::runtime_error(CONCAT_STR("Unsupported extension '"
                                                     << filename_path.extension()
-                                                    << "' with 'auto' type. 'auto' only works with: csv, json"));
+                                                    << "' with 'auto' type. 'auto' only works with: csv, json, "
+                                                       "parquet, orc, arrow"));
     }
 }
\ No newline at end of file
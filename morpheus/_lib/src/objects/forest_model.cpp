@@ -0,0 +1,225 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/objects/forest_model.hpp>
+
+#include <morpheus/objects/tensor.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
+
+#include <nlohmann/json.hpp>
+#include <rmm/cuda_stream_view.hpp>
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+    // Component-private free functions.
+    // ************ ForestModel__parse_number ************ //
+    /**
+     * @brief XGBoost writes the model parameters as strings (i.e. `"5E-1"`), and newer versions wrap `base_score` in
+     * brackets (`"[5E-1]"`)
+     */
+    static double ForestModel__parse_number(const nlohmann::json &value) {
+        if (value.is_number()) {
+            return value.get<double>();
+        }
+
+        auto str = value.get<std::string>();
+
+        if (str.size() >= 2 && str.front() == '[' && str.back() == ']') {
+            str = str.substr(1, str.size() - 2);
+        }
+
+        return std::stod(str);
+    }
+
+    static std::unique_ptr<rmm::device_buffer> ForestModel__to_device(const void *data, std::size_t bytes) {
+        auto buffer = std::make_unique<rmm::device_buffer>(data, bytes, rmm::cuda_stream_per_thread);
+
+        // The host vectors are released once loading returns
+        rmm::cuda_stream_per_thread.synchronize();
+
+        return buffer;
+    }
+
+    // Component public implementations
+    // ************ ForestModel ************************* //
+    std::shared_ptr<ForestModel> ForestModel::load_xgboost_json(const std::string &filename) {
+        std::ifstream file(filename);
+
+        if (!file.is_open()) {
+            throw std::runtime_error("Unable to open forest model file '" + filename + "'");
+        }
+
+        auto model = std::shared_ptr<ForestModel>(new ForestModel());
+
+        std::vector<ForestNode> nodes;
+        std::vector<int32_t> tree_roots;
+        std::vector<int32_t> tree_outputs;
+
+        try {
+            auto doc = nlohmann::json::parse(file);
+
+            const auto &learner = doc.at("learner");
+            const auto &booster = learner.at("gradient_booster");
+            const auto &params = learner.at("learner_model_param");
+
+            const auto booster_name = booster.at("name").get<std::string>();
+            const auto objective = learner.at("objective").at("name").get<std::string>();
+
+            if (booster_name != "gbtree") {
+                throw std::runtime_error("Unsupported booster '" + booster_name + "'. Only 'gbtree' is supported");
+            }
+
+            model->m_num_features = static_cast<std::size_t>(ForestModel__parse_number(params.at("num_feature")));
+            // 0 for binary and regression models
+            const auto num_class = static_cast<std::size_t>(ForestModel__parse_number(params.at("num_class")));
+            model->m_num_outputs = std::max<std::size_t>(1, num_class);
+
+            const auto base_score = ForestModel__parse_number(params.at("base_score"));
+
+            if (objective == "binary:logistic" || objective == "binary:logitraw") {
+                // The base score is a probability, margins are summed in logit space
+                model->m_base_margin = static_cast<float>(std::log(base_score / (1.0 - base_score)));
+                model->m_sigmoid = objective == "binary:logistic";
+            } else if (objective == "reg:squarederror" || objective == "reg:linear") {
+                model->m_base_margin = static_cast<float>(base_score);
+            } else if (objective == "multi:softprob" || objective == "multi:softmax") {
+                model->m_base_margin = static_cast<float>(base_score);
+                model->m_softmax = true;
+            } else {
+                throw std::runtime_error("Unsupported objective '" + objective + "'");
+            }
+
+            const auto &gbtree = booster.at("model");
+            const auto &trees = gbtree.at("trees");
+            const auto &tree_info = gbtree.at("tree_info");
+
+            for (std::size_t tree_idx = 0; tree_idx < trees.size(); ++tree_idx) {
+                const auto &tree = trees[tree_idx];
+
+                const auto &left_children = tree.at("left_children");
+                const auto &right_children = tree.at("right_children");
+                const auto &split_indices = tree.at("split_indices");
+                const auto &split_conditions = tree.at("split_conditions");
+                const auto &default_left = tree.at("default_left");
+
+                const auto root = static_cast<int32_t>(nodes.size());
+                const auto tree_output = tree_info.at(tree_idx).get<int32_t>();
+
+                if (tree_output < 0 || static_cast<std::size_t>(tree_output) >= model->m_num_outputs) {
+                    throw std::runtime_error("Tree " + std::to_string(tree_idx) + " has an invalid output group");
+                }
+
+                const auto num_nodes = static_cast<int32_t>(left_children.size());
+
+                for (int32_t node_idx = 0; node_idx < num_nodes; ++node_idx) {
+                    const auto left = left_children.at(node_idx).get<int32_t>();
+
+                    // Leaves store their value in the split condition
+                    ForestNode node{-1, split_conditions.at(node_idx).get<float>(), -1, -1, -1};
+
+                    if (left >= 0) {
+                        const auto right = right_children.at(node_idx).get<int32_t>();
+                        const auto &is_default_left = default_left.at(node_idx);
+                        const bool goes_left = is_default_left.is_boolean() ? is_default_left.get<bool>()
+                                                                            : is_default_left.get<int>() != 0;
+
+                        node.feature = split_indices.at(node_idx).get<int32_t>();
+                        node.left = root + left;
+                        node.right = root + right;
+                        node.missing = goes_left ? node.left : node.right;
+
+                        if (left >= num_nodes || right < 0 || right >= num_nodes ||
+                            node.feature < 0 || static_cast<std::size_t>(node.feature) >= model->m_num_features) {
+                            throw std::runtime_error("Tree " + std::to_string(tree_idx) + " is malformed");
+                        }
+                    }
+
+                    nodes.push_back(node);
+                }
+
+                tree_roots.push_back(root);
+                tree_outputs.push_back(tree_output);
+            }
+        } catch (const nlohmann::json::exception &e) {
+            throw std::runtime_error("Unable to parse XGBoost model '" + filename + "': " + e.what());
+        }
+
+        model->m_num_trees = tree_roots.size();
+
+        if (model->m_num_trees == 0) {
+            throw std::runtime_error("XGBoost model '" + filename + "' does not contain any trees");
+        }
+
+        model->m_nodes = ForestModel__to_device(nodes.data(), nodes.size() * sizeof(ForestNode));
+        model->m_tree_roots = ForestModel__to_device(tree_roots.data(), tree_roots.size() * sizeof(int32_t));
+        model->m_tree_outputs = ForestModel__to_device(tree_outputs.data(), tree_outputs.size() * sizeof(int32_t));
+
+        LOG(INFO) << "Loaded forest model '" << filename << "' with " << model->m_num_trees << " trees, "
+                  << nodes.size() << " nodes and " << model->m_num_features << " features";
+
+        return model;
+    }
+
+    std::size_t ForestModel::num_features() const {
+        return m_num_features;
+    }
+
+    std::size_t ForestModel::num_outputs() const {
+        return m_num_outputs;
+    }
+
+    TensorObject ForestModel::predict(const TensorObject &input) const {
+        CHECK(input.rank() == 2 && static_cast<std::size_t>(input.shape(1)) >= m_num_features)
+                << "Forest model expects a 2D input with at least " << m_num_features << " columns";
+
+        const auto rows = input.shape(0);
+        const auto cols = static_cast<TensorIndex>(m_num_outputs);
+
+        auto output = Tensor::create(MatxUtil::predict_forest(input,
+                                                              static_cast<const ForestNode *>(m_nodes->data()),
+                                                              static_cast<const int32_t *>(m_tree_roots->data()),
+                                                              static_cast<const int32_t *>(m_tree_outputs->data()),
+                                                              m_num_trees,
+                                                              m_num_outputs,
+                                                              m_base_margin,
+                                                              m_sigmoid),
+                                     DType::create<float>(),
+                                     std::vector<TensorIndex>{rows, cols},
+                                     std::vector<TensorIndex>{},
+                                     0);
+
+        if (!m_softmax) {
+            return output;
+        }
+
+        return Tensor::create(MatxUtil::softmax(output),
+                              DType::create<float>(),
+                              std::vector<TensorIndex>{rows, cols},
+                              std::vector<TensorIndex>{},
+                              0);
+    }
+}  // namespace morpheus
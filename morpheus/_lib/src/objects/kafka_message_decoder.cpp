@@ -0,0 +1,383 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/objects/kafka_message_decoder.hpp>
+
+#include <cudf/concatenate.hpp>
+#include <cudf/io/avro.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+
+#include <glog/logging.h>
+#include <librdkafka/rdkafkacpp.h>
+#include <netdb.h>
+#include <nlohmann/json.hpp>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Written between the header and the data block of every container, the reader only checks that they match
+constexpr char AvroSyncMarker[] = "MorpheusAvroSync";
+constexpr std::size_t AvroSyncMarkerBytes = 16;
+
+// Magic byte and big endian schema id written by the Confluent serializers in front of every datum
+constexpr std::size_t ConfluentFramingBytes = 5;
+
+// Component-private free functions.
+// ************ KafkaAvroDecoder__ ************ //
+static void KafkaAvroDecoder__write_long(std::string &out, int64_t value)
+{
+    // Zig-zag then variable length encoding
+    auto encoded = (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+
+    while (encoded >= 0x80)
+    {
+        out.push_back(static_cast<char>((encoded & 0x7f) | 0x80));
+        encoded >>= 7;
+    }
+
+    out.push_back(static_cast<char>(encoded));
+}
+
+static void KafkaAvroDecoder__write_bytes(std::string &out, const std::string &value)
+{
+    KafkaAvroDecoder__write_long(out, static_cast<int64_t>(value.size()));
+    out.append(value);
+}
+
+/**
+ * @brief Wraps `count` concatenated datums in an uncompressed Avro object container file holding a single block.
+ */
+static std::string KafkaAvroDecoder__container(const std::string &schema, std::size_t count, const std::string &datums)
+{
+    std::string container{"Obj\x01", 4};
+
+    // File metadata, a map of bytes written as a single block
+    KafkaAvroDecoder__write_long(container, 2);
+    KafkaAvroDecoder__write_bytes(container, "avro.schema");
+    KafkaAvroDecoder__write_bytes(container, schema);
+    KafkaAvroDecoder__write_bytes(container, "avro.codec");
+    KafkaAvroDecoder__write_bytes(container, "null");
+    KafkaAvroDecoder__write_long(container, 0);
+    container.append(AvroSyncMarker, AvroSyncMarkerBytes);
+
+    KafkaAvroDecoder__write_long(container, static_cast<int64_t>(count));
+    KafkaAvroDecoder__write_long(container, static_cast<int64_t>(datums.size()));
+    container.append(datums);
+    container.append(AvroSyncMarker, AvroSyncMarkerBytes);
+
+    return container;
+}
+
+/**
+ * @brief Minimal HTTP/1.0 GET returning the body of a 200 response. Only plain "http://" URLs are supported.
+ */
+static std::string KafkaAvroDecoder__http_get(const std::string &url)
+{
+    const std::string scheme{"http://"};
+
+    if (url.compare(0, scheme.size(), scheme) != 0)
+    {
+        throw std::invalid_argument("Only http:// schema registry URLs are supported, not '" + url + "'");
+    }
+
+    const auto path_start = url.find('/', scheme.size());
+    const auto authority  = url.substr(scheme.size(), path_start - scheme.size());
+    const auto path       = path_start == std::string::npos ? std::string{"/"} : url.substr(path_start);
+
+    const auto separator = authority.rfind(':');
+    const auto host      = authority.substr(0, separator);
+    const auto port      = separator == std::string::npos ? std::string{"80"} : authority.substr(separator + 1);
+
+    addrinfo hints{};
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo *addresses = nullptr;
+
+    if (auto result = getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses); result != 0)
+    {
+        throw std::runtime_error("Unable to resolve '" + authority + "': " + gai_strerror(result));
+    }
+
+    int fd    = -1;
+    int error = 0;
+
+    for (auto *candidate = addresses; candidate != nullptr && fd < 0; candidate = candidate->ai_next)
+    {
+        fd = socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+
+        if (fd >= 0 && connect(fd, candidate->ai_addr, candidate->ai_addrlen) != 0)
+        {
+            error = errno;
+            ::close(fd);
+            fd = -1;
+        }
+        else if (fd < 0)
+        {
+            error = errno;
+        }
+    }
+
+    freeaddrinfo(addresses);
+
+    if (fd < 0)
+    {
+        throw std::runtime_error("Unable to connect to '" + authority + "': " + std::strerror(error));
+    }
+
+    const auto request = "GET " + path + " HTTP/1.0\r\nHost: " + authority +
+                         "\r\nAccept: application/vnd.schemaregistry.v1+json\r\n\r\n";
+
+    std::string response;
+    bool failed = false;
+
+    for (std::size_t sent = 0; sent < request.size() && !failed;)
+    {
+        auto written = ::send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+        failed       = written <= 0;
+        sent += written > 0 ? written : 0;
+    }
+
+    // HTTP/1.0 servers close the connection once the response was written
+    std::array<char, 4096> chunk{};
+
+    while (!failed)
+    {
+        auto received = ::recv(fd, chunk.data(), chunk.size(), 0);
+
+        if (received == 0)
+        {
+            break;
+        }
+
+        failed = received < 0;
+
+        if (!failed)
+        {
+            response.append(chunk.data(), received);
+        }
+    }
+
+    error = errno;
+    ::close(fd);
+
+    if (failed)
+    {
+        throw std::runtime_error("Request to '" + url + "' failed: " + std::strerror(error));
+    }
+
+    const auto status_end = response.find("\r\n");
+    const auto body_start = response.find("\r\n\r\n");
+    const auto status     = response.substr(0, status_end);
+
+    if (body_start == std::string::npos || status.find(" 200") == std::string::npos)
+    {
+        throw std::runtime_error("Request to '" + url + "' failed: " + status);
+    }
+
+    return response.substr(body_start + 4);
+}
+
+// Component public implementations
+// ************ KafkaMessageDecoder ************************* //
+std::shared_ptr<KafkaMessageDecoder> KafkaMessageDecoder::create(const std::string &message_format,
+                                                                 const std::string &avro_schema,
+                                                                 const std::string &schema_registry_url)
+{
+    if (message_format == "json")
+    {
+        return nullptr;
+    }
+
+    if (message_format == "avro")
+    {
+        if (avro_schema.empty())
+        {
+            throw std::invalid_argument("The 'avro' message format requires an Avro schema");
+        }
+
+        return std::make_shared<KafkaAvroDecoder>(avro_schema, "", false);
+    }
+
+    if (message_format == "avro-confluent")
+    {
+        if (avro_schema.empty() && schema_registry_url.empty())
+        {
+            throw std::invalid_argument(
+                "The 'avro-confluent' message format requires an Avro schema or a schema registry URL");
+        }
+
+        return std::make_shared<KafkaAvroDecoder>(avro_schema, schema_registry_url, true);
+    }
+
+    throw std::invalid_argument("Unknown message format '" + message_format +
+                                "'. Must be one of 'json', 'avro' or 'avro-confluent'");
+}
+
+// ************ KafkaAvroDecoder ************************* //
+KafkaAvroDecoder::KafkaAvroDecoder(std::string avro_schema, std::string schema_registry_url, bool confluent_framing) :
+  m_avro_schema(std::move(avro_schema)),
+  m_schema_registry_url(std::move(schema_registry_url)),
+  m_confluent_framing(confluent_framing)
+{
+    while (!m_schema_registry_url.empty() && m_schema_registry_url.back() == '/')
+    {
+        m_schema_registry_url.pop_back();
+    }
+}
+
+cudf::io::table_with_metadata KafkaAvroDecoder::decode(const std::vector<std::unique_ptr<RdKafka::Message>> &messages,
+                                                      std::vector<uint8_t> &message_is_decoded)
+{
+    std::vector<cudf::io::table_with_metadata> tables;
+
+    // Consecutive messages written with the same schema are read as one container
+    int32_t run_schema_id = -1;
+    std::size_t run_count = 0;
+    std::string run_datums;
+
+    auto flush_run = [&]() {
+        if (run_count == 0)
+        {
+            return;
+        }
+
+        auto schema    = m_confluent_framing ? this->writer_schema(run_schema_id) : m_avro_schema;
+        auto container = KafkaAvroDecoder__container(schema, run_count, run_datums);
+
+        auto options =
+            cudf::io::avro_reader_options::builder(cudf::io::source_info(container.data(), container.size())).build();
+
+        tables.emplace_back(cudf::io::read_avro(options));
+
+        run_count = 0;
+        run_datums.clear();
+    };
+
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+        const auto &message = messages[i];
+        const auto *payload = static_cast<const char *>(message->payload());
+        auto length         = message->len();
+
+        if (payload == nullptr)
+        {
+            // Tombstones have no datum
+            message_is_decoded[i] = 0;
+            continue;
+        }
+
+        if (m_confluent_framing)
+        {
+            if (length < ConfluentFramingBytes || payload[0] != 0)
+            {
+                LOG(WARNING) << "Skipping message at offset " << message->offset() << " of '" << message->topic_name()
+                             << "' without the Confluent magic byte";
+                message_is_decoded[i] = 0;
+                continue;
+            }
+
+            const auto *id_bytes = reinterpret_cast<const uint8_t *>(payload + 1);
+            auto schema_id       = static_cast<int32_t>((static_cast<uint32_t>(id_bytes[0]) << 24) |
+                                                  (static_cast<uint32_t>(id_bytes[1]) << 16) |
+                                                  (static_cast<uint32_t>(id_bytes[2]) << 8) | id_bytes[3]);
+
+            if (schema_id != run_schema_id)
+            {
+                flush_run();
+                run_schema_id = schema_id;
+            }
+
+            payload += ConfluentFramingBytes;
+            length -= ConfluentFramingBytes;
+        }
+
+        run_datums.append(payload, length);
+        ++run_count;
+    }
+
+    flush_run();
+
+    if (tables.size() <= 1)
+    {
+        return tables.empty() ? cudf::io::table_with_metadata{} : std::move(tables.front());
+    }
+
+    std::vector<cudf::table_view> views;
+
+    for (const auto &table : tables)
+    {
+        if (table.metadata.column_names != tables.front().metadata.column_names)
+        {
+            throw std::runtime_error("Messages of a batch were written with Avro schemas having different fields");
+        }
+
+        views.push_back(table.tbl->view());
+    }
+
+    return cudf::io::table_with_metadata{cudf::concatenate(views), std::move(tables.front().metadata)};
+}
+
+std::string KafkaAvroDecoder::writer_schema(int32_t schema_id)
+{
+    if (m_schema_registry_url.empty())
+    {
+        return m_avro_schema;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto found = m_schemas.find(schema_id);
+
+    if (found != m_schemas.end())
+    {
+        return found->second;
+    }
+
+    auto body = KafkaAvroDecoder__http_get(m_schema_registry_url + "/schemas/ids/" + std::to_string(schema_id));
+
+    std::string schema;
+
+    try
+    {
+        schema = nlohmann::json::parse(body).at("schema").get<std::string>();
+    } catch (const nlohmann::json::exception &e)
+    {
+        throw std::runtime_error("Invalid schema registry response for schema id " + std::to_string(schema_id) +
+                                 ": " + e.what());
+    }
+
+    LOG(INFO) << "Fetched Avro schema id " << schema_id << " from " << m_schema_registry_url;
+
+    return m_schemas.emplace(schema_id, std::move(schema)).first->second;
+}
+}  // namespace morpheus
@@ -0,0 +1,196 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/objects/load_generator.hpp>
+
+#include <cudf/binaryop.hpp>
+#include <cudf/column/column.hpp>
+#include <cudf/copying.hpp>
+#include <cudf/filling.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/strings/combine.hpp>
+#include <cudf/strings/convert/convert_integers.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+    // Component public implementations
+    // ************ LoadGenerator ************************ //
+    BatchSizeDistribution parse_batch_size_distribution(const std::string &name) {
+        if (name == "fixed") {
+            return BatchSizeDistribution::Fixed;
+        }
+
+        if (name == "uniform") {
+            return BatchSizeDistribution::Uniform;
+        }
+
+        if (name == "exponential") {
+            return BatchSizeDistribution::Exponential;
+        }
+
+        throw std::invalid_argument("Unknown batch size distribution '" + name +
+                                    "'. Must be one of 'fixed', 'uniform' or 'exponential'");
+    }
+
+    LoadGenerator::LoadGenerator(cudf::io::table_with_metadata template_table,
+                                 int index_col_count,
+                                 LoadGeneratorOptions options) :
+            m_options(std::move(options)),
+            m_random(m_options.seed != 0 ? m_options.seed : std::random_device{}()) {
+        if (m_options.batch_size == 0) {
+            throw std::invalid_argument("LoadGenerator requires a batch_size of at least 1");
+        }
+
+        if (m_options.rows_per_second < 0.0 || m_options.jitter < 0.0 || m_options.jitter > 1.0) {
+            throw std::invalid_argument("LoadGenerator requires rows_per_second >= 0 and jitter in [0, 1]");
+        }
+
+        auto columns = template_table.tbl->release();
+
+        // The template's index is replaced by one counting the generated rows
+        columns.erase(columns.begin(), columns.begin() + index_col_count);
+
+        m_column_names.assign(template_table.metadata.column_names.begin() + index_col_count,
+                              template_table.metadata.column_names.end());
+
+        m_template = std::make_unique<cudf::table>(std::move(columns));
+
+        if (m_template->num_rows() == 0) {
+            throw std::invalid_argument("LoadGenerator requires a template with at least one row");
+        }
+
+        for (const auto &name: m_options.mutate_columns) {
+            auto found = std::find(m_column_names.begin(), m_column_names.end(), name);
+
+            if (found == m_column_names.end()) {
+                throw std::invalid_argument("Column '" + name + "' to mutate is not in the template");
+            }
+
+            auto idx = static_cast<cudf::size_type>(found - m_column_names.begin());
+
+            if (m_template->get_column(idx).type().id() != cudf::type_id::STRING) {
+                throw std::invalid_argument("Column '" + name + "' to mutate is not a string column");
+            }
+
+            m_mutate_column_idx.push_back(idx);
+        }
+    }
+
+    std::size_t LoadGenerator::next_batch_size() {
+        const auto mean = m_options.batch_size;
+
+        switch (m_options.distribution) {
+            case BatchSizeDistribution::Uniform:
+                return std::uniform_int_distribution<std::size_t>(1, 2 * mean - 1)(m_random);
+            case BatchSizeDistribution::Exponential: {
+                auto rows = std::ceil(std::exponential_distribution<double>(1.0 / mean)(m_random));
+
+                return std::clamp<std::size_t>(static_cast<std::size_t>(rows), 1, MaxBatchSizeFactor * mean);
+            }
+            case BatchSizeDistribution::Fixed:
+            default:
+                return mean;
+        }
+    }
+
+    cudf::io::table_with_metadata LoadGenerator::make_batch(std::size_t rows) {
+        const auto num_rows      = static_cast<cudf::size_type>(rows);
+        const auto template_rows = m_template->num_rows();
+        const auto first_row     = static_cast<cudf::size_type>(m_rows_generated % template_rows);
+        const auto first_index   = static_cast<int64_t>(m_rows_generated);
+
+        // A single gather handles the wrap around, and gives the batch its own copy of the rows
+        auto positions  = cudf::sequence(num_rows, cudf::numeric_scalar<cudf::size_type>(first_row));
+        auto gather_map = cudf::binary_operation(positions->view(),
+                                                 cudf::numeric_scalar<cudf::size_type>(template_rows),
+                                                 cudf::binary_operator::MOD,
+                                                 positions->type());
+
+        auto columns = cudf::gather(m_template->view(), gather_map->view())->release();
+
+        auto index = cudf::sequence(num_rows, cudf::numeric_scalar<int64_t>(first_index));
+
+        if (!m_mutate_column_idx.empty()) {
+            auto suffix = cudf::strings::from_integers(index->view());
+
+            for (auto idx: m_mutate_column_idx) {
+                columns[idx] = cudf::strings::concatenate(cudf::table_view{{columns[idx]->view(), suffix->view()}},
+                                                          cudf::string_scalar("-"));
+            }
+        }
+
+        columns.insert(columns.begin(), std::move(index));
+
+        cudf::io::table_with_metadata batch;
+        batch.tbl = std::make_unique<cudf::table>(std::move(columns));
+        batch.metadata.column_names.reserve(m_column_names.size() + 1);
+        batch.metadata.column_names.emplace_back("");
+        batch.metadata.column_names.insert(
+                batch.metadata.column_names.end(), m_column_names.begin(), m_column_names.end());
+
+        m_rows_generated += rows;
+
+        return batch;
+    }
+
+    LoadGenerator::clock_t::time_point LoadGenerator::schedule(std::size_t rows, clock_t::time_point start) {
+        if (m_options.rows_per_second <= 0.0) {
+            return start;
+        }
+
+        using seconds_t = std::chrono::duration<double>;
+
+        auto due      = seconds_t(m_rows_scheduled / m_options.rows_per_second);
+        auto interval = seconds_t(rows / m_options.rows_per_second);
+
+        if (m_options.jitter > 0.0) {
+            due += interval * std::uniform_real_distribution<double>(-m_options.jitter, m_options.jitter)(m_random);
+        }
+
+        m_rows_scheduled += rows;
+
+        return start + std::chrono::duration_cast<clock_t::duration>(std::max(due, seconds_t(0)));
+    }
+
+    double LoadGenerator::rows_per_second() const {
+        return m_options.rows_per_second;
+    }
+
+    std::size_t LoadGenerator::rows_generated() const {
+        return m_rows_generated;
+    }
+
+    std::size_t LoadGenerator::template_rows() const {
+        return m_template->num_rows();
+    }
+}  // namespace morpheus
@@ -19,12 +19,19 @@
 
 #include <morpheus/objects/table_info.hpp>
 #include <morpheus/utilities/cudf_util.hpp>
+#include <morpheus/utilities/table_util.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
 
+#include <cudf/column/column.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/table/table.hpp>
 #include <cudf/types.hpp>
 
+#include <glog/logging.h>
 #include <pybind11/gil.h>
 #include <pybind11/pytypes.h>
 
+#include <memory>
 #include <utility>
 
 namespace morpheus {
@@ -58,4 +65,47 @@ namespace morpheus {
     const pybind11::object &PyDataTable::get_py_object() const {
         return m_py_table;
     }
+
+    void PyDataTable::insert_columns(const std::vector<std::string> &column_names,
+                                     const std::vector<TypeId> &column_types) const {
+        pybind11::gil_scoped_acquire gil;
+
+        insert_py_columns(m_py_table, column_names, column_types);
+    }
+
+    std::size_t PyDataTable::device_bytes() const {
+        return 0;
+    }
+
+/****** Component public free function implementations******/
+    void insert_py_columns(const pybind11::object &py_table,
+                           const std::vector<std::string> &column_names,
+                           const std::vector<TypeId> &column_types) {
+        CHECK(column_names.size() == column_types.size());
+
+        if (column_names.empty()) {
+            return;
+        }
+
+        const auto num_existing_cols = py_table.attr("_num_columns").cast<cudf::size_type>();
+        const auto num_rows = py_table.attr("_num_rows").cast<cudf::size_type>();
+
+        // Build all of the new columns in C++ and hand them to Python with a single conversion
+        std::vector<std::unique_ptr<cudf::column>> columns;
+        for (const auto &type_id: column_types) {
+            columns.emplace_back(CuDFTableUtil::make_zeroed_column(type_id, num_rows));
+        }
+
+        cudf::io::table_with_metadata new_table{std::make_unique<cudf::table>(std::move(columns)),
+                                                cudf::io::table_metadata{}};
+        new_table.metadata.column_names = column_names;
+
+        auto new_df = proxy_table_from_table_with_metadata(std::move(new_table), 0);
+
+        for (std::size_t i = 0; i < column_names.size(); ++i) {
+            // Insert the column itself, a Series would be aligned against the index of py_table
+            auto column = new_df[pybind11::str(column_names[i])].attr("_column");
+            py_table.attr("insert")(num_existing_cols + i, column_names[i], column);
+        }
+    }
 }  // namespace morpheus
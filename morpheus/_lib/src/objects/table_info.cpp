@@ -30,19 +30,64 @@
 
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace morpheus {
 /****** Component public implementations *******************/
+/****** TableSchema****************************************/
+TableSchema::TableSchema(std::vector<std::string> index_names, std::vector<std::string> column_names) :
+  m_index_names(std::move(index_names)),
+  m_column_names(std::move(column_names))
+{}
+
+const std::vector<std::string> &TableSchema::index_names() const
+{
+    return m_index_names;
+}
+
+const std::vector<std::string> &TableSchema::column_names() const
+{
+    return m_column_names;
+}
+
+cudf::size_type TableSchema::find_column(const std::string &name) const
+{
+    std::call_once(m_lookup_once, [this]() {
+        m_lookup.reserve(m_column_names.size());
+
+        for (cudf::size_type i = 0; i < m_column_names.size(); ++i)
+        {
+            // Keeps the first of any duplicate names, same as a linear search
+            m_lookup.emplace(m_column_names[i], i);
+        }
+    });
+
+    auto found = m_lookup.find(name);
+
+    return found == m_lookup.end() ? -1 : found->second;
+}
+
 /****** TableInfo****************************************/
+TableInfo::TableInfo() : m_schema(std::make_shared<TableSchema>(std::vector<std::string>{}, std::vector<std::string>{}))
+{}
+
 TableInfo::TableInfo(std::shared_ptr<const IDataTable> parent,
                      cudf::table_view view,
                      std::vector<std::string> index_names,
                      std::vector<std::string> column_names) :
+  TableInfo(std::move(parent),
+            std::move(view),
+            std::make_shared<TableSchema>(std::move(index_names), std::move(column_names)))
+{}
+
+TableInfo::TableInfo(std::shared_ptr<const IDataTable> parent,
+                     cudf::table_view view,
+                     std::shared_ptr<const TableSchema> schema) :
   m_parent(std::move(parent)),
   m_table_view(std::move(view)),
-  m_index_names(std::move(index_names)),
-  m_column_names(std::move(column_names))
+  m_schema(std::move(schema))
 {}
 
 const pybind11::object &TableInfo::get_parent_table() const
@@ -50,19 +95,29 @@ const pybind11::object &TableInfo::get_parent_table() const
     return m_parent->get_py_object();
 }
 
+const std::shared_ptr<const IDataTable> &TableInfo::get_parent() const
+{
+    return m_parent;
+}
+
 const cudf::table_view &TableInfo::get_view() const
 {
     return m_table_view;
 }
 
-std::vector<std::string> TableInfo::get_index_names() const
+const std::vector<std::string> &TableInfo::get_index_names() const
 {
-    return m_index_names;
+    return m_schema->index_names();
 }
 
-std::vector<std::string> TableInfo::get_column_names() const
+const std::vector<std::string> &TableInfo::get_column_names() const
 {
-    return m_column_names;
+    return m_schema->column_names();
+}
+
+const std::shared_ptr<const TableSchema> &TableInfo::get_schema() const
+{
+    return m_schema;
 }
 
 cudf::size_type TableInfo::num_indices() const
@@ -91,31 +146,31 @@ pybind11::object TableInfo::as_py_object() const
 
         auto df          = this->get_parent_table();
         auto index_slice = py::slice(py::int_(offset), py::int_(stop), py::none());
-        return df.attr("loc")[py::make_tuple(df.attr("index")[index_slice], m_column_names)];
+        return df.attr("loc")[py::make_tuple(df.attr("index")[index_slice], this->get_column_names())];
     }
 }
 
 void TableInfo::insert_columns(const std::vector<std::string> &column_names, const std::vector<TypeId> &column_types)
 {
     CHECK(column_names.size() == column_types.size());
-    const auto num_existing_cols = m_column_names.size();
-    const auto num_rows          = m_table_view.num_rows();
 
-    // TODO figure out how to do this without the gil
-    {
-        namespace py = pybind11;
-        pybind11::gil_scoped_acquire gil;
-        pybind11::object cupy_zeros = pybind11::module_::import("cupy").attr("zeros");
+    // Rows of the parent covered by this view
+    auto row_offset = [](const cudf::table_view &view) {
+        return view.num_columns() > 0 ? view.column(0).offset() : 0;
+    };
 
-        auto table = get_parent_table();
+    const auto num_rows = m_table_view.num_rows();
 
-        for (std::size_t i = 0; i < column_names.size(); ++i)
-        {
-            auto empty_array = cupy_zeros(num_rows, DataType(column_types[i]).type_str());
-            table.attr("insert")(num_existing_cols + i, column_names[i], empty_array);
-            m_column_names.push_back(column_names[i]);
-        }
-    }
+    m_parent->insert_columns(column_names, column_types);
+
+    // Refresh the view so it contains the new columns
+    auto parent_info = m_parent->get_info();
+    const auto start = row_offset(m_table_view) - row_offset(parent_info.get_view());
+
+    std::vector<std::string> new_column_names{this->get_column_names()};
+    new_column_names.insert(new_column_names.end(), column_names.begin(), column_names.end());
+
+    *this = parent_info.get_slice(start, start + num_rows, std::move(new_column_names));
 }
 
 void TableInfo::insert_missing_columns(const std::vector<std::string> &column_names,
@@ -127,7 +182,7 @@ void TableInfo::insert_missing_columns(const std::vector<std::string> &column_na
     std::vector<TypeId> missing_types;
     for (std::size_t i = 0; i < column_names.size(); ++i)
     {
-        if (std::find(m_column_names.begin(), m_column_names.end(), column_names[i]) == m_column_names.end())
+        if (m_schema->find_column(column_names[i]) < 0)
         {
             missing_names.push_back(column_names[i]);
             missing_types.push_back(column_types[i]);
@@ -147,42 +202,75 @@ const cudf::column_view &TableInfo::get_column(cudf::size_type idx) const
         throw std::invalid_argument("idx must satisfy 0 <= idx < num_columns()");
     }
 
-    return this->m_table_view.column(this->m_index_names.size() + idx);
+    return this->m_table_view.column(this->num_indices() + idx);
 }
 
 TableInfo TableInfo::get_slice(cudf::size_type start, cudf::size_type stop, std::vector<std::string> column_names) const
 {
     std::vector<cudf::size_type> col_indices;
 
-    std::vector<std::string> new_column_names;
+    col_indices.reserve(this->num_indices() + column_names.size());
 
     // Append the indices column idx by default
-    for (cudf::size_type i = 0; i < this->m_index_names.size(); ++i)
+    for (cudf::size_type i = 0; i < this->num_indices(); ++i)
     {
         col_indices.push_back(i);
     }
 
-    std::transform(column_names.begin(),
-                   column_names.end(),
-                   std::back_inserter(col_indices),
-                   [this, &new_column_names](const std::string &c) {
-                       auto found_col = std::find(this->m_column_names.begin(), this->m_column_names.end(), c);
-
-                       if (found_col == this->m_column_names.end())
-                       {
-                           throw std::runtime_error("Unknown column: " + c);
-                       }
+    for (const auto &c : column_names)
+    {
+        auto found_col = m_schema->find_column(c);
 
-                       // Add the found column to the metadata
-                       new_column_names.push_back(c);
+        if (found_col < 0)
+        {
+            throw std::runtime_error("Unknown column: " + c);
+        }
 
-                       return (found_col - this->m_column_names.begin() + this->num_indices());
-                   });
+        col_indices.push_back(found_col + this->num_indices());
+    }
 
     auto slice_rows = cudf::slice(m_table_view, {start, stop})[0];
 
     auto slice_cols = slice_rows.select(col_indices);
 
-    return TableInfo(m_parent, slice_cols, m_index_names, new_column_names);
+    // The requested names are the column names of the slice
+    return TableInfo(m_parent, slice_cols, this->get_index_names(), std::move(column_names));
+}
+
+TableInfo TableInfo::get_row_slice(cudf::size_type start, cudf::size_type stop) const
+{
+    return TableInfo(m_parent, cudf::slice(m_table_view, {start, stop})[0], m_schema);
+}
+
+TableInfo TableInfo::get_slice(cudf::size_type start,
+                               cudf::size_type stop,
+                               const std::vector<cudf::size_type> &column_indices) const
+{
+    std::vector<cudf::size_type> col_indices;
+    std::vector<std::string> new_column_names;
+
+    col_indices.reserve(this->num_indices() + column_indices.size());
+    new_column_names.reserve(column_indices.size());
+
+    // Append the indices column idx by default
+    for (cudf::size_type i = 0; i < this->num_indices(); ++i)
+    {
+        col_indices.push_back(i);
+    }
+
+    for (auto idx : column_indices)
+    {
+        if (idx < 0 || idx >= this->num_columns())
+        {
+            throw std::invalid_argument("Column index " + std::to_string(idx) + " out of range");
+        }
+
+        col_indices.push_back(idx + this->num_indices());
+        new_column_names.push_back(this->get_column_names()[idx]);
+    }
+
+    auto slice_rows = cudf::slice(m_table_view, {start, stop})[0];
+
+    return TableInfo(m_parent, slice_rows.select(col_indices), this->get_index_names(), std::move(new_column_names));
 }
 }  // namespace morpheus
@@ -21,14 +21,25 @@
 #include <morpheus/objects/tensor_object.hpp>
 #include <morpheus/utilities/type_util.hpp>
 
+#include <rmm/cuda_stream_view.hpp>
 #include <rmm/device_buffer.hpp>
 
+#include <glog/logging.h>
+
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
 namespace morpheus {
+// Component-private free functions.
+// ************ Tensor__constants ************ //
+constexpr size_t TensorPackAlignment = 256;
+
+// Component public implementations
+// ************ Tensor **************************** //
 Tensor::Tensor(std::shared_ptr<rmm::device_buffer> buffer,
                std::string init_typestr,
                std::vector<int32_t> init_shape,
@@ -58,11 +69,28 @@ std::vector<uint8_t> Tensor::get_host_data() const
 
     out_data.resize(this->bytes_count());
 
-    NEO_CHECK_CUDA(cudaMemcpy(&out_data[0], this->data(), this->bytes_count(), cudaMemcpyDeviceToHost));
+    // Use the per-thread stream to avoid an implicit sync with every other stream
+    NEO_CHECK_CUDA(cudaMemcpyAsync(
+        out_data.data(), this->data(), this->bytes_count(), cudaMemcpyDeviceToHost, rmm::cuda_stream_per_thread));
+
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
 
     return out_data;
 }
 
+PinnedHostBuffer Tensor::copy_to_host_async(rmm::cuda_stream_view stream) const
+{
+    auto host_buffer = PinnedHostPool::acquire(this->bytes_count());
+
+    if (!host_buffer.empty())
+    {
+        NEO_CHECK_CUDA(cudaMemcpyAsync(
+            host_buffer.data(), this->data(), this->bytes_count(), cudaMemcpyDeviceToHost, stream.value()));
+    }
+
+    return host_buffer;
+}
+
 auto Tensor::get_stream() const
 {
     return this->m_device_buffer->stream();
@@ -80,4 +108,36 @@ TensorObject Tensor::create(std::shared_ptr<rmm::device_buffer> buffer,
 
     return TensorObject(md, tensor);
 }
+
+std::vector<TensorObject> Tensor::create_packed(const std::vector<DType> &dtypes,
+                                                const std::vector<std::vector<TensorIndex>> &shapes)
+{
+    CHECK(dtypes.size() == shapes.size()) << "Must have one dtype per shape";
+
+    std::vector<size_t> offsets(shapes.size());
+    size_t total_bytes = 0;
+
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+        auto elem_count = std::accumulate(shapes[i].begin(), shapes[i].end(), size_t{1}, std::multiplies<>());
+
+        offsets[i]  = total_bytes;
+        total_bytes = (offsets[i] + elem_count * dtypes[i].item_size() + TensorPackAlignment - 1) /
+                      TensorPackAlignment * TensorPackAlignment;
+    }
+
+    auto buffer = std::make_shared<rmm::device_buffer>(total_bytes, rmm::cuda_stream_per_thread);
+
+    std::vector<TensorObject> tensors;
+    tensors.reserve(shapes.size());
+
+    for (size_t i = 0; i < shapes.size(); ++i)
+    {
+        // Tensor offsets are in elements. The alignment is a multiple of every item size
+        tensors.emplace_back(Tensor::create(
+            buffer, dtypes[i], shapes[i], std::vector<TensorIndex>{}, offsets[i] / dtypes[i].item_size()));
+    }
+
+    return tensors;
+}
 }  // namespace morpheus
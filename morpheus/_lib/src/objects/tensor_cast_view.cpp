@@ -0,0 +1,94 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/objects/tensor_cast_view.hpp>
+
+#include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/host_memory.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+
+#include <neo/cuda/common.hpp>
+
+#include <cuda_runtime.h>
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <utility>
+
+namespace morpheus {
+// Component public implementations
+// ************ TensorCastView **************************** //
+TensorCastView::TensorCastView(TensorObject source, DataType dtype) : m_source(std::move(source)), m_dtype(dtype)
+{
+    CHECK(m_source.is_compact()) << "TensorCastView requires a compact tensor";
+}
+
+const TensorObject& TensorCastView::source() const
+{
+    return m_source;
+}
+
+DataType TensorCastView::dtype() const
+{
+    return m_dtype;
+}
+
+bool TensorCastView::is_identity() const
+{
+    return m_dtype == m_source.dtype();
+}
+
+std::size_t TensorCastView::count() const
+{
+    return m_source.count();
+}
+
+std::size_t TensorCastView::bytes() const
+{
+    return m_source.count() * m_dtype.item_size();
+}
+
+void TensorCastView::copy_to(void* output, rmm::cuda_stream_view stream) const
+{
+    if (this->is_identity())
+    {
+        NEO_CHECK_CUDA(cudaMemcpyAsync(output, m_source.data(), this->bytes(), cudaMemcpyDefault, stream.value()));
+        return;
+    }
+
+    MatxUtil::cast_into(
+        m_source.data(), m_source.dtype().type_id(), m_source.count(), m_dtype.type_id(), output, stream);
+}
+
+PinnedHostBuffer TensorCastView::copy_to_host_async(rmm::cuda_stream_view stream) const
+{
+    auto host_buffer = PinnedHostPool::acquire(this->bytes());
+
+    if (!host_buffer.empty())
+    {
+        this->copy_to(host_buffer.data(), stream);
+    }
+
+    return host_buffer;
+}
+
+TensorObject TensorCastView::materialize() const
+{
+    return m_source.as_type(m_dtype);
+}
+}  // namespace morpheus
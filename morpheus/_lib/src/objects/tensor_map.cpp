@@ -0,0 +1,163 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/objects/tensor_map.hpp>
+
+#include <morpheus/objects/tensor_object.hpp>
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private free functions.
+// ************ TensorMap__constants ************ //
+// Every memory type in Morpheus holds at most this many tensors. Avoids regrowing for the common case
+constexpr std::size_t TensorMapInitialCapacity = 4;
+
+// Component public implementations
+// ************ TensorMap **************************** //
+TensorMap::TensorMap()
+{
+    m_entries.reserve(TensorMapInitialCapacity);
+}
+
+std::size_t TensorMap::slot_of(const std::string& name) const
+{
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        if (m_entries[i].first == name)
+        {
+            return i;
+        }
+    }
+
+    return npos;
+}
+
+std::size_t TensorMap::slot_of(const std::string& name, std::size_t hint) const
+{
+    if (hint < m_entries.size() && m_entries[hint].first == name)
+    {
+        return hint;
+    }
+
+    return this->slot_of(name);
+}
+
+TensorObject& TensorMap::at(std::size_t slot)
+{
+    DCHECK(slot < m_entries.size()) << "Tensor slot " << slot << " out of range";
+
+    return m_entries[slot].second;
+}
+
+const TensorObject& TensorMap::at(std::size_t slot) const
+{
+    DCHECK(slot < m_entries.size()) << "Tensor slot " << slot << " out of range";
+
+    return m_entries[slot].second;
+}
+
+const std::string& TensorMap::name_at(std::size_t slot) const
+{
+    DCHECK(slot < m_entries.size()) << "Tensor slot " << slot << " out of range";
+
+    return m_entries[slot].first;
+}
+
+TensorObject& TensorMap::operator[](const std::string& name)
+{
+    auto slot = this->slot_of(name);
+
+    if (slot == npos)
+    {
+        m_entries.emplace_back(name, TensorObject());
+
+        return m_entries.back().second;
+    }
+
+    return m_entries[slot].second;
+}
+
+std::pair<TensorMap::iterator, bool> TensorMap::emplace(const std::string& name, TensorObject tensor)
+{
+    auto found = this->find(name);
+
+    if (found != m_entries.end())
+    {
+        return std::make_pair(found, false);
+    }
+
+    m_entries.emplace_back(name, std::move(tensor));
+
+    return std::make_pair(std::prev(m_entries.end()), true);
+}
+
+TensorMap::iterator TensorMap::find(const std::string& name)
+{
+    auto slot = this->slot_of(name);
+
+    return slot == npos ? m_entries.end() : m_entries.begin() + slot;
+}
+
+TensorMap::const_iterator TensorMap::find(const std::string& name) const
+{
+    auto slot = this->slot_of(name);
+
+    return slot == npos ? m_entries.end() : m_entries.begin() + slot;
+}
+
+bool TensorMap::contains(const std::string& name) const
+{
+    return this->slot_of(name) != npos;
+}
+
+std::size_t TensorMap::size() const
+{
+    return m_entries.size();
+}
+
+bool TensorMap::empty() const
+{
+    return m_entries.empty();
+}
+
+TensorMap::iterator TensorMap::begin()
+{
+    return m_entries.begin();
+}
+
+TensorMap::iterator TensorMap::end()
+{
+    return m_entries.end();
+}
+
+TensorMap::const_iterator TensorMap::begin() const
+{
+    return m_entries.begin();
+}
+
+TensorMap::const_iterator TensorMap::end() const
+{
+    return m_entries.end();
+}
+}  // namespace morpheus
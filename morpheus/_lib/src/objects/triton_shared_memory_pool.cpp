@@ -0,0 +1,86 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/objects/triton_shared_memory_pool.hpp>
+
+#include <neo/cuda/common.hpp>
+
+#include <glog/logging.h>
+
+#include <mutex>
+#include <utility>
+
+namespace morpheus {
+    // Component public implementations
+    // ************ TritonSharedMemoryPool************************* //
+    TritonSharedMemoryPool::TritonSharedMemoryPool(const std::string &name_prefix,
+                                                   std::size_t region_bytes,
+                                                   std::size_t region_count) {
+        CHECK(region_count > 0) << "TritonSharedMemoryPool requires at least one region";
+
+        int device_id = 0;
+        NEO_CHECK_CUDA(cudaGetDevice(&device_id));
+
+        for (std::size_t i = 0; i < region_count; ++i) {
+            TritonSharedMemoryRegion region{name_prefix + "_" + std::to_string(i), nullptr, region_bytes, device_id};
+
+            NEO_CHECK_CUDA(cudaMalloc(reinterpret_cast<void **>(&region.data), region_bytes));
+            NEO_CHECK_CUDA(cudaIpcGetMemHandle(&region.ipc_handle, region.data));
+
+            m_regions.emplace_back(std::move(region));
+            m_free_regions.push_back(i);
+        }
+    }
+
+    TritonSharedMemoryPool::~TritonSharedMemoryPool() {
+        for (auto &region: m_regions) {
+            auto status = cudaFree(region.data);
+
+            if (status != cudaSuccess) {
+                LOG(ERROR) << "Failed to free Triton shared memory region '" << region.name
+                           << "'. Error: " << cudaGetErrorString(status);
+            }
+        }
+    }
+
+    const std::vector<TritonSharedMemoryRegion> &TritonSharedMemoryPool::regions() const {
+        return m_regions;
+    }
+
+    std::shared_ptr<const TritonSharedMemoryRegion> TritonSharedMemoryPool::acquire() {
+        std::unique_lock<boost::fibers::mutex> lock(m_mutex);
+
+        m_cv.wait(lock, [this]() { return !m_free_regions.empty(); });
+
+        auto idx = m_free_regions.back();
+        m_free_regions.pop_back();
+
+        return std::shared_ptr<const TritonSharedMemoryRegion>(&m_regions[idx],
+                                                               [this, idx](const TritonSharedMemoryRegion *) {
+                                                                   this->release(idx);
+                                                               });
+    }
+
+    void TritonSharedMemoryPool::release(std::size_t idx) {
+        {
+            std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+            m_free_regions.push_back(idx);
+        }
+
+        m_cv.notify_one();
+    }
+}
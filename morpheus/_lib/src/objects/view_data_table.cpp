@@ -0,0 +1,111 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/objects/view_data_table.hpp>
+
+#include <morpheus/objects/cpp_data_table.hpp>
+#include <morpheus/objects/table_info.hpp>
+
+#include <cudf/io/types.hpp>
+#include <cudf/table/table.hpp>
+
+#include <pybind11/pytypes.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+/****** Component public implementations *******************/
+/****** ViewDataTable***************************************/
+    ViewDataTable::ViewDataTable(TableInfo view) : m_view(std::move(view)) {}
+
+    cudf::size_type ViewDataTable::count() const {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_owned) {
+                return m_view.num_rows();
+            }
+        }
+
+        // Never reset once made, safe to use without the lock
+        return m_owned->count();
+    }
+
+    TableInfo ViewDataTable::get_info() const {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_owned) {
+                return TableInfo(this->shared_from_this(), m_view.get_view(), m_view.get_schema());
+            }
+        }
+
+        return m_owned->get_info();
+    }
+
+    const pybind11::object &ViewDataTable::get_py_object() const {
+        return this->owned()->get_py_object();
+    }
+
+    void ViewDataTable::insert_columns(const std::vector<std::string> &column_names,
+                                       const std::vector<TypeId> &column_types) const {
+        this->owned()->insert_columns(column_names, column_types);
+    }
+
+    std::size_t ViewDataTable::device_bytes() const {
+        const auto &source = m_view.get_parent();
+        std::size_t bytes  = source ? source->device_bytes() : 0;
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_owned ? bytes + m_owned->device_bytes() : bytes;
+    }
+
+    bool ViewDataTable::is_owned() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_owned != nullptr;
+    }
+
+    const std::shared_ptr<const IDataTable> &ViewDataTable::source() const {
+        return m_view.get_parent();
+    }
+
+    std::shared_ptr<CppDataTable> ViewDataTable::owned() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_owned) {
+            // Index columns come first in the view, same as the layout CppDataTable expects
+            auto column_names = m_view.get_index_names();
+            auto data_columns = m_view.get_column_names();
+            column_names.insert(column_names.end(), data_columns.begin(), data_columns.end());
+
+            cudf::io::table_with_metadata table{std::make_unique<cudf::table>(m_view.get_view()),
+                                                cudf::io::table_metadata{}};
+            table.metadata.column_names = std::move(column_names);
+
+            m_owned = std::make_shared<CppDataTable>(std::move(table), m_view.num_indices());
+        }
+
+        return m_owned;
+    }
+}  // namespace morpheus
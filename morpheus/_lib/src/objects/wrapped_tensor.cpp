@@ -18,11 +18,17 @@
 #include <morpheus/objects/wrapped_tensor.hpp>
 
 #include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/cupy_util.hpp>
 
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cuda_runtime.h>
+#include <dlpack/dlpack.h>
 #include <pybind11/cast.h>
 #include <pybind11/pytypes.h>
 
 #include <chrono>
+#include <utility>
 
 namespace morpheus {
 /****** Component public implementations *******************/
@@ -82,4 +88,29 @@ pybind11::dict TensorObjectInterfaceProxy::cuda_array_interface(TensorObject &se
 
     return array_interface;
 }
+
+pybind11::capsule TensorObjectInterfaceProxy::dlpack(TensorObject &self, pybind11::object stream)
+{
+    return CupyUtil::to_dlpack(self, std::move(stream));
+}
+
+pybind11::tuple TensorObjectInterfaceProxy::dlpack_device(TensorObject &self)
+{
+    cudaPointerAttributes attributes{};
+    NEO_CHECK_CUDA(cudaPointerGetAttributes(&attributes, self.data()));
+
+    auto device_type = attributes.type == cudaMemoryTypeManaged ? kDLCUDAManaged : kDLCUDA;
+
+    return pybind11::make_tuple(static_cast<int>(device_type), attributes.device);
+}
+
+TensorObject TensorObjectInterfaceProxy::from_dlpack(pybind11::object obj)
+{
+    if (PyCapsule_CheckExact(obj.ptr()) != 0)
+    {
+        return CupyUtil::from_dlpack(pybind11::reinterpret_borrow<pybind11::capsule>(obj));
+    }
+
+    return CupyUtil::cupy_to_tensor(std::move(obj));
+}
 }  // namespace morpheus
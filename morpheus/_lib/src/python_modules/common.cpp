@@ -15,13 +15,24 @@
  * limitations under the License.
  */
 
+#include <morpheus/io/gpu_compressed_sink.hpp>
+#include <morpheus/io/ucx_transport.hpp>
 #include <morpheus/objects/fiber_queue.hpp>
 #include <morpheus/objects/wrapped_tensor.hpp>
+#include <morpheus/utilities/cuda_graph.hpp>
 #include <morpheus/utilities/cudf_util.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/pipeline_drain.hpp>
+#include <morpheus/utilities/stage_metrics.hpp>
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace morpheus {
 namespace py = pybind11;
@@ -42,14 +53,105 @@ PYBIND11_MODULE(common, m)
     load_cudf_helpers();
 
     py::class_<TensorObject>(m, "Tensor")
-        .def_property_readonly("__cuda_array_interface__", &TensorObjectInterfaceProxy::cuda_array_interface);
+        .def_property_readonly("__cuda_array_interface__", &TensorObjectInterfaceProxy::cuda_array_interface)
+        .def("__dlpack__", &TensorObjectInterfaceProxy::dlpack, py::arg("stream") = py::none())
+        .def("__dlpack_device__", &TensorObjectInterfaceProxy::dlpack_device)
+        .def_static("from_dlpack", &TensorObjectInterfaceProxy::from_dlpack, py::arg("obj"));
 
     py::class_<FiberQueue, std::shared_ptr<FiberQueue>>(m, "FiberQueue")
         .def(py::init<>(&FiberQueueInterfaceProxy::init), py::arg("max_size"))
         .def("get", &FiberQueueInterfaceProxy::get, py::arg("block") = true, py::arg("timeout") = 0.0)
-        .def("put", &FiberQueueInterfaceProxy::put, py::arg("item"), py::arg("block") = true, py::arg("timeout") = 0.0)
+        .def("put",
+             &FiberQueueInterfaceProxy::put,
+             py::arg("item"),
+             py::arg("block")   = true,
+             py::arg("timeout") = 0.0)
+        .def("get_many",
+             &FiberQueueInterfaceProxy::get_many,
+             py::arg("max_items"),
+             py::arg("block")   = true,
+             py::arg("timeout") = 0.0)
+        .def("put_many",
+             &FiberQueueInterfaceProxy::put_many,
+             py::arg("items"),
+             py::arg("block")   = true,
+             py::arg("timeout") = 0.0)
         .def("close", &FiberQueueInterfaceProxy::close);
 
+    py::class_<DeviceMemoryStats>(m, "DeviceMemoryStats")
+        .def_readonly("current_bytes", &DeviceMemoryStats::current_bytes)
+        .def_readonly("peak_bytes", &DeviceMemoryStats::peak_bytes)
+        .def_readonly("total_bytes", &DeviceMemoryStats::total_bytes)
+        .def_readonly("allocation_count", &DeviceMemoryStats::allocation_count);
+
+    m.def("configure_device_memory",
+          &DeviceMemory::configure,
+          py::arg("resource"),
+          py::arg("initial_pool_bytes") = 0,
+          py::arg("maximum_pool_bytes") = 0,
+          py::arg("device_ids")         = std::vector<int>());
+    m.def("device_memory_resource", &DeviceMemory::resource);
+    m.def("device_memory_stats", &DeviceMemory::stats);
+
+    py::class_<StageMetricsSnapshot>(m, "StageMetricsSnapshot")
+        .def_readonly("messages_in", &StageMetricsSnapshot::messages_in)
+        .def_readonly("rows_in", &StageMetricsSnapshot::rows_in)
+        .def_readonly("messages_out", &StageMetricsSnapshot::messages_out)
+        .def_readonly("rows_out", &StageMetricsSnapshot::rows_out)
+        .def_readonly("processing_ns", &StageMetricsSnapshot::processing_ns)
+        .def_readonly("blocked_ns", &StageMetricsSnapshot::blocked_ns)
+        .def_readonly("latency_buckets", &StageMetricsSnapshot::latency_buckets)
+        .def_readonly("source_latency_buckets", &StageMetricsSnapshot::source_latency_buckets)
+        .def_readonly("source_latency_ns", &StageMetricsSnapshot::source_latency_ns);
+
+    m.attr("stage_latency_buckets_us") =
+        std::vector<uint64_t>(StageMetrics::LatencyBucketsUs.begin(), StageMetrics::LatencyBucketsUs.end());
+    m.attr("stage_source_latency_buckets_ms") = std::vector<uint64_t>(StageMetrics::SourceLatencyBucketsMs.begin(),
+                                                                      StageMetrics::SourceLatencyBucketsMs.end());
+
+    // Safe to call while the pipeline is running, the counters are read without stopping the stages
+    m.def("stage_metrics", &StageMetrics::snapshot_all);
+    m.def("stage_metrics_prometheus", &StageMetrics::prometheus_text);
+
+    py::class_<DrainStatus>(m, "DrainStatus")
+        .def_readonly("in_flight", &DrainStatus::in_flight)
+        .def_readonly("drained", &DrainStatus::drained);
+
+    // Sources stop consuming once a drain is requested, the rest of the pipeline finishes what they already emitted
+    m.def("request_drain",
+          [](uint32_t timeout_ms) { PipelineDrain::request(std::chrono::milliseconds(timeout_ms)); },
+          py::arg("timeout_ms"));
+    m.def("drain_requested", &PipelineDrain::requested);
+    m.def("drain_expired", &PipelineDrain::expired);
+    m.def("drain_progress", &PipelineDrain::progress);
+    m.def("reset_drain", &PipelineDrain::reset);
+
+    // Sources attach a trace to one in every `interval` messages, zero disables tracing
+    m.def("set_trace_sample_interval", &MessageTrace::set_sample_interval, py::arg("interval"));
+    m.def("trace_sample_interval", &MessageTrace::sample_interval);
+
+    // Fixed-shape kernel sequences of the C++ stages are replayed as CUDA Graphs once enabled
+    m.def("set_cuda_graphs_enabled", &CudaGraphCache::set_enabled, py::arg("enabled"));
+    m.def("cuda_graphs_enabled", &CudaGraphCache::enabled);
+
+    // Whether the C++ file sink can compress CSV and JSON output, only when built with nvCOMP
+    m.attr("gpu_compression_available") = GpuCompressedSink::Available;
+
+    // Whether tables can be sent between pipelines with the UCX stages, only when built with UCX
+    m.attr("ucx_available") = UcxSender::Available;
+
+    py::class_<DeviceOperationStats>(m, "DeviceOperationStats")
+        .def_readonly("count", &DeviceOperationStats::count)
+        .def_readonly("total_ns", &DeviceOperationStats::total_ns)
+        .def_readonly("max_ns", &DeviceOperationStats::max_ns);
+
+    m.attr("device_annotations_enabled") = DeviceAnnotation::Enabled;
+
+    m.def("set_device_timing_enabled", &DeviceAnnotation::set_timing_enabled, py::arg("enabled"));
+    m.def("device_timing_enabled", &DeviceAnnotation::timing_enabled);
+    m.def("device_operation_stats", &DeviceAnnotation::stats);
+    m.def("reset_device_operation_stats", &DeviceAnnotation::reset);
+
 #ifdef VERSION_INFO
     m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
 #else
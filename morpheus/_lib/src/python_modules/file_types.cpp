@@ -32,10 +32,14 @@ PYBIND11_MODULE(file_types, m)
     py::enum_<FileTypes>(m,
                          "FileTypes",
                          "The type of files that the `FileSourceStage` can read and `WriteToFileStage` can write. Use "
-                         "'auto' to determine from the file extension.")
+                         "'auto' to determine from the file extension. PARQUET, ORC and ARROW (IPC file format) are "
+                         "only supported by `WriteToFileStage`.")
         .value("Auto", FileTypes::Auto)
         .value("JSON", FileTypes::JSON)
-        .value("CSV", FileTypes::CSV);
+        .value("CSV", FileTypes::CSV)
+        .value("PARQUET", FileTypes::PARQUET)
+        .value("ORC", FileTypes::ORC)
+        .value("ARROW", FileTypes::ARROW);
 
     m.def("determine_file_type", &FileTypesInterfaceProxy::determine_file_type);
 
@@ -28,6 +28,7 @@
 #include <morpheus/messages/multi_inference_nlp.hpp>
 #include <morpheus/messages/multi_response.hpp>
 #include <morpheus/messages/multi_response_probs.hpp>
+#include <morpheus/objects/fiber_queue.hpp>
 #include <morpheus/objects/tensor.hpp>
 #include <morpheus/utilities/cudf_util.hpp>
 
@@ -79,7 +80,31 @@ PYBIND11_MODULE(messages, m)
         .def(py::init<>(&MessageMetaInterfaceProxy::init_python), py::arg("df"))
         .def_property_readonly("count", &MessageMetaInterfaceProxy::count)
         .def_property_readonly("df", &MessageMetaInterfaceProxy::get_data_frame, py::return_value_policy::move)
-        .def_static("make_from_file", &MessageMetaInterfaceProxy::init_cpp);
+        .def_property_readonly("trace", &MessageMetaInterfaceProxy::get_trace)
+        .def_property_readonly("device_bytes", &MessageMetaInterfaceProxy::device_bytes)
+        .def_static("make_from_file", &MessageMetaInterfaceProxy::init_cpp)
+        .def_static("live_device_bytes", &MessageMeta::live_device_bytes)
+        .def_static("live_tables", &MessageMeta::live_tables);
+
+    py::class_<MessageMetaFiberQueue, std::shared_ptr<MessageMetaFiberQueue>>(m, "MessageMetaFiberQueue")
+        .def(py::init<>(&MessageMetaFiberQueueInterfaceProxy::init), py::arg("max_size"))
+        .def("get", &MessageMetaFiberQueueInterfaceProxy::get, py::arg("block") = true, py::arg("timeout") = 0.0)
+        .def("put",
+             &MessageMetaFiberQueueInterfaceProxy::put,
+             py::arg("item"),
+             py::arg("block")   = true,
+             py::arg("timeout") = 0.0)
+        .def("get_many",
+             &MessageMetaFiberQueueInterfaceProxy::get_many,
+             py::arg("max_items"),
+             py::arg("block")   = true,
+             py::arg("timeout") = 0.0)
+        .def("put_many",
+             &MessageMetaFiberQueueInterfaceProxy::put_many,
+             py::arg("items"),
+             py::arg("block")   = true,
+             py::arg("timeout") = 0.0)
+        .def("close", &MessageMetaFiberQueueInterfaceProxy::close);
 
     neo::node::EdgeConnector<std::shared_ptr<MultiMessage>, py::object>::register_converter();
     neo::node::EdgeConnector<py::object, std::shared_ptr<MultiMessage>>::register_converter();
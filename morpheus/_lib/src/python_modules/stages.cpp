@@ -17,22 +17,73 @@
 
 #include <morpheus/stages/add_classification.hpp>
 #include <morpheus/stages/add_scores.hpp>
+#include <morpheus/stages/admission.hpp>
+#include <morpheus/stages/appshield_source.hpp>
+#include <morpheus/stages/buffer.hpp>
+#include <morpheus/stages/cloud_trail_source.hpp>
+#include <morpheus/stages/coalesce.hpp>
 #include <morpheus/stages/deserialization.hpp>
+#include <morpheus/stages/drop_null.hpp>
 #include <morpheus/stages/file_source.hpp>
 #include <morpheus/stages/filter_detection.hpp>
+#include <morpheus/stages/forest_inference.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/stages/generate_viz_frames.hpp>
 #include <morpheus/stages/kafka_source.hpp>
+#include <morpheus/stages/load_generator_source.hpp>
+#include <morpheus/stages/monitor.hpp>
+#include <morpheus/stages/multi_file_source.hpp>
+#include <morpheus/stages/prefilter.hpp>
+#include <morpheus/stages/preprocess_ae.hpp>
 #include <morpheus/stages/preprocess_fil.hpp>
 #include <morpheus/stages/preprocess_nlp.hpp>
+#include <morpheus/stages/repartition.hpp>
 #include <morpheus/stages/serialize.hpp>
+#include <morpheus/stages/timeseries.hpp>
 #include <morpheus/stages/triton_inference.hpp>
+#include <morpheus/stages/ucx_source.hpp>
+#include <morpheus/stages/validation.hpp>
 #include <morpheus/stages/write_to_file.hpp>
+#include <morpheus/stages/write_to_kafka.hpp>
+#include <morpheus/stages/write_to_ucx.hpp>
 #include <morpheus/utilities/cudf_util.hpp>
 
 #include <neo/core/segment_object.hpp>
 
+#include <pybind11/stl.h>  // IWYU pragma: keep
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
 namespace morpheus {
 namespace py = pybind11;
 
+// Binds every FusedStage instantiation, so stages created by FusedStageBuilder::build reach python as their own type
+template <std::size_t... Indices>
+void bind_fused_stages(py::module& m, std::index_sequence<Indices...>)
+{
+    constexpr std::size_t count = std::variant_size_v<FusedStageMessage>;
+
+    auto bind = [&m](auto input_index, auto output_index) {
+        using stage_t = FusedStage<std::variant_alternative_t<decltype(input_index)::value, FusedStageMessage>,
+                                   std::variant_alternative_t<decltype(output_index)::value, FusedStageMessage>>;
+
+        // The type keeps pointing at its name
+        static const auto name = std::string("FusedStage_") +
+                                 FusedStageMessageNames[decltype(input_index)::value] + "_" +
+                                 FusedStageMessageNames[decltype(output_index)::value];
+
+        py::class_<stage_t, neo::SegmentObject, std::shared_ptr<stage_t>>(m, name.c_str(), py::multiple_inheritance());
+    };
+
+    (bind(std::integral_constant<std::size_t, Indices / count>{},
+          std::integral_constant<std::size_t, Indices % count>{}),
+     ...);
+}
+
 // Define the pybind11 module m, as 'pipeline'.
 PYBIND11_MODULE(stages, m)
 {
@@ -58,7 +109,8 @@ PYBIND11_MODULE(stages, m)
              py::arg("name"),
              py::arg("threshold"),
              py::arg("num_class_labels"),
-             py::arg("idx2label"));
+             py::arg("idx2label"),
+             py::arg("filter_threshold") = py::none());
 
     py::class_<AddScoresStage, neo::SegmentObject, std::shared_ptr<AddScoresStage>>(
         m, "AddScoresStage", py::multiple_inheritance())
@@ -68,6 +120,59 @@ PYBIND11_MODULE(stages, m)
              py::arg("num_class_labels"),
              py::arg("idx2label"));
 
+    py::class_<AdmissionStage, neo::SegmentObject, std::shared_ptr<AdmissionStage>>(
+        m, "AdmissionStage", py::multiple_inheritance())
+        .def(py::init<>(&AdmissionStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("key_column"),
+             py::arg("lanes"),
+             py::arg("lane_capacity"),
+             py::arg("protected_lanes"),
+             py::arg("latency_slo_ms"),
+             py::arg("shed_policy"),
+             py::arg("sample_fraction"))
+        .def_property_readonly("shed_counts", &AdmissionStage::shed_counts);
+
+    py::class_<AppShieldSourceStage, neo::SegmentObject, std::shared_ptr<AppShieldSourceStage>>(
+        m, "AppShieldSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&AppShieldSourceStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("plugins_include"),
+             py::arg("cols_include"),
+             py::arg("cols_exclude"),
+             py::arg("encoding")    = "latin1",
+             py::arg("num_threads") = 4);
+
+    py::class_<BufferStage, neo::SegmentObject, std::shared_ptr<BufferStage>>(
+        m, "BufferStage", py::multiple_inheritance())
+        .def(py::init<>(&BufferStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("count"),
+             py::arg("device_memory_budget"),
+             py::arg("host_memory_budget") = 0,
+             py::arg("compact_fraction")   = 0.0);
+
+    py::class_<CloudTrailSourceStage, neo::SegmentObject, std::shared_ptr<CloudTrailSourceStage>>(
+        m, "CloudTrailSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&CloudTrailSourceStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("user_column_name"),
+             py::arg("userid_filter") = "",
+             py::arg("repeat")        = 1,
+             py::arg("num_threads")   = 4);
+
+    py::class_<CoalesceStage, neo::SegmentObject, std::shared_ptr<CoalesceStage>>(
+        m, "CoalesceStage", py::multiple_inheritance())
+        .def(py::init<>(&CoalesceStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("batch_size"),
+             py::arg("timeout_ms"));
+
     py::class_<DeserializeStage, neo::SegmentObject, std::shared_ptr<DeserializeStage>>(
         m, "DeserializeStage", py::multiple_inheritance())
         .def(py::init<>(&DeserializeStageInterfaceProxy::init),
@@ -75,20 +180,61 @@ PYBIND11_MODULE(stages, m)
              py::arg("name"),
              py::arg("batch_size"));
 
+    py::class_<DropNullStage, neo::SegmentObject, std::shared_ptr<DropNullStage>>(
+        m, "DropNullStage", py::multiple_inheritance())
+        .def(py::init<>(&DropNullStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("column"));
+
     py::class_<FileSourceStage, neo::SegmentObject, std::shared_ptr<FileSourceStage>>(
         m, "FileSourceStage", py::multiple_inheritance())
         .def(py::init<>(&FileSourceStageInterfaceProxy::init),
              py::arg("parent"),
              py::arg("name"),
              py::arg("filename"),
-             py::arg("repeat"));
+             py::arg("repeat"),
+             py::arg("chunk_bytes")    = 0,
+             py::arg("use_mmap")       = false,
+             py::arg("output_columns") = std::map<std::string, std::string>());
 
     py::class_<FilterDetectionsStage, neo::SegmentObject, std::shared_ptr<FilterDetectionsStage>>(
         m, "FilterDetectionsStage", py::multiple_inheritance())
         .def(py::init<>(&FilterDetectionStageInterfaceProxy::init),
              py::arg("parent"),
              py::arg("name"),
-             py::arg("threshold"));
+             py::arg("threshold"),
+             py::arg("copy") = false);
+
+    py::class_<ForestInferenceStage, neo::SegmentObject, std::shared_ptr<ForestInferenceStage>>(
+        m, "ForestInferenceStage", py::multiple_inheritance())
+        .def(py::init<>(&ForestInferenceStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("model_filename"));
+
+    bind_fused_stages(m, std::make_index_sequence<std::variant_size_v<FusedStageMessage> *
+                                                  std::variant_size_v<FusedStageMessage>>());
+
+    py::class_<FusedStageBuilder, std::shared_ptr<FusedStageBuilder>>(m, "FusedStageBuilder")
+        .def(py::init<>())
+        .def("begin_capture", &FusedStageBuilder::begin_capture)
+        .def("end_capture", &FusedStageBuilder::end_capture)
+        .def("__len__", &FusedStageBuilder::size)
+        .def("build",
+             &FusedStageBuilder::build,
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("device_ids") = std::vector<int>());
+
+    py::class_<GenerateVizFramesStage, neo::SegmentObject, std::shared_ptr<GenerateVizFramesStage>>(
+        m, "GenerateVizFramesStage", py::multiple_inheritance())
+        .def(py::init<>(&GenerateVizFramesStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("out_dir"),
+             py::arg("out_socket"),
+             py::arg("labels"));
 
     py::class_<InferenceClientStage, neo::SegmentObject, std::shared_ptr<InferenceClientStage>>(
         m, "InferenceClientStage", py::multiple_inheritance())
@@ -100,7 +246,15 @@ PYBIND11_MODULE(stages, m)
              py::arg("force_convert_inputs"),
              py::arg("use_shared_memory"),
              py::arg("needs_logits"),
-             py::arg("inout_mapping") = py::dict());
+             py::arg("inout_mapping")           = py::dict(),
+             py::arg("max_concurrent_requests") = 1,
+             py::arg("protocol")                = "http",
+             py::arg("length_bucketing")        = false,
+             py::arg("device_id")               = -1,
+             py::arg("batch_timeout_ms")        = 0,
+             py::arg("cache_size")              = 0,
+             py::arg("window_reduction")        = "max",
+             py::arg("warmup")                  = false);
 
     py::class_<KafkaSourceStage, neo::SegmentObject, std::shared_ptr<KafkaSourceStage>>(
         m, "KafkaSourceStage", py::multiple_inheritance())
@@ -108,11 +262,119 @@ PYBIND11_MODULE(stages, m)
              py::arg("parent"),
              py::arg("name"),
              py::arg("max_batch_size"),
-             py::arg("topic"),
+             py::arg("topics"),
              py::arg("batch_timeout_ms"),
              py::arg("config"),
              py::arg("disable_commits")       = false,
-             py::arg("disable_pre_filtering") = false);
+             py::arg("disable_pre_filtering") = false,
+             py::arg("max_batch_bytes")       = 0,
+             py::arg("adaptive_batching")     = false,
+             py::arg("commit_on_completion")  = false,
+             py::arg("topic_column")          = "",
+             py::arg("start_timestamp_ms")    = -1,
+             py::arg("start_offsets")         = std::map<std::string, int64_t>(),
+             py::arg("stop_timestamp_ms")     = -1,
+             py::arg("device_id")             = -1,
+             py::arg("drop_null_column")      = "",
+             py::arg("output_columns")        = std::map<std::string, std::string>(),
+             py::arg("schema")                = std::map<std::string, std::string>(),
+             py::arg("schema_batches")        = 0,
+             py::arg("message_format")        = "json",
+             py::arg("avro_schema")           = "",
+             py::arg("schema_registry_url")   = "",
+             py::arg("metadata_columns")      = std::vector<std::string>(),
+             py::arg("max_in_flight_batches") = 0)
+        .def_property_readonly("rejected_message_count", &KafkaSourceStage::rejected_message_count)
+        .def_property_readonly("in_flight_batch_count", &KafkaSourceStage::in_flight_batch_count);
+
+    py::class_<LoadGeneratorSourceStage, neo::SegmentObject, std::shared_ptr<LoadGeneratorSourceStage>>(
+        m, "LoadGeneratorSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&LoadGeneratorSourceStageInterfaceProxy::init_from_file),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("filename"),
+             py::arg("rows_per_second") = 0.0,
+             py::arg("batch_size")      = 256,
+             py::arg("distribution")    = "fixed",
+             py::arg("jitter")          = 0.0,
+             py::arg("mutate_columns")  = std::vector<std::string>(),
+             py::arg("total_rows")      = 0,
+             py::arg("duration_sec")    = 0.0,
+             py::arg("trace_all")       = false,
+             py::arg("seed")            = 0,
+             py::arg("output_columns")  = std::map<std::string, std::string>())
+        .def(py::init<>(&LoadGeneratorSourceStageInterfaceProxy::init_from_meta),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("template"),
+             py::arg("rows_per_second") = 0.0,
+             py::arg("batch_size")      = 256,
+             py::arg("distribution")    = "fixed",
+             py::arg("jitter")          = 0.0,
+             py::arg("mutate_columns")  = std::vector<std::string>(),
+             py::arg("total_rows")      = 0,
+             py::arg("duration_sec")    = 0.0,
+             py::arg("trace_all")       = false,
+             py::arg("seed")            = 0,
+             py::arg("output_columns")  = std::map<std::string, std::string>())
+        .def_property_readonly("rows_emitted", &LoadGeneratorSourceStage::rows_emitted)
+        .def_property_readonly("max_lag_ns", &LoadGeneratorSourceStage::max_lag_ns);
+
+    py::class_<MonitorStage<MessageMeta>, neo::SegmentObject, std::shared_ptr<MonitorStage<MessageMeta>>>(
+        m, "MonitorMessageMetaStage", py::multiple_inheritance())
+        .def(py::init<>(&MonitorStageInterfaceProxy<MessageMeta>::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("description"),
+             py::arg("unit")            = "messages",
+             py::arg("log_interval_ms") = 1000);
+
+    py::class_<MonitorStage<MultiMessage>, neo::SegmentObject, std::shared_ptr<MonitorStage<MultiMessage>>>(
+        m, "MonitorMultiMessageStage", py::multiple_inheritance())
+        .def(py::init<>(&MonitorStageInterfaceProxy<MultiMessage>::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("description"),
+             py::arg("unit")            = "messages",
+             py::arg("log_interval_ms") = 1000);
+
+    py::class_<MultiFileSourceStage, neo::SegmentObject, std::shared_ptr<MultiFileSourceStage>>(
+        m, "MultiFileSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&MultiFileSourceStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("filenames"),
+             py::arg("prefetch")       = 4,
+             py::arg("ordered")        = true,
+             py::arg("output_columns") = std::map<std::string, std::string>());
+
+    py::class_<PrefilterMergeStage, neo::SegmentObject, std::shared_ptr<PrefilterMergeStage>>(
+        m, "PrefilterMergeStage", py::multiple_inheritance())
+        .def(py::init<>(&PrefilterMergeStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("prefilter"));
+
+    py::class_<PrefilterStage, neo::SegmentObject, std::shared_ptr<PrefilterStage>>(
+        m, "PrefilterStage", py::multiple_inheritance())
+        .def(py::init<>(&PrefilterStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("column"),
+             py::arg("patterns"),
+             py::arg("literals"),
+             py::arg("label_columns"),
+             py::arg("forward_benign"),
+             py::arg("benign_queue_size"))
+        .def_property_readonly("benign_count", &PrefilterStage::benign_count);
+
+    py::class_<PreprocessAEStage, neo::SegmentObject, std::shared_ptr<PreprocessAEStage>>(
+        m, "PreprocessAEStage", py::multiple_inheritance())
+        .def(py::init<>(&PreprocessAEStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("features"),
+             py::arg("scaling_file") = "");
 
     py::class_<PreprocessFILStage, neo::SegmentObject, std::shared_ptr<PreprocessFILStage>>(
         m, "PreprocessFILStage", py::multiple_inheritance())
@@ -133,6 +395,24 @@ PYBIND11_MODULE(stages, m)
              py::arg("add_special_token"),
              py::arg("stride"));
 
+    py::class_<RepartitionShardSource, neo::SegmentObject, std::shared_ptr<RepartitionShardSource>>(
+        m, "RepartitionShardSource", py::multiple_inheritance())
+        .def(py::init<>(&RepartitionShardSourceInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("stage"),
+             py::arg("shard"));
+
+    py::class_<RepartitionStage, neo::SegmentObject, std::shared_ptr<RepartitionStage>>(
+        m, "RepartitionStage", py::multiple_inheritance())
+        .def(py::init<>(&RepartitionStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("key_column"),
+             py::arg("num_shards"),
+             py::arg("shard_queue_size") = 16)
+        .def_property_readonly("num_shards", &RepartitionStage::num_shards);
+
     py::class_<SerializeStage, neo::SegmentObject, std::shared_ptr<SerializeStage>>(
         m, "SerializeStage", py::multiple_inheritance())
         .def(py::init<>(&SerializeStageInterfaceProxy::init),
@@ -140,7 +420,45 @@ PYBIND11_MODULE(stages, m)
              py::arg("name"),
              py::arg("include"),
              py::arg("exclude"),
-             py::arg("fixed_columns") = true);
+             py::arg("fixed_columns")    = true,
+             py::arg("compact_fraction") = 0.0);
+
+    py::class_<TimeSeriesStage, neo::SegmentObject, std::shared_ptr<TimeSeriesStage>>(
+        m, "TimeSeriesStage", py::multiple_inheritance())
+        .def(py::init<>(&TimeSeriesStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("resolution_sec"),
+             py::arg("min_window_sec"),
+             py::arg("hot_start"),
+             py::arg("cold_end"),
+             py::arg("filter_percent"),
+             py::arg("zscore_threshold"),
+             py::arg("user_column"));
+
+    py::class_<UcxSourceStage, neo::SegmentObject, std::shared_ptr<UcxSourceStage>>(
+        m, "UcxSourceStage", py::multiple_inheritance())
+        .def(py::init<>(&UcxSourceStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("address"),
+             py::arg("port"),
+             py::arg("num_senders")    = 1,
+             py::arg("output_columns") = std::map<std::string, std::string>());
+
+    py::class_<ValidationStage, neo::SegmentObject, std::shared_ptr<ValidationStage>>(
+        m, "ValidationStage", py::multiple_inheritance())
+        .def(py::init<>(&ValidationStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("val_file_name"),
+             py::arg("results_file_name"),
+             py::arg("include"),
+             py::arg("exclude"),
+             py::arg("index_col"),
+             py::arg("abs_tol"),
+             py::arg("rel_tol"),
+             py::arg("max_samples") = 20);
 
     py::class_<WriteToFileStage, neo::SegmentObject, std::shared_ptr<WriteToFileStage>>(
         m, "WriteToFileStage", py::multiple_inheritance())
@@ -148,8 +466,32 @@ PYBIND11_MODULE(stages, m)
              py::arg("parent"),
              py::arg("name"),
              py::arg("filename"),
-             py::arg("mode")      = "w",
-             py::arg("file_type") = 0);  // Setting this to FileTypes::AUTO throws a conversion error at runtime
+             py::arg("mode")               = "w",
+             py::arg("file_type")          = 0,  // Setting this to FileTypes::AUTO throws a conversion error at runtime
+             py::arg("compression")        = "",
+             py::arg("queue_size")         = 0,
+             py::arg("flush_policy")       = "flush",
+             py::arg("rotate_bytes")       = 0,
+             py::arg("rotate_seconds")     = 0,
+             py::arg("rotate_compression") = "");
+
+    py::class_<WriteToKafkaStage, neo::SegmentObject, std::shared_ptr<WriteToKafkaStage>>(
+        m, "WriteToKafkaStage", py::multiple_inheritance())
+        .def(py::init<>(&WriteToKafkaStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("topic"),
+             py::arg("config"))
+        .def_property_readonly("delivered_message_count", &WriteToKafkaStage::delivered_message_count)
+        .def_property_readonly("failed_message_count", &WriteToKafkaStage::failed_message_count);
+
+    py::class_<WriteToUcxStage, neo::SegmentObject, std::shared_ptr<WriteToUcxStage>>(
+        m, "WriteToUcxStage", py::multiple_inheritance())
+        .def(py::init<>(&WriteToUcxStageInterfaceProxy::init),
+             py::arg("parent"),
+             py::arg("name"),
+             py::arg("host"),
+             py::arg("port"));
 
 #ifdef VERSION_INFO
     m.attr("__version__") = MACRO_STRINGIFY(VERSION_INFO);
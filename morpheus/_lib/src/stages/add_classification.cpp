@@ -17,12 +17,22 @@
 
 #include <morpheus/stages/add_classification.hpp>
 
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/host_memory.hpp>
 #include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace morpheus {
 // Component public implementations
@@ -31,12 +41,15 @@ AddClassificationsStage::AddClassificationsStage(const neo::Segment& parent,
                                                  const std::string& name,
                                                  float threshold,
                                                  std::size_t num_class_labels,
-                                                 std::map<std::size_t, std::string> idx2label) :
+                                                 std::map<std::size_t, std::string> idx2label,
+                                                 std::optional<float> filter_threshold) :
   neo::SegmentObject(parent, name),
   PythonNode(parent, name, build_operator()),
   m_threshold(threshold),
   m_num_class_labels(num_class_labels),
-  m_idx2label(std::move(idx2label))
+  m_idx2label(std::move(idx2label)),
+  m_filter_threshold(filter_threshold),
+  m_metrics(StageMetrics::get(name))
 {
     CHECK(m_idx2label.size() <= m_num_class_labels) << "idx2label should represent a subset of the class_labels";
 }
@@ -46,48 +59,52 @@ AddClassificationsStage::operator_fn_t AddClassificationsStage::build_operator()
     return [this](neo::Observable<reader_type_t>& input, neo::Subscriber<writer_type_t>& output) {
         return input.subscribe(neo::make_observer<reader_type_t>(
             [this, &output](reader_type_t&& x) {
-                const auto& probs  = x->get_probs();
-                const auto& shape  = probs.get_shape();
-                const auto& stride = probs.get_stride();
+                DeviceMemory::ScopedTag memory_tag("AddClassificationsStage");
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                const auto& probs = x->get_probs();
+                const auto& shape = probs.get_shape();
 
                 CHECK(shape.size() == 2 && shape[1] == m_num_class_labels)
                     << "Label count does not match output of model. Label count: " << m_num_class_labels
                     << ", Model output: " << shape[1];
 
-                const std::size_t num_rows    = shape[0];
-                const std::size_t num_columns = shape[1];
+                const std::size_t num_rows = shape[0];
 
-                // A bit ugly, but we cant get access to the rmm::device_buffer here. So make a copy
-                auto tmp_buffer = std::make_shared<rmm::device_buffer>(probs.bytes(), rmm::cuda_stream_per_thread);
+                DevMemInfo labels;
+                PinnedHostBuffer host_rows_above;
 
-                NEO_CHECK_CUDA(
-                    cudaMemcpy(tmp_buffer->data(), probs.data(), tmp_buffer->size(), cudaMemcpyDeviceToDevice));
+                if (m_filter_threshold.has_value())
+                {
+                    // One pass finds both the labels and the rows to keep
+                    auto results = MatxUtil::threshold_with_row_any(probs, m_threshold, *m_filter_threshold);
 
-                // Depending on the input the stride is given in bytes or elements,
-                // divide the stride elements by the smallest item to ensure tensor_stride is defined in
-                // terms of elements
-                std::vector<TensorIndex> tensor_stride(stride.size());
-                auto min_stride = std::min_element(stride.cbegin(), stride.cend());
+                    labels = results[0];
 
-                std::transform(stride.cbegin(),
-                               stride.cend(),
-                               tensor_stride.begin(),
-                               std::bind(std::divides<>(), std::placeholders::_1, *min_stride));
+                    host_rows_above = PinnedHostPool::acquire(num_rows * sizeof(bool));
 
-                // Now call the threshold function
-                auto thresh_bool_buffer =
-                    MatxUtil::threshold(DevMemInfo{probs.count(), probs.dtype().type_id(), tmp_buffer, 0},
-                                        num_rows,
-                                        num_columns,
-                                        tensor_stride,
-                                        m_threshold,
-                                        false);
+                    NEO_CHECK_CUDA(cudaMemcpyAsync(host_rows_above.data(),
+                                                   results[1].data(),
+                                                   num_rows * sizeof(bool),
+                                                   cudaMemcpyDeviceToHost,
+                                                   results[1].stream().value()));
 
+                    NEO_CHECK_CUDA(cudaStreamSynchronize(results[1].stream().value()));
+                }
+                else
+                {
+                    // Threshold straight from probs, the result is a new row-major bool buffer
+                    labels = DevMemInfo{
+                        probs.count(), TypeId::BOOL8, MatxUtil::threshold(probs, m_threshold, false), 0};
+                }
+
+                // Offsets are in elements, which are bytes for bool
                 auto tensor_obj = Tensor::create(
-                    thresh_bool_buffer,
+                    labels.buffer,
                     DType::create<bool>(),
                     std::vector<TensorIndex>{static_cast<long long>(shape[0]), static_cast<long long>(shape[1])},
-                    tensor_stride);
+                    std::vector<TensorIndex>{},
+                    labels.offset);
 
                 std::vector<std::string> columns(m_idx2label.size());
                 std::vector<TensorObject> tensors(m_idx2label.size());
@@ -105,7 +122,40 @@ AddClassificationsStage::operator_fn_t AddClassificationsStage::build_operator()
 
                 x->set_meta(columns, tensors);
 
-                output.on_next(x);
+                if (!m_filter_threshold.has_value())
+                {
+                    metrics_scope.emit(output, x);
+                    return;
+                }
+
+                // Same as FilterDetectionsStage. Using num_rows as our marker for undefined
+                std::vector<std::pair<std::size_t, std::size_t>> ranges;
+                std::size_t slice_start = num_rows;
+                for (std::size_t row = 0; row < num_rows; ++row)
+                {
+                    bool above_threshold = host_rows_above.data()[row];
+
+                    if (above_threshold && slice_start == num_rows)
+                    {
+                        slice_start = row;
+                    }
+                    else if (!above_threshold && slice_start != num_rows)
+                    {
+                        ranges.emplace_back(slice_start, row);
+                        slice_start = num_rows;
+                    }
+                }
+
+                if (slice_start != num_rows)
+                {
+                    // Last row was above the threshold
+                    ranges.emplace_back(slice_start, num_rows);
+                }
+
+                for (auto& slice : x->get_slices(ranges))
+                {
+                    metrics_scope.emit(output, std::move(slice));
+                }
             },
             [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
             [&]() { output.on_completed(); }));
@@ -118,11 +168,13 @@ std::shared_ptr<AddClassificationsStage> AddClassificationStageInterfaceProxy::i
     const std::string& name,
     float threshold,
     std::size_t num_class_labels,
-    std::map<std::size_t, std::string> idx2label)
+    std::map<std::size_t, std::string> idx2label,
+    std::optional<float> filter_threshold)
 {
-    auto stage = std::make_shared<AddClassificationsStage>(parent, name, threshold, num_class_labels, idx2label);
+    auto stage = std::make_shared<AddClassificationsStage>(
+        parent, name, threshold, num_class_labels, idx2label, filter_threshold);
 
-    parent.register_node<AddClassificationsStage>(stage);
+    FusedStageBuilder::register_node(parent, stage);
 
     return stage;
 }
@@ -17,12 +17,18 @@
 
 #include <morpheus/stages/add_scores.hpp>
 
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/utilities/device_memory.hpp>
 #include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
 
 #include <cstddef>
 #include <exception>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace morpheus {
 // Component public implementations
@@ -34,7 +40,8 @@ AddScoresStage::AddScoresStage(const neo::Segment& parent,
   neo::SegmentObject(parent, name),
   PythonNode(parent, name, build_operator()),
   m_num_class_labels(num_class_labels),
-  m_idx2label(std::move(idx2label))
+  m_idx2label(std::move(idx2label)),
+  m_metrics(StageMetrics::get(name))
 {
     CHECK(m_idx2label.size() <= m_num_class_labels) << "idx2label should represent a subset of the class_labels";
 }
@@ -44,56 +51,31 @@ AddScoresStage::operator_fn_t AddScoresStage::build_operator()
     return [this](neo::Observable<reader_type_t>& input, neo::Subscriber<writer_type_t>& output) {
         return input.subscribe(neo::make_observer<reader_type_t>(
             [this, &output](reader_type_t&& x) {
-                const auto& probs  = x->get_probs();
-                const auto& shape  = probs.get_shape();
-                const auto& stride = probs.get_stride();
+                DeviceMemory::ScopedTag memory_tag("AddScoresStage");
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
 
-                CHECK(shape.size() == 2 && shape[1] == m_num_class_labels)
-                    << "Label count does not match output of model. Label count: " << m_num_class_labels
-                    << ", Model output: " << shape[1];
-
-                const std::size_t num_rows    = shape[0];
-                const std::size_t num_columns = shape[1];
-
-                auto tmp_buffer = std::make_shared<rmm::device_buffer>(probs.bytes(), rmm::cuda_stream_per_thread);
-
-                NEO_CHECK_CUDA(
-                    cudaMemcpy(tmp_buffer->data(), probs.data(), tmp_buffer->size(), cudaMemcpyDeviceToDevice));
+                const auto& probs = x->get_probs();
 
-                // Depending on the input the stride is given in bytes or elements,
-                // divide the stride elements by the smallest item to ensure tensor_stride is defined in
-                // terms of elements
-                std::vector<TensorIndex> tensor_stride(stride.size());
-                auto min_stride = std::min_element(stride.cbegin(), stride.cend());
-
-                std::transform(stride.cbegin(),
-                               stride.cend(),
-                               tensor_stride.begin(),
-                               std::bind(std::divides<>(), std::placeholders::_1, *min_stride));
+                CHECK(probs.rank() == 2 && static_cast<std::size_t>(probs.shape(1)) == m_num_class_labels)
+                    << "Label count does not match output of model. Label count: " << m_num_class_labels
+                    << ", Model output: " << (probs.rank() == 2 ? probs.shape(1) : 0);
 
-                auto tensor_obj = Tensor::create(
-                    tmp_buffer,
-                    probs.dtype(),
-                    std::vector<TensorIndex>{static_cast<long long>(shape[0]), static_cast<long long>(shape[1])},
-                    tensor_stride);
+                std::vector<std::string> columns;
+                std::vector<std::size_t> tensor_columns;
 
-                std::vector<std::string> columns(m_idx2label.size());
-                std::vector<TensorObject> tensors(m_idx2label.size());
+                columns.reserve(m_idx2label.size());
+                tensor_columns.reserve(m_idx2label.size());
 
-                std::size_t i = 0;
+                // Columns are copied straight out of probs, no per label slice is created
                 for (const auto& [column_num, column_name] : m_idx2label)
                 {
-                    columns[i] = column_name;
-                    tensors[i] = tensor_obj.slice(std::vector<TensorIndex>{0, static_cast<TensorIndex>(column_num)},
-                                                  std::vector<TensorIndex>{static_cast<TensorIndex>(num_rows),
-                                                                           static_cast<TensorIndex>(column_num + 1)});
-
-                    ++i;
+                    columns.push_back(column_name);
+                    tensor_columns.push_back(column_num);
                 }
 
-                x->set_meta(columns, tensors);
+                x->set_meta(columns, probs, tensor_columns);
 
-                output.on_next(x);
+                metrics_scope.emit(output, x);
             },
             [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
             [&]() { output.on_completed(); }));
@@ -108,7 +90,7 @@ std::shared_ptr<AddScoresStage> AddScoresStageInterfaceProxy::init(neo::Segment&
 {
     auto stage = std::make_shared<AddScoresStage>(parent, name, num_class_labels, idx2label);
 
-    parent.register_node<AddScoresStage>(stage);
+    FusedStageBuilder::register_node(parent, stage);
 
     return stage;
 }
@@ -0,0 +1,410 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/admission.hpp>
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <neo/core/segment_object.hpp>
+
+#include <cudf/binaryop.hpp>
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/column/column_view.hpp>
+#include <cudf/copying.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/partitioning.hpp>
+#include <cudf/reduction.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>
+#include <cudf/utilities/traits.hpp>
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ AdmissionStage__State ************ //
+struct AdmissionStage__Entry
+{
+    std::shared_ptr<MultiMessage> message;
+    std::chrono::steady_clock::time_point enqueued;
+};
+
+/**
+ * @brief Lane queues shared between the operator, which fills them, and the dispatch fiber, which drains them
+ * highest priority first. Both only touch the queues while holding `mutex`.
+ */
+struct AdmissionStage__State
+{
+    boost::fibers::mutex mutex;
+    boost::fibers::condition_variable cv;
+
+    std::vector<std::deque<AdmissionStage__Entry>> lanes;
+
+    // Messages of each lane which were candidates for shedding, used to sample them evenly
+    std::vector<std::size_t> shed_candidates;
+
+    bool done{false};     // Set once the input completed or failed
+    bool stopped{false};  // Set once the dispatch fiber drained the queues and exited
+};
+
+// Component-private free functions.
+/**
+ * @brief Rows of `key` equal to `value`, compared as a string or as an integer depending on the type of `key`.
+ */
+std::unique_ptr<cudf::column> AdmissionStage__key_matches(const cudf::column_view &key, const std::string &value)
+{
+    const auto bool_type = cudf::data_type{cudf::type_id::BOOL8};
+
+    if (key.type().id() == cudf::type_id::STRING)
+    {
+        return cudf::binary_operation(key, cudf::string_scalar(value), cudf::binary_operator::EQUAL, bool_type);
+    }
+
+    if (cudf::is_integral(key.type()))
+    {
+        return cudf::binary_operation(
+            key, cudf::numeric_scalar<int64_t>(std::stoll(value)), cudf::binary_operator::EQUAL, bool_type);
+    }
+
+    throw std::invalid_argument("Priority lane keys must be strings or integers");
+}
+
+/**
+ * @brief Lane of every row of `key`, the first lane whose value it equals or `lanes.size()` when it matches none.
+ */
+std::unique_ptr<cudf::column> AdmissionStage__lane_map(const cudf::column_view &key,
+                                                       const std::vector<std::string> &lanes)
+{
+    auto lane_map = cudf::make_column_from_scalar(cudf::numeric_scalar<int32_t>(lanes.size()), key.size());
+
+    // From the lowest priority up, so a row matching several lanes ends in the highest one
+    for (auto lane = lanes.size(); lane-- > 0;)
+    {
+        auto matches = AdmissionStage__key_matches(key, lanes[lane]);
+
+        lane_map = cudf::copy_if_else(cudf::numeric_scalar<int32_t>(lane), lane_map->view(), matches->view());
+    }
+
+    return lane_map;
+}
+
+/**
+ * @brief Splits `message` into one message per lane its rows fall in, paired with their lane.
+ */
+std::vector<std::pair<std::size_t, std::shared_ptr<MultiMessage>>> AdmissionStage__split(
+    const std::shared_ptr<MultiMessage> &message,
+    const std::string &key_column,
+    const std::vector<std::string> &lanes)
+{
+    const auto default_lane = lanes.size();
+
+    auto info    = message->get_meta();
+    auto key_idx = info.get_schema()->find_column(key_column);
+
+    if (key_idx < 0 || lanes.empty())
+    {
+        return {{default_lane, message}};
+    }
+
+    const auto &view = info.get_view();
+
+    MORPHEUS_DEVICE_RANGE("AdmissionStage::split");
+
+    auto lane_map = AdmissionStage__lane_map(view.column(info.num_indices() + key_idx), lanes);
+
+    auto [min_lane, max_lane] = cudf::minmax(lane_map->view());
+
+    auto first_lane = static_cast<cudf::numeric_scalar<int32_t> &>(*min_lane).value();
+    auto last_lane  = static_cast<cudf::numeric_scalar<int32_t> &>(*max_lane).value();
+
+    if (first_lane == last_lane)
+    {
+        // The common case during a storm of a single source, nothing to regroup
+        return {{static_cast<std::size_t>(first_lane), message}};
+    }
+
+    // Rows keep their relative order within each partition
+    auto num_lanes              = static_cast<cudf::size_type>(lanes.size() + 1);
+    auto [partitioned, offsets] = cudf::partition(view, lane_map->view(), num_lanes);
+
+    const auto num_rows = partitioned->num_rows();
+
+    // Same layout as SerializeStage, index columns first
+    auto column_names = info.get_index_names();
+    auto data_columns = info.get_column_names();
+    column_names.insert(column_names.end(), data_columns.begin(), data_columns.end());
+
+    cudf::io::table_with_metadata table{std::move(partitioned), cudf::io::table_metadata{}};
+    table.metadata.column_names = std::move(column_names);
+
+    auto meta = MessageMeta::create_from_cpp(std::move(table), info.num_indices());
+
+    meta->inherit_completions(*message->meta);
+
+    std::vector<std::pair<std::size_t, std::shared_ptr<MultiMessage>>> lane_messages;
+
+    for (std::size_t lane = 0; lane < offsets.size(); ++lane)
+    {
+        auto start = offsets[lane];
+        auto stop  = lane + 1 < offsets.size() ? offsets[lane + 1] : num_rows;
+
+        if (stop > start)
+        {
+            lane_messages.emplace_back(lane, std::make_shared<MultiMessage>(meta, start, stop - start));
+        }
+    }
+
+    return lane_messages;
+}
+
+/**
+ * @brief Whether a message which is a candidate for shedding is shed. Sampling keeps `sample_fraction` of the
+ * candidates of a lane, spread evenly
+ */
+bool AdmissionStage__is_shed(bool sample, double sample_fraction, std::size_t &candidate_count)
+{
+    if (!sample)
+    {
+        return true;
+    }
+
+    auto candidate = static_cast<double>(candidate_count++);
+
+    return std::floor((candidate + 1) * sample_fraction) == std::floor(candidate * sample_fraction);
+}
+
+// Component public implementations
+// ************ AdmissionStage **************************** //
+AdmissionStage::AdmissionStage(const neo::Segment &parent,
+                               const std::string &name,
+                               std::string key_column,
+                               std::vector<std::string> lanes,
+                               std::size_t lane_capacity,
+                               std::size_t protected_lanes,
+                               int32_t latency_slo_ms,
+                               std::string shed_policy,
+                               double sample_fraction) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_key_column(std::move(key_column)),
+  m_lanes(std::move(lanes)),
+  m_lane_capacity(lane_capacity),
+  m_protected_lanes(protected_lanes),
+  m_latency_slo_ms(latency_slo_ms),
+  m_sample(shed_policy == "sample"),
+  m_sample_fraction(sample_fraction),
+  m_shed_rows(m_lanes.size() + 1),
+  m_metrics(StageMetrics::get(name))
+{
+    CHECK(m_lane_capacity > 0) << "AdmissionStage lane_capacity must be greater than 0";
+
+    if (shed_policy != "drop" && shed_policy != "sample")
+    {
+        throw std::invalid_argument("Unknown shed policy '" + shed_policy + "'. Must be one of 'drop' or 'sample'");
+    }
+
+    if (m_sample_fraction < 0.0 || m_sample_fraction > 1.0)
+    {
+        throw std::invalid_argument("AdmissionStage sample_fraction must be between 0 and 1");
+    }
+}
+
+std::vector<std::size_t> AdmissionStage::shed_counts() const
+{
+    std::vector<std::size_t> counts;
+
+    for (const auto &count : m_shed_rows)
+    {
+        counts.push_back(count.load());
+    }
+
+    return counts;
+}
+
+AdmissionStage::operator_fn_t AdmissionStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        auto state = std::make_shared<AdmissionStage__State>();
+
+        state->lanes.resize(m_lanes.size() + 1);
+        state->shed_candidates.resize(m_lanes.size() + 1);
+
+        const auto latency_slo = std::chrono::milliseconds(m_latency_slo_ms);
+
+        // Emits the queued messages, always from the highest priority lane holding any
+        boost::fibers::fiber([this, state, latency_slo, &output]() {
+            std::unique_lock<boost::fibers::mutex> lock(state->mutex);
+
+            while (true)
+            {
+                auto queued = [&]() {
+                    return std::find_if(state->lanes.begin(), state->lanes.end(), [](const auto &queue) {
+                        return !queue.empty();
+                    });
+                };
+
+                state->cv.wait(lock, [&]() { return state->done || queued() != state->lanes.end(); });
+
+                auto found = queued();
+
+                if (found == state->lanes.end())
+                {
+                    // Done and drained
+                    break;
+                }
+
+                const std::size_t lane = found - state->lanes.begin();
+
+                auto entry = std::move(found->front());
+                found->pop_front();
+
+                // Room for an input blocked on a full protected lane
+                state->cv.notify_all();
+
+                const bool late = m_latency_slo_ms > 0 && lane >= m_protected_lanes &&
+                                  std::chrono::steady_clock::now() - entry.enqueued > latency_slo;
+
+                if (late && AdmissionStage__is_shed(m_sample, m_sample_fraction, state->shed_candidates[lane]))
+                {
+                    m_shed_rows[lane] += entry.message->mess_count;
+                    continue;
+                }
+
+                // Emitting can block on the downstream, let the input keep queueing meanwhile
+                lock.unlock();
+                m_metrics->emit(output, std::move(entry.message));
+                lock.lock();
+            }
+
+            state->stopped = true;
+            state->cv.notify_all();
+        }).detach();
+
+        // Stops the dispatch fiber once it emitted everything still queued
+        auto stop_dispatch = [state]() {
+            std::unique_lock<boost::fibers::mutex> lock(state->mutex);
+
+            state->done = true;
+            state->cv.notify_all();
+
+            state->cv.wait(lock, [&]() { return state->stopped; });
+        };
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, state](reader_type_t &&x) {
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                DeviceMemory::ScopedTag memory_tag("AdmissionStage");
+
+                // Regrouped outside the lock so the dispatch fiber keeps emitting meanwhile
+                auto lane_messages = AdmissionStage__split(x, m_key_column, m_lanes);
+
+                std::unique_lock<boost::fibers::mutex> lock(state->mutex);
+
+                const auto enqueued = std::chrono::steady_clock::now();
+
+                for (auto &[lane, message] : lane_messages)
+                {
+                    auto &queue = state->lanes[lane];
+
+                    if (lane < m_protected_lanes)
+                    {
+                        state->cv.wait(lock, [&]() { return queue.size() < m_lane_capacity || state->done; });
+                    }
+                    else if (queue.size() >= m_lane_capacity)
+                    {
+                        // The oldest message is the furthest past its deadline
+                        m_shed_rows[lane] += queue.front().message->mess_count;
+                        queue.pop_front();
+                    }
+
+                    queue.push_back(AdmissionStage__Entry{std::move(message), enqueued});
+                }
+
+                state->cv.notify_all();
+            },
+            [state, stop_dispatch, &output](std::exception_ptr error_ptr) {
+                {
+                    std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+
+                    for (auto &queue : state->lanes)
+                    {
+                        queue.clear();
+                    }
+                }
+
+                stop_dispatch();
+
+                output.on_error(error_ptr);
+            },
+            [stop_dispatch, &output]() {
+                stop_dispatch();
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ AdmissionStageInterfaceProxy ************* //
+std::shared_ptr<AdmissionStage> AdmissionStageInterfaceProxy::init(neo::Segment &parent,
+                                                                   const std::string &name,
+                                                                   std::string key_column,
+                                                                   std::vector<std::string> lanes,
+                                                                   std::size_t lane_capacity,
+                                                                   std::size_t protected_lanes,
+                                                                   int32_t latency_slo_ms,
+                                                                   std::string shed_policy,
+                                                                   double sample_fraction)
+{
+    auto stage = std::make_shared<AdmissionStage>(parent,
+                                                  name,
+                                                  std::move(key_column),
+                                                  std::move(lanes),
+                                                  lane_capacity,
+                                                  protected_lanes,
+                                                  latency_slo_ms,
+                                                  std::move(shed_policy),
+                                                  sample_fraction);
+
+    parent.register_node<AdmissionStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
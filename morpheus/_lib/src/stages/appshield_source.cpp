@@ -0,0 +1,557 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/appshield_source.hpp>
+
+#include <morpheus/io/mapped_file.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <neo/core/segment_object.hpp>
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/null_mask.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ AppShieldSourceStage__Strings ************ //
+/**
+ * @brief Host side strings column, built row by row then copied to the device at once.
+ */
+struct AppShieldSourceStage__Strings
+{
+    std::string chars;
+    std::vector<cudf::size_type> offsets{0};
+    std::vector<bool> valid;
+    cudf::size_type null_count{0};
+
+    void push(const char *data, std::size_t size)
+    {
+        chars.append(data, size);
+        offsets.push_back(static_cast<cudf::size_type>(chars.size()));
+        valid.push_back(true);
+    }
+
+    void push_null()
+    {
+        offsets.push_back(static_cast<cudf::size_type>(chars.size()));
+        valid.push_back(false);
+        ++null_count;
+    }
+
+    void append(const AppShieldSourceStage__Strings &other)
+    {
+        const auto base = static_cast<cudf::size_type>(chars.size());
+
+        chars += other.chars;
+
+        for (std::size_t i = 1; i < other.offsets.size(); ++i)
+        {
+            offsets.push_back(base + other.offsets[i]);
+        }
+
+        valid.insert(valid.end(), other.valid.begin(), other.valid.end());
+        null_count += other.null_count;
+    }
+
+    std::unique_ptr<cudf::column> to_column() const
+    {
+        const auto num_rows = static_cast<cudf::size_type>(valid.size());
+
+        auto offsets_column = cudf::make_numeric_column(cudf::data_type{cudf::type_id::INT32}, offsets.size());
+        auto chars_column   = cudf::make_numeric_column(cudf::data_type{cudf::type_id::INT8}, chars.size());
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(offsets_column->mutable_view().head(),
+                                       offsets.data(),
+                                       offsets.size() * sizeof(cudf::size_type),
+                                       cudaMemcpyHostToDevice,
+                                       rmm::cuda_stream_per_thread));
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(chars_column->mutable_view().head(),
+                                       chars.data(),
+                                       chars.size(),
+                                       cudaMemcpyHostToDevice,
+                                       rmm::cuda_stream_per_thread));
+
+        rmm::device_buffer null_mask{};
+
+        if (null_count > 0)
+        {
+            std::vector<cudf::bitmask_type> host_mask(
+                cudf::bitmask_allocation_size_bytes(num_rows) / sizeof(cudf::bitmask_type), 0);
+
+            for (cudf::size_type row = 0; row < num_rows; ++row)
+            {
+                if (valid[row])
+                {
+                    host_mask[row / 32] |= cudf::bitmask_type{1} << (row % 32);
+                }
+            }
+
+            null_mask = rmm::device_buffer(
+                host_mask.data(), host_mask.size() * sizeof(cudf::bitmask_type), rmm::cuda_stream_per_thread);
+        }
+
+        // The host vectors must outlive the copies
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+        return cudf::make_strings_column(
+            num_rows, std::move(offsets_column), std::move(chars_column), null_count, std::move(null_mask));
+    }
+};
+
+// ************ AppShieldSourceStage__File ************ //
+/**
+ * @brief Rows of one plugin file. `columns` holds one entry per `cols_include` column.
+ */
+struct AppShieldSourceStage__File
+{
+    std::string source;
+    std::string plugin;
+    std::string timestamp;
+    int64_t snapshot_id{0};
+    std::size_t num_rows{0};
+    std::vector<AppShieldSourceStage__Strings> columns;
+    bool loaded{false};
+};
+
+// Component-private free functions.
+const std::vector<std::string> AppShieldSourceStage__MetaColumns{"snapshot_id", "timestamp", "source", "plugin"};
+
+std::vector<std::string> AppShieldSourceStage__split(const std::string &value, char delimiter)
+{
+    std::vector<std::string> parts;
+    std::size_t start = 0;
+
+    for (auto found = value.find(delimiter); found != std::string::npos; found = value.find(delimiter, start))
+    {
+        parts.push_back(value.substr(start, found - start));
+        start = found + 1;
+    }
+
+    parts.push_back(value.substr(start));
+
+    return parts;
+}
+
+/**
+ * @brief Every byte of Latin-1 is the code point of the same value, those above 0x7F take two bytes in UTF-8.
+ */
+std::string AppShieldSourceStage__latin1_to_utf8(const char *data, std::size_t size)
+{
+    std::string output;
+    output.reserve(size + size / 8);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const auto byte = static_cast<unsigned char>(data[i]);
+
+        if (byte < 0x80)
+        {
+            output.push_back(static_cast<char>(byte));
+        }
+        else
+        {
+            output.push_back(static_cast<char>(0xC0 | (byte >> 6)));
+            output.push_back(static_cast<char>(0x80 | (byte & 0x3F)));
+        }
+    }
+
+    return output;
+}
+
+/**
+ * @brief Reads the source, snapshot and timestamp from a `<source>/snapshot-<id>/<plugin>_<timestamp>.json` path.
+ * Throws `std::invalid_argument` for paths of any other layout.
+ */
+void AppShieldSourceStage__parse_path(const std::vector<std::string> &path_parts, AppShieldSourceStage__File &file)
+{
+    static const std::regex timestamp_regex("[a-z]+_([0-9-_.]+).json");
+
+    if (path_parts.size() < 3)
+    {
+        throw std::invalid_argument("Invalid AppShield file path, expected at least 3 components");
+    }
+
+    const auto &filename = path_parts.back();
+    auto snapshot_parts  = AppShieldSourceStage__split(path_parts[path_parts.size() - 2], '-');
+
+    std::smatch match;
+
+    if (snapshot_parts.size() < 2 || !std::regex_search(filename, match, timestamp_regex))
+    {
+        throw std::invalid_argument("Invalid format for AppShield file '" + filename + "'");
+    }
+
+    file.source      = path_parts[path_parts.size() - 3];
+    file.snapshot_id = std::stoll(snapshot_parts[1]);
+    file.timestamp   = match[1].str();
+}
+
+// Component public implementations
+// ************ AppShieldSourceStage ************************** //
+AppShieldSourceStage::AppShieldSourceStage(const neo::Segment &parent,
+                                           const std::string &name,
+                                           std::vector<std::string> plugins_include,
+                                           std::vector<std::string> cols_include,
+                                           std::vector<std::string> cols_exclude,
+                                           const std::string &encoding,
+                                           std::size_t num_threads) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_plugins_include(std::move(plugins_include)),
+  m_cols_include(std::move(cols_include)),
+  m_cols_exclude(std::move(cols_exclude)),
+  m_latin1(false),
+  m_num_threads(std::max<std::size_t>(num_threads, 1)),
+  m_metrics(StageMetrics::get(name))
+{
+    std::string lowered(encoding);
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+
+    if (lowered == "latin1" || lowered == "latin-1" || lowered == "iso-8859-1" || lowered == "iso8859-1")
+    {
+        m_latin1 = true;
+    }
+    else if (lowered.rfind("utf", 0) != 0)
+    {
+        throw std::invalid_argument("AppShieldSourceStage only reads 'latin1' or 'utf-8' files, not '" + encoding +
+                                    "'");
+    }
+}
+
+std::vector<std::shared_ptr<MessageMeta>> AppShieldSourceStage::load_files(
+    const std::vector<std::string> &filenames) const
+{
+    std::vector<AppShieldSourceStage__File> files(filenames.size());
+
+    // Output columns: the requested ones, then the path columns which were not requested
+    std::vector<std::string> column_names(m_cols_include);
+
+    for (const auto &meta_column : AppShieldSourceStage__MetaColumns)
+    {
+        if (std::find(column_names.begin(), column_names.end(), meta_column) == column_names.end())
+        {
+            column_names.push_back(meta_column);
+        }
+    }
+
+    auto load_file = [this, &filenames, &files](std::size_t file_idx) {
+        const auto &filename = filenames[file_idx];
+        auto &file           = files[file_idx];
+
+        auto path_parts = AppShieldSourceStage__split(filename, '/');
+        file.plugin     = AppShieldSourceStage__split(path_parts.back(), '_').front();
+
+        if (std::find(m_plugins_include.begin(), m_plugins_include.end(), file.plugin) == m_plugins_include.end())
+        {
+            return;
+        }
+
+        MappedFile mapped(filename);
+
+        const char *begin = mapped.data();
+        const char *end   = begin + mapped.size();
+        std::string transcoded;
+
+        if (m_latin1 && std::any_of(begin, end, [](char c) { return static_cast<unsigned char>(c) >= 0x80; }))
+        {
+            transcoded = AppShieldSourceStage__latin1_to_utf8(begin, mapped.size());
+            begin      = transcoded.data();
+            end        = begin + transcoded.size();
+        }
+
+        nlohmann::json doc;
+
+        try
+        {
+            doc = nlohmann::json::parse(begin, end);
+        } catch (const nlohmann::json::parse_error &e)
+        {
+            LOG(ERROR) << "Unable to decode json file " << filename << ": " << e.what();
+            return;
+        }
+
+        const auto &titles = doc.at("titles");
+        const auto &data   = doc.at("data");
+
+        // Position of every requested column in the rows, -1 when the plugin does not have it
+        std::vector<std::ptrdiff_t> positions;
+
+        for (const auto &column : m_cols_include)
+        {
+            std::ptrdiff_t position = -1;
+
+            if (std::find(m_cols_exclude.begin(), m_cols_exclude.end(), column) == m_cols_exclude.end())
+            {
+                for (std::size_t i = 0; i < titles.size(); ++i)
+                {
+                    if (titles[i].is_string() && titles[i].get_ref<const std::string &>() == column)
+                    {
+                        position = static_cast<std::ptrdiff_t>(i);
+                        break;
+                    }
+                }
+            }
+
+            positions.push_back(position);
+        }
+
+        AppShieldSourceStage__parse_path(path_parts, file);
+
+        file.num_rows = data.size();
+        file.columns.resize(m_cols_include.size());
+
+        for (const auto &row : data)
+        {
+            for (std::size_t col = 0; col < positions.size(); ++col)
+            {
+                auto &output = file.columns[col];
+
+                if (positions[col] < 0 || static_cast<std::size_t>(positions[col]) >= row.size() ||
+                    row[positions[col]].is_null())
+                {
+                    output.push_null();
+                    continue;
+                }
+
+                const auto &value = row[positions[col]];
+
+                if (value.is_string())
+                {
+                    const auto &str = value.get_ref<const std::string &>();
+                    output.push(str.data(), str.size());
+                }
+                else
+                {
+                    // Numbers and nested values are kept as their JSON text
+                    auto str = value.dump();
+                    output.push(str.data(), str.size());
+                }
+            }
+        }
+
+        file.loaded = true;
+    };
+
+    // Every thread takes the next file to read until none are left
+    std::atomic<std::size_t> next_file{0};
+    std::vector<std::exception_ptr> errors(filenames.size());
+
+    auto run = [&]() {
+        for (auto file_idx = next_file++; file_idx < filenames.size(); file_idx = next_file++)
+        {
+            try
+            {
+                load_file(file_idx);
+            } catch (...)
+            {
+                errors[file_idx] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < std::min(m_num_threads, filenames.size()); ++i)
+    {
+        threads.emplace_back(run);
+    }
+
+    run();
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // Group the files by source, in the order the sources are first seen
+    std::vector<std::string> sources;
+    std::vector<std::vector<const AppShieldSourceStage__File *>> source_files;
+
+    for (const auto &file : files)
+    {
+        if (!file.loaded)
+        {
+            continue;
+        }
+
+        auto found = std::find(sources.begin(), sources.end(), file.source);
+
+        if (found == sources.end())
+        {
+            sources.push_back(file.source);
+            source_files.emplace_back();
+            found = sources.end() - 1;
+        }
+
+        source_files[found - sources.begin()].push_back(&file);
+    }
+
+    std::vector<std::shared_ptr<MessageMeta>> metas;
+
+    for (const auto &group : source_files)
+    {
+        std::vector<std::unique_ptr<cudf::column>> columns;
+
+        for (const auto &column_name : column_names)
+        {
+            auto meta_column = std::find(AppShieldSourceStage__MetaColumns.begin(),
+                                         AppShieldSourceStage__MetaColumns.end(),
+                                         column_name);
+
+            if (meta_column == AppShieldSourceStage__MetaColumns.begin())
+            {
+                std::vector<int64_t> snapshot_ids;
+
+                for (const auto *file : group)
+                {
+                    snapshot_ids.insert(snapshot_ids.end(), file->num_rows, file->snapshot_id);
+                }
+
+                auto column = cudf::make_numeric_column(cudf::data_type{cudf::type_id::INT64}, snapshot_ids.size());
+
+                NEO_CHECK_CUDA(cudaMemcpyAsync(column->mutable_view().head(),
+                                               snapshot_ids.data(),
+                                               snapshot_ids.size() * sizeof(int64_t),
+                                               cudaMemcpyHostToDevice,
+                                               rmm::cuda_stream_per_thread));
+                NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+                columns.emplace_back(std::move(column));
+                continue;
+            }
+
+            AppShieldSourceStage__Strings strings;
+
+            if (meta_column != AppShieldSourceStage__MetaColumns.end())
+            {
+                // Path columns replace a plugin column of the same name
+                for (const auto *file : group)
+                {
+                    const auto &value = column_name == "timestamp" ? file->timestamp
+                                        : column_name == "source"  ? file->source
+                                                                   : file->plugin;
+
+                    for (std::size_t row = 0; row < file->num_rows; ++row)
+                    {
+                        strings.push(value.data(), value.size());
+                    }
+                }
+            }
+            else
+            {
+                const auto col =
+                    std::find(m_cols_include.begin(), m_cols_include.end(), column_name) - m_cols_include.begin();
+
+                for (const auto *file : group)
+                {
+                    strings.append(file->columns[col]);
+                }
+            }
+
+            columns.emplace_back(strings.to_column());
+        }
+
+        cudf::io::table_with_metadata table;
+        table.tbl                   = std::make_unique<cudf::table>(std::move(columns));
+        table.metadata.column_names = column_names;
+
+        // Rows of different files share no index, a new one is created
+        metas.emplace_back(MessageMeta::create_from_cpp(std::move(table), 0));
+    }
+
+    return metas;
+}
+
+AppShieldSourceStage::operator_fn_t AppShieldSourceStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output](reader_type_t &&x) {
+                DeviceMemory::ScopedTag memory_tag("AppShieldSourceStage");
+                MORPHEUS_DEVICE_RANGE("AppShieldSourceStage");
+
+                for (auto &meta : this->load_files(x))
+                {
+                    m_metrics->emit(output, std::move(meta));
+                }
+            },
+            [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [&]() { output.on_completed(); }));
+    };
+}
+
+// ************ AppShieldSourceStageInterfaceProxy ************ //
+std::shared_ptr<AppShieldSourceStage> AppShieldSourceStageInterfaceProxy::init(
+    neo::Segment &parent,
+    const std::string &name,
+    std::vector<std::string> plugins_include,
+    std::vector<std::string> cols_include,
+    std::vector<std::string> cols_exclude,
+    const std::string &encoding,
+    std::size_t num_threads)
+{
+    auto stage = std::make_shared<AppShieldSourceStage>(parent,
+                                                        name,
+                                                        std::move(plugins_include),
+                                                        std::move(cols_include),
+                                                        std::move(cols_exclude),
+                                                        encoding,
+                                                        num_threads);
+
+    parent.register_node<AppShieldSourceStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
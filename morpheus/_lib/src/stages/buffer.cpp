@@ -0,0 +1,551 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/buffer.hpp>
+
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/host_memory.hpp>
+#include <morpheus/utilities/table_util.hpp>
+
+#include <neo/core/segment_object.hpp>
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+#include <neo/cuda/sync.hpp>
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_view.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/null_mask.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>
+#include <cudf/utilities/traits.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ BufferStage__HostColumn ************ //
+/**
+ * @brief Layout of a spilled column. Offsets are into the pinned buffer of the message.
+ */
+struct BufferStage__HostColumn
+{
+    cudf::data_type type;
+    cudf::size_type size{0};
+    cudf::size_type null_count{0};
+    std::size_t data_offset{0};
+    std::size_t data_bytes{0};
+    std::size_t mask_offset{0};
+    std::size_t mask_bytes{0};
+    std::vector<BufferStage__HostColumn> children;
+};
+
+// ************ BufferStage__Entry ************ //
+/**
+ * @brief A buffered message. Exactly one of `meta` or `host_data` holds the rows.
+ */
+struct BufferStage__Entry
+{
+    std::shared_ptr<MessageMeta> meta;
+    std::size_t device_bytes{0};
+
+    // Only set while spilled
+    PinnedHostBuffer host_data;
+    std::vector<BufferStage__HostColumn> columns;
+    std::vector<std::string> index_names;
+    std::vector<std::string> column_names;
+    std::vector<std::shared_ptr<MessageCompletion>> completions;
+    std::shared_ptr<MessageTrace> trace;
+};
+
+// ************ BufferStage__State ************ //
+/**
+ * @brief Shared between the operator and the emitter fiber. `entries` and the byte counts are only touched while
+ * holding `mutex`. Only the operator pushes entries and only the emitter pops them, so the emitter can restore an
+ * entry without holding the lock.
+ */
+struct BufferStage__State
+{
+    boost::fibers::mutex mutex;
+    boost::fibers::condition_variable cv;
+
+    std::deque<std::shared_ptr<BufferStage__Entry>> entries;
+    std::size_t device_bytes{0};
+    std::size_t host_bytes{0};
+
+    bool done{false};
+    bool drained{false};
+    std::exception_ptr error{nullptr};
+};
+
+// Component-private free functions.
+constexpr std::size_t BufferStage__Alignment = 256;
+
+std::size_t BufferStage__align(std::size_t bytes)
+{
+    return (bytes + BufferStage__Alignment - 1) / BufferStage__Alignment * BufferStage__Alignment;
+}
+
+bool BufferStage__has_offset(const cudf::column_view &column)
+{
+    if (column.offset() != 0)
+    {
+        return true;
+    }
+
+    for (cudf::size_type i = 0; i < column.num_children(); ++i)
+    {
+        if (BufferStage__has_offset(column.child(i)))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+struct BufferStage__Copy
+{
+    const void *device;
+    std::size_t offset;
+    std::size_t bytes;
+};
+
+/**
+ * @brief Gives every buffer of `column` an offset in the pinned buffer of its message, recording the copies to make.
+ * `column` and its children must not be sliced.
+ */
+BufferStage__HostColumn BufferStage__plan_spill(const cudf::column_view &column,
+                                                std::size_t &offset,
+                                                std::vector<BufferStage__Copy> &copies)
+{
+    BufferStage__HostColumn host;
+    host.type       = column.type();
+    host.size       = column.size();
+    host.null_count = column.null_count();
+
+    if (cudf::is_fixed_width(column.type()) && column.size() > 0)
+    {
+        host.data_offset = offset;
+        host.data_bytes  = static_cast<std::size_t>(column.size()) * cudf::size_of(column.type());
+        copies.push_back(BufferStage__Copy{column.head(), host.data_offset, host.data_bytes});
+        offset += BufferStage__align(host.data_bytes);
+    }
+
+    if (column.nullable())
+    {
+        host.mask_offset = offset;
+        host.mask_bytes  = cudf::bitmask_allocation_size_bytes(column.size());
+        copies.push_back(BufferStage__Copy{column.null_mask(), host.mask_offset, host.mask_bytes});
+        offset += BufferStage__align(host.mask_bytes);
+    }
+
+    for (cudf::size_type i = 0; i < column.num_children(); ++i)
+    {
+        host.children.push_back(BufferStage__plan_spill(column.child(i), offset, copies));
+    }
+
+    return host;
+}
+
+/**
+ * @brief Moves the columns of `entry.meta` to pinned host memory and drops the message, releasing its device memory
+ * unless another stage still holds it.
+ */
+void BufferStage__spill(BufferStage__Entry &entry)
+{
+    DeviceMemory::ScopedTag memory_tag("BufferStage");
+
+    auto info = entry.meta->get_info();
+
+    // Sliced columns are copied first so only the rows of the slice are spilled
+    std::vector<std::unique_ptr<cudf::column>> materialized;
+    std::vector<cudf::column_view> columns;
+
+    for (const auto &column : info.get_view())
+    {
+        if (BufferStage__has_offset(column))
+        {
+            materialized.emplace_back(std::make_unique<cudf::column>(column, rmm::cuda_stream_per_thread));
+            columns.push_back(materialized.back()->view());
+        }
+        else
+        {
+            columns.push_back(column);
+        }
+    }
+
+    std::size_t offset = 0;
+    std::vector<BufferStage__Copy> copies;
+
+    for (const auto &column : columns)
+    {
+        entry.columns.push_back(BufferStage__plan_spill(column, offset, copies));
+    }
+
+    entry.host_data = PinnedHostPool::acquire(std::max<std::size_t>(offset, 1));
+
+    for (const auto &copy : copies)
+    {
+        NEO_CHECK_CUDA(cudaMemcpyAsync(entry.host_data.data() + copy.offset,
+                                       copy.device,
+                                       copy.bytes,
+                                       cudaMemcpyDeviceToHost,
+                                       rmm::cuda_stream_per_thread));
+    }
+
+    // Yields the fiber rather than blocking the thread while the copies run
+    neo::enqueue_stream_sync_event(rmm::cuda_stream_per_thread).get();
+
+    entry.index_names  = info.get_index_names();
+    entry.column_names = info.get_column_names();
+    entry.completions  = entry.meta->completions();
+    entry.trace        = entry.meta->trace();
+
+    entry.meta.reset();
+}
+
+std::unique_ptr<cudf::column> BufferStage__restore_column(const BufferStage__HostColumn &host, const uint8_t *host_data)
+{
+    rmm::device_buffer data(host.data_bytes, rmm::cuda_stream_per_thread);
+    rmm::device_buffer mask(host.mask_bytes, rmm::cuda_stream_per_thread);
+
+    if (host.data_bytes > 0)
+    {
+        NEO_CHECK_CUDA(cudaMemcpyAsync(data.data(),
+                                       host_data + host.data_offset,
+                                       host.data_bytes,
+                                       cudaMemcpyHostToDevice,
+                                       rmm::cuda_stream_per_thread));
+    }
+
+    if (host.mask_bytes > 0)
+    {
+        NEO_CHECK_CUDA(cudaMemcpyAsync(mask.data(),
+                                       host_data + host.mask_offset,
+                                       host.mask_bytes,
+                                       cudaMemcpyHostToDevice,
+                                       rmm::cuda_stream_per_thread));
+    }
+
+    std::vector<std::unique_ptr<cudf::column>> children;
+
+    for (const auto &child : host.children)
+    {
+        children.emplace_back(BufferStage__restore_column(child, host_data));
+    }
+
+    return std::make_unique<cudf::column>(
+        host.type, host.size, std::move(data), std::move(mask), host.null_count, std::move(children));
+}
+
+/**
+ * @brief Copies a spilled entry back to the device as a new MessageMeta carrying the completions and the trace of the
+ * original.
+ */
+void BufferStage__restore(BufferStage__Entry &entry)
+{
+    DeviceMemory::ScopedTag memory_tag("BufferStage");
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+
+    for (const auto &column : entry.columns)
+    {
+        columns.emplace_back(BufferStage__restore_column(column, entry.host_data.data()));
+    }
+
+    // The pinned buffer must outlive the copies
+    neo::enqueue_stream_sync_event(rmm::cuda_stream_per_thread).get();
+
+    auto column_names = entry.index_names;
+    column_names.insert(column_names.end(), entry.column_names.begin(), entry.column_names.end());
+
+    cudf::io::table_with_metadata table;
+    table.tbl                   = std::make_unique<cudf::table>(std::move(columns));
+    table.metadata.column_names = std::move(column_names);
+
+    entry.meta = MessageMeta::create_from_cpp(std::move(table), static_cast<int>(entry.index_names.size()));
+
+    for (const auto &completion : entry.completions)
+    {
+        entry.meta->add_completion(completion);
+    }
+
+    entry.meta->set_trace(std::move(entry.trace));
+
+    entry.host_data = PinnedHostBuffer{};
+    entry.columns.clear();
+    entry.completions.clear();
+}
+
+/**
+ * @brief Restores spilled entries, oldest first, while they fit under `device_memory_budget`. Stops at the first one
+ * which does not fit so entries become resident in the order they will be emitted.
+ */
+void BufferStage__prefetch(BufferStage__State &state, std::size_t device_memory_budget)
+{
+    std::unique_lock<boost::fibers::mutex> lock(state.mutex);
+
+    // Only the emitter pops entries, indices stay valid while the lock is released
+    for (std::size_t i = 0; i < state.entries.size(); ++i)
+    {
+        auto entry = state.entries[i];
+
+        if (entry->meta)
+        {
+            continue;
+        }
+
+        if (device_memory_budget > 0 && state.device_bytes + entry->device_bytes > device_memory_budget)
+        {
+            break;
+        }
+
+        state.host_bytes -= entry->device_bytes;
+        state.device_bytes += entry->device_bytes;
+
+        lock.unlock();
+        BufferStage__restore(*entry);
+        lock.lock();
+
+        // Pinned memory was released
+        state.cv.notify_all();
+    }
+}
+
+/**
+ * @brief Body of the emitter fiber. Hands the buffered messages to `output` in order until the input is done and the
+ * buffer is empty.
+ */
+void BufferStage__emit_all(std::shared_ptr<BufferStage__State> state,
+                           std::size_t device_memory_budget,
+                           std::shared_ptr<StageMetrics> metrics,
+                           neo::Subscriber<std::shared_ptr<MessageMeta>> &output)
+{
+    try
+    {
+        while (true)
+        {
+            std::shared_ptr<BufferStage__Entry> entry;
+
+            {
+                std::unique_lock<boost::fibers::mutex> lock(state->mutex);
+
+                state->cv.wait(lock, [&state]() { return state->done || !state->entries.empty(); });
+
+                if (state->entries.empty())
+                {
+                    break;
+                }
+
+                entry = std::move(state->entries.front());
+                state->entries.pop_front();
+
+                if (!entry->meta)
+                {
+                    // Next in line, restored regardless of the budget
+                    state->host_bytes -= entry->device_bytes;
+                    state->device_bytes += entry->device_bytes;
+                }
+
+                state->cv.notify_all();
+            }
+
+            if (!entry->meta)
+            {
+                BufferStage__restore(*entry);
+            }
+
+            // Overlaps the restores of the following messages with the downstream processing this one
+            BufferStage__prefetch(*state, device_memory_budget);
+
+            metrics->emit(output, std::move(entry->meta));
+
+            std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+
+            state->device_bytes -= entry->device_bytes;
+            state->cv.notify_all();
+        }
+    } catch (...)
+    {
+        std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+
+        state->error = std::current_exception();
+        state->entries.clear();
+    }
+
+    std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+
+    state->drained = true;
+    state->cv.notify_all();
+}
+
+// Component public implementations
+// ************ BufferStage **************************** //
+BufferStage::BufferStage(const neo::Segment &parent,
+                         const std::string &name,
+                         std::size_t count,
+                         std::size_t device_memory_budget,
+                         std::size_t host_memory_budget,
+                         double compact_fraction) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_count(count),
+  m_device_memory_budget(device_memory_budget),
+  m_host_memory_budget(host_memory_budget),
+  m_compact_fraction(compact_fraction),
+  m_metrics(StageMetrics::get(name))
+{
+    CHECK(m_count > 0) << "BufferStage count must be greater than 0";
+}
+
+BufferStage::operator_fn_t BufferStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        auto state = std::make_shared<BufferStage__State>();
+
+        boost::fibers::fiber(BufferStage__emit_all, state, m_device_memory_budget, m_metrics, std::ref(output))
+            .detach();
+
+        // Waits for the emitter to hand over every buffered message
+        auto wait_drained = [state]() {
+            std::unique_lock<boost::fibers::mutex> lock(state->mutex);
+
+            state->done = true;
+            state->cv.notify_all();
+            state->cv.wait(lock, [&state]() { return state->drained; });
+
+            return state->error;
+        };
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, state](reader_type_t &&x) {
+                m_metrics->record_in(x->count());
+
+                x = MessageMeta::compact_if_sparse(x, m_compact_fraction);
+
+                auto entry          = std::make_shared<BufferStage__Entry>();
+                entry->device_bytes = CuDFTableUtil::device_bytes(x->get_info().get_view());
+                entry->meta         = std::move(x);
+
+                std::unique_lock<boost::fibers::mutex> lock(state->mutex);
+
+                bool spill = false;
+
+                // Blocking the upstream is the last resort, only once `count` messages are held or there is no room
+                // left in either budget
+                state->cv.wait(lock, [&]() {
+                    if (state->error)
+                    {
+                        return true;
+                    }
+
+                    if (state->entries.size() >= m_count)
+                    {
+                        return false;
+                    }
+
+                    // Spilling the only buffered message would just copy it back before emitting it
+                    spill = m_device_memory_budget > 0 && !state->entries.empty() &&
+                            state->device_bytes + entry->device_bytes > m_device_memory_budget;
+
+                    return !spill || m_host_memory_budget == 0 ||
+                           state->host_bytes + entry->device_bytes <= m_host_memory_budget;
+                });
+
+                if (state->error)
+                {
+                    std::rethrow_exception(state->error);
+                }
+
+                if (spill)
+                {
+                    state->host_bytes += entry->device_bytes;
+
+                    lock.unlock();
+                    BufferStage__spill(*entry);
+                    lock.lock();
+                }
+                else
+                {
+                    state->device_bytes += entry->device_bytes;
+                }
+
+                state->entries.emplace_back(std::move(entry));
+                state->cv.notify_all();
+            },
+            [state, wait_drained, &output](std::exception_ptr error_ptr) {
+                {
+                    std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+
+                    // Buffered messages are dropped
+                    state->entries.clear();
+                }
+
+                wait_drained();
+
+                output.on_error(error_ptr);
+            },
+            [wait_drained, &output]() {
+                auto error_ptr = wait_drained();
+
+                if (error_ptr)
+                {
+                    output.on_error(error_ptr);
+                    return;
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ BufferStageInterfaceProxy ************* //
+std::shared_ptr<BufferStage> BufferStageInterfaceProxy::init(neo::Segment &parent,
+                                                             const std::string &name,
+                                                             std::size_t count,
+                                                             std::size_t device_memory_budget,
+                                                             std::size_t host_memory_budget,
+                                                             double compact_fraction)
+{
+    auto stage = std::make_shared<BufferStage>(
+        parent, name, count, device_memory_budget, host_memory_budget, compact_fraction);
+
+    parent.register_node<BufferStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -0,0 +1,859 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/cloud_trail_source.hpp>
+
+#include <morpheus/io/mapped_file.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/table_util.hpp>
+
+#include <neo/core/segment_object.hpp>
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cudf/binaryop.hpp>
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/column/column_view.hpp>
+#include <cudf/concatenate.hpp>
+#include <cudf/copying.hpp>
+#include <cudf/filling.hpp>
+#include <cudf/io/json.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/sorting.hpp>
+#include <cudf/strings/combine.hpp>
+#include <cudf/strings/convert/convert_booleans.hpp>
+#include <cudf/strings/convert/convert_datetime.hpp>
+#include <cudf/strings/convert/convert_floats.hpp>
+#include <cudf/strings/convert/convert_integers.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/utilities/traits.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ CloudTrailSourceStage__File ************ //
+/**
+ * @brief Flattened records of one file. Every value is kept as JSON text, keyed by the position of its column in
+ * `keys`, which holds the column names in the order they first appear.
+ */
+struct CloudTrailSourceStage__File
+{
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, std::size_t> key_index;
+
+    std::vector<std::vector<std::pair<std::size_t, std::string>>> records;
+
+    // Value of the user column of each record, empty when it has none
+    std::vector<std::string> users;
+    std::vector<bool> has_user;
+};
+
+// ************ CloudTrailSourceStage__Records ************ //
+struct CloudTrailSourceStage__Records
+{
+    cudf::io::table_with_metadata table;
+
+    // Users of the batch in the order first read, and the position in `users` of the user of every row, -1 if none
+    std::vector<std::string> users;
+    std::vector<int32_t> user_codes;
+
+    // Number of rows read from each file, in the order of the files
+    std::vector<cudf::size_type> file_rows;
+};
+
+// Component-private free functions.
+constexpr const char *CloudTrailSourceStage__TimeFormat = "%Y-%m-%dT%H:%M:%SZ";
+
+bool CloudTrailSourceStage__is_gzip(const char *data, std::size_t size)
+{
+    return size >= 2 && static_cast<unsigned char>(data[0]) == 0x1f && static_cast<unsigned char>(data[1]) == 0x8b;
+}
+
+/**
+ * @brief Inflates a gzip file, including files made of several concatenated gzip members.
+ */
+std::string CloudTrailSourceStage__inflate(const char *data, std::size_t size, const std::string &filename)
+{
+    z_stream stream{};
+
+    if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK)
+    {
+        throw std::runtime_error("Failed to initialize zlib for '" + filename + "'");
+    }
+
+    stream.next_in  = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+    stream.avail_in = static_cast<uInt>(size);
+
+    // CloudTrail logs usually compress about ten times
+    std::string output(std::max<std::size_t>(size * 10, 1 << 16), '\0');
+    std::size_t produced = 0;
+
+    while (true)
+    {
+        if (output.size() == produced)
+        {
+            output.resize(output.size() * 2);
+        }
+
+        const auto available =
+            static_cast<uInt>(std::min<std::size_t>(output.size() - produced, std::numeric_limits<uInt>::max()));
+
+        stream.next_out  = reinterpret_cast<Bytef *>(&output[produced]);
+        stream.avail_out = available;
+
+        const auto result = inflate(&stream, Z_NO_FLUSH);
+
+        produced += available - stream.avail_out;
+
+        if (result == Z_STREAM_END)
+        {
+            if (stream.avail_in == 0)
+            {
+                break;
+            }
+
+            // Another member follows
+            inflateReset(&stream);
+            continue;
+        }
+
+        if (result != Z_OK)
+        {
+            inflateEnd(&stream);
+            throw std::runtime_error("Failed to inflate '" + filename + "', the file is truncated or corrupt");
+        }
+    }
+
+    inflateEnd(&stream);
+    output.resize(produced);
+
+    return output;
+}
+
+std::string CloudTrailSourceStage__dump(const nlohmann::ordered_json &value)
+{
+    // Invalid UTF-8 is replaced rather than failing the whole file
+    return value.dump(-1, ' ', false, nlohmann::ordered_json::error_handler_t::replace);
+}
+
+/**
+ * @brief Adds the leaves of `value` to `record` under `key`, with the keys of nested objects appended without
+ * separator, the same names as `json_normalize` followed by removing the dots. Lists are kept as JSON strings
+ * except `requestParametersownersSetitems`, which keeps the first value of its first item like `cleanup_df`.
+ */
+void CloudTrailSourceStage__flatten(const nlohmann::ordered_json &value,
+                                    const std::string &key,
+                                    const std::string &user_column_name,
+                                    CloudTrailSourceStage__File &file,
+                                    std::vector<std::pair<std::size_t, std::string>> &record)
+{
+    if (value.is_object())
+    {
+        for (auto item = value.begin(); item != value.end(); ++item)
+        {
+            auto child_key = key + item.key();
+            child_key.erase(std::remove(child_key.begin() + key.size(), child_key.end(), '.'), child_key.end());
+
+            CloudTrailSourceStage__flatten(item.value(), child_key, user_column_name, file, record);
+        }
+
+        return;
+    }
+
+    std::string column_value;
+
+    if (value.is_array())
+    {
+        if (key == "requestParametersownersSetitems" && !value.empty() && value[0].is_object() && !value[0].empty())
+        {
+            column_value = CloudTrailSourceStage__dump(value[0].begin().value());
+        }
+        else
+        {
+            column_value = CloudTrailSourceStage__dump(nlohmann::ordered_json(CloudTrailSourceStage__dump(value)));
+        }
+    }
+    else
+    {
+        column_value = CloudTrailSourceStage__dump(value);
+    }
+
+    if (key == user_column_name && !value.is_null())
+    {
+        if (value.is_string())
+        {
+            file.users.back() = value.get<std::string>();
+        }
+        else
+        {
+            // Matches the account ids made strings after parsing
+            file.users.back() = key == "userIdentityaccountId" ? "Account-" + column_value : column_value;
+        }
+
+        file.has_user.back() = true;
+    }
+
+    auto found = file.key_index.find(key);
+
+    if (found == file.key_index.end())
+    {
+        found = file.key_index.emplace(key, file.keys.size()).first;
+        file.keys.push_back(key);
+    }
+
+    record.emplace_back(found->second, std::move(column_value));
+}
+
+void CloudTrailSourceStage__add_record(const nlohmann::ordered_json &record,
+                                       const std::string &user_column_name,
+                                       CloudTrailSourceStage__File &file)
+{
+    if (!record.is_object())
+    {
+        return;
+    }
+
+    file.users.emplace_back();
+    file.has_user.push_back(false);
+    file.records.emplace_back();
+
+    CloudTrailSourceStage__flatten(record, "", user_column_name, file, file.records.back());
+}
+
+/**
+ * @brief Parses a `{"Records": [...]}` document, a list of records, or JSON lines with one record per line.
+ */
+void CloudTrailSourceStage__parse(const char *begin,
+                                  const char *end,
+                                  const std::string &user_column_name,
+                                  CloudTrailSourceStage__File &file)
+{
+    auto doc = nlohmann::ordered_json::parse(begin, end, nullptr, false);
+
+    if (!doc.is_discarded())
+    {
+        if (doc.is_object() && doc.contains("Records") && doc["Records"].is_array())
+        {
+            for (const auto &record : doc["Records"])
+            {
+                CloudTrailSourceStage__add_record(record, user_column_name, file);
+            }
+        }
+        else if (doc.is_array())
+        {
+            for (const auto &record : doc)
+            {
+                CloudTrailSourceStage__add_record(record, user_column_name, file);
+            }
+        }
+        else
+        {
+            CloudTrailSourceStage__add_record(doc, user_column_name, file);
+        }
+
+        return;
+    }
+
+    // Not a single document, read it as JSON lines
+    for (const char *line = begin; line < end;)
+    {
+        const char *line_end = std::find(line, end, '\n');
+
+        if (std::any_of(line, line_end, [](char c) { return !std::isspace(static_cast<unsigned char>(c)); }))
+        {
+            CloudTrailSourceStage__add_record(nlohmann::ordered_json::parse(line, line_end), user_column_name, file);
+        }
+
+        line = line_end + 1;
+    }
+}
+
+/**
+ * @brief Returns a numeric column holding `values`.
+ */
+template <typename T>
+std::unique_ptr<cudf::column> CloudTrailSourceStage__to_column(const std::vector<T> &values)
+{
+    auto column = cudf::make_numeric_column(cudf::data_type{cudf::type_to_id<T>()}, values.size());
+
+    NEO_CHECK_CUDA(cudaMemcpyAsync(column->mutable_view().head(),
+                                   values.data(),
+                                   values.size() * sizeof(T),
+                                   cudaMemcpyHostToDevice,
+                                   rmm::cuda_stream_per_thread));
+
+    // The host vector must outlive the copy
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    return column;
+}
+
+/**
+ * @brief `'Account-' + astype(str)` when the account ids were read as numbers, like `cleanup_df`.
+ */
+std::unique_ptr<cudf::column> CloudTrailSourceStage__account_ids(const cudf::column_view &column)
+{
+    std::unique_ptr<cudf::column> as_strings;
+
+    if (cudf::is_floating_point(column.type()))
+    {
+        as_strings = cudf::strings::from_floats(column);
+    }
+    else if (cudf::is_boolean(column.type()))
+    {
+        as_strings = cudf::strings::from_booleans(column);
+    }
+    else
+    {
+        as_strings = cudf::strings::from_integers(column);
+    }
+
+    auto prefix = cudf::make_column_from_scalar(cudf::string_scalar("Account-"), column.size());
+
+    return cudf::strings::concatenate(cudf::table_view{{prefix->view(), as_strings->view()}});
+}
+
+/**
+ * @brief Reads every file on `num_threads` threads, then parses all the records on the device at once.
+ */
+CloudTrailSourceStage__Records CloudTrailSourceStage__read(const std::vector<std::string> &filenames,
+                                                           const std::string &user_column_name,
+                                                           std::size_t num_threads)
+{
+    std::vector<CloudTrailSourceStage__File> files(filenames.size());
+    std::vector<std::exception_ptr> errors(filenames.size());
+    std::atomic<std::size_t> next_file{0};
+
+    auto run = [&]() {
+        for (auto file_idx = next_file++; file_idx < filenames.size(); file_idx = next_file++)
+        {
+            try
+            {
+                MappedFile mapped(filenames[file_idx]);
+
+                if (CloudTrailSourceStage__is_gzip(mapped.data(), mapped.size()))
+                {
+                    const auto inflated =
+                        CloudTrailSourceStage__inflate(mapped.data(), mapped.size(), filenames[file_idx]);
+
+                    CloudTrailSourceStage__parse(
+                        inflated.data(), inflated.data() + inflated.size(), user_column_name, files[file_idx]);
+                }
+                else
+                {
+                    CloudTrailSourceStage__parse(
+                        mapped.data(), mapped.data() + mapped.size(), user_column_name, files[file_idx]);
+                }
+            } catch (...)
+            {
+                errors[file_idx] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 1; i < std::min(num_threads, filenames.size()); ++i)
+    {
+        threads.emplace_back(run);
+    }
+
+    run();
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto &error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // The JSON reader takes the columns from the first record, so every record is written with every column of the
+    // batch, in the same order
+    std::vector<std::string> keys;
+    std::unordered_map<std::string, std::size_t> key_index;
+    std::vector<std::vector<std::size_t>> file_keys(files.size());
+    std::size_t value_bytes = 0;
+
+    for (std::size_t file_idx = 0; file_idx < files.size(); ++file_idx)
+    {
+        for (const auto &key : files[file_idx].keys)
+        {
+            auto found = key_index.find(key);
+
+            if (found == key_index.end())
+            {
+                found = key_index.emplace(key, keys.size()).first;
+                keys.push_back(key);
+            }
+
+            file_keys[file_idx].push_back(found->second);
+        }
+
+        for (const auto &record : files[file_idx].records)
+        {
+            for (const auto &[key, value] : record)
+            {
+                value_bytes += value.size();
+            }
+        }
+    }
+
+    CloudTrailSourceStage__Records result;
+
+    std::vector<std::string> key_prefixes;
+    std::size_t key_bytes = 0;
+
+    for (const auto &key : keys)
+    {
+        key_prefixes.push_back(CloudTrailSourceStage__dump(nlohmann::ordered_json(key)) + ":");
+        key_bytes += key_prefixes.back().size() + 5;
+    }
+
+    std::size_t num_records = 0;
+
+    for (const auto &file : files)
+    {
+        num_records += file.records.size();
+    }
+
+    std::unordered_map<std::string, int32_t> user_index;
+    std::vector<int64_t> positions;
+    std::string lines;
+    std::vector<const std::string *> row(keys.size());
+
+    lines.reserve(value_bytes + key_bytes * num_records);
+
+    for (std::size_t file_idx = 0; file_idx < files.size(); ++file_idx)
+    {
+        const auto &file = files[file_idx];
+
+        result.file_rows.push_back(static_cast<cudf::size_type>(file.records.size()));
+
+        for (std::size_t record_idx = 0; record_idx < file.records.size(); ++record_idx)
+        {
+            std::fill(row.begin(), row.end(), nullptr);
+
+            for (const auto &[key, value] : file.records[record_idx])
+            {
+                row[file_keys[file_idx][key]] = &value;
+            }
+
+            lines.push_back('{');
+
+            for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    lines.push_back(',');
+                }
+
+                lines += key_prefixes[i];
+                lines += row[i] != nullptr ? *row[i] : "null";
+            }
+
+            lines += "}\n";
+
+            positions.push_back(static_cast<int64_t>(record_idx));
+
+            if (!file.has_user[record_idx])
+            {
+                result.user_codes.push_back(-1);
+                continue;
+            }
+
+            auto found = user_index.find(file.users[record_idx]);
+
+            if (found == user_index.end())
+            {
+                found = user_index.emplace(file.users[record_idx], static_cast<int32_t>(result.users.size())).first;
+                result.users.push_back(file.users[record_idx]);
+            }
+
+            result.user_codes.push_back(found->second);
+        }
+    }
+
+    if (positions.empty())
+    {
+        result.table.tbl = std::make_unique<cudf::table>();
+        return result;
+    }
+
+    // Only the new lines need to be kept alive, the parsed files go away here
+    files.clear();
+
+    auto options =
+        cudf::io::json_reader_options::builder(cudf::io::source_info(lines.data(), lines.size())).lines(true).build();
+
+    auto parsed       = CuDFTableUtil::load_json_table(std::move(options));
+    auto column_names = parsed.metadata.column_names;
+    auto columns      = parsed.tbl->release();
+
+    auto account_id = std::find(column_names.begin(), column_names.end(), "userIdentityaccountId");
+
+    if (account_id != column_names.end())
+    {
+        auto &column = columns[account_id - column_names.begin()];
+
+        if (column->type().id() != cudf::type_id::STRING)
+        {
+            column = CloudTrailSourceStage__account_ids(column->view());
+        }
+    }
+
+    const auto event_time = std::find(column_names.begin(), column_names.end(), "eventTime") - column_names.begin();
+
+    if (event_time < static_cast<std::ptrdiff_t>(columns.size()) &&
+        columns[event_time]->type().id() == cudf::type_id::STRING)
+    {
+        columns.emplace_back(cudf::strings::to_timestamps(cudf::strings_column_view{columns[event_time]->view()},
+                                                          cudf::data_type{cudf::type_id::TIMESTAMP_NANOSECONDS},
+                                                          CloudTrailSourceStage__TimeFormat));
+        column_names.emplace_back("event_dt");
+    }
+
+    // Position of each record in its file, the index `json_normalize` would have given it
+    columns.insert(columns.begin(), CloudTrailSourceStage__to_column(positions));
+    column_names.insert(column_names.begin(), "_index_");
+
+    result.table.tbl                   = std::make_unique<cudf::table>(std::move(columns));
+    result.table.metadata.column_names = std::move(column_names);
+
+    return result;
+}
+
+/**
+ * @brief Copies `rows` with `event_dt` moved `shift` nanoseconds later and `eventTime` written back from it, like
+ * `repeat_df`. `event_dt` is the last column.
+ */
+std::unique_ptr<cudf::table> CloudTrailSourceStage__shift(const cudf::table_view &rows,
+                                                          const std::vector<std::string> &column_names,
+                                                          int64_t shift)
+{
+    const auto event_dt   = static_cast<cudf::size_type>(column_names.size() - 1);
+    const auto event_time = std::find(column_names.begin(), column_names.end(), "eventTime") - column_names.begin();
+
+    auto shifted = cudf::binary_operation(rows.column(event_dt),
+                                          cudf::duration_scalar<cudf::duration_ns>(shift),
+                                          cudf::binary_operator::ADD,
+                                          rows.column(event_dt).type());
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+
+    for (cudf::size_type i = 0; i < rows.num_columns(); ++i)
+    {
+        if (i == event_dt)
+        {
+            columns.emplace_back(std::move(shifted));
+        }
+        else if (i == event_time)
+        {
+            columns.emplace_back(cudf::strings::from_timestamps(shifted->view(), CloudTrailSourceStage__TimeFormat));
+        }
+        else
+        {
+            columns.emplace_back(std::make_unique<cudf::column>(rows.column(i)));
+        }
+    }
+
+    return std::make_unique<cudf::table>(std::move(columns));
+}
+
+int64_t CloudTrailSourceStage__timestamp(const cudf::column_view &column, cudf::size_type row)
+{
+    auto element = cudf::get_element(column, row);
+
+    if (!element->is_valid())
+    {
+        return 0;
+    }
+
+    return static_cast<cudf::timestamp_scalar<cudf::timestamp_ns> &>(*element).value().time_since_epoch().count();
+}
+
+// Component public implementations
+// ************ CloudTrailSourceStage ************************* //
+CloudTrailSourceStage::CloudTrailSourceStage(const neo::Segment &parent,
+                                             const std::string &name,
+                                             std::string user_column_name,
+                                             std::string userid_filter,
+                                             std::size_t repeat,
+                                             std::size_t num_threads) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_user_column_name(std::move(user_column_name)),
+  m_userid_filter(std::move(userid_filter)),
+  m_repeat(std::max<std::size_t>(repeat, 1)),
+  m_num_threads(std::max<std::size_t>(num_threads, 1)),
+  m_metrics(StageMetrics::get(name))
+{}
+
+cudf::io::table_with_metadata CloudTrailSourceStage::read_records(const std::vector<std::string> &filenames) const
+{
+    return std::move(CloudTrailSourceStage__read(filenames, m_user_column_name, m_num_threads).table);
+}
+
+std::vector<std::shared_ptr<MessageMeta>> CloudTrailSourceStage::load_files(const std::vector<std::string> &filenames)
+{
+    auto records = CloudTrailSourceStage__read(filenames, m_user_column_name, m_num_threads);
+
+    if (records.user_codes.empty())
+    {
+        return {};
+    }
+
+    const auto &column_names = records.table.metadata.column_names;
+    const auto records_view  = records.table.tbl->view();
+
+    if (std::find(column_names.begin(), column_names.end(), m_user_column_name) == column_names.end())
+    {
+        throw std::runtime_error("CloudTrail records have no '" + m_user_column_name + "' column");
+    }
+
+    const bool has_event_dt = column_names.back() == "event_dt";
+
+    // Each file is repeated after itself, every copy moved later by the time spanned by the file
+    std::vector<std::unique_ptr<cudf::table>> repeated;
+    std::vector<cudf::table_view> parts;
+    std::vector<int32_t> user_codes;
+    cudf::size_type file_start = 0;
+
+    for (auto file_rows : records.file_rows)
+    {
+        if (file_rows == 0)
+        {
+            continue;
+        }
+
+        auto rows = cudf::slice(records_view, {file_start, file_start + file_rows}).front();
+
+        const auto file_codes = records.user_codes.begin() + file_start;
+
+        int64_t span = 0;
+
+        if (has_event_dt && m_repeat > 1)
+        {
+            const auto &event_dt = rows.column(rows.num_columns() - 1);
+
+            span = CloudTrailSourceStage__timestamp(event_dt, file_rows - 1) -
+                   CloudTrailSourceStage__timestamp(event_dt, 0);
+        }
+
+        for (std::size_t i = 0; i < m_repeat; ++i)
+        {
+            if (i == 0 || !has_event_dt)
+            {
+                parts.push_back(rows);
+            }
+            else
+            {
+                repeated.emplace_back(CloudTrailSourceStage__shift(rows, column_names, span * static_cast<int64_t>(i)));
+                parts.push_back(repeated.back()->view());
+            }
+
+            user_codes.insert(user_codes.end(), file_codes, file_codes + file_rows);
+        }
+
+        file_start += file_rows;
+    }
+
+    std::unique_ptr<cudf::table> combined;
+
+    if (parts.size() > 1)
+    {
+        combined = cudf::concatenate(parts);
+        repeated.clear();
+    }
+
+    const auto combined_view = combined ? combined->view() : parts.front();
+    const auto num_rows      = combined_view.num_rows();
+
+    // Sorted by time, then by the position in the file, with missing times last like pandas
+    std::vector<cudf::size_type> order(num_rows);
+
+    if (has_event_dt)
+    {
+        auto sorted = cudf::stable_sorted_order(
+            cudf::table_view{{combined_view.column(combined_view.num_columns() - 1), combined_view.column(0)}},
+            {cudf::order::ASCENDING, cudf::order::ASCENDING},
+            {cudf::null_order::AFTER, cudf::null_order::AFTER});
+
+        NEO_CHECK_CUDA(cudaMemcpy(order.data(),
+                                  sorted->view().data<cudf::size_type>(),
+                                  num_rows * sizeof(cudf::size_type),
+                                  cudaMemcpyDeviceToHost));
+    }
+    else
+    {
+        std::iota(order.begin(), order.end(), 0);
+    }
+
+    // Group the rows by user with a counting sort, users in the order of their first event
+    std::vector<int32_t> user_order;
+    std::vector<cudf::size_type> user_rows(records.users.size(), 0);
+
+    for (auto row : order)
+    {
+        const auto code = user_codes[row];
+
+        if (code < 0 || (!m_userid_filter.empty() && records.users[code] != m_userid_filter))
+        {
+            continue;
+        }
+
+        if (user_rows[code]++ == 0)
+        {
+            user_order.push_back(code);
+        }
+    }
+
+    std::vector<cudf::size_type> user_starts(records.users.size(), 0);
+    cudf::size_type total_rows = 0;
+
+    for (auto code : user_order)
+    {
+        user_starts[code] = total_rows;
+        total_rows += user_rows[code];
+    }
+
+    std::vector<cudf::size_type> gather_map(total_rows);
+
+    {
+        auto next = user_starts;
+
+        for (auto row : order)
+        {
+            const auto code = user_codes[row];
+
+            if (code >= 0 && user_rows[code] > 0)
+            {
+                gather_map[next[code]++] = row;
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<MessageMeta>> metas;
+
+    if (total_rows == 0)
+    {
+        return metas;
+    }
+
+    auto gather_column = CloudTrailSourceStage__to_column(gather_map);
+    auto grouped       = cudf::gather(combined_view, gather_column->view());
+
+    std::vector<std::string> meta_column_names{""};
+    meta_column_names.insert(meta_column_names.end(), column_names.begin(), column_names.end());
+
+    for (auto code : user_order)
+    {
+        const auto start = user_starts[code];
+        const auto rows  = user_rows[code];
+
+        auto user_table = cudf::slice(grouped->view(), {start, start + rows}).front();
+
+        auto &user_start = m_rows_per_user[records.users[code]];
+
+        std::vector<std::unique_ptr<cudf::column>> columns;
+        columns.emplace_back(cudf::sequence(rows, cudf::numeric_scalar<int64_t>(user_start)));
+
+        for (const auto &column : user_table)
+        {
+            columns.emplace_back(std::make_unique<cudf::column>(column));
+        }
+
+        user_start += rows;
+
+        cudf::io::table_with_metadata table;
+        table.tbl                   = std::make_unique<cudf::table>(std::move(columns));
+        table.metadata.column_names = meta_column_names;
+
+        metas.emplace_back(MessageMeta::create_from_cpp(std::move(table), 1));
+    }
+
+    return metas;
+}
+
+CloudTrailSourceStage::operator_fn_t CloudTrailSourceStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output](reader_type_t &&x) {
+                DeviceMemory::ScopedTag memory_tag("CloudTrailSourceStage");
+                MORPHEUS_DEVICE_RANGE("CloudTrailSourceStage");
+
+                for (auto &meta : this->load_files(x))
+                {
+                    m_metrics->emit(output, std::move(meta));
+                }
+            },
+            [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [&]() { output.on_completed(); }));
+    };
+}
+
+// ************ CloudTrailSourceStageInterfaceProxy ************ //
+std::shared_ptr<CloudTrailSourceStage> CloudTrailSourceStageInterfaceProxy::init(neo::Segment &parent,
+                                                                                 const std::string &name,
+                                                                                 std::string user_column_name,
+                                                                                 std::string userid_filter,
+                                                                                 std::size_t repeat,
+                                                                                 std::size_t num_threads)
+{
+    auto stage = std::make_shared<CloudTrailSourceStage>(
+        parent, name, std::move(user_column_name), std::move(userid_filter), repeat, num_threads);
+
+    parent.register_node<CloudTrailSourceStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -0,0 +1,298 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/stages/coalesce.hpp>
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <neo/core/segment_object.hpp>
+
+#include <cudf/concatenate.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ CoalesceStage__State ************ //
+/**
+ * @brief Messages waiting to be merged. Shared between the operator and the timer fiber, which only touch it, or the
+ * output, while holding `mutex`. The timer stops touching the output once `done` is set.
+ */
+struct CoalesceStage__State
+{
+    boost::fibers::mutex mutex;
+    boost::fibers::condition_variable cv;
+
+    std::vector<std::shared_ptr<MultiMessage>> buffer;
+    std::size_t buffered_rows{0};
+    std::chrono::steady_clock::time_point first_arrival;
+
+    // Incremented by every flush so the timer can tell its deadline is stale
+    std::size_t generation{0};
+    bool done{false};
+};
+
+// Component-private free functions.
+/**
+ * @brief True when the rows of `x` can be concatenated with the rows of `y`, same index count, column names and
+ * column types.
+ */
+bool CoalesceStage__same_layout(MultiMessage &x, MultiMessage &y)
+{
+    auto x_info = x.get_meta();
+    auto y_info = y.get_meta();
+
+    if (x_info.num_indices() != y_info.num_indices() || x_info.get_column_names() != y_info.get_column_names())
+    {
+        return false;
+    }
+
+    const auto &x_view = x_info.get_view();
+    const auto &y_view = y_info.get_view();
+
+    if (x_view.num_columns() != y_view.num_columns())
+    {
+        return false;
+    }
+
+    for (cudf::size_type i = 0; i < x_view.num_columns(); ++i)
+    {
+        if (x_view.column(i).type() != y_view.column(i).type())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Copies the rows of every message into a single new MessageMeta. A lone message is returned as it is.
+ */
+std::shared_ptr<MultiMessage> CoalesceStage__concatenate(std::vector<std::shared_ptr<MultiMessage>> &messages)
+{
+    if (messages.size() == 1)
+    {
+        return messages.front();
+    }
+
+    std::vector<TableInfo> infos;
+    std::vector<cudf::table_view> views;
+
+    infos.reserve(messages.size());
+    views.reserve(messages.size());
+
+    for (auto &message : messages)
+    {
+        infos.emplace_back(message->get_meta());
+    }
+
+    // Messages of different sources usually share index labels, only the data columns are copied and the merged
+    // message gets a new 0..N-1 index
+    const auto &first_info = infos.front();
+    std::vector<cudf::size_type> data_indices;
+
+    for (cudf::size_type i = first_info.num_indices(); i < first_info.get_view().num_columns(); ++i)
+    {
+        data_indices.push_back(i);
+    }
+
+    for (auto &info : infos)
+    {
+        views.emplace_back(info.get_view().select(data_indices));
+    }
+
+    MORPHEUS_DEVICE_RANGE("CoalesceStage::concatenate");
+
+    cudf::io::table_with_metadata table{cudf::concatenate(views), cudf::io::table_metadata{}};
+    table.metadata.column_names = first_info.get_column_names();
+
+    const auto num_rows = static_cast<std::size_t>(table.tbl->num_rows());
+
+    auto meta = MessageMeta::create_from_cpp(std::move(table), 0);
+
+    for (auto &message : messages)
+    {
+        meta->inherit_completions(*message->meta);
+    }
+
+    return std::make_shared<MultiMessage>(std::move(meta), 0, num_rows);
+}
+
+/**
+ * @brief Emits everything in the buffer as one message. Must be called with `state.mutex` held.
+ */
+void CoalesceStage__flush(CoalesceStage__State &state,
+                          StageMetrics &metrics,
+                          neo::Subscriber<std::shared_ptr<MultiMessage>> &output)
+{
+    if (state.buffer.empty())
+    {
+        return;
+    }
+
+    DeviceMemory::ScopedTag memory_tag("CoalesceStage");
+
+    auto merged = CoalesceStage__concatenate(state.buffer);
+
+    state.buffer.clear();
+    state.buffered_rows = 0;
+    ++state.generation;
+
+    metrics.emit(output, std::move(merged));
+}
+
+// Component public implementations
+// ************ CoalesceStage **************************** //
+CoalesceStage::CoalesceStage(const neo::Segment &parent,
+                             const std::string &name,
+                             std::size_t batch_size,
+                             int32_t timeout_ms) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_batch_size(batch_size),
+  m_timeout_ms(timeout_ms),
+  m_metrics(StageMetrics::get(name))
+{
+    CHECK(m_batch_size > 0) << "CoalesceStage batch_size must be greater than 0";
+}
+
+CoalesceStage::operator_fn_t CoalesceStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        auto state = std::make_shared<CoalesceStage__State>();
+
+        if (m_timeout_ms > 0)
+        {
+            const auto timeout = std::chrono::milliseconds(m_timeout_ms);
+
+            // Flushes messages which have waited for `timeout` without enough rows arriving to fill a batch
+            boost::fibers::fiber([state, timeout, metrics = m_metrics, &output]() {
+                std::unique_lock<boost::fibers::mutex> lock(state->mutex);
+
+                while (!state->done)
+                {
+                    if (state->buffer.empty())
+                    {
+                        state->cv.wait(lock);
+                        continue;
+                    }
+
+                    const auto generation = state->generation;
+
+                    const bool flushed = state->cv.wait_until(lock, state->first_arrival + timeout, [&]() {
+                        return state->done || state->generation != generation;
+                    });
+
+                    if (!flushed)
+                    {
+                        CoalesceStage__flush(*state, *metrics, output);
+                    }
+                }
+            }).detach();
+        }
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, state, &output](reader_type_t &&x) {
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+
+                if (!state->buffer.empty() && (state->buffered_rows + x->mess_count > m_batch_size ||
+                                               !CoalesceStage__same_layout(*state->buffer.front(), *x)))
+                {
+                    CoalesceStage__flush(*state, *m_metrics, output);
+                }
+
+                // Already a full batch, nothing to merge it with
+                if (x->mess_count >= m_batch_size)
+                {
+                    metrics_scope.emit(output, std::move(x));
+                    return;
+                }
+
+                if (state->buffer.empty())
+                {
+                    state->first_arrival = std::chrono::steady_clock::now();
+                    state->cv.notify_all();
+                }
+
+                state->buffered_rows += x->mess_count;
+                state->buffer.emplace_back(std::move(x));
+
+                if (state->buffered_rows >= m_batch_size)
+                {
+                    CoalesceStage__flush(*state, *m_metrics, output);
+                }
+            },
+            [state, &output](std::exception_ptr error_ptr) {
+                {
+                    std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+
+                    state->done = true;
+                    state->cv.notify_all();
+                }
+
+                output.on_error(error_ptr);
+            },
+            [this, state, &output]() {
+                {
+                    std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+
+                    CoalesceStage__flush(*state, *m_metrics, output);
+
+                    state->done = true;
+                    state->cv.notify_all();
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ CoalesceStageInterfaceProxy ************* //
+std::shared_ptr<CoalesceStage> CoalesceStageInterfaceProxy::init(neo::Segment &parent,
+                                                                 const std::string &name,
+                                                                 std::size_t batch_size,
+                                                                 int32_t timeout_ms)
+{
+    auto stage = std::make_shared<CoalesceStage>(parent, name, batch_size, timeout_ms);
+
+    parent.register_node<CoalesceStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -17,6 +17,8 @@
 
 #include <morpheus/stages/deserialization.hpp>
 
+#include <morpheus/stages/fused.hpp>
+
 #include <pyneo/node.hpp>
 #include <neo/core/segment.hpp>
 
@@ -25,6 +27,7 @@
 #include <memory>
 #include <mutex>
 #include <utility>
+#include <vector>
 
 namespace morpheus {
     // Component public implementations
@@ -32,20 +35,27 @@ namespace morpheus {
     DeserializeStage::DeserializeStage(const neo::Segment &parent, const std::string &name, size_t batch_size) :
             neo::SegmentObject(parent, name),
             PythonNode(parent, name, build_operator()),
-            m_batch_size(batch_size) {}
+            m_batch_size(batch_size),
+            m_metrics(StageMetrics::get(name)) {}
 
     DeserializeStage::operator_fn_t DeserializeStage::build_operator() {
         return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
             return input.subscribe(neo::make_observer<reader_type_t>(
                     [this, &output](reader_type_t &&x) {
-                        // Make one large MultiMessage
-                        auto full_message = std::make_shared<MultiMessage>(x, 0, x->count());
+                        StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                        // Make one large MultiMessage, only used to create the slices
+                        MultiMessage full_message(x, 0, x->count());
 
                         // Loop over the MessageMeta and create sub-batches
+                        std::vector<std::pair<size_t, size_t>> ranges;
                         for (size_t i = 0; i < x->count(); i += this->m_batch_size) {
-                            auto next = full_message->get_slice(i, std::min(i + this->m_batch_size, x->count()));
+                            ranges.emplace_back(i, std::min(i + this->m_batch_size, x->count()));
+                        }
 
-                            output.on_next(std::move(next));
+                        // All sub-batches share a single allocation
+                        for (auto &next: full_message.get_slices(ranges)) {
+                            metrics_scope.emit(output, std::move(next));
                         }
                     },
                     [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
@@ -58,7 +68,7 @@ namespace morpheus {
     DeserializeStageInterfaceProxy::init(neo::Segment &parent, const std::string &name, size_t batch_size) {
         auto stage = std::make_shared<DeserializeStage>(parent, name, batch_size);
 
-        parent.register_node<DeserializeStage>(stage);
+        FusedStageBuilder::register_node(parent, stage);
 
         return stage;
     }
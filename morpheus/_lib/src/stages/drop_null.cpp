@@ -0,0 +1,126 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/drop_null.hpp>
+
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <neo/core/segment_object.hpp>
+
+#include <cudf/io/types.hpp>
+#include <cudf/stream_compaction.hpp>
+#include <cudf/table/table.hpp>
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component public implementations
+// ************ DropNullStage **************************** //
+DropNullStage::DropNullStage(const neo::Segment &parent, const std::string &name, std::string column) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_column(std::move(column)),
+  m_metrics(StageMetrics::get(name))
+{}
+
+DropNullStage::operator_fn_t DropNullStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output](reader_type_t &&x) {
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                auto result = this->drop_nulls(std::move(x));
+
+                if (result)
+                {
+                    metrics_scope.emit(output, std::move(result));
+                }
+            },
+            [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [&]() { output.on_completed(); }));
+    };
+}
+
+std::shared_ptr<MessageMeta> DropNullStage::drop_nulls(std::shared_ptr<MessageMeta> meta) const
+{
+    if (meta->count() == 0)
+    {
+        return nullptr;
+    }
+
+    auto info = meta->get_info();
+
+    const auto column_idx = info.get_schema()->find_column(m_column);
+
+    if (column_idx < 0)
+    {
+        throw std::invalid_argument("DropNullStage: the message has no column named '" + m_column + "'");
+    }
+
+    // Nothing to drop, keep the message and its table as they are
+    if (info.get_column(column_idx).null_count() == 0)
+    {
+        return meta;
+    }
+
+    MORPHEUS_DEVICE_RANGE("DropNullStage::drop_nulls");
+    DeviceMemory::ScopedTag memory_tag("DropNullStage");
+
+    // The view holds the index columns first
+    const std::vector<cudf::size_type> keys{info.num_indices() + column_idx};
+
+    cudf::io::table_with_metadata table{cudf::drop_nulls(info.get_view(), keys), cudf::io::table_metadata{}};
+
+    if (table.tbl->num_rows() == 0)
+    {
+        return nullptr;
+    }
+
+    // Same layout as SerializeStage, index columns first
+    auto column_names = info.get_index_names();
+    column_names.insert(column_names.end(), info.get_column_names().begin(), info.get_column_names().end());
+    table.metadata.column_names = std::move(column_names);
+
+    auto result = MessageMeta::create_from_cpp(std::move(table), info.num_indices());
+
+    result->inherit_completions(*meta);
+
+    return result;
+}
+
+// ************ DropNullStageInterfaceProxy ************* //
+std::shared_ptr<DropNullStage> DropNullStageInterfaceProxy::init(neo::Segment &parent,
+                                                                 const std::string &name,
+                                                                 std::string column)
+{
+    auto stage = std::make_shared<DropNullStage>(parent, name, std::move(column));
+
+    FusedStageBuilder::register_node(parent, stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -17,129 +17,296 @@
 
 #include <morpheus/stages/file_source.hpp>
 
+#include <morpheus/io/mapped_file.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/table_util.hpp>
+
 #include <neo/core/segment.hpp>
 
+#include <cudf/binaryop.hpp>
+#include <cudf/filling.hpp>
 #include <cudf/io/csv.hpp>
 #include <cudf/io/json.hpp>
-#include <cudf/strings/replace.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/table/table.hpp>
 #include <cudf/types.hpp>
+#include <cudf/unary.hpp>
+#include <cudf/utilities/traits.hpp>
 #include <nvtext/subword_tokenize.hpp>
 
 #include <glog/logging.h>
-#include <pybind11/gil.h>
-#include <pybind11/pytypes.h>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <regex>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace morpheus {
+    // Component-private free functions.
+    // ************ FileSourceStage__ ************ //
+    /**
+     * @brief Casts the columns of a chunk to the types inferred for the first chunk, so every message has the same
+     * schema. Throws if the columns differ or a column cannot be cast.
+     */
+    static void FileSourceStage__conform_chunk(cudf::io::table_with_metadata &chunk,
+                                               const std::vector<std::string> &column_names,
+                                               const std::vector<cudf::data_type> &column_types,
+                                               const std::string &filename) {
+        if (chunk.metadata.column_names != column_names) {
+            throw std::runtime_error("Columns of a chunk of '" + filename + "' differ from the first chunk");
+        }
+
+        auto columns = chunk.tbl->release();
+
+        for (std::size_t i = 0; i < columns.size(); ++i) {
+            if (columns[i]->type() == column_types[i]) {
+                continue;
+            }
+
+            if (!cudf::is_fixed_width(columns[i]->type()) || !cudf::is_fixed_width(column_types[i])) {
+                throw std::runtime_error("Column '" + column_names[i] + "' of a chunk of '" + filename +
+                                         "' has a different type than in the first chunk");
+            }
+
+            columns[i] = cudf::cast(columns[i]->view(), column_types[i]);
+        }
+
+        chunk.tbl = std::make_unique<cudf::table>(std::move(columns));
+    }
+
+    /**
+     * @brief Adds `offset` to the index column so repeats of a file continue where the previous repeat ended.
+     */
+    static void FileSourceStage__offset_index(cudf::io::table_with_metadata &chunk, int64_t offset) {
+        auto columns = chunk.tbl->release();
+
+        columns[0] = cudf::binary_operation(columns[0]->view(),
+                                            cudf::numeric_scalar<int64_t>(offset),
+                                            cudf::binary_operator::ADD,
+                                            columns[0]->type());
+
+        chunk.tbl = std::make_unique<cudf::table>(std::move(columns));
+    }
+
+    /**
+     * @brief Prepends an INT64 index column counting up from `start`.
+     */
+    static void FileSourceStage__prepend_index(cudf::io::table_with_metadata &chunk, int64_t start) {
+        auto num_rows = chunk.tbl->num_rows();
+        auto columns  = chunk.tbl->release();
+
+        columns.insert(columns.begin(), cudf::sequence(num_rows, cudf::numeric_scalar<int64_t>(start)));
+        chunk.metadata.column_names.insert(chunk.metadata.column_names.begin(), "");
+
+        chunk.tbl = std::make_unique<cudf::table>(std::move(columns));
+    }
+
     // Component public implementations
     // ************ FileSourceStage ************* //
-    FileSourceStage::FileSourceStage(const neo::Segment &parent, const std::string &name, std::string filename,
-                                     int repeat) :
+    FileSourceStage::FileSourceStage(const neo::Segment &parent,
+                                     const std::string &name,
+                                     std::string filename,
+                                     int repeat,
+                                     std::size_t chunk_bytes,
+                                     bool use_mmap,
+                                     std::map<std::string, std::string> output_columns) :
             neo::SegmentObject(parent, name),
             base_t(parent, name),
             m_filename(std::move(filename)),
-            m_repeat(repeat) {
-        this->set_source_observable(neo::Observable<source_type_t>([this](neo::Subscriber<source_type_t> &sub) {
-            auto data_table = this->load_table();
+            m_repeat(repeat),
+            m_chunk_bytes(chunk_bytes),
+            m_use_mmap(use_mmap) {
+        for (const auto &[column_name, column_type]: output_columns) {
+            m_output_column_names.push_back(column_name);
+            m_output_column_types.push_back(DataType::from_numpy(column_type).type_id());
+        }
 
-            // Using 0 will default to creating a new range index
-            int index_col_count = 0;
+        this->set_source_observable(neo::Observable<source_type_t>([this](neo::Subscriber<source_type_t> &sub) {
+            if (m_use_mmap) {
+                // Mapped once per run, every repeat and chunk reads the same pages
+                m_mapped_file = std::make_unique<MappedFile>(m_filename);
+            }
 
-            // Check if we have a first column with INT64 data type
-            if (data_table.metadata.column_names.size() >= 1 &&
-                data_table.tbl->get_column(0).type().id() == cudf::type_id::INT64) {
-                std::regex index_regex(R"((unnamed: 0|id))",
-                                       std::regex_constants::ECMAScript | std::regex_constants::icase);
+            if (m_chunk_bytes > 0) {
+                this->emit_chunks(sub);
+            } else {
+                this->emit_table(sub);
+            }
 
-                // Get the column name
-                auto col_name = data_table.metadata.column_names[0];
+            m_mapped_file.reset();
+        }));
+    }
 
-                // Check it against some common terms
-                if (std::regex_search(col_name, index_regex)) {
-                    // Also, if its the hideous 'Unnamed: 0', then just use an empty string
-                    if (col_name == "Unnamed: 0") {
-                        data_table.metadata.column_names[0] = "";
-                    }
+    void FileSourceStage::emit_table(neo::Subscriber<source_type_t> &sub) {
+        auto data_table = this->load_table();
 
-                    index_col_count = 1;
-                }
-            }
+        int index_col_count = CuDFTableUtil::get_index_col_count(data_table);
 
-            // Next, create the message metadata. This gets reused for repeats
-            auto meta = MessageMeta::create_from_cpp(std::move(data_table), index_col_count);
+        const auto num_rows = static_cast<int64_t>(data_table.tbl->num_rows());
 
-            // Always push at least 1
-            sub.on_next(meta);
+        // Always push at least 1
+        const int repeat_count = std::max(m_repeat, 1);
 
-            for (cudf::size_type repeat_idx = 1; repeat_idx < m_repeat; ++repeat_idx) {
-                // Clone the previous meta object
-                {
-                    pybind11::gil_scoped_acquire gil;
+        for (int repeat_idx = 0; repeat_idx < repeat_count && sub.is_subscribed(); ++repeat_idx) {
+            cudf::io::table_with_metadata repeat_table;
 
-                    // Use the copy function
-                    auto df = meta->get_py_table().attr("copy")();
+            if (repeat_idx == repeat_count - 1) {
+                // Nothing left to copy for, hand over the loaded table
+                repeat_table = std::move(data_table);
+            } else {
+                // Every message gets its own columns since downstream stages may modify them. Copying on the
+                // device keeps repeats off the GIL
+                repeat_table.tbl = std::make_unique<cudf::table>(data_table.tbl->view());
+                repeat_table.metadata = data_table.metadata;
+            }
 
-                    pybind11::int_ df_len = pybind11::len(df);
+            int repeat_index_col_count = index_col_count;
 
-                    pybind11::object index = df.attr("index");
+            if (repeat_idx > 0) {
+                // Shift the index so each repeat continues where the previous one ended
+                if (index_col_count > 0) {
+                    FileSourceStage__offset_index(repeat_table, repeat_idx * num_rows);
+                } else {
+                    FileSourceStage__prepend_index(repeat_table, repeat_idx * num_rows);
+                    repeat_index_col_count = 1;
+                }
+            }
 
-                    df.attr("index") = index + df_len;
+            // Add the output columns up front, before the table is wrapped
+            MessageMeta::reserve_columns(repeat_table, m_output_column_names, m_output_column_types);
 
-                    meta = MessageMeta::create_from_python(std::move(df));
-                }
+            auto meta = MessageMeta::create_from_cpp(std::move(repeat_table), repeat_index_col_count);
+            meta->set_trace(MessageTrace::sample(MessageTrace::now_ns()));
 
-                sub.on_next(meta);
-            }
+            sub.on_next(std::move(meta));
+        }
 
-            sub.on_completed();
-        }));
+        sub.on_completed();
     }
 
     cudf::io::table_with_metadata FileSourceStage::load_table() {
+        MORPHEUS_DEVICE_RANGE("FileSourceStage::load_table");
+
         auto file_path = std::filesystem::path(m_filename);
 
         if (file_path.extension() == ".json" || file_path.extension() == ".jsonlines") {
             // First, load the file into json
-            auto options = cudf::io::json_reader_options::builder(cudf::io::source_info{m_filename}).lines(true);
+            auto options = cudf::io::json_reader_options::builder(this->make_source_info()).lines(true);
+
+            return CuDFTableUtil::load_json_table(options.build());
+        } else if (file_path.extension() == ".csv") {
+            auto options = cudf::io::csv_reader_options::builder(this->make_source_info());
+
+            return cudf::io::read_csv(options.build());
+        } else {
+            LOG(FATAL) << "Unknown extension for file: " << m_filename;
+            throw std::runtime_error("Unknown extension");
+        }
+    }
+
+    void FileSourceStage::emit_chunks(neo::Subscriber<source_type_t> &sub) {
+        const auto file_size = std::filesystem::file_size(m_filename);
+
+        std::vector<std::string> column_names;
+        std::vector<cudf::data_type> column_types;
+        int index_col_count = 0;
 
-            auto tbl = cudf::io::read_json(options.build());
+        // Rows emitted so far, used to continue the index across chunks and repeats
+        int64_t rows_emitted = 0;
 
-            auto found = std::find(tbl.metadata.column_names.begin(), tbl.metadata.column_names.end(), "data");
+        // Always push at least 1
+        const int repeat_count = std::max(m_repeat, 1);
 
-            if (found == tbl.metadata.column_names.end())
-                return tbl;
+        for (int repeat_idx = 0; repeat_idx < repeat_count && sub.is_subscribed(); ++repeat_idx) {
+            const int64_t repeat_start = rows_emitted;
 
-            // Super ugly but cudf cant handle newlines and add extra escapes. So we need to convert
-            // \\n -> \n
-            // \\/ -> \/
-            auto columns = tbl.tbl->release();
+            for (std::size_t offset = 0; offset < file_size && sub.is_subscribed(); offset += m_chunk_bytes) {
+                auto chunk = this->load_chunk(offset, column_names);
 
-            size_t idx = found - tbl.metadata.column_names.begin();
+                if (offset == 0 && column_names.empty()) {
+                    // The CSV header names the columns of the later chunks, even if no row starts in this one
+                    column_names = chunk.metadata.column_names;
+                }
+
+                auto num_rows = chunk.tbl->num_rows();
+
+                if (num_rows == 0) {
+                    // No row starts within this byte range
+                    continue;
+                }
+
+                if (column_types.empty()) {
+                    // The first chunk with any rows defines the schema of every message
+                    column_names = chunk.metadata.column_names;
 
-            auto updated_data = cudf::strings::replace(
-                    cudf::strings_column_view{columns[idx]->view()}, cudf::string_scalar("\\n"),
-                    cudf::string_scalar("\n"));
+                    for (const auto &column: chunk.tbl->view()) {
+                        column_types.push_back(column.type());
+                    }
 
-            updated_data = cudf::strings::replace(
-                    cudf::strings_column_view{updated_data->view()}, cudf::string_scalar("\\/"),
-                    cudf::string_scalar("/"));
+                    index_col_count = CuDFTableUtil::get_index_col_count(chunk);
+                } else {
+                    FileSourceStage__conform_chunk(chunk, column_names, column_types, m_filename);
 
-            columns[idx] = std::move(updated_data);
+                    if (index_col_count > 0 && chunk.metadata.column_names[0] == "Unnamed: 0") {
+                        chunk.metadata.column_names[0] = "";
+                    }
+                }
 
-            tbl.tbl = std::move(std::make_unique<cudf::table>(std::move(columns)));
+                if (index_col_count > 0) {
+                    if (repeat_start > 0) {
+                        FileSourceStage__offset_index(chunk, repeat_start);
+                    }
+                } else {
+                    FileSourceStage__prepend_index(chunk, rows_emitted);
+                }
 
-            return tbl;
+                // Add the output columns up front, before the table is wrapped
+                MessageMeta::reserve_columns(chunk, m_output_column_names, m_output_column_types);
+
+                auto meta = MessageMeta::create_from_cpp(std::move(chunk), 1);
+                meta->set_trace(MessageTrace::sample(MessageTrace::now_ns()));
+
+                rows_emitted += num_rows;
+
+                sub.on_next(std::move(meta));
+            }
+        }
+
+        sub.on_completed();
+    }
+
+    cudf::io::table_with_metadata FileSourceStage::load_chunk(std::size_t offset,
+                                                              const std::vector<std::string> &column_names) {
+        MORPHEUS_DEVICE_RANGE("FileSourceStage::load_chunk");
+
+        auto file_path = std::filesystem::path(m_filename);
+
+        if (file_path.extension() == ".json" || file_path.extension() == ".jsonlines") {
+            auto options = cudf::io::json_reader_options::builder(this->make_source_info())
+                    .lines(true)
+                    .byte_range_offset(offset)
+                    .byte_range_size(m_chunk_bytes);
+
+            return CuDFTableUtil::load_json_table(options.build());
         } else if (file_path.extension() == ".csv") {
-            auto options = cudf::io::csv_reader_options::builder(cudf::io::source_info{m_filename});
+            auto options = cudf::io::csv_reader_options::builder(this->make_source_info())
+                    .byte_range_offset(offset)
+                    .byte_range_size(m_chunk_bytes);
+
+            if (offset > 0) {
+                // Only the first chunk holds the header
+                options.header(-1).names(column_names);
+            }
 
             return cudf::io::read_csv(options.build());
         } else {
@@ -148,11 +315,25 @@ namespace morpheus {
         }
     }
 
+    cudf::io::source_info FileSourceStage::make_source_info() const {
+        if (m_mapped_file) {
+            return cudf::io::source_info(m_mapped_file->data(), m_mapped_file->size());
+        }
+
+        return cudf::io::source_info{m_filename};
+    }
+
     // ************ FileSourceStageInterfaceProxy ************ //
     std::shared_ptr<FileSourceStage>
-    FileSourceStageInterfaceProxy::init(neo::Segment &parent, const std::string &name, std::string filename,
-                                        int repeat) {
-        auto stage = std::make_shared<FileSourceStage>(parent, name, filename, repeat);
+    FileSourceStageInterfaceProxy::init(neo::Segment &parent,
+                                        const std::string &name,
+                                        std::string filename,
+                                        int repeat,
+                                        std::size_t chunk_bytes,
+                                        bool use_mmap,
+                                        std::map<std::string, std::string> output_columns) {
+        auto stage = std::make_shared<FileSourceStage>(
+                parent, name, filename, repeat, chunk_bytes, use_mmap, std::move(output_columns));
 
         parent.register_node<FileSourceStage>(stage);
 
@@ -17,20 +17,117 @@
 
 #include <morpheus/stages/filter_detection.hpp>
 
+#include <morpheus/messages/memory/response_memory_probs.hpp>
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/tensor.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/host_memory.hpp>
 #include <morpheus/utilities/matx_util.hpp>
 
+#include <cudf/column/column_view.hpp>
+#include <cudf/filling.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/stream_compaction.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+
+#include <rmm/cuda_stream_view.hpp>
+
 #include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace morpheus {
+// Component-private free functions.
+/**
+ * @brief Copies the rows of `x` where the device array of bools `row_mask` is true into a new message with its own
+ * MessageMeta and response memory. Returns nullptr when no rows are selected
+ */
+std::shared_ptr<MultiResponseProbsMessage> FilterDetectionsStage__compact(MultiResponseProbsMessage &x,
+                                                                          const rmm::device_buffer &row_mask)
+{
+    CHECK(x.mess_count == x.count) << "Copying detections requires one response row per message row";
+
+    MORPHEUS_DEVICE_RANGE("FilterDetectionsStage::compact");
+
+    const auto num_rows = static_cast<cudf::size_type>(x.count);
+
+    cudf::column_view mask{cudf::data_type{cudf::type_id::BOOL8}, num_rows, row_mask.data()};
+
+    // Row numbers of the detections, used to gather the response tensors
+    auto row_ids  = cudf::sequence(num_rows, cudf::numeric_scalar<int32_t>(0), cudf::numeric_scalar<int32_t>(1));
+    auto selected = cudf::apply_boolean_mask(cudf::table_view{{row_ids->view()}}, mask);
+
+    const auto selected_rows = static_cast<TensorIndex>(selected->num_rows());
+
+    if (selected_rows == 0)
+    {
+        return nullptr;
+    }
+
+    // Same layout as SerializeStage, index columns first
+    auto table_info   = x.get_meta();
+    auto column_names = table_info.get_index_names();
+    auto data_columns = table_info.get_column_names();
+    column_names.insert(column_names.end(), data_columns.begin(), data_columns.end());
+
+    cudf::io::table_with_metadata table{cudf::apply_boolean_mask(table_info.get_view(), mask),
+                                        cudf::io::table_metadata{}};
+    table.metadata.column_names = std::move(column_names);
+
+    auto meta = MessageMeta::create_from_cpp(std::move(table), table_info.num_indices());
+    meta->inherit_completions(*x.meta);
+
+    const auto *row_indices = selected->get_column(0).view().data<int32_t>();
+
+    auto gather = [&](const TensorObject &tensor) {
+        auto buffer = MatxUtil::gather_rows(tensor, row_indices, selected_rows, tensor.shape(1));
+
+        return Tensor::create(std::move(buffer),
+                              DType(tensor.dtype()),
+                              std::vector<TensorIndex>{selected_rows, tensor.shape(1)},
+                              std::vector<TensorIndex>{},
+                              0);
+    };
+
+    auto memory = std::make_shared<ResponseMemoryProbs>(selected_rows, gather(x.get_probs()));
+
+    for (std::size_t slot = 0; slot < x.memory->outputs.size(); ++slot)
+    {
+        const auto &name = x.memory->outputs.name_at(slot);
+
+        if (name != "probs")
+        {
+            memory->outputs.emplace(name, gather(x.get_output(slot)));
+        }
+    }
+
+    // gather_rows does not wait, and `selected` holds the row indices
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    return std::make_shared<MultiResponseProbsMessage>(
+        std::move(meta), 0, selected_rows, std::move(memory), 0, selected_rows);
+}
+
 // Component public implementations
 // ************ FilterDetectionStage **************************** //
-FilterDetectionsStage::FilterDetectionsStage(const neo::Segment &parent, const std::string &name, float threshold) :
+FilterDetectionsStage::FilterDetectionsStage(const neo::Segment &parent,
+                                             const std::string &name,
+                                             float threshold,
+                                             bool copy) :
   neo::SegmentObject(parent, name),
   PythonNode(parent, name, build_operator()),
-  m_threshold(threshold)
+  m_threshold(threshold),
+  m_copy(copy),
+  m_metrics(StageMetrics::get(name))
 {}
 
 FilterDetectionsStage::operator_fn_t FilterDetectionsStage::build_operator()
@@ -39,56 +136,51 @@ FilterDetectionsStage::operator_fn_t FilterDetectionsStage::build_operator()
         [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
             return input.subscribe(neo::make_observer<reader_type_t>(
                 [this, &output](reader_type_t &&x) {
-                    const auto &probs  = x->get_probs();
-                    const auto &shape  = probs.get_shape();
-                    const auto &stride = probs.get_stride();
+                    DeviceMemory::ScopedTag memory_tag("FilterDetectionsStage");
+                    StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                    const auto &probs = x->get_probs();
+                    const auto &shape = probs.get_shape();
 
                     CHECK(probs.rank() == 2)
                         << "C++ impl of the FilterDetectionsStage currently only supports two dimensional arrays";
 
-                    const std::size_t num_rows    = shape[0];
-                    const std::size_t num_columns = shape[1];
+                    const std::size_t num_rows = shape[0];
 
-                    // A bit ugly, but we cant get access to the rmm::device_buffer here. So make a copy
-                    auto tmp_buffer = std::make_shared<rmm::device_buffer>(probs.count() * probs.dtype_size(),
-                                                                           rmm::cuda_stream_per_thread);
+                    // Threshold straight from probs, no copy is needed since probs is only read
+                    auto thresh_bool_buffer = MatxUtil::threshold(probs, m_threshold, true);
 
-                    NEO_CHECK_CUDA(
-                        cudaMemcpy(tmp_buffer->data(), probs.data(), tmp_buffer->size(), cudaMemcpyDeviceToDevice));
+                    if (m_copy)
+                    {
+                        // Compact on the device into a single dense message
+                        auto compacted = FilterDetectionsStage__compact(*x, *thresh_bool_buffer);
 
-                    // Depending on the input the stride is given in bytes or elements,
-                    // divide the stride elements by the smallest item to ensure tensor_stride is defined in
-                    // terms of elements
-                    std::vector<TensorIndex> tensor_stride(stride.size());
-                    auto min_stride = std::min_element(stride.cbegin(), stride.cend());
+                        if (compacted)
+                        {
+                            metrics_scope.emit(output, std::move(compacted));
+                        }
 
-                    std::transform(stride.cbegin(),
-                                   stride.cend(),
-                                   tensor_stride.begin(),
-                                   std::bind(std::divides<>(), std::placeholders::_1, *min_stride));
+                        return;
+                    }
 
-                    // Now call the threshold function
-                    auto thresh_bool_buffer =
-                        MatxUtil::threshold(DevMemInfo{probs.count(), probs.dtype().type_id(), tmp_buffer, 0},
-                                            num_rows,
-                                            num_columns,
-                                            tensor_stride,
-                                            m_threshold,
-                                            true);
+                    // Pinned so the copy runs at full bandwidth
+                    auto host_bool_values = PinnedHostPool::acquire(thresh_bool_buffer->size());
 
-                    std::vector<uint8_t> host_bool_values(num_rows);
+                    // Copy bools back to host, the only point where we need to wait on the device
+                    NEO_CHECK_CUDA(cudaMemcpyAsync(host_bool_values.data(),
+                                                   thresh_bool_buffer->data(),
+                                                   thresh_bool_buffer->size(),
+                                                   cudaMemcpyDeviceToHost,
+                                                   thresh_bool_buffer->stream().value()));
 
-                    // Copy bools back to host
-                    NEO_CHECK_CUDA(cudaMemcpy(host_bool_values.data(),
-                                              thresh_bool_buffer->data(),
-                                              thresh_bool_buffer->size(),
-                                              cudaMemcpyDeviceToHost));
+                    NEO_CHECK_CUDA(cudaStreamSynchronize(thresh_bool_buffer->stream().value()));
 
                     // We are slicing by rows, using num_rows as our marker for undefined
+                    std::vector<std::pair<std::size_t, std::size_t>> ranges;
                     std::size_t slice_start = num_rows;
                     for (std::size_t row = 0; row < num_rows; ++row)
                     {
-                        bool above_threshold = host_bool_values[row];
+                        bool above_threshold = host_bool_values.data()[row];
 
                         if (above_threshold && slice_start == num_rows)
                         {
@@ -96,7 +188,7 @@ FilterDetectionsStage::operator_fn_t FilterDetectionsStage::build_operator()
                         }
                         else if (!above_threshold && slice_start != num_rows)
                         {
-                            output.on_next(x->get_slice(slice_start, row));
+                            ranges.emplace_back(slice_start, row);
                             slice_start = num_rows;
                         }
                     }
@@ -104,7 +196,13 @@ FilterDetectionsStage::operator_fn_t FilterDetectionsStage::build_operator()
                     if (slice_start != num_rows)
                     {
                         // Last row was above the threshold
-                        output.on_next(x->get_slice(slice_start, num_rows));
+                        ranges.emplace_back(slice_start, num_rows);
+                    }
+
+                    // All slices share a single allocation
+                    for (auto &slice : x->get_slices(ranges))
+                    {
+                        metrics_scope.emit(output, std::move(slice));
                     }
                 },
                 [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
@@ -115,11 +213,12 @@ FilterDetectionsStage::operator_fn_t FilterDetectionsStage::build_operator()
 // ************ FilterDetectionStageInterfaceProxy ************* //
 std::shared_ptr<FilterDetectionsStage> FilterDetectionStageInterfaceProxy::init(neo::Segment &parent,
                                                                                 const std::string &name,
-                                                                                float threshold)
+                                                                                float threshold,
+                                                                                bool copy)
 {
-    auto stage = std::make_shared<FilterDetectionsStage>(parent, name, threshold);
+    auto stage = std::make_shared<FilterDetectionsStage>(parent, name, threshold, copy);
 
-    parent.register_node<FilterDetectionsStage>(stage);
+    FusedStageBuilder::register_node(parent, stage);
 
     return stage;
 }
@@ -0,0 +1,86 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/stages/forest_inference.hpp>
+
+#include <morpheus/messages/memory/response_memory.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <neo/core/segment.hpp>
+#include <neo/cuda/common.hpp>
+#include <pyneo/node.hpp>
+
+#include <glog/logging.h>
+#include <rmm/cuda_stream_view.hpp>
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace morpheus {
+// Component public implementations
+// ************ ForestInferenceStage ************************* //
+ForestInferenceStage::ForestInferenceStage(const neo::Segment &parent,
+                                           const std::string &name,
+                                           const std::string &model_filename) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_model(ForestModel::load_xgboost_json(model_filename)),
+  m_metrics(StageMetrics::get(name))
+{}
+
+ForestInferenceStage::operator_fn_t ForestInferenceStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output](reader_type_t &&x) {
+                DeviceMemory::ScopedTag memory_tag("ForestInferenceStage");
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                // Reads the features straight from the message, the model handles strided and FLOAT64 inputs
+                auto probs = m_model->predict(x->get_input("input__0"));
+
+                // Downstream stages read the probabilities on other streams
+                NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+                auto memory = std::make_shared<ResponseMemory>(x->count);
+                memory->outputs["probs"] = std::move(probs);
+
+                auto next = std::make_shared<MultiResponseProbsMessage>(
+                    x->meta, x->mess_offset, x->mess_count, std::move(memory), 0, x->count);
+
+                metrics_scope.emit(output, std::move(next));
+            },
+            [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [&]() { output.on_completed(); }));
+    };
+}
+
+// ************ ForestInferenceStageInterfaceProxy *********** //
+std::shared_ptr<ForestInferenceStage> ForestInferenceStageInterfaceProxy::init(neo::Segment &parent,
+                                                                               const std::string &name,
+                                                                               const std::string &model_filename)
+{
+    auto stage = std::make_shared<ForestInferenceStage>(parent, name, model_filename);
+
+    FusedStageBuilder::register_node(parent, stage);
+
+    return stage;
+}
+}  // namespace morpheus
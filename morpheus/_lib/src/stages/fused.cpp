@@ -0,0 +1,216 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/stages/fused.hpp>
+
+#include <morpheus/utilities/device_affinity.hpp>
+
+#include <neo/core/segment.hpp>
+#include <pyneo/node.hpp>
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace morpheus {
+    // Component-private free functions.
+    // ************ FusedStage__ ************ //
+    constexpr std::size_t FusedStageMessageCount = std::variant_size_v<FusedStageMessage>;
+
+    static thread_local FusedStageBuilder *FusedStageBuilder__capturing = nullptr;
+
+    template<std::size_t OutputIndex, std::size_t InputIndex>
+    constexpr bool FusedStage__is_related() {
+        using output_t = typename std::variant_alternative_t<OutputIndex, FusedStageMessage>::element_type;
+        using input_t = typename std::variant_alternative_t<InputIndex, FusedStageMessage>::element_type;
+
+        // Derived to base always works, base to derived is checked for every message by fused_message_cast
+        return std::is_base_of_v<input_t, output_t> || std::is_base_of_v<output_t, input_t>;
+    }
+
+    template<std::size_t... Indices>
+    constexpr std::array<bool, sizeof...(Indices)> FusedStage__related_table(std::index_sequence<Indices...>) {
+        return {FusedStage__is_related<Indices / FusedStageMessageCount, Indices % FusedStageMessageCount>()...};
+    }
+
+    // Whether messages of the alternative `output * FusedStageMessageCount + input` can be passed between stages
+    constexpr auto FusedStageRelated =
+            FusedStage__related_table(std::make_index_sequence<FusedStageMessageCount * FusedStageMessageCount>());
+
+    using FusedStage__factory_fn_t = std::shared_ptr<neo::SegmentObject> (*)(
+            neo::Segment &, const std::string &, std::vector<std::shared_ptr<FusedStageLink>>, std::vector<int>);
+
+    template<std::size_t InputIndex, std::size_t OutputIndex>
+    std::shared_ptr<neo::SegmentObject> FusedStage__make(neo::Segment &parent,
+                                                         const std::string &name,
+                                                         std::vector<std::shared_ptr<FusedStageLink>> links,
+                                                         std::vector<int> device_ids) {
+        using stage_t = FusedStage<std::variant_alternative_t<InputIndex, FusedStageMessage>,
+                                   std::variant_alternative_t<OutputIndex, FusedStageMessage>>;
+
+        auto stage = std::make_shared<stage_t>(parent, name, std::move(links), std::move(device_ids));
+
+        parent.register_node<stage_t>(stage);
+
+        return stage;
+    }
+
+    template<std::size_t... Indices>
+    constexpr std::array<FusedStage__factory_fn_t, sizeof...(Indices)> FusedStage__factory_table(
+            std::index_sequence<Indices...>) {
+        return {&FusedStage__make<Indices / FusedStageMessageCount, Indices % FusedStageMessageCount>...};
+    }
+
+    // Creates the FusedStage for the alternatives `input * FusedStageMessageCount + output`
+    constexpr auto FusedStageFactories =
+            FusedStage__factory_table(std::make_index_sequence<FusedStageMessageCount * FusedStageMessageCount>());
+
+    /**
+     * @brief Returns `input` with the calling thread bound to `device_id` before each message is passed on.
+     */
+    static std::shared_ptr<FusedStageLink::stream_t> FusedStage__bind_device(
+            std::shared_ptr<FusedStageLink::stream_t> input, int device_id) {
+        if (device_id < 0) {
+            return input;
+        }
+
+        return std::make_shared<FusedStageLink::stream_t>([input, device_id](neo::Subscriber<FusedStageMessage> &sub) {
+            input->subscribe(neo::make_observer<FusedStageMessage>(
+                    [&sub, device_id](FusedStageMessage &&x) {
+                        DeviceAffinity::bind_current_thread(device_id);
+                        sub.on_next(std::move(x));
+                    },
+                    [&sub](std::exception_ptr error_ptr) { sub.on_error(error_ptr); },
+                    [&sub]() { sub.on_completed(); }));
+        });
+    }
+
+    // Component public implementations
+    // ************ FusedStage **************************** //
+    template<typename InputT, typename OutputT>
+    FusedStage<InputT, OutputT>::FusedStage(const neo::Segment &parent,
+                                            const std::string &name,
+                                            std::vector<std::shared_ptr<FusedStageLink>> links,
+                                            std::vector<int> device_ids) :
+            neo::SegmentObject(parent, name),
+            base_t(parent, name, build_operator()),
+            m_links(std::move(links)),
+            m_device_ids(std::move(device_ids)) {}
+
+    template<typename InputT, typename OutputT>
+    typename FusedStage<InputT, OutputT>::operator_fn_t FusedStage<InputT, OutputT>::build_operator() {
+        return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+            // Called once per concurrent instance
+            const int device_id =
+                    m_device_ids.empty() ? -1 : m_device_ids[m_next_instance.fetch_add(1) % m_device_ids.size()];
+
+            DeviceAffinity::bind_current_thread(device_id);
+
+            auto stream = std::make_shared<FusedStageLink::stream_t>([&input](neo::Subscriber<FusedStageMessage> &sub) {
+                input.subscribe(neo::make_observer<reader_type_t>(
+                        [&sub](reader_type_t &&x) { sub.on_next(FusedStageMessage(std::move(x))); },
+                        [&sub](std::exception_ptr error_ptr) { sub.on_error(error_ptr); },
+                        [&sub]() { sub.on_completed(); }));
+            });
+
+            // Each link subscribes to the one before it once the last one is subscribed to
+            for (const auto &link: m_links) {
+                stream = link->apply(FusedStage__bind_device(std::move(stream), device_id));
+            }
+
+            // The observer keeps the chain alive for as long as the subscription
+            return stream->subscribe(neo::make_observer<FusedStageMessage>(
+                    [&output, stream](FusedStageMessage &&x) {
+                        output.on_next(fused_message_cast<writer_type_t>(std::move(x)));
+                    },
+                    [&output](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+                    [&output]() { output.on_completed(); }));
+        };
+    }
+
+    // ************ FusedStageBuilder ********************* //
+    FusedStageBuilder::~FusedStageBuilder() {
+        if (FusedStageBuilder__capturing == this) {
+            FusedStageBuilder__capturing = nullptr;
+        }
+    }
+
+    void FusedStageBuilder::begin_capture() {
+        if (FusedStageBuilder__capturing != nullptr) {
+            throw std::runtime_error("A FusedStageBuilder is already capturing stages on this thread");
+        }
+
+        FusedStageBuilder__capturing = this;
+    }
+
+    void FusedStageBuilder::end_capture() {
+        if (FusedStageBuilder__capturing == this) {
+            FusedStageBuilder__capturing = nullptr;
+        }
+    }
+
+    std::size_t FusedStageBuilder::size() const {
+        return m_links.size();
+    }
+
+    std::shared_ptr<neo::SegmentObject> FusedStageBuilder::build(neo::Segment &parent,
+                                                                 const std::string &name,
+                                                                 std::vector<int> device_ids) {
+        if (m_links.empty()) {
+            throw std::invalid_argument("Cannot build fused stage '" + name + "' without any stages");
+        }
+
+        for (std::size_t i = 1; i < m_links.size(); ++i) {
+            const auto output_index = m_links[i - 1]->output_index();
+            const auto input_index = m_links[i]->input_index();
+
+            if (!FusedStageRelated[output_index * FusedStageMessageCount + input_index]) {
+                throw std::invalid_argument("Stage " + std::to_string(i) + " of fused stage '" + name +
+                                            "' consumes " + FusedStageMessageNames[input_index] +
+                                            " but the stage before it produces " +
+                                            FusedStageMessageNames[output_index]);
+            }
+        }
+
+        const auto input_index = m_links.front()->input_index();
+        const auto output_index = m_links.back()->output_index();
+
+        VLOG(10) << "Fusing " << m_links.size() << " stages into '" << name << "', "
+                 << FusedStageMessageNames[input_index] << " -> " << FusedStageMessageNames[output_index] << " on "
+                 << std::max<std::size_t>(device_ids.size(), 1) << " devices";
+
+        auto links = std::move(m_links);
+        m_links.clear();
+
+        return FusedStageFactories[input_index * FusedStageMessageCount + output_index](
+                parent, name, std::move(links), std::move(device_ids));
+    }
+
+    FusedStageBuilder *FusedStageBuilder::capturing() {
+        return FusedStageBuilder__capturing;
+    }
+}  // namespace morpheus
@@ -0,0 +1,524 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/generate_viz_frames.hpp>
+
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+
+#include <neo/core/segment_object.hpp>
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cudf/binaryop.hpp>
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/column/column_view.hpp>
+#include <cudf/concatenate.hpp>
+#include <cudf/copying.hpp>
+#include <cudf/interop.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/sorting.hpp>
+#include <cudf/stream_compaction.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/utilities/traits.hpp>
+
+#include <arrow/io/file.h>
+#include <arrow/io/interfaces.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/result.h>
+#include <arrow/status.h>
+#include <arrow/table.h>
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ GenerateVizFramesStage__SocketStream ************ //
+/**
+ * @brief Arrow output stream writing to a connected TCP socket.
+ */
+class GenerateVizFramesStage__SocketStream : public arrow::io::OutputStream
+{
+  public:
+    explicit GenerateVizFramesStage__SocketStream(const std::string &address)
+    {
+        const auto separator = address.rfind(':');
+
+        if (separator == std::string::npos || separator == 0 || separator + 1 == address.size())
+        {
+            throw std::invalid_argument("Viz frames socket must be given as 'host:port', not '" + address + "'");
+        }
+
+        const auto host = address.substr(0, separator);
+        const auto port = address.substr(separator + 1);
+
+        addrinfo hints{};
+        hints.ai_family   = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+
+        addrinfo *addresses = nullptr;
+
+        if (auto result = getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses); result != 0)
+        {
+            throw std::runtime_error("Unable to resolve viz frames socket '" + address + "': " + gai_strerror(result));
+        }
+
+        int error = 0;
+
+        for (auto *candidate = addresses; candidate != nullptr && m_fd < 0; candidate = candidate->ai_next)
+        {
+            m_fd = socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+
+            if (m_fd >= 0 && connect(m_fd, candidate->ai_addr, candidate->ai_addrlen) != 0)
+            {
+                error = errno;
+                ::close(m_fd);
+                m_fd = -1;
+            }
+            else if (m_fd < 0)
+            {
+                error = errno;
+            }
+        }
+
+        freeaddrinfo(addresses);
+
+        if (m_fd < 0)
+        {
+            throw std::runtime_error("Unable to connect to viz frames socket '" + address +
+                                     "': " + std::strerror(error));
+        }
+    }
+
+    ~GenerateVizFramesStage__SocketStream() override
+    {
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+        }
+    }
+
+    arrow::Status Close() override
+    {
+        if (m_fd >= 0 && ::close(m_fd) != 0)
+        {
+            m_fd = -1;
+            return arrow::Status::IOError("Failed to close viz frames socket: ", std::strerror(errno));
+        }
+
+        m_fd = -1;
+
+        return arrow::Status::OK();
+    }
+
+    bool closed() const override
+    {
+        return m_fd < 0;
+    }
+
+    arrow::Result<int64_t> Tell() const override
+    {
+        return m_position;
+    }
+
+    arrow::Status Write(const void *data, int64_t nbytes) override
+    {
+        const auto *bytes = static_cast<const char *>(data);
+
+        while (nbytes > 0)
+        {
+            // Never raise SIGPIPE when the dashboard goes away, fail the write instead
+            auto sent = send(m_fd, bytes, static_cast<std::size_t>(nbytes), MSG_NOSIGNAL);
+
+            if (sent < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+
+                return arrow::Status::IOError("Failed to write to viz frames socket: ", std::strerror(errno));
+            }
+
+            bytes += sent;
+            nbytes -= sent;
+            m_position += sent;
+        }
+
+        return arrow::Status::OK();
+    }
+
+    using arrow::io::OutputStream::Write;
+
+  private:
+    int m_fd{-1};
+    int64_t m_position{0};
+};
+
+// ************ GenerateVizFramesStage__State ************ //
+struct GenerateVizFramesStage__State
+{
+    // Label of every row code, `none` last
+    std::unique_ptr<cudf::column> labels;
+
+    // Rows of each second not written yet, in arrival order
+    std::map<int64_t, std::vector<std::unique_ptr<cudf::table>>> pending;
+    std::optional<int64_t> newest_second;
+
+    // Second of the first frame written, the file names are offsets from it
+    std::optional<int64_t> first_second;
+    std::map<int64_t, int> frames_per_second;
+
+    std::shared_ptr<GenerateVizFramesStage__SocketStream> socket;
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> stream_writer;
+};
+
+// Component-private free functions.
+const std::vector<std::string> GenerateVizFramesStage__InputColumns{
+    "timestamp", "src_ip", "dest_ip", "src_port", "dest_port", "data"};
+
+const std::vector<std::string> GenerateVizFramesStage__FrameColumns{
+    "timestamp", "src_ip", "dest_ip", "src_port", "dest_port", "si", "data"};
+
+void GenerateVizFramesStage__check(const arrow::Status &status)
+{
+    if (!status.ok())
+    {
+        throw std::runtime_error("Failed to write viz frame: " + status.ToString());
+    }
+}
+
+template <typename T>
+T GenerateVizFramesStage__check(arrow::Result<T> result)
+{
+    GenerateVizFramesStage__check(result.status());
+
+    return std::move(result).ValueOrDie();
+}
+
+std::shared_ptr<arrow::Table> GenerateVizFramesStage__to_arrow(const cudf::table_view &frame)
+{
+    std::vector<cudf::column_metadata> metadata;
+    metadata.reserve(GenerateVizFramesStage__FrameColumns.size());
+
+    for (const auto &name : GenerateVizFramesStage__FrameColumns)
+    {
+        metadata.emplace_back(name);
+    }
+
+    return cudf::to_arrow(frame, metadata);
+}
+
+std::unique_ptr<cudf::table> GenerateVizFramesStage__sort_by_time(const cudf::table_view &rows)
+{
+    auto order = cudf::stable_sorted_order(cudf::table_view{{rows.column(0)}});
+
+    return cudf::gather(rows, order->view());
+}
+
+// Component public implementations
+// ************ GenerateVizFramesStage ************************* //
+GenerateVizFramesStage::GenerateVizFramesStage(const neo::Segment &parent,
+                                               const std::string &name,
+                                               std::string out_dir,
+                                               std::string out_socket,
+                                               std::vector<std::string> labels) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_out_dir(std::move(out_dir)),
+  m_out_socket(std::move(out_socket)),
+  m_labels(std::move(labels)),
+  m_metrics(StageMetrics::get(name))
+{}
+
+GenerateVizFramesStage::operator_fn_t GenerateVizFramesStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        auto state = std::make_shared<GenerateVizFramesStage__State>();
+
+        {
+            DeviceMemory::ScopedTag memory_tag("GenerateVizFramesStage");
+
+            std::vector<std::unique_ptr<cudf::column>> labels;
+            std::vector<cudf::column_view> label_views;
+
+            for (const auto &label : m_labels)
+            {
+                labels.emplace_back(cudf::make_column_from_scalar(cudf::string_scalar(label), 1));
+                label_views.push_back(labels.back()->view());
+            }
+
+            labels.emplace_back(cudf::make_column_from_scalar(cudf::string_scalar("none"), 1));
+            label_views.push_back(labels.back()->view());
+
+            state->labels = cudf::concatenate(label_views);
+        }
+
+        if (!m_out_socket.empty())
+        {
+            state->socket = std::make_shared<GenerateVizFramesStage__SocketStream>(m_out_socket);
+        }
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, state, &output](reader_type_t &&x) {
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                this->add_rows(*state, *x);
+
+                if (state->newest_second.has_value())
+                {
+                    this->write_frames(*state, *state->newest_second, false);
+                }
+
+                metrics_scope.emit(output, std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [this, state, &output]() {
+                this->write_frames(*state, 0, true);
+
+                if (state->stream_writer)
+                {
+                    GenerateVizFramesStage__check(state->stream_writer->Close());
+                }
+
+                if (state->socket)
+                {
+                    GenerateVizFramesStage__check(state->socket->Close());
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+void GenerateVizFramesStage::add_rows(GenerateVizFramesStage__State &state, MultiResponseProbsMessage &x) const
+{
+    if (x.mess_count == 0)
+    {
+        return;
+    }
+
+    MORPHEUS_DEVICE_RANGE("GenerateVizFramesStage::add_rows");
+    DeviceMemory::ScopedTag memory_tag("GenerateVizFramesStage");
+
+    auto info        = x.get_meta(GenerateVizFramesStage__InputColumns);
+    const auto probs = x.get_probs();
+    const auto shape = probs.get_shape();
+
+    CHECK(shape.size() == 2 && shape[1] == static_cast<TensorIndex>(m_labels.size()))
+        << "Label count does not match output of model. Label count: " << m_labels.size()
+        << ", Model output: " << shape[1];
+
+    const auto num_rows = info.num_rows();
+
+    const auto &timestamp = info.get_column(0);
+
+    if (!cudf::is_numeric(timestamp.type()))
+    {
+        throw std::runtime_error("The 'timestamp' column of the viz frames must be numeric milliseconds");
+    }
+
+    // Largest probability of each row when one reaches the threshold, `none` otherwise
+    auto row_passes = MatxUtil::threshold(probs, 0.5, true);
+    auto row_argmax = MatxUtil::argmax(probs);
+
+    const cudf::column_view passes_view(cudf::data_type{cudf::type_id::BOOL8}, num_rows, row_passes->data());
+    const cudf::column_view argmax_view(cudf::data_type{cudf::type_id::INT32}, num_rows, row_argmax->data());
+
+    auto codes = cudf::copy_if_else(
+        argmax_view, cudf::numeric_scalar<int32_t>(static_cast<int32_t>(m_labels.size())), passes_view);
+
+    auto si = cudf::gather(cudf::table_view{{state.labels->view()}}, codes->view())->release();
+
+    auto seconds = cudf::binary_operation(timestamp,
+                                          cudf::numeric_scalar<int64_t>(1000),
+                                          cudf::binary_operator::DIV,
+                                          cudf::data_type{cudf::type_id::INT64});
+
+    seconds = cudf::binary_operation(seconds->view(),
+                                     cudf::numeric_scalar<int64_t>(1000),
+                                     cudf::binary_operator::MUL,
+                                     cudf::data_type{cudf::type_id::INT64});
+
+    // Frame columns, with the second of every row last
+    std::vector<cudf::column_view> columns;
+
+    for (cudf::size_type i = 0; i < info.num_columns(); ++i)
+    {
+        if (i == 5)
+        {
+            columns.push_back(si.front()->view());
+        }
+
+        columns.push_back(info.get_column(i));
+    }
+
+    columns.push_back(seconds->view());
+
+    // Rows without a time belong to no frame
+    auto rows = GenerateVizFramesStage__sort_by_time(
+        timestamp.has_nulls() ? cudf::drop_nulls(cudf::table_view{columns}, {0})->view() : cudf::table_view{columns});
+
+    const auto rows_view = rows->view();
+    const auto num_kept  = rows_view.num_rows();
+
+    if (num_kept == 0)
+    {
+        return;
+    }
+
+    std::vector<int64_t> row_seconds(num_kept);
+
+    NEO_CHECK_CUDA(cudaMemcpy(row_seconds.data(),
+                              rows_view.column(rows_view.num_columns() - 1).data<int64_t>(),
+                              num_kept * sizeof(int64_t),
+                              cudaMemcpyDeviceToHost));
+
+    // Sorted by time, so every second is a single run of rows
+    const auto frame_view = cudf::table_view{std::vector<cudf::column_view>(rows_view.begin(), rows_view.end() - 1)};
+
+    for (cudf::size_type start = 0; start < num_kept;)
+    {
+        auto stop = start + 1;
+
+        while (stop < num_kept && row_seconds[stop] == row_seconds[start])
+        {
+            ++stop;
+        }
+
+        auto second_rows = cudf::slice(frame_view, {start, stop}).front();
+
+        state.pending[row_seconds[start]].emplace_back(std::make_unique<cudf::table>(second_rows));
+
+        start = stop;
+    }
+
+    if (!state.newest_second.has_value() || row_seconds.back() > *state.newest_second)
+    {
+        state.newest_second = row_seconds.back();
+    }
+}
+
+void GenerateVizFramesStage::write_frames(GenerateVizFramesStage__State &state, int64_t before, bool all) const
+{
+    while (!state.pending.empty() && (all || state.pending.begin()->first < before))
+    {
+        MORPHEUS_DEVICE_RANGE("GenerateVizFramesStage::write_frames");
+        DeviceMemory::ScopedTag memory_tag("GenerateVizFramesStage");
+
+        auto pending = state.pending.begin();
+
+        const auto second = pending->first;
+        auto &parts       = pending->second;
+
+        std::unique_ptr<cudf::table> frame;
+
+        if (parts.size() == 1)
+        {
+            frame = std::move(parts.front());
+        }
+        else
+        {
+            std::vector<cudf::table_view> part_views;
+
+            for (const auto &part : parts)
+            {
+                part_views.push_back(part->view());
+            }
+
+            frame = GenerateVizFramesStage__sort_by_time(cudf::concatenate(part_views)->view());
+        }
+
+        state.pending.erase(pending);
+
+        auto table = GenerateVizFramesStage__to_arrow(frame->view());
+
+        if (state.socket)
+        {
+            if (!state.stream_writer)
+            {
+                state.stream_writer =
+                    GenerateVizFramesStage__check(arrow::ipc::MakeStreamWriter(state.socket, table->schema()));
+            }
+
+            GenerateVizFramesStage__check(state.stream_writer->WriteTable(*table));
+
+            continue;
+        }
+
+        if (!state.first_second.has_value())
+        {
+            state.first_second = second;
+        }
+
+        auto filename = m_out_dir + "/" + std::to_string((second - *state.first_second) / 1000) + ".0";
+
+        if (auto count = state.frames_per_second[second]++; count > 0)
+        {
+            // Late rows of a second already written
+            filename += "-" + std::to_string(count);
+        }
+
+        filename += ".arrow";
+
+        auto file   = GenerateVizFramesStage__check(arrow::io::FileOutputStream::Open(filename));
+        auto writer = GenerateVizFramesStage__check(arrow::ipc::MakeFileWriter(file, table->schema()));
+
+        GenerateVizFramesStage__check(writer->WriteTable(*table));
+        GenerateVizFramesStage__check(writer->Close());
+        GenerateVizFramesStage__check(file->Close());
+    }
+}
+
+// ************ GenerateVizFramesStageInterfaceProxy ************ //
+std::shared_ptr<GenerateVizFramesStage> GenerateVizFramesStageInterfaceProxy::init(neo::Segment &parent,
+                                                                                   const std::string &name,
+                                                                                   std::string out_dir,
+                                                                                   std::string out_socket,
+                                                                                   std::vector<std::string> labels)
+{
+    auto stage = std::make_shared<GenerateVizFramesStage>(
+        parent, name, std::move(out_dir), std::move(out_socket), std::move(labels));
+
+    parent.register_node<GenerateVizFramesStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -18,27 +18,51 @@
 #include <morpheus/stages/kafka_source.hpp>
 
 #include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/kafka_message_decoder.hpp>
+#include <morpheus/stages/kafka_source_detail.hpp>
+#include <morpheus/utilities/device_affinity.hpp>
+#include <morpheus/utilities/json_util.hpp>
+#include <morpheus/utilities/pipeline_drain.hpp>
 #include <morpheus/utilities/stage_util.hpp>
 #include <morpheus/utilities/string_util.hpp>
+#include <morpheus/utilities/table_util.hpp>
 
 #include <neo/core/segment.hpp>
+#include <neo/cuda/common.hpp>
 #include <pyneo/node.hpp>
 
 #include <glog/logging.h>
 #include <http_client.h>
 #include <librdkafka/rdkafkacpp.h>
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
 #include <boost/fiber/recursive_mutex.hpp>
+#include <cuda_runtime.h>
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
 #include <cudf/io/csv.hpp>
 #include <cudf/io/json.hpp>
-#include <cudf/strings/replace.hpp>
-#include <nlohmann/json.hpp>
+#include <cudf/null_mask.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/scalar/scalar_factories.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/utilities/traits.hpp>
 #include <nvtext/subword_tokenize.hpp>
-
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <exception>
 #include <functional>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -56,21 +80,659 @@
     };
 
 namespace morpheus {
+// When adaptive batching is enabled the batch size target never drops below max_batch_size / this value
+constexpr std::size_t AdaptiveBatchMinFraction = 16;
+
+// Time spent in on_next above which the downstream is considered to be applying backpressure
+constexpr std::chrono::milliseconds AdaptiveBatchBackpressureThreshold{1};
+
+// Number of batches a partition keeps parsing while it consumes the next one, before waiting to emit the oldest
+constexpr std::size_t PartitionBatchesInFlight = 4;
+
+// Parse tasks stay on the queue of their partition unless it holds this many more tasks than the least loaded queue
+constexpr std::size_t TaskQueueAffinitySlack = 2;
+
+// Written by librdkafka to a partition's eventfd when its queue goes from empty to non-empty
+constexpr uint64_t QueueEventIncrement = 1;
+
+// How long a replay waits for the brokers to look up the offsets of its start timestamp
+constexpr int OffsetsForTimesTimeoutMs = 10000;
+
+// How often the consumer is polled to serve rebalances while partition fibers consume their queues
+constexpr std::chrono::milliseconds RebalancePollInterval{100};
+
+// How often a partition paused by backpressure checks whether downstream caught up
+constexpr std::chrono::milliseconds BackpressurePollInterval{10};
+
+// Names of the optional columns filled from the metadata of each message
+constexpr const char *MetadataKeyColumn       = "_key";
+constexpr const char *MetadataTimestampColumn = "_ts";
+constexpr const char *MetadataPartitionColumn = "_partition";
+constexpr const char *MetadataOffsetColumn    = "_offset";
+
+// Component-private free functions.
+// ************ KafkaSourceStage__ ************ //
+static std::string KafkaSourceStage__partition_key(const RdKafka::TopicPartition &partition)
+{
+    return partition.topic() + ":" + std::to_string(partition.partition());
+}
+
+/**
+ * @brief JSON reader type names which can be given in a schema
+ */
+static const std::map<std::string, cudf::type_id> &KafkaSourceStage__schema_types()
+{
+    static const std::map<std::string, cudf::type_id> schema_types{{"bool", cudf::type_id::BOOL8},
+                                                                   {"float32", cudf::type_id::FLOAT32},
+                                                                   {"float64", cudf::type_id::FLOAT64},
+                                                                   {"int8", cudf::type_id::INT8},
+                                                                   {"int16", cudf::type_id::INT16},
+                                                                   {"int32", cudf::type_id::INT32},
+                                                                   {"int64", cudf::type_id::INT64},
+                                                                   {"str", cudf::type_id::STRING},
+                                                                   {"uint8", cudf::type_id::UINT8},
+                                                                   {"uint16", cudf::type_id::UINT16},
+                                                                   {"uint32", cudf::type_id::UINT32},
+                                                                   {"uint64", cudf::type_id::UINT64}};
+
+    return schema_types;
+}
+
+static cudf::type_id KafkaSourceStage__schema_type(const std::string &type_name)
+{
+    auto found = KafkaSourceStage__schema_types().find(type_name);
+
+    if (found == KafkaSourceStage__schema_types().end())
+    {
+        throw std::invalid_argument("Unsupported schema type '" + type_name +
+                                    "'. Must be bool, str, or an int, uint or float type like int64");
+    }
+
+    return found->second;
+}
+
+static std::string KafkaSourceStage__schema_type_name(cudf::type_id type_id)
+{
+    for (const auto &[type_name, schema_type] : KafkaSourceStage__schema_types())
+    {
+        if (schema_type == type_id)
+        {
+            return type_name;
+        }
+    }
+
+    throw std::invalid_argument("Column type " + std::to_string(static_cast<int>(type_id)) + " has no schema name");
+}
+
+/**
+ * @brief Type a learned schema records for a column the reader inferred as `type_id`. Types without a schema name,
+ * like timestamps, are pinned as strings
+ */
+static cudf::type_id KafkaSourceStage__schema_column_type(cudf::type_id type_id)
+{
+    if (type_id != cudf::type_id::STRING && !cudf::is_numeric(cudf::data_type{type_id}))
+    {
+        return cudf::type_id::STRING;
+    }
+
+    return type_id;
+}
+
+/**
+ * @brief Widens the types a column was seen with across batches. Integers and booleans widen to int64, any float to
+ * float64, anything else to str
+ */
+static cudf::type_id KafkaSourceStage__merge_schema_types(cudf::type_id learned, cudf::type_id seen)
+{
+    seen = KafkaSourceStage__schema_column_type(seen);
+
+    if (learned == seen)
+    {
+        return learned;
+    }
+
+    if (learned == cudf::type_id::STRING || seen == cudf::type_id::STRING)
+    {
+        return cudf::type_id::STRING;
+    }
+
+    if (cudf::is_floating_point(cudf::data_type{learned}) || cudf::is_floating_point(cudf::data_type{seen}))
+    {
+        return cudf::type_id::FLOAT64;
+    }
+
+    return cudf::type_id::INT64;
+}
+
+/**
+ * @brief Puts the schema columns first, in schema order, adding null columns for the ones missing from the batch.
+ * Other payload fields follow in the order they were read
+ */
+static void KafkaSourceStage__apply_schema(cudf::io::table_with_metadata &table,
+                                           const std::vector<std::pair<std::string, cudf::type_id>> &schema)
+{
+    auto num_rows = table.tbl->num_rows();
+    auto columns  = table.tbl->release();
+    auto &names   = table.metadata.column_names;
+
+    std::vector<std::unique_ptr<cudf::column>> ordered_columns;
+    std::vector<std::string> ordered_names;
+
+    ordered_columns.reserve(std::max(columns.size(), schema.size()));
+    ordered_names.reserve(ordered_columns.capacity());
+
+    for (const auto &[column_name, type_id] : schema)
+    {
+        auto found = std::find(names.begin(), names.end(), column_name);
+
+        if (found != names.end() && columns[found - names.begin()])
+        {
+            ordered_columns.push_back(std::move(columns[found - names.begin()]));
+        }
+        else
+        {
+            auto null_scalar = cudf::make_default_constructed_scalar(cudf::data_type{type_id});
+            ordered_columns.push_back(cudf::make_column_from_scalar(*null_scalar, num_rows));
+        }
+
+        ordered_names.push_back(column_name);
+    }
+
+    for (std::size_t i = 0; i < columns.size(); ++i)
+    {
+        if (columns[i])
+        {
+            ordered_columns.push_back(std::move(columns[i]));
+            ordered_names.push_back(names[i]);
+        }
+    }
+
+    table.tbl                   = std::make_unique<cudf::table>(std::move(ordered_columns));
+    table.metadata.column_names = std::move(ordered_names);
+}
+
+/**
+ * @brief Appends `column` to `table` as `column_name`, replacing a payload field of the same name
+ */
+static void KafkaSourceStage__set_column(cudf::io::table_with_metadata &table,
+                                         const std::string &column_name,
+                                         std::unique_ptr<cudf::column> column)
+{
+    auto columns = table.tbl->release();
+    auto &names  = table.metadata.column_names;
+
+    auto found = std::find(names.begin(), names.end(), column_name);
+
+    if (found != names.end())
+    {
+        columns[found - names.begin()] = std::move(column);
+    }
+    else
+    {
+        columns.emplace_back(std::move(column));
+        names.push_back(column_name);
+    }
+
+    table.tbl = std::make_unique<cudf::table>(std::move(columns));
+}
+
+/**
+ * @brief The earliest broker timestamp of the batch in nanoseconds, falling back on the current time when the
+ * messages carry no timestamp
+ */
+static int64_t KafkaSourceStage__source_time_ns(const std::vector<std::unique_ptr<RdKafka::Message>> &message_batch)
+{
+    int64_t earliest_ms = -1;
+
+    for (const auto &msg : message_batch)
+    {
+        auto timestamp = msg->timestamp();
+
+        if (timestamp.type != RdKafka::MessageTimestamp::MSG_TIMESTAMP_NOT_AVAILABLE &&
+            (earliest_ms < 0 || timestamp.timestamp < earliest_ms))
+        {
+            earliest_ms = timestamp.timestamp;
+        }
+    }
+
+    return earliest_ms >= 0 ? earliest_ms * 1000000 : MessageTrace::now_ns();
+}
+
+/**
+ * @brief Drops every message from the first one stamped at or after `stop_timestamp_ms` on. Returns true if any
+ * message was dropped, meaning the partition reached the end of the replay.
+ */
+static bool KafkaSourceStage__truncate_at_timestamp(std::vector<std::unique_ptr<RdKafka::Message>> &messages,
+                                                    int64_t stop_timestamp_ms)
+{
+    auto found = std::find_if(messages.begin(), messages.end(), [stop_timestamp_ms](const auto &msg) {
+        return msg->timestamp().timestamp >= stop_timestamp_ms;
+    });
+
+    if (found == messages.end())
+    {
+        return false;
+    }
+
+    messages.erase(found, messages.end());
+
+    return true;
+}
+
 // Component-private classes.
 // ************ KafkaSourceStage__UnsubscribedException**************//
 class KafkaSourceStage__UnsubscribedException : public std::exception
 {};
 
+// ************ KafkaSourceStage__PinnedBuffer ***********************//
+/**
+ * @brief Growable page-locked host buffer. Used to gather message payloads so cuDF can copy them to the device in a
+ * single fast transfer. Only grows, so a buffer reused across batches stops allocating once warmed up.
+ */
+class KafkaSourceStage__PinnedBuffer
+{
+  public:
+    KafkaSourceStage__PinnedBuffer() = default;
+    KafkaSourceStage__PinnedBuffer(const KafkaSourceStage__PinnedBuffer &) = delete;
+    KafkaSourceStage__PinnedBuffer &operator=(const KafkaSourceStage__PinnedBuffer &) = delete;
+
+    ~KafkaSourceStage__PinnedBuffer()
+    {
+        if (m_data != nullptr)
+        {
+            // Can run at thread exit after the CUDA context is gone, so dont check the result
+            cudaFreeHost(m_data);
+        }
+    }
+
+    /**
+     * @brief Ensures the buffer can hold at least `bytes` and returns it. Previous contents are not preserved.
+     */
+    char *reserve(std::size_t bytes)
+    {
+        if (bytes > m_capacity)
+        {
+            if (m_data != nullptr)
+            {
+                NEO_CHECK_CUDA(cudaFreeHost(m_data));
+                m_data = nullptr;
+            }
+
+            m_capacity = std::max(bytes, m_capacity * 2);
+
+            NEO_CHECK_CUDA(cudaMallocHost(reinterpret_cast<void **>(&m_data), m_capacity));
+        }
+
+        return m_data;
+    }
+
+    char *data()
+    {
+        return m_data;
+    }
+
+  private:
+    char *m_data{nullptr};
+    std::size_t m_capacity{0};
+};
+
+// ************ KafkaSourceStage__MetadataColumns ********************//
+/**
+ * @brief Builds the message metadata columns named in `column_names`, one row per message of `messages` with a non zero
+ * entry in `message_is_kept`. Values and null masks of every column are packed into a pinned buffer reused by the
+ * thread and copied to the device at once, then split into the column buffers on the device.
+ */
+static std::vector<std::unique_ptr<cudf::column>> KafkaSourceStage__metadata_columns(
+    const std::vector<std::unique_ptr<RdKafka::Message>> &messages,
+    const std::vector<uint8_t> &message_is_kept,
+    const std::vector<std::string> &column_names)
+{
+    thread_local KafkaSourceStage__PinnedBuffer staging;
+
+    std::vector<const RdKafka::Message *> kept;
+    std::size_t key_bytes = 0;
+
+    for (std::size_t i = 0; i < messages.size(); ++i)
+    {
+        if (message_is_kept[i])
+        {
+            kept.push_back(messages[i].get());
+            key_bytes += messages[i]->key_len();
+        }
+    }
+
+    const auto num_rows   = static_cast<cudf::size_type>(kept.size());
+    const auto mask_bytes = cudf::bitmask_allocation_size_bytes(num_rows);
+
+    // Offset and size of each device buffer within the staging buffer, 8 byte aligned
+    std::vector<std::pair<std::size_t, std::size_t>> sections;
+    std::size_t total_bytes = 0;
+
+    auto add_section = [&](std::size_t bytes) {
+        sections.emplace_back(total_bytes, bytes);
+        total_bytes += (bytes + 7) & ~std::size_t{7};
+        return sections.size() - 1;
+    };
+
+    // Plans every section before the buffer is written, since reserving it does not preserve its contents
+    std::vector<std::vector<std::size_t>> column_sections;
+
+    for (const auto &column_name : column_names)
+    {
+        if (column_name == MetadataPartitionColumn)
+        {
+            column_sections.push_back({add_section(num_rows * sizeof(int32_t))});
+        }
+        else if (column_name == MetadataOffsetColumn)
+        {
+            column_sections.push_back({add_section(num_rows * sizeof(int64_t))});
+        }
+        else if (column_name == MetadataTimestampColumn)
+        {
+            column_sections.push_back({add_section(num_rows * sizeof(int64_t)), add_section(mask_bytes)});
+        }
+        else
+        {
+            column_sections.push_back({add_section((num_rows + 1) * sizeof(int32_t)),
+                                       add_section(key_bytes),
+                                       add_section(mask_bytes)});
+        }
+    }
+
+    char *host = staging.reserve(std::max<std::size_t>(total_bytes, 1));
+
+    auto host_section = [&](std::size_t section) { return host + sections[section].first; };
+
+    constexpr cudf::size_type mask_bits = sizeof(cudf::bitmask_type) * 8;
+
+    // Fills a null mask section, returning the null count
+    auto write_mask = [&](std::size_t section, auto is_valid) {
+        auto *words = reinterpret_cast<cudf::bitmask_type *>(host_section(section));
+        std::fill_n(host_section(section), mask_bytes, 0);
+
+        cudf::size_type null_count = 0;
+
+        for (cudf::size_type row = 0; row < num_rows; ++row)
+        {
+            if (is_valid(*kept[row]))
+            {
+                words[row / mask_bits] |= cudf::bitmask_type{1} << (row % mask_bits);
+            }
+            else
+            {
+                ++null_count;
+            }
+        }
+
+        return null_count;
+    };
+
+    std::vector<cudf::size_type> null_counts;
+
+    for (std::size_t i = 0; i < column_names.size(); ++i)
+    {
+        const auto &column_name = column_names[i];
+        const auto &section_ids = column_sections[i];
+
+        if (column_name == MetadataPartitionColumn)
+        {
+            auto *values = reinterpret_cast<int32_t *>(host_section(section_ids[0]));
+            std::transform(kept.begin(), kept.end(), values, [](auto *msg) { return msg->partition(); });
+            null_counts.push_back(0);
+        }
+        else if (column_name == MetadataOffsetColumn)
+        {
+            auto *values = reinterpret_cast<int64_t *>(host_section(section_ids[0]));
+            std::transform(kept.begin(), kept.end(), values, [](auto *msg) { return msg->offset(); });
+            null_counts.push_back(0);
+        }
+        else if (column_name == MetadataTimestampColumn)
+        {
+            auto *values = reinterpret_cast<int64_t *>(host_section(section_ids[0]));
+            std::transform(kept.begin(), kept.end(), values, [](auto *msg) { return msg->timestamp().timestamp; });
+            null_counts.push_back(write_mask(section_ids[1], [](const RdKafka::Message &msg) {
+                return msg.timestamp().type != RdKafka::MessageTimestamp::MSG_TIMESTAMP_NOT_AVAILABLE;
+            }));
+        }
+        else
+        {
+            auto *offsets = reinterpret_cast<int32_t *>(host_section(section_ids[0]));
+            auto *chars   = host_section(section_ids[1]);
+
+            offsets[0] = 0;
+
+            for (cudf::size_type row = 0; row < num_rows; ++row)
+            {
+                const auto *key = static_cast<const char *>(kept[row]->key_pointer());
+                auto key_len    = key == nullptr ? 0 : kept[row]->key_len();
+
+                std::copy_n(key, key_len, chars + offsets[row]);
+                offsets[row + 1] = offsets[row] + static_cast<int32_t>(key_len);
+            }
+
+            null_counts.push_back(write_mask(
+                section_ids[2], [](const RdKafka::Message &msg) { return msg.key_pointer() != nullptr; }));
+        }
+    }
+
+    auto stream = rmm::cuda_stream_per_thread;
+
+    rmm::device_buffer device_staging(host, total_bytes, stream);
+
+    auto device_section = [&](std::size_t section) {
+        const auto &[offset, bytes] = sections[section];
+
+        return rmm::device_buffer(static_cast<const char *>(device_staging.data()) + offset, bytes, stream);
+    };
+
+    std::vector<std::unique_ptr<cudf::column>> columns;
+
+    for (std::size_t i = 0; i < column_names.size(); ++i)
+    {
+        const auto &column_name = column_names[i];
+        const auto &section_ids = column_sections[i];
+
+        if (column_name == MetadataPartitionColumn || column_name == MetadataOffsetColumn)
+        {
+            auto type_id = column_name == MetadataPartitionColumn ? cudf::type_id::INT32 : cudf::type_id::INT64;
+
+            columns.push_back(
+                std::make_unique<cudf::column>(cudf::data_type{type_id}, num_rows, device_section(section_ids[0])));
+        }
+        else if (column_name == MetadataTimestampColumn)
+        {
+            columns.push_back(std::make_unique<cudf::column>(cudf::data_type{cudf::type_id::TIMESTAMP_MILLISECONDS},
+                                                             num_rows,
+                                                             device_section(section_ids[0]),
+                                                             device_section(section_ids[1]),
+                                                             null_counts[i]));
+        }
+        else
+        {
+            auto offsets = std::make_unique<cudf::column>(
+                cudf::data_type{cudf::type_id::INT32}, num_rows + 1, device_section(section_ids[0]));
+            auto chars = std::make_unique<cudf::column>(cudf::data_type{cudf::type_id::INT8},
+                                                        static_cast<cudf::size_type>(key_bytes),
+                                                        device_section(section_ids[1]));
+
+            columns.push_back(cudf::make_strings_column(num_rows,
+                                                        std::move(offsets),
+                                                        std::move(chars),
+                                                        null_counts[i],
+                                                        device_section(section_ids[2]),
+                                                        stream));
+        }
+    }
+
+    // The staging buffer is reused by the next batch of this thread
+    NEO_CHECK_CUDA(cudaStreamSynchronize(stream));
+
+    return columns;
+}
+
+// ************ KafkaSourceStage__Completion *************************//
+class KafkaSourceStage__Completion : public MessageCompletion
+{
+  public:
+    KafkaSourceStage__Completion(std::shared_ptr<KafkaOffsetTracker> tracker,
+                                 int64_t first,
+                                 int64_t next) :
+      m_tracker(std::move(tracker)),
+      m_first(first)
+    {
+        m_tracker->emitted(first, next);
+    }
+
+    ~KafkaSourceStage__Completion() override
+    {
+        m_tracker->completed(m_first, this->failed());
+    }
+
+  private:
+    std::shared_ptr<KafkaOffsetTracker> m_tracker;
+    int64_t m_first;
+};
+
+// ************ KafkaSourceStage__InFlightCompletion *****************//
+/**
+ * @brief Counts a batch as in flight downstream until every message holding it was released
+ */
+class KafkaSourceStage__InFlightCompletion : public MessageCompletion
+{
+  public:
+    explicit KafkaSourceStage__InFlightCompletion(std::shared_ptr<std::atomic<std::size_t>> in_flight) :
+      m_in_flight(std::move(in_flight))
+    {
+        ++(*m_in_flight);
+    }
+
+    ~KafkaSourceStage__InFlightCompletion() override
+    {
+        --(*m_in_flight);
+    }
+
+  private:
+    // Shared since messages can be released after the stage is gone
+    std::shared_ptr<std::atomic<std::size_t>> m_in_flight;
+};
+
+// ************ KafkaSourceStage__QueueEvent *************************//
+/**
+ * Signalled once librdkafka puts a message on the partition queue after it was drained. Registers with the watcher on
+ * construction and disables the queue event on destruction, so it must be destroyed before the queue.
+ */
+class KafkaSourceStage__QueueEvent
+{
+  public:
+    KafkaSourceStage__QueueEvent(KafkaEventWatcher &watcher, RdKafka::Queue *queue) :
+      m_watcher(watcher),
+      m_queue(queue)
+    {
+        m_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+        if (m_fd < 0)
+        {
+            throw std::runtime_error(std::string("Failed to create a Kafka queue eventfd: ") + std::strerror(errno));
+        }
+
+        m_watcher.add(m_fd, [this]() { this->notify(); });
+        m_queue->io_event_enable(m_fd, &QueueEventIncrement, sizeof(QueueEventIncrement));
+    }
+
+    ~KafkaSourceStage__QueueEvent()
+    {
+        m_queue->io_event_enable(-1, nullptr, 0);
+        m_watcher.remove(m_fd);
+
+        ::close(m_fd);
+    }
+
+    KafkaSourceStage__QueueEvent(const KafkaSourceStage__QueueEvent &)            = delete;
+    KafkaSourceStage__QueueEvent &operator=(const KafkaSourceStage__QueueEvent &) = delete;
+
+    void notify()
+    {
+        {
+            std::unique_lock<boost::fibers::mutex> lock(m_mutex);
+            m_signalled = true;
+        }
+
+        m_cv.notify_all();
+    }
+
+    // Sleeps the calling fiber until notified or until `deadline`, then clears the notification
+    template <typename ClockT, typename DurationT>
+    void wait_until(const std::chrono::time_point<ClockT, DurationT> &deadline)
+    {
+        std::unique_lock<boost::fibers::mutex> lock(m_mutex);
+
+        m_cv.wait_until(lock, deadline, [this]() { return m_signalled; });
+        m_signalled = false;
+    }
+
+  private:
+    KafkaEventWatcher &m_watcher;
+    RdKafka::Queue *m_queue;
+    int m_fd{-1};
+
+    boost::fibers::mutex m_mutex;
+    boost::fibers::condition_variable m_cv;
+    bool m_signalled{false};
+};
+
+// ************ KafkaSourceStage__PendingBatch ***********************//
+/**
+ * A batch consumed from one partition. It is parsed by a task on any of the stage's task queues while the partition
+ * consumes the next batch, and is emitted by the partition task in the order it was consumed.
+ */
+struct KafkaSourceStage__PendingBatch
+{
+    std::vector<std::unique_ptr<RdKafka::Message>> messages;
+    std::shared_ptr<KafkaSourceStage__Completion> completion;
+
+    // Written by the parse task, only read once `parsed` is ready
+    std::shared_ptr<MessageMeta> meta;
+    bool failed{false};
+    neo::SharedFuture<bool> parsed;
+};
+
+// ************ KafkaSourceStage__PartitionTask **********************//
+/**
+ * Fiber consuming one assigned partition. Kept per partition so an incremental revoke only stops the fibers of the
+ * partitions it revokes.
+ */
+struct KafkaSourceStage__PartitionTask
+{
+    std::atomic<bool> running{true};        // Cleared to stop the fiber once its partition is revoked
+    std::atomic<bool> reached_stop{false};  // Set once the partition reached the stop timestamp of a replay
+    neo::SharedFuture<bool> future;
+
+    // Set by the fiber when committing on completion. Read once the fiber finished, to commit the batches which
+    // complete after the source stopped when draining
+    std::shared_ptr<KafkaOffsetTracker> tracker;
+    std::string topic;
+    int32_t partition{-1};
+};
+
 // ************ KafkaSourceStage__Rebalancer *************************//
 class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb
 {
   public:
     KafkaSourceStage__Rebalancer(
-        std::function<neo::SharedFuture<bool>(std::vector<std::function<bool()>> &&)> task_launch_fn,
+        std::function<neo::SharedFuture<bool>(std::size_t, std::function<bool()> &&)> task_launch_fn,
         std::function<int32_t()> batch_timeout_fn,
         std::function<std::size_t()> max_batch_size_fn,
+        std::function<std::size_t()> max_batch_bytes_fn,
         std::function<std::string(std::string)> display_str_fn,
-        std::function<bool(std::vector<std::unique_ptr<RdKafka::Message>> &)> process_fn);
+        std::function<bool()> commit_on_completion_fn,
+        std::function<void(RdKafka::KafkaConsumer *, std::vector<RdKafka::TopicPartition *> &)> seek_fn,
+        std::function<int64_t()> stop_timestamp_fn,
+        std::function<bool(bool)> overloaded_fn,
+        std::function<std::shared_ptr<KafkaSourceStage__PendingBatch>(
+            std::size_t,
+            std::vector<std::unique_ptr<RdKafka::Message>> &&,
+            const std::shared_ptr<KafkaOffsetTracker> &)> parse_fn,
+        std::function<bool(const std::shared_ptr<KafkaSourceStage__PendingBatch> &)> emit_fn);
 
     void rebalance_cb(RdKafka::KafkaConsumer *consumer,
                       RdKafka::ErrorCode err,
@@ -78,15 +740,48 @@ class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb
 
     void rebalance_loop(RdKafka::KafkaConsumer *consumer);
 
-    bool is_rebalanced();
+    /**
+     * Once the loop stopped for a drain, and the source completed, commits the batches of the drained partitions as
+     * downstream releases them. Returns once every batch completed or the drain deadline passed
+     */
+    void commit_drained(RdKafka::KafkaConsumer *consumer, DrainProgress &progress);
 
   private:
-    std::vector<std::unique_ptr<RdKafka::Message>> partition_progress_step(RdKafka::Queue *queue)
+    /**
+     * Builds the task running the fiber of a newly assigned partition
+     */
+    std::function<bool()> make_partition_task(RdKafka::KafkaConsumer *consumer,
+                                              RdKafka::TopicPartition *partition,
+                                              std::size_t home_queue,
+                                              std::shared_ptr<KafkaSourceStage__PartitionTask> state);
+
+    /**
+     * Stops the fibers of `partitions`, or of every partition when null, and waits for them to finish. Returns the
+     * stopped partitions
+     */
+    std::vector<std::shared_ptr<KafkaSourceStage__PartitionTask>> stop_partitions(
+        const std::vector<RdKafka::TopicPartition *> *partitions);
+
+    /**
+     * True once the subscriber went away, once a drain was requested, or once every partition of a replay reached the
+     * stop timestamp
+     */
+    bool should_stop();
+
+    std::vector<std::unique_ptr<RdKafka::Message>> partition_progress_step(RdKafka::Queue *queue,
+                                                                           KafkaSourceStage__QueueEvent &queue_event,
+                                                                           const std::atomic<bool> &running,
+                                                                           bool &at_eof)
     {
         // auto batch_timeout = std::chrono::milliseconds(m_parent.batch_timeout_ms());
         auto batch_timeout = std::chrono::milliseconds(m_batch_timeout_fn());
 
-        size_t msg_count = 0;
+        // A max_batch_bytes of 0 disables the byte limit
+        auto max_batch_size  = m_max_batch_size_fn();
+        auto max_batch_bytes = m_max_batch_bytes_fn();
+
+        size_t msg_count   = 0;
+        size_t batch_bytes = 0;
         std::vector<std::unique_ptr<RdKafka::Message>> messages;
 
         auto now       = std::chrono::high_resolution_clock::now();
@@ -94,17 +789,14 @@ class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb
 
         do
         {
-            auto remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(batch_end - now).count();
-
-            DCHECK(remaining_ms >= 0) << "Cant have negative reminaing time";
-
-            std::unique_ptr<RdKafka::Message> msg{queue->consume(std::min(10L, remaining_ms))};
+            // Never blocks, drains whatever librdkafka already fetched for this partition
+            std::unique_ptr<RdKafka::Message> msg{queue->consume(0)};
 
             switch (msg->err())
             {
             case RdKafka::ERR__TIMED_OUT:
-                // Yield on a timeout
-                boost::this_fiber::yield();
+                // Queue is empty, sleep until librdkafka fills it or the batch times out
+                queue_event.wait_until(batch_end);
                 break;
             case RdKafka::ERR_NO_ERROR:
 
@@ -113,12 +805,16 @@ class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb
                 //     msg->partition()
                 //                                       << ", Offset: " << msg->offset()));
 
+                ++msg_count;
+                batch_bytes += msg->len();
                 messages.emplace_back(std::move(msg));
+                at_eof = false;
                 break;
             case RdKafka::ERR__PARTITION_EOF:
                 VLOG_EVERY_N(10, 10) << "Hit EOF for partition";
-                // Hit the end, sleep for 100 ms
-                boost::this_fiber::sleep_for(std::chrono::milliseconds(100));
+                at_eof = true;
+                // Hit the end, new messages signal the queue event like any other
+                queue_event.wait_until(batch_end);
                 break;
             default:
                 /* Errors */
@@ -127,34 +823,67 @@ class KafkaSourceStage__Rebalancer : public RdKafka::RebalanceCb
 
             // Update now
             now = std::chrono::high_resolution_clock::now();
-        } while (msg_count < m_max_batch_size_fn() && now < batch_end && m_is_rebalanced);
+        } while (msg_count < max_batch_size && (max_batch_bytes == 0 || batch_bytes < max_batch_bytes) &&
+                 now < batch_end && running);
 
         return std::move(messages);
     }
 
-    bool m_is_rebalanced{false};
-
-    std::function<neo::SharedFuture<bool>(std::vector<std::function<bool()>> &&)> m_task_launcher_fn;
+    std::function<neo::SharedFuture<bool>(std::size_t, std::function<bool()> &&)> m_task_launcher_fn;
     std::function<int32_t()> m_batch_timeout_fn;
     std::function<std::size_t()> m_max_batch_size_fn;
+    std::function<std::size_t()> m_max_batch_bytes_fn;
     std::function<std::string(std::string)> m_display_str_fn;
-    std::function<bool(std::vector<std::unique_ptr<RdKafka::Message>> &)> m_process_fn;
+    std::function<bool()> m_commit_on_completion_fn;
+    std::function<void(RdKafka::KafkaConsumer *, std::vector<RdKafka::TopicPartition *> &)> m_seek_fn;
+    std::function<int64_t()> m_stop_timestamp_fn;
+    std::function<bool(bool)> m_overloaded_fn;
+    std::function<std::shared_ptr<KafkaSourceStage__PendingBatch>(
+        std::size_t,
+        std::vector<std::unique_ptr<RdKafka::Message>> &&,
+        const std::shared_ptr<KafkaOffsetTracker> &)>
+        m_parse_fn;
+    std::function<bool(const std::shared_ptr<KafkaSourceStage__PendingBatch> &)> m_emit_fn;
 
     boost::fibers::recursive_mutex m_mutex;
-    neo::SharedFuture<bool> m_partition_future;
+
+    // Fibers of the assigned partitions. Guarded by m_mutex
+    KafkaPartitionFibers<KafkaSourceStage__PartitionTask> m_partitions;
+    std::size_t m_next_home_queue{0};
+    std::atomic<bool> m_unsubscribed{false};
+
+    // Partitions stopped by a drain, whose batches still in flight are committed by `commit_drained`
+    std::vector<std::shared_ptr<KafkaSourceStage__PartitionTask>> m_drained;
+
+    KafkaEventWatcher m_event_watcher;
 };
 
 KafkaSourceStage__Rebalancer::KafkaSourceStage__Rebalancer(
-    std::function<neo::SharedFuture<bool>(std::vector<std::function<bool()>> &&)> task_launch_fn,
+    std::function<neo::SharedFuture<bool>(std::size_t, std::function<bool()> &&)> task_launch_fn,
     std::function<int32_t()> batch_timeout_fn,
     std::function<std::size_t()> max_batch_size_fn,
+    std::function<std::size_t()> max_batch_bytes_fn,
     std::function<std::string(std::string)> display_str_fn,
-    std::function<bool(std::vector<std::unique_ptr<RdKafka::Message>> &)> process_fn) :
+    std::function<bool()> commit_on_completion_fn,
+    std::function<void(RdKafka::KafkaConsumer *, std::vector<RdKafka::TopicPartition *> &)> seek_fn,
+    std::function<int64_t()> stop_timestamp_fn,
+    std::function<bool(bool)> overloaded_fn,
+    std::function<std::shared_ptr<KafkaSourceStage__PendingBatch>(
+        std::size_t,
+        std::vector<std::unique_ptr<RdKafka::Message>> &&,
+        const std::shared_ptr<KafkaOffsetTracker> &)> parse_fn,
+    std::function<bool(const std::shared_ptr<KafkaSourceStage__PendingBatch> &)> emit_fn) :
   m_task_launcher_fn(std::move(task_launch_fn)),
   m_batch_timeout_fn(std::move(batch_timeout_fn)),
   m_max_batch_size_fn(std::move(max_batch_size_fn)),
+  m_max_batch_bytes_fn(std::move(max_batch_bytes_fn)),
   m_display_str_fn(std::move(display_str_fn)),
-  m_process_fn(std::move(process_fn))
+  m_commit_on_completion_fn(std::move(commit_on_completion_fn)),
+  m_seek_fn(std::move(seek_fn)),
+  m_stop_timestamp_fn(std::move(stop_timestamp_fn)),
+  m_overloaded_fn(std::move(overloaded_fn)),
+  m_parse_fn(std::move(parse_fn)),
+  m_emit_fn(std::move(emit_fn))
 {}
 
 void KafkaSourceStage__Rebalancer::rebalance_cb(RdKafka::KafkaConsumer *consumer,
@@ -168,6 +897,8 @@ void KafkaSourceStage__Rebalancer::rebalance_cb(RdKafka::KafkaConsumer *consumer
         VLOG(10) << m_display_str_fn("Rebalance: Assign Partitions");
 
         // application may load offets from arbitrary external storage here and update \p partitions
+        m_seek_fn(consumer, partitions);
+
         if (consumer->rebalance_protocol() == "COOPERATIVE")
         {
             CHECK_KAFKA(std::unique_ptr<RdKafka::Error>(consumer->incremental_assign(partitions))->code(),
@@ -179,75 +910,31 @@ void KafkaSourceStage__Rebalancer::rebalance_cb(RdKafka::KafkaConsumer *consumer
             CHECK_KAFKA(consumer->assign(partitions), RdKafka::ERR_NO_ERROR, "Error during assign");
         }
 
-        std::vector<std::function<bool()>> tasks;
-
         for (auto partition : partitions)
         {
-            auto queue_ptr = consumer->get_partition_queue(partition);
-
-            // Now forward to one of the running queues
-            // queue->forward(m_parent.m_queues[i % m_parent.m_queues.size()].get());
-            queue_ptr->forward(nullptr);
-
-            auto topic  = partition->topic();
-            auto part   = partition->partition();
-            auto offset = partition->offset();
-
-            auto partition_ptr = RdKafka::TopicPartition::create(topic, part, offset);
-
-            tasks.emplace_back([q = queue_ptr, p = partition_ptr, consumer, this]() {
-                auto partition = std::unique_ptr<RdKafka::TopicPartition>(p);
-                auto queue     = std::unique_ptr<RdKafka::Queue>(q);
+            if (PipelineDrain::requested())
+            {
+                // Assigned while committing the last batches of a drain, nothing more is consumed
+                continue;
+            }
 
-                while (m_is_rebalanced)
-                {
-                    // Build the batch
-                    auto messages = this->partition_progress_step(queue.get());
+            auto home_queue = m_next_home_queue++;
 
-                    try
-                    {
-                        // Process the messages. Returns true if we need to commit
-                        auto should_commit = m_process_fn(messages);
-
-                        if (should_commit)
-                        {
-                            int64_t max_offset = -1000;
-                            for (auto &m : messages)
-                            {
-                                DCHECK(m->partition() == partition->partition())
-                                    << "Inconsistent error. Message partition does not match fiber partition";
-
-                                max_offset = std::max(max_offset, m->offset());
-                            }
-
-                            // Find the last message for this partition
-                            partition->set_offset(max_offset + 1);
-
-                            CHECK_KAFKA(consumer->commitAsync(std::vector<RdKafka::TopicPartition *>{partition.get()}),
-                                        RdKafka::ERR_NO_ERROR,
-                                        "Error during commitAsync");
-                        }
-                    } catch (KafkaSourceStage__UnsubscribedException &)
-                    {
-                        // Return false for unsubscribed error
-                        return false;
-                    }
-                }
-
-                // Return true if we exited normally
-                return true;
-            });
+            // A partition assigned twice keeps a single fiber
+            m_partitions.start(KafkaSourceStage__partition_key(*partition),
+                               [&](const std::shared_ptr<KafkaSourceStage__PartitionTask> &state) {
+                                   state->future = m_task_launcher_fn(
+                                       home_queue, this->make_partition_task(consumer, partition, home_queue, state));
+                               });
         }
-
-        // Set this before launching the tasks
-        m_is_rebalanced = true;
-
-        m_partition_future = std::move(m_task_launcher_fn(std::move(tasks)));
     }
     else if (err == RdKafka::ERR__REVOKE_PARTITIONS)
     {
         VLOG(10) << m_display_str_fn("Rebalance: Revoke Partitions");
 
+        // Stop only the revoked partitions, before unassigning so they can still commit what they emitted
+        this->stop_partitions(&partitions);
+
         // Application may commit offsets manually here if auto.commit.enable=false
         if (consumer->rebalance_protocol() == "COOPERATIVE")
         {
@@ -259,41 +946,313 @@ void KafkaSourceStage__Rebalancer::rebalance_cb(RdKafka::KafkaConsumer *consumer
         {
             CHECK_KAFKA(consumer->unassign(), RdKafka::ERR_NO_ERROR, "Error during unassign");
         }
+    }
+    else
+    {
+        LOG(ERROR) << "Rebalancing error: " << RdKafka::err2str(err) << std::endl;
+        this->stop_partitions(nullptr);
+        CHECK_KAFKA(consumer->unassign(), RdKafka::ERR_NO_ERROR, "Error during unassign");
+    }
+}
+
+std::function<bool()> KafkaSourceStage__Rebalancer::make_partition_task(
+    RdKafka::KafkaConsumer *consumer,
+    RdKafka::TopicPartition *assigned,
+    std::size_t home_queue,
+    std::shared_ptr<KafkaSourceStage__PartitionTask> state)
+{
+    auto queue_ptr = consumer->get_partition_queue(assigned);
+
+    // Now forward to one of the running queues
+    // queue->forward(m_parent.m_queues[i % m_parent.m_queues.size()].get());
+    queue_ptr->forward(nullptr);
+
+    auto topic  = assigned->topic();
+    auto part   = assigned->partition();
+    auto offset = assigned->offset();
+
+    auto partition_ptr = RdKafka::TopicPartition::create(topic, part, offset);
+
+    return [q = queue_ptr, p = partition_ptr, home_queue, state = std::move(state), consumer, this]() {
+        auto partition = std::unique_ptr<RdKafka::TopicPartition>(p);
+        auto queue     = std::unique_ptr<RdKafka::Queue>(q);
+
+        // Declared after the queue so it is disabled before the queue is destroyed
+        KafkaSourceStage__QueueEvent queue_event(m_event_watcher, queue.get());
+
+        // Only set when committing on completion, otherwise batches are committed once emitted
+        std::shared_ptr<KafkaOffsetTracker> tracker;
+
+        if (m_commit_on_completion_fn())
+        {
+            tracker = std::make_shared<KafkaOffsetTracker>(KafkaSourceStage__partition_key(*partition));
+
+            state->tracker   = tracker;
+            state->topic     = partition->topic();
+            state->partition = partition->partition();
+        }
+
+        auto commit_completed = [&]() {
+            auto commit_offset = tracker->take_commit_offset();
+
+            if (commit_offset >= 0)
+            {
+                partition->set_offset(commit_offset);
+
+                CHECK_KAFKA(consumer->commitAsync(std::vector<RdKafka::TopicPartition *>{partition.get()}),
+                            RdKafka::ERR_NO_ERROR,
+                            "Error during commitAsync");
+            }
+        };
+
+        // Negative unless replaying up to a timestamp
+        auto stop_timestamp_ms = m_stop_timestamp_fn();
+        bool reached_stop      = false;
+
+        auto emit = [&](std::shared_ptr<KafkaSourceStage__PendingBatch> &&batch) {
+            // Emit the messages. Returns true if we need to commit
+            auto should_commit = m_emit_fn(batch);
+
+            if (!tracker && should_commit)
+            {
+                int64_t max_offset = -1000;
+                for (auto &m : batch->messages)
+                {
+                    DCHECK(m->partition() == partition->partition())
+                        << "Inconsistent error. Message partition does not match fiber partition";
+
+                    max_offset = std::max(max_offset, m->offset());
+                }
+
+                // Find the last message for this partition
+                partition->set_offset(max_offset + 1);
+
+                CHECK_KAFKA(consumer->commitAsync(std::vector<RdKafka::TopicPartition *>{partition.get()}),
+                            RdKafka::ERR_NO_ERROR,
+                            "Error during commitAsync");
+            }
+        };
+
+        // Batches still being parsed, oldest first. Emitting them in this order keeps the partition ordered
+        KafkaBatchWindow<std::shared_ptr<KafkaSourceStage__PendingBatch>> pending(PartitionBatchesInFlight, emit);
+
+        // Pauses fetching for the partition until downstream caught up, so librdkafka does not keep buffering
+        // messages the pipeline cannot take. The consumer is still polled by the rebalance loop meanwhile
+        auto wait_while_overloaded = [&]() {
+            std::vector<RdKafka::TopicPartition *> paused{partition.get()};
+
+            CHECK_KAFKA(consumer->pause(paused), RdKafka::ERR_NO_ERROR, "Error during pause");
+
+            VLOG(10) << m_display_str_fn(
+                CONCAT_STR("Backpressure paused " << partition->topic() << "[" << partition->partition() << "]"));
+
+            while (state->running && m_overloaded_fn(true))
+            {
+                // Still stop once the subscriber goes away
+                m_emit_fn(nullptr);
+
+                boost::this_fiber::sleep_for(BackpressurePollInterval);
+            }
+
+            CHECK_KAFKA(consumer->resume(paused), RdKafka::ERR_NO_ERROR, "Error during resume");
+        };
+
+        try
+        {
+            while (state->running && !reached_stop)
+            {
+                if (m_overloaded_fn(false))
+                {
+                    wait_while_overloaded();
+                }
+
+                // Build the batch and hand it off to be parsed while the next one is built
+                bool at_eof   = false;
+                auto messages = this->partition_progress_step(queue.get(), queue_event, state->running, at_eof);
+
+                if (stop_timestamp_ms >= 0)
+                {
+                    // Once caught up with a stop timestamp in the past, no later message can come before it
+                    auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                      std::chrono::system_clock::now().time_since_epoch())
+                                      .count();
+
+                    reached_stop = KafkaSourceStage__truncate_at_timestamp(messages, stop_timestamp_ms) ||
+                                   (at_eof && now_ms >= stop_timestamp_ms);
+                }
+
+                bool idle = messages.empty();
+
+                if (!idle)
+                {
+                    // Waits on the oldest batch once too many are in flight
+                    pending.push(m_parse_fn(home_queue, std::move(messages), tracker));
+                }
+                else
+                {
+                    // Flush once the partition is quiet
+                    pending.flush();
+
+                    // Nothing to emit, still stop once the subscriber goes away
+                    m_emit_fn(nullptr);
+                }
+
+                if (tracker)
+                {
+                    // Batches emitted earlier may have completed while this one was built
+                    commit_completed();
+                }
+            }
+
+            // Emit everything consumed before the partition was revoked or reached the stop timestamp
+            pending.flush();
+        } catch (KafkaSourceStage__UnsubscribedException &)
+        {
+            // Return false for unsubscribed error
+            m_unsubscribed = true;
+            return false;
+        }
 
-        // Stop all processing queues
-        m_is_rebalanced = false;
+        if (tracker)
+        {
+            // Commit what completed before the partition was revoked, the rest is read again by its next owner
+            commit_completed();
+        }
 
-        // Wait until all processing has completed
-        if (m_partition_future.valid())
+        if (reached_stop)
         {
-            m_partition_future.wait();
+            VLOG(10) << m_display_str_fn(CONCAT_STR("Replay reached the stop timestamp on "
+                                                    << partition->topic() << "[" << partition->partition()
+                                                    << "]"));
+
+            // Stop fetching for this partition. The source completes once every partition is done
+            CHECK_KAFKA(consumer->pause(std::vector<RdKafka::TopicPartition *>{partition.get()}),
+                        RdKafka::ERR_NO_ERROR,
+                        "Error during pause");
+
+            state->reached_stop = true;
+            return false;
         }
+
+        // Return true if we exited normally
+        return true;
+    };
+}
+
+std::vector<std::shared_ptr<KafkaSourceStage__PartitionTask>> KafkaSourceStage__Rebalancer::stop_partitions(
+    const std::vector<RdKafka::TopicPartition *> *partitions)
+{
+    std::unique_lock<boost::fibers::recursive_mutex> lock(m_mutex);
+
+    if (partitions == nullptr)
+    {
+        return m_partitions.stop_all();
     }
-    else
+
+    std::vector<std::string> keys;
+
+    for (auto partition : *partitions)
     {
-        LOG(ERROR) << "Rebalancing error: " << RdKafka::err2str(err) << std::endl;
-        CHECK_KAFKA(consumer->unassign(), RdKafka::ERR_NO_ERROR, "Error during unassign");
+        keys.emplace_back(KafkaSourceStage__partition_key(*partition));
+    }
+
+    return m_partitions.stop(keys);
+}
+
+bool KafkaSourceStage__Rebalancer::should_stop()
+{
+    std::unique_lock<boost::fibers::recursive_mutex> lock(m_mutex);
+
+    if (m_unsubscribed || PipelineDrain::requested())
+    {
+        return true;
     }
+
+    // A replay ends once every assigned partition reached its stop timestamp
+    return m_partitions.all_reached_stop();
 }
 
-void KafkaSourceStage__Rebalancer::rebalance_loop(RdKafka::KafkaConsumer *consumer)
-{
-    do
-    {
-        // Poll until we are rebalanced
-        while (!this->is_rebalanced())
+void KafkaSourceStage__Rebalancer::rebalance_loop(RdKafka::KafkaConsumer *consumer)
+{
+    while (!this->should_stop())
+    {
+        // Serves rebalance callbacks, messages are consumed from the partition queues by the partition fibers
+        consumer->poll(0);
+
+        try
+        {
+            // Only checks the subscription, also stops a source which has no partitions assigned
+            m_emit_fn(nullptr);
+        } catch (KafkaSourceStage__UnsubscribedException &)
+        {
+            m_unsubscribed = true;
+        }
+
+        boost::this_fiber::sleep_for(RebalancePollInterval);
+    }
+
+    // Every partition emits what it already consumed before stopping
+    auto stopped = this->stop_partitions(nullptr);
+
+    if (PipelineDrain::requested() && !m_unsubscribed)
+    {
+        m_drained = std::move(stopped);
+    }
+}
+
+void KafkaSourceStage__Rebalancer::commit_drained(RdKafka::KafkaConsumer *consumer, DrainProgress &progress)
+{
+    std::size_t in_flight = 0;
+
+    while (true)
+    {
+        in_flight = 0;
+
+        for (auto &state : m_drained)
+        {
+            if (!state->tracker)
+            {
+                // Already committed when emitted
+                continue;
+            }
+
+            auto commit_offset = state->tracker->take_commit_offset();
+
+            if (commit_offset >= 0)
+            {
+                auto partition = std::unique_ptr<RdKafka::TopicPartition>(
+                    RdKafka::TopicPartition::create(state->topic, state->partition, commit_offset));
+
+                // The partition may have been revoked meanwhile, its new owner then reads these batches again
+                auto err = consumer->commitSync(std::vector<RdKafka::TopicPartition *>{partition.get()});
+
+                if (err != RdKafka::ERR_NO_ERROR)
+                {
+                    LOG(WARNING) << m_display_str_fn(CONCAT_STR("Drain failed to commit " << state->topic << "["
+                                                                << state->partition << "]: " << RdKafka::err2str(err)));
+                }
+            }
+
+            in_flight += state->tracker->in_flight();
+        }
+
+        progress.set_in_flight(in_flight);
+
+        if (in_flight == 0 || PipelineDrain::expired())
         {
-            VLOG(10) << m_display_str_fn("Rebalance: Calling poll to trigger rebalance");
-            consumer->poll(500);
+            break;
         }
-    } while (m_partition_future.get());
-}
 
-bool KafkaSourceStage__Rebalancer::is_rebalanced()
-{
-    std::unique_lock<boost::fibers::recursive_mutex> lock(m_mutex);
+        // Keeps the group membership alive while downstream finishes
+        consumer->poll(0);
+
+        boost::this_fiber::sleep_for(BackpressurePollInterval);
+    }
+
+    LOG_IF(WARNING, in_flight > 0) << m_display_str_fn(
+        CONCAT_STR("Drain deadline passed with " << in_flight << " batches in flight, they will be read again"));
 
-    return m_is_rebalanced;
+    m_drained.clear();
 }
 
 // Component public implementations
@@ -301,52 +1260,190 @@ bool KafkaSourceStage__Rebalancer::is_rebalanced()
 KafkaSourceStage::KafkaSourceStage(const neo::Segment &parent,
                                    const std::string &name,
                                    std::size_t max_batch_size,
-                                   std::string topic,
+                                   std::vector<std::string> topics,
                                    int32_t batch_timeout_ms,
                                    std::map<std::string, std::string> config,
                                    bool disable_commit,
-                                   bool disable_pre_filtering) :
+                                   bool disable_pre_filtering,
+                                   std::size_t max_batch_bytes,
+                                   bool adaptive_batching,
+                                   bool commit_on_completion,
+                                   std::string topic_column,
+                                   int64_t start_timestamp_ms,
+                                   std::map<std::string, int64_t> start_offsets,
+                                   int64_t stop_timestamp_ms,
+                                   int32_t device_id,
+                                   std::string drop_null_column,
+                                   std::map<std::string, std::string> output_columns,
+                                   std::map<std::string, std::string> schema,
+                                   std::size_t schema_batches,
+                                   const std::string &message_format,
+                                   const std::string &avro_schema,
+                                   const std::string &schema_registry_url,
+                                   std::vector<std::string> metadata_columns,
+                                   std::size_t max_in_flight_batches) :
   neo::SegmentObject(parent, name),
   base_t(parent, name),
   m_max_batch_size(max_batch_size),
-  m_topic(std::move(topic)),
+  m_topics(std::move(topics)),
   m_batch_timeout_ms(batch_timeout_ms),
   m_config(std::move(config)),
   m_disable_commit(disable_commit),
-  m_disable_pre_filtering(disable_pre_filtering)
+  m_disable_pre_filtering(disable_pre_filtering),
+  m_max_batch_bytes(max_batch_bytes),
+  m_adaptive_batching(adaptive_batching),
+  m_commit_on_completion(commit_on_completion),
+  m_topic_column(std::move(topic_column)),
+  m_start_timestamp_ms(start_timestamp_ms),
+  m_start_offsets(std::move(start_offsets)),
+  m_stop_timestamp_ms(stop_timestamp_ms),
+  m_device_id(device_id),
+  m_drop_null_column(std::move(drop_null_column)),
+  m_schema_batches(schema_batches),
+  m_metadata_columns(std::move(metadata_columns)),
+  m_max_in_flight_batches(max_in_flight_batches),
+  m_in_flight_batches(std::make_shared<std::atomic<std::size_t>>(0)),
+  m_drain_progress(PipelineDrain::track(name)),
+  m_decoder(KafkaMessageDecoder::create(message_format, avro_schema, schema_registry_url)),
+  m_batch_size_target(adaptive_batching ? std::max<std::size_t>(1, max_batch_size / AdaptiveBatchMinFraction)
+                                        : max_batch_size)
 {
+    if (m_start_timestamp_ms >= 0 && m_stop_timestamp_ms >= 0 && m_stop_timestamp_ms <= m_start_timestamp_ms)
+    {
+        throw std::invalid_argument("The stop timestamp of a Kafka replay must be after its start timestamp");
+    }
+
+    for (const auto &column_name : m_metadata_columns)
+    {
+        if (column_name != MetadataKeyColumn && column_name != MetadataTimestampColumn &&
+            column_name != MetadataPartitionColumn && column_name != MetadataOffsetColumn)
+        {
+            throw std::invalid_argument("Unknown Kafka metadata column '" + column_name +
+                                        "'. Must be one of '_key', '_ts', '_partition' or '_offset'");
+        }
+    }
+
+    for (const auto &[column_name, column_type] : output_columns)
+    {
+        m_output_column_names.push_back(column_name);
+        m_output_column_types.push_back(DataType::from_numpy(column_type).type_id());
+    }
+
+    if (!schema.empty())
+    {
+        std::vector<std::pair<std::string, cudf::type_id>> pinned;
+
+        for (const auto &[column_name, type_name] : schema)
+        {
+            pinned.emplace_back(column_name, KafkaSourceStage__schema_type(type_name));
+        }
+
+        m_frozen_schema = std::make_shared<const std::vector<std::pair<std::string, cudf::type_id>>>(std::move(pinned));
+    }
+
     this->set_source_observable(neo::Observable<source_type_t>([this](neo::Subscriber<source_type_t> &sub) {
+        DeviceAffinity::bind_current_thread(m_device_id);
+
         // Build rebalancer
         KafkaSourceStage__Rebalancer rebalancer(
-            [this](std::vector<std::function<bool()>> &&tasks) { return this->launch_tasks(std::move(tasks)); },
+            [this](std::size_t home_queue, std::function<bool()> &&task) {
+                return this->launch_task(home_queue, std::move(task));
+            },
             [this]() { return this->batch_timeout_ms(); },
-            [this]() { return this->max_batch_size(); },
+            [this]() { return this->batch_size_target(); },
+            [this]() { return this->m_max_batch_bytes; },
             [this](const std::string str_to_display) { return this->display_str(str_to_display); },
-            [&sub, this](std::vector<std::unique_ptr<RdKafka::Message>> &message_batch) {
+            [this]() { return m_commit_on_completion && m_requires_commit; },
+            [this](RdKafka::KafkaConsumer *consumer, std::vector<RdKafka::TopicPartition *> &partitions) {
+                this->seek_to_start(consumer, partitions);
+            },
+            [this]() { return m_stop_timestamp_ms; },
+            [this](bool paused) { return this->is_overloaded(paused); },
+            [this](std::size_t home_queue,
+                   std::vector<std::unique_ptr<RdKafka::Message>> &&message_batch,
+                   const std::shared_ptr<KafkaOffsetTracker> &tracker) {
+                auto batch      = std::make_shared<KafkaSourceStage__PendingBatch>();
+                batch->messages = std::move(message_batch);
+
+                if (tracker)
+                {
+                    // Registered now, while batches are still in partition order
+                    auto [first, last] = std::minmax_element(
+                        batch->messages.begin(), batch->messages.end(), [](const auto &lhs, const auto &rhs) {
+                            return lhs->offset() < rhs->offset();
+                        });
+
+                    batch->completion = std::make_shared<KafkaSourceStage__Completion>(
+                        tracker, (*first)->offset(), (*last)->offset() + 1);
+                }
+
+                batch->parsed = this->dispatch_batch_task(home_queue, [batch, this]() {
+                    try
+                    {
+                        batch->meta = std::move(this->process_batch(std::move(batch->messages)));
+                    } catch (std::exception &ex)
+                    {
+                        LOG(ERROR) << "Exception in process_batch. Msg: " << ex.what();
+
+                        batch->failed = true;
+                    }
+
+                    return true;
+                });
+
+                return batch;
+            },
+            [&sub, this](const std::shared_ptr<KafkaSourceStage__PendingBatch> &batch) {
                 // If we are unsubscribed, throw an error to break the loops
                 if (!sub.is_subscribed())
                 {
                     throw KafkaSourceStage__UnsubscribedException();
                 }
 
-                if (message_batch.empty())
+                if (!batch)
                 {
                     return false;
                 }
 
-                std::shared_ptr<morpheus::MessageMeta> batch;
+                batch->parsed.get();
 
-                try
-                {
-                    batch = std::move(this->process_batch(std::move(message_batch)));
-                } catch (std::exception &ex)
+                if (batch->failed)
                 {
-                    LOG(ERROR) << "Exception in process_batch. Msg: " << ex.what();
+                    if (batch->completion)
+                    {
+                        batch->completion->fail();
+                    }
 
                     return false;
                 }
 
-                sub.on_next(std::move(batch));
+                if (!batch->meta)
+                {
+                    // Every message was rejected, still commit so they are not read again. A completion released here
+                    // completes immediately
+                    return m_requires_commit;
+                }
+
+                if (batch->completion)
+                {
+                    batch->meta->add_completion(std::move(batch->completion));
+                }
+
+                if (m_max_in_flight_batches > 0)
+                {
+                    batch->meta->add_completion(
+                        std::make_shared<KafkaSourceStage__InFlightCompletion>(m_in_flight_batches));
+                }
+
+                auto emit_start = std::chrono::high_resolution_clock::now();
+
+                sub.on_next(std::move(batch->meta));
+
+                if (m_adaptive_batching)
+                {
+                    // on_next blocks while downstream is full, use the time spent here to measure backpressure
+                    this->update_batch_size_target(std::chrono::high_resolution_clock::now() - emit_start);
+                }
 
                 return m_requires_commit;
             });
@@ -363,13 +1460,35 @@ KafkaSourceStage::KafkaSourceStage(const neo::Segment &parent,
             LOG(ERROR) << "Exception in rebalance_loop. Msg: " << ex.what();
         }
 
+        bool completed = false;
+
+        if (PipelineDrain::requested())
+        {
+            // Downstream only flushes the last batches, and releases them, once the source completed
+            sub.on_completed();
+            completed = true;
+
+            try
+            {
+                rebalancer.commit_drained(consumer.get(), *m_drain_progress);
+            } catch (std::exception &ex)
+            {
+                LOG(ERROR) << "Exception while committing drained batches. Msg: " << ex.what();
+            }
+        }
+
         consumer->unsubscribe();
         consumer->close();
         consumer.reset();
 
         m_rebalancer = nullptr;
 
-        sub.on_completed();
+        m_drain_progress->set_drained();
+
+        if (!completed)
+        {
+            sub.on_completed();
+        }
     }));
 }
 
@@ -383,6 +1502,70 @@ int32_t KafkaSourceStage::batch_timeout_ms()
     return m_batch_timeout_ms;
 }
 
+std::size_t KafkaSourceStage::max_batch_bytes()
+{
+    return m_max_batch_bytes;
+}
+
+std::size_t KafkaSourceStage::rejected_message_count()
+{
+    return m_rejected_message_count.load();
+}
+
+void KafkaSourceStage::set_decoder(std::shared_ptr<KafkaMessageDecoder> decoder)
+{
+    m_decoder = std::move(decoder);
+}
+
+std::size_t KafkaSourceStage::in_flight_batch_count()
+{
+    return m_in_flight_batches->load();
+}
+
+bool KafkaSourceStage::is_overloaded(bool paused)
+{
+    if (m_max_in_flight_batches == 0)
+    {
+        return false;
+    }
+
+    // Paused partitions resume once half the limit drained, so they do not flap around it
+    auto limit = paused ? m_max_in_flight_batches / 2 : m_max_in_flight_batches - 1;
+
+    return m_in_flight_batches->load() > limit;
+}
+
+std::size_t KafkaSourceStage::batch_size_target()
+{
+    return m_batch_size_target.load();
+}
+
+void KafkaSourceStage::update_batch_size_target(std::chrono::nanoseconds emit_duration)
+{
+    auto min_target = std::max<std::size_t>(1, m_max_batch_size / AdaptiveBatchMinFraction);
+    auto target     = m_batch_size_target.load();
+    std::size_t new_target;
+
+    if (emit_duration >= AdaptiveBatchBackpressureThreshold)
+    {
+        // Downstream is falling behind. Double the batch size to amortize the per-batch cost
+        new_target = std::min(m_max_batch_size, target * 2);
+    }
+    else
+    {
+        // Downstream is keeping up. Slowly shrink the batch size so quiet traffic is not held for the timeout
+        new_target = std::max(min_target, target - target / 8);
+    }
+
+    if (new_target != target)
+    {
+        // Partitions run concurrently. If another partition updated the target first, keep their value
+        m_batch_size_target.compare_exchange_strong(target, new_target);
+
+        VLOG(10) << this->display_str(CONCAT_STR("Adaptive batch size target: " << m_batch_size_target.load()));
+    }
+}
+
 void KafkaSourceStage::start()
 {
     // Save off the queues before setting our concurrency back to 1
@@ -391,6 +1574,8 @@ void KafkaSourceStage::start()
         m_task_queues.push_back(this->resources().fiber_pool().next_task_queue());
     }
 
+    m_task_queue_loads = KafkaTaskQueueLoads(m_task_queues.size(), TaskQueueAffinitySlack);
+
     this->concurrency(1);
 
     // Call the default start
@@ -425,6 +1610,14 @@ std::unique_ptr<RdKafka::Conf> KafkaSourceStage::build_kafka_conf(const std::map
                         "been disabled for this Kafka consumer. This should only be used in a debug environment";
     }
 
+    if (this->is_replay())
+    {
+        // A replay reads from explicit positions, committing them would move the live position of the group
+        LOG(INFO) << "KafkaSourceStage: Replaying from a timestamp or explicit offsets, commits are disabled";
+        config_out["enable.auto.commit"] = "false";
+        m_requires_commit                = false;
+    }
+
     // Make the kafka_conf and set all properties
     auto kafka_conf = std::unique_ptr<RdKafka::Conf>(RdKafka::Conf::create(RdKafka::Conf::CONF_GLOBAL));
 
@@ -440,29 +1633,60 @@ std::unique_ptr<RdKafka::Conf> KafkaSourceStage::build_kafka_conf(const std::map
     return std::move(kafka_conf);
 }
 
-neo::SharedFuture<bool> KafkaSourceStage::launch_tasks(std::vector<std::function<bool()>> &&tasks)
+bool KafkaSourceStage::is_replay() const
+{
+    return m_start_timestamp_ms >= 0 || !m_start_offsets.empty() || m_stop_timestamp_ms >= 0;
+}
+
+void KafkaSourceStage::seek_to_start(RdKafka::KafkaConsumer *consumer, std::vector<RdKafka::TopicPartition *> &partitions)
 {
-    std::vector<neo::SharedFuture<bool>> partition_futures;
+    std::vector<RdKafka::TopicPartition *> by_timestamp;
 
-    // Loop over tasks enqueuing onto saved fiber queues
-    for (size_t i = 0; i < tasks.size(); ++i)
+    for (auto partition : partitions)
     {
-        partition_futures.emplace_back(
-            this->m_task_queues[i % this->m_task_queues.size()]->enqueue(std::move(tasks[i])));
-    }
-
-    // Launch a new task to await on the futures
-    return this->m_task_queues[tasks.size() % this->m_task_queues.size()]->enqueue([partition_futures]() {
-        bool ret_val = true;
+        auto found = m_start_offsets.find(KafkaSourceStage__partition_key(*partition));
 
-        for (auto &f : partition_futures)
+        if (found != m_start_offsets.end())
         {
-            if (!f.get())
-            {
-                // Return false if any return false
-                ret_val = false;
-            }
+            partition->set_offset(found->second);
+        }
+        else if (m_start_timestamp_ms >= 0)
+        {
+            // offsetsForTimes takes the timestamp in place of the offset and replaces it with the offset found
+            partition->set_offset(m_start_timestamp_ms);
+            by_timestamp.push_back(partition);
         }
+    }
+
+    if (!by_timestamp.empty())
+    {
+        // Partitions without a message at or after the timestamp are set to the end
+        CHECK_KAFKA(consumer->offsetsForTimes(by_timestamp, OffsetsForTimesTimeoutMs),
+                    RdKafka::ERR_NO_ERROR,
+                    "Error looking up the offsets of the replay start timestamp");
+    }
+}
+
+neo::SharedFuture<bool> KafkaSourceStage::launch_task(std::size_t home_queue, std::function<bool()> &&task)
+{
+    return this->m_task_queues[home_queue % this->m_task_queues.size()]->enqueue(
+        [this, task = std::move(task)]() {
+            DeviceAffinity::bind_current_thread(m_device_id);
+
+            return task();
+        });
+}
+
+neo::SharedFuture<bool> KafkaSourceStage::dispatch_batch_task(std::size_t home_queue, std::function<bool()> &&task)
+{
+    auto target = m_task_queue_loads.acquire(home_queue);
+
+    return m_task_queues[target]->enqueue([this, target, task = std::move(task)]() {
+        DeviceAffinity::bind_current_thread(m_device_id);
+
+        auto ret_val = task();
+
+        m_task_queue_loads.release(target);
 
         return ret_val;
     });
@@ -486,11 +1710,16 @@ std::unique_ptr<RdKafka::KafkaConsumer> KafkaSourceStage::create_consumer()
         LOG(FATAL) << "Error occurred creating Kafka consumer. Error: " << errstr;
     }
 
-    // Subscribe to the topic. Uses the default rebalancer
-    CHECK_KAFKA(
-        consumer->subscribe(std::vector<std::string>{m_topic}), RdKafka::ERR_NO_ERROR, "Error subscribing to topics");
+    // Subscribe to the topics. Uses the default rebalancer. librdkafka resolves regex subscriptions
+    CHECK_KAFKA(consumer->subscribe(m_topics), RdKafka::ERR_NO_ERROR, "Error subscribing to topics");
 
-    auto spec_topic = std::unique_ptr<RdKafka::Topic>(RdKafka::Topic::create(consumer.get(), m_topic, nullptr, errstr));
+    // Several topics, or a regex, need the metadata of every topic
+    std::unique_ptr<RdKafka::Topic> spec_topic;
+
+    if (m_topics.size() == 1 && !KafkaTopicUtil::is_regex(m_topics.front()))
+    {
+        spec_topic.reset(RdKafka::Topic::create(consumer.get(), m_topics.front(), nullptr, errstr));
+    }
 
     RdKafka::Metadata *md;
 
@@ -532,6 +1761,11 @@ std::unique_ptr<RdKafka::KafkaConsumer> KafkaSourceStage::create_consumer()
 
     for (auto const &topic : *(md->topics()))
     {
+        if (!KafkaTopicUtil::is_subscribed(m_topics, topic->topic()))
+        {
+            continue;
+        }
+
         auto &part_ids = topic_parts[topic->topic()];
 
         auto const &parts = *(topic->partitions());
@@ -570,88 +1804,339 @@ std::unique_ptr<RdKafka::KafkaConsumer> KafkaSourceStage::create_consumer()
     return std::move(consumer);
 }
 
-cudf::io::table_with_metadata KafkaSourceStage::load_table(const std::string &buffer)
+cudf::io::table_with_metadata KafkaSourceStage::load_table(const char *buffer, std::size_t size)
+{
+    auto options = cudf::io::json_reader_options::builder(cudf::io::source_info(buffer, size)).lines(true);
+
+    std::shared_ptr<const std::vector<std::pair<std::string, cudf::type_id>>> schema;
+
+    {
+        std::lock_guard<std::mutex> lock(m_schema_mutex);
+        schema = m_frozen_schema;
+    }
+
+    if (!schema)
+    {
+        auto table = CuDFTableUtil::load_json_table(options.build());
+
+        if (m_schema_batches > 0)
+        {
+            this->learn_schema(table);
+        }
+
+        return table;
+    }
+
+    std::vector<std::string> dtypes;
+    dtypes.reserve(schema->size());
+
+    for (const auto &[column_name, type_id] : *schema)
+    {
+        dtypes.push_back(column_name + ":" + KafkaSourceStage__schema_type_name(type_id));
+    }
+
+    options.dtypes(std::move(dtypes));
+
+    auto table = CuDFTableUtil::load_json_table(options.build());
+
+    KafkaSourceStage__apply_schema(table, *schema);
+
+    return table;
+}
+
+void KafkaSourceStage::learn_schema(const cudf::io::table_with_metadata &table)
 {
-    auto options =
-        cudf::io::json_reader_options::builder(cudf::io::source_info(buffer.c_str(), buffer.size())).lines(true);
+    std::lock_guard<std::mutex> lock(m_schema_mutex);
 
-    auto tbl = cudf::io::read_json(options.build());
+    if (m_frozen_schema)
+    {
+        // Batches parsed concurrently can finish after the schema was frozen
+        return;
+    }
 
-    auto found = std::find(tbl.metadata.column_names.begin(), tbl.metadata.column_names.end(), "data");
+    const auto &names = table.metadata.column_names;
+
+    for (cudf::size_type i = 0; i < table.tbl->num_columns(); ++i)
+    {
+        auto column = table.tbl->get_column(i).view();
 
-    if (found == tbl.metadata.column_names.end())
-        return tbl;
+        if (column.null_count() == column.size())
+        {
+            // The reader's type for a column without values says nothing
+            continue;
+        }
 
-    // Super ugly but cudf cant handle newlines and add extra escapes. So we need to convert
-    // \\n -> \n
-    // \\/ -> \/
-    auto columns = tbl.tbl->release();
+        auto found = std::find_if(m_learned_schema.begin(), m_learned_schema.end(), [&](const auto &entry) {
+            return entry.first == names[i];
+        });
 
-    size_t idx = found - tbl.metadata.column_names.begin();
+        if (found == m_learned_schema.end())
+        {
+            m_learned_schema.emplace_back(names[i], KafkaSourceStage__schema_column_type(column.type().id()));
+        }
+        else
+        {
+            found->second = KafkaSourceStage__merge_schema_types(found->second, column.type().id());
+        }
+    }
 
-    auto updated_data = cudf::strings::replace(
-        cudf::strings_column_view{columns[idx]->view()}, cudf::string_scalar("\\n"), cudf::string_scalar("\n"));
+    if (++m_schema_batches_seen < m_schema_batches)
+    {
+        return;
+    }
 
-    updated_data = cudf::strings::replace(
-        cudf::strings_column_view{updated_data->view()}, cudf::string_scalar("\\/"), cudf::string_scalar("/"));
+    std::ostringstream schema_str;
 
-    columns[idx] = std::move(updated_data);
+    for (const auto &[column_name, type_id] : m_learned_schema)
+    {
+        schema_str << " " << column_name << ":" << KafkaSourceStage__schema_type_name(type_id);
+    }
 
-    tbl.tbl = std::move(std::make_unique<cudf::table>(std::move(columns)));
+    LOG(INFO) << "Froze the Kafka batch schema after " << m_schema_batches_seen << " batches:" << schema_str.str();
 
-    return tbl;
+    m_frozen_schema = std::make_shared<const std::vector<std::pair<std::string, cudf::type_id>>>(m_learned_schema);
 }
 
-template <bool EnableFilter>
-std::string concat_message_batch(std::vector<std::unique_ptr<RdKafka::Message>> const &message_batch)
+/**
+ * @brief Gathers the payloads into `buffer`, one per line. Returns the offset of the start of each line in the buffer
+ * followed by the total number of bytes written.
+ */
+std::vector<std::size_t> concat_message_batch(std::vector<std::unique_ptr<RdKafka::Message>> const &message_batch,
+                                              KafkaSourceStage__PinnedBuffer &buffer)
 {
-    std::ostringstream buffer;
+    // Each payload is followed by a newline
+    std::size_t total_bytes = 0;
+
+    for (auto &msg : message_batch)
+    {
+        total_bytes += msg->len() + 1;
+    }
+
+    char *data = buffer.reserve(total_bytes);
+
+    std::vector<std::size_t> line_offsets;
+    line_offsets.reserve(message_batch.size() + 1);
+
+    std::size_t offset = 0;
 
     for (auto &msg : message_batch)
     {
-        auto s = static_cast<char *>(msg->payload());
+        auto payload = static_cast<const char *>(msg->payload());
+        auto len     = msg->len();
 
-        if constexpr (EnableFilter)
+        // Some producers include the null terminator in the payload
+        while (len > 0 && payload[len - 1] == '\0')
         {
-            if (!nlohmann::json::accept(s))
-            {
-                LOG(ERROR) << "Failed to parse kafka message as json: " << s;
-                continue;
-            }
+            --len;
+        }
+
+        line_offsets.push_back(offset);
+
+        std::memcpy(data + offset, payload, len);
+        offset += len;
+        data[offset++] = '\n';
+    }
+
+    line_offsets.push_back(offset);
+
+    return line_offsets;
+}
+
+/**
+ * @brief Removes the lines marked invalid from `data` in place. Returns the number of bytes remaining.
+ */
+std::size_t compact_message_batch(char *data,
+                                  const std::vector<std::size_t> &line_offsets,
+                                  const std::vector<uint8_t> &line_is_valid)
+{
+    std::size_t offset = 0;
+
+    for (std::size_t i = 0; i < line_is_valid.size(); ++i)
+    {
+        auto start = line_offsets[i];
+        auto len   = line_offsets[i + 1] - start;
+
+        if (!line_is_valid[i])
+        {
+            LOG(ERROR) << "Failed to parse kafka message as json: " << std::string(data + start, len - 1);
+            continue;
         }
 
-        buffer << s << "\n";
+        if (offset != start)
+        {
+            std::memmove(data + offset, data + start, len);
+        }
+
+        offset += len;
     }
 
-    return buffer.str();
+    return offset;
 }
 
 std::shared_ptr<morpheus::MessageMeta> KafkaSourceStage::process_batch(
     std::vector<std::unique_ptr<RdKafka::Message>> &&message_batch)
 {
-    // concat the kafka json messages
-    auto json_lines = !this->m_disable_pre_filtering ? concat_message_batch<true>(message_batch)
-                                                     : concat_message_batch<false>(message_batch);
+    cudf::io::table_with_metadata data_table;
+
+    // One entry per message, cleared for the messages left out of the table
+    std::vector<uint8_t> message_is_kept(message_batch.size(), 1);
+
+    if (m_decoder)
+    {
+        data_table = m_decoder->decode(message_batch, message_is_kept);
+
+        if (!data_table.tbl || data_table.tbl->num_rows() == 0)
+        {
+            // No message could be decoded
+            return nullptr;
+        }
+    }
+    else
+    {
+        // Reused by every batch processed on this thread. Only needs to live until the table has been read
+        thread_local KafkaSourceStage__PinnedBuffer buffer;
+
+        // concat the kafka json messages
+        auto line_offsets = concat_message_batch(message_batch, buffer);
+        auto json_bytes   = line_offsets.back();
+
+        if (!this->m_disable_pre_filtering)
+        {
+            // Validate every line on the device at once and drop the malformed ones before parsing
+            auto line_is_valid = JsonUtil::validate_json_lines(buffer.data(), line_offsets);
+
+            auto rejected_count = std::count(line_is_valid.begin(), line_is_valid.end(), 0);
+
+            if (rejected_count > 0)
+            {
+                json_bytes = compact_message_batch(buffer.data(), line_offsets, line_is_valid);
+
+                m_rejected_message_count += rejected_count;
+            }
 
-    // parse the json
-    auto data_table = this->load_table(json_lines);
+            message_is_kept = std::move(line_is_valid);
+
+            if (json_bytes == 0)
+            {
+                // Nothing left to parse
+                return nullptr;
+            }
+        }
+
+        // parse the json
+        data_table = this->load_table(buffer.data(), json_bytes);
+    }
+
+    if (!m_metadata_columns.empty())
+    {
+        auto kept_count =
+            std::count_if(message_is_kept.begin(), message_is_kept.end(), [](uint8_t is_kept) { return is_kept != 0; });
+
+        if (kept_count != data_table.tbl->num_rows())
+        {
+            // Happens when the JSON reader skips empty payloads with the pre-filter disabled
+            throw std::runtime_error("Metadata columns require one row per message. Read " +
+                                     std::to_string(data_table.tbl->num_rows()) + " rows from " +
+                                     std::to_string(kept_count) + " messages");
+        }
+
+        auto columns = KafkaSourceStage__metadata_columns(message_batch, message_is_kept, m_metadata_columns);
+
+        for (std::size_t i = 0; i < columns.size(); ++i)
+        {
+            KafkaSourceStage__set_column(data_table, m_metadata_columns[i], std::move(columns[i]));
+        }
+    }
+
+    if (!m_topic_column.empty())
+    {
+        // Batches are built per partition, so every row of a batch comes from the same topic
+        auto topic_column = cudf::make_column_from_scalar(cudf::string_scalar(message_batch.front()->topic_name()),
+                                                          data_table.tbl->num_rows());
+
+        KafkaSourceStage__set_column(data_table, m_topic_column, std::move(topic_column));
+    }
+
+    if (!m_drop_null_column.empty())
+    {
+        CuDFTableUtil::drop_nulls(data_table, m_drop_null_column);
+
+        if (data_table.tbl->num_rows() == 0)
+        {
+            // Every row was dropped
+            return nullptr;
+        }
+    }
+
+    // Add the output columns up front, in the table the batch was parsed into. Writing them later never rebuilds
+    // the table
+    MessageMeta::reserve_columns(data_table, m_output_column_names, m_output_column_types);
 
     // Next, create the message metadata. This gets reused for repeats
-    return MessageMeta::create_from_cpp(std::move(data_table), 0);
+    auto meta = MessageMeta::create_from_cpp(std::move(data_table), 0);
+
+    // Checked first so batches are not scanned for their timestamps unless tracing is enabled
+    if (MessageTrace::sample_interval() != 0)
+    {
+        meta->set_trace(MessageTrace::sample(KafkaSourceStage__source_time_ns(message_batch)));
+    }
+
+    return meta;
 }
 
 // ************ KafkaStageInterfaceProxy ************ //
-std::shared_ptr<KafkaSourceStage> KafkaSourceStageInterfaceProxy::init(neo::Segment &parent,
-                                                                       const std::string &name,
-                                                                       size_t max_batch_size,
-                                                                       std::string topic,
-                                                                       int32_t batch_timeout_ms,
-                                                                       std::map<std::string, std::string> config,
-                                                                       bool disable_commits,
-                                                                       bool disable_pre_filtering)
-{
-    auto stage = std::make_shared<KafkaSourceStage>(
-        parent, name, max_batch_size, topic, batch_timeout_ms, config, disable_commits, disable_pre_filtering);
+std::shared_ptr<KafkaSourceStage> KafkaSourceStageInterfaceProxy::init(
+    neo::Segment &parent,
+    const std::string &name,
+    size_t max_batch_size,
+    std::vector<std::string> topics,
+    int32_t batch_timeout_ms,
+    std::map<std::string, std::string> config,
+    bool disable_commits,
+    bool disable_pre_filtering,
+    std::size_t max_batch_bytes,
+    bool adaptive_batching,
+    bool commit_on_completion,
+    std::string topic_column,
+    int64_t start_timestamp_ms,
+    std::map<std::string, int64_t> start_offsets,
+    int64_t stop_timestamp_ms,
+    int32_t device_id,
+    std::string drop_null_column,
+    std::map<std::string, std::string> output_columns,
+    std::map<std::string, std::string> schema,
+    std::size_t schema_batches,
+    const std::string &message_format,
+    const std::string &avro_schema,
+    const std::string &schema_registry_url,
+    std::vector<std::string> metadata_columns,
+    std::size_t max_in_flight_batches)
+{
+    auto stage = std::make_shared<KafkaSourceStage>(parent,
+                                                    name,
+                                                    max_batch_size,
+                                                    std::move(topics),
+                                                    batch_timeout_ms,
+                                                    config,
+                                                    disable_commits,
+                                                    disable_pre_filtering,
+                                                    max_batch_bytes,
+                                                    adaptive_batching,
+                                                    commit_on_completion,
+                                                    std::move(topic_column),
+                                                    start_timestamp_ms,
+                                                    std::move(start_offsets),
+                                                    stop_timestamp_ms,
+                                                    device_id,
+                                                    std::move(drop_null_column),
+                                                    std::move(output_columns),
+                                                    std::move(schema),
+                                                    schema_batches,
+                                                    message_format,
+                                                    avro_schema,
+                                                    schema_registry_url,
+                                                    std::move(metadata_columns),
+                                                    max_in_flight_batches);
 
     parent.register_node<KafkaSourceStage>(stage);
 
@@ -0,0 +1,251 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/load_generator_source.hpp>
+
+#include <morpheus/utilities/pipeline_drain.hpp>
+#include <morpheus/utilities/table_util.hpp>
+
+#include <neo/core/segment.hpp>
+
+#include <boost/fiber/operations.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/table/table.hpp>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private free functions.
+// ************ LoadGeneratorSourceStage__ ************ //
+// Longest sleep between checks of whether the downstream unsubscribed, when batches are due far apart
+constexpr std::chrono::milliseconds LoadGeneratorSourceStage__PollInterval{100};
+
+static LoadGeneratorOptions LoadGeneratorSourceStage__options(double rows_per_second,
+                                                              std::size_t batch_size,
+                                                              const std::string &distribution,
+                                                              double jitter,
+                                                              std::vector<std::string> mutate_columns,
+                                                              uint64_t seed)
+{
+    LoadGeneratorOptions options;
+    options.rows_per_second = rows_per_second;
+    options.batch_size      = batch_size;
+    options.distribution    = parse_batch_size_distribution(distribution);
+    options.jitter          = jitter;
+    options.mutate_columns  = std::move(mutate_columns);
+    options.seed            = seed;
+
+    return options;
+}
+
+// Component public implementations
+// ************ LoadGeneratorSourceStage ************* //
+LoadGeneratorSourceStage::LoadGeneratorSourceStage(const neo::Segment &parent,
+                                                   const std::string &name,
+                                                   LoadGenerator generator,
+                                                   std::size_t total_rows,
+                                                   double duration_sec,
+                                                   bool trace_all,
+                                                   std::map<std::string, std::string> output_columns) :
+  neo::SegmentObject(parent, name),
+  base_t(parent, name),
+  m_generator(std::move(generator)),
+  m_total_rows(total_rows),
+  m_duration_sec(duration_sec),
+  m_trace_all(trace_all)
+{
+    for (const auto &[column_name, column_type] : output_columns)
+    {
+        m_output_column_names.push_back(column_name);
+        m_output_column_types.push_back(DataType::from_numpy(column_type).type_id());
+    }
+
+    this->set_source_observable(neo::Observable<source_type_t>([this](neo::Subscriber<source_type_t> &sub) {
+        try
+        {
+            this->generate_all(sub);
+        } catch (...)
+        {
+            sub.on_error(std::current_exception());
+            return;
+        }
+
+        sub.on_completed();
+    }));
+}
+
+std::size_t LoadGeneratorSourceStage::rows_emitted() const
+{
+    return m_rows_emitted;
+}
+
+int64_t LoadGeneratorSourceStage::max_lag_ns() const
+{
+    return m_max_lag_ns;
+}
+
+void LoadGeneratorSourceStage::generate_all(neo::Subscriber<source_type_t> &sub)
+{
+    using clock_t = LoadGenerator::clock_t;
+
+    const auto start    = clock_t::now();
+    const auto deadline = m_duration_sec > 0
+                              ? start + std::chrono::duration_cast<clock_t::duration>(
+                                            std::chrono::duration<double>(m_duration_sec))
+                              : clock_t::time_point::max();
+
+    while (sub.is_subscribed() && !PipelineDrain::requested())
+    {
+        auto rows = m_generator.next_batch_size();
+
+        if (m_total_rows > 0)
+        {
+            if (m_rows_emitted >= m_total_rows)
+            {
+                break;
+            }
+
+            rows = std::min(rows, m_total_rows - m_rows_emitted);
+        }
+
+        auto due = m_generator.schedule(rows, start);
+
+        if (due >= deadline)
+        {
+            break;
+        }
+
+        while (sub.is_subscribed() && !PipelineDrain::requested() && clock_t::now() < due)
+        {
+            boost::this_fiber::sleep_until(std::min(due, clock_t::now() + LoadGeneratorSourceStage__PollInterval));
+        }
+
+        if (!sub.is_subscribed() || PipelineDrain::requested())
+        {
+            break;
+        }
+
+        // Without a target rate every batch is due at the start, there is no schedule to fall behind
+        int64_t lag_ns = 0;
+
+        if (m_generator.rows_per_second() > 0)
+        {
+            lag_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - due).count();
+        }
+
+        auto table = m_generator.make_batch(rows);
+
+        MessageMeta::reserve_columns(table, m_output_column_names, m_output_column_types);
+
+        auto meta = MessageMeta::create_from_cpp(std::move(table), 1);
+
+        // Stamped with the time the batch was due, see the class documentation
+        auto source_time_ns = MessageTrace::now_ns() - lag_ns;
+        meta->set_trace(m_trace_all ? std::make_shared<MessageTrace>(source_time_ns)
+                                    : MessageTrace::sample(source_time_ns));
+
+        m_max_lag_ns = std::max<int64_t>(m_max_lag_ns, lag_ns);
+        m_rows_emitted += rows;
+
+        sub.on_next(std::move(meta));
+    }
+
+    VLOG(10) << "Generated " << m_rows_emitted << " rows, at most " << m_max_lag_ns / 1000000 << " ms behind schedule";
+}
+
+// ************ LoadGeneratorSourceStageInterfaceProxy ************ //
+std::shared_ptr<LoadGeneratorSourceStage> LoadGeneratorSourceStageInterfaceProxy::init_from_file(
+    neo::Segment &parent,
+    const std::string &name,
+    const std::string &filename,
+    double rows_per_second,
+    std::size_t batch_size,
+    const std::string &distribution,
+    double jitter,
+    std::vector<std::string> mutate_columns,
+    std::size_t total_rows,
+    double duration_sec,
+    bool trace_all,
+    uint64_t seed,
+    std::map<std::string, std::string> output_columns)
+{
+    auto table           = CuDFTableUtil::load_table(filename);
+    auto index_col_count = CuDFTableUtil::get_index_col_count(table);
+
+    LoadGenerator generator(
+        std::move(table),
+        index_col_count,
+        LoadGeneratorSourceStage__options(
+            rows_per_second, batch_size, distribution, jitter, std::move(mutate_columns), seed));
+
+    auto stage = std::make_shared<LoadGeneratorSourceStage>(
+        parent, name, std::move(generator), total_rows, duration_sec, trace_all, std::move(output_columns));
+
+    parent.register_node<LoadGeneratorSourceStage>(stage);
+
+    return stage;
+}
+
+std::shared_ptr<LoadGeneratorSourceStage> LoadGeneratorSourceStageInterfaceProxy::init_from_meta(
+    neo::Segment &parent,
+    const std::string &name,
+    std::shared_ptr<MessageMeta> template_meta,
+    double rows_per_second,
+    std::size_t batch_size,
+    const std::string &distribution,
+    double jitter,
+    std::vector<std::string> mutate_columns,
+    std::size_t total_rows,
+    double duration_sec,
+    bool trace_all,
+    uint64_t seed,
+    std::map<std::string, std::string> output_columns)
+{
+    auto info = template_meta->get_info();
+
+    // Index columns come first in the view, same as the layout of a loaded table
+    auto column_names = info.get_index_names();
+    auto data_columns = info.get_column_names();
+    column_names.insert(column_names.end(), data_columns.begin(), data_columns.end());
+
+    cudf::io::table_with_metadata table{std::make_unique<cudf::table>(info.get_view()), cudf::io::table_metadata{}};
+    table.metadata.column_names = std::move(column_names);
+
+    LoadGenerator generator(
+        std::move(table),
+        info.num_indices(),
+        LoadGeneratorSourceStage__options(
+            rows_per_second, batch_size, distribution, jitter, std::move(mutate_columns), seed));
+
+    auto stage = std::make_shared<LoadGeneratorSourceStage>(
+        parent, name, std::move(generator), total_rows, duration_sec, trace_all, std::move(output_columns));
+
+    parent.register_node<LoadGeneratorSourceStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -0,0 +1,198 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/monitor.hpp>
+
+#include <neo/core/segment_object.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace morpheus {
+// Component-private classes.
+// ************ MonitorStage__Reporter ************ //
+/**
+ * @brief Writes the progress line of one monitor from its own thread, reading the stage counters. Only created when
+ * the console line is enabled, so the pipeline threads never format or write anything.
+ */
+class MonitorStage__Reporter
+{
+  public:
+    MonitorStage__Reporter(std::shared_ptr<StageMetrics> metrics,
+                           std::string description,
+                           std::string unit,
+                           std::chrono::milliseconds interval) :
+      m_metrics(std::move(metrics)),
+      m_description(std::move(description)),
+      m_unit(std::move(unit)),
+      m_interval(interval),
+      m_start(std::chrono::steady_clock::now()),
+      m_start_rows(m_metrics->snapshot().rows_in)
+    {
+        m_thread = std::thread(&MonitorStage__Reporter::run, this);
+    }
+
+    ~MonitorStage__Reporter()
+    {
+        this->stop("");
+    }
+
+    /**
+     * @brief Stops the thread and writes the final line, with `status` appended. Only the first call has an effect.
+     */
+    void stop(const std::string &status)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_stopped)
+            {
+                return;
+            }
+
+            m_stopped = true;
+        }
+
+        m_cv.notify_all();
+        m_thread.join();
+
+        this->write_line(status);
+    }
+
+  private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (!m_cv.wait_for(lock, m_interval, [this]() { return m_stopped; }))
+        {
+            this->write_line("");
+        }
+    }
+
+    void write_line(const std::string &status) const
+    {
+        const auto rows    = m_metrics->snapshot().rows_in - m_start_rows;
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+
+        std::ostringstream line;
+        line << m_description << status << ": " << rows << " " << m_unit << " [" << std::fixed << std::setprecision(1)
+             << elapsed << "s, " << std::setprecision(2) << (elapsed > 0 ? rows / elapsed : 0.0) << " " << m_unit
+             << "/s]\n";
+
+        // A single write so lines of different monitors do not interleave
+        std::cerr << line.str() << std::flush;
+    }
+
+    std::shared_ptr<StageMetrics> m_metrics;
+    std::string m_description;
+    std::string m_unit;
+    std::chrono::milliseconds m_interval;
+    std::chrono::steady_clock::time_point m_start;
+    uint64_t m_start_rows;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stopped{false};
+    std::thread m_thread;
+};
+
+// Component public implementations
+// ************ MonitorStage **************************** //
+template <typename MessageT>
+MonitorStage<MessageT>::MonitorStage(const neo::Segment &parent,
+                                     const std::string &name,
+                                     std::string description,
+                                     std::string unit,
+                                     std::size_t log_interval_ms) :
+  neo::SegmentObject(parent, name),
+  base_t(parent, name, build_operator()),
+  m_description(std::move(description)),
+  m_unit(std::move(unit)),
+  m_log_interval_ms(log_interval_ms),
+  m_metrics(StageMetrics::get(name))
+{}
+
+template <typename MessageT>
+typename MonitorStage<MessageT>::operator_fn_t MonitorStage<MessageT>::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        std::shared_ptr<MonitorStage__Reporter> reporter;
+
+        if (m_log_interval_ms > 0)
+        {
+            reporter = std::make_shared<MonitorStage__Reporter>(
+                m_metrics, m_description, m_unit, std::chrono::milliseconds(m_log_interval_ms));
+        }
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output](reader_type_t &&x) {
+                m_metrics->record_in(StageMetrics::message_rows(x));
+                m_metrics->emit(output, std::move(x));
+            },
+            [reporter, &output](std::exception_ptr error_ptr) {
+                if (reporter)
+                {
+                    reporter->stop("[Error]");
+                }
+
+                output.on_error(error_ptr);
+            },
+            [reporter, &output]() {
+                if (reporter)
+                {
+                    reporter->stop("[Complete]");
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ MonitorStageInterfaceProxy ************* //
+template <typename MessageT>
+std::shared_ptr<MonitorStage<MessageT>> MonitorStageInterfaceProxy<MessageT>::init(neo::Segment &parent,
+                                                                                   const std::string &name,
+                                                                                   std::string description,
+                                                                                   std::string unit,
+                                                                                   std::size_t log_interval_ms)
+{
+    auto stage = std::make_shared<MonitorStage<MessageT>>(
+        parent, name, std::move(description), std::move(unit), log_interval_ms);
+
+    parent.register_node<MonitorStage<MessageT>>(stage);
+
+    return stage;
+}
+
+template class MonitorStage<MessageMeta>;
+template class MonitorStage<MultiMessage>;
+template struct MonitorStageInterfaceProxy<MessageMeta>;
+template struct MonitorStageInterfaceProxy<MultiMessage>;
+}  // namespace morpheus
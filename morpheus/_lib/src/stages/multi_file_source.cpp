@@ -0,0 +1,287 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/stages/multi_file_source.hpp>
+
+#include <morpheus/utilities/table_util.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <neo/core/segment.hpp>
+
+#include <cudf/io/types.hpp>
+
+#include <boost/fiber/buffered_channel.hpp>
+#include <boost/fiber/channel_op_status.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <glob.h>  // for glob
+
+namespace morpheus {
+    // Component-private classes.
+    // ************ MultiFileSourceStage__Result ************ //
+    struct MultiFileSourceStage__Result {
+        std::size_t file_idx{0};
+        cudf::io::table_with_metadata table;
+        std::exception_ptr error{nullptr};
+    };
+
+    // ************ MultiFileSourceStage__Readers ************ //
+    /**
+     * @brief Pool of threads reading the requested files. Results are returned in the order the reads complete. The
+     * caller never has more than `max_in_flight` requests outstanding, so neither channel ever blocks the producer.
+     */
+    class MultiFileSourceStage__Readers {
+    public:
+        MultiFileSourceStage__Readers(const std::vector<std::string> &filenames,
+                                      std::size_t num_threads,
+                                      std::size_t max_in_flight) :
+                m_filenames(filenames),
+                m_requests(MultiFileSourceStage__Readers::channel_capacity(max_in_flight)),
+                m_results(MultiFileSourceStage__Readers::channel_capacity(max_in_flight)) {
+            for (std::size_t i = 0; i < num_threads; ++i) {
+                m_threads.emplace_back(&MultiFileSourceStage__Readers::run, this);
+            }
+        }
+
+        ~MultiFileSourceStage__Readers() {
+            this->close();
+        }
+
+        void request(std::size_t file_idx) {
+            m_requests.push(file_idx);
+        }
+
+        /**
+         * @brief Waits for the next completed read, suspending only the calling fiber.
+         */
+        MultiFileSourceStage__Result next() {
+            MultiFileSourceStage__Result result;
+
+            if (m_results.pop(result) != boost::fibers::channel_op_status::success) {
+                throw std::runtime_error("File readers were closed");
+            }
+
+            return result;
+        }
+
+        /**
+         * @brief Waits for the reads in progress and stops the threads.
+         */
+        void close() {
+            m_requests.close();
+
+            for (auto &thread: m_threads) {
+                if (thread.joinable()) {
+                    thread.join();
+                }
+            }
+
+            m_results.close();
+        }
+
+    private:
+        static std::size_t channel_capacity(std::size_t max_in_flight) {
+            // Buffered channels require a power of two and hold one less than their capacity
+            std::size_t capacity = 2;
+
+            while (capacity < max_in_flight + 1) {
+                capacity <<= 1;
+            }
+
+            return capacity;
+        }
+
+        void run() {
+            std::size_t file_idx = 0;
+
+            while (m_requests.pop(file_idx) == boost::fibers::channel_op_status::success) {
+                MultiFileSourceStage__Result result;
+                result.file_idx = file_idx;
+
+                try {
+                    result.table = CuDFTableUtil::load_table(m_filenames[file_idx]);
+                } catch (...) {
+                    result.error = std::current_exception();
+                }
+
+                m_results.push(std::move(result));
+            }
+        }
+
+        const std::vector<std::string> &m_filenames;
+        boost::fibers::buffered_channel<std::size_t> m_requests;
+        boost::fibers::buffered_channel<MultiFileSourceStage__Result> m_results;
+        std::vector<std::thread> m_threads;
+    };
+
+    // Component public implementations
+    // ************ MultiFileSourceStage ************* //
+    MultiFileSourceStage::MultiFileSourceStage(const neo::Segment &parent,
+                                               const std::string &name,
+                                               std::vector<std::string> filenames,
+                                               std::size_t prefetch,
+                                               bool ordered,
+                                               std::map<std::string, std::string> output_columns) :
+            neo::SegmentObject(parent, name),
+            base_t(parent, name),
+            m_filenames(MultiFileSourceStage::expand_filenames(filenames)),
+            m_prefetch(prefetch),
+            m_ordered(ordered) {
+        if (m_prefetch == 0) {
+            throw std::invalid_argument("prefetch must be greater than 0");
+        }
+
+        for (const auto &[column_name, column_type]: output_columns) {
+            m_output_column_names.push_back(column_name);
+            m_output_column_types.push_back(DataType::from_numpy(column_type).type_id());
+        }
+
+        this->set_source_observable(neo::Observable<source_type_t>([this](neo::Subscriber<source_type_t> &sub) {
+            try {
+                this->emit_files(sub);
+            } catch (...) {
+                sub.on_error(std::current_exception());
+            }
+        }));
+    }
+
+    std::vector<std::string> MultiFileSourceStage::expand_filenames(const std::vector<std::string> &patterns) {
+        std::vector<std::string> filenames;
+
+        for (const auto &pattern: patterns) {
+            if (pattern.find_first_of("*?[") == std::string::npos) {
+                filenames.push_back(pattern);
+                continue;
+            }
+
+            glob_t matches{};
+
+            // Matches are sorted
+            int status = ::glob(pattern.c_str(), 0, nullptr, &matches);
+
+            if (status == 0) {
+                filenames.insert(filenames.end(), matches.gl_pathv, matches.gl_pathv + matches.gl_pathc);
+            }
+
+            ::globfree(&matches);
+
+            if (status == GLOB_NOMATCH) {
+                throw std::invalid_argument("No files match '" + pattern + "'");
+            }
+
+            if (status != 0) {
+                throw std::runtime_error("Failed to expand '" + pattern + "'");
+            }
+        }
+
+        return filenames;
+    }
+
+    void MultiFileSourceStage::emit_files(neo::Subscriber<source_type_t> &sub) {
+        const std::size_t num_files = m_filenames.size();
+
+        if (num_files == 0) {
+            sub.on_completed();
+            return;
+        }
+
+        MultiFileSourceStage__Readers readers(m_filenames, std::min(m_prefetch, num_files), m_prefetch);
+
+        std::size_t next_request = 0;
+        std::size_t next_emit = 0;
+        std::size_t in_flight = 0;
+
+        // Files which finished before an earlier file, only used when ordered
+        std::map<std::size_t, cudf::io::table_with_metadata> reordered;
+
+        auto request_more = [&]() {
+            while (next_request < num_files && in_flight < m_prefetch) {
+                readers.request(next_request++);
+                ++in_flight;
+            }
+        };
+
+        auto emit = [&](cudf::io::table_with_metadata &&table) {
+            int index_col_count = CuDFTableUtil::get_index_col_count(table);
+
+            // Add the output columns up front while the table is still in C++
+            MessageMeta::reserve_columns(table, m_output_column_names, m_output_column_types);
+
+            auto meta = MessageMeta::create_from_cpp(std::move(table), index_col_count);
+
+            --in_flight;
+            ++next_emit;
+
+            sub.on_next(std::move(meta));
+        };
+
+        request_more();
+
+        while (next_emit < num_files && sub.is_subscribed()) {
+            auto result = readers.next();
+
+            if (result.error) {
+                std::rethrow_exception(result.error);
+            }
+
+            if (!m_ordered) {
+                emit(std::move(result.table));
+            } else {
+                reordered.emplace(result.file_idx, std::move(result.table));
+
+                while (!reordered.empty() && reordered.begin()->first == next_emit) {
+                    auto table = std::move(reordered.begin()->second);
+                    reordered.erase(reordered.begin());
+
+                    emit(std::move(table));
+                }
+            }
+
+            request_more();
+        }
+
+        readers.close();
+
+        sub.on_completed();
+    }
+
+    // ************ MultiFileSourceStageInterfaceProxy ************ //
+    std::shared_ptr<MultiFileSourceStage>
+    MultiFileSourceStageInterfaceProxy::init(neo::Segment &parent,
+                                             const std::string &name,
+                                             std::vector<std::string> filenames,
+                                             std::size_t prefetch,
+                                             bool ordered,
+                                             std::map<std::string, std::string> output_columns) {
+        auto stage = std::make_shared<MultiFileSourceStage>(
+                parent, name, std::move(filenames), prefetch, ordered, std::move(output_columns));
+
+        parent.register_node<MultiFileSourceStage>(stage);
+
+        return stage;
+    }
+}  // namespace morpheus
@@ -0,0 +1,397 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/prefilter.hpp>
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <neo/core/segment_object.hpp>
+
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/reduction.hpp>
+#include <cudf/replace.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/stream_compaction.hpp>
+#include <cudf/strings/contains.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/types.hpp>
+#include <cudf/unary.hpp>
+
+#include <boost/fiber/channel_op_status.hpp>
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/mutex.hpp>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ PrefilterStage__BenignWriter ************ //
+/**
+ * @brief Lets `StageMetrics` emit into the queue of matched rows like it emits into the output of the stage.
+ */
+struct PrefilterStage__BenignWriter
+{
+    PrefilterStage::benign_channel_t &channel;
+
+    void on_next(std::shared_ptr<MultiMessage> &&message)
+    {
+        // Blocks while the merge stage is behind. Only closed once the input completed or the merge stage failed
+        channel.push(std::move(message));
+    }
+};
+
+// ************ PrefilterMergeStage__State ************ //
+/**
+ * @brief Shared by the operator and the fiber emitting the matched rows, which must not emit at the same time.
+ */
+struct PrefilterMergeStage__State
+{
+    boost::fibers::mutex mutex;
+    boost::fibers::condition_variable cv;
+
+    bool stopped{false};  // Set once the fiber emitted every matched row and exited
+};
+
+// Component-private free functions.
+/**
+ * @brief `value` with every regular expression metacharacter escaped.
+ */
+std::string PrefilterStage__escape(const std::string &value)
+{
+    static const std::string metacharacters = "\\^$.|?*+()[]{}";
+
+    std::string escaped;
+    escaped.reserve(value.size() * 2);
+
+    for (auto c : value)
+    {
+        if (metacharacters.find(c) != std::string::npos)
+        {
+            escaped.push_back('\\');
+        }
+
+        escaped.push_back(c);
+    }
+
+    return escaped;
+}
+
+/**
+ * @brief A single alternation of every pattern and of every literal, anchored to match whole values.
+ */
+std::string PrefilterStage__compile(const std::vector<std::string> &patterns, const std::vector<std::string> &literals)
+{
+    std::vector<std::string> alternatives;
+
+    std::transform(patterns.begin(), patterns.end(), std::back_inserter(alternatives), [](const std::string &pattern) {
+        return "(?:" + pattern + ")";
+    });
+
+    std::transform(literals.begin(), literals.end(), std::back_inserter(alternatives), [](const std::string &literal) {
+        return "^" + PrefilterStage__escape(literal) + "$";
+    });
+
+    if (alternatives.empty())
+    {
+        throw std::invalid_argument("PrefilterStage requires at least one pattern or literal");
+    }
+
+    std::string pattern = alternatives.front();
+
+    for (std::size_t i = 1; i < alternatives.size(); ++i)
+    {
+        pattern += "|" + alternatives[i];
+    }
+
+    return pattern;
+}
+
+std::size_t PrefilterStage__queue_size(std::size_t benign_queue_size)
+{
+    if (benign_queue_size < 2 || (benign_queue_size & (benign_queue_size - 1)) != 0)
+    {
+        throw std::invalid_argument("PrefilterStage benign_queue_size must be a power of 2 greater than 1");
+    }
+
+    return benign_queue_size;
+}
+
+/**
+ * @brief New message of the rows of `info` where `mask` is true, sharing the completions of `message`.
+ */
+std::shared_ptr<MultiMessage> PrefilterStage__select(const std::shared_ptr<MultiMessage> &message,
+                                                     const TableInfo &info,
+                                                     const cudf::column_view &mask,
+                                                     const std::vector<std::string> &label_columns)
+{
+    auto columns = cudf::apply_boolean_mask(info.get_view(), mask)->release();
+
+    const auto num_rows = columns.empty() ? 0 : columns.front()->size();
+
+    // Same layout as SerializeStage, index columns first
+    auto column_names = info.get_index_names();
+    auto data_columns = info.get_column_names();
+    column_names.insert(column_names.end(), data_columns.begin(), data_columns.end());
+
+    for (const auto &label_column : label_columns)
+    {
+        auto label = cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(false), num_rows);
+
+        auto found = std::find(column_names.begin() + info.num_indices(), column_names.end(), label_column);
+
+        if (found != column_names.end())
+        {
+            columns[found - column_names.begin()] = std::move(label);
+        }
+        else
+        {
+            columns.emplace_back(std::move(label));
+            column_names.push_back(label_column);
+        }
+    }
+
+    cudf::io::table_with_metadata table{std::make_unique<cudf::table>(std::move(columns)), cudf::io::table_metadata{}};
+    table.metadata.column_names = std::move(column_names);
+
+    auto meta = MessageMeta::create_from_cpp(std::move(table), info.num_indices());
+
+    meta->inherit_completions(*message->meta);
+
+    return std::make_shared<MultiMessage>(meta, 0, num_rows);
+}
+
+// Component public implementations
+// ************ PrefilterStage **************************** //
+PrefilterStage::PrefilterStage(const neo::Segment &parent,
+                               const std::string &name,
+                               std::string column,
+                               const std::vector<std::string> &patterns,
+                               const std::vector<std::string> &literals,
+                               std::vector<std::string> label_columns,
+                               bool forward_benign,
+                               std::size_t benign_queue_size) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_column(std::move(column)),
+  m_pattern(PrefilterStage__compile(patterns, literals)),
+  m_label_columns(std::move(label_columns)),
+  m_forward_benign(forward_benign),
+  m_benign_channel(PrefilterStage__queue_size(benign_queue_size)),
+  m_metrics(StageMetrics::get(name))
+{}
+
+std::size_t PrefilterStage::benign_count() const
+{
+    return m_benign_rows.load();
+}
+
+PrefilterStage::benign_channel_t &PrefilterStage::benign_channel()
+{
+    return m_benign_channel;
+}
+
+PrefilterStage::operator_fn_t PrefilterStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output](reader_type_t &&x) {
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                DeviceMemory::ScopedTag memory_tag("PrefilterStage");
+
+                auto info       = x->get_meta();
+                auto column_idx = info.get_schema()->find_column(m_column);
+
+                if (column_idx < 0)
+                {
+                    throw std::runtime_error("PrefilterStage could not find the column '" + m_column + "'");
+                }
+
+                MORPHEUS_DEVICE_RANGE("PrefilterStage::match");
+
+                const auto strings = info.get_view().column(info.num_indices() + column_idx);
+
+                auto matches = cudf::replace_nulls(
+                    cudf::strings::contains_re(cudf::strings_column_view(strings), m_pattern)->view(),
+                    cudf::numeric_scalar<bool>(false));
+
+                auto [min_match, max_match] = cudf::minmax(matches->view());
+
+                // Invalid for empty messages
+                const bool any_benign =
+                    max_match->is_valid() && static_cast<cudf::numeric_scalar<bool> &>(*max_match).value();
+                const bool all_benign = static_cast<cudf::numeric_scalar<bool> &>(*min_match).value();
+
+                if (!any_benign)
+                {
+                    // The common case, nothing to take out
+                    metrics_scope.emit(output, std::move(x));
+                    return;
+                }
+
+                std::shared_ptr<MultiMessage> remaining;
+                std::size_t benign_rows = x->mess_count;
+
+                if (!all_benign)
+                {
+                    auto remaining_mask = cudf::unary_operation(matches->view(), cudf::unary_operator::NOT);
+
+                    remaining = PrefilterStage__select(x, info, remaining_mask->view(), {});
+                    benign_rows -= remaining->mess_count;
+                }
+
+                m_benign_rows += benign_rows;
+
+                if (m_forward_benign)
+                {
+                    PrefilterStage__BenignWriter writer{m_benign_channel};
+                    metrics_scope.emit(writer, PrefilterStage__select(x, info, matches->view(), m_label_columns));
+                }
+
+                if (remaining)
+                {
+                    metrics_scope.emit(output, std::move(remaining));
+                }
+            },
+            [this, &output](std::exception_ptr error_ptr) {
+                m_benign_channel.close();
+
+                output.on_error(error_ptr);
+            },
+            [this, &output]() {
+                m_benign_channel.close();
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ PrefilterMergeStage *********************** //
+PrefilterMergeStage::PrefilterMergeStage(const neo::Segment &parent,
+                                         const std::string &name,
+                                         std::shared_ptr<PrefilterStage> prefilter) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_prefilter(std::move(prefilter)),
+  m_metrics(StageMetrics::get(name))
+{}
+
+PrefilterMergeStage::operator_fn_t PrefilterMergeStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        auto state = std::make_shared<PrefilterMergeStage__State>();
+
+        // Emits the matched rows as soon as they are queued, even while no other message reaches this stage
+        boost::fibers::fiber([this, state, &output]() {
+            auto &channel = m_prefilter->benign_channel();
+
+            std::shared_ptr<MultiMessage> message;
+
+            while (channel.pop(message) == boost::fibers::channel_op_status::success)
+            {
+                std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+                m_metrics->emit(output, std::move(message));
+            }
+
+            std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+            state->stopped = true;
+            state->cv.notify_all();
+        }).detach();
+
+        // The prefilter completes, closing the queue, before the input of this stage does
+        auto wait_drained = [state]() {
+            std::unique_lock<boost::fibers::mutex> lock(state->mutex);
+            state->cv.wait(lock, [&]() { return state->stopped; });
+        };
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, state, &output](reader_type_t &&x) {
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                std::lock_guard<boost::fibers::mutex> lock(state->mutex);
+                metrics_scope.emit(output, std::move(x));
+            },
+            [this, wait_drained, &output](std::exception_ptr error_ptr) {
+                // Unblocks the prefilter, whose remaining matched rows are dropped
+                m_prefilter->benign_channel().close();
+
+                wait_drained();
+
+                output.on_error(error_ptr);
+            },
+            [wait_drained, &output]() {
+                wait_drained();
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ PrefilterStageInterfaceProxy ************* //
+std::shared_ptr<PrefilterStage> PrefilterStageInterfaceProxy::init(neo::Segment &parent,
+                                                                   const std::string &name,
+                                                                   std::string column,
+                                                                   std::vector<std::string> patterns,
+                                                                   std::vector<std::string> literals,
+                                                                   std::vector<std::string> label_columns,
+                                                                   bool forward_benign,
+                                                                   std::size_t benign_queue_size)
+{
+    auto stage = std::make_shared<PrefilterStage>(parent,
+                                                  name,
+                                                  std::move(column),
+                                                  patterns,
+                                                  literals,
+                                                  std::move(label_columns),
+                                                  forward_benign,
+                                                  benign_queue_size);
+
+    parent.register_node<PrefilterStage>(stage);
+
+    return stage;
+}
+
+// ************ PrefilterMergeStageInterfaceProxy ******** //
+std::shared_ptr<PrefilterMergeStage> PrefilterMergeStageInterfaceProxy::init(neo::Segment &parent,
+                                                                             const std::string &name,
+                                                                             std::shared_ptr<PrefilterStage> prefilter)
+{
+    auto stage = std::make_shared<PrefilterMergeStage>(parent, name, std::move(prefilter));
+
+    parent.register_node<PrefilterMergeStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
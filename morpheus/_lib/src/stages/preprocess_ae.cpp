@@ -0,0 +1,150 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/preprocess_ae.hpp>
+
+#include <morpheus/messages/memory/inference_memory.hpp>
+#include <morpheus/objects/feature_scaler.hpp>
+#include <morpheus/objects/tensor.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/utilities/cuda_graph.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
+
+#include <neo/core/segment.hpp>
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+#include <pyneo/node.hpp>
+
+#include <cudf/column/column_view.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component public implementations
+// ************ PreprocessAEStage ************************** //
+PreprocessAEStage::PreprocessAEStage(const neo::Segment &parent,
+                                     const std::string &name,
+                                     std::vector<std::string> features,
+                                     const std::string &scaling_file) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_fea_cols(std::move(features)),
+  m_graphs(std::make_shared<CudaGraphCache>()),
+  m_metrics(StageMetrics::get(name))
+{
+    if (!scaling_file.empty())
+    {
+        // Resolved once, every message packs the same columns
+        auto scaler = FeatureScaler::load_json(scaling_file);
+
+        m_shift = scaler->shift(m_fea_cols);
+        m_scale = scaler->scale(m_fea_cols);
+    }
+}
+
+PreprocessAEStage::operator_fn_t PreprocessAEStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output](reader_type_t &&x) {
+                DeviceMemory::ScopedTag memory_tag("PreprocessAEStage");
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                auto df_meta          = x->get_meta(m_fea_cols);
+                auto df_just_features = df_meta.get_view();
+
+                std::vector<cudf::column_view> feature_cols;
+
+                for (size_t i = 0; i < df_meta.num_columns(); ++i)
+                {
+                    feature_cols.push_back(df_just_features.column(df_meta.num_indices() + i));
+                }
+
+                std::size_t rows = x->mess_count;
+                std::size_t cols = feature_cols.size();
+
+                // Allocated up front, a graph replay writes to the outputs named in its arguments
+                auto packed =
+                    std::make_shared<rmm::device_buffer>(rows * cols * sizeof(float), rmm::cuda_stream_per_thread);
+                auto seg_ids_buffer =
+                    std::make_shared<rmm::device_buffer>(rows * 3 * sizeof(uint32_t), rmm::cuda_stream_per_thread);
+
+                auto packed_data  = static_cast<float *>(packed->data());
+                auto seg_ids_data = static_cast<uint32_t *>(seg_ids_buffer->data());
+
+                // Casts, scales and writes the features row-major and builds the seq ids in a single launch, replayed
+                // as a CUDA Graph per number of rows when enabled
+                m_graphs->run({static_cast<int64_t>(rows), static_cast<int64_t>(cols)},
+                              MatxUtil::pack_features_args(feature_cols, m_shift, m_scale, packed_data, seg_ids_data),
+                              [rows, cols](rmm::cuda_stream_view stream, const void *device_args) {
+                                  MatxUtil::pack_features(device_args, rows, cols, stream);
+                              });
+
+                NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+                auto input = Tensor::create(std::move(packed),
+                                            DType::create<float>(),
+                                            std::vector<TensorIndex>{static_cast<long long>(x->mess_count),
+                                                                     static_cast<int>(m_fea_cols.size())},
+                                            std::vector<TensorIndex>{},
+                                            0);
+
+                auto seg_ids =
+                    Tensor::create(std::move(seg_ids_buffer),
+                                   DType::create<uint32_t>(),
+                                   std::vector<TensorIndex>{static_cast<long long>(x->mess_count), static_cast<int>(3)},
+                                   std::vector<TensorIndex>{},
+                                   0);
+
+                // Same tensor names as InferenceMemoryAE in the Python stage
+                auto memory = std::make_shared<InferenceMemory>(x->mess_count);
+                memory->inputs.emplace("input", std::move(input));
+                memory->inputs.emplace("seq_ids", std::move(seg_ids));
+
+                auto next = std::make_shared<MultiInferenceMessage>(
+                    x->meta, x->mess_offset, x->mess_count, std::move(memory), 0, x->mess_count);
+
+                metrics_scope.emit(output, std::move(next));
+            },
+            [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [&]() { output.on_completed(); }));
+    };
+}
+
+// ************ PreprocessAEStageInterfaceProxy ************ //
+std::shared_ptr<PreprocessAEStage> PreprocessAEStageInterfaceProxy::init(neo::Segment &parent,
+                                                                         const std::string &name,
+                                                                         std::vector<std::string> features,
+                                                                         const std::string &scaling_file)
+{
+    auto stage = std::make_shared<PreprocessAEStage>(parent, name, std::move(features), scaling_file);
+
+    FusedStageBuilder::register_node(parent, stage);
+
+    return stage;
+}
+}  // namespace morpheus
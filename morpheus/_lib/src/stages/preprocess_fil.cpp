@@ -18,30 +18,64 @@
 #include <morpheus/stages/preprocess_fil.hpp>
 
 #include <morpheus/messages/memory/inference_memory_fil.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/utilities/cuda_graph.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
 #include <morpheus/utilities/matx_util.hpp>
 #include <morpheus/utilities/type_util.hpp>
 #include <morpheus/utilities/type_util_detail.hpp>
 
 #include <neo/core/segment.hpp>
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
 #include <pyneo/node.hpp>
 
 #include <http_client.h>
 #include <librdkafka/rdkafkacpp.h>
-#include <pybind11/gil.h>
-#include <pybind11/pytypes.h>
+#include <cudf/column/column.hpp>
 #include <cudf/detail/utilities/vector_factories.hpp>
 #include <cudf/io/json.hpp>
+#include <cudf/replace.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/strings/convert/convert_floats.hpp>
+#include <cudf/strings/extract.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <cudf/table/table.hpp>
 #include <cudf/types.hpp>
-#include <cudf/unary.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
 
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <limits>
 #include <memory>
 #include <mutex>
 #include <utility>
 
 namespace morpheus {
+// Component-private free functions.
+/**
+ * @brief Equivalent of `.str.extract(r"(\d+)").astype("float32")` in the Python stage. Rows without a number are NaN.
+ */
+std::unique_ptr<cudf::column> PreprocessFILStage__parse_numbers(const cudf::column_view &column)
+{
+    MORPHEUS_DEVICE_RANGE("PreprocessFILStage::parse_numbers");
+
+    auto extracted = cudf::strings::extract(cudf::strings_column_view{column}, R"((\d+))");
+
+    auto parsed = cudf::strings::to_floats(cudf::strings_column_view{extracted->get_column(0).view()},
+                                           cudf::data_type{cudf::type_id::FLOAT32});
+
+    if (parsed->has_nulls())
+    {
+        return cudf::replace_nulls(parsed->view(),
+                                   cudf::numeric_scalar<float>(std::numeric_limits<float>::quiet_NaN()));
+    }
+
+    return parsed;
+}
+
 // Component public implementations
 // ************ PreprocessFILStage ************************* //
 PreprocessFILStage::PreprocessFILStage(const neo::Segment &parent,
@@ -49,7 +83,9 @@ PreprocessFILStage::PreprocessFILStage(const neo::Segment &parent,
                                        const std::vector<std::string> &features) :
   neo::SegmentObject(parent, name),
   PythonNode(parent, name, build_operator()),
-  m_fea_cols(std::move(features))
+  m_fea_cols(std::move(features)),
+  m_graphs(std::make_shared<CudaGraphCache>()),
+  m_metrics(StageMetrics::get(name))
 {}
 
 PreprocessFILStage::operator_fn_t PreprocessFILStage::build_operator()
@@ -57,84 +93,58 @@ PreprocessFILStage::operator_fn_t PreprocessFILStage::build_operator()
     return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
         return input.subscribe(neo::make_observer<reader_type_t>(
             [this, &output](reader_type_t &&x) {
+                DeviceMemory::ScopedTag memory_tag("PreprocessFILStage");
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
                 // TODO(MDD): Add some sort of lock here to prevent fixing columns after they have been accessed
                 auto df_meta           = x->get_meta(m_fea_cols);
                 auto df_meta_col_names = df_meta.get_column_names();
 
-                auto packed_data = std::make_shared<rmm::device_buffer>(
-                    m_fea_cols.size() * x->mess_count * sizeof(float), rmm::cuda_stream_per_thread);
-
-                std::vector<std::string> bad_cols;
-
                 auto df_just_features = df_meta.get_view();
 
-                for (size_t i = 0; i < df_meta.num_columns(); ++i)
-                {
-                    if (df_just_features.column(df_meta.num_indices() + i).type().id() == cudf::type_id::STRING)
-                    {
-                        bad_cols.push_back(df_meta_col_names[i]);
-                    }
-                }
+                // Holds columns parsed from strings until they have been packed
+                std::vector<std::unique_ptr<cudf::column>> parsed_cols;
+                std::vector<cudf::column_view> feature_cols;
 
-                // Need to ensure all string columns have been converted to numbers. This requires running a
-                // regex which is too difficult to do from C++ at this time. So grab the GIL, make the
-                // conversions, and release. This is horribly inefficient, but so is the JSON lines format for
-                // this workflow
-                if (!bad_cols.empty())
+                for (size_t i = 0; i < df_meta.num_columns(); ++i)
                 {
-                    using namespace pybind11::literals;
-                    pybind11::gil_scoped_acquire gil;
-
-                    pybind11::object df = x->meta->get_py_table();
-
-                    std::string regex = R"((\d+))";
+                    auto curr_col = df_just_features.column(df_meta.num_indices() + i);
 
-                    for (auto c : bad_cols)
+                    // Parse the numbers out of string columns on the device. Only the packed copy is affected, the
+                    // message itself is left unchanged, same as the Python stage
+                    if (curr_col.type().id() == cudf::type_id::STRING)
                     {
-                        df[pybind11::str(c)] = df[pybind11::str(c)]
-                                                   .attr("str")
-                                                   .attr("extract")(pybind11::str(regex), "expand"_a = true)
-                                                   .attr("astype")(pybind11::str("float32"));
+                        parsed_cols.emplace_back(PreprocessFILStage__parse_numbers(curr_col));
+                        curr_col = parsed_cols.back()->view();
                     }
 
-                    // Now re-get the meta
-                    df_meta          = x->get_meta(m_fea_cols);
-                    df_just_features = df_meta.get_view();
+                    feature_cols.push_back(curr_col);
                 }
 
-                for (size_t i = 0; i < df_meta.num_columns(); ++i)
-                {
-                    auto curr_col = df_just_features.column(df_meta.num_indices() + i);
+                std::size_t rows = x->mess_count;
+                std::size_t cols = feature_cols.size();
 
-                    auto curr_ptr = static_cast<float *>(packed_data->data()) + i * df_just_features.num_rows();
+                // Allocated up front, a graph replay writes to the outputs named in its arguments
+                auto packed =
+                    std::make_shared<rmm::device_buffer>(rows * cols * sizeof(float), rmm::cuda_stream_per_thread);
+                auto seg_ids_buffer =
+                    std::make_shared<rmm::device_buffer>(rows * 3 * sizeof(uint32_t), rmm::cuda_stream_per_thread);
 
-                    // Check if we are something other than float
-                    if (curr_col.type().id() != cudf::type_id::FLOAT32)
-                    {
-                        auto float_data = cudf::cast(curr_col, cudf::data_type(cudf::type_id::FLOAT32))->release();
+                auto packed_data  = static_cast<float *>(packed->data());
+                auto seg_ids_data = static_cast<uint32_t *>(seg_ids_buffer->data());
 
-                        // Do the copy here before it goes out of scope
-                        NEO_CHECK_CUDA(cudaMemcpy(curr_ptr,
-                                                  float_data.data->data(),
-                                                  df_just_features.num_rows() * sizeof(float),
-                                                  cudaMemcpyDeviceToDevice));
-                    }
-                    else
-                    {
-                        NEO_CHECK_CUDA(cudaMemcpy(curr_ptr,
-                                                  curr_col.data<float>(),
-                                                  df_just_features.num_rows() * sizeof(float),
-                                                  cudaMemcpyDeviceToDevice));
-                    }
-                }
+                // Casts and writes the features row-major and builds the seq ids in a single launch. The launch only
+                // depends on the shape, so it is replayed as a CUDA Graph when enabled
+                m_graphs->run({static_cast<int64_t>(rows), static_cast<int64_t>(cols)},
+                              MatxUtil::pack_features_args(feature_cols, {}, {}, packed_data, seg_ids_data),
+                              [rows, cols](rmm::cuda_stream_view stream, const void *device_args) {
+                                  MatxUtil::pack_features(device_args, rows, cols, stream);
+                              });
 
-                // Need to do a transpose here
-                auto transposed_data =
-                    MatxUtil::transpose(DevMemInfo{x->mess_count * m_fea_cols.size(), TypeId::FLOAT32, packed_data, 0},
-                                        m_fea_cols.size(),
-                                        x->mess_count);
+                // The parsed columns are freed when leaving this scope
+                NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
 
-                auto input__0 = Tensor::create(transposed_data,
+                auto input__0 = Tensor::create(std::move(packed),
                                                DType::create<float>(),
                                                std::vector<TensorIndex>{static_cast<long long>(x->mess_count),
                                                                         static_cast<int>(m_fea_cols.size())},
@@ -142,7 +152,7 @@ PreprocessFILStage::operator_fn_t PreprocessFILStage::build_operator()
                                                0);
 
                 auto seg_ids =
-                    Tensor::create(MatxUtil::create_seg_ids(x->mess_count, m_fea_cols.size(), TypeId::UINT32),
+                    Tensor::create(std::move(seg_ids_buffer),
                                    DType::create<uint32_t>(),
                                    std::vector<TensorIndex>{static_cast<long long>(x->mess_count), static_cast<int>(3)},
                                    std::vector<TensorIndex>{},
@@ -154,7 +164,7 @@ PreprocessFILStage::operator_fn_t PreprocessFILStage::build_operator()
                 auto next = std::make_shared<MultiInferenceMessage>(
                     x->meta, x->mess_offset, x->mess_count, std::move(memory), 0, memory->count);
 
-                output.on_next(std::move(next));
+                metrics_scope.emit(output, std::move(next));
             },
             [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
             [&]() { output.on_completed(); }));
@@ -168,7 +178,7 @@ std::shared_ptr<PreprocessFILStage> PreprocessFILStageInterfaceProxy::init(neo::
 {
     auto stage = std::make_shared<PreprocessFILStage>(parent, name, features);
 
-    parent.register_node<PreprocessFILStage>(stage);
+    FusedStageBuilder::register_node(parent, stage);
 
     return stage;
 }
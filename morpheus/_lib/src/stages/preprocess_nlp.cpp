@@ -18,14 +18,19 @@
 #include <morpheus/stages/preprocess_nlp.hpp>
 
 #include <morpheus/messages/multi_inference.hpp>
+#include <morpheus/objects/dev_mem_info.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/matx_util.hpp>
 #include <morpheus/utilities/type_util.hpp>
+#include <morpheus/utilities/vocabulary_cache.hpp>
 
 #include <neo/core/segment.hpp>
 #include <pyneo/node.hpp>
 
 #include <librdkafka/rdkafkacpp.h>
 #include <cudf/types.hpp>
-#include <cudf/unary.hpp>
 #include <nvtext/subword_tokenize.hpp>
 
 #include <cstdint>
@@ -52,7 +57,9 @@ PreprocessNLPStage::PreprocessNLPStage(const neo::Segment &parent,
   m_truncation(truncation),
   m_do_lower_case(do_lower_case),
   m_add_special_token(add_special_token),
-  m_stride(stride)
+  m_stride(stride),
+  m_vocab(VocabularyCache::get(m_vocab_hash_file)),
+  m_metrics(StageMetrics::get(name))
 {}
 
 PreprocessNLPStage::operator_fn_t PreprocessNLPStage::build_operator()
@@ -69,62 +76,54 @@ PreprocessNLPStage::operator_fn_t PreprocessNLPStage::build_operator()
 
         return input.subscribe(neo::make_observer<reader_type_t>(
             [this, stride, &output](reader_type_t &&x) {
+                DeviceMemory::ScopedTag memory_tag("PreprocessNLPStage");
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
                 // Convert to string view
                 auto string_col = cudf::strings_column_view{x->get_meta("data").get_column(0)};
 
-                // Create the hashed vocab
-                thread_local std::unique_ptr<nvtext::hashed_vocabulary> vocab =
-                    nvtext::load_vocabulary_file(this->m_vocab_hash_file);
-
                 // Perform the tokenizer
-                auto token_results = nvtext::subword_tokenize(string_col,
-                                                              *vocab,
-                                                              this->m_sequence_length,
-                                                              stride,
-                                                              this->m_do_lower_case,
-                                                              this->m_truncation,
-                                                              string_col.size() * 2);
+                auto token_results = [&]() {
+                    MORPHEUS_DEVICE_RANGE("PreprocessNLPStage::subword_tokenize");
+
+                    return nvtext::subword_tokenize(string_col,
+                                                    *this->m_vocab,
+                                                    this->m_sequence_length,
+                                                    stride,
+                                                    this->m_do_lower_case,
+                                                    this->m_truncation,
+                                                    string_col.size() * 2);
+                }();
 
                 // Build the results
                 auto memory = std::make_shared<InferenceMemory>(token_results.nrows_tensor);
 
-                int32_t length = token_results.tensor_token_ids->size() / token_results.sequence_length;
-                auto input_ids_released =
-                    cudf::cast(token_results.tensor_token_ids->view(), cudf::data_type(cudf::type_id::INT32))
-                        ->release();
-
-                memory->inputs["input_ids"] = std::move(
-                    Tensor::create(std::move(input_ids_released.data),
-                                   DType::create<int32_t>(),
-                                   std::vector<TensorIndex>{length, static_cast<int>(token_results.sequence_length)},
-                                   std::vector<TensorIndex>{},
-                                   0));
-
-                length = token_results.tensor_attention_mask->size() / token_results.sequence_length;
-                auto input_mask_released =
-                    cudf::cast(token_results.tensor_attention_mask->view(), cudf::data_type(cudf::type_id::INT32))
-                        ->release();
-                memory->inputs["input_mask"] = std::move(
-                    Tensor::create(std::move(input_mask_released.data),
-                                   DType::create<int32_t>(),
-                                   std::vector<TensorIndex>{length, static_cast<int>(token_results.sequence_length)},
-                                   std::vector<TensorIndex>{},
-                                   0));
-
-                length = token_results.tensor_metadata->size() / 3;
-                auto seq_ids_released =
-                    cudf::cast(token_results.tensor_metadata->view(), cudf::data_type(cudf::type_id::INT32))->release();
-                memory->inputs["seq_ids"] =
-                    std::move(Tensor::create(std::move(seq_ids_released.data),
-                                             DType::create<int32_t>(),
-                                             std::vector<TensorIndex>{length, static_cast<int32_t>(3)},
-                                             std::vector<TensorIndex>{},
-                                             0));
+                // Narrow all three outputs from uint32 with one kernel, into one allocation
+                auto narrowed = MatxUtil::narrow_to_int32({token_results.tensor_token_ids->view(),
+                                                           token_results.tensor_attention_mask->view(),
+                                                           token_results.tensor_metadata->view()});
+
+                auto make_tensor = [](const DevMemInfo &info, TensorIndex columns) {
+                    const auto rows = static_cast<TensorIndex>(info.element_count) / columns;
+
+                    // Tensor offsets are in elements
+                    return Tensor::create(info.buffer,
+                                          DType::create<int32_t>(),
+                                          std::vector<TensorIndex>{rows, columns},
+                                          std::vector<TensorIndex>{},
+                                          info.offset / sizeof(int32_t));
+                };
+
+                const auto sequence_length = static_cast<TensorIndex>(token_results.sequence_length);
+
+                memory->inputs["input_ids"]  = make_tensor(narrowed[0], sequence_length);
+                memory->inputs["input_mask"] = make_tensor(narrowed[1], sequence_length);
+                memory->inputs["seq_ids"]    = make_tensor(narrowed[2], 3);
 
                 auto next = std::make_shared<MultiInferenceMessage>(
                     x->meta, x->mess_offset, x->mess_count, std::move(memory), 0, memory->count);
 
-                output.on_next(std::move(next));
+                metrics_scope.emit(output, std::move(next));
             },
             [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
             [&]() { output.on_completed(); }));
@@ -144,7 +143,7 @@ std::shared_ptr<PreprocessNLPStage> PreprocessNLPStageInterfaceProxy::init(neo::
     auto stage = std::make_shared<PreprocessNLPStage>(
         parent, name, vocab_hash_file, sequence_length, truncation, do_lower_case, add_special_token, stride);
 
-    parent.register_node<PreprocessNLPStage>(stage);
+    FusedStageBuilder::register_node(parent, stage);
 
     return stage;
 }
@@ -0,0 +1,286 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/repartition.hpp>
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <neo/core/segment_object.hpp>
+
+#include <cudf/binaryop.hpp>
+#include <cudf/column/column.hpp>
+#include <cudf/hashing.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/partitioning.hpp>
+#include <cudf/reduction.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/types.hpp>
+
+#include <boost/fiber/channel_op_status.hpp>
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ RepartitionStage__ShardWriter ************ //
+/**
+ * @brief Lets `StageMetrics` emit into the queue of a shard like it emits into the output of the stage.
+ */
+struct RepartitionStage__ShardWriter
+{
+    RepartitionStage::shard_channel_t &channel;
+
+    void on_next(std::shared_ptr<MultiMessage> &&message)
+    {
+        // Blocks while the shard is behind. Only closed once the input completed
+        channel.push(std::move(message));
+    }
+};
+
+// Component-private free functions.
+/**
+ * @brief Splits `message` into one message per shard its rows fall in, paired with their shard.
+ */
+std::vector<std::pair<std::size_t, std::shared_ptr<MultiMessage>>> RepartitionStage__split(
+    const std::shared_ptr<MultiMessage> &message, const std::string &key_column, std::size_t num_shards)
+{
+    auto info    = message->get_meta();
+    auto key_idx = info.get_schema()->find_column(key_column);
+
+    if (key_idx < 0)
+    {
+        throw std::runtime_error("RepartitionStage could not find the key column '" + key_column + "'");
+    }
+
+    const auto &view = info.get_view();
+
+    MORPHEUS_DEVICE_RANGE("RepartitionStage::split");
+
+    // Nulls all hash to the same value, so they share a shard
+    auto hashes = cudf::hash(cudf::table_view({view.column(info.num_indices() + key_idx)}));
+
+    auto shard_map = cudf::binary_operation(hashes->view(),
+                                            cudf::numeric_scalar<int32_t>(num_shards),
+                                            cudf::binary_operator::PMOD,
+                                            cudf::data_type{cudf::type_id::INT32});
+
+    auto [min_shard, max_shard] = cudf::minmax(shard_map->view());
+
+    auto first_shard = static_cast<cudf::numeric_scalar<int32_t> &>(*min_shard).value();
+    auto last_shard  = static_cast<cudf::numeric_scalar<int32_t> &>(*max_shard).value();
+
+    if (first_shard == last_shard)
+    {
+        // Common with few keys per message, nothing to regroup
+        return {{static_cast<std::size_t>(first_shard), message}};
+    }
+
+    // Unlike `cudf::hash_partition`, rows keep their relative order within each partition
+    auto [partitioned, offsets] = cudf::partition(view, shard_map->view(), static_cast<cudf::size_type>(num_shards));
+
+    const auto num_rows = partitioned->num_rows();
+
+    // Same layout as SerializeStage, index columns first
+    auto column_names = info.get_index_names();
+    auto data_columns = info.get_column_names();
+    column_names.insert(column_names.end(), data_columns.begin(), data_columns.end());
+
+    cudf::io::table_with_metadata table{std::move(partitioned), cudf::io::table_metadata{}};
+    table.metadata.column_names = std::move(column_names);
+
+    auto meta = MessageMeta::create_from_cpp(std::move(table), info.num_indices());
+
+    meta->inherit_completions(*message->meta);
+
+    std::vector<std::pair<std::size_t, std::shared_ptr<MultiMessage>>> shard_messages;
+
+    for (std::size_t shard = 0; shard < offsets.size(); ++shard)
+    {
+        auto start = offsets[shard];
+        auto stop  = shard + 1 < offsets.size() ? offsets[shard + 1] : num_rows;
+
+        if (stop > start)
+        {
+            shard_messages.emplace_back(shard, std::make_shared<MultiMessage>(meta, start, stop - start));
+        }
+    }
+
+    return shard_messages;
+}
+
+// Component public implementations
+// ************ RepartitionStage **************************** //
+RepartitionStage::RepartitionStage(const neo::Segment &parent,
+                                   const std::string &name,
+                                   std::string key_column,
+                                   std::size_t num_shards,
+                                   std::size_t shard_queue_size) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_key_column(std::move(key_column)),
+  m_num_shards(num_shards),
+  m_metrics(StageMetrics::get(name))
+{
+    if (m_num_shards == 0)
+    {
+        throw std::invalid_argument("RepartitionStage num_shards must be greater than 0");
+    }
+
+    if (shard_queue_size < 2 || (shard_queue_size & (shard_queue_size - 1)) != 0)
+    {
+        throw std::invalid_argument("RepartitionStage shard_queue_size must be a power of 2 greater than 1");
+    }
+
+    // Shard 0 is the output of the stage itself
+    for (std::size_t shard = 1; shard < m_num_shards; ++shard)
+    {
+        m_shard_channels.emplace_back(std::make_unique<shard_channel_t>(shard_queue_size));
+    }
+}
+
+std::size_t RepartitionStage::num_shards() const
+{
+    return m_num_shards;
+}
+
+RepartitionStage::shard_channel_t &RepartitionStage::shard_channel(std::size_t shard)
+{
+    CHECK(shard > 0 && shard < m_num_shards) << "RepartitionStage has no shard " << shard << " queue";
+
+    return *m_shard_channels[shard - 1];
+}
+
+void RepartitionStage::close_shards()
+{
+    for (auto &channel : m_shard_channels)
+    {
+        channel->close();
+    }
+}
+
+RepartitionStage::operator_fn_t RepartitionStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output](reader_type_t &&x) {
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                if (m_num_shards == 1)
+                {
+                    metrics_scope.emit(output, std::move(x));
+                    return;
+                }
+
+                DeviceMemory::ScopedTag memory_tag("RepartitionStage");
+
+                for (auto &[shard, message] : RepartitionStage__split(x, m_key_column, m_num_shards))
+                {
+                    if (shard == 0)
+                    {
+                        metrics_scope.emit(output, std::move(message));
+                    }
+                    else
+                    {
+                        RepartitionStage__ShardWriter writer{this->shard_channel(shard)};
+                        metrics_scope.emit(writer, std::move(message));
+                    }
+                }
+            },
+            [this, &output](std::exception_ptr error_ptr) {
+                this->close_shards();
+
+                output.on_error(error_ptr);
+            },
+            [this, &output]() {
+                this->close_shards();
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ RepartitionShardSource ********************** //
+RepartitionShardSource::RepartitionShardSource(const neo::Segment &parent,
+                                               const std::string &name,
+                                               std::shared_ptr<RepartitionStage> stage,
+                                               std::size_t shard) :
+  neo::SegmentObject(parent, name),
+  base_t(parent, name),
+  m_stage(std::move(stage)),
+  m_shard(shard)
+{
+    if (m_shard == 0 || m_shard >= m_stage->num_shards())
+    {
+        throw std::invalid_argument("RepartitionShardSource shard must be between 1 and " +
+                                    std::to_string(m_stage->num_shards() - 1));
+    }
+
+    this->set_source_observable(neo::Observable<source_type_t>([this](neo::Subscriber<source_type_t> &sub) {
+        auto &channel = m_stage->shard_channel(m_shard);
+
+        std::shared_ptr<MultiMessage> message;
+
+        // Yields the fiber while the queue is empty
+        while (sub.is_subscribed() && channel.pop(message) == boost::fibers::channel_op_status::success)
+        {
+            sub.on_next(std::move(message));
+        }
+
+        sub.on_completed();
+    }));
+}
+
+// ************ RepartitionStageInterfaceProxy ************* //
+std::shared_ptr<RepartitionStage> RepartitionStageInterfaceProxy::init(neo::Segment &parent,
+                                                                       const std::string &name,
+                                                                       std::string key_column,
+                                                                       std::size_t num_shards,
+                                                                       std::size_t shard_queue_size)
+{
+    auto stage =
+        std::make_shared<RepartitionStage>(parent, name, std::move(key_column), num_shards, shard_queue_size);
+
+    parent.register_node<RepartitionStage>(stage);
+
+    return stage;
+}
+
+// ************ RepartitionShardSourceInterfaceProxy ******* //
+std::shared_ptr<RepartitionShardSource> RepartitionShardSourceInterfaceProxy::init(
+    neo::Segment &parent, const std::string &name, std::shared_ptr<RepartitionStage> stage, std::size_t shard)
+{
+    auto source = std::make_shared<RepartitionShardSource>(parent, name, std::move(stage), shard);
+
+    parent.register_node<RepartitionShardSource>(source);
+
+    return source;
+}
+}  // namespace morpheus
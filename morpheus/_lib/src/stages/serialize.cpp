@@ -17,9 +17,16 @@
 
 #include <morpheus/stages/serialize.hpp>
 
+#include <morpheus/stages/fused.hpp>
+
+#include <cstddef>
 #include <exception>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace morpheus {
 
@@ -28,16 +35,32 @@ namespace morpheus {
     constexpr std::regex_constants::syntax_option_type RegexOptions =
             std::regex_constants::ECMAScript | std::regex_constants::icase;
 
+    // Feeds with more distinct schemas than this start over rather than growing the cache without bound
+    constexpr std::size_t SerializeStageMaxColumnPlans = 256;
+
+    static std::size_t SerializeStage__fingerprint(const std::vector<std::string> &column_names) {
+        std::size_t seed = column_names.size();
+
+        for (const auto &name: column_names) {
+            seed ^= std::hash<std::string>{}(name) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        }
+
+        return seed;
+    }
+
 // Component public implementations
 // ************ WriteToFileStage **************************** //
     SerializeStage::SerializeStage(const neo::Segment &parent,
                                    const std::string &name,
                                    const std::vector<std::string> &include,
                                    const std::vector<std::string> &exclude,
-                                   bool fixed_columns) :
+                                   bool fixed_columns,
+                                   double compact_fraction) :
             neo::SegmentObject(parent, name),
             PythonNode(parent, name, build_operator()),
-            m_fixed_columns{fixed_columns} {
+            m_fixed_columns{fixed_columns},
+            m_compact_fraction{compact_fraction},
+            m_metrics(StageMetrics::get(name)) {
         make_regex_objs(include, m_include);
         make_regex_objs(exclude, m_exclude);
     }
@@ -71,12 +94,22 @@ namespace morpheus {
     }
 
     TableInfo SerializeStage::get_meta(reader_type_t &msg) {
+        if (!m_fixed_columns) {
+            auto info = msg->meta->get_info();
+
+            return info.get_slice(msg->mess_offset,
+                                  msg->mess_offset + msg->mess_count,
+                                  this->column_plan(info.get_column_names()));
+        }
+
         // If none of the columns match the include regex patterns or are all are excluded this has the effect
         // of including all of the rows since calling msg->get_meta({}) will return a view with all columns.
         // The Python impl appears to have the same behavior.
-        if (!m_fixed_columns || m_column_names.empty()) {
-            m_column_names.clear();
-            for (const auto &c: msg->get_meta().get_column_names()) {
+        if (m_column_names.empty()) {
+            // Keep the view alive, the names are only borrowed from it
+            auto info = msg->get_meta();
+
+            for (const auto &c: info.get_column_names()) {
                 if (include_column(c) && !exclude_column(c)) {
                     m_column_names.push_back(c);
                 }
@@ -86,18 +119,60 @@ namespace morpheus {
         return msg->get_meta(m_column_names);
     }
 
+    std::vector<cudf::size_type> SerializeStage::column_plan(const std::vector<std::string> &column_names) {
+        const auto fingerprint = SerializeStage__fingerprint(column_names);
+
+        std::lock_guard<std::mutex> lock(m_column_plans_mutex);
+
+        auto found = m_column_plans.find(fingerprint);
+
+        if (found != m_column_plans.end() && found->second.column_names == column_names) {
+            return found->second.column_indices;
+        }
+
+        ColumnPlan plan{column_names, {}};
+
+        for (cudf::size_type i = 0; i < column_names.size(); ++i) {
+            if (include_column(column_names[i]) && !exclude_column(column_names[i])) {
+                plan.column_indices.push_back(i);
+            }
+        }
+
+        // Same as the fixed columns case, selecting nothing selects every column
+        if (plan.column_indices.empty()) {
+            for (cudf::size_type i = 0; i < column_names.size(); ++i) {
+                plan.column_indices.push_back(i);
+            }
+        }
+
+        if (m_column_plans.size() >= SerializeStageMaxColumnPlans) {
+            m_column_plans.clear();
+        }
+
+        auto column_indices = plan.column_indices;
+
+        m_column_plans[fingerprint] = std::move(plan);
+
+        return column_indices;
+    }
+
     neo::pyneo::PythonNode<std::shared_ptr<MultiMessage>, std::shared_ptr<MessageMeta>>::operator_fn_t
     SerializeStage::build_operator() {
         return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
             return input.subscribe(neo::make_observer<reader_type_t>(
                     [this, &output](reader_type_t &&msg) {
-                        auto table_info = this->get_meta(msg);
-                        std::shared_ptr<MessageMeta> meta;
-                        {
-                            pybind11::gil_scoped_acquire gil;
-                            meta = MessageMeta::create_from_python(std::move(table_info.as_py_object()));
-                        }
-                        output.on_next(std::move(meta));
+                        StageMetrics::Scope metrics_scope(*m_metrics, msg);
+
+                        // A view of the selected rows & columns, nothing is copied unless a downstream Python stage
+                        // asks for the DataFrame. The C++ writers read the view directly
+                        auto meta = MessageMeta::create_from_view(this->get_meta(msg));
+                        meta->inherit_completions(*msg->meta);
+
+                        // Unless the view only holds a small part of the table, which would otherwise be kept alive
+                        // by the writers
+                        meta = MessageMeta::compact_if_sparse(meta, m_compact_fraction);
+
+                        metrics_scope.emit(output, std::move(meta));
                     },
                     [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
                     [&]() { output.on_completed(); }));
@@ -109,10 +184,12 @@ namespace morpheus {
                                                                        const std::string &name,
                                                                        const std::vector<std::string> &include,
                                                                        const std::vector<std::string> &exclude,
-                                                                       bool fixed_columns) {
-        auto stage = std::make_shared<SerializeStage>(parent, name, include, exclude, fixed_columns);
+                                                                       bool fixed_columns,
+                                                                       double compact_fraction) {
+        auto stage =
+                std::make_shared<SerializeStage>(parent, name, include, exclude, fixed_columns, compact_fraction);
 
-        parent.register_node<SerializeStage>(stage);
+        FusedStageBuilder::register_node(parent, stage);
 
         return stage;
     }
@@ -0,0 +1,545 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/timeseries.hpp>
+
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/objects/tensor.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
+
+#include <neo/core/segment_object.hpp>
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cudf/column/column_view.hpp>
+#include <cudf/copying.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/types.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ TimeSeriesStage__User ************ //
+/**
+ * @brief A message waiting for the events following it, along with the bin of each of its rows.
+ */
+struct TimeSeriesStage__Pending
+{
+    std::shared_ptr<MultiResponseMessage> message;
+    std::shared_ptr<rmm::device_buffer> row_bins;
+    int32_t first_bin;
+    int32_t last_bin;
+};
+
+/**
+ * @brief Time series of a single user. Event counts live in a ring on the device, see `TimeSeriesWindow`. Slots of
+ * bins outside of `[lo, hi]` are always zero so the ring can be extended in either direction without clearing it.
+ */
+struct TimeSeriesStage__User
+{
+    std::deque<TimeSeriesStage__Pending> pending;
+
+    std::unique_ptr<rmm::device_buffer> counts;
+    std::size_t capacity{0};
+    int32_t lo{0};
+    int32_t hi{-1};
+
+    // Bins below this one may not have been cleared yet, they always are once `on_next` returns
+    int32_t cleared_lo{0};
+
+    bool has_data{false};
+    int64_t t0_sec{0};
+    int32_t series_start{0};
+    int32_t series_end{0};
+    bool is_warm{false};
+};
+
+/**
+ * @brief A window whose outliers must be calculated before `pending.message` is sent.
+ */
+struct TimeSeriesStage__Calc
+{
+    TimeSeriesStage__Pending pending;
+    TimeSeriesWindow window;
+    std::size_t length;
+};
+
+struct TimeSeriesStage__State
+{
+    std::map<std::string, std::size_t> user_index;
+    std::vector<std::unique_ptr<TimeSeriesStage__User>> users;  // First seen first, the order of the flush
+};
+
+// Component-private free functions.
+const std::string TimeSeriesStage__TimestampColumn = "event_dt";
+const std::string TimeSeriesStage__AnomalyColumn   = "ts_anomaly";
+
+int64_t TimeSeriesStage__ticks_per_second(const cudf::data_type &type)
+{
+    switch (type.id())
+    {
+    case cudf::type_id::TIMESTAMP_SECONDS:
+        return 1;
+    case cudf::type_id::TIMESTAMP_MILLISECONDS:
+        return 1'000;
+    case cudf::type_id::TIMESTAMP_MICROSECONDS:
+        return 1'000'000;
+    case cudf::type_id::TIMESTAMP_NANOSECONDS:
+        return 1'000'000'000;
+    default:
+        throw std::invalid_argument("TimeSeriesStage requires the '" + TimeSeriesStage__TimestampColumn +
+                                    "' column to be a timestamp");
+    }
+}
+
+int64_t TimeSeriesStage__floor_div(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+std::string TimeSeriesStage__user_id(MultiResponseMessage &x, const std::string &user_column)
+{
+    if (user_column.empty())
+    {
+        return std::string();
+    }
+
+    auto info    = x.get_meta(user_column);
+    auto &column = info.get_column(0);
+
+    if (column.type().id() != cudf::type_id::STRING)
+    {
+        throw std::invalid_argument("TimeSeriesStage requires the '" + user_column + "' column to be a string");
+    }
+
+    auto scalar = cudf::get_element(column, 0);
+
+    return static_cast<cudf::string_scalar &>(*scalar).to_string();
+}
+
+std::unique_ptr<rmm::device_buffer> TimeSeriesStage__zeros(std::size_t bytes)
+{
+    auto buffer = std::make_unique<rmm::device_buffer>(bytes, rmm::cuda_stream_per_thread);
+
+    NEO_CHECK_CUDA(cudaMemsetAsync(buffer->data(), 0, bytes, rmm::cuda_stream_per_thread.value()));
+
+    return buffer;
+}
+
+/**
+ * @brief Makes room in the ring for bins `[lo, hi]`. Growing moves every bin to its slot in the larger ring, which
+ * takes a round trip through the host but only happens a logarithmic number of times.
+ */
+void TimeSeriesStage__reserve(TimeSeriesStage__User &user, int32_t lo, int32_t hi)
+{
+    const auto needed = static_cast<std::size_t>(hi - lo + 1);
+
+    if (hi < lo || needed <= user.capacity)
+    {
+        return;
+    }
+
+    const auto capacity = std::max<std::size_t>({needed, 2 * user.capacity, 256});
+
+    auto counts = TimeSeriesStage__zeros(capacity * sizeof(int32_t));
+
+    if (user.counts && user.hi >= user.lo)
+    {
+        std::vector<int32_t> old_ring(user.capacity);
+        std::vector<int32_t> new_ring(capacity, 0);
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(old_ring.data(),
+                                       user.counts->data(),
+                                       user.counts->size(),
+                                       cudaMemcpyDeviceToHost,
+                                       rmm::cuda_stream_per_thread.value()));
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread.value()));
+
+        auto slot = [](int32_t bin, std::size_t size) {
+            auto c = static_cast<int64_t>(size);
+            return static_cast<std::size_t>(((bin % c) + c) % c);
+        };
+
+        for (int32_t bin = user.lo; bin <= user.hi; ++bin)
+        {
+            new_ring[slot(bin, capacity)] = old_ring[slot(bin, user.capacity)];
+        }
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(counts->data(),
+                                       new_ring.data(),
+                                       counts->size(),
+                                       cudaMemcpyHostToDevice,
+                                       rmm::cuda_stream_per_thread.value()));
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread.value()));
+    }
+
+    user.counts   = std::move(counts);
+    user.capacity = capacity;
+}
+
+/**
+ * @brief Zeroes the slots of the bins dropped since the last call, keeping the ring free of stale counts.
+ */
+void TimeSeriesStage__clear_dropped(TimeSeriesStage__User &user)
+{
+    const int32_t stop = std::min(user.lo, user.hi + 1);
+
+    if (user.counts && stop > user.cleared_lo)
+    {
+        const auto count = std::min<std::size_t>(static_cast<std::size_t>(stop - user.cleared_lo), user.capacity);
+        const auto c     = static_cast<int64_t>(user.capacity);
+        const auto first = static_cast<std::size_t>(((user.cleared_lo % c) + c) % c);
+
+        // At most two runs, when the bins wrap around the end of the ring
+        const auto head = std::min(count, user.capacity - first);
+        auto *counts    = static_cast<int32_t *>(user.counts->data());
+
+        NEO_CHECK_CUDA(cudaMemsetAsync(
+            counts + first, 0, head * sizeof(int32_t), rmm::cuda_stream_per_thread.value()));
+        NEO_CHECK_CUDA(cudaMemsetAsync(
+            counts, 0, (count - head) * sizeof(int32_t), rmm::cuda_stream_per_thread.value()));
+    }
+
+    user.cleared_lo = user.lo;
+}
+
+/**
+ * @brief Bins the rows of `x` and adds them to the counts of `user`. Every row starts as not anomalous.
+ */
+TimeSeriesStage__Pending TimeSeriesStage__add_message(TimeSeriesStage__User &user,
+                                                      std::shared_ptr<MultiResponseMessage> x,
+                                                      int64_t resolution_sec)
+{
+    const auto rows = x->mess_count;
+
+    x->set_meta(TimeSeriesStage__AnomalyColumn,
+                Tensor::create(TimeSeriesStage__zeros(rows * sizeof(bool)),
+                               DType(TypeId::BOOL8),
+                               std::vector<TensorIndex>{static_cast<TensorIndex>(rows), 1},
+                               std::vector<TensorIndex>{},
+                               0));
+
+    auto info    = x->get_meta(TimeSeriesStage__TimestampColumn);
+    auto &column = info.get_column(0);
+
+    const auto ticks_per_second = TimeSeriesStage__ticks_per_second(column.type());
+    const auto *ticks           = column.data<int64_t>();
+
+    if (!user.has_data)
+    {
+        int64_t first_ticks = 0;
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(
+            &first_ticks, ticks, sizeof(int64_t), cudaMemcpyDeviceToHost, rmm::cuda_stream_per_thread.value()));
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread.value()));
+
+        // Floored to the day, as the Python stage
+        constexpr int64_t seconds_per_day = 24 * 60 * 60;
+        user.t0_sec = TimeSeriesStage__floor_div(TimeSeriesStage__floor_div(first_ticks, ticks_per_second),
+                                                 seconds_per_day) *
+                      seconds_per_day;
+    }
+
+    auto row_bins = std::make_shared<rmm::device_buffer>(rows * sizeof(int32_t), rmm::cuda_stream_per_thread);
+    auto *bins    = static_cast<int32_t *>(row_bins->data());
+
+    auto range = MatxUtil::time_bins(ticks, rows, ticks_per_second, user.t0_sec, resolution_sec, bins);
+
+    int32_t lo = range.min;
+    int32_t hi = range.max;
+
+    if (user.has_data)
+    {
+        // Once warm, the bins below `lo` have been dropped and late events are ignored
+        lo = user.is_warm ? user.lo : std::min(user.lo, range.min);
+        hi = std::max(user.hi, range.max);
+    }
+    else
+    {
+        user.cleared_lo   = range.min;
+        user.series_start = range.first;
+        user.has_data     = true;
+    }
+
+    // Moves the bins currently in `[user.lo, user.hi]` when the ring grows
+    TimeSeriesStage__reserve(user, lo, hi);
+
+    user.lo         = lo;
+    user.hi         = hi;
+    user.cleared_lo = std::min(user.cleared_lo, lo);
+    user.series_end = range.last;
+
+    MatxUtil::add_to_histogram(
+        bins, rows, user.lo, user.hi, static_cast<int32_t *>(user.counts->data()), user.capacity);
+
+    return TimeSeriesStage__Pending{std::move(x), std::move(row_bins), range.first, range.last};
+}
+
+/**
+ * @brief Pops every pending message of `user` which can be sent, in order, queuing the windows to calculate first
+ * into `calcs`. Follows `UserTimeSeries._determine_action` of the Python stage, except the dropped bins are only
+ * cleared once the windows have been read.
+ */
+void TimeSeriesStage__determine_actions(TimeSeriesStage__User &user,
+                                        bool is_complete,
+                                        int32_t half_window_bins,
+                                        bool cold_end,
+                                        std::vector<TimeSeriesStage__Calc> &calcs,
+                                        std::vector<std::shared_ptr<MultiResponseMessage>> &to_send)
+{
+    while (!user.pending.empty())
+    {
+        auto &front = user.pending.front();
+
+        const int32_t window_start = front.first_bin - half_window_bins;
+        const int32_t window_end   = front.last_bin + half_window_bins;
+
+        // Warming up, not enough events before the message
+        if (user.series_start > window_start && !user.is_warm && !is_complete)
+        {
+            to_send.emplace_back(std::move(front.message));
+            user.pending.pop_front();
+            continue;
+        }
+
+        user.is_warm = true;
+
+        // Not enough events after the message
+        if (user.series_end < window_end)
+        {
+            if (!is_complete)
+            {
+                return;
+            }
+
+            if (cold_end)
+            {
+                to_send.emplace_back(front.message);
+                user.pending.pop_front();
+                continue;
+            }
+        }
+
+        user.lo = std::max(user.lo, window_start);
+
+        // One bucket before the window, the histogram edges of the Python stage
+        TimeSeriesWindow window{static_cast<const int32_t *>(user.counts->data()),
+                                static_cast<int32_t>(user.capacity),
+                                user.lo,
+                                user.hi,
+                                window_start - 1};
+
+        to_send.emplace_back(front.message);
+        calcs.push_back(TimeSeriesStage__Calc{
+            std::move(front), window, static_cast<std::size_t>(window_end - window_start + 1)});
+        user.pending.pop_front();
+    }
+}
+
+/**
+ * @brief Scores every queued window, grouping those of the same length into a single batch, and writes the flags of
+ * the rows of each message.
+ */
+void TimeSeriesStage__calculate(std::vector<TimeSeriesStage__Calc> &calcs,
+                                double filter_percent,
+                                double zscore_threshold)
+{
+    std::map<std::size_t, std::vector<std::size_t>> by_length;
+
+    for (std::size_t i = 0; i < calcs.size(); ++i)
+    {
+        by_length[calcs[i].length].push_back(i);
+    }
+
+    for (const auto &[length, indices] : by_length)
+    {
+        std::vector<TimeSeriesWindow> windows;
+
+        for (auto i : indices)
+        {
+            windows.push_back(calcs[i].window);
+        }
+
+        auto signals = MatxUtil::window_signals(windows, length);
+        auto flags   = MatxUtil::fft_anomalies(
+            static_cast<const double *>(signals->data()), windows.size(), length, filter_percent, zscore_threshold);
+
+        for (std::size_t j = 0; j < indices.size(); ++j)
+        {
+            auto &calc      = calcs[indices[j]];
+            const auto rows = calc.pending.message->mess_count;
+
+            auto row_flags =
+                std::make_shared<rmm::device_buffer>(rows * sizeof(bool), rmm::cuda_stream_per_thread);
+
+            MatxUtil::flag_rows(static_cast<const int32_t *>(calc.pending.row_bins->data()),
+                                rows,
+                                static_cast<const bool *>(flags->data()) + j * length,
+                                calc.window.first_bin,
+                                length,
+                                static_cast<bool *>(row_flags->data()));
+
+            calc.pending.message->set_meta(TimeSeriesStage__AnomalyColumn,
+                                           Tensor::create(std::move(row_flags),
+                                                          DType(TypeId::BOOL8),
+                                                          std::vector<TensorIndex>{static_cast<TensorIndex>(rows), 1},
+                                                          std::vector<TensorIndex>{},
+                                                          0));
+        }
+    }
+}
+
+// Component public implementations
+// ************ TimeSeriesStage ************************** //
+TimeSeriesStage::TimeSeriesStage(const neo::Segment &parent,
+                                 const std::string &name,
+                                 int64_t resolution_sec,
+                                 double min_window_sec,
+                                 bool hot_start,
+                                 bool cold_end,
+                                 double filter_percent,
+                                 double zscore_threshold,
+                                 std::string user_column) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_resolution_sec(resolution_sec),
+  m_half_window_bins(0),
+  m_hot_start(hot_start),
+  m_cold_end(cold_end),
+  m_filter_percent(filter_percent),
+  m_zscore_threshold(zscore_threshold),
+  m_user_column(std::move(user_column)),
+  m_metrics(StageMetrics::get(name))
+{
+    CHECK(m_resolution_sec > 0) << "TimeSeriesStage resolution must be at least one second";
+
+    m_half_window_bins = static_cast<int32_t>(std::ceil(min_window_sec / m_resolution_sec));
+}
+
+TimeSeriesStage::operator_fn_t TimeSeriesStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        auto state = std::make_shared<TimeSeriesStage__State>();
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, state, &output](reader_type_t &&x) {
+                DeviceMemory::ScopedTag memory_tag("TimeSeriesStage");
+                MORPHEUS_DEVICE_RANGE("TimeSeriesStage");
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                auto user_id = TimeSeriesStage__user_id(*x, m_user_column);
+
+                auto found = state->user_index.find(user_id);
+
+                if (found == state->user_index.end())
+                {
+                    found = state->user_index.emplace(user_id, state->users.size()).first;
+
+                    state->users.emplace_back(std::make_unique<TimeSeriesStage__User>());
+                    state->users.back()->is_warm = m_hot_start;
+                }
+
+                auto &user = *state->users[found->second];
+
+                user.pending.push_back(TimeSeriesStage__add_message(user, std::move(x), m_resolution_sec));
+
+                std::vector<TimeSeriesStage__Calc> calcs;
+                std::vector<std::shared_ptr<MultiResponseMessage>> to_send;
+
+                TimeSeriesStage__determine_actions(user, false, m_half_window_bins, m_cold_end, calcs, to_send);
+                TimeSeriesStage__calculate(calcs, m_filter_percent, m_zscore_threshold);
+                TimeSeriesStage__clear_dropped(user);
+
+                for (auto &message : to_send)
+                {
+                    metrics_scope.emit(output, std::move(message));
+                }
+            },
+            [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [this, state, &output]() {
+                DeviceMemory::ScopedTag memory_tag("TimeSeriesStage");
+
+                // Every remaining window is scored in one pass over all of the users
+                std::vector<TimeSeriesStage__Calc> calcs;
+                std::vector<std::shared_ptr<MultiResponseMessage>> to_send;
+
+                for (auto &user : state->users)
+                {
+                    TimeSeriesStage__determine_actions(
+                        *user, true, m_half_window_bins, m_cold_end, calcs, to_send);
+                }
+
+                TimeSeriesStage__calculate(calcs, m_filter_percent, m_zscore_threshold);
+
+                for (auto &message : to_send)
+                {
+                    m_metrics->emit(output, std::move(message));
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ TimeSeriesStageInterfaceProxy ************ //
+std::shared_ptr<TimeSeriesStage> TimeSeriesStageInterfaceProxy::init(neo::Segment &parent,
+                                                                     const std::string &name,
+                                                                     int64_t resolution_sec,
+                                                                     double min_window_sec,
+                                                                     bool hot_start,
+                                                                     bool cold_end,
+                                                                     double filter_percent,
+                                                                     double zscore_threshold,
+                                                                     std::string user_column)
+{
+    auto stage = std::make_shared<TimeSeriesStage>(parent,
+                                                   name,
+                                                   resolution_sec,
+                                                   min_window_sec,
+                                                   hot_start,
+                                                   cold_end,
+                                                   filter_percent,
+                                                   zscore_threshold,
+                                                   std::move(user_column));
+
+    // Holds messages across calls, never fused
+    parent.register_node<TimeSeriesStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -18,7 +18,14 @@
 #include <morpheus/stages/triton_inference.hpp>
 
 #include <morpheus/messages/multi_response_probs.hpp>
+#include <morpheus/objects/tensor_cast_view.hpp>
+#include <morpheus/objects/tensor_map.hpp>
 #include <morpheus/objects/triton_in_out.hpp>
+#include <morpheus/stages/fused.hpp>
+#include <morpheus/stages/triton_inference_detail.hpp>
+#include <morpheus/utilities/device_affinity.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/host_memory.hpp>
 #include <morpheus/utilities/matx_util.hpp>
 #include <morpheus/utilities/stage_util.hpp>
 #include <morpheus/utilities/type_util.hpp>
@@ -26,307 +33,2234 @@
 #include <neo/core/segment_object.hpp>
 #include <pyneo/node.hpp>
 
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/fiber.hpp>
+#include <boost/fiber/mutex.hpp>
 #include <glog/logging.h>
+#include <grpc_client.h>
 #include <http_client.h>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <exception>
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <sstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
+
+#include <unistd.h>  // for getpid
 
 #define CHECK_TRITON(method) ::InferenceClientStage__check_triton_errors(method, #method, __FILE__, __LINE__);
 
-namespace {
-// Component-private free functions.
-void InferenceClientStage__check_triton_errors(triton::client::Error status,
-                                               const std::string &methodName,
-                                               const std::string &filename,
-                                               const int &lineNumber)
+namespace {
+// Offsets of each input/output within a shared memory region are aligned to this many bytes
+constexpr std::size_t SharedMemoryAlignment = 256;
+
+// How long a Triton server is skipped after a failed request before being health checked
+constexpr std::chrono::seconds EndpointEjectionTime{5};
+
+// Smallest sequence length sent to Triton when bucketing rows by token length
+constexpr morpheus::TensorIndex MinBucketWidth = 16;
+
+// Component-private free functions.
+void InferenceClientStage__check_triton_errors(triton::client::Error status,
+                                               const std::string &methodName,
+                                               const std::string &filename,
+                                               const int &lineNumber)
+{
+    if (!status.IsOk())
+    {
+        std::string err_msg =
+            CONCAT_STR("Triton Error while executing '" << methodName << "'. Error: " + status.Message() << "\n"
+                                                        << filename << "(" << lineNumber << ")");
+        LOG(ERROR) << err_msg;
+        throw std::runtime_error(err_msg);
+    }
+}
+}  // namespace
+
+namespace morpheus {
+// Component-private classes.
+// ************ InferenceClientStage__InFlightRequests ************************* //
+/**
+ * @brief Limits the number of outstanding asynchronous requests for a single message and collects the first error
+ * raised by any of the completion callbacks. Completion callbacks are called from the Triton client's worker thread so
+ * fiber aware primitives are used to avoid blocking the calling fiber's thread.
+ */
+class InferenceClientStage__InFlightRequests
+{
+  public:
+    InferenceClientStage__InFlightRequests(std::size_t max_in_flight) : m_max_in_flight(max_in_flight) {}
+
+    /**
+     * @brief Waits until a new request can be issued. Rethrows an error from a previously completed request.
+     */
+    void acquire()
+    {
+        std::unique_lock<boost::fibers::mutex> lock(m_mutex);
+
+        m_cv.wait(lock, [this]() { return m_in_flight < m_max_in_flight || m_error; });
+
+        if (m_error)
+        {
+            // Dont issue any more requests once one has failed
+            m_cv.wait(lock, [this]() { return m_in_flight == 0; });
+            std::rethrow_exception(m_error);
+        }
+
+        ++m_in_flight;
+    }
+
+    /**
+     * @brief Marks a request as complete, optionally recording an error.
+     */
+    void release(std::exception_ptr error = nullptr)
+    {
+        {
+            std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+
+            if (error && !m_error)
+            {
+                m_error = std::move(error);
+            }
+
+            --m_in_flight;
+        }
+
+        m_cv.notify_all();
+    }
+
+    /**
+     * @brief Waits for all outstanding requests to complete. Rethrows the first error if any request failed.
+     */
+    void wait_all()
+    {
+        std::unique_lock<boost::fibers::mutex> lock(m_mutex);
+
+        m_cv.wait(lock, [this]() { return m_in_flight == 0; });
+
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+    }
+
+  private:
+    std::size_t m_max_in_flight;
+    std::size_t m_in_flight{0};
+    std::exception_ptr m_error{nullptr};
+    boost::fibers::mutex m_mutex;
+    boost::fibers::condition_variable m_cv;
+};
+
+// ************ InferenceClientStage__Client ************************* //
+/**
+ * @brief Common interface over the protocol specific Triton clients. Model metadata and configs are returned in the
+ * JSON layout used by Triton's HTTP/REST API regardless of the protocol.
+ */
+class InferenceClientStage__Client
+{
+  public:
+    virtual ~InferenceClientStage__Client() = default;
+
+    virtual triton::client::Error is_server_live(bool *live) = 0;
+
+    virtual triton::client::Error is_server_ready(bool *ready) = 0;
+
+    virtual triton::client::Error is_model_ready(bool *ready, const std::string &model_name) = 0;
+
+    virtual triton::client::Error model_metadata(nlohmann::json &metadata, const std::string &model_name) = 0;
+
+    virtual triton::client::Error model_config(nlohmann::json &config, const std::string &model_name) = 0;
+
+    virtual triton::client::Error register_cuda_shared_memory(const TritonSharedMemoryRegion &region) = 0;
+
+    virtual triton::client::Error unregister_cuda_shared_memory(const std::string &name) = 0;
+
+    virtual triton::client::Error infer(triton::client::InferResult **result,
+                                        const triton::client::InferOptions &options,
+                                        const std::vector<triton::client::InferInput *> &inputs,
+                                        const std::vector<const triton::client::InferRequestedOutput *> &outputs) = 0;
+
+    virtual triton::client::Error async_infer(
+        std::function<void(triton::client::InferResult *)> callback,
+        const triton::client::InferOptions &options,
+        const std::vector<triton::client::InferInput *> &inputs,
+        const std::vector<const triton::client::InferRequestedOutput *> &outputs) = 0;
+};
+
+/**
+ * @brief Implements `InferenceClientStage__Client` for either `InferenceServerHttpClient` or
+ * `InferenceServerGrpcClient`. Only the metadata/config calls differ between the two and are specialized below.
+ */
+template <typename ClientT>
+class InferenceClientStage__ClientImpl : public InferenceClientStage__Client
+{
+  public:
+    InferenceClientStage__ClientImpl(std::unique_ptr<ClientT> client) : m_client(std::move(client)) {}
+
+    static triton::client::Error create(std::unique_ptr<InferenceClientStage__Client> &client,
+                                        const std::string &server_url)
+    {
+        std::unique_ptr<ClientT> inner_client;
+
+        auto status = ClientT::Create(&inner_client, server_url, false);
+
+        if (status.IsOk())
+        {
+            client = std::make_unique<InferenceClientStage__ClientImpl<ClientT>>(std::move(inner_client));
+        }
+
+        return status;
+    }
+
+    triton::client::Error is_server_live(bool *live) override
+    {
+        return m_client->IsServerLive(live);
+    }
+
+    triton::client::Error is_server_ready(bool *ready) override
+    {
+        return m_client->IsServerReady(ready);
+    }
+
+    triton::client::Error is_model_ready(bool *ready, const std::string &model_name) override
+    {
+        return m_client->IsModelReady(ready, model_name);
+    }
+
+    triton::client::Error model_metadata(nlohmann::json &metadata, const std::string &model_name) override;
+
+    triton::client::Error register_cuda_shared_memory(const TritonSharedMemoryRegion &region) override
+    {
+        return m_client->RegisterCudaSharedMemory(region.name, region.ipc_handle, region.device_id, region.bytes);
+    }
+
+    triton::client::Error unregister_cuda_shared_memory(const std::string &name) override
+    {
+        return m_client->UnregisterCudaSharedMemory(name);
+    }
+
+    triton::client::Error model_config(nlohmann::json &config, const std::string &model_name) override;
+
+    triton::client::Error infer(triton::client::InferResult **result,
+                                const triton::client::InferOptions &options,
+                                const std::vector<triton::client::InferInput *> &inputs,
+                                const std::vector<const triton::client::InferRequestedOutput *> &outputs) override
+    {
+        return m_client->Infer(result, options, inputs, outputs);
+    }
+
+    triton::client::Error async_infer(std::function<void(triton::client::InferResult *)> callback,
+                                      const triton::client::InferOptions &options,
+                                      const std::vector<triton::client::InferInput *> &inputs,
+                                      const std::vector<const triton::client::InferRequestedOutput *> &outputs) override
+    {
+        return m_client->AsyncInfer(std::move(callback), options, inputs, outputs);
+    }
+
+  private:
+    std::unique_ptr<ClientT> m_client;
+};
+
+template <>
+triton::client::Error InferenceClientStage__ClientImpl<triton::client::InferenceServerHttpClient>::model_metadata(
+    nlohmann::json &metadata, const std::string &model_name)
+{
+    std::string model_metadata_json;
+
+    auto status = m_client->ModelMetadata(&model_metadata_json, model_name);
+
+    if (status.IsOk())
+    {
+        metadata = nlohmann::json::parse(model_metadata_json);
+    }
+
+    return status;
+}
+
+template <>
+triton::client::Error InferenceClientStage__ClientImpl<triton::client::InferenceServerHttpClient>::model_config(
+    nlohmann::json &config, const std::string &model_name)
+{
+    std::string model_config_json;
+
+    auto status = m_client->ModelConfig(&model_config_json, model_name);
+
+    if (status.IsOk())
+    {
+        config = nlohmann::json::parse(model_config_json);
+    }
+
+    return status;
+}
+
+template <>
+triton::client::Error InferenceClientStage__ClientImpl<triton::client::InferenceServerGrpcClient>::model_metadata(
+    nlohmann::json &metadata, const std::string &model_name)
+{
+    inference::ModelMetadataResponse model_metadata;
+
+    auto status = m_client->ModelMetadata(&model_metadata, model_name);
+
+    if (status.IsOk())
+    {
+        auto tensors_to_json = [](auto const &tensors) {
+            auto tensors_json = nlohmann::json::array();
+
+            for (auto const &tensor : tensors)
+            {
+                tensors_json.push_back({{"name", tensor.name()},
+                                        {"datatype", tensor.datatype()},
+                                        {"shape", std::vector<int64_t>(tensor.shape().begin(), tensor.shape().end())}});
+            }
+
+            return tensors_json;
+        };
+
+        metadata = {{"name", model_metadata.name()},
+                    {"inputs", tensors_to_json(model_metadata.inputs())},
+                    {"outputs", tensors_to_json(model_metadata.outputs())}};
+    }
+
+    return status;
+}
+
+template <>
+triton::client::Error InferenceClientStage__ClientImpl<triton::client::InferenceServerGrpcClient>::model_config(
+    nlohmann::json &config, const std::string &model_name)
+{
+    inference::ModelConfigResponse model_config;
+
+    auto status = m_client->ModelConfig(&model_config, model_name);
+
+    if (status.IsOk())
+    {
+        // Only the values used by the stage are converted
+        config = {{"name", model_config.config().name()}, {"max_batch_size", model_config.config().max_batch_size()}};
+    }
+
+    return status;
+}
+
+/**
+ * @brief Creates a client for the requested protocol.
+ */
+triton::client::Error InferenceClientStage__create_client(InferenceClientProtocol protocol,
+                                                          const std::string &server_url,
+                                                          std::unique_ptr<InferenceClientStage__Client> &client)
+{
+    if (protocol == InferenceClientProtocol::GRPC)
+    {
+        return InferenceClientStage__ClientImpl<triton::client::InferenceServerGrpcClient>::create(client,
+                                                                                                   server_url);
+    }
+
+    return InferenceClientStage__ClientImpl<triton::client::InferenceServerHttpClient>::create(client, server_url);
+}
+
+// ************ InferenceClientStage__ClientPool ************************* //
+/**
+ * @brief Triton clients for one or more servers hosting the same model, shared by every operator instance of a stage.
+ * Each request leases a client from the healthy server with the fewest outstanding requests. Clients are never used by
+ * two leases at once and are kept for later requests once the lease ends. A server whose request fails is ejected for
+ * `EndpointEjectionTime`, after which the next `acquire` checks it is live with the model ready before using it again.
+ */
+class InferenceClientStage__ClientPool
+{
+    struct Endpoint
+    {
+        std::string server_url;
+        std::vector<std::unique_ptr<InferenceClientStage__Client>> idle_clients;
+    };
+
+  public:
+    /**
+     * @brief Exclusive use of a client until destroyed. Call `fail` if a request sent with it failed.
+     */
+    class Lease
+    {
+      public:
+        Lease(InferenceClientStage__ClientPool &pool,
+              std::size_t endpoint_idx,
+              std::unique_ptr<InferenceClientStage__Client> client) :
+          m_pool(pool),
+          m_endpoint_idx(endpoint_idx),
+          m_client(std::move(client))
+        {}
+
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        ~Lease()
+        {
+            m_pool.release(m_endpoint_idx, std::move(m_client), m_failed);
+        }
+
+        InferenceClientStage__Client &client()
+        {
+            return *m_client;
+        }
+
+        const std::string &server_url() const
+        {
+            return m_pool.m_endpoints[m_endpoint_idx].server_url;
+        }
+
+        void fail()
+        {
+            m_failed = true;
+        }
+
+      private:
+        InferenceClientStage__ClientPool &m_pool;
+        std::size_t m_endpoint_idx;
+        std::unique_ptr<InferenceClientStage__Client> m_client;
+        bool m_failed{false};
+    };
+
+    InferenceClientStage__ClientPool(InferenceClientProtocol protocol,
+                                     std::string model_name,
+                                     const std::vector<std::string> &server_urls) :
+      m_protocol(protocol),
+      m_model_name(std::move(model_name)),
+      m_endpoints(server_urls.size()),
+      m_loads(server_urls.size(), EndpointEjectionTime)
+    {
+        for (std::size_t i = 0; i < server_urls.size(); ++i)
+        {
+            m_endpoints[i].server_url = server_urls[i];
+        }
+    }
+
+    std::size_t size() const
+    {
+        return m_endpoints.size();
+    }
+
+    /**
+     * @brief Leases a client for the healthy server with the fewest outstanding requests. Throws when every server is
+     * ejected and none of those due for a retry pass their health check.
+     */
+    std::unique_ptr<Lease> acquire()
+    {
+        this->check_ejected();
+
+        std::unique_ptr<InferenceClientStage__Client> client;
+        std::size_t endpoint_idx = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            endpoint_idx = m_loads.acquire();
+
+            if (endpoint_idx == m_loads.size())
+            {
+                throw std::runtime_error("None of the Triton servers for model '" + m_model_name + "' are healthy");
+            }
+
+            auto &endpoint = m_endpoints[endpoint_idx];
+
+            if (!endpoint.idle_clients.empty())
+            {
+                client = std::move(endpoint.idle_clients.back());
+                endpoint.idle_clients.pop_back();
+            }
+        }
+
+        if (!client)
+        {
+            // Connecting can be slow, done without the lock
+            auto status = InferenceClientStage__create_client(m_protocol, m_endpoints[endpoint_idx].server_url, client);
+
+            if (!status.IsOk())
+            {
+                this->release(endpoint_idx, nullptr, true);
+
+                CHECK_TRITON(status);
+            }
+        }
+
+        return std::make_unique<Lease>(*this, endpoint_idx, std::move(client));
+    }
+
+    /**
+     * @brief Calls `func` with a client for every server, healthy or not. Used to register and unregister shared
+     * memory.
+     */
+    void for_each_server(const std::function<void(const std::string &, InferenceClientStage__Client &)> &func)
+    {
+        for (auto &endpoint : m_endpoints)
+        {
+            std::unique_ptr<InferenceClientStage__Client> client;
+
+            CHECK_TRITON(InferenceClientStage__create_client(m_protocol, endpoint.server_url, client));
+
+            func(endpoint.server_url, *client);
+        }
+    }
+
+  private:
+    void release(std::size_t endpoint_idx, std::unique_ptr<InferenceClientStage__Client> client, bool failed)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        auto &endpoint = m_endpoints[endpoint_idx];
+
+        if (m_loads.release(endpoint_idx, failed))
+        {
+            LOG(WARNING) << "Request to Triton at '" << endpoint.server_url << "' failed. Ejecting the server for "
+                         << EndpointEjectionTime.count() << "s";
+        }
+
+        if (failed)
+        {
+            // The connections may be broken, dont reuse them. This can run on the worker thread of `client`, which
+            // would deadlock destroying it, so they are destroyed by a later `acquire`
+            if (client)
+            {
+                m_retired_clients.emplace_back(std::move(client));
+            }
+
+            for (auto &idle_client : endpoint.idle_clients)
+            {
+                m_retired_clients.emplace_back(std::move(idle_client));
+            }
+
+            endpoint.idle_clients.clear();
+
+            return;
+        }
+
+        if (client)
+        {
+            endpoint.idle_clients.emplace_back(std::move(client));
+        }
+    }
+
+    /**
+     * @brief Health checks every ejected server which is due for a retry, bringing back those which pass.
+     */
+    void check_ejected()
+    {
+        std::vector<std::size_t> due;
+        std::vector<std::unique_ptr<InferenceClientStage__Client>> retired_clients;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Destroyed outside of the lock once this returns
+            retired_clients.swap(m_retired_clients);
+
+            due = m_loads.due_for_check();
+        }
+
+        for (auto idx : due)
+        {
+            std::unique_ptr<InferenceClientStage__Client> client;
+
+            bool live  = false;
+            bool ready = false;
+
+            if (InferenceClientStage__create_client(m_protocol, m_endpoints[idx].server_url, client).IsOk() &&
+                client->is_server_live(&live).IsOk() && live &&
+                client->is_model_ready(&ready, m_model_name).IsOk() && ready)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                LOG(INFO) << "Triton at '" << m_endpoints[idx].server_url << "' passed its health check";
+
+                m_loads.restore(idx);
+                m_endpoints[idx].idle_clients.emplace_back(std::move(client));
+            }
+        }
+    }
+
+    InferenceClientProtocol m_protocol;
+    std::string m_model_name;
+
+    // Held briefly from operator threads and the clients' worker threads, never while sending a request
+    std::mutex m_mutex;
+    std::vector<Endpoint> m_endpoints;
+    InferenceEndpointLoads m_loads;
+
+    // Clients dropped after a failed request, see `release`
+    std::vector<std::unique_ptr<InferenceClientStage__Client>> m_retired_clients;
+};
+
+/**
+ * @brief Sends a request synchronously, trying the other servers in `pool` if it fails. Every failure ejects a server,
+ * so each is tried at most once.
+ */
+std::unique_ptr<triton::client::InferResult> InferenceClientStage__infer(
+    InferenceClientStage__ClientPool &pool,
+    const triton::client::InferOptions &options,
+    const std::vector<triton::client::InferInput *> &inputs,
+    const std::vector<const triton::client::InferRequestedOutput *> &outputs)
+{
+    auto status = triton::client::Error::Success;
+
+    for (std::size_t attempt = 1;; ++attempt)
+    {
+        std::unique_ptr<InferenceClientStage__ClientPool::Lease> lease;
+
+        try
+        {
+            lease = pool.acquire();
+        } catch (...)
+        {
+            // Every server has been ejected, report why the last one failed
+            if (status.IsOk())
+            {
+                throw;
+            }
+
+            CHECK_TRITON(status);
+        }
+
+        triton::client::InferResult *results = nullptr;
+
+        status = lease->client().infer(&results, options, inputs, outputs);
+
+        std::unique_ptr<triton::client::InferResult> results_ptr(results);
+
+        if (status.IsOk())
+        {
+            status = results_ptr->RequestStatus();
+        }
+
+        if (status.IsOk())
+        {
+            return results_ptr;
+        }
+
+        lease->fail();
+
+        if (attempt >= pool.size())
+        {
+            CHECK_TRITON(status);
+        }
+
+        LOG(WARNING) << "Request to Triton at '" << lease->server_url()
+                     << "' failed, retrying on another server. Error: " << status.Message();
+    }
+}
+
+/**
+ * @brief Unregisters all regions in the pool from every server. Failures are logged since this runs during shutdown.
+ */
+void InferenceClientStage__unregister_shared_memory(InferenceClientStage__ClientPool &clients,
+                                                    const TritonSharedMemoryPool *pool)
+{
+    if (pool == nullptr)
+    {
+        return;
+    }
+
+    try
+    {
+        clients.for_each_server([pool](const std::string &server_url, InferenceClientStage__Client &client) {
+            for (auto const &region : pool->regions())
+            {
+                auto status = client.unregister_cuda_shared_memory(region.name);
+
+                if (!status.IsOk())
+                {
+                    LOG(WARNING) << "Failed to unregister Triton shared memory region '" << region.name << "' from '"
+                                 << server_url << "'. Error: " << status.Message();
+                }
+            }
+        });
+    } catch (const std::exception &e)
+    {
+        LOG(WARNING) << "Failed to unregister Triton shared memory regions. Error: " << e.what();
+    }
+}
+
+/**
+ * @brief When `server_url` uses the default gRPC port of 8001, changes it to the default HTTP port of 8000 and returns
+ * true.
+ */
+bool InferenceClientStage__is_default_grpc_port(std::string &server_url)
+{
+    size_t colon_loc = server_url.find_last_of(':');
+
+    if (colon_loc == -1)
+    {
+        return false;
+    }
+
+    // Check if the port matches 8001
+    if (server_url.size() < colon_loc + 1 || server_url.substr(colon_loc + 1) != "8001")
+    {
+        return false;
+    }
+
+    // It matches, change to 8000
+    server_url = server_url.substr(0, colon_loc) + ":8000";
+
+    return true;
+}
+
+/**
+ * @brief Checks the server is live and ready and that it has loaded `model_name`. Returns the URL to use, which
+ * differs from `server_url` when the default gRPC port was given for HTTP. When `client` is set, it receives the
+ * client used for the checks.
+ */
+std::string InferenceClientStage__check_server(InferenceClientProtocol protocol,
+                                               std::string server_url,
+                                               const std::string &model_name,
+                                               std::unique_ptr<InferenceClientStage__Client> *client = nullptr)
+{
+    const std::string requested_url = server_url;
+
+    std::unique_ptr<InferenceClientStage__Client> server_client;
+
+    auto result = InferenceClientStage__create_client(protocol, server_url, server_client);
+
+    bool is_server_live = false;
+
+    triton::client::Error status = server_client->is_server_live(&is_server_live);
+
+    if (!status.IsOk())
+    {
+        if (protocol == InferenceClientProtocol::HTTP && InferenceClientStage__is_default_grpc_port(server_url))
+        {
+            LOG(WARNING) << "Failed to connect to Triton at '" << requested_url
+                         << "'. Default gRPC port of (8001) was detected but C++ "
+                            "InferenceClientStage is using HTTP protocol. Retrying with default HTTP port (8000)";
+
+            // We are using the default gRPC port, try the default HTTP
+            result = InferenceClientStage__create_client(protocol, server_url, server_client);
+
+            status = server_client->is_server_live(&is_server_live);
+        }
+        else if (status.Message().find("Unsupported protocol") != std::string::npos)
+        {
+            throw std::runtime_error(
+                CONCAT_STR("Failed to connect to Triton at '"
+                           << requested_url
+                           << "'. Received 'Unsupported Protocol' error. Are you using the right port? The C++ "
+                              "InferenceClientStage is using Triton's HTTP protocol. Ensure you have specified the "
+                              "HTTP port (Default 8000) or set the protocol to 'grpc'."));
+        }
+
+        if (!status.IsOk())
+            throw std::runtime_error(CONCAT_STR("Unable to connect to Triton at '"
+                                                << requested_url
+                                                << "'. Check the URL and port and ensure the server is running."));
+    }
+
+    if (!is_server_live)
+        throw std::runtime_error(CONCAT_STR("Server '" << server_url << "' is not live"));
+
+    bool is_server_ready = false;
+    CHECK_TRITON(server_client->is_server_ready(&is_server_ready));
+
+    if (!is_server_ready)
+        throw std::runtime_error(CONCAT_STR("Server '" << server_url << "' is not ready"));
+
+    bool is_model_ready = false;
+    CHECK_TRITON(server_client->is_model_ready(&is_model_ready, model_name));
+
+    if (!is_model_ready)
+        throw std::runtime_error(CONCAT_STR("Model is not ready on server '" << server_url << "'"));
+
+    if (client != nullptr)
+    {
+        *client = std::move(server_client);
+    }
+
+    return server_url;
+}
+
+// ************ InferenceClientStage__ModelInfo ************************* //
+/**
+ * @brief Result of the handshake with every server hosting a model. Shared by every stage sending the same model to
+ * the same servers.
+ */
+struct InferenceClientStage__ModelInfo
+{
+    // After replacing the default gRPC port when using HTTP
+    std::vector<std::string> server_urls;
+
+    nlohmann::json metadata;
+    nlohmann::json config;
+};
+
+/**
+ * @brief Checks every server in parallel, then reads the model metadata and config from the first one. Every server
+ * must host the same model.
+ */
+std::shared_ptr<const InferenceClientStage__ModelInfo> InferenceClientStage__handshake(InferenceClientProtocol protocol,
+                                                                                       const std::string &server_urls,
+                                                                                       const std::string &model_name)
+{
+    auto requested_urls = InferenceServerUrls::split(server_urls);
+
+    if (requested_urls.empty())
+    {
+        throw std::invalid_argument("InferenceClientStage requires at least one Triton server URL");
+    }
+
+    // Client for the first server, used to load the inputs/outputs for the model
+    std::unique_ptr<InferenceClientStage__Client> client;
+
+    std::vector<std::future<std::string>> checks;
+
+    for (std::size_t i = 1; i < requested_urls.size(); ++i)
+    {
+        checks.emplace_back(std::async(std::launch::async, [protocol, url = requested_urls[i], &model_name]() {
+            return InferenceClientStage__check_server(protocol, url, model_name);
+        }));
+    }
+
+    auto info = std::make_shared<InferenceClientStage__ModelInfo>();
+
+    info->server_urls.push_back(InferenceClientStage__check_server(protocol, requested_urls[0], model_name, &client));
+
+    // Every check is waited for, even after one fails, since they reference `model_name`
+    std::exception_ptr error;
+
+    for (auto &check : checks)
+    {
+        try
+        {
+            info->server_urls.push_back(check.get());
+        } catch (...)
+        {
+            error = error ? error : std::current_exception();
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    CHECK_TRITON(client->model_metadata(info->metadata, model_name));
+    CHECK_TRITON(client->model_config(info->config, model_name));
+
+    return info;
+}
+
+using InferenceClientStage__ModelInfoFuture =
+    std::shared_future<std::shared_ptr<const InferenceClientStage__ModelInfo>>;
+
+/**
+ * @brief Starts the handshake for (protocol, server_urls, model_name) on a background thread, or returns the one
+ * already started by another stage. Failed handshakes are forgotten once they complete, so a later stage retries.
+ */
+InferenceClientStage__ModelInfoFuture InferenceClientStage__model_info(InferenceClientProtocol protocol,
+                                                                      const std::string &server_urls,
+                                                                      const std::string &model_name)
+{
+    static InferenceSharedFutureCache<std::tuple<InferenceClientProtocol, std::string, std::string>,
+                                      std::shared_ptr<const InferenceClientStage__ModelInfo>>
+        cache;
+
+    return cache.get(std::make_tuple(protocol, server_urls, model_name), [protocol, server_urls, model_name]() {
+        return InferenceClientStage__handshake(protocol, server_urls, model_name);
+    });
+}
+
+// ************ InferenceClientStage__Request ************************* //
+/**
+ * @brief Request descriptors for every model input and output. Created once and reused for later requests, only the
+ * shape and the data of each input, and the shared memory region, change between requests.
+ */
+struct InferenceClientStage__Request
+{
+    std::vector<std::unique_ptr<triton::client::InferInput>> input_objects;
+    std::vector<std::unique_ptr<triton::client::InferRequestedOutput>> output_objects;
+
+    // Views of the objects above, in the form taken by the client
+    std::vector<triton::client::InferInput *> inputs;
+    std::vector<const triton::client::InferRequestedOutput *> outputs;
+
+    // Pinned copies of the inputs when not using shared memory. Must stay alive until the request completes
+    std::vector<PinnedHostBuffer> staging;
+};
+
+/**
+ * @brief Free list of `InferenceClientStage__Request`, one set of descriptors is needed for every outstanding
+ * request. Shared by the operator instances of a stage and the clients' worker threads.
+ */
+class InferenceClientStage__RequestPool : public std::enable_shared_from_this<InferenceClientStage__RequestPool>
+{
+  public:
+    InferenceClientStage__RequestPool(const std::vector<TritonInOut> &model_inputs,
+                                      const std::vector<TritonInOut> &model_outputs) :
+      m_model_inputs(model_inputs),
+      m_model_outputs(model_outputs)
+    {}
+
+    /**
+     * @brief Returns an unused request, which goes back to the pool once every copy of the pointer is released.
+     */
+    std::shared_ptr<InferenceClientStage__Request> acquire()
+    {
+        std::unique_ptr<InferenceClientStage__Request> request;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (!m_free.empty())
+            {
+                request = std::move(m_free.back());
+                m_free.pop_back();
+            }
+        }
+
+        if (!request)
+        {
+            request = this->create();
+        }
+
+        std::weak_ptr<InferenceClientStage__RequestPool> weak_pool = this->shared_from_this();
+
+        return std::shared_ptr<InferenceClientStage__Request>(
+            request.release(), [weak_pool](InferenceClientStage__Request *released) {
+                std::unique_ptr<InferenceClientStage__Request> owned(released);
+
+                // Give the pinned buffers back straight away rather than holding them while idle
+                owned->staging.clear();
+
+                if (auto pool = weak_pool.lock())
+                {
+                    std::lock_guard<std::mutex> lock(pool->m_mutex);
+                    pool->m_free.emplace_back(std::move(owned));
+                }
+            });
+    }
+
+  private:
+    std::unique_ptr<InferenceClientStage__Request> create() const
+    {
+        auto request = std::make_unique<InferenceClientStage__Request>();
+
+        for (auto const &model_input : m_model_inputs)
+        {
+            triton::client::InferInput *input = nullptr;
+
+            // The shape is set for every request
+            CHECK_TRITON(triton::client::InferInput::Create(
+                &input, model_input.name, std::vector<int64_t>{}, model_input.datatype.triton_str()));
+
+            request->input_objects.emplace_back(input);
+            request->inputs.push_back(input);
+        }
+
+        for (auto const &model_output : m_model_outputs)
+        {
+            triton::client::InferRequestedOutput *output = nullptr;
+
+            CHECK_TRITON(triton::client::InferRequestedOutput::Create(&output, model_output.name));
+
+            request->output_objects.emplace_back(output);
+            request->outputs.push_back(output);
+        }
+
+        return request;
+    }
+
+    std::vector<TritonInOut> m_model_inputs;
+    std::vector<TritonInOut> m_model_outputs;
+
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<InferenceClientStage__Request>> m_free;
+};
+
+// ************ InferenceClientStage__MiniBatch ************************* //
+/**
+ * @brief Rows [start, stop) sent in a single request. When bucketing, rows are positions in the length sorted order and
+ * `width` is the number of columns sent for inputs with a dynamic sequence length.
+ */
+struct InferenceClientStage__MiniBatch
+{
+    std::size_t start;
+    std::size_t stop;
+    TensorIndex width;
+};
+
+/**
+ * @brief Rounds a token count up to the next power of two, bounded by `MinBucketWidth` and `max_width`. Keeping the
+ * number of distinct shapes small lets Triton reuse its CUDA graphs and batches.
+ */
+TensorIndex InferenceClientStage__bucket_width(int32_t length, TensorIndex max_width)
+{
+    TensorIndex width = MinBucketWidth;
+
+    while (width < length)
+    {
+        width *= 2;
+    }
+
+    return std::min(width, max_width);
+}
+
+// ************ InferenceClientStage__Pending ************************* //
+/**
+ * @brief Messages waiting to be combined into a single request. Shared between the operator and the timer fiber, which
+ * only touch it, the client or the output while holding `mutex`. The timer stops touching them once `done` is set.
+ */
+struct InferenceClientStage__Pending
+{
+    boost::fibers::mutex mutex;
+    boost::fibers::condition_variable cv;
+
+    std::vector<std::shared_ptr<MultiInferenceMessage>> messages;
+    std::size_t rows{0};
+    std::chrono::steady_clock::time_point first_arrival;
+
+    // Incremented by every flush so the timer can tell its deadline is stale
+    std::size_t generation{0};
+    bool done{false};
+
+    // Set when a flush from the timer fails, rethrown by the next call to the operator
+    std::exception_ptr error{nullptr};
+};
+
+/**
+ * @brief True when the rows of `tensor` are stored one after the other, so the rows of several tensors can be joined
+ * with one copy each.
+ */
+bool InferenceClientStage__rows_contiguous(const TensorObject &tensor)
+{
+    TensorIndex expected_stride = 1;
+
+    for (auto dim = static_cast<int>(tensor.rank()) - 1; dim >= 0; --dim)
+    {
+        // The stride of a dimension with a single element is never used
+        if (tensor.shape(dim) > 1 && tensor.stride(dim) != expected_stride)
+        {
+            return false;
+        }
+
+        expected_stride *= tensor.shape(dim);
+    }
+
+    return true;
+}
+
+/**
+ * @brief True when `x` and `y` have the same type and the same shape, ignoring the number of rows.
+ */
+bool InferenceClientStage__same_row_shape(const TensorObject &x, const TensorObject &y)
+{
+    if (!(x.dtype() == y.dtype()) || x.rank() != y.rank())
+    {
+        return false;
+    }
+
+    for (std::uint32_t dim = 1; dim < x.rank(); ++dim)
+    {
+        if (x.shape(dim) != y.shape(dim))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Rows [start, stop) of a tensor of any rank.
+ */
+TensorObject InferenceClientStage__row_slice(const TensorObject &tensor, std::size_t start, std::size_t stop)
+{
+    std::vector<TensorIndex> min_dims(tensor.rank(), 0);
+    std::vector<TensorIndex> max_dims(tensor.rank(), -1);
+
+    min_dims[0] = static_cast<TensorIndex>(start);
+    max_dims[0] = static_cast<TensorIndex>(stop);
+
+    return tensor.slice(std::move(min_dims), std::move(max_dims));
+}
+
+/**
+ * @brief When `message` has more inference rows than message rows, the rows are overlapping token windows of longer
+ * messages. Merges the outputs of every window into a single row per message row using `seq_ids[:, 0]`, otherwise
+ * returns `memory` unchanged.
+ */
+std::shared_ptr<ResponseMemory> InferenceClientStage__reduce_windows(const MultiInferenceMessage &message,
+                                                                     std::shared_ptr<ResponseMemory> memory,
+                                                                     RowReduction reduction)
+{
+    if (message.count == message.mess_count || !message.memory->has_input("seq_ids"))
+    {
+        return memory;
+    }
+
+    auto seq_ids = message.get_input("seq_ids");
+
+    // Slices keep the message ids of the message they were taken from
+    const auto first_message = static_cast<std::size_t>(seq_ids.read_element<int32_t>({0, 0}));
+
+    auto reduced = std::make_shared<ResponseMemory>(message.mess_count);
+
+    for (auto &[name, output] : memory->outputs)
+    {
+        if (output.rank() != 2)
+        {
+            throw std::invalid_argument("Output '" + name + "' must be 2D to be reduced by seq_ids");
+        }
+
+        auto buffer = MatxUtil::reduce_by_seq_ids(output, seq_ids, message.mess_count, reduction, first_message);
+
+        reduced->outputs[name] = Tensor::create(
+            std::move(buffer),
+            DType(output.dtype()),
+            std::vector<TensorIndex>{static_cast<TensorIndex>(message.mess_count), output.shape(1)},
+            std::vector<TensorIndex>{},
+            0);
+    }
+
+    return reduced;
+}
+
+/**
+ * @brief True when every input in `input_names` of `x` can be concatenated, as is or with the same input of `first`
+ * when set. Both messages must also agree on whether they have an input mask.
+ */
+bool InferenceClientStage__can_combine(const MultiInferenceMessage &x,
+                                       const MultiInferenceMessage *first,
+                                       const std::vector<std::string> &input_names,
+                                       bool use_input_mask)
+{
+    std::vector<std::string> names{input_names};
+
+    if (use_input_mask && first != nullptr &&
+        x.memory->has_input("input_mask") != first->memory->has_input("input_mask"))
+    {
+        return false;
+    }
+
+    if (use_input_mask && x.memory->has_input("input_mask"))
+    {
+        names.emplace_back("input_mask");
+    }
+
+    for (const auto &name : names)
+    {
+        if (!x.memory->has_input(name))
+        {
+            return false;
+        }
+
+        auto tensor = x.get_input(name);
+
+        if (!InferenceClientStage__rows_contiguous(tensor))
+        {
+            return false;
+        }
+
+        if (first != nullptr)
+        {
+            if (!InferenceClientStage__same_row_shape(first->get_input(name), tensor))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Joins the rows of `parts`, which must share a type and row shape and have contiguous rows, into a new tensor.
+ */
+TensorObject InferenceClientStage__concatenate(const std::vector<TensorObject> &parts)
+{
+    const auto &first = parts.front();
+
+    std::vector<TensorIndex> shape(first.rank());
+
+    for (std::uint32_t dim = 1; dim < first.rank(); ++dim)
+    {
+        shape[dim] = first.shape(dim);
+    }
+
+    for (const auto &part : parts)
+    {
+        CHECK(InferenceClientStage__same_row_shape(first, part))
+            << "Only tensors with the same row shape can be joined";
+
+        shape[0] += part.shape(0);
+    }
+
+    auto combined = std::move(Tensor::create_packed({DType(first.dtype())}, {shape}).front());
+
+    auto *dst = static_cast<uint8_t *>(combined.data());
+
+    // Queue every copy before a single synchronize
+    for (const auto &part : parts)
+    {
+        NEO_CHECK_CUDA(
+            cudaMemcpyAsync(dst, part.data(), part.bytes(), cudaMemcpyDeviceToDevice, rmm::cuda_stream_per_thread));
+
+        dst += part.bytes();
+    }
+
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    return combined;
+}
+
+// ************ InferenceClientStage__ResponseCache ************************* //
+/**
+ * @brief Gathers the `rows` rows of a 2D tensor listed in the device array `row_indices` into a new contiguous tensor.
+ */
+TensorObject InferenceClientStage__gather_rows(const TensorObject &input,
+                                               const rmm::device_buffer &row_indices,
+                                               std::size_t rows)
+{
+    return Tensor::create(
+        MatxUtil::gather_rows(input, static_cast<const int32_t *>(row_indices.data()), rows, input.shape(1)),
+        DType(input.dtype()),
+        std::vector<TensorIndex>{static_cast<TensorIndex>(rows), input.shape(1)},
+        std::vector<TensorIndex>{},
+        0);
+}
+
+/**
+ * @brief Bounded LRU of the outputs of previous rows, keyed by a hash of the row's inputs. The outputs of every cached
+ * row stay on the device, in one [capacity, cols] tensor per model output, only the index is kept on the host. Shared
+ * by the operator instances of a stage. Only used with models whose outputs have a single dimension per row.
+ *
+ * Rows are looked up and written under the cache's lock, and every copy from or into the cached tensors is
+ * synchronized before releasing it, so a slot is never overwritten while another fiber is reading it.
+ */
+class InferenceClientStage__ResponseCache
+{
+  public:
+    // Sends the rows of the message given, by row index, and returns their outputs in the same order
+    using infer_fn_t = std::function<std::shared_ptr<ResponseMemory>(const std::vector<int32_t> &rows)>;
+
+    explicit InferenceClientStage__ResponseCache(std::size_t capacity) : m_capacity(capacity), m_index(capacity) {}
+
+    /**
+     * @brief Returns the outputs for rows with the hashes in `keys`, only sending the rows which are not cached to
+     * `infer_fn`. Rows sharing a hash within `keys` are only sent once.
+     */
+    std::shared_ptr<ResponseMemory> infer(const std::vector<uint64_t> &keys, const infer_fn_t &infer_fn)
+    {
+        const auto count = keys.size();
+
+        InferenceResponseCacheIndex::Lookup lookup;
+
+        // Copies of the cached outputs of the hits, taken under the lock
+        std::map<std::string, TensorObject> hit_outputs;
+
+        {
+            std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+
+            lookup = m_index.lookup(keys);
+
+            m_hits += lookup.hit_rows.size();
+            m_misses += lookup.missed_rows.size();
+
+            if (!lookup.hit_rows.empty())
+            {
+                rmm::device_buffer slots(
+                    lookup.hit_slots.data(), lookup.hit_slots.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+                for (const auto &[name, cached] : m_outputs)
+                {
+                    hit_outputs[name] = InferenceClientStage__gather_rows(cached, slots, lookup.hit_rows.size());
+                }
+
+                NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+            }
+        }
+
+        const auto &hit_rows    = lookup.hit_rows;
+        const auto &miss_rows   = lookup.miss_rows;
+        const auto &missed_rows = lookup.missed_rows;
+        const auto &missed_keys = lookup.missed_keys;
+
+        if (miss_rows.empty())
+        {
+            return InferenceClientStage__ResponseCache::assemble(count, hit_rows, hit_outputs, {}, {});
+        }
+
+        auto missed = infer_fn(miss_rows);
+
+        this->insert(keys, miss_rows, *missed);
+
+        if (hit_rows.empty() && missed_rows.size() == miss_rows.size())
+        {
+            // Every row was sent, in order
+            return missed;
+        }
+
+        // Rows sharing a key get a copy of its outputs
+        std::map<std::string, TensorObject> missed_outputs;
+
+        if (missed_rows.size() == miss_rows.size())
+        {
+            missed_outputs.insert(missed->outputs.begin(), missed->outputs.end());
+        }
+        else
+        {
+            rmm::device_buffer indices(
+                missed_keys.data(), missed_keys.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+            for (const auto &[name, output] : missed->outputs)
+            {
+                missed_outputs[name] = InferenceClientStage__gather_rows(output, indices, missed_keys.size());
+            }
+        }
+
+        return InferenceClientStage__ResponseCache::assemble(count, hit_rows, hit_outputs, missed_rows, missed_outputs);
+    }
+
+    std::size_t hits() const
+    {
+        return m_hits;
+    }
+
+    std::size_t misses() const
+    {
+        return m_misses;
+    }
+
+  private:
+
+    /**
+     * @brief Builds the outputs of all `count` rows, from the outputs of the hits and of the missed rows
+     */
+    static std::shared_ptr<ResponseMemory> assemble(std::size_t count,
+                                                    const std::vector<int32_t> &hit_rows,
+                                                    const std::map<std::string, TensorObject> &hit_outputs,
+                                                    const std::vector<int32_t> &missed_rows,
+                                                    const std::map<std::string, TensorObject> &missed_outputs)
+    {
+        auto memory = std::make_shared<ResponseMemory>(count);
+
+        const auto &names = hit_outputs.empty() ? missed_outputs : hit_outputs;
+
+        std::unique_ptr<rmm::device_buffer> hit_indices;
+        std::unique_ptr<rmm::device_buffer> missed_indices;
+
+        if (!hit_rows.empty())
+        {
+            hit_indices = std::make_unique<rmm::device_buffer>(
+                hit_rows.data(), hit_rows.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+        }
+
+        if (!missed_rows.empty())
+        {
+            missed_indices = std::make_unique<rmm::device_buffer>(
+                missed_rows.data(), missed_rows.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+        }
+
+        for (const auto &[name, reference] : names)
+        {
+            auto output = std::move(Tensor::create_packed({DType(reference.dtype())},
+                                                          {{static_cast<TensorIndex>(count), reference.shape(1)}})
+                                        .front());
+
+            if (hit_indices)
+            {
+                MatxUtil::scatter_rows_into(
+                    hit_outputs.at(name), static_cast<const int32_t *>(hit_indices->data()), output.data());
+            }
+
+            if (missed_indices)
+            {
+                MatxUtil::scatter_rows_into(
+                    missed_outputs.at(name), static_cast<const int32_t *>(missed_indices->data()), output.data());
+            }
+
+            memory->outputs[name] = std::move(output);
+        }
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+        return memory;
+    }
+
+    /**
+     * @brief Stores the outputs of the rows in `miss_rows`, evicting the least recently used rows when full. Nothing
+     * is stored if the outputs do not match the cached ones, and only the first `m_capacity` rows are stored.
+     */
+    void insert(const std::vector<uint64_t> &keys, const std::vector<int32_t> &miss_rows, const ResponseMemory &missed)
+    {
+        std::lock_guard<boost::fibers::mutex> lock(m_mutex);
+
+        if (!m_outputs.empty() && m_outputs.size() != missed.outputs.size())
+        {
+            return;
+        }
+
+        for (const auto &[name, output] : missed.outputs)
+        {
+            if (output.rank() != 2)
+            {
+                return;
+            }
+
+            if (m_outputs.empty())
+            {
+                continue;
+            }
+
+            auto cached = m_outputs.find(name);
+
+            if (cached == m_outputs.end() || !(cached->second.dtype() == output.dtype()) ||
+                cached->second.shape(1) != output.shape(1))
+            {
+                return;
+            }
+        }
+
+        if (m_outputs.empty())
+        {
+            for (const auto &[name, output] : missed.outputs)
+            {
+                m_outputs[name] = std::move(Tensor::create_packed({DType(output.dtype())},
+                                                                  {{static_cast<TensorIndex>(m_capacity),
+                                                                    output.shape(1)}})
+                                                .front());
+            }
+        }
+
+        // Keys stored by another fiber since the lookup keep their slot, their outputs are the same
+        const auto slots  = m_index.assign(keys, miss_rows);
+        const auto stored = slots.size();
+
+        rmm::device_buffer slot_indices(slots.data(), slots.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+        for (auto &[name, cached] : m_outputs)
+        {
+            // Missed rows beyond the capacity are not stored
+            auto rows = InferenceClientStage__row_slice(missed.outputs.find(name)->second, 0, stored);
+
+            MatxUtil::scatter_rows_into(rows, static_cast<const int32_t *>(slot_indices.data()), cached.data());
+        }
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+    }
+
+    std::size_t m_capacity;
+
+    boost::fibers::mutex m_mutex;
+    InferenceResponseCacheIndex m_index;
+    std::map<std::string, TensorObject> m_outputs;
+
+    std::atomic<std::size_t> m_hits{0};
+    std::atomic<std::size_t> m_misses{0};
+};
+
+// Component public implementations
+// ************ InferenceClientStage ************************* //
+InferenceClientStage::InferenceClientStage(const neo::Segment &parent,
+                                           const std::string &name,
+                                           std::string model_name,
+                                           std::string server_url,
+                                           bool force_convert_inputs,
+                                           bool use_shared_memory,
+                                           bool needs_logits,
+                                           std::map<std::string, std::string> inout_mapping,
+                                           std::size_t max_concurrent_requests,
+                                           InferenceClientProtocol protocol,
+                                           bool length_bucketing,
+                                           int32_t device_id,
+                                           int32_t batch_timeout_ms,
+                                           std::size_t cache_size,
+                                           RowReduction window_reduction,
+                                           bool warmup) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_model_name(std::move(model_name)),
+  m_server_url(std::move(server_url)),
+  m_force_convert_inputs(force_convert_inputs),
+  m_use_shared_memory(use_shared_memory),
+  m_needs_logits(needs_logits),
+  m_inout_mapping(std::move(inout_mapping)),
+  m_max_concurrent_requests(std::max<std::size_t>(max_concurrent_requests, 1)),
+  m_protocol(protocol),
+  m_length_bucketing(length_bucketing),
+  m_device_id(device_id),
+  m_batch_timeout_ms(batch_timeout_ms),
+  m_cache_size(cache_size),
+  m_window_reduction(window_reduction),
+  m_warmup(warmup),
+  m_options(m_model_name),
+  m_metrics(StageMetrics::get(name)),
+  m_drain_progress(PipelineDrain::track(name))
+{
+    // Runs in the background while the rest of the pipeline is built, stages using the same model and servers share
+    // a single handshake
+    m_model_info = InferenceClientStage__model_info(m_protocol, m_server_url, m_model_name);
+}
+
+InferenceClientStage::operator_fn_t InferenceClientStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        // The first operator to start waits for the handshake and sets up the inputs/outputs
+        std::call_once(m_connect_once, [this]() {
+            DeviceAffinity::bind_current_thread(m_device_id);
+
+            this->connect_with_server();
+
+            if (m_warmup)
+            {
+                this->warmup();
+            }
+        });
+
+        auto pending = std::make_shared<InferenceClientStage__Pending>();
+
+        // Inputs joined when combining messages, the input mask is only needed when bucketing
+        auto input_names = foreach_map(m_model_inputs, [](auto const &model_input) { return model_input.mapped_name; });
+
+        // Sends every pending message as one set of requests and emits a response per message. Must be called with
+        // `pending->mutex` held
+        auto flush = [this, pending, &output]() {
+            auto messages = std::move(pending->messages);
+
+            pending->messages.clear();
+            pending->rows = 0;
+            ++pending->generation;
+
+            // Counted in flight from the time they were queued until they were emitted, or failed
+            struct Released
+            {
+                DrainProgress &progress;
+                std::size_t count;
+
+                ~Released()
+                {
+                    progress.remove(count);
+                }
+            } released{*m_drain_progress, messages.size()};
+
+            if (messages.empty())
+            {
+                return;
+            }
+
+            if (messages.size() == 1)
+            {
+                m_metrics->emit(output, this->infer_message(messages.front()));
+                return;
+            }
+
+            std::vector<TensorObject> inputs;
+
+            for (auto const &model_input : m_model_inputs)
+            {
+                auto parts = foreach_map(messages, [&model_input](auto const &x) -> TensorObject {
+                    return x->get_input(model_input.mapped_name);
+                });
+
+                inputs.emplace_back(InferenceClientStage__concatenate(parts));
+            }
+
+            TensorObject input_mask;
+            const bool has_input_mask = m_length_bucketing && messages.front()->memory->has_input("input_mask");
+
+            if (has_input_mask)
+            {
+                input_mask = InferenceClientStage__concatenate(
+                    foreach_map(messages, [](auto const &x) -> TensorObject { return x->get_input("input_mask"); }));
+            }
+
+            std::size_t total_rows = 0;
+
+            for (auto const &x : messages)
+            {
+                total_rows += x->count;
+            }
+
+            auto combined = this->infer_cached(inputs, has_input_mask ? &input_mask : nullptr, total_rows);
+
+            // Each message gets a view of its own rows, the outputs are not copied again
+            std::size_t offset = 0;
+
+            for (auto &x : messages)
+            {
+                auto memory = std::make_shared<ResponseMemory>(x->count);
+
+                for (auto const &[name, combined_output] : combined->outputs)
+                {
+                    memory->outputs[name] = InferenceClientStage__row_slice(combined_output, offset, offset + x->count);
+                }
+
+                offset += x->count;
+
+                memory = InferenceClientStage__reduce_windows(*x, std::move(memory), m_window_reduction);
+
+                auto response = std::make_shared<MultiResponseProbsMessage>(
+                    x->meta, x->mess_offset, x->mess_count, memory, 0, memory->count);
+
+                m_metrics->emit(output, std::move(response));
+            }
+        };
+
+        if (m_batch_timeout_ms > 0)
+        {
+            const auto timeout = std::chrono::milliseconds(m_batch_timeout_ms);
+
+            // Sends partial batches which have waited for `timeout` without enough rows arriving to fill a request
+            boost::fibers::fiber([this, pending, timeout, flush]() {
+                std::unique_lock<boost::fibers::mutex> lock(pending->mutex);
+
+                while (!pending->done)
+                {
+                    if (pending->messages.empty())
+                    {
+                        pending->cv.wait(lock);
+                        continue;
+                    }
+
+                    const auto generation = pending->generation;
+
+                    const bool flushed = pending->cv.wait_until(lock, pending->first_arrival + timeout, [&]() {
+                        return pending->done || pending->generation != generation;
+                    });
+
+                    if (!flushed)
+                    {
+                        try
+                        {
+                            DeviceAffinity::bind_current_thread(m_device_id);
+                            DeviceMemory::ScopedTag memory_tag("InferenceClientStage");
+
+                            flush();
+                        } catch (...)
+                        {
+                            // Surfaced by the next call to the operator
+                            pending->error = std::current_exception();
+                            pending->done  = true;
+                        }
+                    }
+                }
+            }).detach();
+        }
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, pending, input_names, flush, &output](reader_type_t &&x) {
+                DeviceAffinity::bind_current_thread(m_device_id);
+
+                DeviceMemory::ScopedTag memory_tag("InferenceClientStage");
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+                DrainProgress::Scope drain_scope(*m_drain_progress);
+
+                if (m_batch_timeout_ms <= 0)
+                {
+                    metrics_scope.emit(output, this->infer_message(x));
+                    return;
+                }
+
+                std::lock_guard<boost::fibers::mutex> lock(pending->mutex);
+
+                if (pending->error)
+                {
+                    std::rethrow_exception(pending->error);
+                }
+
+                const bool can_combine =
+                    m_max_batch_size > 0 && x->count < m_max_batch_size &&
+                    InferenceClientStage__can_combine(*x, nullptr, input_names, m_length_bucketing);
+
+                if (!pending->messages.empty() &&
+                    (!can_combine || pending->rows + x->count > m_max_batch_size ||
+                     !InferenceClientStage__can_combine(
+                         *x, pending->messages.front().get(), input_names, m_length_bucketing)))
+                {
+                    flush();
+                }
+
+                // Already a full request, or can't be joined with other messages
+                if (!can_combine)
+                {
+                    metrics_scope.emit(output, this->infer_message(x));
+                    return;
+                }
+
+                if (pending->messages.empty())
+                {
+                    pending->first_arrival = std::chrono::steady_clock::now();
+                    pending->cv.notify_all();
+                }
+
+                pending->rows += x->count;
+                pending->messages.emplace_back(std::move(x));
+                m_drain_progress->add();
+
+                if (pending->rows >= m_max_batch_size)
+                {
+                    flush();
+                }
+            },
+            [this, pending, &output](std::exception_ptr error_ptr) {
+                {
+                    std::lock_guard<boost::fibers::mutex> lock(pending->mutex);
+
+                    pending->done = true;
+                    pending->cv.notify_all();
+                }
+
+                InferenceClientStage__unregister_shared_memory(*m_client_pool, m_shared_memory_pool.get());
+                output.on_error(error_ptr);
+            },
+            [this, pending, flush, &output]() {
+                std::exception_ptr error_ptr = nullptr;
+
+                {
+                    std::lock_guard<boost::fibers::mutex> lock(pending->mutex);
+
+                    error_ptr = pending->error;
+
+                    if (!error_ptr)
+                    {
+                        try
+                        {
+                            DeviceMemory::ScopedTag memory_tag("InferenceClientStage");
+
+                            flush();
+                        } catch (...)
+                        {
+                            error_ptr = std::current_exception();
+                        }
+                    }
+
+                    pending->done = true;
+                    pending->cv.notify_all();
+                }
+
+                InferenceClientStage__unregister_shared_memory(*m_client_pool, m_shared_memory_pool.get());
+
+                if (m_response_cache)
+                {
+                    // Totals for every operator instance of the stage so far
+                    LOG(INFO) << "Response cache for model '" << m_model_name << "': " << m_response_cache->hits()
+                              << " hits, " << m_response_cache->misses() << " misses";
+                }
+
+                if (error_ptr)
+                {
+                    output.on_error(error_ptr);
+                    return;
+                }
+
+                // Every outstanding request finished, `infer_message` waits on all of them
+                m_drain_progress->set_drained();
+
+                output.on_completed();
+            }));
+    };
+}
+
+InferenceClientStage::writer_type_t InferenceClientStage::infer_message(const reader_type_t &message)
 {
-    if (!status.IsOk())
+    // Inputs are looked up by name once per message, mini-batches use the tensors directly
+    auto inputs = foreach_map(m_model_inputs, [&message](auto const &model_input) -> TensorObject {
+        auto slot = message->memory->inputs.slot_of(model_input.mapped_name);
+
+        CHECK(slot != TensorMap::npos)
+            << "Model input '" << model_input.mapped_name << "' not found in InferenceMemory";
+
+        return message->get_input(slot);
+    });
+
+    TensorObject input_mask;
+    const bool has_input_mask = m_length_bucketing && message->memory->has_input("input_mask");
+
+    if (has_input_mask)
     {
-        std::string err_msg =
-            CONCAT_STR("Triton Error while executing '" << methodName << "'. Error: " + status.Message() << "\n"
-                                                        << filename << "(" << lineNumber << ")");
-        LOG(ERROR) << err_msg;
-        throw std::runtime_error(err_msg);
+        input_mask = message->get_input("input_mask");
     }
+
+    auto memory = this->infer_cached(inputs, has_input_mask ? &input_mask : nullptr, message->count);
+
+    memory = InferenceClientStage__reduce_windows(*message, std::move(memory), m_window_reduction);
+
+    return std::make_shared<MultiResponseProbsMessage>(
+        message->meta, message->mess_offset, message->mess_count, memory, 0, memory->count);
 }
-}  // namespace
 
-namespace morpheus {
-// Component public implementations
-// ************ InferenceClientStage ************************* //
-InferenceClientStage::InferenceClientStage(const neo::Segment &parent,
-                                           const std::string &name,
-                                           std::string model_name,
-                                           std::string server_url,
-                                           bool force_convert_inputs,
-                                           bool use_shared_memory,
-                                           bool needs_logits,
-                                           std::map<std::string, std::string> inout_mapping) :
-  neo::SegmentObject(parent, name),
-  PythonNode(parent, name, build_operator()),
-  m_model_name(std::move(model_name)),
-  m_server_url(std::move(server_url)),
-  m_force_convert_inputs(force_convert_inputs),
-  m_use_shared_memory(use_shared_memory),
-  m_needs_logits(needs_logits),
-  m_inout_mapping(std::move(inout_mapping)),
-  m_options(m_model_name)
+std::shared_ptr<ResponseMemory> InferenceClientStage::infer_cached(const std::vector<TensorObject> &inputs,
+                                                                   const TensorObject *input_mask,
+                                                                   std::size_t count)
 {
-    // Connect with the server to setup the inputs/outputs
-    this->connect_with_server();  // TODO(Devin)
+    if (!m_response_cache || count == 0)
+    {
+        return this->infer_rows(inputs, input_mask, count);
+    }
+
+    // Every input of a row is hashed together, only the hashes are copied to the host
+    rmm::device_buffer hashes(count * sizeof(uint64_t), rmm::cuda_stream_per_thread);
+
+    for (std::size_t input_idx = 0; input_idx < inputs.size(); ++input_idx)
+    {
+        MatxUtil::hash_rows(inputs[input_idx], static_cast<uint64_t *>(hashes.data()), input_idx > 0);
+    }
+
+    std::vector<uint64_t> keys(count);
+
+    NEO_CHECK_CUDA(cudaMemcpyAsync(
+        keys.data(), hashes.data(), hashes.size(), cudaMemcpyDeviceToHost, rmm::cuda_stream_per_thread));
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    return m_response_cache->infer(keys, [&](const std::vector<int32_t> &rows) {
+        if (rows.size() == count)
+        {
+            // Nothing cached and no repeated rows
+            return this->infer_rows(inputs, input_mask, count);
+        }
+
+        rmm::device_buffer row_indices(rows.data(), rows.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+        auto miss_inputs = foreach_map(inputs, [&](auto const &input) {
+            return InferenceClientStage__gather_rows(input, row_indices, rows.size());
+        });
+
+        TensorObject miss_mask;
+
+        if (input_mask != nullptr)
+        {
+            miss_mask = InferenceClientStage__gather_rows(*input_mask, row_indices, rows.size());
+        }
+
+        return this->infer_rows(miss_inputs, input_mask != nullptr ? &miss_mask : nullptr, rows.size());
+    });
 }
 
-InferenceClientStage::operator_fn_t InferenceClientStage::build_operator()
+std::shared_ptr<ResponseMemory> InferenceClientStage::infer_rows(const std::vector<TensorObject> &inputs,
+                                                                 const TensorObject *input_mask,
+                                                                 std::size_t count)
 {
-    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
-        std::unique_ptr<triton::client::InferenceServerHttpClient> client;
+    auto memory = std::make_shared<ResponseMemory>(count);
 
-        CHECK_TRITON(triton::client::InferenceServerHttpClient::Create(&client, m_server_url, false));
+    // When bucketing, rows are sent sorted by token length and the response is filled in that order.
+    // Holds the original row index of each sorted row
+    std::vector<int32_t> row_order;
+    std::shared_ptr<rmm::device_buffer> row_order_buffer;
+    std::vector<InferenceClientStage__MiniBatch> mini_batches;
 
-        return input.subscribe(neo::make_observer<reader_type_t>(
-            [this, &output, &client](reader_type_t &&x) {
-                auto reponse_memory = std::make_shared<ResponseMemory>(x->count);
+    if (input_mask != nullptr)
+    {
+        auto lengths       = MatxUtil::row_lengths(*input_mask);
+        const auto max_len = input_mask->shape(1);
 
-                // Create the output memory blocks
-                for (auto &model_output : m_model_outputs)
-                {
-                    auto total_shape = model_output.shape;
+        row_order.resize(count);
+        std::iota(row_order.begin(), row_order.end(), 0);
+        std::stable_sort(row_order.begin(), row_order.end(), [&lengths](int32_t a, int32_t b) {
+            return lengths[a] < lengths[b];
+        });
 
-                    // First dimension will always end up being the number of rows
-                    total_shape[0] = x->count;
+        row_order_buffer = std::make_shared<rmm::device_buffer>(
+            row_order.data(), row_order.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
 
-                    auto elem_count = std::accumulate(total_shape.begin(), total_shape.end(), 1, std::multiplies<>());
+        // Never mix buckets in a single request
+        for (size_t start = 0; start < count;)
+        {
+            auto width  = InferenceClientStage__bucket_width(lengths[row_order[start]], max_len);
+            size_t stop = start + 1;
 
-                    // Create the output memory
-                    auto output_buffer = std::make_shared<rmm::device_buffer>(
-                        elem_count * model_output.datatype.item_size(), rmm::cuda_stream_per_thread);
+            while (stop < count && stop - start < m_max_batch_size &&
+                   InferenceClientStage__bucket_width(lengths[row_order[stop]], max_len) == width)
+            {
+                ++stop;
+            }
 
-                    reponse_memory->outputs[model_output.mapped_name] = Tensor::create(
-                        std::move(output_buffer),
-                        model_output.datatype,
-                        std::vector<TensorIndex>{static_cast<int>(total_shape[0]), static_cast<int>(total_shape[1])},
-                        std::vector<TensorIndex>{},
-                        0);
-                }
+            mini_batches.push_back(InferenceClientStage__MiniBatch{start, stop, width});
+            start = stop;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i += m_max_batch_size)
+        {
+            mini_batches.push_back(InferenceClientStage__MiniBatch{i, std::min(i + m_max_batch_size, count), -1});
+        }
+    }
 
-                // This will be the final output of all mini-batches
-                auto response = std::make_shared<MultiResponseProbsMessage>(
-                    x->meta, x->mess_offset, x->mess_count, std::move(reponse_memory), 0, reponse_memory->count);
+    // Shared with the completion callbacks which can outlive this scope if an error is thrown
+    auto in_flight = std::make_shared<InferenceClientStage__InFlightRequests>(m_max_concurrent_requests);
 
-                for (size_t i = 0; i < x->count; i += m_max_batch_size)
-                {
-                    triton::client::InferInput *input1;
+    // Outputs of each mini-batch, in the order of `m_model_outputs`. Sized by what Triton returns, since dimensions
+    // after the first can differ from the model's metadata. Each callback only writes its own entry
+    auto mini_batch_outputs = std::make_shared<std::vector<std::vector<TensorObject>>>(mini_batches.size());
+
+    for (std::size_t batch_idx = 0; batch_idx < mini_batches.size(); ++batch_idx)
+    {
+        const auto &mini_batch = mini_batches[batch_idx];
+
+        size_t start = mini_batch.start;
+        size_t stop  = mini_batch.stop;
 
-                    size_t start = i;
-                    size_t stop  = std::min(i + m_max_batch_size, x->count);
+        // Mini-batches never leave the stage, so rather than creating slice messages the inputs are addressed as
+        // rows [start, stop) of `inputs`
 
-                    reader_type_t mini_batch_input =
-                        std::static_pointer_cast<MultiInferenceMessage>(x->get_slice(start, stop));
-                    writer_type_t mini_batch_output =
-                        std::static_pointer_cast<MultiResponseProbsMessage>(response->get_slice(start, stop));
+        // Returns the tensor to send for a model input, gathering and trimming the rows when bucketing
+        auto get_mini_batch_input = [&](const TritonInOut &model_input, size_t input_idx) -> TensorObject {
+            const auto &full_tensor = inputs[input_idx];
 
-                    // Iterate on the model inputs in case the model takes less than what tensors are available
-                    std::vector<std::pair<std::shared_ptr<triton::client::InferInput>, std::vector<uint8_t>>>
-                        saved_inputs = foreach_map(m_model_inputs, [this, &mini_batch_input](auto const &model_input) {
-                            DCHECK(mini_batch_input->memory->has_input(model_input.mapped_name))
-                                << "Model input '" << model_input.mapped_name << "' not found in InferenceMemory";
+            if (!row_order_buffer)
+            {
+                return InferenceClientStage__row_slice(full_tensor, start, stop);
+            }
+
+            auto rows = static_cast<TensorIndex>(stop - start);
+            auto cols = model_input.dynamic_width ? std::min(mini_batch.width, full_tensor.shape(1))
+                                                  : full_tensor.shape(1);
+
+            const auto *row_indices = static_cast<const int32_t *>(row_order_buffer->data()) + start;
 
-                            auto const &inp_tensor = mini_batch_input->get_input(model_input.mapped_name);
+            auto buffer = MatxUtil::gather_rows(full_tensor, row_indices, rows, cols);
 
-                            // Convert to the right type. Make shallow if necessary
-                            auto final_tensor = inp_tensor.as_type(model_input.datatype);
+            return Tensor::create(std::move(buffer),
+                                  DType(full_tensor.dtype()),
+                                  std::vector<TensorIndex>{rows, cols},
+                                  std::vector<TensorIndex>{},
+                                  0);
+        };
 
-                            std::vector<uint8_t> inp_data = final_tensor.get_host_data();
+        if (m_max_concurrent_requests > 1)
+        {
+            // Blocks (yielding the fiber) until there is room for another outstanding request
+            in_flight->acquire();
+        }
 
-                            // Test
-                            triton::client::InferInput *inp_ptr;
+        // When using shared memory, inputs and outputs for this mini-batch live in a single region
+        std::shared_ptr<const TritonSharedMemoryRegion> region;
 
-                            triton::client::InferInput::Create(&inp_ptr,
-                                                               model_input.name,
-                                                               {inp_tensor.shape(0), inp_tensor.shape(1)},
-                                                               model_input.datatype.triton_str());
-                            std::shared_ptr<triton::client::InferInput> inp_shared;
-                            inp_shared.reset(inp_ptr);
+        if (m_shared_memory_pool)
+        {
+            region = m_shared_memory_pool->acquire();
+        }
 
-                            inp_ptr->AppendRaw(inp_data);
+        // Reused descriptors, held in a shared_ptr since the request data must stay alive until an async request
+        // completes
+        auto request = m_request_pool->acquire();
 
-                            return std::make_pair(inp_shared, std::move(inp_data));
-                        });
+        // Iterate on the model inputs in case the model takes less than what tensors are available
+        for (std::size_t input_idx = 0; input_idx < m_model_inputs.size(); ++input_idx)
+        {
+            const auto &model_input = m_model_inputs[input_idx];
+            auto *input             = request->input_objects[input_idx].get();
 
-                    std::vector<std::shared_ptr<const triton::client::InferRequestedOutput>> saved_outputs =
-                        foreach_map(m_model_outputs, [this](auto const &model_output) {
-                            // Generate the outputs to be requested.
-                            triton::client::InferRequestedOutput *out_ptr;
+            auto inp_tensor = get_mini_batch_input(model_input, input_idx);
 
-                            triton::client::InferRequestedOutput::Create(&out_ptr, model_output.name);
-                            std::shared_ptr<const triton::client::InferRequestedOutput> out_shared;
-                            out_shared.reset(out_ptr);
+            // Converted to the model's type while being written to the region or staging buffer
+            const TensorCastView final_tensor(inp_tensor, model_input.datatype);
 
-                            return out_shared;
-                        });
+            const auto inp_shape = inp_tensor.get_shape();
 
-                    std::vector<triton::client::InferInput *> inputs =
-                        foreach_map(saved_inputs, [](auto x) { return x.first.get(); });
+            // Drops the data, or region, of the previous request
+            CHECK_TRITON(input->Reset());
+            CHECK_TRITON(input->SetShape(std::vector<int64_t>(inp_shape.begin(), inp_shape.end())));
 
-                    std::vector<const triton::client::InferRequestedOutput *> outputs =
-                        foreach_map(saved_outputs, [](auto x) { return x.get(); });
+            if (region)
+            {
+                CHECK(final_tensor.bytes() <= model_input.bytes)
+                    << "Input '" << model_input.name << "' does not fit in the shared memory region";
 
-                    // this->segment().resources().fiber_pool().enqueue([client, output](){});
+                // Stays on the device. Triton reads directly from the region
+                final_tensor.copy_to(region->data + model_input.offset, rmm::cuda_stream_per_thread);
 
-                    triton::client::InferResult *results;
+                CHECK_TRITON(input->SetSharedMemory(region->name, final_tensor.bytes(), model_input.offset));
 
-                    CHECK_TRITON(client->Infer(&results, m_options, inputs, outputs));
+                continue;
+            }
 
-                    for (auto &model_output : m_model_outputs)
-                    {
-                        std::vector<int64_t> output_shape;
+            // Pinned staging copy, every input is queued before the single synchronize below
+            request->staging.emplace_back(final_tensor.copy_to_host_async(rmm::cuda_stream_per_thread));
 
-                        CHECK_TRITON(results->Shape(model_output.name, &output_shape));
+            CHECK_TRITON(input->AppendRaw(request->staging.back().data(), request->staging.back().size()));
+        }
 
-                        // Make sure we have at least 2 dims
-                        while (output_shape.size() < 2)
-                        {
-                            output_shape.push_back(1);
-                        }
+        if (region)
+        {
+            // Every request uses a different region
+            for (std::size_t output_idx = 0; output_idx < m_model_outputs.size(); ++output_idx)
+            {
+                const auto &model_output = m_model_outputs[output_idx];
+
+                CHECK_TRITON(request->output_objects[output_idx]->SetSharedMemory(
+                    region->name, model_output.bytes, model_output.offset));
+            }
+        }
+
+        // The inputs must be written, to the region or the staging buffers, before sending the request
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+        if (m_max_concurrent_requests <= 1)
+        {
+            auto results_ptr =
+                InferenceClientStage__infer(*m_client_pool, m_options, request->inputs, request->outputs);
+
+            this->process_infer_result(*results_ptr, (*mini_batch_outputs)[batch_idx], region.get());
 
-                        const uint8_t *output_ptr = nullptr;
-                        size_t output_ptr_size    = 0;
-                        CHECK_TRITON(results->RawData(model_output.name, &output_ptr, &output_ptr_size));
+            continue;
+        }
+
+        // Kept until the callback completes, so the server's outstanding count includes this request
+        std::shared_ptr<InferenceClientStage__ClientPool::Lease> lease = m_client_pool->acquire();
+
+        auto status = lease->client().async_infer(
+            [this, in_flight, mini_batch_outputs, batch_idx, region, request, lease](
+                triton::client::InferResult *results) {
+                std::unique_ptr<triton::client::InferResult> results_ptr(results);
+
+                try
+                {
+                    // Runs on the client's own worker thread
+                    DeviceAffinity::bind_current_thread(m_device_id);
 
-                        auto output_buffer =
-                            std::make_shared<rmm::device_buffer>(output_ptr_size, rmm::cuda_stream_per_thread);
+                    auto request_status = results_ptr->RequestStatus();
 
-                        NEO_CHECK_CUDA(
-                            cudaMemcpy(output_buffer->data(), output_ptr, output_ptr_size, cudaMemcpyHostToDevice));
+                    if (!request_status.IsOk())
+                    {
+                        lease->fail();
 
-                        // If we need to do logits, do that here
-                        if (m_needs_logits)
+                        if (m_client_pool->size() <= 1)
                         {
-                            size_t element_count =
-                                std::accumulate(output_shape.begin(), output_shape.end(), 1, std::multiplies<>());
-                            output_buffer = MatxUtil::logits(
-                                DevMemInfo{element_count, model_output.datatype.type_id(), output_buffer, 0});
+                            CHECK_TRITON(request_status);
                         }
 
-                        mini_batch_output->set_output(
-                            model_output.mapped_name,
-                            Tensor::create(std::move(output_buffer),
-                                           model_output.datatype,
-                                           std::vector<TensorIndex>{static_cast<int>(output_shape[0]),
-                                                                    static_cast<int>(output_shape[1])},
-                                           std::vector<TensorIndex>{},
-                                           0));
+                        // Send it again to the other servers, blocking this worker thread until it completes
+                        results_ptr =
+                            InferenceClientStage__infer(*m_client_pool, m_options, request->inputs, request->outputs);
                     }
+
+                    this->process_infer_result(*results_ptr, (*mini_batch_outputs)[batch_idx], region.get());
+
+                    in_flight->release();
+                } catch (...)
+                {
+                    in_flight->release(std::current_exception());
                 }
-                output.on_next(std::move(response));
             },
-            [&](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
-            [&]() { output.on_completed(); }));
-    };
-}
+            m_options,
+            request->inputs,
+            request->outputs);
 
-void InferenceClientStage::connect_with_server()
-{
-    std::string server_url = m_server_url;
+        if (!status.IsOk())
+        {
+            // The callback will never be called. Give back the slot before throwing or retrying
+            lease->fail();
+            in_flight->release();
 
-    std::unique_ptr<triton::client::InferenceServerHttpClient> client;
+            if (m_client_pool->size() <= 1)
+            {
+                CHECK_TRITON(status);
+            }
 
-    auto result = triton::client::InferenceServerHttpClient::Create(&client, server_url, false);
+            auto results_ptr =
+                InferenceClientStage__infer(*m_client_pool, m_options, request->inputs, request->outputs);
 
-    // Now load the input/outputs for the model
-    bool is_server_live = false;
+            this->process_infer_result(*results_ptr, (*mini_batch_outputs)[batch_idx], region.get());
+        }
+    }
 
-    triton::client::Error status = client->IsServerLive(&is_server_live);
+    // Only return once every mini-batch has been written. Rethrows any callback errors
+    in_flight->wait_all();
 
-    if (!status.IsOk())
+    for (std::size_t i = 0; i < m_model_outputs.size(); ++i)
     {
-        if (this->is_default_grpc_port(server_url))
-        {
-            LOG(WARNING) << "Failed to connect to Triton at '" << m_server_url
-                         << "'. Default gRPC port of (8001) was detected but C++ "
-                            "InferenceClientStage uses HTTP protocol. Retrying with default HTTP port (8000)";
+        const auto &model_output = m_model_outputs[i];
 
-            // We are using the default gRPC port, try the default HTTP
-            std::unique_ptr<triton::client::InferenceServerHttpClient> unique_client;
+        auto parts = foreach_map(*mini_batch_outputs, [i](auto const &outputs) { return outputs[i]; });
+
+        TensorObject output;
 
-            auto result = triton::client::InferenceServerHttpClient::Create(&unique_client, server_url, false);
+        if (parts.empty())
+        {
+            // No rows, dimensions Triton would have sized are left empty
+            std::vector<TensorIndex> shape{0};
 
-            client = std::move(unique_client);
+            for (std::size_t dim = 1; dim < model_output.shape.size(); ++dim)
+            {
+                shape.push_back(std::max(model_output.shape[dim], 0));
+            }
 
-            status = client->IsServerLive(&is_server_live);
+            output = std::move(Tensor::create_packed({model_output.datatype}, {shape}).front());
         }
-        else if (status.Message().find("Unsupported protocol") != std::string::npos)
+        else
         {
-            throw std::runtime_error(
-                CONCAT_STR("Failed to connect to Triton at '"
-                           << m_server_url
-                           << "'. Received 'Unsupported Protocol' error. Are you using the right port? The C++ "
-                              "InferenceClientStage uses Triton's HTTP protocol instead of gRPC. Ensure you have "
-                              "specified the HTTP port (Default 8000)."));
+            // A lone mini-batch is used as it is
+            output = parts.size() == 1 ? parts.front() : InferenceClientStage__concatenate(parts);
         }
 
-        if (!status.IsOk())
-            throw std::runtime_error(CONCAT_STR("Unable to connect to Triton at '"
-                                                << m_server_url
-                                                << "'. Check the URL and port and ensure the server is running."));
+        CHECK(output.shape(0) == static_cast<TensorIndex>(count))
+            << "Output '" << model_output.name << "' has " << output.shape(0) << " rows, expected " << count;
+
+        memory->outputs[model_output.mapped_name] = std::move(output);
     }
 
-    // Save this for new clients
-    m_server_url = server_url;
+    if (row_order_buffer)
+    {
+        // Put the outputs back into the original row order
+        for (auto &[name, sorted_output] : memory->outputs)
+        {
+            const auto *row_indices = static_cast<const int32_t *>(row_order_buffer->data());
 
-    if (!is_server_live)
-        throw std::runtime_error("Server is not live");
+            auto buffer = MatxUtil::scatter_rows(sorted_output, row_indices);
 
-    bool is_server_ready = false;
-    CHECK_TRITON(client->IsServerReady(&is_server_ready));
+            sorted_output = Tensor::create(std::move(buffer),
+                                           DType(sorted_output.dtype()),
+                                           std::vector<TensorIndex>{sorted_output.shape(0),
+                                                                    sorted_output.shape(1)},
+                                           std::vector<TensorIndex>{},
+                                           0);
+        }
 
-    if (!is_server_ready)
-        throw std::runtime_error("Server is not ready");
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+    }
 
-    bool is_model_ready = false;
-    CHECK_TRITON(client->IsModelReady(&is_model_ready, this->m_model_name));
+    return memory;
+}
 
-    if (!is_model_ready)
-        throw std::runtime_error("Model is not ready");
+void InferenceClientStage::process_infer_result(triton::client::InferResult &results,
+                                                std::vector<TensorObject> &outputs,
+                                                const TritonSharedMemoryRegion *shared_memory_region)
+{
+    outputs.clear();
+    outputs.reserve(m_model_outputs.size());
 
-    std::string model_metadata_json;
-    CHECK_TRITON(client->ModelMetadata(&model_metadata_json, this->m_model_name));
+    for (const auto &model_output : m_model_outputs)
+    {
+        std::vector<int64_t> output_shape;
 
-    auto model_metadata = nlohmann::json::parse(model_metadata_json);
+        CHECK_TRITON(results.Shape(model_output.name, &output_shape));
 
-    std::string model_config_json;
-    CHECK_TRITON(client->ModelConfig(&model_config_json, this->m_model_name));
+        // Make sure we have at least 2 dims, outputs with a single value per row become a column
+        while (output_shape.size() < 2)
+        {
+            output_shape.push_back(1);
+        }
+
+        const auto element_count =
+            std::accumulate(output_shape.begin(), output_shape.end(), std::size_t{1}, std::multiplies<>());
 
-    auto model_config = nlohmann::json::parse(model_config_json);
+        std::shared_ptr<rmm::device_buffer> output_buffer;
+
+        if (shared_memory_region != nullptr)
+        {
+            // Triton wrote the output into the region. Copy it out on the device so the region can be reused
+            const auto *region_ptr = shared_memory_region->data + model_output.offset;
+
+            if (m_needs_logits)
+            {
+                // The sigmoid is written straight from the region, saving a copy
+                output_buffer = std::make_shared<rmm::device_buffer>(element_count * model_output.datatype.item_size(),
+                                                                     rmm::cuda_stream_per_thread);
+
+                MatxUtil::logits_into(
+                    region_ptr, output_buffer->data(), element_count, model_output.datatype.type_id());
+            }
+            else
+            {
+                output_buffer = std::make_shared<rmm::device_buffer>(
+                    region_ptr, element_count * model_output.datatype.item_size(), rmm::cuda_stream_per_thread);
+            }
+
+            NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+        }
+        else
+        {
+            const uint8_t *output_ptr = nullptr;
+            size_t output_ptr_size    = 0;
+            CHECK_TRITON(results.RawData(model_output.name, &output_ptr, &output_ptr_size));
+
+            CHECK(output_ptr_size == element_count * model_output.datatype.item_size())
+                << "Output '" << model_output.name << "' holds " << output_ptr_size << " bytes, which does not match "
+                << "its shape";
+
+            // Only as large as what was returned
+            output_buffer = std::make_shared<rmm::device_buffer>(output_ptr_size, rmm::cuda_stream_per_thread);
+
+            NEO_CHECK_CUDA(cudaMemcpyAsync(output_buffer->data(),
+                                           output_ptr,
+                                           output_ptr_size,
+                                           cudaMemcpyHostToDevice,
+                                           output_buffer->stream().value()));
+
+            if (m_needs_logits)
+            {
+                // Applied in place on the freshly copied buffer rather than allocating another one
+                MatxUtil::logits_into(
+                    output_buffer->data(), output_buffer->data(), element_count, model_output.datatype.type_id());
+            }
+
+            // `results` owns the host memory and is released once we return
+            NEO_CHECK_CUDA(cudaStreamSynchronize(output_buffer->stream().value()));
+        }
+
+        outputs.emplace_back(Tensor::create(std::move(output_buffer),
+                                            model_output.datatype,
+                                            std::vector<TensorIndex>(output_shape.begin(), output_shape.end()),
+                                            std::vector<TensorIndex>{},
+                                            0));
+    }
+}
+
+void InferenceClientStage::connect_with_server()
+{
+    // Usually finished while the rest of the pipeline was being built
+    auto model_info = m_model_info.get();
+
+    const auto &server_urls = model_info->server_urls;
+
+    // Save this for new clients
+    m_server_url = std::accumulate(std::next(server_urls.begin()),
+                                   server_urls.end(),
+                                   server_urls.front(),
+                                   [](std::string joined, const std::string &server_url) {
+                                       return std::move(joined) + "," + server_url;
+                                   });
+
+    m_client_pool = std::make_shared<InferenceClientStage__ClientPool>(m_protocol, m_model_name, server_urls);
+
+    const auto &model_metadata = model_info->metadata;
+    const auto &model_config   = model_info->config;
 
     if (model_config.contains("max_batch_size"))
     {
         m_max_batch_size = model_config.at("max_batch_size").get<int>();
     }
 
+    bool has_dynamic_input  = false;
+    bool has_dynamic_output = false;
+
+    // Rows are gathered and scattered as 2D tensors when bucketing
+    bool has_multi_dim = false;
+
     for (auto const &input : model_metadata.at("inputs"))
     {
         auto shape = input.at("shape").get<std::vector<int>>();
 
         auto dtype = DType::from_triton(input.at("datatype").get<std::string>());
 
+        // Inputs like [batch, sequence] where the sequence length can vary per request
+        bool dynamic_width = shape.size() == 2 && shape[1] == -1;
+        has_dynamic_input |= dynamic_width;
+        has_multi_dim |= shape.size() > 2;
+
+        // Only used to lay out a shared memory region, which must hold a full batch. Buffers outside of the region
+        // are sized by what Triton returns
         size_t bytes = dtype.item_size();
 
-        for (auto &y : shape)
+        for (auto y : shape)
         {
-            if (y == -1)
-            {
-                y = m_max_batch_size;
-            }
-
-            bytes *= y;
+            bytes *= y == -1 ? m_max_batch_size : y;
         }
 
         std::string mapped_name = input.at("name").get<std::string>();
@@ -341,7 +2275,8 @@ void InferenceClientStage::connect_with_server()
                                              DType::from_triton(input.at("datatype").get<std::string>()),
                                              shape,
                                              mapped_name,
-                                             0});
+                                             0,
+                                             dynamic_width});
     }
 
     for (auto const &output : model_metadata.at("outputs"))
@@ -350,16 +2285,16 @@ void InferenceClientStage::connect_with_server()
 
         auto dtype = DType::from_triton(output.at("datatype").get<std::string>());
 
+        has_dynamic_output |= std::find(std::next(shape.begin()), shape.end(), -1) != shape.end();
+        has_multi_dim |= shape.size() > 2;
+
+        // Only used to lay out a shared memory region, which must hold a full batch. Buffers outside of the region
+        // are sized by what Triton returns
         size_t bytes = dtype.item_size();
 
-        for (auto &y : shape)
+        for (auto y : shape)
         {
-            if (y == -1)
-            {
-                y = m_max_batch_size;
-            }
-
-            bytes *= y;
+            bytes *= y == -1 ? m_max_batch_size : y;
         }
 
         std::string mapped_name = output.at("name").get<std::string>();
@@ -372,28 +2307,102 @@ void InferenceClientStage::connect_with_server()
         m_model_outputs.push_back(
             TritonInOut{output.at("name").get<std::string>(), bytes, dtype, shape, mapped_name, 0});
     }
+
+    m_request_pool = std::make_shared<InferenceClientStage__RequestPool>(m_model_inputs, m_model_outputs);
+
+    if (m_length_bucketing && (!has_dynamic_input || has_dynamic_output || has_multi_dim))
+    {
+        // Trimming the sequence only works when the model accepts it and the outputs don't depend on it
+        LOG(WARNING) << "Length bucketing requires model '" << m_model_name
+                     << "' to have 2D inputs with a dynamic sequence length and 2D outputs with a fixed shape. "
+                        "Disabling length bucketing.";
+        m_length_bucketing = false;
+    }
+
+    if (m_cache_size > 0)
+    {
+        if (has_multi_dim)
+        {
+            LOG(WARNING) << "Response caching requires model '" << m_model_name
+                         << "' to have 2D inputs and outputs. Disabling the response cache.";
+        }
+        else
+        {
+            m_response_cache = std::make_shared<InferenceClientStage__ResponseCache>(m_cache_size);
+        }
+    }
+
+    if (m_use_shared_memory)
+    {
+        // Lay out every input and output for a full batch in a single region. One region per outstanding request
+        size_t region_bytes = 0;
+
+        auto assign_offset = [&region_bytes](TritonInOut &inout) {
+            inout.offset = region_bytes;
+            region_bytes += (inout.bytes + SharedMemoryAlignment - 1) / SharedMemoryAlignment * SharedMemoryAlignment;
+        };
+
+        std::for_each(m_model_inputs.begin(), m_model_inputs.end(), assign_offset);
+        std::for_each(m_model_outputs.begin(), m_model_outputs.end(), assign_offset);
+
+        m_shared_memory_pool = std::make_unique<TritonSharedMemoryPool>(
+            CONCAT_STR("morpheus_" << m_model_name << "_" << getpid() << "_" << this),
+            region_bytes,
+            m_max_concurrent_requests);
+
+        // Every server reads from the same regions
+        m_client_pool->for_each_server([this](const std::string &, InferenceClientStage__Client &server_client) {
+            for (auto const &region : m_shared_memory_pool->regions())
+            {
+                CHECK_TRITON(server_client.register_cuda_shared_memory(region));
+            }
+        });
+    }
 }
 
-bool InferenceClientStage::is_default_grpc_port(std::string &server_url)
+void InferenceClientStage::warmup()
 {
-    // Check if we are the default gRPC port of 8001 and try 8000 for http client instead
-    size_t colon_loc = server_url.find_last_of(':');
-
-    if (colon_loc == -1)
+    if (m_max_batch_size <= 0)
     {
-        return false;
+        LOG(WARNING) << "Model '" << m_model_name << "' does not support batching, skipping the warmup request";
+        return;
     }
 
-    // Check if the port matches 8001
-    if (server_url.size() < colon_loc + 1 || server_url.substr(colon_loc + 1) != "8001")
+    const auto rows = static_cast<TensorIndex>(m_max_batch_size);
+
+    // Zeros for every input, dynamic dimensions have a size of 1
+    std::vector<TensorObject> inputs;
+
+    for (auto const &model_input : m_model_inputs)
     {
-        return false;
+        std::vector<TensorIndex> shape{rows};
+
+        for (std::size_t dim = 1; dim < model_input.shape.size(); ++dim)
+        {
+            shape.push_back(model_input.shape[dim] == -1 ? 1 : model_input.shape[dim]);
+        }
+
+        auto elements = std::accumulate(shape.begin(), shape.end(), TensorIndex{1}, std::multiplies<>());
+
+        auto buffer = std::make_shared<rmm::device_buffer>(elements * model_input.datatype.item_size(),
+                                                           rmm::cuda_stream_per_thread);
+
+        NEO_CHECK_CUDA(cudaMemsetAsync(buffer->data(), 0, buffer->size(), rmm::cuda_stream_per_thread));
+
+        inputs.emplace_back(
+            Tensor::create(std::move(buffer), model_input.datatype, std::move(shape), std::vector<TensorIndex>{}, 0));
     }
 
-    // It matches, change to 8000
-    server_url = server_url.substr(0, colon_loc) + ":8000";
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
 
-    return true;
+    const auto start = std::chrono::steady_clock::now();
+
+    // Bypasses the response cache, the outputs are discarded
+    this->infer_rows(inputs, nullptr, static_cast<std::size_t>(rows));
+
+    LOG(INFO) << "Warmup request of " << rows << " rows for model '" << m_model_name << "' took "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count()
+              << " ms";
 }
 
 // ************ InferenceClientStageInterfaceProxy********* //
@@ -405,12 +2414,66 @@ std::shared_ptr<InferenceClientStage> InferenceClientStageInterfaceProxy::init(
     bool force_convert_inputs,
     bool use_shared_memory,
     bool needs_logits,
-    std::map<std::string, std::string> inout_mapping)
+    std::map<std::string, std::string> inout_mapping,
+    std::size_t max_concurrent_requests,
+    const std::string &protocol,
+    bool length_bucketing,
+    int32_t device_id,
+    int32_t batch_timeout_ms,
+    std::size_t cache_size,
+    const std::string &window_reduction,
+    bool warmup)
 {
-    auto stage = std::make_shared<InferenceClientStage>(
-        parent, name, model_name, server_url, force_convert_inputs, use_shared_memory, needs_logits, inout_mapping);
+    InferenceClientProtocol client_protocol;
+
+    if (protocol == "http")
+    {
+        client_protocol = InferenceClientProtocol::HTTP;
+    }
+    else if (protocol == "grpc")
+    {
+        client_protocol = InferenceClientProtocol::GRPC;
+    }
+    else
+    {
+        throw std::invalid_argument("Unknown protocol '" + protocol +
+                                    "' for InferenceClientStage. Must be one of 'http' or 'grpc'.");
+    }
+
+    RowReduction reduction;
+
+    if (window_reduction == "max")
+    {
+        reduction = RowReduction::MAX;
+    }
+    else if (window_reduction == "mean")
+    {
+        reduction = RowReduction::MEAN;
+    }
+    else
+    {
+        throw std::invalid_argument("Unknown window reduction '" + window_reduction +
+                                    "' for InferenceClientStage. Must be one of 'max' or 'mean'.");
+    }
 
-    parent.register_node<InferenceClientStage>(stage);
+    auto stage = std::make_shared<InferenceClientStage>(parent,
+                                                        name,
+                                                        model_name,
+                                                        server_url,
+                                                        force_convert_inputs,
+                                                        use_shared_memory,
+                                                        needs_logits,
+                                                        inout_mapping,
+                                                        max_concurrent_requests,
+                                                        client_protocol,
+                                                        length_bucketing,
+                                                        device_id,
+                                                        batch_timeout_ms,
+                                                        cache_size,
+                                                        reduction,
+                                                        warmup);
+
+    FusedStageBuilder::register_node(parent, stage);
 
     return stage;
 }
@@ -0,0 +1,117 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/ucx_source.hpp>
+
+#include <morpheus/io/ucx_transport.hpp>
+
+#include <neo/core/segment.hpp>
+
+#include <glog/logging.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace morpheus {
+// Component-private free functions.
+// ************ UcxSourceStage__ ************ //
+// How often the stage checks whether the downstream unsubscribed while no tables arrive
+constexpr std::chrono::milliseconds UcxSourceStage__PollInterval{100};
+
+// Component public implementations
+// ************ UcxSourceStage ************* //
+UcxSourceStage::UcxSourceStage(const neo::Segment &parent,
+                               const std::string &name,
+                               std::string address,
+                               uint16_t port,
+                               std::size_t num_senders,
+                               std::map<std::string, std::string> output_columns) :
+  neo::SegmentObject(parent, name),
+  base_t(parent, name),
+  m_address(std::move(address)),
+  m_port(port),
+  m_num_senders(num_senders)
+{
+    for (const auto &[column_name, column_type] : output_columns)
+    {
+        m_output_column_names.push_back(column_name);
+        m_output_column_types.push_back(DataType::from_numpy(column_type).type_id());
+    }
+
+    this->set_source_observable(neo::Observable<source_type_t>([this](neo::Subscriber<source_type_t> &sub) {
+        try
+        {
+            this->receive_all(sub);
+        } catch (...)
+        {
+            sub.on_error(std::current_exception());
+            return;
+        }
+
+        sub.on_completed();
+    }));
+}
+
+void UcxSourceStage::receive_all(neo::Subscriber<source_type_t> &sub)
+{
+    // Listens from the start of the run, on the thread which receives every table
+    UcxReceiver receiver(m_address, m_port, m_num_senders);
+
+    while (sub.is_subscribed() && !receiver.done())
+    {
+        auto received = receiver.receive(UcxSourceStage__PollInterval);
+
+        if (!received)
+        {
+            continue;
+        }
+
+        // The output columns of this pipeline, the senders may have reserved different ones
+        MessageMeta::reserve_columns(received->table, m_output_column_names, m_output_column_types);
+
+        auto meta = MessageMeta::create_from_cpp(std::move(received->table), received->num_indices);
+        meta->set_trace(MessageTrace::sample(MessageTrace::now_ns()));
+
+        sub.on_next(std::move(meta));
+    }
+
+    VLOG(10) << "Received " << receiver.bytes_received() << " bytes over UCX";
+}
+
+// ************ UcxSourceStageInterfaceProxy ************ //
+std::shared_ptr<UcxSourceStage> UcxSourceStageInterfaceProxy::init(neo::Segment &parent,
+                                                                   const std::string &name,
+                                                                   std::string address,
+                                                                   uint16_t port,
+                                                                   std::size_t num_senders,
+                                                                   std::map<std::string, std::string> output_columns)
+{
+    auto stage = std::make_shared<UcxSourceStage>(
+        parent, name, std::move(address), port, num_senders, std::move(output_columns));
+
+    parent.register_node<UcxSourceStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -0,0 +1,587 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/validation.hpp>
+
+#include <morpheus/io/serializers.hpp>
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+#include <morpheus/utilities/table_util.hpp>
+
+#include <neo/core/segment_object.hpp>
+
+#include <cudf/aggregation.hpp>
+#include <cudf/binaryop.hpp>
+#include <cudf/column/column.hpp>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/column/column_view.hpp>
+#include <cudf/copying.hpp>
+#include <cudf/filling.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/join.hpp>
+#include <cudf/reduction.hpp>
+#include <cudf/replace.hpp>
+#include <cudf/scalar/scalar.hpp>
+#include <cudf/stream_compaction.hpp>
+#include <cudf/table/table.hpp>
+#include <cudf/table/table_view.hpp>
+#include <cudf/unary.hpp>
+#include <cudf/utilities/traits.hpp>
+
+#include <glog/logging.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ ValidationStage__State ************ //
+/**
+ * @brief The expected table and the running statistics. The layout of the compared columns is taken from the first
+ * message, every following message must have the same columns.
+ */
+struct ValidationStage__State
+{
+    cudf::io::table_with_metadata expected;
+    int expected_index_count{0};
+
+    // Key of every expected row, a column of `expected` or the row positions
+    cudf::column_view expected_key;
+    std::unique_ptr<cudf::column> expected_positions;
+
+    // Set for the expected rows which were found in the results
+    std::unique_ptr<cudf::column> seen;
+
+    bool layout_known{false};
+    std::vector<std::string> compare_columns;      // In the order of the expected table
+    std::vector<cudf::size_type> expected_columns;  // Positions in `expected` of `compare_columns`
+    std::vector<std::string> missing_columns;
+    std::vector<std::string> extra_columns;
+
+    uint64_t result_rows{0};
+    uint64_t joined_rows{0};
+    uint64_t matching_rows{0};
+    std::vector<uint64_t> column_mismatches;  // One per compared column
+
+    nlohmann::json samples = nlohmann::json::array();
+};
+
+// Component-private free functions.
+/**
+ * @brief Same selection as the python stage, names matching any of `include`, or every name when it is empty,
+ * without those matching any of `exclude`. Expressions only have to match the start of the name, like `re.match`.
+ */
+std::vector<std::string> ValidationStage__select(const std::vector<std::string> &names,
+                                                 const std::vector<std::string> &include,
+                                                 const std::vector<std::string> &exclude)
+{
+    auto to_regex = [](const std::vector<std::string> &expressions) {
+        std::vector<std::regex> result;
+        std::transform(expressions.begin(), expressions.end(), std::back_inserter(result), [](const auto &expr) {
+            return std::regex(expr);
+        });
+        return result;
+    };
+
+    const auto include_regex = to_regex(include);
+    const auto exclude_regex = to_regex(exclude);
+
+    auto matches_any = [](const std::string &name, const std::vector<std::regex> &expressions) {
+        return std::any_of(expressions.begin(), expressions.end(), [&name](const auto &expr) {
+            return std::regex_search(name, expr, std::regex_constants::match_continuous);
+        });
+    };
+
+    std::vector<std::string> selected;
+
+    for (const auto &name : names)
+    {
+        if ((include_regex.empty() || matches_any(name, include_regex)) && !matches_any(name, exclude_regex))
+        {
+            selected.push_back(name);
+        }
+    }
+
+    return selected;
+}
+
+uint64_t ValidationStage__count_true(const cudf::column_view &mask)
+{
+    if (mask.size() == 0)
+    {
+        return 0;
+    }
+
+    const auto int64_type = cudf::data_type{cudf::type_id::INT64};
+
+    auto as_int = cudf::cast(mask, int64_type);
+    auto sum    = cudf::reduce(as_int->view(), cudf::make_sum_aggregation<cudf::reduce_aggregation>(), int64_type);
+
+    return static_cast<uint64_t>(static_cast<cudf::numeric_scalar<int64_t> &>(*sum).value());
+}
+
+bool ValidationStage__castable(cudf::data_type type)
+{
+    return cudf::is_numeric(type) || cudf::is_boolean(type);
+}
+
+/**
+ * @brief Returns a BOOL8 column without nulls, true where the rows of `val` and `res` match.
+ */
+std::unique_ptr<cudf::column> ValidationStage__match(const cudf::column_view &val,
+                                                     const cudf::column_view &res,
+                                                     double abs_tol,
+                                                     double rel_tol)
+{
+    const auto bool_type = cudf::data_type{cudf::type_id::BOOL8};
+
+    if (val.type() != res.type() && !(ValidationStage__castable(val.type()) && ValidationStage__castable(res.type())))
+    {
+        return cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(false), val.size());
+    }
+
+    if (cudf::is_floating_point(val.type()) || cudf::is_floating_point(res.type()))
+    {
+        const auto float_type = cudf::data_type{cudf::type_id::FLOAT64};
+
+        auto val_float = cudf::cast(val, float_type);
+        auto res_float = cudf::cast(res, float_type);
+
+        // Same test as `numpy.isclose`, |res - val| <= abs_tol + rel_tol * |res|
+        auto diff =
+            cudf::binary_operation(val_float->view(), res_float->view(), cudf::binary_operator::SUB, float_type);
+        auto abs_diff = cudf::unary_operation(diff->view(), cudf::unary_operator::ABS);
+        auto abs_res  = cudf::unary_operation(res_float->view(), cudf::unary_operator::ABS);
+
+        auto bound = cudf::binary_operation(
+            abs_res->view(), cudf::numeric_scalar<double>(rel_tol), cudf::binary_operator::MUL, float_type);
+        bound = cudf::binary_operation(
+            bound->view(), cudf::numeric_scalar<double>(abs_tol), cudf::binary_operator::ADD, float_type);
+
+        auto close =
+            cudf::binary_operation(abs_diff->view(), bound->view(), cudf::binary_operator::LESS_EQUAL, bool_type);
+
+        // Null where either side is null, in which case they only match when both are
+        auto equal = cudf::binary_operation(
+            val_float->view(), res_float->view(), cudf::binary_operator::NULL_EQUALS, bool_type);
+
+        return cudf::replace_nulls(close->view(), equal->view());
+    }
+
+    if (val.type() != res.type())
+    {
+        auto res_cast = cudf::cast(res, val.type());
+
+        return cudf::binary_operation(val, res_cast->view(), cudf::binary_operator::NULL_EQUALS, bool_type);
+    }
+
+    return cudf::binary_operation(val, res, cudf::binary_operator::NULL_EQUALS, bool_type);
+}
+
+/**
+ * @brief Formats the first `count` rows of `table` selected by `mask` as JSON records, keeping the host copy small.
+ */
+nlohmann::json ValidationStage__samples(cudf::table_view table,
+                                        std::vector<std::string> column_names,
+                                        const cudf::column_view &mask,
+                                        std::size_t count)
+{
+    auto selected = cudf::apply_boolean_mask(table, mask);
+
+    const auto num_rows = std::min(static_cast<cudf::size_type>(count), selected->num_rows());
+    auto first_rows     = cudf::slice(selected->view(), {0, num_rows}).front();
+
+    cudf::io::table_with_metadata sample{std::make_unique<cudf::table>(first_rows), cudf::io::table_metadata{}};
+    sample.metadata.column_names = std::move(column_names);
+
+    auto meta = MessageMeta::create_from_cpp(std::move(sample), 0);
+
+    std::istringstream lines(df_to_json(meta->get_info()));
+
+    auto records = nlohmann::json::array();
+
+    for (std::string line; std::getline(lines, line);)
+    {
+        if (!line.empty())
+        {
+            records.push_back(nlohmann::json::parse(line));
+        }
+    }
+
+    return records;
+}
+
+// Component public implementations
+// ************ ValidationStage **************************** //
+ValidationStage::ValidationStage(const neo::Segment &parent,
+                                 const std::string &name,
+                                 std::string val_file_name,
+                                 std::string results_file_name,
+                                 std::vector<std::string> include,
+                                 std::vector<std::string> exclude,
+                                 std::string index_col,
+                                 double abs_tol,
+                                 double rel_tol,
+                                 std::size_t max_samples) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_val_file_name(std::move(val_file_name)),
+  m_results_file_name(std::move(results_file_name)),
+  m_include(std::move(include)),
+  m_exclude(std::move(exclude)),
+  m_index_col(std::move(index_col)),
+  m_abs_tol(abs_tol),
+  m_rel_tol(rel_tol),
+  m_max_samples(max_samples),
+  m_metrics(StageMetrics::get(name))
+{}
+
+ValidationStage::operator_fn_t ValidationStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        auto state = std::make_shared<ValidationStage__State>();
+
+        {
+            DeviceMemory::ScopedTag memory_tag("ValidationStage");
+
+            state->expected             = CuDFTableUtil::load_table(m_val_file_name);
+            state->expected_index_count = CuDFTableUtil::get_index_col_count(state->expected);
+
+            const auto &names    = state->expected.metadata.column_names;
+            const auto num_rows  = state->expected.tbl->num_rows();
+            auto expected_view   = state->expected.tbl->view();
+            const auto named_key = std::find(names.begin(), names.end(), m_index_col);
+
+            if (!m_index_col.empty() && named_key != names.end())
+            {
+                state->expected_key = expected_view.column(named_key - names.begin());
+            }
+            else if (state->expected_index_count > 0)
+            {
+                state->expected_key = expected_view.column(0);
+            }
+            else
+            {
+                state->expected_positions = cudf::sequence(num_rows, cudf::numeric_scalar<int64_t>(0));
+                state->expected_key       = state->expected_positions->view();
+            }
+
+            state->seen = cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(false), num_rows);
+        }
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, state, &output](reader_type_t &&x) {
+                StageMetrics::Scope metrics_scope(*m_metrics, x);
+
+                this->compare(*state, *x);
+
+                metrics_scope.emit(output, std::move(x));
+            },
+            [&output](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [this, state, &output]() {
+                this->write_results(*state);
+
+                output.on_completed();
+            }));
+    };
+}
+
+void ValidationStage::compare(ValidationStage__State &state, MultiMessage &x) const
+{
+    if (x.mess_count == 0)
+    {
+        return;
+    }
+
+    MORPHEUS_DEVICE_RANGE("ValidationStage::compare");
+    DeviceMemory::ScopedTag memory_tag("ValidationStage");
+
+    auto info                = x.get_meta();
+    const auto view          = info.get_view();
+    const auto num_indices   = info.num_indices();
+    const auto &column_names = info.get_column_names();
+
+    auto find_column = [&column_names](const std::string &name) -> cudf::size_type {
+        auto found = std::find(column_names.begin(), column_names.end(), name);
+        return found == column_names.end() ? -1 : static_cast<cudf::size_type>(found - column_names.begin());
+    };
+
+    if (!state.layout_known)
+    {
+        // Index columns, and the key column, are matched by the join rather than compared
+        const auto &expected_names = state.expected.metadata.column_names;
+
+        std::vector<std::string> expected_data;
+        std::copy_if(expected_names.begin() + state.expected_index_count,
+                     expected_names.end(),
+                     std::back_inserter(expected_data),
+                     [this](const auto &name) { return name != m_index_col; });
+
+        std::vector<std::string> result_data;
+        std::copy_if(column_names.begin(),
+                     column_names.end(),
+                     std::back_inserter(result_data),
+                     [this](const auto &name) { return name != m_index_col; });
+
+        const auto val_columns = ValidationStage__select(expected_data, m_include, m_exclude);
+        const auto res_columns = ValidationStage__select(result_data, m_include, m_exclude);
+
+        for (const auto &name : val_columns)
+        {
+            if (std::find(res_columns.begin(), res_columns.end(), name) == res_columns.end())
+            {
+                state.missing_columns.push_back(name);
+                continue;
+            }
+
+            state.compare_columns.push_back(name);
+            state.expected_columns.push_back(
+                static_cast<cudf::size_type>(std::find(expected_names.begin(), expected_names.end(), name) -
+                                             expected_names.begin()));
+        }
+
+        std::copy_if(res_columns.begin(),
+                     res_columns.end(),
+                     std::back_inserter(state.extra_columns),
+                     [&val_columns](const auto &name) {
+                         return std::find(val_columns.begin(), val_columns.end(), name) == val_columns.end();
+                     });
+
+        // Sorted like `Index.difference`
+        std::sort(state.missing_columns.begin(), state.missing_columns.end());
+        std::sort(state.extra_columns.begin(), state.extra_columns.end());
+
+        state.column_mismatches.assign(state.compare_columns.size(), 0);
+        state.layout_known = true;
+    }
+
+    // Key of the message rows
+    cudf::column_view key;
+    const auto key_idx = m_index_col.empty() ? -1 : find_column(m_index_col);
+
+    if (key_idx >= 0)
+    {
+        key = view.column(num_indices + key_idx);
+    }
+    else if (num_indices > 0)
+    {
+        key = view.column(0);
+    }
+    else
+    {
+        throw std::invalid_argument("ValidationStage: the message has no index and no column named '" + m_index_col +
+                                    "' to join on");
+    }
+
+    std::unique_ptr<cudf::column> key_cast;
+
+    if (key.type() != state.expected_key.type())
+    {
+        if (!ValidationStage__castable(key.type()) || !ValidationStage__castable(state.expected_key.type()))
+        {
+            throw std::invalid_argument("ValidationStage: the key of the message and of the expected results have "
+                                        "different types");
+        }
+
+        key_cast = cudf::cast(key, state.expected_key.type());
+        key      = key_cast->view();
+    }
+
+    auto [res_map, val_map] = cudf::inner_join(cudf::table_view{{key}}, cudf::table_view{{state.expected_key}});
+
+    const auto joined = static_cast<cudf::size_type>(res_map->size());
+
+    state.result_rows += x.mess_count;
+    state.joined_rows += joined;
+
+    if (joined == 0)
+    {
+        return;
+    }
+
+    const cudf::column_view res_rows{cudf::data_type{cudf::type_id::INT32}, joined, res_map->data()};
+    const cudf::column_view val_rows{cudf::data_type{cudf::type_id::INT32}, joined, val_map->data()};
+
+    const cudf::numeric_scalar<bool> found(true);
+    const std::vector<std::reference_wrapper<const cudf::scalar>> found_values{found};
+    auto seen = cudf::scatter(found_values, val_rows, cudf::table_view{{state.seen->view()}});
+    state.seen = std::move(seen->release().front());
+
+    const auto expected_view = state.expected.tbl->view();
+
+    std::vector<cudf::column_view> res_columns;
+    std::vector<cudf::column_view> val_columns;
+
+    for (std::size_t i = 0; i < state.compare_columns.size(); ++i)
+    {
+        const auto column_idx = find_column(state.compare_columns[i]);
+
+        if (column_idx < 0)
+        {
+            throw std::invalid_argument("ValidationStage: the message has no column named '" +
+                                        state.compare_columns[i] + "', every message must have the same columns");
+        }
+
+        res_columns.push_back(view.column(num_indices + column_idx));
+        val_columns.push_back(expected_view.column(state.expected_columns[i]));
+    }
+
+    // Only the joined rows are compared, in the same order on both sides
+    auto res = cudf::gather(cudf::table_view{res_columns}, res_rows);
+    auto val = cudf::gather(cudf::table_view{val_columns}, val_rows);
+
+    const auto bool_type = cudf::data_type{cudf::type_id::BOOL8};
+
+    auto row_match = cudf::make_column_from_scalar(cudf::numeric_scalar<bool>(true), joined);
+
+    for (std::size_t i = 0; i < state.compare_columns.size(); ++i)
+    {
+        auto match = ValidationStage__match(val->get_column(i).view(), res->get_column(i).view(), m_abs_tol, m_rel_tol);
+
+        state.column_mismatches[i] += joined - ValidationStage__count_true(match->view());
+
+        row_match =
+            cudf::binary_operation(row_match->view(), match->view(), cudf::binary_operator::LOGICAL_AND, bool_type);
+    }
+
+    const auto matching = ValidationStage__count_true(row_match->view());
+    state.matching_rows += matching;
+
+    if (matching == static_cast<uint64_t>(joined) || state.samples.size() >= m_max_samples)
+    {
+        return;
+    }
+
+    auto mismatch = cudf::unary_operation(row_match->view(), cudf::unary_operator::NOT);
+    auto keys     = cudf::gather(cudf::table_view{{state.expected_key}}, val_rows);
+
+    // Expected and actual values side by side
+    std::vector<cudf::column_view> sample_columns{keys->get_column(0).view()};
+    std::vector<std::string> sample_names{m_index_col.empty() ? "index" : m_index_col};
+
+    for (std::size_t i = 0; i < state.compare_columns.size(); ++i)
+    {
+        sample_columns.push_back(val->get_column(i).view());
+        sample_names.push_back(state.compare_columns[i] + "_val");
+        sample_columns.push_back(res->get_column(i).view());
+        sample_names.push_back(state.compare_columns[i] + "_res");
+    }
+
+    auto records = ValidationStage__samples(cudf::table_view{sample_columns},
+                                            std::move(sample_names),
+                                            mismatch->view(),
+                                            m_max_samples - state.samples.size());
+
+    for (auto &record : records)
+    {
+        state.samples.push_back(std::move(record));
+    }
+}
+
+void ValidationStage::write_results(const ValidationStage__State &state) const
+{
+    const auto total_rows    = static_cast<uint64_t>(state.expected.tbl->num_rows());
+    const auto found_rows    = ValidationStage__count_true(state.seen->view());
+    const auto matching_rows = std::min(state.matching_rows, total_rows);
+    const auto diff_rows     = total_rows - matching_rows;
+
+    nlohmann::json results;
+    results["total_rows"]    = total_rows;
+    results["matching_rows"] = matching_rows;
+    results["diff_rows"]     = diff_rows;
+    results["matching_cols"] = state.compare_columns;
+    results["extra_cols"]    = state.extra_columns;
+    results["missing_cols"]  = state.missing_columns;
+
+    // Not written by the python stage
+    results["missing_rows"]     = total_rows - found_rows;
+    results["extra_rows"]       = state.result_rows - std::min(state.joined_rows, state.result_rows);
+    results["mismatch_samples"] = state.samples;
+
+    auto column_mismatches = nlohmann::json::object();
+
+    for (std::size_t i = 0; i < state.compare_columns.size(); ++i)
+    {
+        column_mismatches[state.compare_columns[i]] = state.column_mismatches[i];
+    }
+
+    results["column_mismatches"] = std::move(column_mismatches);
+
+    if (diff_rows == 0 && state.extra_columns.empty() && state.missing_columns.empty())
+    {
+        LOG(INFO) << "Results match validation dataset";
+    }
+    else
+    {
+        LOG(WARNING) << "Results do not match. Diff " << diff_rows << "/" << total_rows << " ("
+                     << (total_rows > 0 ? diff_rows * 100.0 / total_rows : 0.0) << " %)";
+    }
+
+    std::ofstream out_file(m_results_file_name);
+
+    if (!out_file)
+    {
+        throw std::runtime_error("ValidationStage: cannot open '" + m_results_file_name + "' for writing");
+    }
+
+    // Keys are sorted, like `json.dump(sort_keys=True)`
+    out_file << results.dump(2) << std::endl;
+}
+
+// ************ ValidationStageInterfaceProxy ************* //
+std::shared_ptr<ValidationStage> ValidationStageInterfaceProxy::init(neo::Segment &parent,
+                                                                     const std::string &name,
+                                                                     std::string val_file_name,
+                                                                     std::string results_file_name,
+                                                                     std::vector<std::string> include,
+                                                                     std::vector<std::string> exclude,
+                                                                     std::string index_col,
+                                                                     double abs_tol,
+                                                                     double rel_tol,
+                                                                     std::size_t max_samples)
+{
+    auto stage = std::make_shared<ValidationStage>(parent,
+                                                   name,
+                                                   std::move(val_file_name),
+                                                   std::move(results_file_name),
+                                                   std::move(include),
+                                                   std::move(exclude),
+                                                   std::move(index_col),
+                                                   abs_tol,
+                                                   rel_tol,
+                                                   max_samples);
+
+    parent.register_node<ValidationStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -17,56 +17,913 @@
 
 #include <morpheus/stages/write_to_file.hpp>
 
+#include <morpheus/io/async_file_writer.hpp>
+#include <morpheus/io/device_file_sink.hpp>
+#include <morpheus/io/gpu_compressed_sink.hpp>
+#include <morpheus/io/serializers.hpp>
 #include <morpheus/utilities/matx_util.hpp>
 
+#include <cudf/interop.hpp>
+#include <cudf/io/orc.hpp>
+#include <cudf/io/parquet.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/table/table_view.hpp>
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/table.h>
+#include <arrow/util/compression.h>
+
+#include <glog/logging.h>
+#include <zlib.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <ctime>
+#include <deque>
 #include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace morpheus {
+// Component-private free functions.
+// ************ WriteToFileStage__constants ************ //
+// Rotated files are read this many bytes at a time while compressing
+constexpr std::size_t GzipChunkBytes = 1 << 20;
+
+/**
+ * @brief Formats `table` as CSV or JSON lines into `sink` and returns the compressed output.
+ */
+std::string WriteToFileStage__compress(const TableInfo &table,
+                                       FileTypes file_type,
+                                       bool include_header,
+                                       GpuCompressedSink &sink)
+{
+    if (file_type == FileTypes::CSV)
+    {
+        df_to_csv(table, sink, include_header);
+    }
+    else
+    {
+        df_to_json(table, sink);
+    }
+
+    sink.flush();
+
+    return sink.release();
+}
+
+// Component-private classes.
+// ************ WriteToFileStage__FileWriter ************ //
+/**
+ * @brief Writes messages to a single output file.
+ */
+class WriteToFileStage__FileWriter
+{
+  public:
+    virtual ~WriteToFileStage__FileWriter() = default;
+
+    virtual void write(const TableInfo &table) = 0;
+
+    virtual void close() = 0;
+
+    /**
+     * @brief Bytes written to the file so far, used to decide when to rotate.
+     */
+    virtual std::size_t bytes_written() const = 0;
+};
+
+// ************ WriteToFileStage__StreamWriter ************ //
+/**
+ * @brief Writes messages synchronously. Formatted output still on the device, the CSV writer's and `df_to_json`'s,
+ * goes straight to the file through a `DeviceFileSink` rather than being staged in a host stream first.
+ */
+class WriteToFileStage__StreamWriter : public WriteToFileStage__FileWriter
+{
+  public:
+    WriteToFileStage__StreamWriter(const std::string &filename,
+                                   std::ios::openmode mode,
+                                   FileTypes file_type,
+                                   std::optional<GpuCompressionCodec> codec) :
+      m_file_type(file_type),
+      m_file(filename, (mode & std::ios::app) != 0)
+    {
+        if (codec.has_value())
+        {
+            m_sink = std::make_unique<GpuCompressedSink>(*codec);
+        }
+    }
+
+    void write(const TableInfo &table) override
+    {
+        if (m_sink)
+        {
+            auto data = WriteToFileStage__compress(table, m_file_type, m_is_first, *m_sink);
+
+            m_file.host_write(data.data(), data.size());
+        }
+        else if (m_file_type == FileTypes::CSV)
+        {
+            // Every file gets its own header
+            df_to_csv(table, m_file, m_is_first);
+        }
+        else
+        {
+            df_to_json(table, m_file);
+        }
+
+        m_is_first = false;
+    }
+
+    void close() override
+    {
+        m_file.close();
+    }
+
+    std::size_t bytes_written() const override
+    {
+        return m_file.file_size();
+    }
+
+  private:
+    FileTypes m_file_type;
+    bool m_is_first{true};
+    DeviceFileSink m_file;
+    std::unique_ptr<GpuCompressedSink> m_sink;
+};
+
+// ************ WriteToFileStage__QueuedWriter ************ //
+/**
+ * @brief Formats messages on the calling thread and hands them to an `AsyncFileWriter`, so formatting overlaps the
+ * file writes.
+ */
+class WriteToFileStage__QueuedWriter : public WriteToFileStage__FileWriter
+{
+  public:
+    WriteToFileStage__QueuedWriter(const std::string &filename,
+                                   bool append,
+                                   FileTypes file_type,
+                                   std::size_t queue_size,
+                                   FileFlushPolicy policy,
+                                   std::optional<GpuCompressionCodec> codec) :
+      m_file_type(file_type),
+      m_writer(filename, append, queue_size, policy)
+    {
+        if (codec.has_value())
+        {
+            m_sink = std::make_unique<GpuCompressedSink>(*codec);
+        }
+    }
+
+    void write(const TableInfo &table) override
+    {
+        std::string data;
+
+        if (m_sink)
+        {
+            data = WriteToFileStage__compress(table, m_file_type, m_is_first, *m_sink);
+        }
+        else
+        {
+            data = m_file_type == FileTypes::CSV ? df_to_csv(table, m_is_first) : df_to_json(table);
+        }
+
+        m_bytes_written += data.size();
+        m_is_first = false;
+
+        m_writer.write(std::move(data));
+    }
+
+    void close() override
+    {
+        m_writer.close();
+    }
+
+    std::size_t bytes_written() const override
+    {
+        return m_bytes_written;
+    }
+
+  private:
+    FileTypes m_file_type;
+    bool m_is_first{true};
+    std::size_t m_bytes_written{0};
+    AsyncFileWriter m_writer;
+    std::unique_ptr<GpuCompressedSink> m_sink;
+};
+
+// ************ WriteToFileStage__ColumnarWriter ************ //
+/**
+ * @brief Base of the writers for the columnar formats. The output file is opened lazily on the first message, since
+ * the schema is taken from it, and every later message must have the same column names. Only the data columns are
+ * written, the index is dropped.
+ */
+class WriteToFileStage__ColumnarWriter : public WriteToFileStage__FileWriter
+{
+  public:
+    explicit WriteToFileStage__ColumnarWriter(std::string filename) : m_filename(std::move(filename)) {}
+
+    void write(const TableInfo &table) override
+    {
+        auto column_names = table.get_column_names();
+
+        if (!m_is_open)
+        {
+            m_column_names = column_names;
+            this->open(this->data_view(table));
+            m_is_open = true;
+        }
+        else if (column_names != m_column_names)
+        {
+            throw std::runtime_error("Every message written to '" + m_filename +
+                                     "' must have the same columns as the first message");
+        }
+
+        this->write_chunk(this->data_view(table));
+    }
+
+    void close() override
+    {
+        if (m_is_open)
+        {
+            this->close_file();
+            m_is_open = false;
+        }
+    }
+
+    std::size_t bytes_written() const override
+    {
+        // Every chunk is flushed to the file as it is written
+        return m_is_open ? std::filesystem::file_size(m_filename) : 0;
+    }
+
+  protected:
+    virtual void open(const cudf::table_view &data) = 0;
+    virtual void write_chunk(const cudf::table_view &data) = 0;
+    virtual void close_file() = 0;
+
+    cudf::io::table_input_metadata make_metadata(const cudf::table_view &data) const
+    {
+        cudf::io::table_input_metadata metadata(data);
+
+        for (std::size_t i = 0; i < m_column_names.size(); ++i)
+        {
+            metadata.column_metadata[i].set_name(m_column_names[i]);
+        }
+
+        return metadata;
+    }
+
+    const std::string m_filename;
+    std::vector<std::string> m_column_names;
+
+  private:
+    cudf::table_view data_view(const TableInfo &table) const
+    {
+        std::vector<cudf::size_type> data_columns(table.num_columns());
+        std::iota(data_columns.begin(), data_columns.end(), table.num_indices());
+
+        return table.get_view().select(data_columns);
+    }
+
+    bool m_is_open{false};
+};
+
+// ************ WriteToFileStage__ParquetWriter ************ //
+class WriteToFileStage__ParquetWriter : public WriteToFileStage__ColumnarWriter
+{
+  public:
+    WriteToFileStage__ParquetWriter(std::string filename, const std::string &compression) :
+      WriteToFileStage__ColumnarWriter(std::move(filename)),
+      m_compression(WriteToFileStage__ParquetWriter::parse_compression(compression))
+    {}
+
+    static cudf::io::compression_type parse_compression(const std::string &compression)
+    {
+        if (compression.empty() || compression == "snappy")
+        {
+            return cudf::io::compression_type::SNAPPY;
+        }
+        if (compression == "none")
+        {
+            return cudf::io::compression_type::NONE;
+        }
+
+        throw std::invalid_argument("Unsupported compression '" + compression +
+                                    "' for parquet and orc files. Must be one of 'none' or 'snappy'");
+    }
+
+  protected:
+    void open(const cudf::table_view &data) override
+    {
+        m_metadata = this->make_metadata(data);
+
+        auto options = cudf::io::chunked_parquet_writer_options::builder(cudf::io::sink_info(m_filename))
+                           .compression(m_compression)
+                           .metadata(&m_metadata)
+                           .build();
+
+        m_writer = std::make_unique<cudf::io::parquet_chunked_writer>(options);
+    }
+
+    void write_chunk(const cudf::table_view &data) override
+    {
+        m_writer->write(data);
+    }
+
+    void close_file() override
+    {
+        m_writer->close();
+        m_writer.reset();
+    }
+
+  private:
+    cudf::io::compression_type m_compression;
+    cudf::io::table_input_metadata m_metadata;
+    std::unique_ptr<cudf::io::parquet_chunked_writer> m_writer;
+};
+
+// ************ WriteToFileStage__OrcWriter ************ //
+class WriteToFileStage__OrcWriter : public WriteToFileStage__ColumnarWriter
+{
+  public:
+    WriteToFileStage__OrcWriter(std::string filename, const std::string &compression) :
+      WriteToFileStage__ColumnarWriter(std::move(filename)),
+      m_compression(WriteToFileStage__ParquetWriter::parse_compression(compression))
+    {}
+
+  protected:
+    void open(const cudf::table_view &data) override
+    {
+        m_metadata = this->make_metadata(data);
+
+        auto options = cudf::io::chunked_orc_writer_options::builder(cudf::io::sink_info(m_filename))
+                           .compression(m_compression)
+                           .metadata(&m_metadata)
+                           .build();
+
+        m_writer = std::make_unique<cudf::io::orc_chunked_writer>(options);
+    }
+
+    void write_chunk(const cudf::table_view &data) override
+    {
+        m_writer->write(data);
+    }
+
+    void close_file() override
+    {
+        m_writer->close();
+        m_writer.reset();
+    }
+
+  private:
+    cudf::io::compression_type m_compression;
+    cudf::io::table_input_metadata m_metadata;
+    std::unique_ptr<cudf::io::orc_chunked_writer> m_writer;
+};
+
+// ************ WriteToFileStage__ArrowWriter ************ //
+/**
+ * @brief Writes the Arrow IPC file format (Feather V2), one or more record batches per message. Columns are copied
+ * to host memory by `cudf::to_arrow`.
+ */
+class WriteToFileStage__ArrowWriter : public WriteToFileStage__ColumnarWriter
+{
+  public:
+    WriteToFileStage__ArrowWriter(std::string filename, const std::string &compression) :
+      WriteToFileStage__ColumnarWriter(std::move(filename))
+    {
+        if (compression == "lz4")
+        {
+            m_options.codec = check(arrow::util::Codec::Create(arrow::Compression::LZ4_FRAME));
+        }
+        else if (compression == "zstd")
+        {
+            m_options.codec = check(arrow::util::Codec::Create(arrow::Compression::ZSTD));
+        }
+        else if (!compression.empty() && compression != "none")
+        {
+            throw std::invalid_argument("Unsupported compression '" + compression +
+                                        "' for arrow files. Must be one of 'none', 'lz4' or 'zstd'");
+        }
+    }
+
+  protected:
+    void open(const cudf::table_view &data) override
+    {
+        m_file = check(arrow::io::FileOutputStream::Open(m_filename));
+
+        auto table = this->to_arrow(data);
+
+        m_writer = check(arrow::ipc::MakeFileWriter(m_file, table->schema(), m_options));
+    }
+
+    void write_chunk(const cudf::table_view &data) override
+    {
+        check(m_writer->WriteTable(*this->to_arrow(data)));
+    }
+
+    void close_file() override
+    {
+        check(m_writer->Close());
+        check(m_file->Close());
+        m_writer.reset();
+        m_file.reset();
+    }
+
+  private:
+    std::shared_ptr<arrow::Table> to_arrow(const cudf::table_view &data) const
+    {
+        std::vector<cudf::column_metadata> metadata;
+        metadata.reserve(m_column_names.size());
+
+        for (const auto &name : m_column_names)
+        {
+            metadata.emplace_back(name);
+        }
+
+        return cudf::to_arrow(data, metadata);
+    }
+
+    static void check(const arrow::Status &status)
+    {
+        if (!status.ok())
+        {
+            throw std::runtime_error("Failed to write arrow file: " + status.ToString());
+        }
+    }
+
+    template <typename T>
+    static T check(arrow::Result<T> result)
+    {
+        check(result.status());
+
+        return std::move(result).ValueOrDie();
+    }
+
+    arrow::ipc::IpcWriteOptions m_options{arrow::ipc::IpcWriteOptions::Defaults()};
+    std::shared_ptr<arrow::io::FileOutputStream> m_file;
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> m_writer;
+};
+
+// ************ WriteToFileStage__Compressor ************ //
+/**
+ * @brief Gzips finished output files on a background thread, replacing `name` with `name.gz`, so rotating never waits
+ * on the compression. The first error is rethrown by `close`.
+ */
+class WriteToFileStage__Compressor
+{
+  public:
+    WriteToFileStage__Compressor()
+    {
+        m_thread = std::thread(&WriteToFileStage__Compressor::run, this);
+    }
+
+    ~WriteToFileStage__Compressor()
+    {
+        try
+        {
+            this->close();
+        } catch (const std::exception &e)
+        {
+            LOG(ERROR) << e.what();
+        }
+    }
+
+    void add(std::string filename)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.push_back(std::move(filename));
+        }
+
+        m_cv.notify_one();
+    }
+
+    /**
+     * @brief Waits until every added file has been compressed.
+     */
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_is_closed = true;
+        }
+
+        m_cv.notify_one();
+
+        if (m_thread.joinable())
+        {
+            m_thread.join();
+        }
+
+        if (auto error = std::exchange(m_error, nullptr))
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
+  private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true)
+        {
+            m_cv.wait(lock, [this]() { return m_is_closed || !m_pending.empty(); });
+
+            if (m_pending.empty())
+            {
+                // Closed and drained
+                break;
+            }
+
+            auto filename = std::move(m_pending.front());
+            m_pending.pop_front();
+
+            lock.unlock();
+
+            std::exception_ptr error;
+
+            try
+            {
+                WriteToFileStage__Compressor::gzip_file(filename);
+            } catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            lock.lock();
+
+            if (error && !m_error)
+            {
+                m_error = std::move(error);
+            }
+        }
+    }
+
+    static void gzip_file(const std::string &filename)
+    {
+        // Columnar files are only created once a message arrives
+        if (!std::filesystem::exists(filename))
+        {
+            return;
+        }
+
+        const auto gz_filename = filename + ".gz";
+
+        std::ifstream input(filename, std::ios::binary);
+
+        gzFile output = gzopen(gz_filename.c_str(), "wb");
+
+        if (!input.is_open() || output == nullptr)
+        {
+            if (output != nullptr)
+            {
+                gzclose(output);
+            }
+
+            throw std::runtime_error("Failed to open '" + filename + "' for compression");
+        }
+
+        std::vector<char> buffer(GzipChunkBytes);
+
+        while (input)
+        {
+            input.read(buffer.data(), buffer.size());
+
+            auto count = static_cast<int>(input.gcount());
+
+            if (count > 0 && gzwrite(output, buffer.data(), static_cast<unsigned>(count)) != count)
+            {
+                gzclose(output);
+                throw std::runtime_error("Failed to write '" + gz_filename + "'");
+            }
+        }
+
+        if (gzclose(output) != Z_OK)
+        {
+            throw std::runtime_error("Failed to write '" + gz_filename + "'");
+        }
+
+        input.close();
+        std::filesystem::remove(filename);
+    }
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::string> m_pending;
+    bool m_is_closed{false};
+    std::exception_ptr m_error{nullptr};
+
+    std::thread m_thread;
+};
+
+// ************ WriteToFileStage__RotatingOutput ************ //
+/**
+ * @brief Owns the current output file and starts the next one, named by expanding `pattern`, once the current file
+ * holds `rotate_bytes` or has been open for `rotate_interval`. Rotation is checked before each message is written, so
+ * messages are never split between files, a file which has nothing written to it is never rotated, and an idle
+ * pipeline keeps its file open. With neither limit set, `pattern` is used as the filename as is.
+ */
+class WriteToFileStage__RotatingOutput
+{
+  public:
+    using factory_fn_t = std::function<std::unique_ptr<WriteToFileStage__FileWriter>(const std::string &)>;
+
+    WriteToFileStage__RotatingOutput(std::string pattern,
+                                     factory_fn_t factory,
+                                     std::size_t rotate_bytes,
+                                     std::chrono::seconds rotate_interval,
+                                     bool compress) :
+      m_pattern(std::move(pattern)),
+      m_factory(std::move(factory)),
+      m_rotate_bytes(rotate_bytes),
+      m_rotate_interval(rotate_interval)
+    {
+        if (compress)
+        {
+            m_compressor = std::make_unique<WriteToFileStage__Compressor>();
+        }
+
+        if (this->is_rotating())
+        {
+            m_pattern = WriteToFileStage__RotatingOutput::rotation_pattern(m_pattern);
+        }
+
+        this->open_next();
+    }
+
+    void write(const TableInfo &table)
+    {
+        if (this->should_rotate())
+        {
+            this->close_current();
+            this->open_next();
+        }
+
+        m_writer->write(table);
+        ++m_messages_written;
+    }
+
+    void close()
+    {
+        this->close_current();
+
+        if (m_compressor)
+        {
+            m_compressor->close();
+        }
+    }
+
+  private:
+    bool is_rotating() const
+    {
+        return m_rotate_bytes > 0 || m_rotate_interval.count() > 0;
+    }
+
+    bool should_rotate() const
+    {
+        if (m_messages_written == 0)
+        {
+            return false;
+        }
+
+        if (m_rotate_bytes > 0 && m_writer->bytes_written() >= m_rotate_bytes)
+        {
+            return true;
+        }
+
+        return m_rotate_interval.count() > 0 && std::chrono::steady_clock::now() - m_opened >= m_rotate_interval;
+    }
+
+    void open_next()
+    {
+        m_filename         = this->is_rotating() ? this->expand_pattern() : m_pattern;
+        m_writer           = m_factory(m_filename);
+        m_opened           = std::chrono::steady_clock::now();
+        m_messages_written = 0;
+        ++m_file_index;
+    }
+
+    void close_current()
+    {
+        if (!m_writer)
+        {
+            return;
+        }
+
+        auto writer = std::move(m_writer);
+
+        writer->close();
+
+        if (m_compressor)
+        {
+            m_compressor->add(m_filename);
+        }
+    }
+
+    /**
+     * @brief Replaces `{index}` with the index of the file, starting at 0, and `{timestamp}` with the UTC time the
+     * file was opened.
+     */
+    std::string expand_pattern() const
+    {
+        char index[32];
+        std::snprintf(index, sizeof(index), "%05zu", m_file_index);
+
+        auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+        std::tm utc{};
+        gmtime_r(&now, &utc);
+
+        char timestamp[32];
+        std::strftime(timestamp, sizeof(timestamp), "%Y%m%dT%H%M%SZ", &utc);
+
+        auto filename = m_pattern;
+
+        WriteToFileStage__RotatingOutput::replace_all(filename, "{index}", index);
+        WriteToFileStage__RotatingOutput::replace_all(filename, "{timestamp}", timestamp);
+
+        return filename;
+    }
+
+    /**
+     * @brief Filenames without an `{index}` or `{timestamp}` placeholder get `.{index}` inserted before the
+     * extension, turning `alerts.csv` into `alerts.00000.csv`, `alerts.00001.csv` and so on.
+     */
+    static std::string rotation_pattern(const std::string &filename)
+    {
+        if (StringUtil::str_contains(filename, "{index}") || StringUtil::str_contains(filename, "{timestamp}"))
+        {
+            return filename;
+        }
+
+        auto name_start = filename.find_last_of('/');
+        auto extension  = filename.find_last_of('.');
+
+        if (extension == std::string::npos || (name_start != std::string::npos && extension < name_start))
+        {
+            return filename + ".{index}";
+        }
+
+        return filename.substr(0, extension) + ".{index}" + filename.substr(extension);
+    }
+
+    static void replace_all(std::string &str, const std::string &from, const std::string &to)
+    {
+        for (auto pos = str.find(from); pos != std::string::npos; pos = str.find(from, pos + to.size()))
+        {
+            str.replace(pos, from.size(), to);
+        }
+    }
+
+    std::string m_pattern;
+    factory_fn_t m_factory;
+    std::size_t m_rotate_bytes;
+    std::chrono::seconds m_rotate_interval;
+    std::unique_ptr<WriteToFileStage__Compressor> m_compressor;
+
+    std::string m_filename;
+    std::unique_ptr<WriteToFileStage__FileWriter> m_writer;
+    std::chrono::steady_clock::time_point m_opened;
+    std::size_t m_messages_written{0};
+    std::size_t m_file_index{0};
+};
+
 // Component public implementations
 // ************ WriteToFileStage **************************** //
 WriteToFileStage::WriteToFileStage(const neo::Segment &parent,
                                    const std::string &name,
                                    const std::string &filename,
                                    std::ios::openmode mode,
-                                   FileTypes file_type) :
+                                   FileTypes file_type,
+                                   const std::string &compression,
+                                   std::size_t queue_size,
+                                   const std::string &flush_policy,
+                                   std::size_t rotate_bytes,
+                                   std::size_t rotate_seconds,
+                                   const std::string &rotate_compression) :
   neo::SegmentObject(parent, name),
   PythonNode(parent, name, build_operator()),
-  m_is_first(true)
+  m_metrics(StageMetrics::get(name)),
+  m_drain_progress(PipelineDrain::track(name))
 {
     if (file_type == FileTypes::Auto)
     {
         file_type = determine_file_type(filename);
     }
 
-    if (file_type == FileTypes::CSV)
+    WriteToFileStage__RotatingOutput::factory_fn_t factory;
+
+    if (file_type == FileTypes::CSV || file_type == FileTypes::JSON)
     {
-        m_write_func = [this](auto &&PH1) { write_csv(std::forward<decltype(PH1)>(PH1)); };
+        // Compressed on the device, every message is appended as a sequence of gzip members or zstd frames
+        std::optional<GpuCompressionCodec> codec;
+
+        if (!compression.empty() && compression != "none")
+        {
+            codec = parse_gpu_compression_codec(compression);
+
+            if (!GpuCompressedSink::Available)
+            {
+                throw std::invalid_argument("Compression '" + compression +
+                                            "' of csv and json files requires Morpheus to be built with nvCOMP");
+            }
+
+            if (rotate_compression == "gzip")
+            {
+                throw std::invalid_argument("rotate_compression cannot be combined with compression. File: " +
+                                            filename);
+            }
+        }
+
+        if (queue_size > 0)
+        {
+            // Messages are formatted on the calling thread while the writer thread writes the previous ones
+            auto policy = parse_file_flush_policy(flush_policy);
+            bool append = (mode & std::ios::app) != 0;
+
+            factory = [append, file_type, queue_size, policy, codec](const std::string &output_filename) {
+                return std::make_unique<WriteToFileStage__QueuedWriter>(
+                    output_filename, append, file_type, queue_size, policy, codec);
+            };
+        }
+        else
+        {
+            factory = [mode, file_type, codec](const std::string &output_filename) {
+                return std::make_unique<WriteToFileStage__StreamWriter>(output_filename, mode, file_type, codec);
+            };
+        }
     }
-    else if (file_type == FileTypes::JSON)
+    else
     {
-        m_write_func = [this](auto &&PH1) { write_json(std::forward<decltype(PH1)>(PH1)); };
+        if ((mode & std::ios::app) != 0)
+        {
+            throw std::invalid_argument("Append mode ('a') is not supported for parquet, orc and arrow files. File: " +
+                                        filename);
+        }
+
+        if (queue_size > 0)
+        {
+            LOG(WARNING) << "queue_size is ignored for parquet, orc and arrow files. File: " << filename;
+        }
+
+        if (file_type == FileTypes::PARQUET)
+        {
+            factory = [compression](const std::string &output_filename) {
+                return std::make_unique<WriteToFileStage__ParquetWriter>(output_filename, compression);
+            };
+        }
+        else if (file_type == FileTypes::ORC)
+        {
+            factory = [compression](const std::string &output_filename) {
+                return std::make_unique<WriteToFileStage__OrcWriter>(output_filename, compression);
+            };
+        }
+        else if (file_type == FileTypes::ARROW)
+        {
+            factory = [compression](const std::string &output_filename) {
+                return std::make_unique<WriteToFileStage__ArrowWriter>(output_filename, compression);
+            };
+        }
+        else  // FileTypes::AUTO
+        {
+            LOG(FATAL) << "Unknown extension for file: " << filename;
+            throw std::runtime_error("Unknown extension");
+        }
     }
-    else  // FileTypes::AUTO
+
+    if (!rotate_compression.empty() && rotate_compression != "none" && rotate_compression != "gzip")
     {
-        LOG(FATAL) << "Unknown extension for file: " << filename;
-        throw std::runtime_error("Unknown extension");
+        throw std::invalid_argument("Unsupported rotate_compression '" + rotate_compression +
+                                    "'. Must be one of 'none' or 'gzip'");
     }
 
-    // Enable throwing exceptions in case something fails.
-    m_fstream.exceptions(std::fstream::failbit | std::fstream::badbit);
+    auto output = std::make_shared<WriteToFileStage__RotatingOutput>(filename,
+                                                                     std::move(factory),
+                                                                     rotate_bytes,
+                                                                     std::chrono::seconds(rotate_seconds),
+                                                                     rotate_compression == "gzip");
 
-    m_fstream.open(filename, mode);
+    m_write_func = [output](reader_type_t &msg) { output->write(msg->get_info()); };
+    m_close_func = [output]() { output->close(); };
 }
 
 void WriteToFileStage::close()
 {
-    if (m_fstream.is_open())
-    {
-        m_fstream.close();
-    }
+    m_close_func();
 }
 
 WriteToFileStage::operator_fn_t WriteToFileStage::build_operator()
@@ -74,16 +931,30 @@ WriteToFileStage::operator_fn_t WriteToFileStage::build_operator()
     return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
         return input.subscribe(neo::make_observer<reader_type_t>(
             [this, &output](reader_type_t &&msg) {
+                StageMetrics::Scope metrics_scope(*m_metrics, msg);
+                DrainProgress::Scope drain_scope(*m_drain_progress);
+
                 this->m_write_func(msg);
-                m_is_first = false;
-                output.on_next(std::move(msg));
+                metrics_scope.emit(output, std::move(msg));
             },
             [&](std::exception_ptr error_ptr) {
                 this->close();
                 output.on_error(error_ptr);
             },
             [&]() {
-                this->close();
+                try
+                {
+                    // Asynchronous writers report write errors when they are closed
+                    this->close();
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                // Every queued write reached the file
+                m_drain_progress->set_drained();
+
                 output.on_completed();
             }));
     };
@@ -94,7 +965,13 @@ std::shared_ptr<WriteToFileStage> WriteToFileStageInterfaceProxy::init(neo::Segm
                                                                        const std::string &name,
                                                                        const std::string &filename,
                                                                        const std::string &mode,
-                                                                       FileTypes file_type)
+                                                                       FileTypes file_type,
+                                                                       const std::string &compression,
+                                                                       std::size_t queue_size,
+                                                                       const std::string &flush_policy,
+                                                                       std::size_t rotate_bytes,
+                                                                       std::size_t rotate_seconds,
+                                                                       const std::string &rotate_compression)
 {
     std::ios::openmode fsmode = std::ios::out;
 
@@ -130,7 +1007,17 @@ std::shared_ptr<WriteToFileStage> WriteToFileStageInterfaceProxy::init(neo::Segm
         throw std::runtime_error(std::string("Unsupported file mode. Must choose either 'w' or 'a'. Mode: ") + mode);
     }
 
-    auto stage = std::make_shared<WriteToFileStage>(parent, name, filename, fsmode, file_type);
+    auto stage = std::make_shared<WriteToFileStage>(parent,
+                                                    name,
+                                                    filename,
+                                                    fsmode,
+                                                    file_type,
+                                                    compression,
+                                                    queue_size,
+                                                    flush_policy,
+                                                    rotate_bytes,
+                                                    rotate_seconds,
+                                                    rotate_compression);
 
     parent.register_node<WriteToFileStage>(stage);
 
@@ -0,0 +1,360 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/stages/write_to_kafka.hpp>
+
+#include <morpheus/io/serializers.hpp>
+#include <morpheus/messages/meta.hpp>
+
+#include <boost/fiber/operations.hpp>
+#include <glog/logging.h>
+#include <librdkafka/rdkafkacpp.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private free functions.
+// ************ WriteToKafkaStage__constants ************ //
+// While the producer queue is full the stage sleeps this long between polls, letting other fibers run
+constexpr std::chrono::milliseconds QueueFullSleep{5};
+
+// Delivery reports are served this often while flushing on completion
+constexpr int FlushPollMs = 100;
+
+// Records purged on shutdown are reported within this time
+constexpr int PurgeTimeoutMs = 1000;
+
+// Component-private classes.
+// ************ WriteToKafkaStage__Batch ************ //
+/**
+ * @brief Formatted records of one message. The records point into `payload`, which librdkafka references without
+ * copying until each record has been reported, so the batch deletes itself once the last report arrives. The
+ * completions of the message are held until then, so its source only treats it as processed once delivered.
+ */
+struct WriteToKafkaStage__Batch
+{
+    std::string payload;
+    std::vector<std::shared_ptr<MessageCompletion>> completions;
+
+    // Records not yet reported, plus one reference held while producing
+    std::atomic<std::size_t> pending{1};
+
+    void release()
+    {
+        if (pending.fetch_sub(1) == 1)
+        {
+            delete this;
+        }
+    }
+};
+
+// ************ WriteToKafkaStage__DeliveryReport ************ //
+/**
+ * @brief Counts delivery results and keeps the first error until it is rethrown. Called from `poll` and `flush` on
+ * the thread of the stage.
+ */
+class WriteToKafkaStage__DeliveryReport : public RdKafka::DeliveryReportCb
+{
+  public:
+    WriteToKafkaStage__DeliveryReport(std::atomic<std::size_t> &delivered, std::atomic<std::size_t> &failed) :
+      m_delivered(delivered),
+      m_failed(failed)
+    {}
+
+    void dr_cb(RdKafka::Message &message) override
+    {
+        auto *batch = static_cast<WriteToKafkaStage__Batch *>(message.msg_opaque());
+
+        if (message.err() == RdKafka::ERR_NO_ERROR)
+        {
+            ++m_delivered;
+        }
+        else
+        {
+            ++m_failed;
+
+            for (auto &completion : batch->completions)
+            {
+                completion->fail();
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (m_error.empty())
+            {
+                m_error = message.errstr();
+            }
+        }
+
+        batch->release();
+    }
+
+    /**
+     * @brief Throws `std::runtime_error` for the first delivery error reported since the last call.
+     */
+    void rethrow_error()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_error.empty())
+        {
+            throw std::runtime_error("Error occurred delivering to Kafka. Error: " + std::exchange(m_error, {}));
+        }
+    }
+
+  private:
+    std::atomic<std::size_t> &m_delivered;
+    std::atomic<std::size_t> &m_failed;
+
+    std::mutex m_mutex;
+    std::string m_error;
+};
+
+// ************ WriteToKafkaStage__Producer ************ //
+/**
+ * @brief Producer for a single run of the stage.
+ */
+class WriteToKafkaStage__Producer
+{
+  public:
+    WriteToKafkaStage__Producer(std::string topic,
+                                const std::map<std::string, std::string> &config,
+                                std::atomic<std::size_t> &delivered,
+                                std::atomic<std::size_t> &failed) :
+      m_topic(std::move(topic)),
+      m_delivery_report(delivered, failed)
+    {
+        auto kafka_conf = std::unique_ptr<RdKafka::Conf>(RdKafka::Conf::create(RdKafka::Conf::CONF_GLOBAL));
+        std::string error_string;
+
+        for (auto const &key_value : config)
+        {
+            if (RdKafka::Conf::ConfResult::CONF_OK != kafka_conf->set(key_value.first, key_value.second, error_string))
+            {
+                throw std::invalid_argument("Error occurred while setting Kafka configuration '" + key_value.first +
+                                            "'. Error: " + error_string);
+            }
+        }
+
+        if (RdKafka::Conf::ConfResult::CONF_OK != kafka_conf->set("dr_cb", &m_delivery_report, error_string))
+        {
+            throw std::runtime_error("Error occurred while setting Kafka delivery report callback. Error: " +
+                                     error_string);
+        }
+
+        m_producer.reset(RdKafka::Producer::create(kafka_conf.get(), error_string));
+
+        if (!m_producer)
+        {
+            throw std::runtime_error("Error occurred creating Kafka producer. Error: " + error_string);
+        }
+    }
+
+    ~WriteToKafkaStage__Producer()
+    {
+        if (m_producer->outq_len() > 0)
+        {
+            // Only reached on errors. Purged records are still reported, releasing their batches
+            LOG(WARNING) << "WriteToKafkaStage: Dropping " << m_producer->outq_len() << " undelivered records";
+
+            m_producer->purge(RdKafka::Producer::PURGE_QUEUE | RdKafka::Producer::PURGE_INFLIGHT);
+            m_producer->flush(PurgeTimeoutMs);
+        }
+    }
+
+    WriteToKafkaStage__Producer(const WriteToKafkaStage__Producer &) = delete;
+    WriteToKafkaStage__Producer &operator=(const WriteToKafkaStage__Producer &) = delete;
+
+    /**
+     * @brief Produces every row of `meta` as a record.
+     */
+    void produce(const MessageMeta &meta)
+    {
+        auto *batch        = new WriteToKafkaStage__Batch();
+        batch->payload     = df_to_json(meta.get_info());
+        batch->completions = meta.completions();
+
+        const std::string &payload = batch->payload;
+
+        try
+        {
+            std::size_t start = 0;
+
+            while (start < payload.size())
+            {
+                auto stop = payload.find('\n', start);
+
+                if (stop == std::string::npos)
+                {
+                    stop = payload.size();
+                }
+
+                if (stop > start)
+                {
+                    ++batch->pending;
+                    this->produce_record(const_cast<char *>(payload.data()) + start, stop - start, batch);
+                }
+
+                start = stop + 1;
+            }
+        } catch (...)
+        {
+            for (auto &completion : batch->completions)
+            {
+                completion->fail();
+            }
+
+            batch->release();
+            throw;
+        }
+
+        batch->release();
+
+        // Serve the delivery reports of earlier messages
+        m_producer->poll(0);
+        m_delivery_report.rethrow_error();
+    }
+
+    /**
+     * @brief Waits until every record has been reported.
+     */
+    void flush()
+    {
+        while (m_producer->outq_len() > 0)
+        {
+            m_producer->flush(FlushPollMs);
+        }
+
+        m_delivery_report.rethrow_error();
+    }
+
+  private:
+    void produce_record(char *data, std::size_t size, WriteToKafkaStage__Batch *batch)
+    {
+        while (true)
+        {
+            // No copy flags, the record references the batch payload
+            auto code = m_producer->produce(
+                m_topic, RdKafka::Topic::PARTITION_UA, 0, data, size, nullptr, 0, 0, batch);
+
+            if (code == RdKafka::ERR_NO_ERROR)
+            {
+                return;
+            }
+
+            if (code != RdKafka::ERR__QUEUE_FULL)
+            {
+                // The record was never queued, so it will not be reported
+                batch->release();
+
+                throw std::runtime_error("Error occurred producing to Kafka topic '" + m_topic +
+                                         "'. Error: " + RdKafka::err2str(code));
+            }
+
+            // Backpressure, wait for the brokers to acknowledge earlier records
+            m_producer->poll(0);
+            boost::this_fiber::sleep_for(QueueFullSleep);
+        }
+    }
+
+    const std::string m_topic;
+
+    // Must outlive the producer, which calls it while purging
+    WriteToKafkaStage__DeliveryReport m_delivery_report;
+    std::unique_ptr<RdKafka::Producer> m_producer;
+};
+
+// Component public implementations
+// ************ WriteToKafkaStage **************************** //
+WriteToKafkaStage::WriteToKafkaStage(const neo::Segment &parent,
+                                     const std::string &name,
+                                     std::string topic,
+                                     std::map<std::string, std::string> config) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_topic(std::move(topic)),
+  m_config(std::move(config)),
+  m_metrics(StageMetrics::get(name))
+{
+    // Wait briefly to fill batches instead of sending a request per record. Explicit settings take precedence
+    std::map<std::string, std::string> defaults{{"linger.ms", "5"}, {"batch.num.messages", "10000"}};
+
+    m_config.merge(defaults);
+}
+
+std::size_t WriteToKafkaStage::delivered_message_count() const
+{
+    return m_delivered_message_count;
+}
+
+std::size_t WriteToKafkaStage::failed_message_count() const
+{
+    return m_failed_message_count;
+}
+
+WriteToKafkaStage::operator_fn_t WriteToKafkaStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        auto producer = std::make_shared<WriteToKafkaStage__Producer>(
+            m_topic, m_config, m_delivered_message_count, m_failed_message_count);
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output, producer](reader_type_t &&msg) {
+                StageMetrics::Scope metrics_scope(*m_metrics, msg);
+
+                producer->produce(*msg);
+                metrics_scope.emit(output, std::move(msg));
+            },
+            [&output](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [&output, producer]() {
+                try
+                {
+                    producer->flush();
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ WriteToKafkaStageInterfaceProxy ************ //
+std::shared_ptr<WriteToKafkaStage> WriteToKafkaStageInterfaceProxy::init(neo::Segment &parent,
+                                                                         const std::string &name,
+                                                                         std::string topic,
+                                                                         std::map<std::string, std::string> config)
+{
+    auto stage = std::make_shared<WriteToKafkaStage>(parent, name, std::move(topic), std::move(config));
+
+    parent.register_node<WriteToKafkaStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
@@ -0,0 +1,97 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/stages/write_to_ucx.hpp>
+
+#include <morpheus/io/ucx_transport.hpp>
+#include <morpheus/objects/table_info.hpp>
+
+#include <neo/core/segment.hpp>
+#include <neo/core/segment_object.hpp>
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component public implementations
+// ************ WriteToUcxStage **************************** //
+WriteToUcxStage::WriteToUcxStage(const neo::Segment &parent,
+                                 const std::string &name,
+                                 std::string host,
+                                 uint16_t port) :
+  neo::SegmentObject(parent, name),
+  PythonNode(parent, name, build_operator()),
+  m_host(std::move(host)),
+  m_port(port),
+  m_metrics(StageMetrics::get(name))
+{}
+
+WriteToUcxStage::operator_fn_t WriteToUcxStage::build_operator()
+{
+    return [this](neo::Observable<reader_type_t> &input, neo::Subscriber<writer_type_t> &output) {
+        // Connects when the pipeline starts, on the thread which sends every message. Dropped without closing on an
+        // error, so the receiver fails as well
+        auto sender = std::make_shared<UcxSender>(m_host, m_port);
+
+        return input.subscribe(neo::make_observer<reader_type_t>(
+            [this, &output, sender](reader_type_t &&msg) {
+                StageMetrics::Scope metrics_scope(*m_metrics, msg);
+
+                auto info = msg->get_info();
+
+                // Index columns first, the receiver is told how many there are
+                auto column_names      = info.get_index_names();
+                const auto &data_names = info.get_column_names();
+                column_names.insert(column_names.end(), data_names.begin(), data_names.end());
+
+                sender->send(info.get_view(), column_names, info.num_indices());
+
+                metrics_scope.emit(output, std::move(msg));
+            },
+            [&output](std::exception_ptr error_ptr) { output.on_error(error_ptr); },
+            [&output, sender]() {
+                try
+                {
+                    sender->close();
+                } catch (...)
+                {
+                    output.on_error(std::current_exception());
+                    return;
+                }
+
+                output.on_completed();
+            }));
+    };
+}
+
+// ************ WriteToUcxStageInterfaceProxy ************ //
+std::shared_ptr<WriteToUcxStage> WriteToUcxStageInterfaceProxy::init(neo::Segment &parent,
+                                                                     const std::string &name,
+                                                                     std::string host,
+                                                                     uint16_t port)
+{
+    auto stage = std::make_shared<WriteToUcxStage>(parent, name, std::move(host), port);
+
+    parent.register_node<WriteToUcxStage>(stage);
+
+    return stage;
+}
+}  // namespace morpheus
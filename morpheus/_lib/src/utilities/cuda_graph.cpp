@@ -0,0 +1,193 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/utilities/cuda_graph.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <glog/logging.h>
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace morpheus {
+// Component-private free functions.
+    static std::atomic<bool> &CudaGraphCache__enabled() {
+        static std::atomic<bool> enabled{false};
+        return enabled;
+    }
+
+    /**
+     * @brief Enqueues `launches` without a graph, with a temporary device copy of `host_args`
+     */
+    static void CudaGraphCache__run_eagerly(rmm::cuda_stream_view stream,
+                                            const std::vector<uint8_t> &host_args,
+                                            const CudaGraphCache::launches_t &launches) {
+        // Released in stream order, after the launches
+        rmm::device_buffer device_args(host_args.size(), stream);
+
+        if (!host_args.empty()) {
+            NEO_CHECK_CUDA(cudaMemcpyAsync(
+                    device_args.data(), host_args.data(), host_args.size(), cudaMemcpyHostToDevice, stream.value()));
+        }
+
+        launches(stream, device_args.data());
+    }
+
+    /**
+     * @brief Records `launches` on `stream`. Relaxed mode lets the memory resource allocate while capturing. Returns
+     * nullptr, with the CUDA error cleared, when the sequence cannot be captured.
+     */
+    static cudaGraph_t CudaGraphCache__capture(rmm::cuda_stream_view stream,
+                                               const void *device_args,
+                                               const CudaGraphCache::launches_t &launches) {
+        NEO_CHECK_CUDA(cudaStreamBeginCapture(stream.value(), cudaStreamCaptureModeRelaxed));
+
+        bool launched = true;
+
+        try {
+            launches(stream, device_args);
+        } catch (...) {
+            // Rethrown, if it was not caused by the capture, when run again eagerly
+            launched = false;
+        }
+
+        cudaGraph_t graph = nullptr;
+        auto status = cudaStreamEndCapture(stream.value(), &graph);
+
+        if (!launched || status != cudaSuccess) {
+            if (graph != nullptr) {
+                cudaGraphDestroy(graph);
+            }
+
+            cudaGetLastError();
+
+            return nullptr;
+        }
+
+        return graph;
+    }
+
+// Component public implementations
+// ************ CudaGraphCache ************************ //
+    CudaGraphCache::CudaGraphCache(std::size_t max_graphs) : m_max_graphs(max_graphs) {}
+
+    CudaGraphCache::~CudaGraphCache() {
+        for (auto &[key, entry]: m_entries) {
+            if (entry.launched != nullptr) {
+                // The last launch may still read the arguments
+                cudaEventSynchronize(entry.launched);
+                cudaEventDestroy(entry.launched);
+            }
+
+            if (entry.exec != nullptr) {
+                cudaGraphExecDestroy(entry.exec);
+            }
+        }
+    }
+
+    void CudaGraphCache::run(const key_t &key, const std::vector<uint8_t> &host_args, const launches_t &launches) {
+        const auto stream = rmm::cuda_stream_per_thread;
+
+        if (!CudaGraphCache::enabled() || m_max_graphs == 0) {
+            CudaGraphCache__run_eagerly(stream, host_args, launches);
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        auto found = m_entries.find(key);
+
+        if (found == m_entries.end()) {
+            // Seen for the first time, only remembered so a repeat is captured
+            if (m_entries.size() < m_max_graphs) {
+                m_entries.emplace(key, Entry{});
+            }
+
+            lock.unlock();
+            CudaGraphCache__run_eagerly(stream, host_args, launches);
+            return;
+        }
+
+        // Entries are never erased, the reference stays valid
+        auto &entry = found->second;
+
+        if (entry.exec == nullptr && !entry.eager) {
+            // Seen again, captured once. Held locked so a key is only ever captured by one thread
+            entry.args = std::make_unique<rmm::device_buffer>(host_args.size(), stream);
+
+            NEO_CHECK_CUDA(cudaEventCreateWithFlags(&entry.launched, cudaEventDisableTiming));
+
+            // Launches from other streams wait on this, so on the allocation
+            NEO_CHECK_CUDA(cudaEventRecord(entry.launched, stream.value()));
+
+            cudaGraph_t graph = CudaGraphCache__capture(stream, entry.args->data(), launches);
+
+            ++m_capture_count;
+
+            if (graph != nullptr) {
+                if (cudaGraphInstantiate(&entry.exec, graph, nullptr, nullptr, 0) != cudaSuccess) {
+                    cudaGetLastError();
+                    entry.exec = nullptr;
+                }
+
+                cudaGraphDestroy(graph);
+            }
+
+            if (entry.exec == nullptr) {
+                LOG(WARNING) << "Kernel sequence could not be captured into a CUDA Graph, running it eagerly";
+
+                entry.eager = true;
+            }
+        }
+
+        if (entry.eager || entry.args->size() != host_args.size()) {
+            lock.unlock();
+            CudaGraphCache__run_eagerly(stream, host_args, launches);
+            return;
+        }
+
+        // The previous launch of this graph must have read its arguments before they are overwritten
+        NEO_CHECK_CUDA(cudaStreamWaitEvent(stream.value(), entry.launched, 0));
+
+        if (!host_args.empty()) {
+            NEO_CHECK_CUDA(cudaMemcpyAsync(
+                    entry.args->data(), host_args.data(), host_args.size(), cudaMemcpyHostToDevice, stream.value()));
+        }
+
+        NEO_CHECK_CUDA(cudaGraphLaunch(entry.exec, stream.value()));
+        NEO_CHECK_CUDA(cudaEventRecord(entry.launched, stream.value()));
+    }
+
+    std::size_t CudaGraphCache::capture_count() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_capture_count;
+    }
+
+    void CudaGraphCache::set_enabled(bool enabled) {
+        CudaGraphCache__enabled().store(enabled, std::memory_order_relaxed);
+    }
+
+    bool CudaGraphCache::enabled() {
+        return CudaGraphCache__enabled().load(std::memory_order_relaxed);
+    }
+}  // namespace morpheus
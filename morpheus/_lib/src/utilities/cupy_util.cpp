@@ -18,7 +18,16 @@
 #include <morpheus/utilities/cupy_util.hpp>
 
 #include <morpheus/objects/tensor.hpp>
+#include <morpheus/utilities/type_util.hpp>
 
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cuda_runtime.h>
+#include <dlpack/dlpack.h>
+#include <glog/logging.h>
 #include <pybind11/cast.h>
 #include <pybind11/functional.h>  // IWYU pragma: keep
 #include <pybind11/gil.h>         // IWYU pragma: keep
@@ -26,27 +35,136 @@
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>  // IWYU pragma: keep
 
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
 namespace morpheus {
-pybind11::object CupyUtil::cp_module = pybind11::none();
+// Component-private classes.
+// ************ CupyUtil__DLPackContext ************ //
+/**
+ * @brief Owned by an exported `DLManagedTensor`. Holds the tensor, keeping its memory alive, and the shape and
+ * strides the `DLTensor` points to.
+ */
+struct CupyUtil__DLPackContext
+{
+    TensorObject tensor;
+    std::vector<int64_t> shape;
+    std::vector<int64_t> strides;
+    DLManagedTensor managed;
+};
 
-pybind11::module_ CupyUtil::get_cp()
+// Component-private free functions.
+static void CupyUtil__delete_dlpack_context(DLManagedTensor *managed)
 {
-    DCHECK(PyGILState_Check() != 0);
+    delete static_cast<CupyUtil__DLPackContext *>(managed->manager_ctx);
+}
 
-    if (cp_module.is_none())
+/**
+ * @brief Frees capsules which were never consumed. Consumers rename the capsule to "used_dltensor" and call the
+ * deleter themselves
+ */
+static void CupyUtil__delete_capsule(PyObject *capsule)
+{
+    if (PyCapsule_IsValid(capsule, "dltensor") != 0)
     {
-        cp_module = pybind11::module_::import("cupy");
+        auto *managed = static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule, "dltensor"));
+        managed->deleter(managed);
     }
+}
 
-    pybind11::module_ m = pybind11::cast<pybind11::module_>(cp_module);
+static DLDataType CupyUtil__to_dl_dtype(const DataType &dtype)
+{
+    DLDataType dl_dtype{};
+    dl_dtype.bits  = static_cast<uint8_t>(dtype.item_size() * 8);
+    dl_dtype.lanes = 1;
 
-    return m;
+    switch (dtype.type_id())
+    {
+    case TypeId::INT8:
+    case TypeId::INT16:
+    case TypeId::INT32:
+    case TypeId::INT64:
+        dl_dtype.code = kDLInt;
+        break;
+    case TypeId::UINT8:
+    case TypeId::UINT16:
+    case TypeId::UINT32:
+    case TypeId::UINT64:
+        dl_dtype.code = kDLUInt;
+        break;
+    case TypeId::FLOAT16:
+    case TypeId::FLOAT32:
+    case TypeId::FLOAT64:
+        dl_dtype.code = kDLFloat;
+        break;
+    case TypeId::BFLOAT16:
+        dl_dtype.code = kDLBfloat;
+        break;
+    default:
+        throw std::invalid_argument("Tensor type '" + dtype.name() + "' cannot be exported with DLPack");
+    }
+
+    return dl_dtype;
 }
 
-pybind11::object CupyUtil::tensor_to_cupy(const TensorObject &tensor)
+static DType CupyUtil__from_dl_dtype(const DLDataType &dl_dtype)
+{
+    CHECK(dl_dtype.lanes == 1) << "Vectorized DLPack types are not supported";
+
+    switch (dl_dtype.code)
+    {
+    case kDLInt:
+        return DType::from_numpy("<i" + std::to_string(dl_dtype.bits / 8));
+    case kDLUInt:
+        return DType::from_numpy("<u" + std::to_string(dl_dtype.bits / 8));
+    case kDLFloat:
+        return DType::from_numpy("<f" + std::to_string(dl_dtype.bits / 8));
+    case kDLBfloat:
+        CHECK(dl_dtype.bits == 16) << "Unsupported bfloat width " << static_cast<int>(dl_dtype.bits);
+        return DType(TypeId::BFLOAT16);
+    default:
+        throw std::invalid_argument("Unsupported DLPack type code " + std::to_string(dl_dtype.code));
+    }
+}
+
+/**
+ * @brief Makes work already queued on the per-thread stream visible to the consumer's stream, without blocking the
+ * host. The legacy default stream waits on every blocking stream by itself
+ */
+static void CupyUtil__order_for_consumer(pybind11::object stream)
+{
+    if (stream.is_none())
+    {
+        return;
+    }
+
+    auto stream_val = stream.cast<intptr_t>();
+
+    if (stream_val == -1 || stream_val == 1 || stream_val == 2)
+    {
+        return;
+    }
+
+    cudaEvent_t event;
+    NEO_CHECK_CUDA(cudaEventCreateWithFlags(&event, cudaEventDisableTiming));
+    NEO_CHECK_CUDA(cudaEventRecord(event, rmm::cuda_stream_per_thread));
+    NEO_CHECK_CUDA(cudaStreamWaitEvent(reinterpret_cast<cudaStream_t>(stream_val), event, 0));
+
+    // Released once the event completes
+    NEO_CHECK_CUDA(cudaEventDestroy(event));
+}
+
+/**
+ * @brief Boolean tensors are viewed through `__cuda_array_interface__`, which keeps the cupy dtype. These steps follow
+ * the cupy._convert_object_with_cuda_array_interface function shown here:
+ * https://github.com/cupy/cupy/blob/a5b24f91d4d77fa03e6a4dd2ac954ff9a04e21f4/cupy/core/core.pyx#L2478-L2514
+ */
+static pybind11::object CupyUtil__array_interface_to_cupy(const TensorObject &tensor)
 {
-    // These steps follow the cupy._convert_object_with_cuda_array_interface function shown here:
-    // https://github.com/cupy/cupy/blob/a5b24f91d4d77fa03e6a4dd2ac954ff9a04e21f4/cupy/core/core.pyx#L2478-L2514
     auto cp      = CupyUtil::get_cp();
     auto cuda    = cp.attr("cuda");
     auto ndarray = cp.attr("ndarray");
@@ -75,47 +193,174 @@ pybind11::object CupyUtil::tensor_to_cupy(const TensorObject &tensor)
     pybind11::object dtype  = cp.attr("dtype")(tensor.get_numpy_typestr());
     pybind11::object memptr = cuda.attr("MemoryPointer")(mem, 0);
 
-    // TODO(MDD): Sync on stream
-
     return ndarray(
         pybind11::cast<pybind11::tuple>(shape_list), dtype, memptr, pybind11::cast<pybind11::tuple>(stride_list));
 }
 
-TensorObject CupyUtil::cupy_to_tensor(pybind11::object cupy_array)
+/**
+ * @brief Implements `CupyUtil::from_dlpack`. When `is_bool` is set, 8 bit integers are imported as BOOL8
+ */
+static TensorObject CupyUtil__import_dlpack(pybind11::capsule capsule, bool is_bool)
 {
-    // Convert inputs from cupy to Tensor
-    pybind11::dict arr_interface = cupy_array.attr("__cuda_array_interface__");
+    auto *managed = static_cast<DLManagedTensor *>(PyCapsule_GetPointer(capsule.ptr(), "dltensor"));
+
+    if (managed == nullptr)
+    {
+        throw pybind11::error_already_set();
+    }
 
-    pybind11::tuple shape_tup = arr_interface["shape"];
+    // The capsule is consumed, from here on releasing the producer's memory is our job
+    PyCapsule_SetName(capsule.ptr(), "used_dltensor");
 
-    pybind11::print(shape_tup);
-    auto shape = shape_tup.cast<std::vector<TensorIndex>>();
+    std::unique_ptr<DLManagedTensor, void (*)(DLManagedTensor *)> guard(managed, [](DLManagedTensor *m) {
+        if (m->deleter != nullptr)
+        {
+            m->deleter(m);
+        }
+    });
 
-    std::string typestr = arr_interface["typestr"].cast<std::string>();
+    const auto &dl_tensor = managed->dl_tensor;
 
-    pybind11::tuple data_tup = arr_interface["data"];
+    CHECK(dl_tensor.device.device_type == kDLCUDA || dl_tensor.device.device_type == kDLCUDAManaged)
+        << "Only device memory can be converted to a tensor";
 
-    uintptr_t data_ptr = data_tup[0].cast<uintptr_t>();
+    CHECK(!is_bool || dl_tensor.dtype.bits == 8) << "Booleans must use one byte per value";
 
+    auto dtype = is_bool ? DType(TypeId::BOOL8) : CupyUtil__from_dl_dtype(dl_tensor.dtype);
+
+    std::vector<TensorIndex> shape(dl_tensor.shape, dl_tensor.shape + dl_tensor.ndim);
     std::vector<TensorIndex> strides{};
 
-    if (arr_interface.contains("strides") && !arr_interface["strides"].is_none())
+    // Number of elements spanned by the tensor, which is more than the count for strided tensors
+    std::size_t extent = 1;
+
+    if (dl_tensor.strides != nullptr)
     {
-        pybind11::tuple strides_tup = arr_interface["strides"];
+        strides.assign(dl_tensor.strides, dl_tensor.strides + dl_tensor.ndim);
 
-        strides = strides_tup.cast<std::vector<TensorIndex>>();
+        for (int i = 0; i < dl_tensor.ndim; ++i)
+        {
+            CHECK(strides[i] >= 0) << "Negative strides are not supported";
+
+            if (shape[i] == 0)
+            {
+                extent = 0;
+                break;
+            }
+
+            extent += static_cast<std::size_t>(shape[i] - 1) * strides[i];
+        }
     }
+    else
+    {
+        for (auto dim : shape)
+        {
+            extent *= static_cast<std::size_t>(dim);
+        }
+    }
+
+    const auto *data = static_cast<const uint8_t *>(dl_tensor.data) + dl_tensor.byte_offset;
+
+    auto buffer =
+        std::make_shared<rmm::device_buffer>(data, extent * dtype.item_size(), rmm::cuda_stream_per_thread);
+
+    // The producer may free or reuse its memory as soon as the deleter runs
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    return Tensor::create(std::move(buffer), dtype, shape, strides, 0);
+}
+
+// Component public implementations
+// ************ CupyUtil **************************** //
+pybind11::object CupyUtil::cp_module = pybind11::none();
+
+pybind11::module_ CupyUtil::get_cp()
+{
+    DCHECK(PyGILState_Check() != 0);
+
+    if (cp_module.is_none())
+    {
+        cp_module = pybind11::module_::import("cupy");
+    }
+
+    pybind11::module_ m = pybind11::cast<pybind11::module_>(cp_module);
+
+    return m;
+}
 
-    //  Get the size finally
-    auto size = cupy_array.attr("data").attr("mem").attr("size").cast<size_t>();
+pybind11::object CupyUtil::tensor_to_cupy(const TensorObject &tensor)
+{
+    if (tensor.dtype().type_id() == TypeId::BOOL8)
+    {
+        return CupyUtil__array_interface_to_cupy(tensor);
+    }
 
-    auto tensor =
-        Tensor::create(std::make_shared<rmm::device_buffer>((void const *)data_ptr, size, rmm::cuda_stream_per_thread),
-                       DType::from_numpy(typestr),
-                       shape,
-                       strides,
-                       0);
+    // cupy 9 predates the `__dlpack__` protocol and reads on the legacy default stream
+    return CupyUtil::get_cp().attr("fromDlpack")(CupyUtil::to_dlpack(tensor));
+}
 
-    return tensor;
+TensorObject CupyUtil::cupy_to_tensor(pybind11::object cupy_array)
+{
+    // DLPack 0.5 describes booleans as 8 bit unsigned integers
+    const bool is_bool = cupy_array.attr("dtype").attr("kind").cast<std::string>() == "b";
+
+    pybind11::object capsule;
+
+    if (pybind11::hasattr(cupy_array, "__dlpack__"))
+    {
+        // Ask the producer to order its work before the per-thread stream the copy is queued on
+        capsule = cupy_array.attr("__dlpack__")(pybind11::arg("stream") = 2);
+    }
+    else
+    {
+        capsule = cupy_array.attr("toDlpack")();
+    }
+
+    return CupyUtil__import_dlpack(pybind11::reinterpret_borrow<pybind11::capsule>(capsule), is_bool);
+}
+
+pybind11::capsule CupyUtil::to_dlpack(const TensorObject &tensor, pybind11::object stream)
+{
+    auto context = std::make_unique<CupyUtil__DLPackContext>();
+
+    context->tensor = tensor;
+
+    for (auto dim : tensor.get_shape())
+    {
+        context->shape.push_back(static_cast<int64_t>(dim));
+    }
+
+    for (auto stride : tensor.get_stride())
+    {
+        context->strides.push_back(static_cast<int64_t>(stride));
+    }
+
+    cudaPointerAttributes attributes{};
+    NEO_CHECK_CUDA(cudaPointerGetAttributes(&attributes, tensor.data()));
+
+    auto &dl_tensor              = context->managed.dl_tensor;
+    dl_tensor.data               = tensor.data();
+    dl_tensor.device.device_type = attributes.type == cudaMemoryTypeManaged ? kDLCUDAManaged : kDLCUDA;
+    dl_tensor.device.device_id   = attributes.device;
+    dl_tensor.ndim               = static_cast<int>(context->shape.size());
+    dl_tensor.dtype              = CupyUtil__to_dl_dtype(tensor.dtype());
+    dl_tensor.shape              = context->shape.data();
+    dl_tensor.strides            = context->strides.empty() ? nullptr : context->strides.data();
+    dl_tensor.byte_offset        = 0;
+
+    context->managed.manager_ctx = context.get();
+    context->managed.deleter     = CupyUtil__delete_dlpack_context;
+
+    CupyUtil__order_for_consumer(std::move(stream));
+
+    // Ownership passes to the capsule, then to the consumer
+    auto *managed = &context.release()->managed;
+
+    return pybind11::capsule(managed, "dltensor", CupyUtil__delete_capsule);
+}
+
+TensorObject CupyUtil::from_dlpack(pybind11::capsule capsule)
+{
+    return CupyUtil__import_dlpack(std::move(capsule), false);
 }
 }  // namespace morpheus
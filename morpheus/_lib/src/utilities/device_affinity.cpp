@@ -0,0 +1,193 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/utilities/device_affinity.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace morpheus {
+// Component-private free functions.
+// ************ DeviceAffinity__state ************ //
+    static thread_local int DeviceAffinity__current_numa_node = -1;
+    static thread_local int DeviceAffinity__bound_device = -1;
+
+    struct DeviceAffinity__Cache {
+        std::mutex mutex;
+        std::map<int, int> numa_nodes;
+    };
+
+    static DeviceAffinity__Cache &DeviceAffinity__cache() {
+        static DeviceAffinity__Cache cache;
+        return cache;
+    }
+
+    /**
+     * @brief Reads the first line of a sysfs file, empty if it cant be read.
+     */
+    static std::string DeviceAffinity__read_line(const std::string &path) {
+        std::ifstream file(path);
+        std::string line;
+
+        if (file) {
+            std::getline(file, line);
+        }
+
+        return line;
+    }
+
+    /**
+     * @brief sysfs names PCI devices in lower case with a 4 digit domain, CUDA reports upper case and some drivers
+     * an 8 digit domain.
+     */
+    static std::string DeviceAffinity__sysfs_bus_id(std::string bus_id) {
+        std::transform(bus_id.begin(), bus_id.end(), bus_id.begin(), [](unsigned char c) {
+            return std::tolower(c);
+        });
+
+        auto domain_end = bus_id.find(':');
+
+        if (domain_end != std::string::npos && domain_end > 4) {
+            bus_id.erase(0, domain_end - 4);
+        }
+
+        return bus_id;
+    }
+
+// Component public implementations
+// ************ DeviceAffinity ************************ //
+    int DeviceAffinity::numa_node(int device_id) {
+        auto &cache = DeviceAffinity__cache();
+
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+
+            auto found = cache.numa_nodes.find(device_id);
+
+            if (found != cache.numa_nodes.end()) {
+                return found->second;
+            }
+        }
+
+        char bus_id[32] = {0};
+        NEO_CHECK_CUDA(cudaDeviceGetPCIBusId(bus_id, sizeof(bus_id), device_id));
+
+        auto line = DeviceAffinity__read_line("/sys/bus/pci/devices/" + DeviceAffinity__sysfs_bus_id(bus_id) +
+                                              "/numa_node");
+
+        // Single node hosts report -1
+        int node = -1;
+
+        if (!line.empty()) {
+            node = std::max(std::stoi(line), -1);
+        }
+
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.numa_nodes[device_id] = node;
+
+        return node;
+    }
+
+    std::vector<int> DeviceAffinity::numa_cpus(int numa_node) {
+        if (numa_node < 0) {
+            return {};
+        }
+
+        return parse_cpu_list(
+                DeviceAffinity__read_line("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist"));
+    }
+
+    std::vector<int> DeviceAffinity::parse_cpu_list(const std::string &cpu_list) {
+        std::vector<int> cpus;
+        std::stringstream stream(cpu_list);
+        std::string range;
+
+        while (std::getline(stream, range, ',')) {
+            if (range.empty()) {
+                continue;
+            }
+
+            auto dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+
+        return cpus;
+    }
+
+    void DeviceAffinity::bind_current_thread(int device_id) {
+        if (device_id < 0 || device_id == DeviceAffinity__bound_device) {
+            return;
+        }
+
+        NEO_CHECK_CUDA(cudaSetDevice(device_id));
+
+        DeviceAffinity__bound_device = device_id;
+
+        auto node = numa_node(device_id);
+        auto cpus = numa_cpus(node);
+
+        if (cpus.empty()) {
+            VLOG(10) << "No NUMA node found for device " << device_id << ", only setting the CUDA device";
+            return;
+        }
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+
+        for (auto cpu: cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpu_set);
+            }
+        }
+
+        auto result = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+
+        if (result != 0) {
+            // Usually a cgroup or container restricting the CPUs, the thread still runs, just not bound
+            LOG(WARNING) << "Unable to bind thread to the CPUs of NUMA node " << node << " for device " << device_id
+                         << ". Error: " << result;
+            return;
+        }
+
+        DeviceAffinity__current_numa_node = node;
+
+        VLOG(10) << "Bound thread to NUMA node " << node << " for device " << device_id;
+    }
+
+    int DeviceAffinity::current_numa_node() {
+        return DeviceAffinity__current_numa_node;
+    }
+}  // namespace morpheus
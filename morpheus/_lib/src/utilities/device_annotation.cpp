@@ -0,0 +1,206 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/utilities/device_annotation.hpp>
+
+#include <cuda_runtime.h>
+#include <nvtx3/nvToolsExt.h>
+#include <rmm/cuda_stream_view.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ DeviceAnnotation__Registry ************ //
+    struct DeviceAnnotation__Pending {
+        const char *name;
+        cudaEvent_t start;
+        cudaEvent_t stop;
+    };
+
+    /**
+     * @brief Events are recycled rather than destroyed, and ranges are only folded into `stats` once their stop event
+     * has completed, so closing a range never waits on the device.
+     */
+    struct DeviceAnnotation__Registry {
+        std::atomic<bool> timing_enabled{false};
+
+        std::mutex mutex;
+        std::vector<cudaEvent_t> free_events;
+        std::deque<DeviceAnnotation__Pending> pending;
+        std::map<const char *, DeviceOperationStats> stats;
+    };
+
+    static DeviceAnnotation__Registry &DeviceAnnotation__registry() {
+        // Leaked, events may still be released by ranges closed during static destruction
+        static auto *registry = new DeviceAnnotation__Registry();
+        return *registry;
+    }
+
+    static cudaEvent_t DeviceAnnotation__acquire_event(DeviceAnnotation__Registry &registry) {
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+
+            if (!registry.free_events.empty()) {
+                auto event = registry.free_events.back();
+                registry.free_events.pop_back();
+                return event;
+            }
+        }
+
+        cudaEvent_t event;
+
+        if (cudaEventCreate(&event) != cudaSuccess) {
+            return nullptr;
+        }
+
+        return event;
+    }
+
+    /**
+     * @brief Folds completed ranges into `stats`. Must be called with the registry mutex held. Timing is best effort
+     * and this runs from destructors, so CUDA errors drop the sample instead of throwing.
+     */
+    static void DeviceAnnotation__collect(DeviceAnnotation__Registry &registry, bool wait) {
+        while (!registry.pending.empty()) {
+            auto &range = registry.pending.front();
+
+            auto status = wait ? cudaEventSynchronize(range.stop) : cudaEventQuery(range.stop);
+
+            if (status == cudaErrorNotReady) {
+                // Ranges complete roughly in the order they were closed, no need to look further
+                break;
+            }
+
+            float elapsed_ms = 0;
+
+            if (status == cudaSuccess &&
+                cudaEventElapsedTime(&elapsed_ms, range.start, range.stop) == cudaSuccess) {
+                auto elapsed_ns = static_cast<uint64_t>(static_cast<double>(elapsed_ms) * 1e6);
+
+                auto &op_stats = registry.stats[range.name];
+                ++op_stats.count;
+                op_stats.total_ns += elapsed_ns;
+                op_stats.max_ns = std::max(op_stats.max_ns, elapsed_ns);
+            }
+
+            registry.free_events.push_back(range.start);
+            registry.free_events.push_back(range.stop);
+            registry.pending.pop_front();
+        }
+    }
+
+// Component public implementations
+// ************ DeviceAnnotation ************************ //
+    void DeviceAnnotation::set_timing_enabled(bool enabled) {
+        DeviceAnnotation__registry().timing_enabled = enabled && Enabled;
+    }
+
+    bool DeviceAnnotation::timing_enabled() {
+        return DeviceAnnotation__registry().timing_enabled;
+    }
+
+    std::map<std::string, DeviceOperationStats> DeviceAnnotation::stats() {
+        auto &registry = DeviceAnnotation__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        DeviceAnnotation__collect(registry, true);
+
+        // Names are keyed by pointer internally, identical literals from different translation units are merged
+        std::map<std::string, DeviceOperationStats> result;
+
+        for (const auto &[name, op_stats]: registry.stats) {
+            auto &merged = result[name];
+            merged.count += op_stats.count;
+            merged.total_ns += op_stats.total_ns;
+            merged.max_ns = std::max(merged.max_ns, op_stats.max_ns);
+        }
+
+        return result;
+    }
+
+    void DeviceAnnotation::reset() {
+        auto &registry = DeviceAnnotation__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        DeviceAnnotation__collect(registry, true);
+        registry.stats.clear();
+    }
+
+    DeviceAnnotation::ScopedRange::ScopedRange(const char *name, rmm::cuda_stream_view stream) :
+            m_name(name),
+            m_stream(stream),
+            m_range(nvtxRangeStartA(name)) {
+        auto &registry = DeviceAnnotation__registry();
+
+        if (!registry.timing_enabled) {
+            return;
+        }
+
+        auto start = DeviceAnnotation__acquire_event(registry);
+
+        if (start == nullptr) {
+            return;
+        }
+
+        if (cudaEventRecord(start, m_stream.value()) != cudaSuccess) {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.free_events.push_back(start);
+            return;
+        }
+
+        m_start = start;
+    }
+
+    DeviceAnnotation::ScopedRange::~ScopedRange() {
+        nvtxRangeEnd(m_range);
+
+        if (m_start == nullptr) {
+            return;
+        }
+
+        auto &registry = DeviceAnnotation__registry();
+
+        auto start = static_cast<cudaEvent_t>(m_start);
+        auto stop = DeviceAnnotation__acquire_event(registry);
+
+        // A failed record only loses this sample
+        if (stop == nullptr || cudaEventRecord(stop, m_stream.value()) != cudaSuccess) {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.free_events.push_back(start);
+
+            if (stop != nullptr) {
+                registry.free_events.push_back(stop);
+            }
+
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        registry.pending.push_back(DeviceAnnotation__Pending{m_name, start, stop});
+
+        DeviceAnnotation__collect(registry, false);
+    }
+}  // namespace morpheus
@@ -0,0 +1,336 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <rmm/cuda_device.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/mr/device/arena_memory_resource.hpp>
+#include <rmm/mr/device/cuda_memory_resource.hpp>
+#include <rmm/mr/device/device_memory_resource.hpp>
+#include <rmm/mr/device/per_device_resource.hpp>
+#include <rmm/mr/device/pool_memory_resource.hpp>
+
+#include <thrust/optional.h>
+
+#include <cuda_runtime.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ DeviceMemory__TrackingResource ************ //
+    /**
+     * @brief Forwards to `upstream`, counting every allocation against the tag of the allocating thread. The tag is
+     * remembered per pointer so frees are counted against the same tag, regardless of the thread freeing it.
+     */
+    class DeviceMemory__TrackingResource : public rmm::mr::device_memory_resource {
+    public:
+        explicit DeviceMemory__TrackingResource(rmm::mr::device_memory_resource *upstream) : m_upstream(upstream) {}
+
+        bool supports_streams() const noexcept override {
+            return m_upstream->supports_streams();
+        }
+
+        bool supports_get_mem_info() const noexcept override {
+            return m_upstream->supports_get_mem_info();
+        }
+
+        std::map<std::string, DeviceMemoryStats> stats() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            // Tags are keyed by pointer internally, identical literals from different translation units are merged
+            std::map<std::string, DeviceMemoryStats> result;
+
+            for (const auto &[tag, tag_stats]: m_stats) {
+                auto &merged = result[tag];
+                merged.current_bytes += tag_stats.current_bytes;
+                merged.peak_bytes = std::max(merged.peak_bytes, tag_stats.peak_bytes);
+                merged.total_bytes += tag_stats.total_bytes;
+                merged.allocation_count += tag_stats.allocation_count;
+            }
+
+            return result;
+        }
+
+        static thread_local const char *current_tag;
+
+    private:
+        void *do_allocate(std::size_t bytes, rmm::cuda_stream_view stream) override {
+            void *ptr = m_upstream->allocate(bytes, stream);
+
+            const char *tag = current_tag != nullptr ? current_tag : DeviceMemory::DefaultTag;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_allocations[ptr] = std::make_pair(bytes, tag);
+
+            auto &tag_stats = m_stats[tag];
+            tag_stats.current_bytes += bytes;
+            tag_stats.peak_bytes = std::max(tag_stats.peak_bytes, tag_stats.current_bytes);
+            tag_stats.total_bytes += bytes;
+            ++tag_stats.allocation_count;
+
+            return ptr;
+        }
+
+        void do_deallocate(void *ptr, std::size_t bytes, rmm::cuda_stream_view stream) override {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+
+                auto found = m_allocations.find(ptr);
+
+                if (found != m_allocations.end()) {
+                    m_stats[found->second.second].current_bytes -= found->second.first;
+                    m_allocations.erase(found);
+                }
+            }
+
+            m_upstream->deallocate(ptr, bytes, stream);
+        }
+
+        std::pair<std::size_t, std::size_t> do_get_mem_info(rmm::cuda_stream_view stream) const override {
+            return m_upstream->get_mem_info(stream);
+        }
+
+        rmm::mr::device_memory_resource *m_upstream;
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<void *, std::pair<std::size_t, const char *>> m_allocations;
+        std::map<const char *, DeviceMemoryStats> m_stats;
+    };
+
+    thread_local const char *DeviceMemory__TrackingResource::current_tag = nullptr;
+
+// ************ DeviceMemory__Stack ************ //
+    /**
+     * @brief Owns one configured resource stack. Buffers keep a raw pointer to the resource they were allocated from,
+     * so stacks replaced by a later `configure` call are kept alive rather than destroyed.
+     */
+    struct DeviceMemory__Stack {
+        std::string resource;
+        std::unique_ptr<rmm::mr::cuda_memory_resource> cuda;
+        std::unique_ptr<rmm::mr::device_memory_resource> sub_allocator;
+        std::unique_ptr<DeviceMemory__TrackingResource> tracking;
+    };
+
+    struct DeviceMemory__Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<DeviceMemory__Stack>> stacks;
+        std::vector<DeviceMemory__Stack *> current;  // Stacks installed by the last call to configure
+    };
+
+    static DeviceMemory__Registry &DeviceMemory__registry() {
+        static DeviceMemory__Registry registry;
+        return registry;
+    }
+
+    static thrust::optional<std::size_t> DeviceMemory__optional_size(std::size_t bytes) {
+        if (bytes == 0) {
+            return thrust::nullopt;
+        }
+
+        return bytes;
+    }
+
+    /**
+     * @brief Builds a resource stack for the current device.
+     */
+    static std::unique_ptr<DeviceMemory__Stack> DeviceMemory__make_stack(const std::string &resource,
+                                                                         std::size_t initial_pool_bytes,
+                                                                         std::size_t maximum_pool_bytes) {
+        auto stack = std::make_unique<DeviceMemory__Stack>();
+        stack->resource = resource;
+        stack->cuda = std::make_unique<rmm::mr::cuda_memory_resource>();
+
+        rmm::mr::device_memory_resource *upstream = stack->cuda.get();
+
+        if (resource == "pool") {
+            stack->sub_allocator = std::make_unique<rmm::mr::pool_memory_resource<rmm::mr::cuda_memory_resource>>(
+                    stack->cuda.get(),
+                    DeviceMemory__optional_size(initial_pool_bytes),
+                    DeviceMemory__optional_size(maximum_pool_bytes));
+            upstream = stack->sub_allocator.get();
+        } else if (resource == "arena") {
+            stack->sub_allocator =
+                    std::make_unique<rmm::mr::arena_memory_resource<rmm::mr::cuda_memory_resource>>(stack->cuda.get());
+            upstream = stack->sub_allocator.get();
+        } else if (resource != "cuda") {
+            throw std::invalid_argument("Unknown device memory resource '" + resource +
+                                        "'. Must be one of 'cuda', 'pool' or 'arena'");
+        }
+
+        stack->tracking = std::make_unique<DeviceMemory__TrackingResource>(upstream);
+
+        return stack;
+    }
+
+    /**
+     * @brief Throws unless every device in `device_ids` can read the memory of the others. Messages are handed to
+     * whichever device pulls them from the shared input, so a kernel of one device reading a message allocated on
+     * another would fail mid pipeline.
+     */
+    static void DeviceMemory__check_peer_access(const std::vector<int> &device_ids) {
+        for (auto device_id: device_ids) {
+            for (auto peer_id: device_ids) {
+                if (peer_id == device_id) {
+                    continue;
+                }
+
+                int can_access = 0;
+                NEO_CHECK_CUDA(cudaDeviceCanAccessPeer(&can_access, device_id, peer_id));
+
+                if (can_access == 0) {
+                    throw std::runtime_error("Device " + std::to_string(device_id) +
+                                             " cannot access the memory of device " + std::to_string(peer_id) +
+                                             ", running on several GPUs requires peer access between all of them. "
+                                             "Use a single GPU instead");
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Lets every device in `device_ids` read the memory of the others. Must be checked with
+     * `DeviceMemory__check_peer_access` first.
+     */
+    static void DeviceMemory__enable_peer_access(const std::vector<int> &device_ids) {
+        for (auto device_id: device_ids) {
+            NEO_CHECK_CUDA(cudaSetDevice(device_id));
+
+            for (auto peer_id: device_ids) {
+                if (peer_id == device_id) {
+                    continue;
+                }
+
+                auto result = cudaDeviceEnablePeerAccess(peer_id, 0);
+
+                if (result == cudaErrorPeerAccessAlreadyEnabled) {
+                    // Clears the sticky error
+                    cudaGetLastError();
+                } else {
+                    NEO_CHECK_CUDA(result);
+                }
+            }
+        }
+    }
+
+// Component public implementations
+// ************ DeviceMemory ************************ //
+    void DeviceMemory::configure(const std::string &resource,
+                                 std::size_t initial_pool_bytes,
+                                 std::size_t maximum_pool_bytes,
+                                 const std::vector<int> &device_ids) {
+        std::vector<std::unique_ptr<DeviceMemory__Stack>> stacks;
+
+        if (device_ids.empty()) {
+            stacks.emplace_back(DeviceMemory__make_stack(resource, initial_pool_bytes, maximum_pool_bytes));
+        } else {
+            // Before any pool reserves memory, nothing is left half configured
+            DeviceMemory__check_peer_access(device_ids);
+
+            int previous_device_id = 0;
+            NEO_CHECK_CUDA(cudaGetDevice(&previous_device_id));
+
+            // Pools reserve their initial memory on the current device
+            for (auto device_id: device_ids) {
+                NEO_CHECK_CUDA(cudaSetDevice(device_id));
+                stacks.emplace_back(DeviceMemory__make_stack(resource, initial_pool_bytes, maximum_pool_bytes));
+            }
+
+            DeviceMemory__enable_peer_access(device_ids);
+
+            NEO_CHECK_CUDA(cudaSetDevice(previous_device_id));
+        }
+
+        auto &registry = DeviceMemory__registry();
+
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+
+            if (device_ids.empty()) {
+                rmm::mr::set_current_device_resource(stacks.front()->tracking.get());
+            } else {
+                for (std::size_t i = 0; i < device_ids.size(); ++i) {
+                    rmm::mr::set_per_device_resource(rmm::cuda_device_id{device_ids[i]}, stacks[i]->tracking.get());
+                }
+            }
+
+            registry.current.clear();
+
+            for (auto &stack: stacks) {
+                registry.current.push_back(stack.get());
+                registry.stacks.emplace_back(std::move(stack));
+            }
+        }
+
+        LOG(INFO) << "Using the '" << resource << "' device memory resource on "
+                  << (device_ids.empty() ? std::string("the current device")
+                                         : std::to_string(device_ids.size()) + " devices");
+    }
+
+    std::string DeviceMemory::resource() {
+        auto &registry = DeviceMemory__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        if (registry.current.empty()) {
+            return std::string();
+        }
+
+        return registry.current.front()->resource;
+    }
+
+    std::map<std::string, DeviceMemoryStats> DeviceMemory::stats() {
+        auto &registry = DeviceMemory__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        std::map<std::string, DeviceMemoryStats> result;
+
+        for (auto *stack: registry.current) {
+            for (const auto &[tag, tag_stats]: stack->tracking->stats()) {
+                // Peaks of different devices are not simultaneous, summing them gives an upper bound
+                auto &merged = result[tag];
+                merged.current_bytes += tag_stats.current_bytes;
+                merged.peak_bytes += tag_stats.peak_bytes;
+                merged.total_bytes += tag_stats.total_bytes;
+                merged.allocation_count += tag_stats.allocation_count;
+            }
+        }
+
+        return result;
+    }
+
+    DeviceMemory::ScopedTag::ScopedTag(const char *tag) : m_previous(DeviceMemory__TrackingResource::current_tag) {
+        DeviceMemory__TrackingResource::current_tag = tag;
+    }
+
+    DeviceMemory::ScopedTag::~ScopedTag() {
+        DeviceMemory__TrackingResource::current_tag = m_previous;
+    }
+}  // namespace morpheus
@@ -0,0 +1,180 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/utilities/host_memory.hpp>
+
+#include <morpheus/utilities/device_affinity.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cuda_runtime.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace morpheus {
+// Component-private classes.
+// ************ PinnedHostPool__constants ************ //
+    // Smallest block handed out, keeps tiny staging copies (masks, seq ids) from fragmenting the cache
+    constexpr std::size_t PinnedHostPoolMinBlockBytes = 4096;
+
+// ************ PinnedHostPool__State ************ //
+    struct PinnedHostPool__State {
+        std::mutex mutex;
+        // Keyed by NUMA node, then block size
+        std::map<std::pair<int, std::size_t>, std::vector<uint8_t *>> free_blocks;
+        std::size_t cached_bytes{0};
+    };
+
+    static PinnedHostPool__State &PinnedHostPool__state() {
+        // Never destroyed. Buffers can be released at exit after the CUDA context is gone
+        static auto *state = new PinnedHostPool__State();
+        return *state;
+    }
+
+    static std::size_t PinnedHostPool__block_bytes(std::size_t bytes) {
+        std::size_t block = PinnedHostPoolMinBlockBytes;
+
+        while (block < bytes) {
+            block *= 2;
+        }
+
+        return block;
+    }
+
+// Component public implementations
+// ************ PinnedHostBuffer ************************ //
+    PinnedHostBuffer::PinnedHostBuffer(uint8_t *data, std::size_t size, std::size_t capacity, int numa_node) :
+            m_data(data),
+            m_size(size),
+            m_capacity(capacity),
+            m_numa_node(numa_node) {}
+
+    PinnedHostBuffer::~PinnedHostBuffer() {
+        this->release();
+    }
+
+    PinnedHostBuffer::PinnedHostBuffer(PinnedHostBuffer &&other) noexcept:
+            m_data(std::exchange(other.m_data, nullptr)),
+            m_size(std::exchange(other.m_size, 0)),
+            m_capacity(std::exchange(other.m_capacity, 0)),
+            m_numa_node(std::exchange(other.m_numa_node, -1)) {}
+
+    PinnedHostBuffer &PinnedHostBuffer::operator=(PinnedHostBuffer &&other) noexcept {
+        if (this != &other) {
+            this->release();
+
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_numa_node = std::exchange(other.m_numa_node, -1);
+        }
+
+        return *this;
+    }
+
+    void PinnedHostBuffer::release() {
+        if (m_data != nullptr) {
+            PinnedHostPool::release(m_data, m_capacity, m_numa_node);
+
+            m_data = nullptr;
+            m_size = 0;
+            m_capacity = 0;
+            m_numa_node = -1;
+        }
+    }
+
+// ************ PinnedHostPool ************************ //
+    PinnedHostBuffer PinnedHostPool::acquire(std::size_t bytes) {
+        if (bytes == 0) {
+            return PinnedHostBuffer();
+        }
+
+        const auto block_bytes = PinnedHostPool__block_bytes(bytes);
+        const auto numa_node = DeviceAffinity::current_numa_node();
+
+        auto &state = PinnedHostPool__state();
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            auto found = state.free_blocks.find(std::make_pair(numa_node, block_bytes));
+
+            if (found != state.free_blocks.end() && !found->second.empty()) {
+                uint8_t *data = found->second.back();
+                found->second.pop_back();
+                state.cached_bytes -= block_bytes;
+
+                return PinnedHostBuffer(data, bytes, block_bytes, numa_node);
+            }
+        }
+
+        // Pages are placed by the memory policy of the calling thread. Bound threads only run on their own node, so
+        // the block lands there
+        void *data = nullptr;
+        NEO_CHECK_CUDA(cudaMallocHost(&data, block_bytes));
+
+        return PinnedHostBuffer(static_cast<uint8_t *>(data), bytes, block_bytes, numa_node);
+    }
+
+    void PinnedHostPool::release(uint8_t *data, std::size_t capacity, int numa_node) {
+        auto &state = PinnedHostPool__state();
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            if (state.cached_bytes + capacity <= MaxCachedBytes) {
+                state.free_blocks[std::make_pair(numa_node, capacity)].push_back(data);
+                state.cached_bytes += capacity;
+                return;
+            }
+        }
+
+        // Can run at thread exit after the CUDA context is gone, so dont check the result
+        cudaFreeHost(data);
+    }
+
+    void PinnedHostPool::clear() {
+        auto &state = PinnedHostPool__state();
+
+        std::map<std::pair<int, std::size_t>, std::vector<uint8_t *>> free_blocks;
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            free_blocks.swap(state.free_blocks);
+            state.cached_bytes = 0;
+        }
+
+        for (auto &[key, blocks]: free_blocks) {
+            for (auto *block: blocks) {
+                cudaFreeHost(block);
+            }
+        }
+    }
+
+    std::size_t PinnedHostPool::cached_bytes() {
+        auto &state = PinnedHostPool__state();
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        return state.cached_bytes;
+    }
+}  // namespace morpheus
@@ -0,0 +1,640 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/utilities/json_util.hpp>
+
+#include <neo/cuda/common.hpp>
+
+#include <glog/logging.h>
+
+#include <cuda_runtime.h>
+#include <cudf/column/column_device_view.cuh>
+#include <cudf/column/column_factories.hpp>
+#include <cudf/null_mask.hpp>
+#include <cudf/strings/string_view.cuh>
+#include <cudf/strings/strings_column_view.hpp>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_uvector.hpp>
+#include <rmm/exec_policy.hpp>
+#include <thrust/scan.h>
+
+namespace morpheus {
+// Component-private free functions.
+// ************ JsonUtil__validate_lines_kernel**************//
+/**
+ * @brief Maximum nesting depth of a line. Deeper lines are rejected since the container types can't be tracked
+ */
+constexpr int JsonUtil__MaxDepth = 64;
+
+__host__ __device__ bool JsonUtil__is_whitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+__host__ __device__ bool JsonUtil__is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+__host__ __device__ bool JsonUtil__is_hex(char c)
+{
+    return JsonUtil__is_digit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/**
+ * @brief Skips the string starting at the opening quote `it`. Returns one past the closing quote or nullptr if the
+ * string is not valid
+ */
+__host__ __device__ const char *JsonUtil__skip_string(const char *it, const char *end)
+{
+    for (++it; it < end; ++it)
+    {
+        char c = *it;
+
+        if (c == '"')
+        {
+            return it + 1;
+        }
+
+        if (c == '\\')
+        {
+            if (++it >= end)
+            {
+                return nullptr;
+            }
+
+            switch (*it)
+            {
+            case '"':
+            case '\\':
+            case '/':
+            case 'b':
+            case 'f':
+            case 'n':
+            case 'r':
+            case 't':
+                break;
+            case 'u':
+                for (int i = 0; i < 4; ++i)
+                {
+                    if (++it >= end || !JsonUtil__is_hex(*it))
+                    {
+                        return nullptr;
+                    }
+                }
+                break;
+            default:
+                return nullptr;
+            }
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            // Control characters must be escaped
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Skips the number starting at `it`, `-?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?`. Returns one past
+ * the last character or nullptr if the number is not valid
+ */
+__host__ __device__ const char *JsonUtil__skip_number(const char *it, const char *end)
+{
+    if (it < end && *it == '-')
+    {
+        ++it;
+    }
+
+    if (it >= end || !JsonUtil__is_digit(*it))
+    {
+        return nullptr;
+    }
+
+    if (*it == '0')
+    {
+        ++it;
+    }
+    else
+    {
+        while (it < end && JsonUtil__is_digit(*it))
+        {
+            ++it;
+        }
+    }
+
+    if (it < end && *it == '.')
+    {
+        if (++it >= end || !JsonUtil__is_digit(*it))
+        {
+            return nullptr;
+        }
+
+        while (it < end && JsonUtil__is_digit(*it))
+        {
+            ++it;
+        }
+    }
+
+    if (it < end && (*it == 'e' || *it == 'E'))
+    {
+        if (++it < end && (*it == '+' || *it == '-'))
+        {
+            ++it;
+        }
+
+        if (it >= end || !JsonUtil__is_digit(*it))
+        {
+            return nullptr;
+        }
+
+        while (it < end && JsonUtil__is_digit(*it))
+        {
+            ++it;
+        }
+    }
+
+    return it;
+}
+
+/**
+ * @brief Skips `literal` at `it` when it matches exactly. Returns one past the literal or nullptr
+ */
+__host__ __device__ const char *JsonUtil__skip_literal(const char *it, const char *end, const char *literal)
+{
+    for (; *literal != '\0'; ++literal, ++it)
+    {
+        if (it >= end || *it != *literal)
+        {
+            return nullptr;
+        }
+    }
+
+    return it;
+}
+
+/**
+ * @brief Checks that `[it, end)` holds a single JSON object or array followed only by whitespace
+ */
+__host__ __device__ bool JsonUtil__is_valid_line(const char *it, const char *end)
+{
+    enum class Expect
+    {
+        Root,              // First token of the line
+        Value,             // After `:` or `,` in an array
+        ValueOrArrayEnd,   // After `[`
+        Key,               // After `,` in an object
+        KeyOrObjectEnd,    // After `{`
+        Colon,             // After a key
+        CommaOrEnd,        // After a value
+        Done,              // After the root closed
+    };
+
+    // One bit per level, set for arrays
+    uint64_t array_stack = 0;
+    int depth            = 0;
+    Expect expect        = Expect::Root;
+
+    while (it < end)
+    {
+        char c = *it;
+
+        if (JsonUtil__is_whitespace(c))
+        {
+            ++it;
+            continue;
+        }
+
+        switch (expect)
+        {
+        case Expect::Done:
+            // Only a single object or array is allowed per line
+            return false;
+        case Expect::Colon:
+            if (c != ':')
+            {
+                return false;
+            }
+            ++it;
+            expect = Expect::Value;
+            continue;
+        case Expect::Key:
+        case Expect::KeyOrObjectEnd:
+            if (c == '}' && expect == Expect::KeyOrObjectEnd)
+            {
+                break;
+            }
+            if (c != '"' || (it = JsonUtil__skip_string(it, end)) == nullptr)
+            {
+                return false;
+            }
+            expect = Expect::Colon;
+            continue;
+        case Expect::CommaOrEnd:
+            if (c == ',')
+            {
+                ++it;
+                expect = ((array_stack >> (depth - 1)) & 1) ? Expect::Value : Expect::Key;
+                continue;
+            }
+            if (c != '}' && c != ']')
+            {
+                return false;
+            }
+            break;
+        case Expect::Root:
+            if (c != '{' && c != '[')
+            {
+                return false;
+            }
+            break;
+        case Expect::ValueOrArrayEnd:
+        case Expect::Value:
+            if (c == ']' && expect == Expect::ValueOrArrayEnd)
+            {
+                break;
+            }
+            if (c == '}' || c == ']')
+            {
+                return false;
+            }
+            break;
+        }
+
+        // Values and closing brackets
+        switch (c)
+        {
+        case '{':
+        case '[':
+            if (depth >= JsonUtil__MaxDepth)
+            {
+                return false;
+            }
+            array_stack = c == '[' ? (array_stack | (uint64_t{1} << depth)) : (array_stack & ~(uint64_t{1} << depth));
+            ++depth;
+            ++it;
+            expect = c == '[' ? Expect::ValueOrArrayEnd : Expect::KeyOrObjectEnd;
+            continue;
+        case '}':
+        case ']':
+            --depth;
+            if (((array_stack >> depth) & 1) != (c == ']'))
+            {
+                return false;
+            }
+            ++it;
+            break;
+        case '"':
+            it = JsonUtil__skip_string(it, end);
+            break;
+        case 't':
+            it = JsonUtil__skip_literal(it, end, "true");
+            break;
+        case 'f':
+            it = JsonUtil__skip_literal(it, end, "false");
+            break;
+        case 'n':
+            it = JsonUtil__skip_literal(it, end, "null");
+            break;
+        default:
+            it = JsonUtil__skip_number(it, end);
+        }
+
+        if (it == nullptr)
+        {
+            return false;
+        }
+
+        expect = depth == 0 ? Expect::Done : Expect::CommaOrEnd;
+    }
+
+    return expect == Expect::Done;
+}
+
+/**
+ * @brief One thread per line. Writes whether the line is valid
+ */
+__global__ void JsonUtil__validate_lines_kernel(const char *data,
+                                                const std::size_t *line_offsets,
+                                                std::size_t line_count,
+                                                uint8_t *valid)
+{
+    std::size_t line_idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+    if (line_idx >= line_count)
+    {
+        return;
+    }
+
+    valid[line_idx] = JsonUtil__is_valid_line(data + line_offsets[line_idx], data + line_offsets[line_idx + 1]);
+}
+
+// ************ JsonUtil__unescape_kernels**************//
+__device__ int JsonUtil__hex_value(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * @brief Parses the 4 hex digits at `in`. Returns -1 if there are not 4 valid digits before `end`
+ */
+__device__ int32_t JsonUtil__parse_hex4(const char *in, const char *end)
+{
+    if (end - in < 4)
+    {
+        return -1;
+    }
+
+    int32_t value = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        int digit = JsonUtil__hex_value(in[i]);
+
+        if (digit < 0)
+        {
+            return -1;
+        }
+
+        value = (value << 4) | digit;
+    }
+
+    return value;
+}
+
+/**
+ * @brief Writes `code_point` as UTF-8 to `out` if not null. Returns the number of bytes required
+ */
+__device__ cudf::size_type JsonUtil__write_utf8(uint32_t code_point, char *out)
+{
+    if (code_point < 0x80)
+    {
+        if (out)
+            out[0] = static_cast<char>(code_point);
+        return 1;
+    }
+    if (code_point < 0x800)
+    {
+        if (out)
+        {
+            out[0] = static_cast<char>(0xC0 | (code_point >> 6));
+            out[1] = static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        return 2;
+    }
+    if (code_point < 0x10000)
+    {
+        if (out)
+        {
+            out[0] = static_cast<char>(0xE0 | (code_point >> 12));
+            out[1] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            out[2] = static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        return 3;
+    }
+    if (out)
+    {
+        out[0] = static_cast<char>(0xF0 | (code_point >> 18));
+        out[1] = static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+        out[2] = static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+        out[3] = static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+    return 4;
+}
+
+/**
+ * @brief Unescapes a single string. When `out` is null only the output size is computed, allowing the same code to be
+ * used for both sizing and writing
+ */
+__device__ cudf::size_type JsonUtil__unescape(cudf::string_view str, char *out)
+{
+    const char *it  = str.data();
+    const char *end = it + str.size_bytes();
+
+    cudf::size_type written = 0;
+
+    auto emit = [&](char c) {
+        if (out)
+            out[written] = c;
+        ++written;
+    };
+
+    while (it < end)
+    {
+        if (*it != '\\' || it + 1 >= end)
+        {
+            emit(*it++);
+            continue;
+        }
+
+        char escaped = it[1];
+
+        switch (escaped)
+        {
+        case '"':
+        case '\\':
+        case '/':
+            emit(escaped);
+            it += 2;
+            break;
+        case 'b':
+            emit('\b');
+            it += 2;
+            break;
+        case 'f':
+            emit('\f');
+            it += 2;
+            break;
+        case 'n':
+            emit('\n');
+            it += 2;
+            break;
+        case 'r':
+            emit('\r');
+            it += 2;
+            break;
+        case 't':
+            emit('\t');
+            it += 2;
+            break;
+        case 'u': {
+            int32_t code_point = JsonUtil__parse_hex4(it + 2, end);
+
+            if (code_point < 0)
+            {
+                // Malformed, copy the backslash and continue
+                emit(*it++);
+                break;
+            }
+
+            it += 6;
+
+            // Combine surrogate pairs
+            if (code_point >= 0xD800 && code_point <= 0xDBFF && end - it >= 6 && it[0] == '\\' && it[1] == 'u')
+            {
+                int32_t low = JsonUtil__parse_hex4(it + 2, end);
+
+                if (low >= 0xDC00 && low <= 0xDFFF)
+                {
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                    it += 6;
+                }
+            }
+
+            written += JsonUtil__write_utf8(code_point, out ? out + written : nullptr);
+            break;
+        }
+        default:
+            // Unknown escape, leave as is
+            emit(*it++);
+        }
+    }
+
+    return written;
+}
+
+__global__ void JsonUtil__unescape_sizes_kernel(cudf::column_device_view d_strings, cudf::size_type *sizes)
+{
+    cudf::size_type idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= d_strings.size())
+    {
+        return;
+    }
+
+    sizes[idx] = d_strings.is_null(idx) ? 0 : JsonUtil__unescape(d_strings.element<cudf::string_view>(idx), nullptr);
+}
+
+__global__ void JsonUtil__unescape_chars_kernel(cudf::column_device_view d_strings,
+                                                const cudf::size_type *offsets,
+                                                char *chars)
+{
+    cudf::size_type idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= d_strings.size() || d_strings.is_null(idx))
+    {
+        return;
+    }
+
+    JsonUtil__unescape(d_strings.element<cudf::string_view>(idx), chars + offsets[idx]);
+}
+
+// Component public implementations
+// ************ JsonUtil************************* //
+bool JsonUtil::is_valid_json_line(const char *data, std::size_t size)
+{
+    return JsonUtil__is_valid_line(data, data + size);
+}
+
+std::vector<uint8_t> JsonUtil::validate_json_lines(const char *host_data, const std::vector<std::size_t> &line_offsets)
+{
+    if (line_offsets.size() < 2)
+    {
+        return {};
+    }
+
+    auto stream            = rmm::cuda_stream_per_thread;
+    std::size_t line_count = line_offsets.size() - 1;
+    std::size_t data_bytes = line_offsets.back();
+
+    rmm::device_uvector<char> device_data(data_bytes, stream);
+    rmm::device_uvector<std::size_t> device_offsets(line_offsets.size(), stream);
+    rmm::device_uvector<uint8_t> device_valid(line_count, stream);
+
+    NEO_CHECK_CUDA(
+        cudaMemcpyAsync(device_data.data(), host_data, data_bytes, cudaMemcpyHostToDevice, stream.value()));
+    NEO_CHECK_CUDA(cudaMemcpyAsync(device_offsets.data(),
+                                   line_offsets.data(),
+                                   line_offsets.size() * sizeof(std::size_t),
+                                   cudaMemcpyHostToDevice,
+                                   stream.value()));
+
+    constexpr int threads_per_block = 256;
+    auto blocks = static_cast<unsigned int>((line_count + threads_per_block - 1) / threads_per_block);
+
+    JsonUtil__validate_lines_kernel<<<blocks, threads_per_block, 0, stream.value()>>>(
+        device_data.data(), device_offsets.data(), line_count, device_valid.data());
+
+    NEO_CHECK_CUDA(cudaGetLastError());
+
+    std::vector<uint8_t> valid(line_count);
+
+    NEO_CHECK_CUDA(
+        cudaMemcpyAsync(valid.data(), device_valid.data(), line_count, cudaMemcpyDeviceToHost, stream.value()));
+    NEO_CHECK_CUDA(cudaStreamSynchronize(stream.value()));
+
+    return valid;
+}
+
+std::unique_ptr<cudf::column> JsonUtil::unescape_strings(const cudf::column_view &input)
+{
+    CHECK(input.type().id() == cudf::type_id::STRING) << "unescape_strings requires a strings column";
+
+    auto stream        = rmm::cuda_stream_per_thread;
+    auto string_count  = input.size();
+    auto d_strings_ptr = cudf::column_device_view::create(input, stream);
+    auto &d_strings    = *d_strings_ptr;
+
+    constexpr int threads_per_block = 256;
+    auto blocks = static_cast<unsigned int>((string_count + threads_per_block - 1) / threads_per_block);
+
+    // Compute the size of each output string then scan to get the offsets. The extra entry holds the total
+    auto offsets_column = cudf::make_numeric_column(
+        cudf::data_type{cudf::type_id::INT32}, string_count + 1, cudf::mask_state::UNALLOCATED, stream);
+    auto d_offsets = offsets_column->mutable_view().data<cudf::size_type>();
+
+    NEO_CHECK_CUDA(cudaMemsetAsync(d_offsets, 0, (string_count + 1) * sizeof(cudf::size_type), stream.value()));
+
+    if (string_count > 0)
+    {
+        JsonUtil__unescape_sizes_kernel<<<blocks, threads_per_block, 0, stream.value()>>>(d_strings, d_offsets);
+        NEO_CHECK_CUDA(cudaGetLastError());
+    }
+
+    thrust::exclusive_scan(rmm::exec_policy(stream), d_offsets, d_offsets + string_count + 1, d_offsets);
+
+    cudf::size_type total_bytes = 0;
+    NEO_CHECK_CUDA(cudaMemcpyAsync(
+        &total_bytes, d_offsets + string_count, sizeof(cudf::size_type), cudaMemcpyDeviceToHost, stream.value()));
+    NEO_CHECK_CUDA(cudaStreamSynchronize(stream.value()));
+
+    // Single allocation for all of the output characters
+    auto chars_column = cudf::make_numeric_column(
+        cudf::data_type{cudf::type_id::INT8}, total_bytes, cudf::mask_state::UNALLOCATED, stream);
+
+    if (string_count > 0 && total_bytes > 0)
+    {
+        JsonUtil__unescape_chars_kernel<<<blocks, threads_per_block, 0, stream.value()>>>(
+            d_strings, d_offsets, chars_column->mutable_view().data<char>());
+        NEO_CHECK_CUDA(cudaGetLastError());
+    }
+
+    return cudf::make_strings_column(string_count,
+                                     std::move(offsets_column),
+                                     std::move(chars_column),
+                                     input.null_count(),
+                                     cudf::copy_bitmask(input, stream));
+}
+}  // namespace morpheus
@@ -18,15 +18,54 @@
 #include <morpheus/utilities/matx_util.hpp>
 
 #include <morpheus/objects/dev_mem_info.hpp>
+#include <morpheus/utilities/device_annotation.hpp>
+#include <morpheus/utilities/type_dispatch.hpp>
 #include <morpheus/utilities/type_util.hpp>
 #include <morpheus/objects/tensor_object.hpp>
 
+#include <glog/logging.h>
+#include <neo/cuda/common.hpp>
 #include <neo/cuda/sync.hpp>
 
+#include <cub/device/device_segmented_radix_sort.cuh>
+#include <cudf/column/column_view.hpp>
+#include <cudf/types.hpp>
+#include <cudf/utilities/traits.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cufft.h>
 #include <matx.h>
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
 namespace morpheus {
 
+    // Component-private free functions.
+    /**
+     * @brief The half types are tensor only. They have no cudf representation
+     */
+    template<>
+    struct TypeIdOf<matx::matxFp16> {
+        static constexpr TypeId value = TypeId::FLOAT16;
+    };
+
+    template<>
+    struct TypeIdOf<matx::matxBf16> {
+        static constexpr TypeId value = TypeId::BFLOAT16;
+    };
+
+    // Element types dispatched by the primitives below. Kernels are instantiated for exactly these types
+    using MatxUtil__HalfTypes = TypeList<matx::matxFp16, matx::matxBf16>;
+    using MatxUtil__FloatingTypes = type_list_concat_t<FloatingPointTypes, MatxUtil__HalfTypes>;
+    using MatxUtil__AllTypes = type_list_concat_t<CudfTypes, MatxUtil__HalfTypes>;
+
+    // bool is cast like any other arithmetic type
+    using MatxUtil__CastTypes = MatxUtil__AllTypes;
+
     // Component-private classes.
     // ************ MatxUtil__MatxCast**************//
     /**
@@ -39,19 +78,7 @@ namespace morpheus {
         /**
          * TODO(Documentation)
          */
-        template<typename InputT,
-                typename OutputT,
-                std::enable_if_t<!cudf::is_numeric<InputT>() || !cudf::is_numeric<OutputT>()> * = nullptr>
-        void operator()(void *input_data, void *output_data) {
-            throw std::invalid_argument("Unsupported conversion");
-        }
-
-        /**
-         * TODO(Documentation)
-         */
-        template<typename InputT,
-                typename OutputT,
-                std::enable_if_t<cudf::is_numeric<InputT>() && cudf::is_numeric<OutputT>()> * = nullptr>
+        template<typename InputT, typename OutputT>
         void operator()(void *input_data, void *output_data) {
             matx::tensorShape_t<1> shape({static_cast<matx::index_t>(element_count)});
 
@@ -74,15 +101,7 @@ namespace morpheus {
         /**
          * TODO(Documentation)
          */
-        template<typename OutputT, std::enable_if_t<!std::is_integral_v<OutputT>> * = nullptr>
-        void operator()(void *output_data) {
-            throw std::invalid_argument("Unsupported conversion");
-        }
-
-        /**
-         * TODO(Documentation)
-         */
-        template<typename OutputT, std::enable_if_t<std::is_integral_v<OutputT>> * = nullptr>
+        template<typename OutputT>
         void operator()(void *output_data) {
             matx::tensorShape_t<2> shape({static_cast<matx::index_t>(element_count), 3});
 
@@ -109,15 +128,7 @@ namespace morpheus {
         /**
          * TODO(Documentation)
          */
-        template<typename InputT, std::enable_if_t<!cudf::is_floating_point<InputT>()> * = nullptr>
-        void operator()(void *input_data, void *output_data) {
-            throw std::invalid_argument("Unsupported conversion");
-        }
-
-        /**
-         * TODO(Documentation)
-         */
-        template<typename InputT, std::enable_if_t<cudf::is_floating_point<InputT>()> * = nullptr>
+        template<typename InputT>
         void operator()(void *input_data, void *output_data) {
             matx::tensorShape_t<1> shape({static_cast<matx::index_t>(element_count)});
 
@@ -142,15 +153,7 @@ namespace morpheus {
         /**
          * TODO(Documentation)
          */
-        template<typename InputT, std::enable_if_t<!cudf::is_numeric<InputT>()> * = nullptr>
-        void operator()(void *input_data, void *output_data) {
-            throw std::invalid_argument("Unsupported conversion");
-        }
-
-        /**
-         * TODO(Documentation)
-         */
-        template<typename InputT, std::enable_if_t<cudf::is_numeric<InputT>()> * = nullptr>
+        template<typename InputT>
         void operator()(void *input_data, void *output_data) {
             matx::tensorShape_t<2> input_shape({static_cast<matx::index_t>(rows), static_cast<matx::index_t>(cols)});
             matx::tensorShape_t<2> output_shape({static_cast<matx::index_t>(cols), static_cast<matx::index_t>(rows)});
@@ -175,16 +178,7 @@ namespace morpheus {
         /**
          * TODO(Documentation)
          */
-        template<typename InputT, std::enable_if_t<!cudf::is_floating_point<InputT>()> * = nullptr>
-        void
-        operator()(void *input_data, void *output_data, double threshold, const std::vector<TensorIndex> &stride) {
-            throw std::invalid_argument("Unsupported conversion");
-        }
-
-        /**
-         * TODO(Documentation)
-         */
-        template<typename InputT, std::enable_if_t<cudf::is_floating_point<InputT>()> * = nullptr>
+        template<typename InputT>
         void
         operator()(void *input_data, void *output_data, double threshold, const std::vector<TensorIndex> &stride) {
             if (by_row) {
@@ -236,105 +230,2029 @@ namespace morpheus {
                                             static_cast<matx::index_t>(stride[1])};
 
             matx::tensor_t<InputT, 2> input_tensor(static_cast<InputT *>(input_data), shape, matx_stride);
-            matx::tensor_t<bool, 2> output_tensor(static_cast<bool *>(output_data), shape, matx_stride);
+
+            // The output is always row-major, regardless of the input strides
+            matx::tensor_t<bool, 2> output_tensor(static_cast<bool *>(output_data), shape);
 
             // Convert max value to bool
             (output_tensor = input_tensor > (InputT) threshold).run(stream.value());
         }
     };
 
+    // ************ MatxUtil__threshold_with_row_any_kernel**************//
+    /**
+     * @brief One thread per row. Writes `value > thresh_val` for each element to the row-major `labels` and whether any
+     * value in the row is above `row_thresh_val` to `rows_above`. Strides are in elements
+     */
+    template<typename InputT>
+    __global__ void MatxUtil__threshold_with_row_any_kernel(const InputT *input,
+                                                            bool *labels,
+                                                            bool *rows_above,
+                                                            std::size_t rows,
+                                                            std::size_t cols,
+                                                            TensorIndex row_stride,
+                                                            TensorIndex col_stride,
+                                                            InputT thresh_val,
+                                                            InputT row_thresh_val) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (row >= rows) {
+            return;
+        }
+
+        bool any_above = false;
+
+        for (std::size_t col = 0; col < cols; ++col) {
+            InputT value = input[row * row_stride + col * col_stride];
+
+            labels[row * cols + col] = value > thresh_val;
+            any_above = any_above || value > row_thresh_val;
+        }
+
+        rows_above[row] = any_above;
+    }
+
+    /**
+     * @brief Launches `MatxUtil__threshold_with_row_any_kernel` for floating point inputs
+     */
+    struct MatxUtil__ThresholdWithRowAny { // NOLINT
+        std::size_t rows;
+        std::size_t cols;
+        TensorIndex row_stride;
+        TensorIndex col_stride;
+        rmm::cuda_stream_view stream;
+
+        template<typename InputT>
+        void operator()(const void *input_data, bool *labels, bool *rows_above, double thresh_val,
+                        double row_thresh_val) {
+            constexpr int block_size = 256;
+            auto grid_size = static_cast<unsigned int>((rows + block_size - 1) / block_size);
+
+            MatxUtil__threshold_with_row_any_kernel<InputT><<<grid_size, block_size, 0, stream.value()>>>(
+                    static_cast<const InputT *>(input_data),
+                    labels,
+                    rows_above,
+                    rows,
+                    cols,
+                    row_stride,
+                    col_stride,
+                    static_cast<InputT>(thresh_val),
+                    static_cast<InputT>(row_thresh_val));
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+    };
+
+    // ************ MatxUtil__narrow_to_int32_kernel**************//
+    /**
+     * @brief Maximum number of arrays narrowed by a single launch
+     */
+    constexpr std::size_t MatxUtil__MaxNarrowSegments = 8;
+
+    /**
+     * @brief Outputs are aligned so each one can be used as its own tensor
+     */
+    constexpr std::size_t MatxUtil__OutputAlignment = 256;
+
+    /**
+     * @brief Passed by value to the kernel. `ends` holds the running total of elements up to and including each array
+     */
+    struct MatxUtil__NarrowSegments {
+        const uint32_t *inputs[MatxUtil__MaxNarrowSegments];
+        int32_t *outputs[MatxUtil__MaxNarrowSegments];
+        std::size_t ends[MatxUtil__MaxNarrowSegments];
+        std::size_t count;
+    };
+
+    /**
+     * @brief One thread per element across all of the arrays
+     */
+    __global__ void MatxUtil__narrow_to_int32_kernel(MatxUtil__NarrowSegments segments) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= segments.ends[segments.count - 1]) {
+            return;
+        }
+
+        std::size_t segment = 0;
+        while (idx >= segments.ends[segment]) {
+            ++segment;
+        }
+
+        std::size_t local_idx = idx - (segment == 0 ? 0 : segments.ends[segment - 1]);
+
+        segments.outputs[segment][local_idx] = static_cast<int32_t>(segments.inputs[segment][local_idx]);
+    }
+
+    // ************ MatxUtil__pack_columns_kernel**************//
+    /**
+     * @brief Describes one input column for `MatxUtil__pack_columns_kernel`. `data` already includes the column offset.
+     * Values are written as `(x - shift) * scale`
+     */
+    struct MatxUtil__PackColumn {
+        const void *data;
+        cudf::type_id type;
+        float shift;
+        float scale;
+    };
+
+    /**
+     * @brief Reads element `row` of a type-erased numeric column as float
+     */
+    __device__ float MatxUtil__load_as_float(const MatxUtil__PackColumn &column, std::size_t row) {
+        switch (column.type) {
+            case cudf::type_id::INT8:
+                return static_cast<float>(static_cast<const int8_t *>(column.data)[row]);
+            case cudf::type_id::INT16:
+                return static_cast<float>(static_cast<const int16_t *>(column.data)[row]);
+            case cudf::type_id::INT32:
+                return static_cast<float>(static_cast<const int32_t *>(column.data)[row]);
+            case cudf::type_id::INT64:
+                return static_cast<float>(static_cast<const int64_t *>(column.data)[row]);
+            case cudf::type_id::UINT8:
+                return static_cast<float>(static_cast<const uint8_t *>(column.data)[row]);
+            case cudf::type_id::UINT16:
+                return static_cast<float>(static_cast<const uint16_t *>(column.data)[row]);
+            case cudf::type_id::UINT32:
+                return static_cast<float>(static_cast<const uint32_t *>(column.data)[row]);
+            case cudf::type_id::UINT64:
+                return static_cast<float>(static_cast<const uint64_t *>(column.data)[row]);
+            case cudf::type_id::FLOAT64:
+                return static_cast<float>(static_cast<const double *>(column.data)[row]);
+            case cudf::type_id::BOOL8:
+                return static_cast<const bool *>(column.data)[row] ? 1.0f : 0.0f;
+            default:
+                return static_cast<const float *>(column.data)[row];
+        }
+    }
+
+    /**
+     * @brief One thread per output element, output is a row-major [rows, cols] float matrix
+     */
+    __global__ void MatxUtil__pack_columns_kernel(const MatxUtil__PackColumn *columns,
+                                                  float *output,
+                                                  std::size_t rows,
+                                                  std::size_t cols) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= rows * cols) {
+            return;
+        }
+
+        std::size_t row = idx / cols;
+        std::size_t col = idx % cols;
+
+        const auto &column = columns[col];
+
+        output[idx] = (MatxUtil__load_as_float(column, row) - column.shift) * column.scale;
+    }
+
+    /**
+     * @brief Most columns whose descriptors are passed to the kernel by value, avoiding a copy to the device and a
+     * synchronization
+     */
+    constexpr std::size_t MatxUtil__MaxPackColumnsByValue = 64;
+
+    struct MatxUtil__PackColumnArray {
+        MatxUtil__PackColumn columns[MatxUtil__MaxPackColumnsByValue];
+    };
+
+    /**
+     * @brief Same as `MatxUtil__pack_columns_kernel`, with the descriptors passed by value
+     */
+    __global__ void MatxUtil__pack_columns_by_value_kernel(MatxUtil__PackColumnArray columns,
+                                                           float *output,
+                                                           std::size_t rows,
+                                                           std::size_t cols) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= rows * cols) {
+            return;
+        }
+
+        std::size_t row = idx / cols;
+        std::size_t col = idx % cols;
+
+        const auto &column = columns.columns[col];
+
+        output[idx] = (MatxUtil__load_as_float(column, row) - column.shift) * column.scale;
+    }
+
+    // ************ MatxUtil__pack_features_kernel**************//
+    /**
+     * @brief Device arguments of `MatxUtil__pack_features_kernel`, followed by one `MatxUtil__PackColumn` per column
+     */
+    struct MatxUtil__PackFeaturesArgs {
+        float *packed;
+        uint32_t *seg_ids;
+    };
+
+    static_assert(sizeof(MatxUtil__PackFeaturesArgs) % alignof(MatxUtil__PackColumn) == 0,
+                  "The column descriptors following the arguments must be aligned");
+
+    /**
+     * @brief One thread per packed element followed by one thread per row of seg ids. Every pointer is read from
+     * `args`, so a CUDA Graph of the launch replays with other columns and outputs
+     */
+    __global__ void MatxUtil__pack_features_kernel(const uint8_t *args, std::size_t rows, std::size_t cols) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        const auto &header = *reinterpret_cast<const MatxUtil__PackFeaturesArgs *>(args);
+
+        if (idx < rows * cols) {
+            const auto *columns = reinterpret_cast<const MatxUtil__PackColumn *>(args + sizeof(header));
+
+            std::size_t row = idx / cols;
+            const auto &column = columns[idx % cols];
+
+            header.packed[idx] = (MatxUtil__load_as_float(column, row) - column.shift) * column.scale;
+        } else if (idx < rows * cols + rows) {
+            std::size_t row = idx - rows * cols;
+
+            header.seg_ids[row * 3] = static_cast<uint32_t>(row);
+            header.seg_ids[row * 3 + 1] = 0;
+            header.seg_ids[row * 3 + 2] = static_cast<uint32_t>(cols - 1);
+        }
+    }
+
+    // ************ MatxUtil__copy_rows_kernel**************//
+    /**
+     * @brief One thread per output element. When `scatter` is false output row i is read from input row
+     * row_indices[i], otherwise input row i is written to output row row_indices[i]. Strides are in elements
+     */
+    __global__ void MatxUtil__copy_rows_kernel(const uint8_t *input,
+                                               uint8_t *output,
+                                               const int32_t *row_indices,
+                                               std::size_t rows,
+                                               std::size_t cols,
+                                               std::size_t item_size,
+                                               std::size_t input_row_stride,
+                                               std::size_t input_col_stride,
+                                               bool scatter) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= rows * cols) {
+            return;
+        }
+
+        std::size_t row = idx / cols;
+        std::size_t col = idx % cols;
+
+        std::size_t input_row = scatter ? row : row_indices[row];
+        std::size_t output_row = scatter ? row_indices[row] : row;
+
+        const uint8_t *src = input + (input_row * input_row_stride + col * input_col_stride) * item_size;
+        uint8_t *dst = output + (output_row * cols + col) * item_size;
+
+        for (std::size_t b = 0; b < item_size; ++b) {
+            dst[b] = src[b];
+        }
+    }
+
+    // ************ MatxUtil__hash_rows_kernel**************//
+    constexpr uint64_t MatxUtil__FnvOffsetBasis = 14695981039346656037ULL;
+    constexpr uint64_t MatxUtil__FnvPrime = 1099511628211ULL;
+
+    /**
+     * @brief One thread per row. The width is hashed first so rows of different widths sharing a prefix differ
+     */
+    __global__ void MatxUtil__hash_rows_kernel(const uint8_t *input,
+                                               uint64_t *hashes,
+                                               std::size_t rows,
+                                               std::size_t cols,
+                                               std::size_t item_size,
+                                               std::size_t row_stride,
+                                               std::size_t col_stride,
+                                               bool combine) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (row >= rows) {
+            return;
+        }
+
+        uint64_t hash = combine ? hashes[row] : MatxUtil__FnvOffsetBasis;
+
+        hash = (hash ^ static_cast<uint64_t>(cols)) * MatxUtil__FnvPrime;
+
+        for (std::size_t col = 0; col < cols; ++col) {
+            const uint8_t *item = input + (row * row_stride + col * col_stride) * item_size;
+
+            for (std::size_t b = 0; b < item_size; ++b) {
+                hash = (hash ^ item[b]) * MatxUtil__FnvPrime;
+            }
+        }
+
+        hashes[row] = hash;
+    }
+
+    // ************ MatxUtil__row_lengths_kernel**************//
+    /**
+     * @brief One thread per row. Writes the index of the last non-zero element in the row plus one
+     */
+    __global__ void MatxUtil__row_lengths_kernel(const uint8_t *input,
+                                                 int32_t *output,
+                                                 std::size_t rows,
+                                                 std::size_t cols,
+                                                 std::size_t item_size,
+                                                 std::size_t row_stride,
+                                                 std::size_t col_stride) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (row >= rows) {
+            return;
+        }
+
+        int32_t length = 0;
+
+        for (std::size_t col = 0; col < cols; ++col) {
+            const uint8_t *item = input + (row * row_stride + col * col_stride) * item_size;
+
+            for (std::size_t b = 0; b < item_size; ++b) {
+                if (item[b] != 0) {
+                    length = static_cast<int32_t>(col + 1);
+                    break;
+                }
+            }
+        }
+
+        output[row] = length;
+    }
+
     // Component public implementations
-    // ************ MatxUtil************************* //
-    std::shared_ptr<rmm::device_buffer> MatxUtil::cast(const DevMemInfo &input, TypeId output_type) {
-        auto input_dtype = DType(input.type_id);
-        auto output_dtype = DType(output_type);
+    // ************ MatxUtil__dispatch_floating**************//
+    /**
+     * @brief Compile-time dispatch shared by the row-wise primitives below. Calls `func` with a `TypeTag` for the
+     * floating point type matching `type_id`, so each primitive is a single generic launch
+     */
+    template<typename FuncT>
+    void MatxUtil__dispatch_floating(TypeId type_id, FuncT &&func) {
+        dispatch_type<FloatingPointTypes>(
+                type_id, std::forward<FuncT>(func), "Only floating point tensors are supported");
+    }
 
-        // Create the output
-        auto output = std::make_shared<rmm::device_buffer>(
-                output_dtype.item_size() * input.element_count, input.buffer->stream(),
-                input.buffer->memory_resource());
+    /**
+     * @brief Calls `func.template operator()<T>(args...)` for the type of `ListT` matching `type_id`
+     */
+    template<typename ListT, typename FuncT, typename... ArgsT>
+    void MatxUtil__type_dispatcher(TypeId type_id, FuncT func, ArgsT &&...args) {
+        dispatch_type<ListT>(
+                type_id,
+                [&](auto tag) {
+                    func.template operator()<typename decltype(tag)::type>(std::forward<ArgsT>(args)...);
+                },
+                "Unsupported conversion");
+    }
 
-        cudf::double_type_dispatcher(cudf::data_type{input_dtype.cudf_type_id()},
-                                     cudf::data_type{output_dtype.cudf_type_id()},
-                                     MatxUtil__MatxCast{input.element_count, output->stream()},
-                                     input.data(),
-                                     output->data());
+    /**
+     * @brief Pair version of `MatxUtil__type_dispatcher`, only the combinations of `InputListT` and `OutputListT` are
+     * instantiated
+     */
+    template<typename InputListT, typename OutputListT, typename FuncT, typename... ArgsT>
+    void MatxUtil__double_type_dispatcher(TypeId input_type, TypeId output_type, FuncT func, ArgsT &&...args) {
+        dispatch_type_pair<InputListT, OutputListT>(
+                input_type,
+                output_type,
+                [&](auto input_tag, auto output_tag) {
+                    func.template operator()<typename decltype(input_tag)::type, typename decltype(output_tag)::type>(
+                            std::forward<ArgsT>(args)...);
+                },
+                "Unsupported conversion");
+    }
 
-        neo::enqueue_stream_sync_event(output->stream()).get();
+    /**
+     * @brief Element (row, col) of a strided 2D input. Strides are in elements
+     */
+    struct MatxUtil__Strided2D {
+        TensorIndex row_stride;
+        TensorIndex col_stride;
 
-        return output;
+        __device__ std::size_t operator()(std::size_t row, std::size_t col) const {
+            return row * row_stride + col * col_stride;
+        }
+    };
+
+    /**
+     * @brief Folds `value` into `acc` for `reduction`. MEAN sums, the caller divides by the count
+     */
+    template<typename T>
+    __device__ T MatxUtil__combine(RowReduction reduction, T acc, T value) {
+        switch (reduction) {
+            case RowReduction::MAX:
+                return value > acc ? value : acc;
+            case RowReduction::MIN:
+                return value < acc ? value : acc;
+            default:
+                return acc + value;
+        }
     }
 
-    std::shared_ptr<rmm::device_buffer>
-    MatxUtil::create_seg_ids(size_t row_count, size_t fea_len, TypeId output_type) {
-        auto output_dtype = DType(output_type);
+    // ************ MatxUtil__reduce_rows_kernel**************//
+    /**
+     * @brief One thread per row
+     */
+    template<typename T>
+    __global__ void MatxUtil__reduce_rows_kernel(const T *input, T *output, std::size_t rows, std::size_t cols,
+                                                 MatxUtil__Strided2D at, RowReduction reduction) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
 
-        // Now create the output
-        auto output =
-                std::make_shared<rmm::device_buffer>(output_dtype.item_size() * row_count * 3,
-                                                     rmm::cuda_stream_per_thread);
+        if (row >= rows) {
+            return;
+        }
 
-        cudf::type_dispatcher(cudf::data_type{output_dtype.cudf_type_id()},
-                              MatxUtil__MatxCreateSegIds{row_count, fea_len, output->stream()},
-                              output->data());
+        T acc = input[at(row, 0)];
+        for (std::size_t col = 1; col < cols; ++col) {
+            acc = MatxUtil__combine(reduction, acc, input[at(row, col)]);
+        }
 
-        return output;
+        output[row] = reduction == RowReduction::MEAN ? acc / static_cast<T>(cols) : acc;
     }
 
-    std::shared_ptr<rmm::device_buffer> MatxUtil::logits(const DevMemInfo &input) {
-        auto input_dtype = DType(input.type_id);
+    // ************ MatxUtil__predict_forest_kernel**************//
+    /**
+     * @brief One thread per row, walking every tree in turn. Rows of a warp usually diverge after the first few
+     * levels, but the trees are small and the nodes are shared by every row so they stay in cache
+     */
+    template<typename T>
+    __global__ void MatxUtil__predict_forest_kernel(const T *input, float *output, std::size_t rows,
+                                                    MatxUtil__Strided2D at, const ForestNode *nodes,
+                                                    const int32_t *tree_roots, const int32_t *tree_outputs,
+                                                    std::size_t num_trees, std::size_t num_outputs,
+                                                    float base_margin, bool sigmoid) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (row >= rows) {
+            return;
+        }
 
-        // Now create the output
-        auto output = std::make_shared<rmm::device_buffer>(
-                input_dtype.item_size() * input.element_count, input.buffer->stream(), input.buffer->memory_resource());
+        float *row_output = output + row * num_outputs;
+
+        for (std::size_t out = 0; out < num_outputs; ++out) {
+            row_output[out] = base_margin;
+        }
 
-        cudf::type_dispatcher(cudf::data_type{input_dtype.cudf_type_id()},
-                              MatxUtil__MatxLogits{input.element_count, output->stream()},
-                              input.data(),
-                              output->data());
+        for (std::size_t tree = 0; tree < num_trees; ++tree) {
+            int32_t node_idx = tree_roots[tree];
 
-        return output;
+            while (nodes[node_idx].left >= 0) {
+                const ForestNode &node = nodes[node_idx];
+                const auto value = static_cast<float>(input[at(row, node.feature)]);
+
+                if (isnan(value)) {
+                    node_idx = node.missing;
+                } else {
+                    node_idx = value < node.value ? node.left : node.right;
+                }
+            }
+
+            row_output[tree_outputs[tree]] += nodes[node_idx].value;
+        }
+
+        if (sigmoid) {
+            for (std::size_t out = 0; out < num_outputs; ++out) {
+                row_output[out] = 1.0f / (1.0f + expf(-row_output[out]));
+            }
+        }
     }
 
-    std::shared_ptr<rmm::device_buffer> MatxUtil::transpose(const DevMemInfo &input, size_t rows, size_t cols) {
-        auto input_dtype = DType(input.type_id);
+    // ************ MatxUtil__softmax_kernel**************//
+    /**
+     * @brief One thread per row. Subtracts the row max before exponentiating for stability
+     */
+    template<typename T>
+    __global__ void MatxUtil__softmax_kernel(const T *input, T *output, std::size_t rows, std::size_t cols,
+                                             MatxUtil__Strided2D at) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
 
-        // Now create the output
-        auto output = std::make_shared<rmm::device_buffer>(
-                input_dtype.item_size() * input.element_count, input.buffer->stream(), input.buffer->memory_resource());
+        if (row >= rows) {
+            return;
+        }
+
+        T max_val = input[at(row, 0)];
+        for (std::size_t col = 1; col < cols; ++col) {
+            max_val = MatxUtil__combine(RowReduction::MAX, max_val, input[at(row, col)]);
+        }
 
-        cudf::type_dispatcher(cudf::data_type{input_dtype.cudf_type_id()},
-                              MatxUtil__MatxTranspose{input.element_count, output->stream(), rows, cols},
-                              input.data(),
-                              output->data());
+        T sum = 0;
+        for (std::size_t col = 0; col < cols; ++col) {
+            T value = exp(input[at(row, col)] - max_val);
 
-        return output;
+            output[row * cols + col] = value;
+            sum += value;
+        }
+
+        for (std::size_t col = 0; col < cols; ++col) {
+            output[row * cols + col] /= sum;
+        }
     }
 
-    std::shared_ptr<rmm::device_buffer>
-    MatxUtil::threshold(const DevMemInfo &input, size_t rows, size_t cols,
-                        const std::vector<TensorIndex> &stride,
-                        double thresh_val, bool by_row) {
-        auto input_dtype = DType(input.type_id);
+    // ************ MatxUtil__top_k_kernel**************//
+    /**
+     * @brief Largest supported `k` for `MatxUtil::top_k`, each thread keeps its candidates in registers
+     */
+    constexpr std::size_t MatxUtil__MaxTopK = 32;
 
-        std::size_t output_size = sizeof(bool) * rows;
-        if (!by_row) {
-            output_size *= cols;
+    /**
+     * @brief One thread per row. Keeps the best `k` values seen so far sorted in descending order, ties keep the
+     * lowest column
+     */
+    template<typename T>
+    __global__ void MatxUtil__top_k_kernel(const T *input, T *values, int32_t *indices, std::size_t rows,
+                                           std::size_t cols, std::size_t k, MatxUtil__Strided2D at) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (row >= rows) {
+            return;
         }
 
-        // Now create the output array of bools
-        auto output = std::make_shared<rmm::device_buffer>(output_size, input.buffer->stream(),
-                                                           input.buffer->memory_resource());
+        T best_vals[MatxUtil__MaxTopK];
+        int32_t best_idx[MatxUtil__MaxTopK];
+        std::size_t found = 0;
 
-        cudf::type_dispatcher(cudf::data_type{input_dtype.cudf_type_id()},
-                              MatxUtil__MatxThreshold{rows, cols, by_row, output->stream()},
-                              input.data(),
-                              output->data(),
-                              thresh_val,
-                              stride);
+        for (std::size_t col = 0; col < cols; ++col) {
+            T value = input[at(row, col)];
 
-        neo::enqueue_stream_sync_event(output->stream()).get();
+            if (found == k && !(value > best_vals[k - 1])) {
+                continue;
+            }
 
-        return output;
+            // Insertion sort, dropping the smallest candidate when full
+            std::size_t pos = found < k ? found++ : k - 1;
+            while (pos > 0 && value > best_vals[pos - 1]) {
+                best_vals[pos] = best_vals[pos - 1];
+                best_idx[pos] = best_idx[pos - 1];
+                --pos;
+            }
+
+            best_vals[pos] = value;
+            best_idx[pos] = static_cast<int32_t>(col);
+        }
+
+        for (std::size_t i = 0; i < k; ++i) {
+            values[row * k + i] = best_vals[i];
+            indices[row * k + i] = best_idx[i];
+        }
+    }
+
+    // ************ MatxUtil__reduce_by_seq_ids_kernel**************//
+    /**
+     * @brief One thread per output element. `seq_ids[:, 0]` must be sorted, the rows for message `m`, whose id is
+     * `first_message + m`, are found with a binary search. Messages without any rows are set to 0
+     */
+    template<typename T>
+    __global__ void MatxUtil__reduce_by_seq_ids_kernel(const T *input, const int32_t *seq_ids, T *output,
+                                                       std::size_t rows, std::size_t cols, std::size_t num_messages,
+                                                       MatxUtil__Strided2D at, TensorIndex seq_row_stride,
+                                                       RowReduction reduction, std::size_t first_message) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= num_messages * cols) {
+            return;
+        }
+
+        const std::size_t message = first_message + idx / cols;
+        const std::size_t col = idx % cols;
+
+        // First row whose message id is >= `target`
+        auto lower_bound = [&](std::size_t target) {
+            std::size_t lo = 0;
+            std::size_t hi = rows;
+            while (lo < hi) {
+                std::size_t mid = (lo + hi) / 2;
+                if (static_cast<std::size_t>(seq_ids[mid * seq_row_stride]) < target) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return lo;
+        };
+
+        const std::size_t start = lower_bound(message);
+        const std::size_t stop = lower_bound(message + 1);
+
+        if (start == stop) {
+            output[idx] = 0;
+            return;
+        }
+
+        T acc = input[at(start, col)];
+        for (std::size_t row = start + 1; row < stop; ++row) {
+            acc = MatxUtil__combine(reduction, acc, input[at(row, col)]);
+        }
+
+        output[idx] = reduction == RowReduction::MEAN ? acc / static_cast<T>(stop - start) : acc;
+    }
+
+    // ************ MatxUtil__scatter_columns_kernel**************//
+    /**
+     * @brief Most columns written by a single launch, `MatxUtil::scatter_columns` launches once per group
+     */
+    constexpr std::size_t MatxUtil__MaxScatterColumns = 64;
+
+    /**
+     * @brief Passed by value to the kernel. Output `i` receives input column `input_columns[i]`
+     */
+    struct MatxUtil__ScatterColumns {
+        void *outputs[MatxUtil__MaxScatterColumns];
+        TensorIndex input_columns[MatxUtil__MaxScatterColumns];
+        std::size_t count;
+    };
+
+    /**
+     * @brief One thread per output element. Consecutive threads write consecutive rows of the same output
+     */
+    template<typename InputT, typename OutputT>
+    __global__ void MatxUtil__scatter_columns_kernel(const InputT *input, MatxUtil__ScatterColumns columns,
+                                                     std::size_t rows, MatxUtil__Strided2D at) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= rows * columns.count) {
+            return;
+        }
+
+        const std::size_t col = idx / rows;
+        const std::size_t row = idx % rows;
+
+        static_cast<OutputT *>(columns.outputs[col])[row] =
+                static_cast<OutputT>(input[at(row, columns.input_columns[col])]);
+    }
+
+    // ************ MatxUtil__elementwise_kernel**************//
+    /**
+     * @brief Longest expression accepted by `MatxUtil::apply_elementwise`
+     */
+    constexpr std::size_t MatxUtil__MaxElementwiseOps = 8;
+
+    /**
+     * @brief Passed by value to the kernel
+     */
+    struct MatxUtil__ElementwiseProgram {
+        ElementwiseOp ops[MatxUtil__MaxElementwiseOps];
+        std::size_t count;
+    };
+
+    /**
+     * @brief One thread per element, every op is applied before the single write
+     */
+    template<typename T>
+    __global__ void MatxUtil__elementwise_kernel(const T *input, T *output, std::size_t rows, std::size_t cols,
+                                                 MatxUtil__Strided2D at, MatxUtil__ElementwiseProgram program) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= rows * cols) {
+            return;
+        }
+
+        T value = input[at(idx / cols, idx % cols)];
+
+        for (std::size_t i = 0; i < program.count; ++i) {
+            const auto &op = program.ops[i];
+            const auto a = static_cast<T>(op.a);
+            const auto b = static_cast<T>(op.b);
+
+            switch (op.kind) {
+                case ElementwiseOp::Kind::SIGMOID:
+                    value = T(1) / (T(1) + exp(-value));
+                    break;
+                case ElementwiseOp::Kind::EXP:
+                    value = exp(value);
+                    break;
+                case ElementwiseOp::Kind::LOG:
+                    value = log(value);
+                    break;
+                case ElementwiseOp::Kind::ABS:
+                    value = fabs(value);
+                    break;
+                case ElementwiseOp::Kind::SCALE:
+                    value *= a;
+                    break;
+                case ElementwiseOp::Kind::OFFSET:
+                    value += a;
+                    break;
+                case ElementwiseOp::Kind::CLAMP:
+                    value = value < a ? a : (value > b ? b : value);
+                    break;
+                case ElementwiseOp::Kind::THRESHOLD:
+                    value = value > a ? T(1) : T(0);
+                    break;
+            }
+        }
+
+        output[idx] = value;
+    }
+
+    /**
+     * @brief Shared launch configuration for the kernels above
+     */
+    constexpr int MatxUtil__BlockSize = 256;
+
+    inline unsigned int MatxUtil__grid_size(std::size_t threads) {
+        return static_cast<unsigned int>((threads + MatxUtil__BlockSize - 1) / MatxUtil__BlockSize);
+    }
+
+    /**
+     * @brief Checks `input` is 2D and returns its strides, in elements
+     */
+    MatxUtil__Strided2D MatxUtil__strided_2d(const TensorObject &input, const char *caller) {
+        if (input.rank() != 2) {
+            throw std::invalid_argument(std::string(caller) + " requires a 2D tensor");
+        }
+
+        return MatxUtil__Strided2D{static_cast<TensorIndex>(input.stride(0)),
+                                   static_cast<TensorIndex>(input.stride(1))};
+    }
+
+    // ************ MatxUtil__time_series kernels**************//
+    __host__ __device__ inline int64_t MatxUtil__floor_div(int64_t a, int64_t b) {
+        int64_t q = a / b;
+        return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+    }
+
+    __host__ __device__ inline std::size_t MatxUtil__ring_slot(int32_t bin, std::size_t capacity) {
+        auto c = static_cast<int64_t>(capacity);
+        return static_cast<std::size_t>(((bin % c) + c) % c);
+    }
+
+    /**
+     * @brief One thread per row. `min_max` must start as {INT32_MAX, INT32_MIN}
+     */
+    __global__ void MatxUtil__time_bins_kernel(const int64_t *ticks, std::size_t rows, int64_t ticks_per_second,
+                                               int64_t t0_sec, int64_t resolution_sec, int32_t *row_bins,
+                                               int32_t *min_max) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (row >= rows) {
+            return;
+        }
+
+        // Same rounding as `pd.Series.dt.round(freq="S")`
+        int64_t sec = MatxUtil__floor_div(ticks[row], ticks_per_second);
+        int64_t rem = 2 * (ticks[row] - sec * ticks_per_second);
+
+        if (rem > ticks_per_second || (rem == ticks_per_second && (sec & 1) != 0)) {
+            ++sec;
+        }
+
+        auto bin = static_cast<int32_t>(MatxUtil__floor_div(sec - t0_sec, resolution_sec));
+
+        row_bins[row] = bin;
+        atomicMin(&min_max[0], bin);
+        atomicMax(&min_max[1], bin);
+    }
+
+    __global__ void MatxUtil__add_to_histogram_kernel(const int32_t *row_bins, std::size_t rows, int32_t lo,
+                                                      int32_t hi, int32_t *counts, std::size_t capacity) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (row >= rows || row_bins[row] < lo || row_bins[row] > hi) {
+            return;
+        }
+
+        atomicAdd(&counts[MatxUtil__ring_slot(row_bins[row], capacity)], 1);
+    }
+
+    __device__ inline int32_t MatxUtil__window_count(const TimeSeriesWindow &window, int32_t bin) {
+        if (bin < window.lo || bin > window.hi) {
+            return 0;
+        }
+
+        return window.counts[MatxUtil__ring_slot(bin, window.capacity)];
+    }
+
+    __global__ void MatxUtil__window_signals_kernel(const TimeSeriesWindow *windows, double *signals,
+                                                    std::size_t num_windows, std::size_t length) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= num_windows * length) {
+            return;
+        }
+
+        const TimeSeriesWindow &window = windows[idx / length];
+        const auto i = static_cast<int32_t>(idx % length);
+
+        double value = MatxUtil__window_count(window, window.first_bin + i);
+
+        // The last histogram bucket is closed on both sides
+        if (i == static_cast<int32_t>(length) - 1) {
+            value += MatxUtil__window_count(window, window.first_bin + i + 1);
+        }
+
+        signals[idx] = value;
+    }
+
+    /**
+     * @brief Sums `value` over the block, which must be `MatxUtil__BlockSize` threads
+     */
+    __device__ double MatxUtil__block_sum(double value, double *scratch) {
+        scratch[threadIdx.x] = value;
+        __syncthreads();
+
+        for (unsigned int stride = blockDim.x / 2; stride > 0; stride >>= 1) {
+            if (threadIdx.x < stride) {
+                scratch[threadIdx.x] += scratch[threadIdx.x + stride];
+            }
+            __syncthreads();
+        }
+
+        double total = scratch[0];
+        __syncthreads();
+
+        return total;
+    }
+
+    /**
+     * @brief One block per signal. Periodogram of the standardized signal, computed from the spectrum of the raw one
+     */
+    __global__ void MatxUtil__periodogram_kernel(const double *signals, const cufftDoubleComplex *spectrum,
+                                                 double *periodogram, std::size_t length, std::size_t num_freqs) {
+        __shared__ double scratch[MatxUtil__BlockSize];
+
+        const double *signal = signals + blockIdx.x * length;
+
+        double sum = 0;
+        for (std::size_t i = threadIdx.x; i < length; i += blockDim.x) {
+            sum += signal[i];
+        }
+        const double mean = MatxUtil__block_sum(sum, scratch) / length;
+
+        double sq_sum = 0;
+        for (std::size_t i = threadIdx.x; i < length; i += blockDim.x) {
+            sq_sum += (signal[i] - mean) * (signal[i] - mean);
+        }
+        const double var = MatxUtil__block_sum(sq_sum, scratch) / length;
+
+        for (std::size_t k = threadIdx.x; k < num_freqs; k += blockDim.x) {
+            const cufftDoubleComplex &z = spectrum[blockIdx.x * num_freqs + k];
+
+            // Standardizing removes the mean (k == 0) and divides every other frequency by the std
+            periodogram[blockIdx.x * num_freqs + k] =
+                    (k == 0 || var == 0) ? 0.0 : (z.x * z.x + z.y * z.y) / (length * var);
+        }
+    }
+
+    /**
+     * @brief Removes the frequencies below the `percent` percentile (linearly interpolated, as `cupy.percentile`)
+     */
+    __global__ void MatxUtil__filter_spectrum_kernel(const double *periodogram, const double *sorted,
+                                                     cufftDoubleComplex *spectrum, std::size_t num_signals,
+                                                     std::size_t num_freqs, double percent) {
+        std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (idx >= num_signals * num_freqs) {
+            return;
+        }
+
+        const double *signal_sorted = sorted + (idx / num_freqs) * num_freqs;
+
+        const double pos = percent / 100.0 * (num_freqs - 1);
+        const auto below = static_cast<std::size_t>(floor(pos));
+        const auto above = below + 1 < num_freqs ? below + 1 : below;
+
+        const double threshold =
+                signal_sorted[below] + (signal_sorted[above] - signal_sorted[below]) * (pos - below);
+
+        if (periodogram[idx] < threshold) {
+            spectrum[idx] = cufftDoubleComplex{0, 0};
+        }
+    }
+
+    /**
+     * @brief One block per signal. `recon` is the unnormalized output of the inverse transform
+     */
+    __global__ void MatxUtil__flag_outliers_kernel(const double *signals, const double *recon, bool *flags,
+                                                   std::size_t length, double zscore_threshold) {
+        __shared__ double scratch[MatxUtil__BlockSize];
+
+        const std::size_t offset = blockIdx.x * length;
+
+        double sum = 0;
+        for (std::size_t i = threadIdx.x; i < length; i += blockDim.x) {
+            sum += fabs(recon[offset + i] / length - signals[offset + i]);
+        }
+        const double mean = MatxUtil__block_sum(sum, scratch) / length;
+
+        double sq_sum = 0;
+        for (std::size_t i = threadIdx.x; i < length; i += blockDim.x) {
+            const double err = fabs(recon[offset + i] / length - signals[offset + i]);
+            sq_sum += (err - mean) * (err - mean);
+        }
+        const double std_dev = sqrt(MatxUtil__block_sum(sq_sum, scratch) / length);
+
+        for (std::size_t i = threadIdx.x; i < length; i += blockDim.x) {
+            const double err = fabs(recon[offset + i] / length - signals[offset + i]);
+
+            // A constant error never flags anything, as the NaN z-scores of cupy
+            flags[offset + i] = std_dev > 0 && fabs(err - mean) / std_dev >= zscore_threshold;
+        }
+    }
+
+    __global__ void MatxUtil__flag_rows_kernel(const int32_t *row_bins, std::size_t rows, const bool *bin_flags,
+                                               int32_t first_bin, std::size_t num_bins, bool *row_flags) {
+        std::size_t row = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+        if (row >= rows) {
+            return;
+        }
+
+        const int64_t bin = static_cast<int64_t>(row_bins[row]) - first_bin;
+
+        row_flags[row] = bin >= 0 && bin < static_cast<int64_t>(num_bins) && bin_flags[bin];
+    }
+
+    inline void MatxUtil__check_cufft(cufftResult result) {
+        if (result != CUFFT_SUCCESS) {
+            throw std::runtime_error("cuFFT call failed with error " + std::to_string(static_cast<int>(result)));
+        }
+    }
+
+    /**
+     * @brief Owns a cuFFT plan of `batch` transforms of `length` values, enqueued on `stream`
+     */
+    class MatxUtil__CufftPlan {
+    public:
+        MatxUtil__CufftPlan(cufftType type, std::size_t length, std::size_t batch, rmm::cuda_stream_view stream) {
+            int n = static_cast<int>(length);
+            int freqs = static_cast<int>(length / 2 + 1);
+
+            int in_dist = type == CUFFT_D2Z ? n : freqs;
+            int out_dist = type == CUFFT_D2Z ? freqs : n;
+
+            MatxUtil__check_cufft(cufftPlanMany(&m_handle, 1, &n, nullptr, 1, in_dist, nullptr, 1, out_dist, type,
+                                                static_cast<int>(batch)));
+            MatxUtil__check_cufft(cufftSetStream(m_handle, stream.value()));
+        }
+
+        ~MatxUtil__CufftPlan() {
+            cufftDestroy(m_handle);
+        }
+
+        MatxUtil__CufftPlan(const MatxUtil__CufftPlan &) = delete;
+        MatxUtil__CufftPlan &operator=(const MatxUtil__CufftPlan &) = delete;
+
+        cufftHandle handle() const {
+            return m_handle;
+        }
+
+    private:
+        cufftHandle m_handle{0};
+    };
+
+    // ************ MatxUtil__pack_column_descriptors**************//
+    /**
+     * @brief Validates the columns given to `pack_columns` and describes them for the packing kernels
+     */
+    static std::vector<MatxUtil__PackColumn> MatxUtil__pack_column_descriptors(
+            const std::vector<cudf::column_view> &columns,
+            const std::vector<float> &shift,
+            const std::vector<float> &scale) {
+        const std::size_t cols = columns.size();
+        const std::size_t rows = cols > 0 ? columns[0].size() : 0;
+
+        if ((!shift.empty() && shift.size() != cols) || shift.size() != scale.size()) {
+            throw std::invalid_argument("pack_columns requires one shift and one scale per column, or neither");
+        }
+
+        std::vector<MatxUtil__PackColumn> descriptors;
+        descriptors.reserve(cols);
+
+        for (const auto &column: columns) {
+            if (!cudf::is_numeric(column.type())) {
+                throw std::invalid_argument("pack_columns only supports numeric and boolean columns");
+            }
+
+            if (static_cast<std::size_t>(column.size()) != rows) {
+                throw std::invalid_argument("pack_columns requires all columns to have the same number of rows");
+            }
+
+            const auto col = descriptors.size();
+
+            descriptors.push_back(MatxUtil__PackColumn{
+                    static_cast<const uint8_t *>(column.head()) + column.offset() * cudf::size_of(column.type()),
+                    column.type().id(),
+                    shift.empty() ? 0.0f : shift[col],
+                    scale.empty() ? 1.0f : scale[col]});
+        }
+
+        return descriptors;
+    }
+
+    // ************ MatxUtil************************* //
+    std::shared_ptr<rmm::device_buffer> MatxUtil::cast(const DevMemInfo &input, TypeId output_type) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::cast", input.buffer->stream());
+
+        auto input_dtype = DType(input.type_id);
+        auto output_dtype = DType(output_type);
+
+        // Create the output
+        auto output = std::make_shared<rmm::device_buffer>(
+                output_dtype.item_size() * input.element_count, input.buffer->stream(),
+                input.buffer->memory_resource());
+
+        MatxUtil__double_type_dispatcher<MatxUtil__CastTypes, MatxUtil__CastTypes>(
+                input_dtype.type_id(),
+                output_dtype.type_id(),
+                MatxUtil__MatxCast{input.element_count, output->stream()},
+                input.data(),
+                output->data());
+
+        neo::enqueue_stream_sync_event(output->stream()).get();
+
+        return output;
+    }
+
+    void MatxUtil::cast_into(const void *input,
+                             TypeId input_type,
+                             std::size_t element_count,
+                             TypeId output_type,
+                             void *output,
+                             rmm::cuda_stream_view stream) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::cast_into", stream);
+
+        if (element_count == 0) {
+            return;
+        }
+
+        MatxUtil__double_type_dispatcher<MatxUtil__CastTypes, MatxUtil__CastTypes>(
+                input_type, output_type, MatxUtil__MatxCast{element_count, stream}, const_cast<void *>(input), output);
+    }
+
+    std::shared_ptr<rmm::device_buffer>
+    MatxUtil::create_seg_ids(size_t row_count, size_t fea_len, TypeId output_type) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::create_seg_ids");
+
+        auto output_dtype = DType(output_type);
+
+        // Now create the output
+        auto output =
+                std::make_shared<rmm::device_buffer>(output_dtype.item_size() * row_count * 3,
+                                                     rmm::cuda_stream_per_thread);
+
+        MatxUtil__type_dispatcher<IntegralTypes>(output_type,
+                                                 MatxUtil__MatxCreateSegIds{row_count, fea_len, output->stream()},
+                                                 output->data());
+
+        return output;
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::logits(const DevMemInfo &input) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::logits", input.buffer->stream());
+
+        auto input_dtype = DType(input.type_id);
+
+        // Now create the output
+        auto output = std::make_shared<rmm::device_buffer>(
+                input_dtype.item_size() * input.element_count, input.buffer->stream(), input.buffer->memory_resource());
+
+        MatxUtil__type_dispatcher<MatxUtil__FloatingTypes>(input_dtype.type_id(),
+                                                           MatxUtil__MatxLogits{input.element_count, output->stream()},
+                                                           input.data(),
+                                                           output->data());
+
+        return output;
+    }
+
+    void MatxUtil::logits_into(const void *input, void *output, std::size_t element_count, TypeId type_id) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::logits_into", rmm::cuda_stream_per_thread);
+
+        // Purely elementwise, so reading and writing the same memory is safe
+        MatxUtil__type_dispatcher<MatxUtil__FloatingTypes>(
+                type_id, MatxUtil__MatxLogits{element_count, rmm::cuda_stream_per_thread}, const_cast<void *>(input),
+                output);
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::transpose(const DevMemInfo &input, size_t rows, size_t cols) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::transpose", input.buffer->stream());
+
+        auto input_dtype = DType(input.type_id);
+
+        // Now create the output
+        auto output = std::make_shared<rmm::device_buffer>(
+                input_dtype.item_size() * input.element_count, input.buffer->stream(), input.buffer->memory_resource());
+
+        MatxUtil__type_dispatcher<MatxUtil__AllTypes>(
+                input_dtype.type_id(),
+                MatxUtil__MatxTranspose{input.element_count, output->stream(), rows, cols},
+                input.data(),
+                output->data());
+
+        return output;
+    }
+
+    std::shared_ptr<rmm::device_buffer>
+    MatxUtil::threshold(const DevMemInfo &input, size_t rows, size_t cols,
+                        const std::vector<TensorIndex> &stride,
+                        double thresh_val, bool by_row) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::threshold", input.buffer->stream());
+
+        auto input_dtype = DType(input.type_id);
+
+        std::size_t output_size = sizeof(bool) * rows;
+        if (!by_row) {
+            output_size *= cols;
+        }
+
+        // Now create the output array of bools
+        auto output = std::make_shared<rmm::device_buffer>(output_size, input.buffer->stream(),
+                                                           input.buffer->memory_resource());
+
+        MatxUtil__type_dispatcher<MatxUtil__FloatingTypes>(
+                input_dtype.type_id(),
+                MatxUtil__MatxThreshold{rows, cols, by_row, output->stream()},
+                input.data(),
+                output->data(),
+                thresh_val,
+                stride);
+
+        neo::enqueue_stream_sync_event(output->stream()).get();
+
+        return output;
+    }
+
+    std::shared_ptr<rmm::device_buffer>
+    MatxUtil::threshold(const TensorObject &input, double thresh_val, bool by_row) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::threshold");
+
+        CHECK(input.rank() == 2) << "threshold requires a 2D tensor";
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+        const auto cols = static_cast<std::size_t>(input.shape(1));
+        const std::vector<TensorIndex> stride{static_cast<TensorIndex>(input.stride(0)),
+                                              static_cast<TensorIndex>(input.stride(1))};
+
+        std::size_t output_size = sizeof(bool) * rows;
+        if (!by_row) {
+            output_size *= cols;
+        }
+
+        auto output = std::make_shared<rmm::device_buffer>(output_size, rmm::cuda_stream_per_thread);
+
+        MatxUtil__type_dispatcher<MatxUtil__FloatingTypes>(
+                input.dtype().type_id(),
+                MatxUtil__MatxThreshold{rows, cols, by_row, output->stream()},
+                input.data(),
+                output->data(),
+                thresh_val,
+                stride);
+
+        neo::enqueue_stream_sync_event(output->stream()).get();
+
+        return output;
+    }
+
+    std::vector<DevMemInfo>
+    MatxUtil::threshold_with_row_any(const TensorObject &input, double thresh_val, double row_thresh_val) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::threshold_with_row_any");
+
+        CHECK(input.rank() == 2) << "threshold_with_row_any requires a 2D tensor";
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+        const auto cols = static_cast<std::size_t>(input.shape(1));
+
+        // Both outputs share one allocation, the row flags start at an aligned offset after the labels
+        const std::size_t rows_offset = (rows * cols * sizeof(bool) + MatxUtil__OutputAlignment - 1) /
+                                        MatxUtil__OutputAlignment * MatxUtil__OutputAlignment;
+
+        auto output = std::make_shared<rmm::device_buffer>(rows_offset + rows * sizeof(bool),
+                                                           rmm::cuda_stream_per_thread);
+
+        auto *labels = static_cast<bool *>(output->data());
+        auto *rows_above = reinterpret_cast<bool *>(static_cast<uint8_t *>(output->data()) + rows_offset);
+
+        if (rows > 0) {
+            MatxUtil__type_dispatcher<MatxUtil__FloatingTypes>(
+                    input.dtype().type_id(),
+                    MatxUtil__ThresholdWithRowAny{rows,
+                                                  cols,
+                                                  static_cast<TensorIndex>(input.stride(0)),
+                                                  static_cast<TensorIndex>(input.stride(1)),
+                                                  output->stream()},
+                    input.data(),
+                    labels,
+                    rows_above,
+                    thresh_val,
+                    row_thresh_val);
+        }
+
+        neo::enqueue_stream_sync_event(output->stream()).get();
+
+        return {DevMemInfo{rows * cols, TypeId::BOOL8, output, 0},
+                DevMemInfo{rows, TypeId::BOOL8, output, rows_offset}};
+    }
+
+    std::vector<DevMemInfo> MatxUtil::narrow_to_int32(const std::vector<cudf::column_view> &inputs) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::narrow_to_int32");
+
+        if (inputs.empty() || inputs.size() > MatxUtil__MaxNarrowSegments) {
+            throw std::invalid_argument("narrow_to_int32 supports between 1 and 8 inputs");
+        }
+
+        // Lay the outputs out back to back in a single allocation
+        std::vector<std::size_t> offsets;
+        std::size_t total_bytes = 0;
+
+        for (const auto &input: inputs) {
+            if (input.type().id() != cudf::type_id::UINT32) {
+                throw std::invalid_argument("narrow_to_int32 only supports UINT32 inputs");
+            }
+
+            offsets.push_back(total_bytes);
+
+            total_bytes += input.size() * sizeof(int32_t);
+            total_bytes = (total_bytes + MatxUtil__OutputAlignment - 1) / MatxUtil__OutputAlignment *
+                          MatxUtil__OutputAlignment;
+        }
+
+        auto output = std::make_shared<rmm::device_buffer>(total_bytes, rmm::cuda_stream_per_thread);
+
+        MatxUtil__NarrowSegments segments{};
+        std::vector<DevMemInfo> results;
+        std::size_t element_count = 0;
+
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            element_count += inputs[i].size();
+
+            segments.inputs[i] = inputs[i].data<uint32_t>();
+            segments.outputs[i] = reinterpret_cast<int32_t *>(static_cast<uint8_t *>(output->data()) + offsets[i]);
+            segments.ends[i] = element_count;
+
+            results.push_back(DevMemInfo{static_cast<std::size_t>(inputs[i].size()), TypeId::INT32, output,
+                                         offsets[i]});
+        }
+
+        segments.count = inputs.size();
+
+        if (element_count > 0) {
+            constexpr int block_size = 256;
+            auto grid_size = static_cast<unsigned int>((element_count + block_size - 1) / block_size);
+
+            MatxUtil__narrow_to_int32_kernel<<<grid_size, block_size, 0, output->stream().value()>>>(segments);
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        neo::enqueue_stream_sync_event(output->stream()).get();
+
+        return results;
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::pack_columns(const std::vector<cudf::column_view> &columns) {
+        return MatxUtil::pack_columns(columns, {}, {});
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::pack_columns(const std::vector<cudf::column_view> &columns,
+                                                               const std::vector<float> &shift,
+                                                               const std::vector<float> &scale) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::pack_columns");
+
+        const std::size_t cols = columns.size();
+        const std::size_t rows = cols > 0 ? columns[0].size() : 0;
+
+        auto descriptors = MatxUtil__pack_column_descriptors(columns, shift, scale);
+
+        auto output = std::make_shared<rmm::device_buffer>(rows * cols * sizeof(float), rmm::cuda_stream_per_thread);
+
+        if (rows * cols > 0 && cols <= MatxUtil__MaxPackColumnsByValue) {
+            MatxUtil__PackColumnArray by_value{};
+            std::copy(descriptors.begin(), descriptors.end(), by_value.columns);
+
+            constexpr int block_size = 256;
+            auto grid_size = static_cast<unsigned int>((rows * cols + block_size - 1) / block_size);
+
+            MatxUtil__pack_columns_by_value_kernel<<<grid_size, block_size, 0, output->stream().value()>>>(
+                    by_value, static_cast<float *>(output->data()), rows, cols);
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        } else if (rows * cols > 0) {
+            rmm::device_buffer device_descriptors(descriptors.size() * sizeof(MatxUtil__PackColumn),
+                                                  output->stream());
+
+            NEO_CHECK_CUDA(cudaMemcpyAsync(device_descriptors.data(),
+                                           descriptors.data(),
+                                           device_descriptors.size(),
+                                           cudaMemcpyHostToDevice,
+                                           output->stream().value()));
+
+            constexpr int block_size = 256;
+            auto grid_size = static_cast<unsigned int>((rows * cols + block_size - 1) / block_size);
+
+            MatxUtil__pack_columns_kernel<<<grid_size, block_size, 0, output->stream().value()>>>(
+                    static_cast<const MatxUtil__PackColumn *>(device_descriptors.data()),
+                    static_cast<float *>(output->data()),
+                    rows,
+                    cols);
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+
+            // `descriptors` and `device_descriptors` must outlive the kernel
+            neo::enqueue_stream_sync_event(output->stream()).get();
+        }
+
+        return output;
+    }
+
+    std::vector<uint8_t> MatxUtil::pack_features_args(const std::vector<cudf::column_view> &columns,
+                                                      const std::vector<float> &shift,
+                                                      const std::vector<float> &scale,
+                                                      float *packed,
+                                                      uint32_t *seg_ids) {
+        auto descriptors = MatxUtil__pack_column_descriptors(columns, shift, scale);
+
+        MatxUtil__PackFeaturesArgs header{packed, seg_ids};
+
+        std::vector<uint8_t> args(sizeof(header) + descriptors.size() * sizeof(MatxUtil__PackColumn));
+
+        std::memcpy(args.data(), &header, sizeof(header));
+        std::memcpy(args.data() + sizeof(header),
+                    descriptors.data(),
+                    descriptors.size() * sizeof(MatxUtil__PackColumn));
+
+        return args;
+    }
+
+    void MatxUtil::pack_features(const void *device_args, std::size_t rows, std::size_t cols,
+                                 rmm::cuda_stream_view stream) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::pack_features", stream);
+
+        const std::size_t thread_count = rows * cols + rows;
+
+        if (thread_count == 0) {
+            return;
+        }
+
+        constexpr int block_size = 256;
+        auto grid_size = static_cast<unsigned int>((thread_count + block_size - 1) / block_size);
+
+        MatxUtil__pack_features_kernel<<<grid_size, block_size, 0, stream.value()>>>(
+                static_cast<const uint8_t *>(device_args), rows, cols);
+
+        NEO_CHECK_CUDA(cudaGetLastError());
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::gather_rows(const TensorObject &input,
+                                                              const int32_t *row_indices,
+                                                              std::size_t rows,
+                                                              std::size_t cols) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::gather_rows");
+
+        CHECK(input.rank() == 2 && cols <= static_cast<std::size_t>(input.shape(1)))
+                << "gather_rows requires a 2D tensor with at least `cols` columns";
+
+        const auto item_size = input.dtype().item_size();
+
+        auto output = std::make_shared<rmm::device_buffer>(rows * cols * item_size, rmm::cuda_stream_per_thread);
+
+        if (rows * cols > 0) {
+            constexpr int block_size = 256;
+            auto grid_size = static_cast<unsigned int>((rows * cols + block_size - 1) / block_size);
+
+            MatxUtil__copy_rows_kernel<<<grid_size, block_size, 0, output->stream().value()>>>(
+                    static_cast<const uint8_t *>(input.data()),
+                    static_cast<uint8_t *>(output->data()),
+                    row_indices,
+                    rows,
+                    cols,
+                    item_size,
+                    input.stride(0),
+                    input.stride(1),
+                    false);
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        return output;
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::scatter_rows(const TensorObject &input, const int32_t *row_indices) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::scatter_rows");
+
+        CHECK(input.rank() == 2) << "scatter_rows requires a 2D tensor";
+
+        const std::size_t rows = input.shape(0);
+        const std::size_t cols = input.shape(1);
+        const auto item_size = input.dtype().item_size();
+
+        auto output = std::make_shared<rmm::device_buffer>(rows * cols * item_size, rmm::cuda_stream_per_thread);
+
+        if (rows * cols > 0) {
+            constexpr int block_size = 256;
+            auto grid_size = static_cast<unsigned int>((rows * cols + block_size - 1) / block_size);
+
+            MatxUtil__copy_rows_kernel<<<grid_size, block_size, 0, output->stream().value()>>>(
+                    static_cast<const uint8_t *>(input.data()),
+                    static_cast<uint8_t *>(output->data()),
+                    row_indices,
+                    rows,
+                    cols,
+                    item_size,
+                    input.stride(0),
+                    input.stride(1),
+                    true);
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        return output;
+    }
+
+    void MatxUtil::scatter_rows_into(const TensorObject &input, const int32_t *row_indices, void *output) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::scatter_rows_into");
+
+        CHECK(input.rank() == 2) << "scatter_rows_into requires a 2D tensor";
+
+        const std::size_t rows = input.shape(0);
+        const std::size_t cols = input.shape(1);
+
+        if (rows * cols > 0) {
+            constexpr int block_size = 256;
+            auto grid_size = static_cast<unsigned int>((rows * cols + block_size - 1) / block_size);
+
+            MatxUtil__copy_rows_kernel<<<grid_size, block_size, 0, rmm::cuda_stream_per_thread.value()>>>(
+                    static_cast<const uint8_t *>(input.data()),
+                    static_cast<uint8_t *>(output),
+                    row_indices,
+                    rows,
+                    cols,
+                    input.dtype().item_size(),
+                    input.stride(0),
+                    input.stride(1),
+                    true);
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+    }
+
+    void MatxUtil::hash_rows(const TensorObject &input, uint64_t *hashes, bool combine) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::hash_rows");
+
+        CHECK(input.rank() == 2) << "hash_rows requires a 2D tensor";
+
+        const std::size_t rows = input.shape(0);
+
+        if (rows > 0) {
+            constexpr int block_size = 256;
+            auto grid_size = static_cast<unsigned int>((rows + block_size - 1) / block_size);
+
+            MatxUtil__hash_rows_kernel<<<grid_size, block_size, 0, rmm::cuda_stream_per_thread.value()>>>(
+                    static_cast<const uint8_t *>(input.data()),
+                    hashes,
+                    rows,
+                    input.shape(1),
+                    input.dtype().item_size(),
+                    input.stride(0),
+                    input.stride(1),
+                    combine);
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+    }
+
+    std::vector<int32_t> MatxUtil::row_lengths(const TensorObject &input) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::row_lengths");
+
+        CHECK(input.rank() == 2) << "row_lengths requires a 2D tensor";
+
+        const std::size_t rows = input.shape(0);
+
+        std::vector<int32_t> lengths(rows);
+
+        if (rows == 0) {
+            return lengths;
+        }
+
+        rmm::device_buffer output(rows * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+        constexpr int block_size = 256;
+        auto grid_size = static_cast<unsigned int>((rows + block_size - 1) / block_size);
+
+        MatxUtil__row_lengths_kernel<<<grid_size, block_size, 0, output.stream().value()>>>(
+                static_cast<const uint8_t *>(input.data()),
+                static_cast<int32_t *>(output.data()),
+                rows,
+                input.shape(1),
+                input.dtype().item_size(),
+                input.stride(0),
+                input.stride(1));
+
+        NEO_CHECK_CUDA(cudaGetLastError());
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(lengths.data(),
+                                       output.data(),
+                                       output.size(),
+                                       cudaMemcpyDeviceToHost,
+                                       output.stream().value()));
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(output.stream().value()));
+
+        return lengths;
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::reduce_rows(const TensorObject &input, RowReduction reduction) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::reduce_rows");
+
+        auto at = MatxUtil__strided_2d(input, "reduce_rows");
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+        const auto cols = static_cast<std::size_t>(input.shape(1));
+
+        auto output = std::make_shared<rmm::device_buffer>(rows * input.dtype_size(), rmm::cuda_stream_per_thread);
+
+        if (rows > 0 && cols > 0) {
+            MatxUtil__dispatch_floating(input.dtype().type_id(), [&](auto tag) {
+                using T = typename decltype(tag)::type;
+
+                MatxUtil__reduce_rows_kernel<T><<<MatxUtil__grid_size(rows), MatxUtil__BlockSize, 0,
+                                                  output->stream().value()>>>(
+                        static_cast<const T *>(input.data()), static_cast<T *>(output->data()), rows, cols, at,
+                        reduction);
+            });
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        return output;
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::softmax(const TensorObject &input) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::softmax");
+
+        auto at = MatxUtil__strided_2d(input, "softmax");
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+        const auto cols = static_cast<std::size_t>(input.shape(1));
+
+        auto output = std::make_shared<rmm::device_buffer>(input.bytes(), rmm::cuda_stream_per_thread);
+
+        if (rows > 0 && cols > 0) {
+            MatxUtil__dispatch_floating(input.dtype().type_id(), [&](auto tag) {
+                using T = typename decltype(tag)::type;
+
+                MatxUtil__softmax_kernel<T><<<MatxUtil__grid_size(rows), MatxUtil__BlockSize, 0,
+                                              output->stream().value()>>>(
+                        static_cast<const T *>(input.data()), static_cast<T *>(output->data()), rows, cols, at);
+            });
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        return output;
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::argmax(const TensorObject &input) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::argmax");
+
+        auto results = MatxUtil::top_k(input, 1);
+
+        // With k == 1 the indices are already one per row, drop the values
+        auto output = std::make_shared<rmm::device_buffer>(results[1].element_count * sizeof(int32_t),
+                                                           rmm::cuda_stream_per_thread);
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(output->data(),
+                                       results[1].data(),
+                                       output->size(),
+                                       cudaMemcpyDeviceToDevice,
+                                       output->stream().value()));
+
+        return output;
+    }
+
+    std::vector<DevMemInfo> MatxUtil::top_k(const TensorObject &input, std::size_t k) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::top_k");
+
+        auto at = MatxUtil__strided_2d(input, "top_k");
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+        const auto cols = static_cast<std::size_t>(input.shape(1));
+
+        if (k == 0 || k > MatxUtil__MaxTopK || k > cols) {
+            throw std::invalid_argument("top_k requires 0 < k <= min(32, columns)");
+        }
+
+        // Values then indices, sharing one allocation
+        const std::size_t indices_offset = (rows * k * input.dtype_size() + MatxUtil__OutputAlignment - 1) /
+                                           MatxUtil__OutputAlignment * MatxUtil__OutputAlignment;
+
+        auto output = std::make_shared<rmm::device_buffer>(indices_offset + rows * k * sizeof(int32_t),
+                                                           rmm::cuda_stream_per_thread);
+
+        auto *indices = reinterpret_cast<int32_t *>(static_cast<uint8_t *>(output->data()) + indices_offset);
+
+        if (rows > 0) {
+            MatxUtil__dispatch_floating(input.dtype().type_id(), [&](auto tag) {
+                using T = typename decltype(tag)::type;
+
+                MatxUtil__top_k_kernel<T><<<MatxUtil__grid_size(rows), MatxUtil__BlockSize, 0,
+                                            output->stream().value()>>>(
+                        static_cast<const T *>(input.data()), static_cast<T *>(output->data()), indices, rows, cols, k,
+                        at);
+            });
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        return {DevMemInfo{rows * k, input.dtype().type_id(), output, 0},
+                DevMemInfo{rows * k, TypeId::INT32, output, indices_offset}};
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::reduce_by_seq_ids(const TensorObject &input,
+                                                                    const TensorObject &seq_ids,
+                                                                    std::size_t num_messages,
+                                                                    RowReduction reduction,
+                                                                    std::size_t first_message) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::reduce_by_seq_ids");
+
+        auto at = MatxUtil__strided_2d(input, "reduce_by_seq_ids");
+        MatxUtil__strided_2d(seq_ids, "reduce_by_seq_ids");
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+        const auto cols = static_cast<std::size_t>(input.shape(1));
+
+        const auto seq_type = seq_ids.dtype().type_id();
+        if ((seq_type != TypeId::INT32 && seq_type != TypeId::UINT32) ||
+            static_cast<std::size_t>(seq_ids.shape(0)) != rows) {
+            throw std::invalid_argument("reduce_by_seq_ids requires 32 bit integer seq_ids with one row per input row");
+        }
+
+        auto output = std::make_shared<rmm::device_buffer>(num_messages * cols * input.dtype_size(),
+                                                           rmm::cuda_stream_per_thread);
+
+        if (num_messages * cols > 0) {
+            MatxUtil__dispatch_floating(input.dtype().type_id(), [&](auto tag) {
+                using T = typename decltype(tag)::type;
+
+                // Message ids are small and non-negative, UINT32 can be read as INT32
+                MatxUtil__reduce_by_seq_ids_kernel<T><<<MatxUtil__grid_size(num_messages * cols),
+                                                        MatxUtil__BlockSize, 0, output->stream().value()>>>(
+                        static_cast<const T *>(input.data()), static_cast<const int32_t *>(seq_ids.data()),
+                        static_cast<T *>(output->data()), rows, cols, num_messages, at,
+                        static_cast<TensorIndex>(seq_ids.stride(0)), reduction, first_message);
+            });
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        return output;
+    }
+
+    void MatxUtil::scatter_columns(const TensorObject &input,
+                                   const std::vector<std::size_t> &input_columns,
+                                   const std::vector<void *> &outputs,
+                                   TypeId output_type,
+                                   rmm::cuda_stream_view stream) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::scatter_columns", stream);
+
+        auto at = MatxUtil__strided_2d(input, "scatter_columns");
+
+        if (input_columns.size() != outputs.size()) {
+            throw std::invalid_argument("scatter_columns requires one output per input column");
+        }
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+        const auto input_type = input.dtype().type_id();
+
+        for (auto input_column: input_columns) {
+            if (input_column >= static_cast<std::size_t>(input.shape(1))) {
+                throw std::out_of_range("scatter_columns input column " + std::to_string(input_column) +
+                                        " out of range");
+            }
+        }
+
+        if (rows == 0) {
+            return;
+        }
+
+        dispatch_type<MatxUtil__AllTypes>(input_type, [&](auto tag) {
+            using T = typename decltype(tag)::type;
+
+            auto launch = [&](auto output_tag) {
+                using OutputT = typename decltype(output_tag)::type;
+
+                for (std::size_t first = 0; first < outputs.size(); first += MatxUtil__MaxScatterColumns) {
+                    MatxUtil__ScatterColumns columns{};
+                    columns.count = std::min(MatxUtil__MaxScatterColumns, outputs.size() - first);
+
+                    for (std::size_t i = 0; i < columns.count; ++i) {
+                        columns.outputs[i] = outputs[first + i];
+                        columns.input_columns[i] = static_cast<TensorIndex>(input_columns[first + i]);
+                    }
+
+                    MatxUtil__scatter_columns_kernel<T, OutputT>
+                            <<<MatxUtil__grid_size(rows * columns.count), MatxUtil__BlockSize, 0, stream.value()>>>(
+                                    static_cast<const T *>(input.data()), columns, rows, at);
+
+                    NEO_CHECK_CUDA(cudaGetLastError());
+                }
+            };
+
+            if (output_type == input_type) {
+                launch(TypeTag<T>{});
+                return;
+            }
+
+            if constexpr (type_list_contains_v<MatxUtil__HalfTypes, T>) {
+                if (output_type == TypeId::FLOAT32) {
+                    launch(TypeTag<float>{});
+                    return;
+                }
+            }
+
+            throw std::invalid_argument("scatter_columns only widens half types to FLOAT32");
+        });
+    }
+
+    std::shared_ptr<rmm::device_buffer>
+    MatxUtil::apply_elementwise(const TensorObject &input, const std::vector<ElementwiseOp> &ops) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::apply_elementwise");
+
+        auto at = MatxUtil__strided_2d(input, "apply_elementwise");
+
+        if (ops.size() > MatxUtil__MaxElementwiseOps) {
+            throw std::invalid_argument("apply_elementwise supports at most 8 ops");
+        }
+
+        MatxUtil__ElementwiseProgram program{};
+        std::copy(ops.begin(), ops.end(), program.ops);
+        program.count = ops.size();
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+        const auto cols = static_cast<std::size_t>(input.shape(1));
+
+        auto output = std::make_shared<rmm::device_buffer>(input.bytes(), rmm::cuda_stream_per_thread);
+
+        if (rows * cols > 0) {
+            MatxUtil__dispatch_floating(input.dtype().type_id(), [&](auto tag) {
+                using T = typename decltype(tag)::type;
+
+                MatxUtil__elementwise_kernel<T><<<MatxUtil__grid_size(rows * cols), MatxUtil__BlockSize, 0,
+                                                  output->stream().value()>>>(
+                        static_cast<const T *>(input.data()), static_cast<T *>(output->data()), rows, cols, at,
+                        program);
+            });
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        return output;
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::predict_forest(const TensorObject &input,
+                                                                 const ForestNode *nodes,
+                                                                 const int32_t *tree_roots,
+                                                                 const int32_t *tree_outputs,
+                                                                 std::size_t num_trees,
+                                                                 std::size_t num_outputs,
+                                                                 float base_margin,
+                                                                 bool sigmoid) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::predict_forest");
+
+        auto at = MatxUtil__strided_2d(input, "predict_forest");
+
+        const auto rows = static_cast<std::size_t>(input.shape(0));
+
+        auto output =
+                std::make_shared<rmm::device_buffer>(rows * num_outputs * sizeof(float), rmm::cuda_stream_per_thread);
+
+        if (rows > 0 && num_outputs > 0) {
+            MatxUtil__dispatch_floating(input.dtype().type_id(), [&](auto tag) {
+                using T = typename decltype(tag)::type;
+
+                MatxUtil__predict_forest_kernel<T><<<MatxUtil__grid_size(rows), MatxUtil__BlockSize, 0,
+                                                     output->stream().value()>>>(
+                        static_cast<const T *>(input.data()), static_cast<float *>(output->data()), rows, at, nodes,
+                        tree_roots, tree_outputs, num_trees, num_outputs, base_margin, sigmoid);
+            });
+
+            NEO_CHECK_CUDA(cudaGetLastError());
+        }
+
+        return output;
+    }
+
+    TimeBinRange MatxUtil::time_bins(const int64_t *ticks,
+                                     std::size_t rows,
+                                     int64_t ticks_per_second,
+                                     int64_t t0_sec,
+                                     int64_t resolution_sec,
+                                     int32_t *row_bins) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::time_bins");
+
+        if (rows == 0) {
+            throw std::invalid_argument("time_bins requires at least one row");
+        }
+
+        auto stream = rmm::cuda_stream_per_thread;
+
+        int32_t host_min_max[2] = {std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min()};
+        rmm::device_buffer min_max(sizeof(host_min_max), stream);
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(min_max.data(), host_min_max, sizeof(host_min_max), cudaMemcpyHostToDevice,
+                                       stream.value()));
+
+        MatxUtil__time_bins_kernel<<<MatxUtil__grid_size(rows), MatxUtil__BlockSize, 0, stream.value()>>>(
+                ticks, rows, ticks_per_second, t0_sec, resolution_sec, row_bins,
+                static_cast<int32_t *>(min_max.data()));
+
+        NEO_CHECK_CUDA(cudaGetLastError());
+
+        TimeBinRange range{};
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(host_min_max, min_max.data(), sizeof(host_min_max), cudaMemcpyDeviceToHost,
+                                       stream.value()));
+        NEO_CHECK_CUDA(cudaMemcpyAsync(&range.first, row_bins, sizeof(int32_t), cudaMemcpyDeviceToHost,
+                                       stream.value()));
+        NEO_CHECK_CUDA(cudaMemcpyAsync(&range.last, row_bins + rows - 1, sizeof(int32_t), cudaMemcpyDeviceToHost,
+                                       stream.value()));
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(stream.value()));
+
+        range.min = host_min_max[0];
+        range.max = host_min_max[1];
+
+        return range;
+    }
+
+    void MatxUtil::add_to_histogram(
+            const int32_t *row_bins, std::size_t rows, int32_t lo, int32_t hi, int32_t *counts, std::size_t capacity) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::add_to_histogram");
+
+        if (rows == 0) {
+            return;
+        }
+
+        MatxUtil__add_to_histogram_kernel<<<MatxUtil__grid_size(rows), MatxUtil__BlockSize, 0,
+                                            rmm::cuda_stream_per_thread.value()>>>(
+                row_bins, rows, lo, hi, counts, capacity);
+
+        NEO_CHECK_CUDA(cudaGetLastError());
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::window_signals(const std::vector<TimeSeriesWindow> &windows,
+                                                                 std::size_t length) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::window_signals");
+
+        auto output = std::make_shared<rmm::device_buffer>(windows.size() * length * sizeof(double),
+                                                           rmm::cuda_stream_per_thread);
+
+        if (windows.empty() || length == 0) {
+            return output;
+        }
+
+        rmm::device_buffer device_windows(windows.size() * sizeof(TimeSeriesWindow), output->stream());
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(device_windows.data(),
+                                       windows.data(),
+                                       device_windows.size(),
+                                       cudaMemcpyHostToDevice,
+                                       output->stream().value()));
+
+        MatxUtil__window_signals_kernel<<<MatxUtil__grid_size(windows.size() * length), MatxUtil__BlockSize, 0,
+                                          output->stream().value()>>>(
+                static_cast<const TimeSeriesWindow *>(device_windows.data()),
+                static_cast<double *>(output->data()),
+                windows.size(),
+                length);
+
+        NEO_CHECK_CUDA(cudaGetLastError());
+
+        // `windows` must outlive the copy
+        neo::enqueue_stream_sync_event(output->stream()).get();
+
+        return output;
+    }
+
+    std::shared_ptr<rmm::device_buffer> MatxUtil::fft_anomalies(const double *signals,
+                                                                std::size_t num_signals,
+                                                                std::size_t length,
+                                                                double filter_percent,
+                                                                double zscore_threshold) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::fft_anomalies");
+
+        auto stream = rmm::cuda_stream_per_thread;
+
+        auto output = std::make_shared<rmm::device_buffer>(num_signals * length * sizeof(bool), stream);
+
+        if (num_signals == 0 || length == 0) {
+            return output;
+        }
+
+        if (length < 2) {
+            // A single value is never an outlier
+            NEO_CHECK_CUDA(cudaMemsetAsync(output->data(), 0, output->size(), stream.value()));
+            return output;
+        }
+
+        const std::size_t num_freqs = length / 2 + 1;
+        const std::size_t spectrum_size = num_signals * num_freqs;
+
+        rmm::device_buffer spectrum(spectrum_size * sizeof(cufftDoubleComplex), stream);
+        rmm::device_buffer periodogram(spectrum_size * sizeof(double), stream);
+        rmm::device_buffer sorted(spectrum_size * sizeof(double), stream);
+        rmm::device_buffer recon(num_signals * length * sizeof(double), stream);
+
+        // A single plan transforms every signal. Out of place real to complex transforms leave the input untouched
+        MatxUtil__CufftPlan forward(CUFFT_D2Z, length, num_signals, stream);
+        MatxUtil__check_cufft(cufftExecD2Z(forward.handle(),
+                                           const_cast<cufftDoubleReal *>(signals),
+                                           static_cast<cufftDoubleComplex *>(spectrum.data())));
+
+        MatxUtil__periodogram_kernel<<<num_signals, MatxUtil__BlockSize, 0, stream.value()>>>(
+                signals,
+                static_cast<const cufftDoubleComplex *>(spectrum.data()),
+                static_cast<double *>(periodogram.data()),
+                length,
+                num_freqs);
+
+        NEO_CHECK_CUDA(cudaGetLastError());
+
+        // The percentile of every periodogram comes from a segmented sort, one segment per signal
+        std::vector<int32_t> host_offsets(num_signals + 1);
+        for (std::size_t i = 0; i <= num_signals; ++i) {
+            host_offsets[i] = static_cast<int32_t>(i * num_freqs);
+        }
+
+        rmm::device_buffer offsets(host_offsets.size() * sizeof(int32_t), stream);
+        NEO_CHECK_CUDA(cudaMemcpyAsync(offsets.data(),
+                                       host_offsets.data(),
+                                       offsets.size(),
+                                       cudaMemcpyHostToDevice,
+                                       stream.value()));
+
+        const auto *begin_offsets = static_cast<const int32_t *>(offsets.data());
+        std::size_t temp_bytes = 0;
+
+        NEO_CHECK_CUDA(cub::DeviceSegmentedRadixSort::SortKeys(nullptr,
+                                                               temp_bytes,
+                                                               static_cast<const double *>(periodogram.data()),
+                                                               static_cast<double *>(sorted.data()),
+                                                               static_cast<int>(spectrum_size),
+                                                               static_cast<int>(num_signals),
+                                                               begin_offsets,
+                                                               begin_offsets + 1,
+                                                               0,
+                                                               sizeof(double) * 8,
+                                                               stream.value()));
+
+        rmm::device_buffer temp(temp_bytes, stream);
+
+        NEO_CHECK_CUDA(cub::DeviceSegmentedRadixSort::SortKeys(temp.data(),
+                                                               temp_bytes,
+                                                               static_cast<const double *>(periodogram.data()),
+                                                               static_cast<double *>(sorted.data()),
+                                                               static_cast<int>(spectrum_size),
+                                                               static_cast<int>(num_signals),
+                                                               begin_offsets,
+                                                               begin_offsets + 1,
+                                                               0,
+                                                               sizeof(double) * 8,
+                                                               stream.value()));
+
+        MatxUtil__filter_spectrum_kernel<<<MatxUtil__grid_size(spectrum_size), MatxUtil__BlockSize, 0,
+                                           stream.value()>>>(
+                static_cast<const double *>(periodogram.data()),
+                static_cast<const double *>(sorted.data()),
+                static_cast<cufftDoubleComplex *>(spectrum.data()),
+                num_signals,
+                num_freqs,
+                filter_percent);
+
+        NEO_CHECK_CUDA(cudaGetLastError());
+
+        // Overwrites `spectrum`, which is no longer needed
+        MatxUtil__CufftPlan inverse(CUFFT_Z2D, length, num_signals, stream);
+        MatxUtil__check_cufft(cufftExecZ2D(inverse.handle(),
+                                           static_cast<cufftDoubleComplex *>(spectrum.data()),
+                                           static_cast<cufftDoubleReal *>(recon.data())));
+
+        MatxUtil__flag_outliers_kernel<<<num_signals, MatxUtil__BlockSize, 0, stream.value()>>>(
+                signals,
+                static_cast<const double *>(recon.data()),
+                static_cast<bool *>(output->data()),
+                length,
+                zscore_threshold);
+
+        NEO_CHECK_CUDA(cudaGetLastError());
+
+        // `host_offsets` must outlive the copy, and the plans are destroyed on return
+        neo::enqueue_stream_sync_event(stream).get();
+
+        return output;
+    }
+
+    void MatxUtil::flag_rows(const int32_t *row_bins,
+                             std::size_t rows,
+                             const bool *bin_flags,
+                             int32_t first_bin,
+                             std::size_t num_bins,
+                             bool *row_flags) {
+        MORPHEUS_DEVICE_RANGE("MatxUtil::flag_rows");
+
+        if (rows == 0) {
+            return;
+        }
+
+        MatxUtil__flag_rows_kernel<<<MatxUtil__grid_size(rows), MatxUtil__BlockSize, 0,
+                                     rmm::cuda_stream_per_thread.value()>>>(
+                row_bins, rows, bin_flags, first_bin, num_bins, row_flags);
+
+        NEO_CHECK_CUDA(cudaGetLastError());
     }
 }
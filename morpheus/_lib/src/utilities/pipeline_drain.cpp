@@ -0,0 +1,113 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <morpheus/utilities/pipeline_drain.hpp>
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace morpheus {
+// Component-private classes.
+// ************ PipelineDrain__Registry ************ //
+    struct PipelineDrain__Registry {
+        std::atomic<bool> requested{false};
+
+        std::mutex mutex;
+        PipelineDrain::clock_t::time_point deadline{PipelineDrain::clock_t::time_point::max()};
+        std::map<std::string, std::shared_ptr<DrainProgress>> stages;
+    };
+
+    static PipelineDrain__Registry &PipelineDrain__registry() {
+        static PipelineDrain__Registry registry;
+        return registry;
+    }
+
+// Component public implementations
+// ************ PipelineDrain ************************ //
+    void PipelineDrain::request(std::chrono::milliseconds timeout) {
+        auto &registry = PipelineDrain__registry();
+
+        {
+            std::lock_guard<std::mutex> lock(registry.mutex);
+
+            registry.deadline = std::min(registry.deadline, clock_t::now() + timeout);
+        }
+
+        // Set after the deadline, so a source seeing the request also sees its deadline
+        registry.requested = true;
+
+        LOG(INFO) << "Draining the pipeline, in-flight work is abandoned after " << timeout.count() << " ms";
+    }
+
+    bool PipelineDrain::requested() {
+        return PipelineDrain__registry().requested.load();
+    }
+
+    bool PipelineDrain::expired() {
+        return PipelineDrain::requested() && clock_t::now() >= PipelineDrain::deadline();
+    }
+
+    PipelineDrain::clock_t::time_point PipelineDrain::deadline() {
+        auto &registry = PipelineDrain__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        return registry.deadline;
+    }
+
+    void PipelineDrain::reset() {
+        auto &registry = PipelineDrain__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        registry.requested = false;
+        registry.deadline  = clock_t::time_point::max();
+        registry.stages.clear();
+    }
+
+    std::shared_ptr<DrainProgress> PipelineDrain::track(const std::string &name) {
+        auto &registry = PipelineDrain__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto &progress = registry.stages[name];
+
+        if (!progress) {
+            progress = std::make_shared<DrainProgress>();
+        }
+
+        return progress;
+    }
+
+    std::map<std::string, DrainStatus> PipelineDrain::progress() {
+        auto &registry = PipelineDrain__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        std::map<std::string, DrainStatus> result;
+
+        for (const auto &[name, progress]: registry.stages) {
+            result.emplace(name, progress->status());
+        }
+
+        return result;
+    }
+}  // namespace morpheus
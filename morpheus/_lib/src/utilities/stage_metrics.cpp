@@ -0,0 +1,288 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/utilities/stage_metrics.hpp>
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/utilities/device_memory.hpp>
+
+#include <nvtx3/nvToolsExt.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace morpheus {
+// Component-private classes.
+// ************ StageMetrics__Registry ************ //
+    struct StageMetrics__Registry {
+        std::mutex mutex;
+        std::map<std::string, std::shared_ptr<StageMetrics>> stages;
+    };
+
+    static StageMetrics__Registry &StageMetrics__registry() {
+        static StageMetrics__Registry registry;
+        return registry;
+    }
+
+    static void StageMetrics__write_counter(std::ostringstream &out,
+                                            const char *metric,
+                                            const char *help,
+                                            const std::map<std::string, StageMetricsSnapshot> &snapshots,
+                                            uint64_t StageMetricsSnapshot::*field) {
+        out << "# HELP " << metric << " " << help << "\n";
+        out << "# TYPE " << metric << " counter\n";
+
+        for (const auto &[name, snapshot]: snapshots) {
+            out << metric << "{stage=\"" << name << "\"} " << snapshot.*field << "\n";
+        }
+    }
+
+// Component public implementations
+// ************ StageMetrics ************************ //
+    StageMetrics::StageMetrics(std::string name) : m_name(std::move(name)) {}
+
+    std::shared_ptr<StageMetrics> StageMetrics::get(const std::string &name) {
+        auto &registry = StageMetrics__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto &metrics = registry.stages[name];
+
+        if (!metrics) {
+            metrics = std::make_shared<StageMetrics>(name);
+        }
+
+        return metrics;
+    }
+
+    std::map<std::string, StageMetricsSnapshot> StageMetrics::snapshot_all() {
+        auto &registry = StageMetrics__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        std::map<std::string, StageMetricsSnapshot> snapshots;
+
+        for (const auto &[name, metrics]: registry.stages) {
+            snapshots.emplace(name, metrics->snapshot());
+        }
+
+        return snapshots;
+    }
+
+    std::string StageMetrics::prometheus_text() {
+        const auto snapshots = StageMetrics::snapshot_all();
+
+        std::ostringstream out;
+
+        StageMetrics__write_counter(out,
+                                    "morpheus_stage_messages_in_total",
+                                    "Messages received by the stage",
+                                    snapshots,
+                                    &StageMetricsSnapshot::messages_in);
+        StageMetrics__write_counter(out,
+                                    "morpheus_stage_rows_in_total",
+                                    "Rows received by the stage",
+                                    snapshots,
+                                    &StageMetricsSnapshot::rows_in);
+        StageMetrics__write_counter(out,
+                                    "morpheus_stage_messages_out_total",
+                                    "Messages emitted by the stage",
+                                    snapshots,
+                                    &StageMetricsSnapshot::messages_out);
+        StageMetrics__write_counter(out,
+                                    "morpheus_stage_rows_out_total",
+                                    "Rows emitted by the stage",
+                                    snapshots,
+                                    &StageMetricsSnapshot::rows_out);
+
+        // Times are exported in seconds, the Prometheus base unit
+        out << "# HELP morpheus_stage_blocked_seconds_total Time spent waiting on the downstream stage\n";
+        out << "# TYPE morpheus_stage_blocked_seconds_total counter\n";
+
+        for (const auto &[name, snapshot]: snapshots) {
+            out << "morpheus_stage_blocked_seconds_total{stage=\"" << name << "\"} " << snapshot.blocked_ns * 1e-9
+                << "\n";
+        }
+
+        out << "# HELP morpheus_stage_processing_seconds Time spent in on_next, excluding time blocked downstream\n";
+        out << "# TYPE morpheus_stage_processing_seconds histogram\n";
+
+        for (const auto &[name, snapshot]: snapshots) {
+            uint64_t cumulative = 0;
+
+            for (std::size_t i = 0; i < LatencyBucketsUs.size(); ++i) {
+                cumulative += snapshot.latency_buckets[i];
+                out << "morpheus_stage_processing_seconds_bucket{stage=\"" << name << "\",le=\""
+                    << LatencyBucketsUs[i] * 1e-6 << "\"} " << cumulative << "\n";
+            }
+
+            cumulative += snapshot.latency_buckets.back();
+            out << "morpheus_stage_processing_seconds_bucket{stage=\"" << name << "\",le=\"+Inf\"} " << cumulative
+                << "\n";
+            out << "morpheus_stage_processing_seconds_sum{stage=\"" << name << "\"} " << snapshot.processing_ns * 1e-9
+                << "\n";
+            out << "morpheus_stage_processing_seconds_count{stage=\"" << name << "\"} " << cumulative << "\n";
+        }
+
+        out << "# HELP morpheus_stage_source_latency_seconds Time from the source timestamp of traced messages to the "
+               "end of the stage\n";
+        out << "# TYPE morpheus_stage_source_latency_seconds histogram\n";
+
+        for (const auto &[name, snapshot]: snapshots) {
+            uint64_t cumulative = 0;
+
+            for (std::size_t i = 0; i < SourceLatencyBucketsMs.size(); ++i) {
+                cumulative += snapshot.source_latency_buckets[i];
+                out << "morpheus_stage_source_latency_seconds_bucket{stage=\"" << name << "\",le=\""
+                    << SourceLatencyBucketsMs[i] * 1e-3 << "\"} " << cumulative << "\n";
+            }
+
+            cumulative += snapshot.source_latency_buckets.back();
+            out << "morpheus_stage_source_latency_seconds_bucket{stage=\"" << name << "\",le=\"+Inf\"} "
+                << cumulative << "\n";
+            out << "morpheus_stage_source_latency_seconds_sum{stage=\"" << name << "\"} "
+                << snapshot.source_latency_ns * 1e-9 << "\n";
+            out << "morpheus_stage_source_latency_seconds_count{stage=\"" << name << "\"} " << cumulative << "\n";
+        }
+
+        // Allocations are tagged by stage type rather than stage name
+        const auto memory_stats = DeviceMemory::stats();
+
+        out << "# HELP morpheus_device_memory_allocated_bytes_total Device memory allocated by each stage type\n";
+        out << "# TYPE morpheus_device_memory_allocated_bytes_total counter\n";
+
+        for (const auto &[tag, stats]: memory_stats) {
+            out << "morpheus_device_memory_allocated_bytes_total{tag=\"" << tag << "\"} " << stats.total_bytes << "\n";
+        }
+
+        out << "# HELP morpheus_device_memory_in_use_bytes Device memory currently held by each stage type\n";
+        out << "# TYPE morpheus_device_memory_in_use_bytes gauge\n";
+
+        for (const auto &[tag, stats]: memory_stats) {
+            out << "morpheus_device_memory_in_use_bytes{tag=\"" << tag << "\"} " << stats.current_bytes << "\n";
+        }
+
+        out << "# HELP morpheus_message_meta_live_bytes Device memory of the C++ tables held by live messages\n";
+        out << "# TYPE morpheus_message_meta_live_bytes gauge\n";
+        out << "morpheus_message_meta_live_bytes " << MessageMeta::live_device_bytes() << "\n";
+
+        out << "# HELP morpheus_message_meta_live_tables C++ tables held by live messages\n";
+        out << "# TYPE morpheus_message_meta_live_tables gauge\n";
+        out << "morpheus_message_meta_live_tables " << MessageMeta::live_tables() << "\n";
+
+        return out.str();
+    }
+
+    StageMetricsSnapshot StageMetrics::snapshot() const {
+        StageMetricsSnapshot snapshot;
+
+        snapshot.messages_in = m_messages_in.load(std::memory_order_relaxed);
+        snapshot.rows_in = m_rows_in.load(std::memory_order_relaxed);
+        snapshot.messages_out = m_messages_out.load(std::memory_order_relaxed);
+        snapshot.rows_out = m_rows_out.load(std::memory_order_relaxed);
+        snapshot.processing_ns = m_processing_ns.load(std::memory_order_relaxed);
+        snapshot.blocked_ns = m_blocked_ns.load(std::memory_order_relaxed);
+
+        snapshot.latency_buckets.reserve(m_latency_buckets.size());
+
+        for (const auto &bucket: m_latency_buckets) {
+            snapshot.latency_buckets.push_back(bucket.load(std::memory_order_relaxed));
+        }
+
+        snapshot.source_latency_ns = m_source_latency_ns.load(std::memory_order_relaxed);
+        snapshot.source_latency_buckets.reserve(m_source_latency_buckets.size());
+
+        for (const auto &bucket: m_source_latency_buckets) {
+            snapshot.source_latency_buckets.push_back(bucket.load(std::memory_order_relaxed));
+        }
+
+        return snapshot;
+    }
+
+    void StageMetrics::record_in(std::size_t rows) {
+        m_messages_in.fetch_add(1, std::memory_order_relaxed);
+        m_rows_in.fetch_add(rows, std::memory_order_relaxed);
+    }
+
+    void StageMetrics::record_out(std::size_t rows, uint64_t blocked_ns) {
+        m_messages_out.fetch_add(1, std::memory_order_relaxed);
+        m_rows_out.fetch_add(rows, std::memory_order_relaxed);
+        m_blocked_ns.fetch_add(blocked_ns, std::memory_order_relaxed);
+    }
+
+    void StageMetrics::record_processing(uint64_t processing_ns) {
+        m_processing_ns.fetch_add(processing_ns, std::memory_order_relaxed);
+
+        const auto processing_us = processing_ns / 1000;
+
+        std::size_t bucket = 0;
+        while (bucket < LatencyBucketsUs.size() && processing_us > LatencyBucketsUs[bucket]) {
+            ++bucket;
+        }
+
+        m_latency_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void StageMetrics::record_source_latency(uint64_t latency_ns) {
+        m_source_latency_ns.fetch_add(latency_ns, std::memory_order_relaxed);
+
+        const auto latency_ms = latency_ns / 1000000;
+
+        std::size_t bucket = 0;
+        while (bucket < SourceLatencyBucketsMs.size() && latency_ms > SourceLatencyBucketsMs[bucket]) {
+            ++bucket;
+        }
+
+        m_source_latency_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t StageMetrics::elapsed_ns(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    uint64_t StageMetrics::range_start(const std::string &name) {
+        return nvtxRangeStartA(name.c_str());
+    }
+
+    void StageMetrics::range_end(uint64_t range) {
+        nvtxRangeEnd(range);
+    }
+
+// ************ StageMetrics::Scope ************************ //
+    StageMetrics::Scope::~Scope() {
+        StageMetrics::range_end(m_range);
+
+        const auto total_ns = StageMetrics::elapsed_ns(m_start);
+
+        m_metrics.record_processing(total_ns > m_blocked_ns ? total_ns - m_blocked_ns : 0);
+
+        if (m_trace) {
+            const auto exit_ns = MessageTrace::now_ns();
+
+            m_trace->record(m_metrics.name(), m_enter_ns, exit_ns);
+
+            // Source clocks can be ahead of ours
+            const auto source_ns = m_trace->source_time_ns();
+            m_metrics.record_source_latency(exit_ns > source_ns ? exit_ns - source_ns : 0);
+        }
+    }
+}  // namespace morpheus
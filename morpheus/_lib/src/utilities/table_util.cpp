@@ -17,13 +17,26 @@
 
 #include <morpheus/utilities/table_util.hpp>
 
+#include <morpheus/utilities/json_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
+
+#include <cudf/column/column_factories.hpp>
 #include <cudf/io/csv.hpp>
 #include <cudf/io/json.hpp>
+#include <cudf/null_mask.hpp>
+#include <cudf/stream_compaction.hpp>
+#include <cudf/utilities/traits.hpp>
 
+#include <cuda_runtime.h>
 #include <glog/logging.h>
+#include <neo/cuda/common.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <memory>
+#include <regex>
+#include <stdexcept>
+#include <string>
 
 namespace fs = std::filesystem;
 namespace py = pybind11;
@@ -35,7 +48,7 @@ cudf::io::table_with_metadata morpheus::CuDFTableUtil::load_table(const std::str
         // First, load the file into json
         auto options = cudf::io::json_reader_options::builder(cudf::io::source_info{filename}).lines(true);
 
-        return cudf::io::read_json(options.build());
+        return load_json_table(options.build());
     } else if (file_path.extension() == ".csv") {
         auto options = cudf::io::csv_reader_options::builder(cudf::io::source_info{filename});
 
@@ -44,4 +57,102 @@ cudf::io::table_with_metadata morpheus::CuDFTableUtil::load_table(const std::str
         LOG(FATAL) << "Unknown extension for file: " << filename;
         throw std::runtime_error("Unknown extension");
     }
-}
\ No newline at end of file
+}
+
+cudf::io::table_with_metadata morpheus::CuDFTableUtil::load_json_table(cudf::io::json_reader_options &&json_options) {
+    auto tbl = cudf::io::read_json(json_options);
+
+    auto found = std::find(tbl.metadata.column_names.begin(), tbl.metadata.column_names.end(), "data");
+
+    if (found == tbl.metadata.column_names.end())
+        return tbl;
+
+    // cudf doesnt decode escape sequences in json strings (i.e. \n, \/, \uXXXX). Decode them on the device
+    auto columns = tbl.tbl->release();
+
+    size_t idx = found - tbl.metadata.column_names.begin();
+
+    columns[idx] = JsonUtil::unescape_strings(columns[idx]->view());
+
+    tbl.tbl = std::make_unique<cudf::table>(std::move(columns));
+
+    return tbl;
+}
+
+int morpheus::CuDFTableUtil::get_index_col_count(cudf::io::table_with_metadata &data_table) {
+    // Check if we have a first column with INT64 data type
+    if (data_table.metadata.column_names.size() >= 1 &&
+        data_table.tbl->get_column(0).type().id() == cudf::type_id::INT64) {
+        std::regex index_regex(R"((unnamed: 0|id))", std::regex_constants::ECMAScript | std::regex_constants::icase);
+
+        // Get the column name
+        auto col_name = data_table.metadata.column_names[0];
+
+        // Check it against some common terms
+        if (std::regex_search(col_name, index_regex)) {
+            // Also, if its the hideous 'Unnamed: 0', then just use an empty string
+            if (col_name == "Unnamed: 0") {
+                data_table.metadata.column_names[0] = "";
+            }
+
+            return 1;
+        }
+    }
+
+    // Using 0 will default to creating a new range index
+    return 0;
+}
+
+std::unique_ptr<cudf::column> morpheus::CuDFTableUtil::make_zeroed_column(TypeId type_id, cudf::size_type num_rows) {
+    auto column = cudf::make_numeric_column(cudf::data_type(DType(type_id).cudf_type_id()), num_rows);
+
+    auto view = column->mutable_view();
+    NEO_CHECK_CUDA(cudaMemset(view.head(), 0, num_rows * cudf::size_of(view.type())));
+
+    return column;
+}
+
+void morpheus::CuDFTableUtil::drop_nulls(cudf::io::table_with_metadata &data_table, const std::string &column_name) {
+    auto &names = data_table.metadata.column_names;
+    auto found  = std::find(names.begin(), names.end(), column_name);
+
+    if (found == names.end()) {
+        throw std::invalid_argument("Cannot drop nulls, the table has no column named '" + column_name + "'");
+    }
+
+    const auto column_idx = static_cast<cudf::size_type>(found - names.begin());
+
+    if (data_table.tbl->get_column(column_idx).null_count() == 0) {
+        return;
+    }
+
+    data_table.tbl = cudf::drop_nulls(data_table.tbl->view(), std::vector<cudf::size_type>{column_idx});
+}
+
+std::size_t morpheus::CuDFTableUtil::device_bytes(const cudf::column_view &column) {
+    std::size_t bytes = 0;
+
+    if (cudf::is_fixed_width(column.type())) {
+        bytes += static_cast<std::size_t>(column.size()) * cudf::size_of(column.type());
+    }
+
+    if (column.nullable()) {
+        bytes += cudf::bitmask_allocation_size_bytes(column.size());
+    }
+
+    for (cudf::size_type i = 0; i < column.num_children(); ++i) {
+        bytes += device_bytes(column.child(i));
+    }
+
+    return bytes;
+}
+
+std::size_t morpheus::CuDFTableUtil::device_bytes(const cudf::table_view &table) {
+    std::size_t bytes = 0;
+
+    for (const auto &column: table) {
+        bytes += device_bytes(column);
+    }
+
+    return bytes;
+}
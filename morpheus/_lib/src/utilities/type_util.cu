@@ -17,45 +17,60 @@
 
 #include <morpheus/utilities/type_util.hpp>
 
+#include <morpheus/utilities/type_dispatch.hpp>
+
+#include <cudf/utilities/type_dispatcher.hpp>
+
 #include <stdexcept>
 #include <string>
 
 namespace morpheus {
 
+// Component-private free functions.
+template <typename... Ts>
+static TypeId DType__from_cudf(TypeList<Ts...>, cudf::type_id tid)
+{
+    TypeId result = TypeId::EMPTY;
+
+    ((tid == cudf::type_to_id<Ts>() ? (result = TypeIdOf<Ts>::value, true) : false) || ...);
+
+    return result;
+}
+
 DType::DType(const DataType& dtype) : DataType(dtype.type_id()) {}
 DType::DType(TypeId tid) : DataType(tid) {}
 
 // Cudf representation
 cudf::type_id DType::cudf_type_id() const
+{
+    if (m_type_id == TypeId::FLOAT16 || m_type_id == TypeId::BFLOAT16)
+    {
+        throw std::runtime_error("Half types have no cudf representation, use column_dtype() for DataFrame columns");
+    }
+
+    if (!type_list_contains_id(CudfTypes{}, m_type_id))
+    {
+        throw std::runtime_error("Not supported");
+    }
+
+    cudf::type_id result = cudf::type_id::EMPTY;
+
+    dispatch_type<CudfTypes>(m_type_id, [&result](auto tag) {
+        result = cudf::type_to_id<typename decltype(tag)::type>();
+    });
+
+    return result;
+}
+
+DType DType::column_dtype() const
 {
     switch (m_type_id)
     {
-    case TypeId::INT8:
-        return cudf::type_id::INT8;
-    case TypeId::INT16:
-        return cudf::type_id::INT16;
-    case TypeId::INT32:
-        return cudf::type_id::INT32;
-    case TypeId::INT64:
-        return cudf::type_id::INT64;
-    case TypeId::UINT8:
-        return cudf::type_id::UINT8;
-    case TypeId::UINT16:
-        return cudf::type_id::UINT16;
-    case TypeId::UINT32:
-        return cudf::type_id::UINT32;
-    case TypeId::UINT64:
-        return cudf::type_id::UINT64;
-    case TypeId::FLOAT32:
-        return cudf::type_id::FLOAT32;
-    case TypeId::FLOAT64:
-        return cudf::type_id::FLOAT64;
-    case TypeId::BOOL8:
-        return cudf::type_id::BOOL8;
-    case TypeId::EMPTY:
-    case TypeId::NUM_TYPE_IDS:
+    case TypeId::FLOAT16:
+    case TypeId::BFLOAT16:
+        return DType(TypeId::FLOAT32);
     default:
-        throw std::runtime_error("Not supported");
+        return *this;
     }
 }
 
@@ -87,6 +102,10 @@ std::string DType::triton_str() const
         return "FP64";
     case TypeId::BOOL8:
         return "BOOL";
+    case TypeId::FLOAT16:
+        return "FP16";
+    case TypeId::BFLOAT16:
+        return "BF16";
     case TypeId::EMPTY:
     case TypeId::NUM_TYPE_IDS:
     default:
@@ -97,35 +116,14 @@ std::string DType::triton_str() const
 // From cudf
 DType DType::from_cudf(cudf::type_id tid)
 {
-    switch (tid)
+    auto type_id = DType__from_cudf(CudfTypes{}, tid);
+
+    if (type_id == TypeId::EMPTY)
     {
-    case cudf::type_id::INT8:
-        return DType(TypeId::INT8);
-    case cudf::type_id::INT16:
-        return DType(TypeId::INT16);
-    case cudf::type_id::INT32:
-        return DType(TypeId::INT32);
-    case cudf::type_id::INT64:
-        return DType(TypeId::INT64);
-    case cudf::type_id::UINT8:
-        return DType(TypeId::UINT8);
-    case cudf::type_id::UINT16:
-        return DType(TypeId::UINT16);
-    case cudf::type_id::UINT32:
-        return DType(TypeId::UINT32);
-    case cudf::type_id::UINT64:
-        return DType(TypeId::UINT64);
-    case cudf::type_id::FLOAT32:
-        return DType(TypeId::FLOAT32);
-    case cudf::type_id::FLOAT64:
-        return DType(TypeId::FLOAT64);
-    case cudf::type_id::BOOL8:
-        return DType(TypeId::BOOL8);
-    case cudf::type_id::EMPTY:
-    case cudf::type_id::NUM_TYPE_IDS:
-    default:
         throw std::runtime_error("Not supported");
     }
+
+    return DType(type_id);
 }
 
 // From triton
@@ -175,6 +173,14 @@ DType DType::from_triton(const std::string& type_str)
     {
         return DType(TypeId::BOOL8);
     }
+    else if (type_str == "FP16")
+    {
+        return DType(TypeId::FLOAT16);
+    }
+    else if (type_str == "BF16")
+    {
+        return DType(TypeId::BFLOAT16);
+    }
     else
     {
         throw std::runtime_error("Not supported");
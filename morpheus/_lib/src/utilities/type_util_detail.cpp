@@ -34,6 +34,7 @@ std::map<char, std::map<size_t, TypeId>> make_str_to_type_id()
     std::map<char, std::map<size_t, TypeId>> map;
 
     map['?'][1] = TypeId::BOOL8;
+    map['b'][1] = TypeId::BOOL8;  // numpy `dtype.str` gives the kind, '|b1'
 
     map['i'][1] = TypeId::INT8;
     map['i'][2] = TypeId::INT16;
@@ -45,6 +46,7 @@ std::map<char, std::map<size_t, TypeId>> make_str_to_type_id()
     map['u'][4] = TypeId::UINT32;
     map['u'][8] = TypeId::UINT64;
 
+    map['f'][2] = TypeId::FLOAT16;
     map['f'][4] = TypeId::FLOAT32;
     map['f'][8] = TypeId::FLOAT64;
 
@@ -70,6 +72,8 @@ size_t DataType::item_size() const
         return 1;
     case TypeId::INT16:
     case TypeId::UINT16:
+    case TypeId::FLOAT16:
+    case TypeId::BFLOAT16:
         return 2;
     case TypeId::INT32:
     case TypeId::UINT32:
@@ -109,8 +113,8 @@ DataType DataType::from_numpy(const std::string& numpy_str)
     char type_char    = numpy_str[0];
     size_t size_start = 1;
 
-    // Can start with < or > or none
-    if (numpy_str[0] == '<' || numpy_str[0] == '>')
+    // Can start with < or >, | for types without a byte order, or none
+    if (numpy_str[0] == '<' || numpy_str[0] == '>' || numpy_str[0] == '|')
     {
         type_char  = numpy_str[1];
         size_start = 2;
@@ -146,9 +150,12 @@ char DataType::type_char() const
         return 'u';
     case TypeId::BOOL8:
         return '?';
+    case TypeId::FLOAT16:
     case TypeId::FLOAT32:
     case TypeId::FLOAT64:
         return 'f';
+    case TypeId::BFLOAT16:
+        throw std::invalid_argument("BFLOAT16 has no numpy representation, cast to FLOAT32 first");
     case TypeId::NUM_TYPE_IDS:
     case TypeId::EMPTY:
     default:
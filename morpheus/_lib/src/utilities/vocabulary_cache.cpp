@@ -0,0 +1,96 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <morpheus/utilities/vocabulary_cache.hpp>
+
+#include <cudf/column/column.hpp>
+#include <cudf/utilities/traits.hpp>
+#include <nvtext/subword_tokenize.hpp>
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace morpheus {
+// Component-private classes.
+// ************ VocabularyCache__Registry ************ //
+    struct VocabularyCache__Registry {
+        std::mutex mutex;
+        std::map<std::string, std::weak_ptr<const nvtext::hashed_vocabulary>> vocabs;
+    };
+
+    static VocabularyCache__Registry &VocabularyCache__registry() {
+        static VocabularyCache__Registry registry;
+        return registry;
+    }
+
+    static std::size_t VocabularyCache__column_bytes(const std::unique_ptr<cudf::column> &column) {
+        if (!column) {
+            return 0;
+        }
+
+        return column->size() * cudf::size_of(column->type());
+    }
+
+// Component public implementations
+// ************ VocabularyCache ************************ //
+    std::shared_ptr<const nvtext::hashed_vocabulary> VocabularyCache::get(const std::string &vocab_hash_file) {
+        auto &registry = VocabularyCache__registry();
+
+        // Held while loading so concurrent callers wait for the first load rather than loading their own copy
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        auto &entry = registry.vocabs[vocab_hash_file];
+
+        auto vocab = entry.lock();
+
+        if (!vocab) {
+            vocab = nvtext::load_vocabulary_file(vocab_hash_file);
+            entry = vocab;
+
+            LOG(INFO) << "Loaded vocabulary '" << vocab_hash_file << "' using " << device_bytes(*vocab)
+                      << " bytes of device memory";
+        }
+
+        return vocab;
+    }
+
+    std::size_t VocabularyCache::device_bytes(const nvtext::hashed_vocabulary &vocab) {
+        return VocabularyCache__column_bytes(vocab.table) + VocabularyCache__column_bytes(vocab.bin_coefficients) +
+               VocabularyCache__column_bytes(vocab.bin_offsets) + VocabularyCache__column_bytes(vocab.cp_metadata) +
+               VocabularyCache__column_bytes(vocab.aux_cp_table);
+    }
+
+    std::size_t VocabularyCache::total_device_bytes() {
+        auto &registry = VocabularyCache__registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        std::size_t total = 0;
+
+        for (const auto &[path, entry]: registry.vocabs) {
+            if (auto vocab = entry.lock()) {
+                total += device_bytes(*vocab);
+            }
+        }
+
+        return total;
+    }
+}  // namespace morpheus
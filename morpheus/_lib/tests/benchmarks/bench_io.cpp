@@ -0,0 +1,157 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./bench_morpheus.hpp"
+
+#include <morpheus/io/serializers.hpp>
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/utilities/table_util.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cudf/concatenate.hpp>
+#include <cudf/io/types.hpp>
+#include <cudf/table/table_view.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+void BM_LoadTableJson(benchmark::State& state)
+{
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto path = bench::jsonlines_file(rows);
+
+    for (auto _ : state)
+    {
+        auto table = CuDFTableUtil::load_table(path);
+        benchmark::DoNotOptimize(table.tbl);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_LoadTableJson)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond);
+
+void BM_LoadTableCsv(benchmark::State& state)
+{
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto path = bench::csv_file(rows);
+
+    for (auto _ : state)
+    {
+        auto table = CuDFTableUtil::load_table(path);
+        benchmark::DoNotOptimize(table.tbl);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_LoadTableCsv)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond);
+
+/**
+ * Merging `count` messages of `rows` rows into a single C++ backed message, the same work `CoalesceStage` does.
+ */
+void BM_ConcatMessageBatch(benchmark::State& state)
+{
+    const auto rows  = static_cast<std::size_t>(state.range(0));
+    const auto count = static_cast<std::size_t>(state.range(1));
+
+    std::vector<std::shared_ptr<MessageMeta>> metas;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        metas.push_back(bench::make_meta(rows));
+    }
+
+    for (auto _ : state)
+    {
+        std::vector<TableInfo> infos;
+        std::vector<cudf::table_view> views;
+        for (const auto& meta : metas)
+        {
+            infos.push_back(meta->get_info());
+            views.push_back(infos.back().get_view());
+        }
+
+        auto column_names = infos.front().get_index_names();
+        auto data_columns = infos.front().get_column_names();
+        column_names.insert(column_names.end(), data_columns.begin(), data_columns.end());
+
+        cudf::io::table_with_metadata table{cudf::concatenate(views), cudf::io::table_metadata{}};
+        table.metadata.column_names = std::move(column_names);
+
+        auto merged = MessageMeta::create_from_cpp(std::move(table), infos.front().num_indices());
+        benchmark::DoNotOptimize(merged);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows * count);
+}
+BENCHMARK(BM_ConcatMessageBatch)
+    ->ArgsProduct({{64, 256, 1024}, {4, 16, 64}})
+    ->ArgNames({"rows", "messages"})
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_DfToCsv(benchmark::State& state)
+{
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    auto meta       = bench::make_meta(rows);
+    auto info       = meta->get_info();
+
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        std::ostringstream out;
+        df_to_csv(info, out, true);
+        bytes += static_cast<std::size_t>(out.tellp());
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_DfToCsv)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond);
+
+void BM_DfToJson(benchmark::State& state)
+{
+    if (!bench::python_available())
+    {
+        state.SkipWithError("df_to_json goes through Python and the cudf helpers could not be loaded");
+        return;
+    }
+
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    auto meta       = bench::make_meta(rows);
+    auto info       = meta->get_info();
+
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        auto json = df_to_json(info);
+        bytes += json.size();
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_DfToJson)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMillisecond);
+}  // namespace
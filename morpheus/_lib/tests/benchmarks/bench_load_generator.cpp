@@ -0,0 +1,76 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./bench_morpheus.hpp"
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/load_generator.hpp>
+#include <morpheus/utilities/table_util.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+// Rows of the template, batches larger than it wrap around
+constexpr std::size_t TemplateRows = 1 << 12;
+
+LoadGenerator make_generator(std::vector<std::string> mutate_columns)
+{
+    auto table           = CuDFTableUtil::load_table(bench::jsonlines_file(TemplateRows));
+    auto index_col_count = CuDFTableUtil::get_index_col_count(table);
+
+    LoadGeneratorOptions options;
+    options.mutate_columns = std::move(mutate_columns);
+
+    return LoadGenerator(std::move(table), index_col_count, std::move(options));
+}
+
+/**
+ * Generating one batch of `rows` rows and wrapping it in a message, the work `LoadGeneratorSourceStage` does for each
+ * batch. Bounds the rate the source can sustain, with and without making the `data` column unique.
+ */
+void BM_LoadGeneratorBatch(benchmark::State& state)
+{
+    const auto rows   = static_cast<std::size_t>(state.range(0));
+    const bool mutate = state.range(1) != 0;
+
+    auto generator = make_generator(mutate ? std::vector<std::string>{"data"} : std::vector<std::string>{});
+
+    for (auto _ : state)
+    {
+        auto table = generator.make_batch(rows);
+        auto meta  = MessageMeta::create_from_cpp(std::move(table), 1);
+        benchmark::DoNotOptimize(meta);
+    }
+
+    bench::sync_stream();
+
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_LoadGeneratorBatch)
+    ->ArgsProduct({{1 << 8, 1 << 12, 1 << 16}, {0, 1}})
+    ->ArgNames({"rows", "mutate"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+}  // namespace
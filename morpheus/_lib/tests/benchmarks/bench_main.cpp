@@ -0,0 +1,62 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./bench_morpheus.hpp"
+
+#include <morpheus/utilities/cudf_util.hpp>
+
+#include <benchmark/benchmark.h>
+#include <glog/logging.h>
+#include <pybind11/embed.h>
+#include <pybind11/gil.h>
+
+#include <exception>
+
+int main(int argc, char** argv)
+{
+    FLAGS_alsologtostderr = true;  // Log to console
+    ::google::InitGoogleLogging("morpheus::bench_libmorpheus");
+
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    // Only `df_to_json` and moving tables into Python need the interpreter, everything else runs without it
+    pybind11::scoped_interpreter interpreter;
+
+    try
+    {
+        morpheus::load_cudf_helpers();
+        morpheus::bench::set_python_available(true);
+    } catch (const std::exception& e)
+    {
+        LOG(WARNING) << "cudf helpers are not importable, skipping benchmarks which need Python: " << e.what();
+    }
+
+    {
+        // Stages run without holding the GIL, measure them the same way
+        pybind11::gil_scoped_release nogil;
+
+        ::benchmark::RunSpecifiedBenchmarks();
+    }
+
+    ::benchmark::Shutdown();
+
+    return 0;
+}
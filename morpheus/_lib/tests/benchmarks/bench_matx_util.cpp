@@ -0,0 +1,221 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./bench_morpheus.hpp"
+
+#include <morpheus/objects/dev_mem_info.hpp>
+#include <morpheus/objects/table_info.hpp>
+#include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+#include <morpheus/utilities/vocabulary_cache.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cudf/column/column_view.hpp>
+#include <cudf/strings/strings_column_view.hpp>
+#include <nvtext/subword_tokenize.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+/**
+ * Tokenizing the `data` column and narrowing the three uint32 outputs, as done by `PreprocessNLPStage`.
+ */
+void BM_SubwordTokenize(benchmark::State& state)
+{
+    const auto rows            = static_cast<std::size_t>(state.range(0));
+    const auto sequence_length = static_cast<uint32_t>(state.range(1));
+
+    auto vocab = VocabularyCache::get(bench::vocab_hash_file());
+    auto meta  = bench::make_meta(rows);
+    auto info  = meta->get_info();
+
+    // The first column is the range index
+    auto string_col = cudf::strings_column_view{info.get_column(1)};
+
+    for (auto _ : state)
+    {
+        auto token_results = nvtext::subword_tokenize(
+            string_col, *vocab, sequence_length, sequence_length, true, false, string_col.size() * 2);
+
+        auto narrowed = MatxUtil::narrow_to_int32({token_results.tensor_token_ids->view(),
+                                                   token_results.tensor_attention_mask->view(),
+                                                   token_results.tensor_metadata->view()});
+        benchmark::DoNotOptimize(narrowed);
+
+        bench::sync_stream();
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_SubwordTokenize)
+    ->ArgsProduct({{256, 4096}, {128, 256}})
+    ->ArgNames({"rows", "seq_len"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+void BM_CastInt64ToInt32(benchmark::State& state)
+{
+    const auto rows  = static_cast<std::size_t>(state.range(0));
+    const auto count = rows * 256;
+
+    const DevMemInfo input{count, TypeId::INT64, bench::make_device_buffer(count, TypeId::INT64), 0};
+
+    for (auto _ : state)
+    {
+        auto output = MatxUtil::cast(input, TypeId::INT32);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(state.iterations() * count * sizeof(int64_t));
+}
+BENCHMARK(BM_CastInt64ToInt32)->RangeMultiplier(8)->Range(256, 1 << 14)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+/**
+ * Per dtype timings of the type dispatched primitives, the place to compare kernels when adding or tuning a dtype.
+ */
+void BM_CastToFloat32PerDtype(benchmark::State& state)
+{
+    const auto count      = static_cast<std::size_t>(state.range(0));
+    const auto input_type = static_cast<TypeId>(state.range(1));
+
+    const DevMemInfo input{count, input_type, bench::make_device_buffer(count, input_type), 0};
+
+    for (auto _ : state)
+    {
+        auto output = MatxUtil::cast(input, TypeId::FLOAT32);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetLabel(DataType(input_type).name());
+    state.SetBytesProcessed(state.iterations() * count * DataType(input_type).item_size());
+}
+BENCHMARK(BM_CastToFloat32PerDtype)
+    ->ArgsProduct({{1 << 16, 1 << 22},
+                   {static_cast<int64_t>(TypeId::INT8),
+                    static_cast<int64_t>(TypeId::INT64),
+                    static_cast<int64_t>(TypeId::FLOAT16),
+                    static_cast<int64_t>(TypeId::FLOAT64)}})
+    ->ArgNames({"count", "dtype"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+void BM_LogitsPerDtype(benchmark::State& state)
+{
+    const auto count   = static_cast<std::size_t>(state.range(0));
+    const auto type_id = static_cast<TypeId>(state.range(1));
+
+    const DevMemInfo input{count, type_id, bench::make_device_buffer(count, type_id), 0};
+
+    for (auto _ : state)
+    {
+        auto output = MatxUtil::logits(input);
+        benchmark::DoNotOptimize(output);
+
+        bench::sync_stream();
+    }
+
+    state.SetLabel(DataType(type_id).name());
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_LogitsPerDtype)
+    ->ArgsProduct({{1 << 16, 1 << 22},
+                   {static_cast<int64_t>(TypeId::FLOAT16),
+                    static_cast<int64_t>(TypeId::BFLOAT16),
+                    static_cast<int64_t>(TypeId::FLOAT32),
+                    static_cast<int64_t>(TypeId::FLOAT64)}})
+    ->ArgNames({"count", "dtype"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+/**
+ * Packing the feature columns of a FIL message into a row major float tensor, as done by `PreprocessFILStage`.
+ */
+void BM_PackColumns(benchmark::State& state)
+{
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    auto meta       = bench::make_meta(rows);
+    auto info       = meta->get_info();
+
+    std::vector<cudf::column_view> columns;
+    for (cudf::size_type i = 0; i < static_cast<cudf::size_type>(bench::NumValueColumns); ++i)
+    {
+        // Skip the range index and the `data` column
+        columns.push_back(info.get_column(i + 2));
+    }
+
+    for (auto _ : state)
+    {
+        auto output = MatxUtil::pack_columns(columns);
+        benchmark::DoNotOptimize(output);
+
+        bench::sync_stream();
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_PackColumns)->RangeMultiplier(8)->Range(1 << 10, 1 << 16)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+void BM_Transpose(benchmark::State& state)
+{
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto cols = static_cast<std::size_t>(state.range(1));
+
+    const DevMemInfo input{rows * cols, TypeId::FLOAT32, bench::make_device_buffer(rows * cols), 0};
+
+    for (auto _ : state)
+    {
+        auto output = MatxUtil::transpose(input, rows, cols);
+        benchmark::DoNotOptimize(output);
+
+        bench::sync_stream();
+    }
+
+    state.SetBytesProcessed(state.iterations() * rows * cols * sizeof(float));
+}
+BENCHMARK(BM_Transpose)
+    ->ArgsProduct({{1 << 10, 1 << 14}, {4, 29}})
+    ->ArgNames({"rows", "cols"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+void BM_Threshold(benchmark::State& state)
+{
+    const auto rows   = static_cast<std::size_t>(state.range(0));
+    const auto cols   = static_cast<std::size_t>(state.range(1));
+    const bool by_row = state.range(2) != 0;
+    auto tensor       = bench::make_tensor(rows, cols);
+
+    for (auto _ : state)
+    {
+        auto output = MatxUtil::threshold(tensor, 0.5, by_row);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_Threshold)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 17}, {1, 10}, {0, 1}})
+    ->ArgNames({"rows", "cols", "by_row"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+}  // namespace
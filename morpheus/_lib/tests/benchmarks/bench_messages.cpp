@@ -0,0 +1,96 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./bench_morpheus.hpp"
+
+#include <morpheus/messages/multi.hpp>
+#include <morpheus/objects/tensor_object.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+/**
+ * Writing the columns of a probabilities tensor into the message, as done by `AddScoresStage`. The columns are
+ * inserted on the first iteration, later iterations only measure the copies.
+ */
+void BM_SetMetaFromTensor(benchmark::State& state)
+{
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto cols = static_cast<std::size_t>(state.range(1));
+
+    auto message = std::make_shared<MultiMessage>(bench::make_meta(rows), 0, rows);
+    auto probs   = bench::make_tensor(rows, cols);
+
+    std::vector<std::string> column_names;
+    std::vector<std::size_t> tensor_columns;
+    for (std::size_t i = 0; i < cols; ++i)
+    {
+        column_names.push_back("label_" + std::to_string(i));
+        tensor_columns.push_back(i);
+    }
+
+    for (auto _ : state)
+    {
+        message->set_meta(column_names, probs, tensor_columns);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows * cols);
+}
+BENCHMARK(BM_SetMetaFromTensor)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 17}, {1, 10}})
+    ->ArgNames({"rows", "cols"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+/**
+ * Same columns as `BM_SetMetaFromTensor`, set from one single column tensor each.
+ */
+void BM_SetMetaFromTensors(benchmark::State& state)
+{
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto cols = static_cast<std::size_t>(state.range(1));
+
+    auto message = std::make_shared<MultiMessage>(bench::make_meta(rows), 0, rows);
+
+    std::vector<std::string> column_names;
+    std::vector<TensorObject> tensors;
+    for (std::size_t i = 0; i < cols; ++i)
+    {
+        column_names.push_back("label_" + std::to_string(i));
+        tensors.push_back(bench::make_tensor(rows, 1));
+    }
+
+    for (auto _ : state)
+    {
+        message->set_meta(column_names, tensors);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows * cols);
+}
+BENCHMARK(BM_SetMetaFromTensors)
+    ->ArgsProduct({{1 << 10, 1 << 14, 1 << 17}, {1, 10}})
+    ->ArgNames({"rows", "cols"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+}  // namespace
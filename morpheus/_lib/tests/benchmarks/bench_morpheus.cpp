@@ -0,0 +1,178 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./bench_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/objects/dev_mem_info.hpp>
+#include <morpheus/objects/tensor.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/table_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cuda_runtime.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace morpheus::bench {
+namespace {
+std::atomic<bool> g_python_available{false};
+
+// Deterministic values in [0, 1) so runs are comparable
+float bench_value(std::size_t i)
+{
+    return static_cast<float>((i * 2654435761u) % 1000u) / 1000.0F;
+}
+
+std::string bench_text(std::size_t i)
+{
+    return "GET /api/v1/users/" + std::to_string(i) + "?session=" + std::to_string(i * 7919 % 100000) +
+           " the quick brown fox jumps over the lazy dog";
+}
+
+std::string cached_file(std::size_t rows, const std::string& extension)
+{
+    static std::mutex mutex;
+    static std::map<std::pair<std::size_t, std::string>, std::string> files;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto& path = files[{rows, extension}];
+
+    if (!path.empty())
+    {
+        return path;
+    }
+
+    path = (std::filesystem::temp_directory_path() / ("bench_libmorpheus_" + std::to_string(rows) + extension))
+               .string();
+
+    std::ofstream out(path, std::ios::trunc);
+
+    if (extension == ".csv")
+    {
+        out << "data";
+        for (std::size_t c = 0; c < NumValueColumns; ++c)
+        {
+            out << ",v" << c;
+        }
+        out << "\n";
+    }
+
+    for (std::size_t i = 0; i < rows; ++i)
+    {
+        if (extension == ".csv")
+        {
+            out << bench_text(i);
+            for (std::size_t c = 0; c < NumValueColumns; ++c)
+            {
+                out << "," << bench_value(i * NumValueColumns + c);
+            }
+        }
+        else
+        {
+            out << "{\"data\":\"" << bench_text(i) << "\"";
+            for (std::size_t c = 0; c < NumValueColumns; ++c)
+            {
+                out << ",\"v" << c << "\":" << bench_value(i * NumValueColumns + c);
+            }
+            out << "}";
+        }
+        out << "\n";
+    }
+
+    return path;
+}
+}  // namespace
+
+bool python_available()
+{
+    return g_python_available;
+}
+
+void set_python_available(bool available)
+{
+    g_python_available = available;
+}
+
+std::string jsonlines_file(std::size_t rows)
+{
+    return cached_file(rows, ".jsonlines");
+}
+
+std::string csv_file(std::size_t rows)
+{
+    return cached_file(rows, ".csv");
+}
+
+std::shared_ptr<MessageMeta> make_meta(std::size_t rows)
+{
+    return MessageMeta::create_from_cpp(CuDFTableUtil::load_table(jsonlines_file(rows)), 0);
+}
+
+std::shared_ptr<rmm::device_buffer> make_device_buffer(std::size_t count, TypeId type_id)
+{
+    std::vector<float> values(count);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        values[i] = bench_value(i);
+    }
+
+    auto buffer = std::make_shared<rmm::device_buffer>(
+        values.data(), values.size() * sizeof(float), rmm::cuda_stream_per_thread);
+
+    if (type_id != TypeId::FLOAT32)
+    {
+        buffer = MatxUtil::cast(DevMemInfo{values.size(), TypeId::FLOAT32, buffer, 0}, type_id);
+    }
+
+    // `values` must outlive the copy
+    sync_stream();
+
+    return buffer;
+}
+
+TensorObject make_tensor(std::size_t rows, std::size_t cols, TypeId type_id)
+{
+    return Tensor::create(make_device_buffer(rows * cols, type_id),
+                          DType(type_id),
+                          std::vector<TensorIndex>{static_cast<TensorIndex>(rows), static_cast<TensorIndex>(cols)},
+                          std::vector<TensorIndex>{},
+                          0);
+}
+
+std::string vocab_hash_file()
+{
+    return std::string(MORPHEUS_BENCH_DATA_DIR) + "/bert-base-uncased-hash.txt";
+}
+
+void sync_stream()
+{
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+}
+}  // namespace morpheus::bench
@@ -0,0 +1,74 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <morpheus/messages/meta.hpp>
+#include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace morpheus::bench {
+/**
+ * @brief Number of float columns, `v0` to `v3`, written next to the `data` string column by the table helpers.
+ */
+constexpr std::size_t NumValueColumns = 4;
+
+/**
+ * @brief Set by `main` once an interpreter with the cudf helpers is available. Benchmarks of paths which go through
+ * Python skip themselves otherwise.
+ */
+bool python_available();
+void set_python_available(bool available);
+
+/**
+ * @brief Writes `rows` lines of synthetic messages to a file in the temp directory, returning its path. The file is
+ * only written on the first call for each size.
+ */
+std::string jsonlines_file(std::size_t rows);
+std::string csv_file(std::size_t rows);
+
+/**
+ * @brief C++ backed message with the same `rows` as `jsonlines_file`, read through `CuDFTableUtil::load_table`.
+ */
+std::shared_ptr<MessageMeta> make_meta(std::size_t rows);
+
+/**
+ * @brief Device buffer of `count` elements of `type_id` filled with values in [0, 1).
+ */
+std::shared_ptr<rmm::device_buffer> make_device_buffer(std::size_t count, TypeId type_id = TypeId::FLOAT32);
+
+/**
+ * @brief Compact `rows` x `cols` tensor over a buffer from `make_device_buffer`.
+ */
+TensorObject make_tensor(std::size_t rows, std::size_t cols, TypeId type_id = TypeId::FLOAT32);
+
+/**
+ * @brief Path of the hashed vocabulary used by the NLP pipelines.
+ */
+std::string vocab_hash_file();
+
+/**
+ * @brief Waits for all work queued by the benchmark on the per-thread stream.
+ */
+void sync_stream();
+}  // namespace morpheus::bench
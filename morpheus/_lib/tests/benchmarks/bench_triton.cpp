@@ -0,0 +1,138 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./bench_morpheus.hpp"
+
+#include <morpheus/objects/dev_mem_info.hpp>
+#include <morpheus/objects/tensor_cast_view.hpp>
+#include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/host_memory.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+#include <morpheus/utilities/type_util.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <benchmark/benchmark.h>
+#include <http_client.h>  // for triton::client::InferInput
+#include <cuda_runtime.h>
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace morpheus;
+
+// The requests themselves need a running server. These cover everything the stage does on either side of them
+namespace {
+/**
+ * Staging the three NLP inputs for an HTTP/gRPC request: casting the int64 tensors to the model's int32 while copying
+ * them to pinned host memory, and attaching them to the Triton inputs, as done by `InferenceClientStage`.
+ */
+void BM_TritonMarshalInputs(benchmark::State& state)
+{
+    const auto rows    = static_cast<std::size_t>(state.range(0));
+    const auto seq_len = static_cast<std::size_t>(state.range(1));
+
+    const std::vector<std::string> names{"input_ids", "input_mask", "segment_ids"};
+
+    std::vector<TensorObject> tensors;
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        tensors.push_back(bench::make_tensor(rows, seq_len, TypeId::INT64));
+    }
+
+    const DType model_type(TypeId::INT32);
+
+    for (auto _ : state)
+    {
+        std::vector<std::pair<std::unique_ptr<triton::client::InferInput>, PinnedHostBuffer>> inputs;
+
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            const TensorCastView final_tensor(tensors[i], model_type);
+
+            triton::client::InferInput* inp_ptr;
+            triton::client::InferInput::Create(&inp_ptr,
+                                               names[i],
+                                               {static_cast<int64_t>(rows), static_cast<int64_t>(seq_len)},
+                                               model_type.triton_str());
+
+            auto inp_data = final_tensor.copy_to_host_async(rmm::cuda_stream_per_thread);
+            inp_ptr->AppendRaw(inp_data.data(), inp_data.size());
+
+            inputs.emplace_back(std::unique_ptr<triton::client::InferInput>(inp_ptr), std::move(inp_data));
+        }
+
+        bench::sync_stream();
+
+        benchmark::DoNotOptimize(inputs);
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetBytesProcessed(state.iterations() * names.size() * rows * seq_len * sizeof(int64_t));
+}
+BENCHMARK(BM_TritonMarshalInputs)
+    ->ArgsProduct({{32, 256, 1024}, {128, 256}})
+    ->ArgNames({"rows", "seq_len"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+/**
+ * Copying a model output from the response back to the device and applying the logits, as done by
+ * `InferenceClientStage` for models which need it.
+ */
+void BM_TritonUnmarshalOutputs(benchmark::State& state)
+{
+    const auto rows = static_cast<std::size_t>(state.range(0));
+    const auto cols = static_cast<std::size_t>(state.range(1));
+
+    // Responses are owned by the Triton client, so the source is pageable memory
+    const std::vector<float> response(rows * cols, 0.5F);
+    const auto response_bytes = response.size() * sizeof(float);
+
+    for (auto _ : state)
+    {
+        auto output_buffer = std::make_shared<rmm::device_buffer>(response_bytes, rmm::cuda_stream_per_thread);
+
+        NEO_CHECK_CUDA(cudaMemcpyAsync(output_buffer->data(),
+                                       response.data(),
+                                       response_bytes,
+                                       cudaMemcpyHostToDevice,
+                                       output_buffer->stream().value()));
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(output_buffer->stream().value()));
+
+        auto probs = MatxUtil::logits(DevMemInfo{response.size(), TypeId::FLOAT32, output_buffer, 0});
+        benchmark::DoNotOptimize(probs);
+
+        bench::sync_stream();
+    }
+
+    state.SetItemsProcessed(state.iterations() * rows);
+    state.SetBytesProcessed(state.iterations() * response_bytes);
+}
+BENCHMARK(BM_TritonUnmarshalOutputs)
+    ->ArgsProduct({{32, 256, 1024}, {2, 10}})
+    ->ArgNames({"rows", "cols"})
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+}  // namespace
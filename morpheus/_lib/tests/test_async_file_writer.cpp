@@ -0,0 +1,133 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/io/async_file_writer.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+using namespace morpheus;
+
+TEST_CLASS(AsyncFileWriter);
+
+namespace {
+std::string temp_file_name()
+{
+    return ::testing::TempDir() + "test_async_file_writer_" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+std::string read_file(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+TEST_F(TestAsyncFileWriter, WritesInOrder)
+{
+    auto filename = temp_file_name();
+    std::string expected;
+
+    {
+        AsyncFileWriter writer(filename, false, 2, FileFlushPolicy::None);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            auto line = std::to_string(i) + "\n";
+            expected += line;
+            writer.write(std::move(line));
+        }
+
+        writer.close();
+    }
+
+    EXPECT_EQ(read_file(filename), expected);
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(TestAsyncFileWriter, SpansBlocks)
+{
+    auto filename = temp_file_name();
+
+    // Smaller than the alignment, so the block is rounded up to a single page
+    AsyncFileWriter writer(filename, false, 4, FileFlushPolicy::FSync, 100);
+
+    std::string large(3 * AsyncFileWriter::Alignment + 17, 'a');
+    std::string small(10, 'b');
+
+    writer.write(large);
+    writer.write(small);
+    writer.close();
+
+    EXPECT_EQ(read_file(filename), large + small);
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(TestAsyncFileWriter, Append)
+{
+    auto filename = temp_file_name();
+
+    {
+        AsyncFileWriter writer(filename, false, 2);
+        writer.write("first\n");
+    }
+
+    {
+        AsyncFileWriter writer(filename, true, 2);
+        writer.write("second\n");
+    }
+
+    EXPECT_EQ(read_file(filename), "first\nsecond\n");
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(TestAsyncFileWriter, OpenFailure)
+{
+    EXPECT_THROW(AsyncFileWriter("/this/directory/does/not/exist/file.txt", false, 2), std::runtime_error);
+}
+
+TEST_F(TestAsyncFileWriter, WriteAfterClose)
+{
+    auto filename = temp_file_name();
+
+    AsyncFileWriter writer(filename, false, 2);
+    writer.close();
+
+    EXPECT_THROW(writer.write("late"), std::runtime_error);
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(TestAsyncFileWriter, ParsePolicy)
+{
+    EXPECT_EQ(parse_file_flush_policy("none"), FileFlushPolicy::None);
+    EXPECT_EQ(parse_file_flush_policy("flush"), FileFlushPolicy::Flush);
+    EXPECT_EQ(parse_file_flush_policy("fsync"), FileFlushPolicy::FSync);
+    EXPECT_THROW(parse_file_flush_policy("sometimes"), std::invalid_argument);
+}
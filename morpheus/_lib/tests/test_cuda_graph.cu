@@ -0,0 +1,158 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/utilities/cuda_graph.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+
+#include <cuda_runtime.h>
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+struct FillArgs
+{
+    int32_t *output;
+    int32_t value;
+};
+
+__global__ void fill_from_args_kernel(const FillArgs *args, std::size_t count)
+{
+    std::size_t idx = blockIdx.x * static_cast<std::size_t>(blockDim.x) + threadIdx.x;
+
+    if (idx < count)
+    {
+        args->output[idx] = args->value;
+    }
+}
+
+std::vector<uint8_t> to_bytes(const FillArgs &args)
+{
+    std::vector<uint8_t> bytes(sizeof(args));
+    std::memcpy(bytes.data(), &args, sizeof(args));
+
+    return bytes;
+}
+
+std::vector<int32_t> to_host(const rmm::device_buffer &buffer)
+{
+    std::vector<int32_t> output(buffer.size() / sizeof(int32_t));
+
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+    NEO_CHECK_CUDA(cudaMemcpy(output.data(), buffer.data(), buffer.size(), cudaMemcpyDeviceToHost));
+
+    return output;
+}
+}  // namespace
+
+class TestCudaGraph : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        m_was_enabled = CudaGraphCache::enabled();
+        CudaGraphCache::set_enabled(true);
+    }
+
+    void TearDown() override
+    {
+        CudaGraphCache::set_enabled(m_was_enabled);
+    }
+
+    bool m_was_enabled{false};
+};
+
+TEST_F(TestCudaGraph, CapturesOncePerKey)
+{
+    constexpr std::size_t Count = 1000;
+
+    CudaGraphCache graphs;
+    std::size_t launch_calls = 0;
+
+    auto launches = [&](rmm::cuda_stream_view stream, const void *device_args) {
+        ++launch_calls;
+        auto args = static_cast<const FillArgs *>(device_args);
+        fill_from_args_kernel<<<(Count + 255) / 256, 256, 0, stream.value()>>>(args, Count);
+    };
+
+    // A new output and value every call, as the stages allocate new outputs for every batch
+    std::vector<rmm::device_buffer> outputs;
+
+    for (int32_t i = 0; i < 6; ++i)
+    {
+        outputs.emplace_back(Count * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+        graphs.run({static_cast<int64_t>(Count)},
+                   to_bytes(FillArgs{static_cast<int32_t *>(outputs.back().data()), i}),
+                   launches);
+    }
+
+    // Run eagerly when first seen, captured on the repeat and only relaunched since
+    EXPECT_EQ(launch_calls, 2);
+    EXPECT_EQ(graphs.capture_count(), 1);
+
+    for (int32_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(to_host(outputs[i]), std::vector<int32_t>(Count, i)) << "Call " << i;
+    }
+
+    // Another shape gets its own graph
+    rmm::device_buffer other(Count * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+    for (int32_t i = 0; i < 3; ++i)
+    {
+        graphs.run({1}, to_bytes(FillArgs{static_cast<int32_t *>(other.data()), 7}), launches);
+    }
+
+    EXPECT_EQ(launch_calls, 4);
+    EXPECT_EQ(graphs.capture_count(), 2);
+}
+
+TEST_F(TestCudaGraph, DisabledRunsEagerly)
+{
+    CudaGraphCache::set_enabled(false);
+
+    CudaGraphCache graphs;
+    std::size_t launch_calls = 0;
+
+    rmm::device_buffer output(sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+    for (int32_t i = 0; i < 3; ++i)
+    {
+        graphs.run({1},
+                   to_bytes(FillArgs{static_cast<int32_t *>(output.data()), i}),
+                   [&](rmm::cuda_stream_view stream, const void *device_args) {
+                       ++launch_calls;
+                       fill_from_args_kernel<<<1, 1, 0, stream.value()>>>(static_cast<const FillArgs *>(device_args),
+                                                                          1);
+                   });
+    }
+
+    EXPECT_EQ(launch_calls, 3);
+    EXPECT_EQ(graphs.capture_count(), 0);
+    EXPECT_EQ(to_host(output), std::vector<int32_t>{2});
+}
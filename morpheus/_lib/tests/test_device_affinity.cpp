@@ -0,0 +1,43 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/utilities/device_affinity.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(DeviceAffinity);
+
+TEST_F(TestDeviceAffinity, ParseCpuList)
+{
+    EXPECT_EQ(DeviceAffinity::parse_cpu_list("0-3,8,10-11"), (std::vector<int>{0, 1, 2, 3, 8, 10, 11}));
+    EXPECT_EQ(DeviceAffinity::parse_cpu_list("5"), (std::vector<int>{5}));
+    EXPECT_TRUE(DeviceAffinity::parse_cpu_list("").empty());
+}
+
+TEST_F(TestDeviceAffinity, NegativeDeviceIsIgnored)
+{
+    DeviceAffinity::bind_current_thread(-1);
+
+    EXPECT_EQ(DeviceAffinity::current_numa_node(), -1);
+    EXPECT_TRUE(DeviceAffinity::numa_cpus(-1).empty());
+}
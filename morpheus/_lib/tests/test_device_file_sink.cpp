@@ -0,0 +1,107 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/io/device_file_sink.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+using namespace morpheus;
+
+TEST_CLASS(DeviceFileSink);
+
+namespace {
+std::string temp_file_name()
+{
+    return ::testing::TempDir() + "test_device_file_sink_" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+std::string read_file(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+}  // namespace
+
+TEST_F(TestDeviceFileSink, HostAndDeviceWrites)
+{
+    auto filename = temp_file_name();
+
+    // Spans several bounce blocks, the last one partial
+    std::string device_data(2 * DeviceFileSink::BounceBytes + 17, 'd');
+
+    for (std::size_t i = 0; i < device_data.size(); i += 4099)
+    {
+        device_data[i] = static_cast<char>('a' + (i % 26));
+    }
+
+    rmm::device_buffer buffer(device_data.data(), device_data.size(), rmm::cuda_stream_per_thread);
+
+    {
+        DeviceFileSink sink(filename, false);
+
+        sink.host_write("header\n", 7);
+        sink.device_write(buffer.data(), buffer.size(), rmm::cuda_stream_per_thread);
+
+        EXPECT_EQ(sink.bytes_written(), 7 + device_data.size());
+        EXPECT_EQ(sink.file_size(), 7 + device_data.size());
+    }
+
+    EXPECT_EQ(read_file(filename), "header\n" + device_data);
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(TestDeviceFileSink, Append)
+{
+    auto filename = temp_file_name();
+
+    {
+        DeviceFileSink sink(filename, false);
+        sink.host_write("first\n", 6);
+    }
+
+    {
+        DeviceFileSink sink(filename, true);
+        EXPECT_EQ(sink.file_size(), 6);
+
+        sink.host_write("second\n", 7);
+        EXPECT_EQ(sink.bytes_written(), 7);
+        EXPECT_EQ(sink.file_size(), 13);
+    }
+
+    EXPECT_EQ(read_file(filename), "first\nsecond\n");
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(TestDeviceFileSink, OpenFailure)
+{
+    EXPECT_THROW(DeviceFileSink("/this/directory/does/not/exist/file.txt", false), std::runtime_error);
+}
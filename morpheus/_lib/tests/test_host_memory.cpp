@@ -0,0 +1,71 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/utilities/host_memory.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+
+#include <cstdint>
+#include <utility>
+
+using namespace morpheus;
+
+TEST_CLASS(HostMemory);
+
+TEST_F(TestHostMemory, BuffersAreRecycled)
+{
+    PinnedHostPool::clear();
+
+    uint8_t* first_data = nullptr;
+
+    {
+        auto buffer = PinnedHostPool::acquire(1000);
+
+        ASSERT_NE(buffer.data(), nullptr);
+        EXPECT_EQ(buffer.size(), 1000u);
+
+        first_data = buffer.data();
+    }
+
+    EXPECT_EQ(PinnedHostPool::cached_bytes(), 4096u);
+
+    // Same size class, so the released block is handed out again
+    auto buffer = PinnedHostPool::acquire(3000);
+
+    EXPECT_EQ(buffer.data(), first_data);
+    EXPECT_EQ(buffer.size(), 3000u);
+    EXPECT_EQ(PinnedHostPool::cached_bytes(), 0u);
+
+    // Moving transfers the block without releasing it
+    auto moved = std::move(buffer);
+
+    EXPECT_EQ(buffer.data(), nullptr);
+    EXPECT_EQ(moved.data(), first_data);
+    EXPECT_EQ(PinnedHostPool::cached_bytes(), 0u);
+
+    PinnedHostPool::clear();
+}
+
+TEST_F(TestHostMemory, EmptyBuffer)
+{
+    auto buffer = PinnedHostPool::acquire(0);
+
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(buffer.data(), nullptr);
+}
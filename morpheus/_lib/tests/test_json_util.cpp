@@ -0,0 +1,118 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/utilities/json_util.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_TRUE, EXPECT_FALSE, EXPECT_EQ
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+bool is_valid(const std::string &line)
+{
+    return JsonUtil::is_valid_json_line(line.data(), line.size());
+}
+
+const std::vector<std::string> ValidLines = {
+    "{}\n",
+    "[]\n",
+    " {\"a\": 1} \n",
+    "{\"a\":[1,2.5,-0.1e+3,1E9,true,false,null,\"x\\u00e9\\n\"]}\n",
+    "[{}, [], {\"b\": {\"c\": []}}]\n",
+};
+
+const std::vector<std::string> MalformedLines = {
+    "{\"a\":}\n",
+    "{\"a\" 1}\n",
+    "{,}\n",
+    "{\"a\":tru}\n",
+    "{\"a\":truex}\n",
+    "{\"a\":1,}\n",
+    "[1,]\n",
+    "[,1]\n",
+    "[1 2]\n",
+    "{1:2}\n",
+    "{\"a\"}\n",
+    "{\"a\":1]\n",
+    "[01]\n",
+    "[1.]\n",
+    "[-]\n",
+    "[\"\\x\"]\n",
+    "{\"a\":1}{}\n",
+    "1\n",
+    "\n",
+};
+}  // namespace
+
+TEST_CLASS(JsonUtil);
+
+TEST_F(TestJsonUtil, ValidLines)
+{
+    for (const auto &line : ValidLines)
+    {
+        EXPECT_TRUE(is_valid(line)) << line;
+    }
+}
+
+TEST_F(TestJsonUtil, MalformedLines)
+{
+    for (const auto &line : MalformedLines)
+    {
+        EXPECT_FALSE(is_valid(line)) << line;
+    }
+}
+
+TEST_F(TestJsonUtil, MaxDepth)
+{
+    std::string line = std::string(64, '[') + std::string(64, ']');
+    EXPECT_TRUE(is_valid(line));
+
+    line = "[" + line + "]";
+    EXPECT_FALSE(is_valid(line));
+}
+
+TEST_F(TestJsonUtil, ValidateJsonLines)
+{
+    // Interleave the lines so each malformed line sits between valid ones
+    std::string data;
+    std::vector<std::size_t> line_offsets;
+    std::vector<uint8_t> expected;
+
+    for (std::size_t i = 0; i < MalformedLines.size(); ++i)
+    {
+        const auto &valid_line = ValidLines[i % ValidLines.size()];
+
+        line_offsets.push_back(data.size());
+        data += valid_line;
+        expected.push_back(1);
+
+        line_offsets.push_back(data.size());
+        data += MalformedLines[i];
+        expected.push_back(0);
+    }
+
+    line_offsets.push_back(data.size());
+
+    EXPECT_EQ(JsonUtil::validate_json_lines(data.data(), line_offsets), expected);
+}
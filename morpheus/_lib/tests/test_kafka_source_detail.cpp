@@ -0,0 +1,330 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/stages/kafka_source_detail.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, EXPECT_THROW
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace morpheus;
+
+namespace {
+struct TestPartitionTask
+{
+    std::atomic<bool> running{true};
+    std::atomic<bool> reached_stop{false};
+    std::shared_future<bool> future;
+};
+
+void launch_partition_task(const std::shared_ptr<TestPartitionTask> &task)
+{
+    // Stands in for a partition fiber, runs until stopped
+    task->future = std::async(std::launch::async, [task]() {
+                       while (task->running)
+                       {
+                           std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                       }
+
+                       return true;
+                   }).share();
+}
+
+bool is_finished(const std::shared_ptr<TestPartitionTask> &task)
+{
+    return task->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+}  // namespace
+
+TEST_CLASS(KafkaSourceDetail);
+
+TEST_F(TestKafkaSourceDetail, TopicSubscriptions)
+{
+    EXPECT_TRUE(KafkaTopicUtil::is_regex("^logs-.*"));
+    EXPECT_FALSE(KafkaTopicUtil::is_regex("logs"));
+    EXPECT_FALSE(KafkaTopicUtil::is_regex(""));
+
+    std::vector<std::string> topics{"alerts", "^logs-[0-9]+$"};
+
+    EXPECT_TRUE(KafkaTopicUtil::is_subscribed(topics, "alerts"));
+    EXPECT_TRUE(KafkaTopicUtil::is_subscribed(topics, "logs-42"));
+    EXPECT_FALSE(KafkaTopicUtil::is_subscribed(topics, "logs-x"));
+    EXPECT_FALSE(KafkaTopicUtil::is_subscribed(topics, "alerts-old"));
+    EXPECT_FALSE(KafkaTopicUtil::is_subscribed({}, "alerts"));
+}
+
+TEST_F(TestKafkaSourceDetail, OffsetTrackerCommitsInOrder)
+{
+    KafkaOffsetTracker tracker("topic:0");
+
+    tracker.emitted(0, 10);
+    tracker.emitted(10, 20);
+    tracker.emitted(20, 30);
+    EXPECT_EQ(tracker.in_flight(), 3);
+
+    // Nothing to commit until the oldest batch completes
+    tracker.completed(10, false);
+    EXPECT_EQ(tracker.take_commit_offset(), -1);
+
+    tracker.completed(0, false);
+    EXPECT_EQ(tracker.take_commit_offset(), 20);
+
+    // Only returned once
+    EXPECT_EQ(tracker.take_commit_offset(), -1);
+
+    tracker.completed(20, false);
+    EXPECT_EQ(tracker.take_commit_offset(), 30);
+    EXPECT_EQ(tracker.in_flight(), 0);
+    EXPECT_EQ(tracker.tracked(), 0);
+}
+
+TEST_F(TestKafkaSourceDetail, OffsetTrackerCommitsPastFailedBatches)
+{
+    KafkaOffsetTracker tracker("topic:0");
+
+    tracker.emitted(0, 10);
+    tracker.emitted(10, 20);
+
+    tracker.completed(0, true);
+    EXPECT_EQ(tracker.take_commit_offset(), 10);
+    EXPECT_EQ(tracker.failed_count(), 1);
+
+    // Commits keep moving after the failure
+    tracker.emitted(20, 30);
+    tracker.completed(20, false);
+    EXPECT_EQ(tracker.take_commit_offset(), -1);
+
+    tracker.completed(10, false);
+    EXPECT_EQ(tracker.take_commit_offset(), 30);
+    EXPECT_EQ(tracker.failed_count(), 1);
+    EXPECT_EQ(tracker.tracked(), 0);
+}
+
+TEST_F(TestKafkaSourceDetail, OffsetTrackerReleasesCompletedBatches)
+{
+    KafkaOffsetTracker tracker("topic:0");
+
+    // Every batch completes, alternately failed, so none may be held on to
+    for (int64_t first = 0; first < 1000; first += 10)
+    {
+        tracker.emitted(first, first + 10);
+        tracker.completed(first, (first / 10) % 2 == 0);
+    }
+
+    EXPECT_EQ(tracker.tracked(), 0);
+    EXPECT_EQ(tracker.in_flight(), 0);
+    EXPECT_EQ(tracker.failed_count(), 50);
+    EXPECT_EQ(tracker.take_commit_offset(), 1000);
+}
+
+TEST_F(TestKafkaSourceDetail, TaskQueueLoadsPreferHomeQueue)
+{
+    KafkaTaskQueueLoads loads(3, 2);
+
+    // The home queue keeps its tasks until it holds more than 2 more than the least loaded queue
+    EXPECT_EQ(loads.acquire(1), 1);
+    EXPECT_EQ(loads.acquire(1), 1);
+    EXPECT_EQ(loads.acquire(4), 1);
+    EXPECT_EQ(loads.acquire(1), 0);
+    EXPECT_EQ(loads.load(1), 3);
+
+    loads.release(1);
+    loads.release(1);
+    EXPECT_EQ(loads.acquire(1), 1);
+    EXPECT_EQ(loads.load(0), 1);
+    EXPECT_EQ(loads.load(1), 2);
+    EXPECT_EQ(loads.load(2), 0);
+}
+
+TEST_F(TestKafkaSourceDetail, BatchWindowEmitsInOrder)
+{
+    constexpr std::size_t BatchCount = 8;
+
+    // Batches are parsed on other threads and finish in reverse order
+    std::vector<std::promise<std::size_t>> parsed(BatchCount);
+    std::vector<std::shared_future<std::size_t>> batches;
+    std::vector<std::size_t> emitted;
+
+    for (auto &promise : parsed)
+    {
+        batches.push_back(promise.get_future().share());
+    }
+
+    KafkaBatchWindow<std::shared_future<std::size_t>> window(
+        3, [&](std::shared_future<std::size_t> &&batch) { emitted.push_back(batch.get()); });
+
+    std::thread parser([&]() {
+        for (std::size_t i = BatchCount; i > 0; --i)
+        {
+            parsed[i - 1].set_value(i - 1);
+        }
+    });
+
+    for (std::size_t i = 0; i < BatchCount; ++i)
+    {
+        window.push(batches[i]);
+
+        // The oldest batch is emitted once more than 3 are pending
+        EXPECT_LE(window.size(), 3);
+        EXPECT_EQ(emitted.size(), i + 1 < 3 ? 0 : i + 1 - 3);
+    }
+
+    window.flush();
+    parser.join();
+
+    EXPECT_EQ(window.size(), 0);
+    ASSERT_EQ(emitted.size(), BatchCount);
+
+    for (std::size_t i = 0; i < BatchCount; ++i)
+    {
+        EXPECT_EQ(emitted[i], i);
+    }
+}
+
+TEST_F(TestKafkaSourceDetail, BatchWindowRemovesBatchWhenEmitThrows)
+{
+    std::vector<int> emitted;
+
+    KafkaBatchWindow<int> window(0, [&](int &&batch) {
+        if (batch == 1)
+        {
+            throw std::runtime_error("Unsubscribed");
+        }
+
+        emitted.push_back(batch);
+    });
+
+    window.push(0);
+    EXPECT_THROW(window.push(1), std::runtime_error);
+    window.push(2);
+
+    EXPECT_EQ(emitted, (std::vector<int>{0, 2}));
+    EXPECT_EQ(window.size(), 0);
+}
+
+TEST_F(TestKafkaSourceDetail, EventWatcherAddRemoveStop)
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t notified = 0;
+
+    int fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    ASSERT_GE(fd, 0);
+
+    {
+        KafkaEventWatcher watcher;
+
+        watcher.add(fd, [&]() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                ++notified;
+            }
+
+            cv.notify_all();
+        });
+
+        auto wait_for_notified = [&](std::size_t count) {
+            std::unique_lock<std::mutex> lock(mutex);
+            return cv.wait_for(lock, std::chrono::seconds(5), [&]() { return notified >= count; });
+        };
+
+        ::eventfd_write(fd, 1);
+        EXPECT_TRUE(wait_for_notified(1));
+
+        // The count is cleared before each call, so every write notifies again
+        ::eventfd_write(fd, 1);
+        EXPECT_TRUE(wait_for_notified(2));
+
+        // Never called once removed, even with the eventfd still readable
+        watcher.remove(fd);
+        ::eventfd_write(fd, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        std::lock_guard<std::mutex> lock(mutex);
+        EXPECT_EQ(notified, 2);
+
+        // The destructor stops and joins the watcher thread
+    }
+
+    EXPECT_THROW(
+        {
+            KafkaEventWatcher watcher;
+            watcher.add(-1, nullptr);
+        },
+        std::runtime_error);
+
+    ::close(fd);
+}
+
+TEST_F(TestKafkaSourceDetail, PartitionFibersRevokeOnlyStopsRevoked)
+{
+    KafkaPartitionFibers<TestPartitionTask> fibers;
+
+    auto a0 = fibers.start("a:0", launch_partition_task);
+    auto a1 = fibers.start("a:1", launch_partition_task);
+    auto b0 = fibers.start("b:0", launch_partition_task);
+    EXPECT_EQ(fibers.size(), 3);
+
+    // An incremental revoke, including a partition which was never assigned
+    auto revoked = fibers.stop({"a:1", "c:9"});
+
+    ASSERT_EQ(revoked.size(), 1);
+    EXPECT_EQ(revoked.front(), a1);
+    EXPECT_TRUE(is_finished(a1));
+    EXPECT_FALSE(fibers.contains("a:1"));
+
+    EXPECT_TRUE(a0->running);
+    EXPECT_TRUE(b0->running);
+    EXPECT_FALSE(is_finished(a0));
+    EXPECT_FALSE(is_finished(b0));
+
+    // Assigned again, the running fiber is replaced
+    auto a0_again = fibers.start("a:0", launch_partition_task);
+
+    EXPECT_TRUE(is_finished(a0));
+    EXPECT_FALSE(is_finished(a0_again));
+    EXPECT_EQ(fibers.size(), 2);
+
+    // A replay ends once every remaining partition reached its stop timestamp
+    a0_again->reached_stop = true;
+    EXPECT_FALSE(fibers.all_reached_stop());
+    b0->reached_stop = true;
+    EXPECT_TRUE(fibers.all_reached_stop());
+
+    auto stopped = fibers.stop_all();
+
+    EXPECT_EQ(stopped.size(), 2);
+    EXPECT_TRUE(is_finished(a0_again));
+    EXPECT_TRUE(is_finished(b0));
+    EXPECT_EQ(fibers.size(), 0);
+    EXPECT_FALSE(fibers.all_reached_stop());
+}
@@ -0,0 +1,86 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/io/mapped_file.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace morpheus;
+
+TEST_CLASS(MappedFile);
+
+namespace {
+std::string temp_file_name()
+{
+    return ::testing::TempDir() + "test_mapped_file_" +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name();
+}
+
+void write_file(const std::string& filename, const std::string& contents)
+{
+    std::ofstream out(filename, std::ios::binary);
+    out << contents;
+}
+}  // namespace
+
+TEST_F(TestMappedFile, MapsContents)
+{
+    auto filename = temp_file_name();
+    std::string expected;
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        expected += std::to_string(i) + ",a\n";
+    }
+
+    write_file(filename, expected);
+
+    MappedFile mapped(filename);
+
+    ASSERT_EQ(mapped.size(), expected.size());
+    EXPECT_EQ(std::string(mapped.data(), mapped.size()), expected);
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(TestMappedFile, EmptyFile)
+{
+    auto filename = temp_file_name();
+
+    write_file(filename, "");
+
+    MappedFile mapped(filename);
+
+    EXPECT_EQ(mapped.size(), 0);
+    EXPECT_EQ(mapped.data(), nullptr);
+
+    std::remove(filename.c_str());
+}
+
+TEST_F(TestMappedFile, MissingFile)
+{
+    auto filename = temp_file_name();
+
+    EXPECT_THROW(MappedFile mapped(filename), std::runtime_error);
+}
@@ -0,0 +1,375 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/objects/tensor_cast_view.hpp>
+#include <morpheus/objects/tensor_object.hpp>
+#include <morpheus/utilities/matx_util.hpp>
+
+#include <neo/cuda/common.hpp>  // for NEO_CHECK_CUDA
+#include <neo/memory/old_interface/memory.hpp>
+#include <neo/memory/resources/device/cuda_malloc_resource.hpp>
+
+#include <cuda_runtime.h>
+
+#include <cudf/column/column_view.hpp>
+#include <cudf/types.hpp>
+
+#include <rmm/cuda_stream_view.hpp>
+#include <rmm/device_buffer.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace morpheus;
+
+class TestMatxUtil : public ::testing::Test
+{
+  protected:
+    void SetUp() override
+    {
+        auto device = std::make_shared<neo::memory::cuda_malloc_resource>(0);
+
+        m_device_allocator = neo::memory::OldDeviceAllocator(device, nullptr).shared();
+    }
+
+    void TearDown() override {}
+
+    TensorObject make_device_tensor(const std::vector<float>& values, TensorIndex rows, TensorIndex cols)
+    {
+        auto md = m_device_allocator->allocate_descriptor(values.size() * sizeof(float)).make_shared();
+
+        NEO_CHECK_CUDA(cudaMemcpy(md->data(), values.data(), values.size() * sizeof(float), cudaMemcpyHostToDevice));
+
+        auto tensor = std::make_shared<GenericTensor>(
+            md, 0, DataType(TypeId::FLOAT32), std::vector<TensorIndex>{rows, cols}, std::vector<TensorIndex>{});
+
+        return TensorObject(md, std::move(tensor));
+    }
+
+    template <typename T>
+    std::vector<T> to_host(const void* data, std::size_t count)
+    {
+        std::vector<T> output(count);
+
+        NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+        NEO_CHECK_CUDA(cudaMemcpy(output.data(), data, count * sizeof(T), cudaMemcpyDeviceToHost));
+
+        return output;
+    }
+
+    std::shared_ptr<neo::memory::IAllocator> m_device_allocator;
+};
+
+TEST_F(TestMatxUtil, ReduceRows)
+{
+    auto input = make_device_tensor({1, 5, 3, -2, 0, 4}, 2, 3);
+
+    auto max_vals = MatxUtil::reduce_rows(input, RowReduction::MAX);
+    EXPECT_EQ(to_host<float>(max_vals->data(), 2), (std::vector<float>{5, 4}));
+
+    auto min_vals = MatxUtil::reduce_rows(input, RowReduction::MIN);
+    EXPECT_EQ(to_host<float>(min_vals->data(), 2), (std::vector<float>{1, -2}));
+
+    auto mean_vals = MatxUtil::reduce_rows(input, RowReduction::MEAN);
+    EXPECT_EQ(to_host<float>(mean_vals->data(), 2), (std::vector<float>{3, 2.0f / 3.0f}));
+}
+
+TEST_F(TestMatxUtil, Softmax)
+{
+    auto input = make_device_tensor({0, 0, 1, 1}, 2, 2);
+
+    auto output = to_host<float>(MatxUtil::softmax(input)->data(), 4);
+
+    for (auto value : output)
+    {
+        EXPECT_FLOAT_EQ(value, 0.5f);
+    }
+}
+
+TEST_F(TestMatxUtil, ArgmaxAndTopK)
+{
+    auto input = make_device_tensor({0.1f, 0.7f, 0.2f, 0.9f, 0.3f, 0.9f}, 2, 3);
+
+    auto argmax = MatxUtil::argmax(input);
+    EXPECT_EQ(to_host<int32_t>(argmax->data(), 2), (std::vector<int32_t>{1, 0}));
+
+    auto top_k = MatxUtil::top_k(input, 2);
+    EXPECT_EQ(to_host<float>(top_k[0].data(), 4), (std::vector<float>{0.7f, 0.2f, 0.9f, 0.9f}));
+    EXPECT_EQ(to_host<int32_t>(top_k[1].data(), 4), (std::vector<int32_t>{1, 2, 0, 2}));
+
+    EXPECT_THROW(MatxUtil::top_k(input, 4), std::invalid_argument);
+}
+
+TEST_F(TestMatxUtil, ReduceBySeqIds)
+{
+    // Message 0 was split into two windows, message 1 has no rows and message 2 has one
+    auto input = make_device_tensor({0.1f, 0.8f, 0.6f, 0.2f, 0.3f, 0.4f}, 3, 2);
+
+    std::vector<int32_t> host_seq_ids{0, 0, 1, 0, 1, 2, 2, 0, 1};
+    auto seq_md = m_device_allocator->allocate_descriptor(host_seq_ids.size() * sizeof(int32_t)).make_shared();
+    NEO_CHECK_CUDA(cudaMemcpy(
+        seq_md->data(), host_seq_ids.data(), host_seq_ids.size() * sizeof(int32_t), cudaMemcpyHostToDevice));
+
+    TensorObject seq_ids(seq_md,
+                         std::make_shared<GenericTensor>(seq_md,
+                                                         0,
+                                                         DataType(TypeId::INT32),
+                                                         std::vector<TensorIndex>{3, 3},
+                                                         std::vector<TensorIndex>{}));
+
+    auto output = MatxUtil::reduce_by_seq_ids(input, seq_ids, 3, RowReduction::MAX);
+    EXPECT_EQ(to_host<float>(output->data(), 6), (std::vector<float>{0.6f, 0.8f, 0, 0, 0.3f, 0.4f}));
+}
+
+TEST_F(TestMatxUtil, ApplyElementwise)
+{
+    auto input = make_device_tensor({-1, 0, 2, 5}, 2, 2);
+
+    // (x * 2 + 1) clamped to [0, 6], then thresholded at 2
+    auto output = MatxUtil::apply_elementwise(input,
+                                              {ElementwiseOp{ElementwiseOp::Kind::SCALE, 2},
+                                               ElementwiseOp{ElementwiseOp::Kind::OFFSET, 1},
+                                               ElementwiseOp{ElementwiseOp::Kind::CLAMP, 0, 6},
+                                               ElementwiseOp{ElementwiseOp::Kind::THRESHOLD, 2}});
+
+    EXPECT_EQ(to_host<float>(output->data(), 4), (std::vector<float>{0, 0, 1, 1}));
+}
+
+TEST_F(TestMatxUtil, PredictForest)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    auto input = make_device_tensor({0, 5, 2, nan}, 2, 2);
+
+    // Two single split trees, the first on feature 0 with missing values going left, the second on feature 1 going
+    // right. Each feeds its own output
+    std::vector<ForestNode> nodes{ForestNode{0, 1.0f, 1, 2, 1},
+                                  ForestNode{-1, -1.0f, -1, -1, -1},
+                                  ForestNode{-1, 1.0f, -1, -1, -1},
+                                  ForestNode{1, 3.0f, 4, 5, 5},
+                                  ForestNode{-1, 10.0f, -1, -1, -1},
+                                  ForestNode{-1, 20.0f, -1, -1, -1}};
+    std::vector<int32_t> roots{0, 3};
+    std::vector<int32_t> outputs{0, 1};
+
+    rmm::device_buffer nodes_buffer(nodes.data(), nodes.size() * sizeof(ForestNode), rmm::cuda_stream_per_thread);
+    rmm::device_buffer roots_buffer(roots.data(), roots.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+    rmm::device_buffer outputs_buffer(outputs.data(), outputs.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+    auto output = MatxUtil::predict_forest(input,
+                                           static_cast<const ForestNode*>(nodes_buffer.data()),
+                                           static_cast<const int32_t*>(roots_buffer.data()),
+                                           static_cast<const int32_t*>(outputs_buffer.data()),
+                                           2,
+                                           2,
+                                           0.5f,
+                                           false);
+
+    EXPECT_EQ(to_host<float>(output->data(), 4), (std::vector<float>{-0.5f, 20.5f, 1.5f, 20.5f}));
+}
+
+TEST_F(TestMatxUtil, HashRowsAndScatterInto)
+{
+    auto input = make_device_tensor({1, 2, 3, 4, 1, 2}, 3, 2);
+
+    rmm::device_buffer hashes(3 * sizeof(uint64_t), rmm::cuda_stream_per_thread);
+    MatxUtil::hash_rows(input, static_cast<uint64_t*>(hashes.data()), false);
+
+    auto first = to_host<uint64_t>(hashes.data(), 3);
+
+    // Equal rows hash the same
+    EXPECT_EQ(first[0], first[2]);
+    EXPECT_NE(first[0], first[1]);
+
+    // Combining with a second tensor changes every hash, keeping equal rows equal
+    MatxUtil::hash_rows(make_device_tensor({5, 6, 5}, 3, 1), static_cast<uint64_t*>(hashes.data()), true);
+
+    auto combined = to_host<uint64_t>(hashes.data(), 3);
+
+    EXPECT_NE(combined[0], first[0]);
+    EXPECT_EQ(combined[0], combined[2]);
+
+    // Rows 0 and 1 of the input land in rows 2 and 0 of the output, row 1 is left as it was
+    std::vector<int32_t> indices{2, 0};
+    rmm::device_buffer indices_buffer(indices.data(), indices.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+    auto output = make_device_tensor({0, 0, 9, 9, 0, 0}, 3, 2);
+
+    MatxUtil::scatter_rows_into(input.slice({0, 0}, {2, -1}),
+                                static_cast<const int32_t*>(indices_buffer.data()),
+                                output.data());
+
+    EXPECT_EQ(to_host<float>(output.data(), 6), (std::vector<float>{3, 4, 9, 9, 1, 2}));
+}
+
+TEST_F(TestMatxUtil, LogitsInto)
+{
+    auto input  = make_device_tensor({0, 0, 0, 0}, 2, 2);
+    auto output = make_device_tensor({9, 9, 9, 9}, 2, 2);
+
+    MatxUtil::logits_into(input.data(), output.data(), 4, TypeId::FLOAT32);
+
+    for (auto value : to_host<float>(output.data(), 4))
+    {
+        EXPECT_FLOAT_EQ(value, 0.5f);
+    }
+
+    // In place, the input is overwritten
+    MatxUtil::logits_into(input.data(), input.data(), 4, TypeId::FLOAT32);
+
+    EXPECT_EQ(to_host<float>(input.data(), 4), to_host<float>(output.data(), 4));
+}
+
+TEST_F(TestMatxUtil, HalfPrecision)
+{
+    auto input = make_device_tensor({0, 2, -2, 0}, 2, 2);
+
+    for (auto half_type : {TypeId::FLOAT16, TypeId::BFLOAT16})
+    {
+        auto md = m_device_allocator->allocate_descriptor(4 * DataType(half_type).item_size()).make_shared();
+
+        MatxUtil::cast_into(input.data(), TypeId::FLOAT32, 4, half_type, md->data(), rmm::cuda_stream_per_thread);
+
+        // Stays in half precision, only the final values are widened
+        MatxUtil::logits_into(md->data(), md->data(), 4, half_type);
+
+        auto tensor = std::make_shared<GenericTensor>(
+            md, 0, DataType(half_type), std::vector<TensorIndex>{2, 2}, std::vector<TensorIndex>{});
+        TensorObject half_tensor(md, std::move(tensor));
+
+        auto labels = MatxUtil::threshold(half_tensor, 0.6, false);
+        EXPECT_EQ(to_host<uint8_t>(labels->data(), 4), (std::vector<uint8_t>{0, 1, 0, 0}));
+
+        auto output = make_device_tensor({9, 9, 9, 9}, 2, 2);
+        MatxUtil::cast_into(md->data(), half_type, 4, TypeId::FLOAT32, output.data(), rmm::cuda_stream_per_thread);
+
+        auto values = to_host<float>(output.data(), 4);
+        EXPECT_NEAR(values[0], 0.5f, 1e-2);
+        EXPECT_NEAR(values[1], 0.8808f, 1e-2);
+        EXPECT_NEAR(values[2], 0.1192f, 1e-2);
+    }
+}
+
+TEST_F(TestMatxUtil, PackColumnsScaled)
+{
+    auto first  = make_device_tensor({1, 2, 3}, 3, 1);
+    auto second = make_device_tensor({10, 20, 30}, 3, 1);
+
+    std::vector<cudf::column_view> columns{
+        cudf::column_view(cudf::data_type{cudf::type_id::FLOAT32}, 3, first.data()),
+        cudf::column_view(cudf::data_type{cudf::type_id::FLOAT32}, 3, second.data())};
+
+    // Row-major, first column standardized with mean 2 and std 0.5, second min-max scaled over [10, 30]
+    auto output = MatxUtil::pack_columns(columns, {2.0f, 10.0f}, {2.0f, 0.05f});
+
+    auto values = to_host<float>(output->data(), 6);
+    std::vector<float> expected{-2, 0, 0, 0.5, 2, 1};
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(values[i], expected[i]);
+    }
+
+    EXPECT_THROW(MatxUtil::pack_columns(columns, {1.0f}, {1.0f}), std::invalid_argument);
+}
+
+TEST_F(TestMatxUtil, CastViewIntoPinnedHost)
+{
+    auto input = make_device_tensor({1.5f, -2.0f, 3.25f, 4.0f}, 2, 2);
+
+    // The conversion is written straight into the pinned staging buffer, no intermediate device buffer
+    const TensorCastView view(input, DataType(TypeId::INT32));
+
+    EXPECT_FALSE(view.is_identity());
+    EXPECT_EQ(view.bytes(), 4 * sizeof(int32_t));
+
+    auto host_buffer = view.copy_to_host_async(rmm::cuda_stream_per_thread);
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    const auto* values = reinterpret_cast<const int32_t*>(host_buffer.data());
+    EXPECT_EQ((std::vector<int32_t>(values, values + 4)), (std::vector<int32_t>{1, -2, 3, 4}));
+
+    // Same type is a plain copy
+    const TensorCastView same(input, DataType(TypeId::FLOAT32));
+    EXPECT_TRUE(same.is_identity());
+
+    auto same_buffer = same.copy_to_host_async(rmm::cuda_stream_per_thread);
+    NEO_CHECK_CUDA(cudaStreamSynchronize(rmm::cuda_stream_per_thread));
+
+    const auto* floats = reinterpret_cast<const float*>(same_buffer.data());
+    EXPECT_EQ((std::vector<float>(floats, floats + 4)), (std::vector<float>{1.5f, -2.0f, 3.25f, 4.0f}));
+}
+
+TEST_F(TestMatxUtil, TimeSeriesBinning)
+{
+    // Nanoseconds. 59.5s and -1.5s round half to even, to 60s and -2s
+    std::vector<int64_t> ticks{0, 59'500'000'000, 30'000'000'000, 150'500'000'000, -1'500'000'000};
+    rmm::device_buffer device_ticks(ticks.data(), ticks.size() * sizeof(int64_t), rmm::cuda_stream_per_thread);
+    rmm::device_buffer row_bins(ticks.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+
+    auto* bins = static_cast<int32_t*>(row_bins.data());
+    auto range = MatxUtil::time_bins(
+        static_cast<const int64_t*>(device_ticks.data()), ticks.size(), 1'000'000'000, 0, 60, bins);
+
+    EXPECT_EQ(to_host<int32_t>(bins, 5), (std::vector<int32_t>{0, 1, 0, 2, -1}));
+    EXPECT_EQ(range.first, 0);
+    EXPECT_EQ(range.last, -1);
+    EXPECT_EQ(range.min, -1);
+    EXPECT_EQ(range.max, 2);
+
+    // Ring of 4 bins, the row of bin -1 is outside of [0, 2] and ignored
+    std::vector<int32_t> zeros(4, 0);
+    rmm::device_buffer counts(zeros.data(), zeros.size() * sizeof(int32_t), rmm::cuda_stream_per_thread);
+    auto* ring = static_cast<int32_t*>(counts.data());
+
+    MatxUtil::add_to_histogram(bins, 5, 0, 2, ring, 4);
+    EXPECT_EQ(to_host<int32_t>(ring, 4), (std::vector<int32_t>{2, 1, 1, 0}));
+
+    // Bins 1 to 3, the last value also counts bin 4. Bins outside of [0, 2] read as zero
+    auto signals =
+        MatxUtil::window_signals({TimeSeriesWindow{ring, 4, 0, 2, 1}, TimeSeriesWindow{ring, 4, 1, 2, -1}}, 3);
+    EXPECT_EQ(to_host<double>(signals->data(), 6), (std::vector<double>{1, 1, 0, 0, 0, 2}));
+
+    // Rows of bins 0 and 2 flagged, bin 3 is past the window
+    std::vector<uint8_t> host_bin_flags{1, 0, 1};
+    rmm::device_buffer bin_flags(host_bin_flags.data(), 3, rmm::cuda_stream_per_thread);
+    rmm::device_buffer row_flags(5 * sizeof(bool), rmm::cuda_stream_per_thread);
+
+    MatxUtil::flag_rows(
+        bins, 5, static_cast<const bool*>(bin_flags.data()), 0, 3, static_cast<bool*>(row_flags.data()));
+    EXPECT_EQ(to_host<uint8_t>(row_flags.data(), 5), (std::vector<uint8_t>{1, 0, 1, 1, 0}));
+}
+
+TEST_F(TestMatxUtil, FftAnomaliesConstantSignal)
+{
+    // A constant signal is perfectly reconstructed, nothing is flagged
+    std::vector<double> values(2 * 16, 3.0);
+    rmm::device_buffer signals(values.data(), values.size() * sizeof(double), rmm::cuda_stream_per_thread);
+
+    auto flags = MatxUtil::fft_anomalies(static_cast<const double*>(signals.data()), 2, 16, 90, 0.5);
+
+    EXPECT_EQ(to_host<uint8_t>(flags->data(), values.size()), std::vector<uint8_t>(values.size(), 0));
+
+    // Single values never are
+    auto single = MatxUtil::fft_anomalies(static_cast<const double*>(signals.data()), 2, 1, 90, 0.5);
+    EXPECT_EQ(to_host<uint8_t>(single->data(), 2), std::vector<uint8_t>(2, 0));
+}
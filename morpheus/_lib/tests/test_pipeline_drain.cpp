@@ -0,0 +1,84 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/utilities/pipeline_drain.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+
+#include <chrono>
+
+using namespace morpheus;
+
+TEST_CLASS(PipelineDrain);
+
+TEST_F(TestPipelineDrain, RequestAndDeadline)
+{
+    PipelineDrain::reset();
+
+    EXPECT_FALSE(PipelineDrain::requested());
+    EXPECT_FALSE(PipelineDrain::expired());
+    EXPECT_EQ(PipelineDrain::deadline(), PipelineDrain::clock_t::time_point::max());
+
+    PipelineDrain::request(std::chrono::hours(1));
+
+    EXPECT_TRUE(PipelineDrain::requested());
+    EXPECT_FALSE(PipelineDrain::expired());
+
+    // A later request only moves the deadline closer
+    auto first_deadline = PipelineDrain::deadline();
+    PipelineDrain::request(std::chrono::hours(2));
+    EXPECT_EQ(PipelineDrain::deadline(), first_deadline);
+
+    PipelineDrain::request(std::chrono::milliseconds(0));
+    EXPECT_TRUE(PipelineDrain::expired());
+
+    PipelineDrain::reset();
+
+    EXPECT_FALSE(PipelineDrain::requested());
+    EXPECT_FALSE(PipelineDrain::expired());
+}
+
+TEST_F(TestPipelineDrain, Progress)
+{
+    PipelineDrain::reset();
+
+    auto progress = PipelineDrain::track("source");
+
+    // Tracking the same name again returns the same progress
+    EXPECT_EQ(PipelineDrain::track("source"), progress);
+
+    {
+        DrainProgress::Scope scope(*progress);
+        progress->add(2);
+
+        EXPECT_EQ(PipelineDrain::progress()["source"].in_flight, 3u);
+    }
+
+    progress->remove(2);
+    progress->set_drained();
+
+    auto status = PipelineDrain::progress()["source"];
+    EXPECT_EQ(status.in_flight, 0u);
+    EXPECT_TRUE(status.drained);
+
+    PipelineDrain::reset();
+
+    EXPECT_TRUE(PipelineDrain::progress().empty());
+}
@@ -0,0 +1,90 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/objects/tensor_map.hpp>
+#include <morpheus/objects/tensor_object.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(TensorMap);
+
+TEST_F(TestTensorMap, SlotsFollowInsertionOrder)
+{
+    TensorMap map;
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.slot_of("input_ids"), TensorMap::npos);
+
+    map.emplace("input_ids", TensorObject());
+    map.emplace("input_mask", TensorObject());
+    map["seq_ids"];
+
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.slot_of("input_ids"), 0u);
+    EXPECT_EQ(map.slot_of("input_mask"), 1u);
+    EXPECT_EQ(map.slot_of("seq_ids"), 2u);
+    EXPECT_EQ(map.name_at(1), "input_mask");
+
+    std::vector<std::string> names;
+    for (const auto& [name, tensor] : map)
+    {
+        names.push_back(name);
+    }
+
+    EXPECT_EQ(names, (std::vector<std::string>{"input_ids", "input_mask", "seq_ids"}));
+}
+
+TEST_F(TestTensorMap, LookupsShareEntries)
+{
+    TensorMap map;
+
+    auto [inserted, was_inserted] = map.emplace("probs", TensorObject());
+    EXPECT_TRUE(was_inserted);
+
+    auto [existing, was_inserted_again] = map.emplace("probs", TensorObject());
+    EXPECT_FALSE(was_inserted_again);
+    EXPECT_EQ(existing, inserted);
+
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_EQ(&map["probs"], &map.at(0));
+    EXPECT_EQ(&map.find("probs")->second, &map.at(0));
+    EXPECT_EQ(map.find("missing"), map.end());
+    EXPECT_TRUE(map.contains("probs"));
+    EXPECT_FALSE(map.contains("missing"));
+}
+
+TEST_F(TestTensorMap, SlotHint)
+{
+    TensorMap map;
+
+    map.emplace("a", TensorObject());
+    map.emplace("b", TensorObject());
+
+    // A correct hint, a wrong hint and an out of range hint all find the entry
+    EXPECT_EQ(map.slot_of("b", 1), 1u);
+    EXPECT_EQ(map.slot_of("b", 0), 1u);
+    EXPECT_EQ(map.slot_of("b", 10), 1u);
+    EXPECT_EQ(map.slot_of("c", 1), TensorMap::npos);
+}
@@ -0,0 +1,211 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/stages/triton_inference_detail.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, EXPECT_THROW
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(TritonInferenceDetail);
+
+TEST_F(TestTritonInferenceDetail, SplitServerUrls)
+{
+    EXPECT_EQ(InferenceServerUrls::split("localhost:8001"), (std::vector<std::string>{"localhost:8001"}));
+    EXPECT_EQ(InferenceServerUrls::split(" a:8001, b:8001 ,,\tc:8001 "),
+              (std::vector<std::string>{"a:8001", "b:8001", "c:8001"}));
+    EXPECT_TRUE(InferenceServerUrls::split(" , ").empty());
+}
+
+TEST_F(TestTritonInferenceDetail, EndpointLoadsPreferFewestOutstanding)
+{
+    InferenceEndpointLoads loads(3, std::chrono::seconds(5));
+
+    // Ties are spread across servers
+    EXPECT_EQ(loads.acquire(), 0);
+    EXPECT_EQ(loads.acquire(), 1);
+    EXPECT_EQ(loads.acquire(), 2);
+
+    EXPECT_FALSE(loads.release(1, false));
+    EXPECT_EQ(loads.outstanding(1), 0);
+
+    EXPECT_EQ(loads.acquire(), 1);
+    EXPECT_EQ(loads.acquire(), 2);
+    EXPECT_EQ(loads.outstanding(2), 2);
+}
+
+TEST_F(TestTritonInferenceDetail, EndpointLoadsEjectAndCheckAgain)
+{
+    const auto now = InferenceEndpointLoads::clock_t::now();
+
+    InferenceEndpointLoads loads(2, std::chrono::seconds(5));
+
+    EXPECT_EQ(loads.acquire(), 0);
+    EXPECT_EQ(loads.acquire(), 1);
+
+    EXPECT_TRUE(loads.release(0, true, now));
+    EXPECT_FALSE(loads.healthy(0));
+
+    // Only ejected once, by the first failure
+    EXPECT_EQ(loads.acquire(), 1);
+    EXPECT_EQ(loads.acquire(), 1);
+
+    EXPECT_TRUE(loads.due_for_check(now + std::chrono::seconds(1)).empty());
+    EXPECT_EQ(loads.due_for_check(now + std::chrono::seconds(5)), (std::vector<std::size_t>{0}));
+
+    // Not handed out twice while it is being checked
+    EXPECT_TRUE(loads.due_for_check(now + std::chrono::seconds(6)).empty());
+
+    loads.restore(0);
+
+    EXPECT_TRUE(loads.healthy(0));
+    EXPECT_EQ(loads.acquire(), 0);
+}
+
+TEST_F(TestTritonInferenceDetail, EndpointLoadsAllEjected)
+{
+    InferenceEndpointLoads single(1, std::chrono::seconds(5));
+
+    // A lone server is never ejected
+    EXPECT_EQ(single.acquire(), 0);
+    EXPECT_FALSE(single.release(0, true));
+    EXPECT_TRUE(single.healthy(0));
+
+    InferenceEndpointLoads loads(2, std::chrono::seconds(5));
+
+    EXPECT_EQ(loads.acquire(), 0);
+    EXPECT_EQ(loads.acquire(), 1);
+    EXPECT_TRUE(loads.release(0, true));
+    EXPECT_TRUE(loads.release(1, true));
+    EXPECT_FALSE(loads.release(0, true) || loads.healthy(0));
+
+    EXPECT_EQ(loads.acquire(), loads.size());
+}
+
+TEST_F(TestTritonInferenceDetail, ResponseCacheIndexHitsAndMisses)
+{
+    InferenceResponseCacheIndex index(4);
+
+    auto first = index.lookup({10, 20, 10});
+
+    // Rows sharing a key are only sent once
+    EXPECT_TRUE(first.hit_rows.empty());
+    EXPECT_EQ(first.miss_rows, (std::vector<int32_t>{0, 1}));
+    EXPECT_EQ(first.missed_rows, (std::vector<int32_t>{0, 1, 2}));
+    EXPECT_EQ(first.missed_keys, (std::vector<int32_t>{0, 1, 0}));
+
+    EXPECT_EQ(index.assign({10, 20, 10}, first.miss_rows), (std::vector<int32_t>{0, 1}));
+    EXPECT_EQ(index.size(), 2);
+
+    auto second = index.lookup({20, 30, 10});
+
+    EXPECT_EQ(second.hit_rows, (std::vector<int32_t>{0, 2}));
+    EXPECT_EQ(second.hit_slots, (std::vector<int32_t>{1, 0}));
+    EXPECT_EQ(second.miss_rows, (std::vector<int32_t>{1}));
+    EXPECT_EQ(second.missed_rows, (std::vector<int32_t>{1}));
+}
+
+TEST_F(TestTritonInferenceDetail, ResponseCacheIndexEvictsLeastRecentlyUsed)
+{
+    InferenceResponseCacheIndex index(2);
+
+    EXPECT_EQ(index.assign({1, 2}, {0, 1}), (std::vector<int32_t>{0, 1}));
+
+    // Key 1 becomes the most recently used, key 2 goes first
+    index.lookup({1});
+
+    EXPECT_EQ(index.assign({3}, {0}), (std::vector<int32_t>{1}));
+
+    EXPECT_TRUE(index.contains(1));
+    EXPECT_FALSE(index.contains(2));
+    EXPECT_TRUE(index.contains(3));
+    EXPECT_EQ(index.size(), 2);
+
+    EXPECT_EQ(index.lookup({2}).miss_rows, (std::vector<int32_t>{0}));
+}
+
+TEST_F(TestTritonInferenceDetail, ResponseCacheIndexStoresAtMostCapacity)
+{
+    InferenceResponseCacheIndex index(2);
+
+    EXPECT_EQ(index.assign({1, 2, 3}, {0, 1, 2}), (std::vector<int32_t>{0, 1}));
+    EXPECT_FALSE(index.contains(3));
+
+    // Stored by another caller since the lookup, keeps its slot
+    EXPECT_EQ(index.assign({2}, {0}), (std::vector<int32_t>{1}));
+    EXPECT_EQ(index.size(), 2);
+}
+
+TEST_F(TestTritonInferenceDetail, SharedFutureCacheStartsOncePerKey)
+{
+    InferenceSharedFutureCache<std::tuple<int, std::string>, int> cache;
+    std::atomic<int> starts{0};
+
+    auto start = [&starts]() { return ++starts; };
+
+    auto first  = cache.get({1, "model"}, start);
+    auto second = cache.get({1, "model"}, start);
+
+    EXPECT_EQ(first.get(), 1);
+    EXPECT_EQ(second.get(), 1);
+
+    EXPECT_EQ(cache.get({2, "model"}, start).get(), 2);
+    EXPECT_EQ(starts, 2);
+    EXPECT_EQ(cache.size(), 2);
+}
+
+TEST_F(TestTritonInferenceDetail, SharedFutureCacheForgetsFailures)
+{
+    InferenceSharedFutureCache<std::string, int> cache;
+    std::atomic<int> starts{0};
+
+    std::promise<void> gate;
+    std::shared_future<void> opened = gate.get_future().share();
+
+    auto failing = [&starts, opened]() -> int {
+        ++starts;
+        opened.wait();
+        throw std::runtime_error("Server not ready");
+    };
+
+    auto first = cache.get("model", failing);
+
+    // Shared while it has not completed, even though it will fail
+    auto second = cache.get("model", failing);
+
+    gate.set_value();
+
+    EXPECT_THROW(first.get(), std::runtime_error);
+    EXPECT_THROW(second.get(), std::runtime_error);
+    EXPECT_EQ(starts, 1);
+
+    // Started again once it failed
+    EXPECT_EQ(cache.get("model", [&starts]() { return ++starts; }).get(), 2);
+    EXPECT_EQ(cache.get("model", [&starts]() { return ++starts; }).get(), 2);
+}
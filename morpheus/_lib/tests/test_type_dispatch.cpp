@@ -0,0 +1,101 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/utilities/type_dispatch.hpp>
+#include <morpheus/utilities/type_util_detail.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ, EXPECT_THROW
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(TypeDispatch);
+
+TEST_F(TestTypeDispatch, TypeIdOf)
+{
+    static_assert(TypeIdOf<int8_t>::value == TypeId::INT8);
+    static_assert(TypeIdOf<uint64_t>::value == TypeId::UINT64);
+    static_assert(TypeIdOf<long long>::value == TypeId::INT64);
+    static_assert(TypeIdOf<double>::value == TypeId::FLOAT64);
+    static_assert(TypeIdOf<std::vector<int>>::value == TypeId::EMPTY);
+
+    // bool is also an unsigned 8 bit integral type
+    static_assert(TypeIdOf<bool>::value == TypeId::BOOL8);
+    EXPECT_EQ(DataType::create<bool>(), DataType(TypeId::BOOL8));
+    EXPECT_EQ(DataType::create<uint8_t>(), DataType(TypeId::UINT8));
+}
+
+TEST_F(TestTypeDispatch, TypeLists)
+{
+    static_assert(NumericTypes::size == 10);
+    static_assert(CudfTypes::size == 11);
+    static_assert(std::is_same_v<type_list_concat_t<TypeList<int>, TypeList<>, TypeList<float, bool>>,
+                                 TypeList<int, float, bool>>);
+
+    static_assert(type_list_contains_v<FloatingPointTypes, float>);
+    static_assert(!type_list_contains_v<FloatingPointTypes, int32_t>);
+
+    EXPECT_TRUE(type_list_contains_id(CudfTypes{}, TypeId::BOOL8));
+    EXPECT_FALSE(type_list_contains_id(CudfTypes{}, TypeId::FLOAT16));
+    EXPECT_FALSE(type_list_contains_id(IntegralTypes{}, TypeId::FLOAT32));
+}
+
+TEST_F(TestTypeDispatch, DispatchType)
+{
+    std::size_t item_size = 0;
+    auto record_size = [&item_size](auto tag) {
+        item_size = sizeof(typename decltype(tag)::type);
+    };
+
+    dispatch_type<CudfTypes>(TypeId::INT16, record_size);
+    EXPECT_EQ(item_size, 2u);
+
+    dispatch_type<CudfTypes>(TypeId::FLOAT64, record_size);
+    EXPECT_EQ(item_size, 8u);
+
+    TypeId dispatched = TypeId::EMPTY;
+    dispatch_type<FloatingPointTypes>(TypeId::FLOAT32, [&dispatched](auto tag) {
+        dispatched = TypeIdOf<typename decltype(tag)::type>::value;
+    });
+    EXPECT_EQ(dispatched, TypeId::FLOAT32);
+
+    // Types outside of the list never reach the function
+    EXPECT_THROW(dispatch_type<FloatingPointTypes>(TypeId::INT32, record_size), std::invalid_argument);
+    EXPECT_THROW(dispatch_type<CudfTypes>(TypeId::EMPTY, record_size), std::invalid_argument);
+}
+
+TEST_F(TestTypeDispatch, DispatchTypePair)
+{
+    std::vector<TypeId> dispatched;
+    auto record = [&dispatched](auto input_tag, auto output_tag) {
+        dispatched.push_back(TypeIdOf<typename decltype(input_tag)::type>::value);
+        dispatched.push_back(TypeIdOf<typename decltype(output_tag)::type>::value);
+    };
+
+    dispatch_type_pair<IntegralTypes, FloatingPointTypes>(TypeId::UINT32, TypeId::FLOAT64, record);
+    EXPECT_EQ(dispatched, (std::vector<TypeId>{TypeId::UINT32, TypeId::FLOAT64}));
+
+    EXPECT_THROW(dispatch_type_pair<IntegralTypes, FloatingPointTypes>(TypeId::UINT32, TypeId::INT8, record),
+                 std::invalid_argument);
+}
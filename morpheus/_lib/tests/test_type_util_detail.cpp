@@ -19,8 +19,9 @@
 
 #include <morpheus/utilities/type_util_detail.hpp>
 
-#include <gtest/gtest.h>  // for EXPECT_EQ
+#include <gtest/gtest.h>  // for EXPECT_EQ, EXPECT_THROW
 
+#include <stdexcept>
 #include <vector>
 
 TEST_CLASS(TypeUtils);
@@ -53,3 +54,18 @@ TEST_F(TestTypeUtils, DataTypeCopy)
     morpheus::DataType d5{d1};
     morpheus::DataType d6{d2};
 }
+
+TEST_F(TestTypeUtils, HalfTypes)
+{
+    morpheus::DataType fp16(morpheus::TypeId::FLOAT16);
+    morpheus::DataType bf16(morpheus::TypeId::BFLOAT16);
+
+    EXPECT_EQ(fp16.item_size(), 2u);
+    EXPECT_EQ(bf16.item_size(), 2u);
+
+    EXPECT_EQ(fp16.type_str(), "<f2");
+    EXPECT_EQ(morpheus::DataType::from_numpy("<f2"), fp16);
+
+    // numpy has no bfloat16
+    EXPECT_THROW(bf16.type_str(), std::invalid_argument);
+}
@@ -0,0 +1,89 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/objects/typed_tensor_view.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+
+#include <numeric>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(TypedTensorView);
+
+// The view never dereferences memory itself, so host memory stands in for a device tensor
+TEST_F(TestTypedTensorView, RowMajorIndexing)
+{
+    std::vector<float> values(12);
+    std::iota(values.begin(), values.end(), 0.0f);
+
+    TypedTensorView<float, 2> view(values.data(), {3, 4}, {4, 1});
+
+    EXPECT_EQ(view.count(), 12);
+    EXPECT_TRUE(view.is_compact());
+    EXPECT_EQ(view.offset(2, 1), 9);
+    EXPECT_EQ(view(1, 3), 7.0f);
+    EXPECT_EQ(view.at({2, 3}), &values[11]);
+}
+
+TEST_F(TestTypedTensorView, ColumnMajorIndexing)
+{
+    std::vector<float> values(12);
+    std::iota(values.begin(), values.end(), 0.0f);
+
+    TypedTensorView<const float, 2> view(values.data(), {3, 4}, {1, 3});
+
+    EXPECT_FALSE(view.is_compact());
+    EXPECT_EQ(view(2, 1), 5.0f);
+    EXPECT_EQ(view.ptr(0, 3), &values[9]);
+}
+
+TEST_F(TestTypedTensorView, Slice)
+{
+    std::vector<int> values(12);
+    std::iota(values.begin(), values.end(), 0);
+
+    TypedTensorView<int, 2> view(values.data(), {3, 4}, {4, 1});
+
+    // Column 2, same as the per label slices taken from probs
+    auto column = view.slice({0, 2}, {-1, 3});
+
+    EXPECT_EQ(column.shape(0), 3);
+    EXPECT_EQ(column.shape(1), 1);
+    EXPECT_EQ(column.stride(0), 4);
+    EXPECT_EQ(column(0, 0), 2);
+    EXPECT_EQ(column(2, 0), 10);
+
+    auto inner = view.slice({1, 1}, {3, 3});
+
+    EXPECT_EQ(inner.count(), 4);
+    EXPECT_EQ(inner.data(), &values[5]);
+    EXPECT_EQ(inner(1, 1), 10);
+}
+
+TEST_F(TestTypedTensorView, BoundsChecks)
+{
+    std::vector<int> values(6);
+
+    TypedTensorView<int, 2> view(values.data(), {2, 3}, {3, 1});
+
+    EXPECT_DEATH(view.at({2, 0}), "outside of the bounds");
+    EXPECT_DEATH(view.slice({0, 0}, {2, 4}), "outside of the bounds");
+}
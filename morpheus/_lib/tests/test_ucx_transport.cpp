@@ -0,0 +1,93 @@
+/**
+ * SPDX-FileCopyrightText: Copyright (c) 2021-2022, NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "./test_morpheus.hpp"  // IWYU pragma: associated
+
+#include <morpheus/io/ucx_transport.hpp>
+
+#include <gtest/gtest.h>  // for EXPECT_EQ
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace morpheus;
+
+TEST_CLASS(UcxTransport);
+
+TEST_F(TestUcxTransport, FrameHeaderRoundTrip)
+{
+    UcxFrameHeader header;
+    header.payload_tag   = 0x0200123456000007ULL;
+    header.payload_bytes = 1 << 20;
+    header.num_indices   = 1;
+    header.column_names  = {"", "data", "probs"};
+    header.metadata      = {1, 2, 3, 0, 255};
+
+    auto encoded = header.encode();
+    auto decoded = UcxFrameHeader::decode(encoded.data(), encoded.size());
+
+    EXPECT_FALSE(decoded.end);
+    EXPECT_EQ(decoded.payload_tag, header.payload_tag);
+    EXPECT_EQ(decoded.payload_bytes, header.payload_bytes);
+    EXPECT_EQ(decoded.num_indices, header.num_indices);
+    EXPECT_EQ(decoded.column_names, header.column_names);
+    EXPECT_EQ(decoded.metadata, header.metadata);
+}
+
+TEST_F(TestUcxTransport, FrameHeaderEnd)
+{
+    UcxFrameHeader header;
+    header.end = true;
+
+    auto encoded = header.encode();
+    auto decoded = UcxFrameHeader::decode(encoded.data(), encoded.size());
+
+    EXPECT_TRUE(decoded.end);
+    EXPECT_TRUE(decoded.column_names.empty());
+    EXPECT_TRUE(decoded.metadata.empty());
+}
+
+TEST_F(TestUcxTransport, FrameHeaderRejectsInvalid)
+{
+    UcxFrameHeader header;
+    header.column_names = {"data"};
+
+    auto encoded = header.encode();
+
+    // Every truncation fails rather than reading past the end
+    for (std::size_t size = 0; size < encoded.size(); ++size)
+    {
+        EXPECT_THROW(UcxFrameHeader::decode(encoded.data(), size), std::runtime_error);
+    }
+
+    encoded[0] ^= 0xff;
+    EXPECT_THROW(UcxFrameHeader::decode(encoded.data(), encoded.size()), std::runtime_error);
+}
+
+TEST_F(TestUcxTransport, UnavailableWithoutUcx)
+{
+    if (UcxSender::Available)
+    {
+        GTEST_SKIP() << "Built with UCX";
+    }
+
+    EXPECT_THROW(UcxSender("localhost", 13337), std::runtime_error);
+    EXPECT_THROW(UcxReceiver("0.0.0.0", 13337), std::runtime_error);
+}
@@ -168,6 +168,20 @@ def _parse_log_level(ctx, param, value):
     return x
 
 
+def _parse_column_types(ctx, param, value):
+    output_columns = {}
+
+    for column in value:
+        name, sep, dtype = column.partition("=")
+
+        if (not sep or not name or not dtype):
+            raise click.BadParameter("Must be given as NAME=TYPE, like 'score=float32'. Passed: {}".format(column))
+
+        output_columns[name] = dtype
+
+    return output_columns
+
+
 @click.group(name="morpheus",
              chain=False,
              invoke_without_command=True,
@@ -298,6 +312,55 @@ def install(**kwargs):
               help=("The size of buffered channels to use between nodes in a pipeline. Larger values reduce "
                     "backpressure at the cost of memory. Smaller values will push messages through the "
                     "pipeline quicker. Must be greater than 1 and a power of 2 (i.e. 2, 4, 8, 16, etc.)"))
+@click.option('--device_memory_resource',
+              default=DEFAULT_CONFIG.device_memory_resource,
+              type=click.Choice(["cuda", "pool", "arena"], case_sensitive=False),
+              help=("Device memory resource C++ stages allocate their buffers from. 'pool' and 'arena' reuse freed "
+                    "memory instead of calling cudaMalloc/cudaFree for every buffer"))
+@click.option('--device_pool_initial_size',
+              default=DEFAULT_CONFIG.device_pool_initial_size,
+              type=click.IntRange(min=0),
+              help="Initial size of the device memory pool in bytes. 0 uses half of the device memory")
+@click.option('--device_pool_maximum_size',
+              default=DEFAULT_CONFIG.device_pool_maximum_size,
+              type=click.IntRange(min=0),
+              help="Size in bytes the device memory pool may grow to. 0 for no limit")
+@click.option('--device_timing',
+              default=DEFAULT_CONFIG.device_timing,
+              type=bool,
+              help=("Time annotated device operations in C++ stages with CUDA events and log the totals when the "
+                    "pipeline completes. Requires a build with MORPHEUS_ENABLE_DEVICE_ANNOTATIONS"))
+@click.option('--cuda_graphs',
+              default=DEFAULT_CONFIG.cuda_graphs,
+              type=bool,
+              help=("Replay the fixed-shape kernel sequences of the C++ preprocessing stages as CUDA Graphs, one per "
+                    "batch size, to reduce launch overhead for small batches"))
+@click.option('--drain_timeout',
+              default=DEFAULT_CONFIG.drain_timeout,
+              type=click.FloatRange(min=0),
+              help=("Seconds to drain the pipeline for on SIGINT or SIGTERM. Sources stop consuming and the rest of the "
+                    "pipeline finishes and commits what was already consumed. 0 stops immediately"))
+@click.option('--fuse_cpp_stages',
+              default=DEFAULT_CONFIG.fuse_cpp_stages,
+              type=bool,
+              help=("Run each chain of consecutive C++ stages as a single node, passing messages between them with "
+                    "direct calls instead of channels"))
+@click.option('--num_gpus',
+              default=DEFAULT_CONFIG.num_gpus,
+              type=click.IntRange(min=1),
+              help=("Number of GPUs to spread C++ stages across. Above 1, chains of C++ stages are fused and every GPU "
+                    "runs its own instance of each chain. Messages are not kept in order and the GPUs must "
+                    "support peer access"))
+@click.option('--output_columns',
+              multiple=True,
+              callback=_parse_column_types,
+              help=("Output column, as NAME=TYPE, created by the C++ sources in every message so stages writing it "
+                    "never change the table schema. Can be repeated"))
+@click.option('--trace_sample_interval',
+              default=DEFAULT_CONFIG.trace_sample_interval,
+              type=click.IntRange(min=0),
+              help=("Trace one in every N source messages through the C++ stages and export their latency since "
+                    "ingestion as a histogram per stage. 0 disables tracing"))
 @click.option('--use_cpp',
               default=True,
               type=bool,
@@ -579,6 +642,16 @@ def post_pipeline(ctx: click.Context, *args, **kwargs):
               type=bool,
               help=("Whether or not to filter rows with null 'data' column. Null values in the 'data' column can "
                     "cause issues down the line with processing. Setting this to True is recommended."))
+@click.option('--chunk_bytes',
+              default=0,
+              type=click.IntRange(min=0),
+              help=("Read the file this many bytes at a time, emitting each chunk as it is read, so files larger than "
+                    "device memory can be replayed. 0 reads the whole file at once."))
+@click.option('--use_mmap',
+              is_flag=True,
+              default=False,
+              help=("Read the file through a memory mapping, so repeated replays are served from the page cache "
+                    "without an intermediate host copy."))
 @prepare_command()
 def from_file(ctx: click.Context, **kwargs):
 
@@ -596,6 +669,47 @@ def from_file(ctx: click.Context, **kwargs):
     return stage
 
 
+@click.command(short_help="Load messages from many files, reading several at once", **command_kwargs)
+@click.option('--filename',
+              'filenames',
+              type=str,
+              multiple=True,
+              required=True,
+              help=("Input filename or glob. May be given multiple times. Globs are expanded in sorted order."))
+@click.option('--file-type',
+              type=click.Choice(FILE_TYPE_NAMES, case_sensitive=False),
+              default="auto",
+              help=("Indicates what type of file to read. "
+                    "Specifying 'auto' will determine the file type from the extension."))
+@click.option('--prefetch',
+              default=4,
+              type=click.IntRange(min=1),
+              help=("Number of files read concurrently."))
+@click.option('--ordered/--unordered',
+              default=True,
+              help=("Emit the files in the order given, or each file as soon as it has been read."))
+@click.option('--filter_null',
+              default=True,
+              type=bool,
+              help=("Whether or not to filter rows with null 'data' column. Null values in the 'data' column can "
+                    "cause issues down the line with processing. Setting this to True is recommended."))
+@prepare_command()
+def from_files(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    from morpheus.stages.input.multi_file_source_stage import MultiFileSourceStage
+
+    file_type = str_to_file_type(kwargs.pop("file_type").lower())
+
+    stage = MultiFileSourceStage(config, file_type=file_type, **kwargs)
+
+    p.set_source(stage)
+
+    return stage
+
+
 @click.command(short_help="Load messages from a Kafka cluster", **command_kwargs)
 @click.option('--bootstrap_servers',
               type=str,
@@ -603,7 +717,12 @@ def from_file(ctx: click.Context, **kwargs):
               required=True,
               help=("Comma-separated list of bootstrap servers. If using Kafka created via `docker-compose`, "
                     "this can be set to 'auto' to automatically determine the cluster IPs and ports"))
-@click.option('--input_topic', type=str, default="test_pcap", required=True, help="Kafka topic to read from")
+@click.option('--input_topic',
+              type=str,
+              default="test_pcap",
+              required=True,
+              help=("Kafka topic to read from. Several topics can be given separated by commas, topics starting with "
+                    "'^' are regular expressions. Several topics require the C++ implementation."))
 @click.option('--group_id', type=str, default="custreamz", required=True, help="")
 @click.option('--poll_interval',
               type=str,
@@ -618,6 +737,87 @@ def from_file(ctx: click.Context, **kwargs):
               is_flag=True,
               help=("Enabling this option will skip pre-filtering of json messages. "
                     "This is only useful when inputs are known to be valid json."))
+@click.option("--max_batch_bytes",
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Maximum number of message payload bytes accumulated per batch by the C++ implementation. "
+                    "A value of 0 disables the limit."))
+@click.option("--adaptive_batching",
+              is_flag=True,
+              help=("Enabling this option lets the C++ implementation grow the batch size up to `pipeline_batch_size` "
+                    "while downstream stages apply backpressure, and shrink it again when they keep up."))
+@click.option("--commit_on_completion",
+              is_flag=True,
+              help=("Enabling this option lets the C++ implementation commit the offsets of a batch only once every "
+                    "message created from it has been released by the pipeline, so a crash only replays unfinished "
+                    "batches."))
+@click.option("--topic_column",
+              type=str,
+              default=None,
+              help=("Name of a column added to every row holding the topic it was read from."))
+@click.option("--start_timestamp_ms",
+              type=click.IntRange(min=0),
+              default=None,
+              help=("Replay from the first message stamped at or after this time, in milliseconds since the epoch, "
+                    "instead of the committed offsets. Disables commits. Requires the C++ implementation."))
+@click.option("--start_offset",
+              "start_offsets",
+              type=str,
+              multiple=True,
+              help=("Replay a partition from an explicit offset, given as 'topic:partition=offset'. Can be repeated. "
+                    "Disables commits. Requires the C++ implementation."))
+@click.option("--stop_timestamp_ms",
+              type=click.IntRange(min=0),
+              default=None,
+              help=("Stop each partition at the first message stamped at or after this time, in milliseconds since "
+                    "the epoch, and end the pipeline once every partition stopped. Disables commits. Requires the "
+                    "C++ implementation."))
+@click.option("--device_id",
+              type=click.IntRange(min=0),
+              default=None,
+              help=("Bind the threads consuming and parsing partitions to the NUMA node closest to this GPU and use "
+                    "it as their CUDA device. Requires the C++ implementation."))
+@click.option("--drop_null_column",
+              type=str,
+              default=None,
+              help=("Drop rows where this column is null while each batch is read, instead of adding a separate "
+                    "'dropna' stage."))
+@click.option("--schema",
+              multiple=True,
+              callback=_parse_column_types,
+              help=("Column type, as NAME=TYPE like 'count=int64', used when reading each batch instead of inferring "
+                    "the types. Types are bool, str, or an int, uint or float type. Can be repeated."))
+@click.option("--schema_batches",
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Learn the schema from this many batches and then freeze it, when --schema is not given. "
+                    "Requires the C++ implementation."))
+@click.option("--message_format",
+              type=click.Choice(["json", "avro", "avro-confluent"], case_sensitive=False),
+              default="json",
+              help=("Format of the message payloads. 'avro' reads bare Avro datums written with --avro_schema_file, "
+                    "'avro-confluent' reads datums framed by the Confluent serializer. Avro requires the C++ "
+                    "implementation."))
+@click.option("--avro_schema_file",
+              type=click.Path(exists=True, dir_okay=False),
+              default=None,
+              help=("File holding the writer schema of Avro payloads, as Avro JSON. Used for every schema id of "
+                    "'avro-confluent' payloads when --schema_registry_url is not given."))
+@click.option("--schema_registry_url",
+              type=str,
+              default=None,
+              help="Confluent schema registry used to look up the writer schemas of 'avro-confluent' payloads.")
+@click.option("--metadata_column",
+              "metadata_columns",
+              multiple=True,
+              type=click.Choice(["_key", "_ts", "_partition", "_offset"]),
+              help=("Add a column filled from the metadata of each message, its key, timestamp, partition or offset. "
+                    "Can be repeated. Requires the C++ implementation."))
+@click.option("--max_in_flight_batches",
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Pause fetching for partitions once this many emitted batches are still held downstream, and "
+                    "resume once half of them were released. 0 disables. Requires the C++ implementation."))
 @prepare_command()
 def from_kafka(ctx: click.Context, **kwargs):
 
@@ -627,6 +827,25 @@ def from_kafka(ctx: click.Context, **kwargs):
     if ("bootstrap_servers" in kwargs and kwargs["bootstrap_servers"] == "auto"):
         kwargs["bootstrap_servers"] = auto_determine_bootstrap()
 
+    start_offsets = {}
+
+    for start_offset in kwargs.get("start_offsets", ()):
+        (partition, sep, offset) = start_offset.rpartition("=")
+
+        if (not sep or not offset.lstrip("-").isdigit()):
+            raise click.BadParameter("Expected 'topic:partition=offset', got '{}'".format(start_offset),
+                                     param_hint="--start_offset")
+
+        start_offsets[partition] = int(offset)
+
+    kwargs["start_offsets"] = start_offsets
+
+    avro_schema_file = kwargs.pop("avro_schema_file", None)
+
+    if (avro_schema_file is not None):
+        with open(avro_schema_file, "r") as f:
+            kwargs["avro_schema"] = f.read()
+
     from morpheus.stages.input.kafka_source_stage import KafkaSourceStage
 
     stage = KafkaSourceStage(config, **kwargs)
@@ -636,6 +855,75 @@ def from_kafka(ctx: click.Context, **kwargs):
     return stage
 
 
+@click.command(short_help="Generate synthetic load at a target rate from the rows of a file", **command_kwargs)
+@click.option('--filename', type=click.Path(exists=True, dir_okay=False), required=True, help="Template file")
+@click.option('--rows_per_second',
+              type=click.FloatRange(min=0),
+              default=0,
+              help="Target rate in rows per second, 0 emits batches as fast as the pipeline accepts them")
+@click.option('--batch_size',
+              type=click.IntRange(min=1),
+              default=None,
+              help="Mean number of rows per batch. Defaults to pipeline_batch_size")
+@click.option('--distribution',
+              type=click.Choice(["fixed", "uniform", "exponential"], case_sensitive=False),
+              default="fixed",
+              help="Distribution of the batch sizes")
+@click.option('--jitter',
+              type=click.FloatRange(min=0, max=1),
+              default=0,
+              help="Fraction of its own interval by which each batch is randomly early or late")
+@click.option('--mutate_column',
+              'mutate_columns',
+              type=str,
+              multiple=True,
+              help="String column made unique in every batch. May be given multiple times")
+@click.option('--total_rows', type=click.IntRange(min=0), default=0, help="Rows to emit, 0 for no limit")
+@click.option('--duration_sec', type=click.FloatRange(min=0), default=0, help="Seconds to run for, 0 for no limit")
+@click.option('--trace_all', is_flag=True, help="Trace every batch rather than following the trace sample interval")
+@click.option('--seed', type=click.IntRange(min=0), default=0, help="Random seed, 0 picks a random seed")
+@prepare_command()
+def from_load_generator(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    from morpheus.stages.input.load_generator_source_stage import LoadGeneratorSourceStage
+
+    kwargs["distribution"] = kwargs["distribution"].lower()
+
+    stage = LoadGeneratorSourceStage(config, **kwargs)
+
+    p.set_source(stage)
+
+    return stage
+
+
+@click.command(short_help="Receive messages sent by the to-ucx stage of other pipelines", **command_kwargs)
+@click.option('--port', type=click.IntRange(min=1, max=65535), required=True, help="Port to listen on")
+@click.option('--address',
+              type=str,
+              default="0.0.0.0",
+              help="Local address to listen on, '0.0.0.0' listens on every interface")
+@click.option('--num_senders',
+              type=click.IntRange(min=1),
+              default=1,
+              help="Number of sending pipelines, the source completes once all of them have completed")
+@prepare_command()
+def from_ucx(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    from morpheus.stages.input.ucx_source_stage import UcxSourceStage
+
+    stage = UcxSourceStage(config, **kwargs)
+
+    p.set_source(stage)
+
+    return stage
+
+
 @click.command(short_help="Load messages from a Cloudtrail directory", **command_kwargs)
 @click.option('--input_glob',
               type=str,
@@ -705,6 +993,11 @@ def from_cloudtrail(ctx: click.Context, **kwargs):
                     "message is received. Otherwise, the progress bar is shown on pipeline startup and "
                     "will begin timing immediately. In large pipelines, this option may be desired to "
                     "give a more accurate timing."))
+@click.option('--log_interval_ms',
+              type=click.IntRange(min=0),
+              default=1000,
+              help=("C++ stage only. Interval in milliseconds between progress lines, 0 disables the console "
+                    "output"))
 @prepare_command()
 def monitor(ctx: click.Context, **kwargs):
 
@@ -720,8 +1013,19 @@ def monitor(ctx: click.Context, **kwargs):
     return stage
 
 
-@click.command(short_help="Buffer results", deprecated=True, **command_kwargs)
-@click.option('--count', type=int, default=1000, help="")
+@click.command(short_help="Buffer results, spilling them to host memory over a device memory budget",
+               **command_kwargs)
+@click.option('--count', type=click.IntRange(min=1), default=1000, help="Most messages held at once")
+@click.option('--device_memory_budget',
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Bytes of device memory the held tables may use before new messages are spilled to pinned host "
+                    "memory. 0 disables spilling and the stage is a pass through"))
+@click.option('--host_memory_budget',
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Bytes of pinned host memory spilled messages may use before the upstream is blocked. "
+                    "0 is unlimited"))
 @prepare_command()
 def buffer(ctx: click.Context, **kwargs):
 
@@ -737,6 +1041,138 @@ def buffer(ctx: click.Context, **kwargs):
     return stage
 
 
+@click.command(short_help="Emit rows by priority lane and shed low priority lanes under overload", **command_kwargs)
+@click.option('--key_column', type=str, required=True, help="Column holding the value rows are classified by.")
+@click.option('--lane',
+              'lanes',
+              type=str,
+              multiple=True,
+              required=True,
+              help=("Key value of a priority lane, highest priority first. Can be repeated. Rows matching no lane "
+                    "go to a last, lowest priority lane"))
+@click.option('--lane_capacity',
+              type=click.IntRange(min=1),
+              default=16,
+              help="Number of messages each lane queues at most")
+@click.option('--protected_lanes',
+              type=click.IntRange(min=0),
+              default=1,
+              help="Number of highest priority lanes which are never shed")
+@click.option('--latency_slo_ms',
+              type=int,
+              default=0,
+              help=("Longest time in milliseconds a message of a lane which is not protected may wait before being "
+                    "shed. Values less than or equal to 0 only shed messages when their lane is full"))
+@click.option('--shed_policy',
+              type=click.Choice(["drop", "sample"], case_sensitive=False),
+              default="drop",
+              help="Whether late messages are all dropped, or sampled keeping --sample_fraction of them")
+@click.option('--sample_fraction',
+              type=click.FloatRange(min=0.0, max=1.0),
+              default=0.1,
+              help="Fraction of the late messages emitted by the 'sample' policy")
+@prepare_command()
+def admission(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    from morpheus.stages.general.admission_stage import AdmissionStage
+
+    stage = AdmissionStage(config, **kwargs)
+
+    p.add_stage(stage)
+
+    return stage
+
+
+@click.command(short_help="Merge small messages into larger batches", **command_kwargs)
+@click.option('--batch_size',
+              type=click.IntRange(min=1),
+              default=None,
+              help=("Number of rows to merge into each message. Defaults to the pipeline batch size"))
+@click.option('--timeout_ms',
+              type=int,
+              default=100,
+              help=("Longest time in milliseconds a message is held waiting for more rows. "
+                    "Values less than or equal to 0 disable the timeout"))
+@prepare_command()
+def coalesce(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    from morpheus.stages.general.coalesce_stage import CoalesceStage
+
+    stage = CoalesceStage(config, **kwargs)
+
+    p.add_stage(stage)
+
+    return stage
+
+
+@click.command(short_help="Take rows matching known benign patterns out of the inference path", **command_kwargs)
+@click.option('--column', type=str, required=True, help="String column the patterns and literals are evaluated against")
+@click.option('--pattern',
+              'patterns',
+              type=str,
+              multiple=True,
+              help="Regular expression, rows whose value contains a match are taken out. Can be repeated")
+@click.option('--literal',
+              'literals',
+              type=str,
+              multiple=True,
+              help="Value, rows exactly equal to it are taken out. Can be repeated")
+@click.option('--label_column',
+              'label_columns',
+              type=str,
+              multiple=True,
+              help=("Label column set to false in the rows taken out. Can be repeated. Defaults to the labels of the "
+                    "pipeline"))
+@prepare_command()
+def prefilter(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    if (len(kwargs.get("patterns", ())) == 0 and len(kwargs.get("literals", ())) == 0):
+        raise click.BadParameter("At least one --pattern or --literal is required")
+
+    if (len(kwargs.get("label_columns", ())) == 0):
+        # Falls back on the labels of the pipeline
+        kwargs.pop("label_columns", None)
+
+    from morpheus.stages.general.prefilter_stage import PrefilterStage
+
+    stage = PrefilterStage(config, **kwargs)
+
+    p.add_stage(stage)
+
+    return stage
+
+
+@click.command(short_help="Merge the rows taken out by the last prefilter stage back in", **command_kwargs)
+@prepare_command()
+def prefilter_merge(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    from morpheus.stages.general.prefilter_merge_stage import PrefilterMergeStage
+    from morpheus.stages.general.prefilter_stage import PrefilterStage
+
+    prefilters = [stage for stage in p._linear_stages if isinstance(stage, PrefilterStage)]
+
+    if (len(prefilters) == 0):
+        raise click.UsageError("prefilter-merge must come after a prefilter stage")
+
+    stage = PrefilterMergeStage(config, prefilters[-1], **kwargs)
+
+    p.add_stage(stage)
+
+    return stage
+
+
 @click.command(short_help="Drop null data entries from a DataFrame", **command_kwargs)
 @click.option('--column', type=str, default="data", help="Which column to use when searching for null values.")
 @prepare_command()
@@ -895,6 +1331,11 @@ def preprocess_fil(ctx: click.Context, **kwargs):
 
 
 @click.command(name="preprocess", short_help="Convert messages to tokens", **command_kwargs)
+@click.option('--scaling_file',
+              type=click.Path(exists=True, dir_okay=False),
+              default=None,
+              help=("JSON file of per-feature mean/std or min/max statistics. When set, features are normalized with "
+                    "these statistics instead of by the model, allowing the stage to run in C++."))
 @prepare_command()
 def preprocess_ae(ctx: click.Context, **kwargs):
 
@@ -912,7 +1353,11 @@ def preprocess_ae(ctx: click.Context, **kwargs):
 
 @click.command(short_help="Perform inference with Triton", **command_kwargs)
 @click.option('--model_name', type=str, required=True, help="Model name in Triton to send messages to")
-@click.option('--server_url', type=str, required=True, help="Triton server URL (IP:Port)")
+@click.option('--server_url',
+              type=str,
+              required=True,
+              help=("Triton server URL (IP:Port). The C++ stage accepts a comma separated list of servers hosting the "
+                    "same model and balances requests across them."))
 @click.option('--force_convert_inputs',
               default=False,
               type=bool,
@@ -925,6 +1370,46 @@ def preprocess_ae(ctx: click.Context, **kwargs):
               help=("Whether or not to use CUDA Shared IPC Memory for transferring data to Triton. "
                     "Using CUDA IPC reduces network transfer time but requires that Morpheus and Triton are "
                     "located on the same machine"))
+@click.option("--max_concurrent_requests",
+              type=click.IntRange(min=1),
+              default=1,
+              help=("Maximum number of requests the C++ stage keeps in flight with Triton. Values greater than 1 "
+                    "send requests asynchronously to overlap data transfer with inference."))
+@click.option("--protocol",
+              type=click.Choice(["http", "grpc"], case_sensitive=False),
+              default="http",
+              help=("Protocol used by the C++ stage to communicate with Triton. Ensure the port in `--server_url` "
+                    "matches the protocol."))
+@click.option("--length_bucketing",
+              type=bool,
+              default=False,
+              help=("Sort rows by token length and send each request with the shortest sequence length that fits, "
+                    "reducing padding. Requires a model with a dynamic sequence dimension. C++ stage only."))
+@click.option("--device_id",
+              type=click.IntRange(min=0),
+              default=None,
+              help=("Bind the threads of the C++ stage to the NUMA node closest to this GPU and use it as their CUDA "
+                    "device. C++ stage only."))
+@click.option("--batch_timeout_ms",
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Time a message smaller than the model's max batch size waits to be combined with the following "
+                    "messages into a single request. 0 sends every message on its own. C++ stage only."))
+@click.option("--cache_size",
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Number of distinct rows whose outputs are kept on the GPU. Rows with the same inputs as a cached "
+                    "row are not sent to Triton. 0 disables the cache. C++ stage only."))
+@click.option("--window_reduction",
+              type=click.Choice(["max", "mean"], case_sensitive=False),
+              default="max",
+              help=("How the outputs of the overlapping token windows of a long message are merged back into a "
+                    "single row. C++ stage only."))
+@click.option("--warmup",
+              type=bool,
+              default=False,
+              help=("Send a batch of zeros with the model's max batch size when the stage starts, so the first real "
+                    "batch does not pay for cold allocations. C++ stage only."))
 @prepare_command()
 def inf_triton(ctx: click.Context, **kwargs):
 
@@ -956,6 +1441,26 @@ def inf_identity(ctx: click.Context, **kwargs):
     return stage
 
 
+@click.command(name="inf-forest", short_help="Perform in-process inference with a tree model", **command_kwargs)
+@click.option('--model_filename',
+              type=click.Path(exists=True, dir_okay=False),
+              required=True,
+              help="XGBoost model saved in JSON format, i.e. with `Booster.save_model(\"model.json\")`")
+@prepare_command()
+def inf_forest(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    from morpheus.stages.inference.forest_inference_stage import ForestInferenceStage
+
+    stage = ForestInferenceStage(config, **kwargs)
+
+    p.add_stage(stage)
+
+    return stage
+
+
 @click.command(name="inf-pytorch", short_help="Perform inference with PyTorch", **command_kwargs)
 @click.option('--model_filename',
               type=click.Path(exists=True, dir_okay=False),
@@ -1006,6 +1511,11 @@ def inf_pytorch_ae(ctx: click.Context, **kwargs):
               default="",
               help=("Prefix to add to each label. Allows adding labels different from the "
                     "Config.class_labels property"))
+@click.option('--filter_threshold',
+              type=float,
+              default=None,
+              help=("Also filter out rows without any probability above this level, replacing a following `filter` "
+                    "stage. Labels and detections are then computed in a single pass"))
 @prepare_command()
 def add_class(ctx: click.Context, **kwargs):
 
@@ -1069,6 +1579,11 @@ def add_scores(ctx: click.Context, **kwargs):
               default=0.5,
               required=True,
               help=("All messages without a probability above this threshold will be filtered away"))
+@click.option('--copy',
+              type=bool,
+              default=False,
+              help=("Copy the detected rows into a single new message instead of emitting a slice for each contiguous "
+                    "run of detections. Avoids many small messages when detections are sparse"))
 @prepare_command()
 def filter_command(ctx: click.Context, **kwargs):
 
@@ -1256,6 +1771,11 @@ def timeseries(ctx: click.Context, **kwargs):
               default=0.05,
               required=True,
               help="Relative tolerance to use when comparing float columns.")
+@click.option('--max_mismatch_samples',
+              type=click.IntRange(min=0),
+              default=20,
+              help=("C++ stage only. Most mismatched rows written, with their expected and actual values, "
+                    "to the results."))
 @prepare_command()
 def validate(ctx: click.Context, **kwargs):
 
@@ -1274,6 +1794,34 @@ def validate(ctx: click.Context, **kwargs):
 @click.command(short_help="Write all messages to a file", **command_kwargs)
 @click.option('--filename', type=click.Path(writable=True), required=True, help="The file to write to")
 @click.option('--overwrite', is_flag=True, help="Whether or not to overwrite the target file")
+@click.option('--compression',
+              type=click.Choice(["none", "snappy", "lz4", "zstd", "gzip"], case_sensitive=False),
+              default=None,
+              help=("Compression codec. PARQUET and ORC support 'none' and 'snappy', ARROW supports 'none', 'lz4' and "
+                    "'zstd'. CSV and JSON support 'none', 'gzip' and 'zstd', compressed on the GPU with nvCOMP. "
+                    "Defaults to the writer's default"))
+@click.option('--queue_size',
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Number of formatted CSV/JSON messages queued for a dedicated writer thread. "
+                    "0 writes synchronously"))
+@click.option('--flush_policy',
+              type=click.Choice(["none", "flush", "fsync"], case_sensitive=False),
+              default="flush",
+              help="When queued writes are handed to the OS. Only used when --queue_size is greater than 0")
+@click.option('--rotate_bytes',
+              type=click.IntRange(min=0),
+              default=0,
+              help=("Start a new file once the current one holds this many bytes. The filename may contain "
+                    "{index} and {timestamp} placeholders. 0 disables size based rotation"))
+@click.option('--rotate_seconds',
+              type=click.IntRange(min=0),
+              default=0,
+              help="Start a new file once the current one has been open this many seconds. 0 disables it")
+@click.option('--rotate_compression',
+              type=click.Choice(["none", "gzip"], case_sensitive=False),
+              default=None,
+              help="Compress every finished file in the background")
 @prepare_command()
 def to_file(ctx: click.Context, **kwargs):
 
@@ -1315,13 +1863,42 @@ def to_kafka(ctx: click.Context, **kwargs):
     return stage
 
 
-@click.command(short_help="Write out vizualization data frames", deprecated=True, **command_kwargs)
+@click.command(short_help="Send all messages to the from-ucx source of another pipeline", **command_kwargs)
+@click.option('--host', type=str, required=True, help="Host of the receiving pipeline")
+@click.option('--port',
+              type=click.IntRange(min=1, max=65535),
+              required=True,
+              help="Port the receiving pipeline listens on")
+@prepare_command()
+def to_ucx(ctx: click.Context, **kwargs):
+
+    config = get_config_from_ctx(ctx)
+    p = get_pipeline_from_ctx(ctx)
+
+    from morpheus.stages.output.write_to_ucx_stage import WriteToUcxStage
+
+    stage = WriteToUcxStage(config, **kwargs)
+
+    p.add_stage(stage)
+
+    return stage
+
+
+@click.command(short_help="Write out vizualization data frames", **command_kwargs)
 @click.option('--out_dir',
               type=click.Path(dir_okay=True, file_okay=False),
               default="./viz_frames",
               required=True,
               help="")
 @click.option('--overwrite', is_flag=True, help="")
+@click.option('--frame_type',
+              type=click.Choice(["csv", "arrow"], case_sensitive=False),
+              default="csv",
+              help="Format of the frames. Arrow frames are written by the C++ stage when C++ execution is enabled.")
+@click.option('--out_socket',
+              type=str,
+              default=None,
+              help="Stream arrow frames to this 'host:port' instead of writing files. Requires C++ execution.")
 @prepare_command()
 def gen_viz(ctx: click.Context, **kwargs):
 
@@ -1345,44 +1922,61 @@ run.add_command(pipeline_ae)
 # NLP Pipeline
 pipeline_nlp.add_command(add_class)
 pipeline_nlp.add_command(add_scores)
+pipeline_nlp.add_command(admission)
 pipeline_nlp.add_command(buffer)
+pipeline_nlp.add_command(coalesce)
 pipeline_nlp.add_command(delay)
 pipeline_nlp.add_command(deserialize)
 pipeline_nlp.add_command(dropna)
 pipeline_nlp.add_command(filter_command)
 pipeline_nlp.add_command(from_file)
+pipeline_nlp.add_command(from_files)
 pipeline_nlp.add_command(from_kafka)
+pipeline_nlp.add_command(from_load_generator)
+pipeline_nlp.add_command(from_ucx)
 pipeline_nlp.add_command(gen_viz)
 pipeline_nlp.add_command(inf_identity)
 pipeline_nlp.add_command(inf_pytorch)
 pipeline_nlp.add_command(inf_triton)
 pipeline_nlp.add_command(mlflow_drift)
 pipeline_nlp.add_command(monitor)
+pipeline_nlp.add_command(prefilter)
+pipeline_nlp.add_command(prefilter_merge)
 pipeline_nlp.add_command(preprocess_nlp)
 pipeline_nlp.add_command(serialize)
 pipeline_nlp.add_command(to_file)
 pipeline_nlp.add_command(to_kafka)
+pipeline_nlp.add_command(to_ucx)
 pipeline_nlp.add_command(validate)
 
 # FIL Pipeline
 pipeline_fil.add_command(add_class)
 pipeline_fil.add_command(add_scores)
+pipeline_fil.add_command(admission)
 pipeline_fil.add_command(buffer)
+pipeline_fil.add_command(coalesce)
 pipeline_fil.add_command(delay)
 pipeline_fil.add_command(deserialize)
 pipeline_fil.add_command(dropna)
 pipeline_fil.add_command(filter_command)
 pipeline_fil.add_command(from_file)
+pipeline_fil.add_command(from_files)
 pipeline_fil.add_command(from_kafka)
+pipeline_fil.add_command(from_load_generator)
+pipeline_fil.add_command(from_ucx)
+pipeline_fil.add_command(inf_forest)
 pipeline_fil.add_command(inf_identity)
 pipeline_fil.add_command(inf_pytorch)
 pipeline_fil.add_command(inf_triton)
 pipeline_fil.add_command(mlflow_drift)
 pipeline_fil.add_command(monitor)
+pipeline_fil.add_command(prefilter)
+pipeline_fil.add_command(prefilter_merge)
 pipeline_fil.add_command(preprocess_fil)
 pipeline_fil.add_command(serialize)
 pipeline_fil.add_command(to_file)
 pipeline_fil.add_command(to_kafka)
+pipeline_fil.add_command(to_ucx)
 pipeline_fil.add_command(validate)
 
 # AE Pipeline
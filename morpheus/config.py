@@ -22,6 +22,8 @@ import os
 import typing
 from enum import Enum
 
+import numpy as np
+
 logger = logging.getLogger(__name__)
 
 
@@ -185,9 +187,48 @@ class Config(ConfigBase):
         The size of buffered channels to use between nodes in a pipeline. Larger values reduce backpressure at the cost
         of memory. Smaller values will push messages through the pipeline quicker. Must be greater than 1 and a power of
         2 (i.e., 2, 4, 8, 16, etc.).
+    device_memory_resource : str, default = "pool"
+        Device memory resource C++ stages allocate their buffers from. One of "cuda" (allocate and free every buffer
+        directly), "pool" or "arena". Only used when C++ is enabled.
+    device_pool_initial_size : int, default = 256 MiB
+        Initial size of the device memory pool in bytes, 0 uses the RMM default of half the device memory. Only used
+        when `device_memory_resource` is "pool".
+    device_pool_maximum_size : int, default = 0
+        Size in bytes the device memory pool may grow to, 0 for no limit. Only used when `device_memory_resource` is
+        "pool".
+    device_timing : bool, default = False
+        Whether to time annotated device operations in C++ stages with CUDA events. Requires the library to be built
+        with `MORPHEUS_ENABLE_DEVICE_ANNOTATIONS`, the timings are logged when the pipeline completes.
+    fuse_cpp_stages : bool, default = False
+        Whether to run each chain of consecutive C++ stages as a single node. Messages are then passed from one stage to
+        the next by a direct call rather than through a channel. Only used when C++ is enabled.
+    num_gpus : int, default = 1
+        Number of GPUs to spread C++ stages across. When greater than 1, chains of consecutive C++ stages are fused and
+        each GPU runs its own instance of every chain, with its own device memory pool, on the messages it pulls from
+        the shared input. Messages leave a chain in the order they complete, not the order they arrived. Every pair of
+        GPUs must support peer access, building the pipeline fails otherwise. Only used when C++ is enabled.
+    output_columns : typing.Dict[str, str], default = {}
+        Output columns, mapping names to numpy types like 'float32', which the C++ sources of this pipeline create in
+        every message. Stages writing these columns then never change the schema of the table, which would rebuild it
+        or, once the table is in Python, acquire the GIL. `AddClassificationsStage` adds its label columns here, the
+        type of the `AddScoresStage` columns follows the model and must be added explicitly.
     use_cpp : bool, default = True
         Whether or not to use C++ node and message types or to prefer Python. Only use as a last resort if bugs are
         encountered.
+    trace_sample_interval : int, default = 0
+        Trace one in every `trace_sample_interval` messages created by the C++ file and Kafka sources, 0 disables
+        tracing. Traced messages record the time spent in each C++ stage, and the time since their source timestamp
+        is exported by `stage_metrics_prometheus` as the `morpheus_stage_source_latency_seconds` histogram. Only used
+        when C++ is enabled.
+    cuda_graphs : bool, default = False
+        Replay the fixed-shape kernel sequences of the C++ FIL and AE preprocessing stages as CUDA Graphs, one per
+        batch size, reducing launch overhead for small batches. Sequences which cannot be captured run as before. Only
+        used when C++ is enabled.
+    drain_timeout : float, default = 0
+        Seconds the pipeline gets to drain when it receives SIGINT or SIGTERM. The C++ sources stop consuming, the rest
+        of the pipeline finishes what they already emitted and Kafka sources commit the final offsets, then the
+        pipeline exits. Work still in flight at the deadline is abandoned. 0 stops the pipeline immediately. Only used
+        when C++ is enabled.
 
     Attributes
     ----------
@@ -209,6 +250,17 @@ class Config(ConfigBase):
     num_threads: int = 1
     model_max_batch_size: int = 8
     edge_buffer_size: int = 128
+    device_memory_resource: str = "pool"
+    device_pool_initial_size: int = 256 * 1024 * 1024
+    device_pool_maximum_size: int = 0
+    device_timing: bool = False
+    fuse_cpp_stages: bool = False
+    num_gpus: int = 1
+    trace_sample_interval: int = 0
+    cuda_graphs: bool = False
+    drain_timeout: float = 0
+
+    output_columns: typing.Dict[str, str] = dataclasses.field(default_factory=dict)
 
     # Class labels to convert class index to label.
     class_labels: typing.List[str] = dataclasses.field(default_factory=list)
@@ -229,6 +281,12 @@ class Config(ConfigBase):
         with open(filename, "w") as f:
             json.dump(dataclasses.asdict(self), f, indent=3, sort_keys=True)
 
+    def output_column_types(self) -> typing.Dict[str, str]:
+        """
+        Returns `output_columns` with every type as a numpy type string, like '<f4', as taken by the C++ sources.
+        """
+        return {name: np.dtype(dtype).str for name, dtype in self.output_columns.items()}
+
     def to_string(self):
         """Get string representation of Config.
 
@@ -25,9 +25,12 @@ from tqdm import tqdm
 
 import cudf
 
+import morpheus._lib.common as neoc
 from morpheus.config import Config
+from morpheus.config import CppConfig
 from morpheus.pipeline.receiver import Receiver
 from morpheus.pipeline.sender import Sender
+from morpheus.pipeline.single_port_stage import SinglePortStage
 from morpheus.pipeline.source_stage import SourceStage
 from morpheus.pipeline.stage import Stage
 from morpheus.pipeline.stream_wrapper import StreamWrapper
@@ -66,6 +69,17 @@ class Pipeline():
 
         self.batch_size = c.pipeline_batch_size
 
+        self._device_memory_resource = c.device_memory_resource
+        self._device_pool_initial_size = c.device_pool_initial_size
+        self._device_pool_maximum_size = c.device_pool_maximum_size
+        self._device_timing = c.device_timing
+        self._fuse_cpp_stages = c.fuse_cpp_stages
+        self._num_gpus = c.num_gpus
+        self._trace_sample_interval = c.trace_sample_interval
+        self._cuda_graphs = c.cuda_graphs
+        self._drain_timeout = c.drain_timeout
+        self._drain_watcher: asyncio.Task = None
+
         self._graph = networkx.DiGraph()
 
         self._is_built = False
@@ -140,6 +154,24 @@ class Pipeline():
 
         logger.info("====Registering Pipeline====")
 
+        if (CppConfig.get_should_use_cpp()):
+            # Installed before any stage is built so every C++ allocation comes from the configured resource
+            neoc.configure_device_memory(self._device_memory_resource,
+                                         initial_pool_bytes=self._device_pool_initial_size,
+                                         maximum_pool_bytes=self._device_pool_maximum_size,
+                                         device_ids=list(range(self._num_gpus)) if self._num_gpus > 1 else [])
+
+            if (self._device_timing and not neoc.device_annotations_enabled):
+                logger.warning("Device timing was requested but Morpheus was built without "
+                               "MORPHEUS_ENABLE_DEVICE_ANNOTATIONS, no device operations will be timed")
+
+            neoc.set_device_timing_enabled(self._device_timing)
+            neoc.set_trace_sample_interval(self._trace_sample_interval)
+            neoc.set_cuda_graphs_enabled(self._cuda_graphs)
+
+            # Clears a drain of a previous pipeline run in this process
+            neoc.reset_drain()
+
         self._neo_executor = neo.Executor(self._exec_options)
 
         self._neo_pipeline = neo.Pipeline()
@@ -150,6 +182,10 @@ class Pipeline():
             # Get the list of stages and source
             source_and_stages: typing.List[StreamWrapper] = list(self._sources) + list(self._stages)
 
+            # Stages are spread across GPUs one fused chain at a time
+            if ((self._fuse_cpp_stages or self._num_gpus > 1) and CppConfig.get_should_use_cpp()):
+                self._fuse_stages()
+
             # Now loop over stages
             for s in source_and_stages:
 
@@ -187,6 +223,54 @@ class Pipeline():
 
         logger.info("====Registering Pipeline Complete!====")
 
+    def _fuse_stages(self):
+        """
+        Finds every chain of fusable C++ stages where each stage is the only input of the next one, and marks the
+        stages of each chain to be built as a single node. Chains need two or more stages, unless the stages are
+        spread across several GPUs, in which case single stages are wrapped as well.
+        """
+
+        def can_fuse(stage: StreamWrapper) -> bool:
+            return isinstance(stage, SinglePortStage) and stage.supports_fusion()
+
+        def next_in_chain(stage: StreamWrapper) -> typing.Optional[SinglePortStage]:
+            output_stages = stage.get_all_output_stages()
+
+            if (len(output_stages) != 1):
+                return None
+
+            next_stage = output_stages[0]
+
+            if (not can_fuse(next_stage) or len(next_stage.get_all_input_stages()) != 1):
+                return None
+
+            return next_stage
+
+        for stage in self._stages:
+            if (not can_fuse(stage)):
+                continue
+
+            input_stages = stage.get_all_input_stages()
+
+            if (len(input_stages) == 1 and can_fuse(input_stages[0]) and next_in_chain(input_stages[0]) is stage):
+                # Continues the chain of the stage before it
+                continue
+
+            chain = [stage]
+            next_stage = next_in_chain(stage)
+
+            while (next_stage is not None and next_stage not in chain):
+                chain.append(next_stage)
+                next_stage = next_in_chain(next_stage)
+
+            if (len(chain) < 2 and self._num_gpus <= 1):
+                continue
+
+            for chained_stage in chain:
+                chained_stage._fused_stages = chain
+
+            logger.info("Fusing stages: %s", " -> ".join(chained_stage.unique_name for chained_stage in chain))
+
     def start(self):
         assert self._is_built, "Pipeline must be built before starting"
 
@@ -206,6 +290,48 @@ class Pipeline():
 
         logger.info("====Pipeline Stopped====")
 
+    def drain(self, timeout: float):
+        """
+        Stops the sources from consuming and lets the rest of the pipeline finish the messages already emitted, then
+        stops the pipeline if it has not completed within `timeout` seconds. Progress of every C++ stage is logged
+        meanwhile. Returns immediately, await `join` to wait for the pipeline to exit. Must be called from the event
+        loop running the pipeline.
+
+        Parameters
+        ----------
+        timeout : float
+            Seconds the pipeline gets to drain.
+
+        """
+        if (not CppConfig.get_should_use_cpp()):
+            logger.warning("Draining requires the C++ implementation, stopping the pipeline instead")
+            self.stop()
+            return
+
+        logger.info("====Draining Pipeline====")
+
+        neoc.request_drain(int(timeout * 1000))
+
+        if (self._drain_watcher is None):
+            self._drain_watcher = asyncio.get_running_loop().create_task(self._watch_drain(timeout))
+
+    async def _watch_drain(self, timeout: float):
+
+        deadline = time.monotonic() + timeout
+
+        while (time.monotonic() < deadline):
+            await asyncio.sleep(min(1.0, max(deadline - time.monotonic(), 0)))
+
+            for name, status in sorted(neoc.drain_progress().items()):
+                logger.info("Draining %s: %s, %d in flight",
+                            name,
+                            "drained" if status.drained else "running",
+                            status.in_flight)
+
+        logger.warning("Pipeline did not drain within %.1f s, stopping it", timeout)
+
+        self.stop()
+
     async def join(self):
 
         await self._neo_executor.join_async()
@@ -223,6 +349,14 @@ class Pipeline():
         for s in list(self._stages):
             await s.join()
 
+        if (self._drain_watcher is not None):
+            # Only still running when the pipeline drained before the deadline
+            if (not self._drain_watcher.done()):
+                logger.info("====Pipeline Drained====")
+
+            self._drain_watcher.cancel()
+            self._drain_watcher = None
+
     def build_and_start(self):
 
         if (not self.is_built):
@@ -374,6 +508,43 @@ class Pipeline():
         with open(filename, "wb") as f:
             f.write(viz_binary)
 
+    def _log_device_memory_stats(self):
+
+        if (not CppConfig.get_should_use_cpp()):
+            return
+
+        for tag, stats in sorted(neoc.device_memory_stats().items()):
+            logger.info("Device memory for %s: %d allocations, %d bytes total, %d bytes peak, %d bytes in use",
+                        tag,
+                        stats.allocation_count,
+                        stats.total_bytes,
+                        stats.peak_bytes,
+                        stats.current_bytes)
+
+    def _log_stage_metrics(self):
+
+        if (not CppConfig.get_should_use_cpp()):
+            return
+
+        for name, metrics in sorted(neoc.stage_metrics().items()):
+            logger.info("Stage %s: %d messages (%d rows) in, %d messages (%d rows) out, %.3f s processing, "
+                        "%.3f s blocked on downstream",
+                        name,
+                        metrics.messages_in,
+                        metrics.rows_in,
+                        metrics.messages_out,
+                        metrics.rows_out,
+                        metrics.processing_ns * 1e-9,
+                        metrics.blocked_ns * 1e-9)
+
+        # Empty unless the library was built with MORPHEUS_ENABLE_DEVICE_ANNOTATIONS and timing was turned on
+        for name, stats in sorted(neoc.device_operation_stats().items()):
+            logger.info("Device operation %s: %d calls, %.3f ms total, %.3f ms max",
+                        name,
+                        stats.count,
+                        stats.total_ns * 1e-6,
+                        stats.max_ns * 1e-6)
+
     async def _do_run(self):
         """
         This function sets up the current asyncio loop, builds the pipeline, and awaits on it to complete.
@@ -397,7 +568,10 @@ class Pipeline():
             nonlocal exit_count
             exit_count = exit_count + 1
 
-            if (exit_count == 1):
+            if (exit_count == 1 and self._drain_timeout > 0):
+                tqdm.write("Draining pipeline. Please wait... Press Ctrl+C again to kill.")
+                self.drain(self._drain_timeout)
+            elif (exit_count == 1):
                 tqdm.write("Stopping pipeline. Please wait... Press Ctrl+C again to kill.")
                 self.stop()
             else:
@@ -426,6 +600,9 @@ class Pipeline():
             # Shutdown the async generator sources and exit
             logger.info("====Pipeline Complete====")
 
+            self._log_device_memory_stats()
+            self._log_stage_metrics()
+
     def run(self):
         """
         This function makes use of asyncio features to keep the pipeline running indefinitely.
@@ -19,6 +19,7 @@ from abc import abstractmethod
 import neo
 import typing_utils
 
+import morpheus._lib.stages as neos
 import morpheus.pipeline as _pipeline
 from morpheus.config import Config
 from morpheus.pipeline.stream_pair import StreamPair
@@ -42,6 +43,10 @@ class SinglePortStage(_pipeline.Stage):
 
         self._create_ports(1, 1)
 
+        # Set by the pipeline when `Config.fuse_cpp_stages` fuses this stage with its neighbours
+        self._fused_stages: typing.List["SinglePortStage"] = None
+        self._fused_output: StreamPair = None
+
     @abstractmethod
     def accepted_types(self) -> typing.Tuple:
         """
@@ -57,17 +62,96 @@ class SinglePortStage(_pipeline.Stage):
         """
         pass
 
+    def supports_fusion(self) -> bool:
+        """
+        Whether this stage builds a C++ node which can be fused with neighbouring C++ stages into a single node when
+        `Config.fuse_cpp_stages` is set. Stages returning True must implement `_build_fusable_node`.
+
+        Returns
+        -------
+        bool
+            True if the stage can be fused, False otherwise.
+        """
+        return False
+
+    def _check_input_type(self, input_type: type):
+        if (not typing_utils.issubtype(input_type, typing.Union[self.accepted_types()])):
+            raise RuntimeError("The {} stage cannot handle input of {}. Accepted input types: {}".format(
+                self.name, input_type, self.accepted_types()))
+
     def _pre_build(self) -> typing.List[StreamPair]:
         in_ports_pairs = super()._pre_build()
 
         # Check the types of all inputs
         for x in in_ports_pairs:
-            if (not typing_utils.issubtype(x[1], typing.Union[self.accepted_types()])):
-                raise RuntimeError("The {} stage cannot handle input of {}. Accepted input types: {}".format(
-                    self.name, x[1], self.accepted_types()))
+            self._check_input_type(x[1])
 
         return in_ports_pairs
 
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        """
+        Creates the C++ node of this stage without making any edges, returning it along with the output type. When the
+        stage is fused this is called while a `FusedStageBuilder` is capturing, so the node is only run as part of the
+        fused node.
+
+        :meta public:
+
+        Parameters
+        ----------
+        seg : `neo.Segment`
+            `neo.Segment` object for the pipeline.
+        input_type : type
+            Type of the messages the stage will receive.
+
+        Returns
+        -------
+        `morpheus.pipeline.pipeline.StreamPair`
+            The C++ node and the type of the messages it emits.
+        """
+        raise NotImplementedError("The {} stage does not support fusion".format(self.name))
+
+    def _build_fused(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
+        if (self._fused_output is not None):
+            # Already built by the first stage of the chain
+            return self._fused_output
+
+        builder = neos.FusedStageBuilder()
+        output_types = []
+        output_type = input_stream[1]
+        concurrency = 1
+
+        builder.begin_capture()
+
+        try:
+            for stage in self._fused_stages:
+                stage._check_input_type(output_type)
+
+                node, output_type = stage._build_fusable_node(seg, output_type)
+
+                concurrency = max(concurrency, node.concurrency)
+                output_types.append(output_type)
+        finally:
+            builder.end_capture()
+
+        num_gpus = self._config.num_gpus
+        device_ids = list(range(num_gpus)) if num_gpus > 1 else []
+
+        if (num_gpus > 1):
+            # Every GPU runs the same number of instances of the chain
+            concurrency = -(-concurrency // num_gpus) * num_gpus
+
+        fused_node = builder.build(seg,
+                                   "+".join(stage.unique_name for stage in self._fused_stages),
+                                   device_ids=device_ids)
+        fused_node.concurrency = concurrency
+
+        seg.make_edge(input_stream[0], fused_node)
+
+        for stage, stage_output_type in zip(self._fused_stages, output_types):
+            stage._fused_output = (fused_node, stage_output_type)
+
+        return self._fused_output
+
     @abstractmethod
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
         pass
@@ -81,6 +165,9 @@ class SinglePortStage(_pipeline.Stage):
 
         assert len(in_ports_streams) == 1, "Should only have 1 port on input"
 
+        if (self._fused_stages is not None):
+            return [self._build_fused(seg, in_ports_streams[0])]
+
         return [self._build_single(seg, in_ports_streams[0])]
 
     def _post_build_single(self, seg: neo.Segment, out_pair: StreamPair) -> StreamPair:
@@ -0,0 +1,134 @@
+# Copyright (c) 2021-2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import typing
+
+import neo
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.config import CppConfig
+from morpheus.messages import MultiMessage
+from morpheus.pipeline.multi_message_stage import MultiMessageStage
+from morpheus.pipeline.stream_pair import StreamPair
+
+logger = logging.getLogger(__name__)
+
+
+class AdmissionStage(MultiMessageStage):
+    """
+    This stage sorts the rows of each message into priority lanes by the value of `key_column` and emits the queued
+    messages highest priority first, so high priority rows overtake a backlog of low priority ones during a burst.
+    Place it after deserialization, ahead of the preprocessing and inference stages. Lane `i` holds the rows whose key
+    equals `lanes[i]`, a last lane holds every other row.
+
+    Lanes from `protected_lanes` on can be shed under overload: when their queue is full the oldest message is shed,
+    and a message which waited longer than `latency_slo_ms` is shed instead of being emitted. The rows shed from each
+    lane are reported by `shed_counts`. Requires the C++ implementation.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    key_column : str
+        Column holding the value rows are classified by, strings or integers.
+    lanes : typing.List[str]
+        Key values of the lanes, highest priority first.
+    lane_capacity : int, default = 16
+        Number of messages each lane queues at most.
+    protected_lanes : int, default = 1
+        Number of highest priority lanes which are never shed. A full protected lane blocks the input instead.
+    latency_slo_ms : int, default = 0
+        Longest time in milliseconds a message of a lane which is not protected may wait. Values less than or equal to
+        0 only shed messages when their lane is full.
+    shed_policy : str, default = "drop"
+        "drop" sheds every late message, "sample" still emits `sample_fraction` of them.
+    sample_fraction : float, default = 0.1
+        Fraction of the late messages emitted by the "sample" policy.
+
+    """
+
+    def __init__(self,
+                 c: Config,
+                 key_column: str,
+                 lanes: typing.List[str],
+                 lane_capacity: int = 16,
+                 protected_lanes: int = 1,
+                 latency_slo_ms: int = 0,
+                 shed_policy: str = "drop",
+                 sample_fraction: float = 0.1):
+        super().__init__(c)
+
+        self._key_column = key_column
+        self._lanes = [str(lane) for lane in lanes]
+        self._lane_capacity = lane_capacity
+        self._protected_lanes = protected_lanes
+        self._latency_slo_ms = latency_slo_ms
+        self._shed_policy = shed_policy
+        self._sample_fraction = sample_fraction
+
+        if (self._lane_capacity <= 0):
+            raise ValueError("AdmissionStage lane_capacity must be greater than 0")
+
+        if (self._shed_policy not in ("drop", "sample")):
+            raise ValueError("Unknown shed policy '{}'. Must be one of 'drop' or 'sample'".format(shed_policy))
+
+        if (not 0.0 <= self._sample_fraction <= 1.0):
+            raise ValueError("AdmissionStage sample_fraction must be between 0 and 1")
+
+        self._cpp_stage = None
+
+    @property
+    def name(self) -> str:
+        return "admission"
+
+    @property
+    def shed_counts(self) -> typing.List[int]:
+        """
+        Number of rows shed from each lane, in lane order, the lane of unmatched rows last.
+
+        """
+        if (self._cpp_stage is None):
+            return [0] * (len(self._lanes) + 1)
+
+        return list(self._cpp_stage.shed_counts)
+
+    def accepted_types(self) -> typing.Tuple:
+        """
+        Returns accepted input types for this stage.
+
+        """
+        return (MultiMessage, )
+
+    def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
+
+        if (not CppConfig.get_should_use_cpp()):
+            raise NotImplementedError("AdmissionStage requires the C++ implementation")
+
+        stream = neos.AdmissionStage(seg,
+                                     self.unique_name,
+                                     self._key_column,
+                                     self._lanes,
+                                     self._lane_capacity,
+                                     self._protected_lanes,
+                                     self._latency_slo_ms,
+                                     self._shed_policy,
+                                     self._sample_fraction)
+
+        self._cpp_stage = stream
+
+        seg.make_edge(input_stream[0], stream)
+
+        return stream, MultiMessage
@@ -17,7 +17,9 @@ import typing
 
 import neo
 
+import morpheus._lib.stages as neos
 from morpheus.config import Config
+from morpheus.messages import MessageMeta
 from morpheus.pipeline.single_port_stage import SinglePortStage
 from morpheus.pipeline.stream_pair import StreamPair
 from morpheus.utils.logging import deprecated_stage_warning
@@ -30,17 +32,45 @@ class BufferStage(SinglePortStage):
     The input messages are buffered by this stage class for faster access to downstream stages. Allows
     upstream stages to run faster than downstream stages.
 
+    Without a `device_memory_budget` this stage is a pass through, the edges between stages already buffer messages.
+    With a budget, and when the C++ stages are in use and the input is `MessageMeta`, up to `count` messages are held
+    while keeping the tables resident on the device under `device_memory_budget` bytes. Messages arriving over the
+    budget have their columns moved to pinned host memory and are copied back, in order, as room frees up, usually
+    before they reach the downstream. The upstream is only blocked once `count` messages are held, or when spilling
+    would exceed `host_memory_budget`.
+
     Parameters
     ----------
     c : `morpheus.config.Config`
         Pipeline configuration instance.
+    count : int, default = 1000
+        Most messages held at once.
+    device_memory_budget : int, default = 0
+        Bytes of device memory the held tables may use before new messages are spilled to host memory. 0 disables
+        spilling.
+    host_memory_budget : int, default = 0
+        Bytes of pinned host memory spilled messages may use before the upstream is blocked. 0 is unlimited.
+    compact_fraction : float, default = 0.0
+        Slices holding fewer than this fraction of the rows of the table they were taken from are copied into a table
+        of their own, so the rest of that table can be freed while they are held. 0 disables compaction.
 
     """
 
-    def __init__(self, c: Config, count: int = 1000):
+    def __init__(self,
+                 c: Config,
+                 count: int = 1000,
+                 device_memory_budget: int = 0,
+                 host_memory_budget: int = 0,
+                 compact_fraction: float = 0.0):
         super().__init__(c)
 
         self._buffer_count = count
+        self._device_memory_budget = device_memory_budget
+        self._host_memory_budget = host_memory_budget
+        self._compact_fraction = compact_fraction
+
+        if (self._buffer_count <= 0):
+            raise ValueError("BufferStage count must be greater than 0")
 
     @property
     def name(self) -> str:
@@ -58,9 +88,30 @@ class BufferStage(SinglePortStage):
         """
         return (typing.Any, )
 
+    def supports_cpp_node(self):
+        return True
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
-        # This stage is no longer needed and is just a pass thru stage
+        needs_cpp_node = self._device_memory_budget > 0 or self._compact_fraction > 0
+
+        if (needs_cpp_node and self._build_cpp_node() and input_stream[1] == MessageMeta):
+            stream = neos.BufferStage(seg,
+                                      self.unique_name,
+                                      self._buffer_count,
+                                      self._device_memory_budget,
+                                      self._host_memory_budget,
+                                      self._compact_fraction)
+            seg.make_edge(input_stream[0], stream)
+
+            return stream, input_stream[1]
+
+        if (needs_cpp_node):
+            logger.warning("BufferStage '%s' only spills and compacts MessageMeta with the C++ stages, ignoring the "
+                           "budget and compact fraction",
+                           self.unique_name)
+
+        # Without a budget this stage is no longer needed and is just a pass thru stage
         deprecated_stage_warning(logger, type(self), self.unique_name)
 
         return input_stream
@@ -0,0 +1,172 @@
+# Copyright (c) 2021-2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import time
+import typing
+
+import neo
+from neo.core import operators as ops
+
+import cudf
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.config import CppConfig
+from morpheus.messages import MessageMeta
+from morpheus.messages import MultiMessage
+from morpheus.pipeline.multi_message_stage import MultiMessageStage
+from morpheus.pipeline.stream_pair import StreamPair
+
+logger = logging.getLogger(__name__)
+
+
+class CoalesceStage(MultiMessageStage):
+    """
+    This stage merges small `MultiMessage` objects into messages of up to `batch_size` rows by concatenating their
+    rows into a new `MessageMeta`. Useful after stages which emit many small messages, such as `KafkaSourceStage` on a
+    quiet topic or `FilterDetectionsStage`, so the following preprocessing and inference stages see full batches.
+
+    Buffered rows are emitted once adding the next message would exceed `batch_size`, once `timeout_ms` has passed
+    since the oldest buffered message arrived, or when the input completes. Only the C++ stage has a timer, the python
+    stage checks the timeout when a message arrives, so a quiet input can hold rows until the next message or the end
+    of the input.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    batch_size : int, default = None
+        Number of rows to merge into each message. Defaults to `c.pipeline_batch_size`.
+    timeout_ms : int, default = 100
+        Longest time in milliseconds a message is held waiting for more rows. Values less than or equal to 0 disable
+        the timeout.
+
+    """
+
+    def __init__(self, c: Config, batch_size: int = None, timeout_ms: int = 100):
+        super().__init__(c)
+
+        self._batch_size = batch_size if batch_size is not None else c.pipeline_batch_size
+        self._timeout_ms = timeout_ms
+
+        if (self._batch_size <= 0):
+            raise ValueError("CoalesceStage batch_size must be greater than 0")
+
+        self._buffer: typing.List[MultiMessage] = []
+        self._buffered_rows = 0
+        self._first_arrival = 0.0
+
+    @property
+    def name(self) -> str:
+        return "coalesce"
+
+    def accepted_types(self) -> typing.Tuple:
+        """
+        Returns accepted input types for this stage.
+
+        """
+        return (MultiMessage, )
+
+    @staticmethod
+    def _same_layout(x: MultiMessage, y: MultiMessage) -> bool:
+        x_df = x.get_meta()
+        y_df = y.get_meta()
+
+        return list(x_df.columns) == list(y_df.columns) and list(x_df.dtypes) == list(y_df.dtypes)
+
+    def _flush(self) -> typing.List[MultiMessage]:
+
+        if (len(self._buffer) == 0):
+            return []
+
+        if (len(self._buffer) == 1):
+            merged = self._buffer[0]
+        else:
+            # Messages of different sources usually share index labels, which `MultiMessage.get_meta` selects rows by
+            df = cudf.concat([m.get_meta() for m in self._buffer], ignore_index=True)
+
+            merged = MultiMessage(meta=MessageMeta(df), mess_offset=0, mess_count=len(df))
+
+        self._buffer = []
+        self._buffered_rows = 0
+
+        return [merged]
+
+    def on_next(self, x: MultiMessage) -> typing.List[MultiMessage]:
+        """
+        Buffers `x`, returning any messages which are ready to be emitted.
+
+        Parameters
+        ----------
+        x : `morpheus.pipeline.messages.MultiMessage`
+            Incoming message.
+
+        Returns
+        -------
+        typing.List[`morpheus.pipeline.messages.MultiMessage`]
+            Messages to emit, possibly empty.
+
+        """
+        output = []
+
+        if (len(self._buffer) > 0):
+            timed_out = self._timeout_ms > 0 and (time.monotonic() - self._first_arrival) * 1000 >= self._timeout_ms
+
+            if (timed_out or self._buffered_rows + x.mess_count > self._batch_size
+                    or not CoalesceStage._same_layout(self._buffer[0], x)):
+                output.extend(self._flush())
+
+        # Already a full batch, nothing to merge it with
+        if (x.mess_count >= self._batch_size):
+            output.append(x)
+            return output
+
+        if (len(self._buffer) == 0):
+            self._first_arrival = time.monotonic()
+
+        self._buffer.append(x)
+        self._buffered_rows += x.mess_count
+
+        if (self._buffered_rows >= self._batch_size):
+            output.extend(self._flush())
+
+        return output
+
+    def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
+
+        stream = input_stream[0]
+        out_type = MultiMessage
+
+        def node_fn(input: neo.Observable, output: neo.Subscriber):
+
+            def on_completed():
+
+                to_send = self._flush()
+
+                return to_send if len(to_send) > 0 else None
+
+            input.pipe(ops.map(self.on_next),
+                       ops.filter(lambda x: len(x) > 0),
+                       ops.on_completed(on_completed),
+                       ops.flatten()).subscribe(output)
+
+        if CppConfig.get_should_use_cpp():
+            stream = neos.CoalesceStage(seg, self.unique_name, self._batch_size, self._timeout_ms)
+        else:
+            stream = seg.make_node_full(self.unique_name, node_fn)
+
+        seg.make_edge(input_stream[0], stream)
+
+        return stream, out_type
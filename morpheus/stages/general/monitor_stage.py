@@ -23,6 +23,7 @@ from tqdm import tqdm
 
 import cudf
 
+import morpheus._lib.stages as neos
 from morpheus.config import Config
 from morpheus.messages import MessageMeta
 from morpheus.messages import MultiMessage
@@ -143,6 +144,13 @@ class MonitorStage(SinglePortStage):
     determine_count_fn : typing.Callable[[typing.Any], int]
         Custom function for determining the count in a message. Gets called for each message. Allows for
         correct counting of batched and sliced messages.
+    log_interval_ms : int
+        C++ stage only. Interval in milliseconds between the progress lines. 0 disables the console output, the
+        counts are still available from the stage metrics.
+
+    When the C++ stages are in use, the input is `MessageMeta` or `MultiMessage` and no `determine_count_fn` is given,
+    a C++ pass through node counts the rows without the GIL and a background thread writes a progress line every
+    `log_interval_ms` in place of the tqdm progress bar. `smoothing` and `delayed_start` are ignored by that node.
 
     """
     stage_count: int = 0
@@ -153,7 +161,8 @@ class MonitorStage(SinglePortStage):
                  smoothing: float = 0.05,
                  unit="messages",
                  delayed_start: bool = False,
-                 determine_count_fn: typing.Callable[[typing.Any], int] = None):
+                 determine_count_fn: typing.Callable[[typing.Any], int] = None,
+                 log_interval_ms: int = 1000):
         super().__init__(c)
 
         self._progress: MorpheusTqdm = None
@@ -167,6 +176,10 @@ class MonitorStage(SinglePortStage):
         self._delayed_start = delayed_start
 
         self._determine_count_fn = determine_count_fn
+        self._log_interval_ms = log_interval_ms
+
+        # Set when the C++ node is built, which replaces the progress bar
+        self._cpp_monitor = False
 
     @property
     def name(self) -> str:
@@ -184,8 +197,14 @@ class MonitorStage(SinglePortStage):
         """
         return (typing.Any, )
 
+    def supports_cpp_node(self):
+        return True
+
     def on_start(self):
 
+        if (self._cpp_monitor):
+            return
+
         # Set the monitor interval to 0 to use prevent using tqdms monitor
         tqdm.monitor_interval = 0
 
@@ -212,6 +231,32 @@ class MonitorStage(SinglePortStage):
 
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
+        if (self._build_cpp_node() and self._determine_count_fn is None
+                and input_stream[1] in (MessageMeta, MultiMessage)):
+            unit = self._unit if self._unit is not None else "messages"
+
+            if (input_stream[1] == MessageMeta):
+                stream = neos.MonitorMessageMetaStage(seg,
+                                                      self.unique_name,
+                                                      self._description,
+                                                      unit,
+                                                      self._log_interval_ms)
+            else:
+                stream = neos.MonitorMultiMessageStage(seg,
+                                                       self.unique_name,
+                                                       self._description,
+                                                       unit,
+                                                       self._log_interval_ms)
+
+            seg.make_edge(input_stream[0], stream)
+
+            self._cpp_monitor = True
+
+            # Never shows a tqdm bar, so the last python monitor to complete can stop the tqdm monitor thread
+            MonitorStage.stage_count -= 1
+
+            return stream, input_stream[1]
+
         def sink_on_error(x):
             logger.error("Node: '%s' received error: %s", self.unique_name, x)
 
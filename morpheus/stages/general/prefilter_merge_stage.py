@@ -0,0 +1,78 @@
+# Copyright (c) 2021-2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import typing
+
+import neo
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.config import CppConfig
+from morpheus.messages import MultiMessage
+from morpheus.pipeline.multi_message_stage import MultiMessageStage
+from morpheus.pipeline.stream_pair import StreamPair
+from morpheus.stages.general.prefilter_stage import PrefilterStage
+
+logger = logging.getLogger(__name__)
+
+
+class PrefilterMergeStage(MultiMessageStage):
+    """
+    This stage emits its input along with the rows `prefilter` took out, as soon as they are available. Place it after
+    the stages the matched rows skip, before serialization. The matched rows are plain `MultiMessage` messages, so the
+    stage emits `MultiMessage`. Requires the C++ implementation.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    prefilter : `morpheus.stages.general.prefilter_stage.PrefilterStage`
+        Stage whose matched rows are merged back. Must come before this stage in the pipeline.
+
+    """
+
+    def __init__(self, c: Config, prefilter: PrefilterStage):
+        super().__init__(c)
+
+        if (prefilter._merge_stage is not None):
+            raise ValueError("The rows of a PrefilterStage can only be merged back once")
+
+        self._prefilter = prefilter
+        self._prefilter._merge_stage = self
+
+    @property
+    def name(self) -> str:
+        return "prefilter-merge"
+
+    def accepted_types(self) -> typing.Tuple:
+        """
+        Returns accepted input types for this stage.
+
+        """
+        return (MultiMessage, )
+
+    def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
+
+        if (not CppConfig.get_should_use_cpp()):
+            raise NotImplementedError("PrefilterMergeStage requires the C++ implementation")
+
+        if (self._prefilter._cpp_stage is None):
+            raise RuntimeError("The PrefilterStage must be built before its PrefilterMergeStage")
+
+        stream = neos.PrefilterMergeStage(seg, self.unique_name, self._prefilter._cpp_stage)
+
+        seg.make_edge(input_stream[0], stream)
+
+        return stream, MultiMessage
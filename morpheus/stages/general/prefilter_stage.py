@@ -0,0 +1,118 @@
+# Copyright (c) 2021-2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import typing
+
+import neo
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.config import CppConfig
+from morpheus.messages import MultiMessage
+from morpheus.pipeline.multi_message_stage import MultiMessageStage
+from morpheus.pipeline.stream_pair import StreamPair
+
+logger = logging.getLogger(__name__)
+
+
+class PrefilterStage(MultiMessageStage):
+    """
+    This stage takes the rows whose `column` matches any of `patterns`, or equals any of `literals`, out of each
+    message so known benign traffic, like health checks and heartbeats, skips preprocessing and inference. Place it
+    after deserialization. The patterns and literals are compiled into a single regular expression evaluated on the
+    GPU. Null values never match.
+
+    Matched rows are given every label column, set to false. When a `PrefilterMergeStage` is created for this stage,
+    the matched rows are emitted again by it, typically right before serialization, otherwise they are dropped. The
+    number of matched rows is reported by `benign_count`. Requires the C++ implementation.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    column : str
+        String column the patterns and literals are evaluated against.
+    patterns : typing.List[str], default = None
+        Regular expressions, a row matches when any of them is found in its value.
+    literals : typing.List[str], default = None
+        Values a row matches when it is exactly equal to one of them.
+    label_columns : typing.List[str], default = None
+        Label columns written into the matched rows. Defaults to `Config.class_labels`.
+
+    """
+
+    def __init__(self,
+                 c: Config,
+                 column: str,
+                 patterns: typing.List[str] = None,
+                 literals: typing.List[str] = None,
+                 label_columns: typing.List[str] = None):
+        super().__init__(c)
+
+        self._column = column
+        self._patterns = list(patterns) if patterns is not None else []
+        self._literals = list(literals) if literals is not None else []
+        self._label_columns = list(label_columns) if label_columns is not None else list(c.class_labels)
+        self._benign_queue_size = c.edge_buffer_size
+
+        if (len(self._patterns) == 0 and len(self._literals) == 0):
+            raise ValueError("PrefilterStage requires at least one pattern or literal")
+
+        # Set by the merge stage created for this stage
+        self._merge_stage = None
+
+        self._cpp_stage = None
+
+    @property
+    def name(self) -> str:
+        return "prefilter"
+
+    @property
+    def benign_count(self) -> int:
+        """
+        Number of rows which matched so far.
+
+        """
+        if (self._cpp_stage is None):
+            return 0
+
+        return self._cpp_stage.benign_count
+
+    def accepted_types(self) -> typing.Tuple:
+        """
+        Returns accepted input types for this stage.
+
+        """
+        return (MultiMessage, )
+
+    def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
+
+        if (not CppConfig.get_should_use_cpp()):
+            raise NotImplementedError("PrefilterStage requires the C++ implementation")
+
+        stream = neos.PrefilterStage(seg,
+                                     self.unique_name,
+                                     self._column,
+                                     self._patterns,
+                                     self._literals,
+                                     self._label_columns,
+                                     self._merge_stage is not None,
+                                     self._benign_queue_size)
+
+        self._cpp_stage = stream
+
+        seg.make_edge(input_stream[0], stream)
+
+        return stream, MultiMessage
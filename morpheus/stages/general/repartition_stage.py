@@ -0,0 +1,109 @@
+# Copyright (c) 2021-2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import typing
+
+import neo
+import typing_utils
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.config import CppConfig
+from morpheus.messages import MultiMessage
+from morpheus.pipeline.stage import Stage
+from morpheus.pipeline.stream_pair import StreamPair
+
+logger = logging.getLogger(__name__)
+
+
+class RepartitionStage(Stage):
+    """
+    This stage splits the rows of each message into `num_shards` shards by the hash of `key_column`, with one output
+    port per shard. Every row with the same key always goes to the same port and rows keep their order within a shard,
+    so stateful stages, like `TimeSeriesStage`, can run once per port on every shard in parallel while still seeing
+    the events of each key in order. Messages are regrouped into new messages of the input rows, so place the stage
+    after deserialization and build the rest of the pipeline, from preprocessing on, once per port.
+
+    Every output port must be connected, a shard whose messages are not consumed blocks the stage once
+    `shard_queue_size` of them are queued. Requires the C++ implementation.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    key_column : str
+        Column holding the key rows are sharded by, such as the user id.
+    num_shards : int
+        Number of shards, and of output ports.
+    shard_queue_size : int, default = None
+        Number of messages queued for each shard, must be a power of 2. Defaults to `Config.edge_buffer_size`.
+
+    """
+
+    def __init__(self, c: Config, key_column: str, num_shards: int, shard_queue_size: int = None):
+        super().__init__(c)
+
+        self._key_column = key_column
+        self._num_shards = num_shards
+        self._shard_queue_size = shard_queue_size if shard_queue_size is not None else c.edge_buffer_size
+
+        if (self._num_shards <= 0):
+            raise ValueError("RepartitionStage num_shards must be greater than 0")
+
+        if (self._shard_queue_size < 2 or (self._shard_queue_size & (self._shard_queue_size - 1)) != 0):
+            raise ValueError("RepartitionStage shard_queue_size must be a power of 2 greater than 1")
+
+        self._create_ports(1, num_shards)
+
+    @property
+    def name(self) -> str:
+        return "repartition"
+
+    def accepted_types(self) -> typing.Tuple:
+        """
+        Returns accepted input types for this stage.
+
+        """
+        return (MultiMessage, )
+
+    def _build(self, seg: neo.Segment, in_ports_streams: typing.List[StreamPair]) -> typing.List[StreamPair]:
+
+        assert len(in_ports_streams) == 1, "Should only have 1 port on input"
+
+        input_stream = in_ports_streams[0]
+
+        if (not typing_utils.issubtype(input_stream[1], typing.Union[self.accepted_types()])):
+            raise RuntimeError("The {} stage cannot handle input of {}. Accepted input types: {}".format(
+                self.name, input_stream[1], self.accepted_types()))
+
+        if (not CppConfig.get_should_use_cpp()):
+            raise NotImplementedError("RepartitionStage requires the C++ implementation")
+
+        stage = neos.RepartitionStage(seg,
+                                      self.unique_name,
+                                      self._key_column,
+                                      self._num_shards,
+                                      self._shard_queue_size)
+
+        seg.make_edge(input_stream[0], stage)
+
+        # Shard 0 is emitted by the stage itself, each of the others by its own source
+        out_pairs = [(stage, MultiMessage)]
+
+        for shard in range(1, self._num_shards):
+            source = neos.RepartitionShardSource(seg, "{}-shard-{}".format(self.unique_name, shard), stage, shard)
+            out_pairs.append((source, MultiMessage))
+
+        return out_pairs
@@ -0,0 +1,235 @@
+# Copyright (c) 2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+import json
+import math
+import typing
+
+import cupy as cp
+import neo
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.messages import MultiInferenceMessage
+from morpheus.messages import ResponseMemory
+from morpheus.messages import ResponseMemoryProbs
+from morpheus.stages.inference.inference_stage import InferenceStage
+from morpheus.stages.inference.inference_stage import InferenceWorker
+from morpheus.utils.producer_consumer_queue import ProducerConsumerQueue
+
+
+def _parse_number(value) -> float:
+    # XGBoost writes the model parameters as strings, newer versions wrap `base_score` in brackets
+    if (isinstance(value, str)):
+        value = value.strip("[]")
+
+    return float(value)
+
+
+class ForestModel:
+    """
+    Tree ensemble loaded from the JSON format written by XGBoost's `Booster.save_model("model.json")` and evaluated
+    with CuPy. Mirrors the C++ `ForestModel`, see `ForestInferenceStage` for the supported models.
+
+    Parameters
+    ----------
+    filename : str
+        XGBoost JSON model file.
+    """
+
+    def __init__(self, filename: str):
+        with open(filename, "r") as f:
+            learner = json.load(f)["learner"]
+
+        booster = learner["gradient_booster"]
+        params = learner["learner_model_param"]
+        objective = learner["objective"]["name"]
+
+        if (booster["name"] != "gbtree"):
+            raise ValueError("Unsupported booster '{}'. Only 'gbtree' is supported".format(booster["name"]))
+
+        self.num_features = int(_parse_number(params["num_feature"]))
+        self.num_outputs = max(1, int(_parse_number(params["num_class"])))
+
+        base_score = _parse_number(params["base_score"])
+
+        self._sigmoid = objective == "binary:logistic"
+        self._softmax = objective in ("multi:softprob", "multi:softmax")
+
+        if (objective in ("binary:logistic", "binary:logitraw")):
+            # The base score is a probability, margins are summed in logit space
+            self._base_margin = math.log(base_score / (1.0 - base_score))
+        elif (objective in ("reg:squarederror", "reg:linear") or self._softmax):
+            self._base_margin = base_score
+        else:
+            raise ValueError("Unsupported objective '{}'".format(objective))
+
+        feature = []
+        value = []
+        left = []
+        right = []
+        missing = []
+        tree_roots = []
+
+        trees = booster["model"]["trees"]
+
+        # Flatten every tree into a single node array with absolute child indices, same as the C++ model
+        for tree in trees:
+            root = len(feature)
+            tree_roots.append(root)
+
+            for idx, left_child in enumerate(tree["left_children"]):
+                value.append(tree["split_conditions"][idx])
+
+                if (left_child < 0):
+                    feature.append(0)
+                    left.append(-1)
+                    right.append(-1)
+                    missing.append(-1)
+                    continue
+
+                right_child = tree["right_children"][idx]
+
+                feature.append(tree["split_indices"][idx])
+                left.append(root + left_child)
+                right.append(root + right_child)
+                missing.append(root + (left_child if tree["default_left"][idx] else right_child))
+
+        if (len(tree_roots) == 0):
+            raise ValueError("XGBoost model '{}' does not contain any trees".format(filename))
+
+        self._feature = cp.asarray(feature, dtype=cp.int32)
+        self._value = cp.asarray(value, dtype=cp.float32)
+        self._left = cp.asarray(left, dtype=cp.int32)
+        self._right = cp.asarray(right, dtype=cp.int32)
+        self._missing = cp.asarray(missing, dtype=cp.int32)
+        self._tree_roots = cp.asarray(tree_roots, dtype=cp.int32)
+
+        # [trees, outputs] one-hot matrix summing the leaves of each tree into its output
+        tree_outputs = cp.asarray(booster["model"]["tree_info"], dtype=cp.int32)
+        self._tree_output_matrix = (tree_outputs[:, None] == cp.arange(self.num_outputs)[None, :]).astype(cp.float32)
+
+    def predict(self, inputs: cp.ndarray) -> cp.ndarray:
+        """
+        Predicts every row of `inputs`, a [rows, features] array.
+
+        Returns
+        -------
+        cupy.ndarray
+            A [rows, num_outputs] float32 array of probabilities, or of raw scores for regression and
+            `binary:logitraw` models.
+        """
+        inputs = cp.asarray(inputs, dtype=cp.float32)
+        rows = inputs.shape[0]
+
+        # Walks every (row, tree) pair one level at a time until all of them have reached a leaf
+        nodes = cp.tile(self._tree_roots, (rows, 1))
+        row_idx = cp.arange(rows)[:, None]
+
+        while (True):
+            is_split = self._left[nodes] >= 0
+
+            if (not bool(is_split.any())):
+                break
+
+            values = inputs[row_idx, self._feature[nodes]]
+
+            next_nodes = cp.where(cp.isnan(values),
+                                  self._missing[nodes],
+                                  cp.where(values < self._value[nodes], self._left[nodes], self._right[nodes]))
+
+            nodes = cp.where(is_split, next_nodes, nodes)
+
+        output = self._value[nodes] @ self._tree_output_matrix + self._base_margin
+
+        if (self._sigmoid):
+            output = 1.0 / (1.0 + cp.exp(-output))
+        elif (self._softmax):
+            output = cp.exp(output - output.max(axis=1, keepdims=True))
+            output /= output.sum(axis=1, keepdims=True)
+
+        return output.astype(cp.float32)
+
+
+class _ForestInferenceWorker(InferenceWorker):
+    """
+    Inference worker used by ForestInferenceStage.
+
+    Parameters
+    ----------
+    inf_queue : `morpheus.utils.producer_consumer_queue.ProducerConsumerQueue`
+        Inference queue.
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    model_filename : str
+        XGBoost JSON model file.
+    """
+
+    def __init__(self, inf_queue: ProducerConsumerQueue, c: Config, model_filename: str):
+        super().__init__(inf_queue)
+
+        self._model_filename = model_filename
+        self._model: ForestModel = None
+
+    def init(self):
+        self._model = ForestModel(self._model_filename)
+
+    def calc_output_dims(self, x: MultiInferenceMessage) -> typing.Tuple:
+        return (x.count, self._model.num_outputs)
+
+    def process(self, batch: MultiInferenceMessage, cb: typing.Callable[[ResponseMemory], None]):
+
+        probs = self._model.predict(batch.get_input("input__0"))
+
+        # Computed inline, there is no server to wait on
+        cb(ResponseMemoryProbs(count=batch.count, probs=probs))
+
+
+class ForestInferenceStage(InferenceStage):
+    """
+    Runs small tree ensemble models, such as the XGBoost models used by the FIL pipelines, in-process on the GPU
+    instead of sending the inputs to Triton. The model is evaluated directly on the `input__0` tensor created by
+    `PreprocessFILStage`, avoiding the network round trip which dominates the inference time of small models. Outputs
+    the model's probabilities in `probs`.
+
+    Models are loaded from the JSON format written by XGBoost's `Booster.save_model("model.json")`. `gbtree` boosters
+    with the `binary:logistic`, `binary:logitraw`, `reg:squarederror`, `reg:linear`, `multi:softprob` and
+    `multi:softmax` objectives are supported. `multi:softmax` models output the class probabilities rather than the
+    class.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    model_filename : str
+        XGBoost JSON model file.
+    """
+
+    def __init__(self, c: Config, model_filename: str):
+        super().__init__(c)
+
+        self._config = c
+        self._model_filename = model_filename
+
+    def supports_cpp_node(self):
+        return True
+
+    def _get_inference_worker(self, inf_queue: ProducerConsumerQueue) -> InferenceWorker:
+
+        return _ForestInferenceWorker(inf_queue, self._config, model_filename=self._model_filename)
+
+    def _get_cpp_inference_node(self, seg: neo.Segment):
+
+        return neos.ForestInferenceStage(seg, name=self.unique_name, model_filename=self._model_filename)
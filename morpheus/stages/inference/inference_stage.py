@@ -199,6 +199,17 @@ class InferenceStage(MultiMessageStage):
     def _get_cpp_inference_node(self, seg: neo.Segment) -> neo.SegmentObject:
         raise NotImplementedError("No C++ node is available for this inference type")
 
+    def supports_fusion(self) -> bool:
+        return self._build_cpp_node()
+
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        node = self._get_cpp_inference_node(seg)
+
+        # Set the concurrency level to be up with the thread count
+        node.concurrency = self._thread_count
+
+        return node, MultiResponseProbsMessage
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
         stream = input_stream[0]
@@ -250,12 +261,13 @@ class InferenceStage(MultiMessageStage):
             assert outstanding_requests == 0, "Not all inference requests were completed"
 
         if (self._build_cpp_node()):
-            node = self._get_cpp_inference_node(seg)
+            node, out_type = self._build_fusable_node(seg, input_stream[1])
         else:
             node = seg.make_node_full(self.unique_name, py_inference_fn)
 
-        # Set the concurrency level to be up with the thread count
-        node.concurrency = self._thread_count
+            # Set the concurrency level to be up with the thread count
+            node.concurrency = self._thread_count
+
         seg.make_edge(stream, node)
 
         stream = node
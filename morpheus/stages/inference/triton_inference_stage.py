@@ -414,7 +414,8 @@ class _TritonInferenceWorker(InferenceWorker):
         default_mapping.update(inout_mapping if inout_mapping is not None else {})
 
         self._model_name = model_name
-        self._server_url = server_url
+        # Only the C++ stage balances across several servers, use the first
+        self._server_url = server_url.split(",")[0].strip()
         self._inout_mapping = default_mapping
         self._use_shared_memory = use_shared_memory
 
@@ -841,13 +842,43 @@ class TritonInferenceStage(InferenceStage):
         Name of the model specifies which model can handle the inference requests that are sent to Triton inference
         server.
     server_url : str
-        Triton server URL.
+        Triton server URL. The C++ stage accepts a comma separated list of servers hosting the same model, sending each
+        request to the healthy server with the fewest outstanding requests. The Python implementation only uses the
+        first.
     force_convert_inputs : bool
         Instructs the stage to convert the incoming data to the same format that Triton is expecting. If set to False,
         data will only be converted if it would not result in the loss of data.
     use_shared_memory: bool, default = False
         Whether or not to use CUDA Shared IPC Memory for transferring data to Triton. Using CUDA IPC reduces network
         transfer time but requires that Morpheus and Triton are located on the same machine.
+    max_concurrent_requests : int, default = 1
+        Maximum number of mini-batch requests the C++ stage will have outstanding with Triton at once. Values greater
+        than 1 use asynchronous requests, overlapping data transfer with inference. Ignored by the Python
+        implementation.
+    protocol : str, default = "http"
+        Protocol used by the C++ stage to communicate with Triton, either "http" or "grpc". Ensure `server_url` points
+        to the matching port. The Python implementation always uses gRPC.
+    length_bucketing : bool, default = False
+        When set, the C++ stage sorts rows by token length and sends each request with the shortest sequence length
+        that fits its rows, restoring the original row order in the response. Requires an NLP model with a dynamic
+        sequence dimension. Ignored by the Python implementation.
+    device_id : int, default = None
+        When set, the C++ stage binds its threads to the NUMA node closest to this GPU and makes it their current CUDA
+        device. Ignored by the Python implementation.
+    batch_timeout_ms : int, default = 0
+        When greater than 0, the C++ stage holds messages with fewer rows than the model's `max_batch_size` for up to
+        this many milliseconds, sending the rows of consecutive messages in a single request. Each message still
+        receives its own response. Ignored by the Python implementation.
+    cache_size : int, default = 0
+        When greater than 0, the C++ stage keeps the outputs of up to this many distinct rows on the GPU, keyed by a
+        hash of the row's inputs, and only sends rows which are not cached to Triton. Useful with highly repetitive
+        data. Ignored by the Python implementation.
+    window_reduction : str, default = "max"
+        How the C++ stage merges the outputs of the overlapping token windows of a single message row, either "max" or
+        "mean". The Python implementation always uses the max.
+    warmup : bool, default = False
+        When set, the C++ stage sends a batch of `max_batch_size` rows of zeros to Triton when it starts, so the first
+        real batch does not pay for cold allocations. Ignored by the Python implementation.
     """
 
     def __init__(self,
@@ -855,7 +886,15 @@ class TritonInferenceStage(InferenceStage):
                  model_name: str,
                  server_url: str,
                  force_convert_inputs: bool,
-                 use_shared_memory: bool = False):
+                 use_shared_memory: bool = False,
+                 max_concurrent_requests: int = 1,
+                 protocol: str = "http",
+                 length_bucketing: bool = False,
+                 device_id: int = None,
+                 batch_timeout_ms: int = 0,
+                 cache_size: int = 0,
+                 window_reduction: str = "max",
+                 warmup: bool = False):
         super().__init__(c)
 
         self._config = c
@@ -867,6 +906,15 @@ class TritonInferenceStage(InferenceStage):
             "use_shared_memory": use_shared_memory,
         }
 
+        self._max_concurrent_requests = max_concurrent_requests
+        self._protocol = protocol
+        self._length_bucketing = length_bucketing
+        self._device_id = device_id
+        self._batch_timeout_ms = batch_timeout_ms
+        self._cache_size = cache_size
+        self._window_reduction = window_reduction
+        self._warmup = warmup
+
         self._requires_seg_ids = False
 
     def supports_cpp_node(self):
@@ -895,4 +943,12 @@ class TritonInferenceStage(InferenceStage):
                                          name=self.unique_name,
                                          needs_logits=self._get_worker_class().needs_logits(),
                                          inout_mapping=self._get_worker_class().default_inout_mapping(),
+                                         max_concurrent_requests=self._max_concurrent_requests,
+                                         protocol=self._protocol,
+                                         length_bucketing=self._length_bucketing,
+                                         device_id=-1 if self._device_id is None else self._device_id,
+                                         batch_timeout_ms=self._batch_timeout_ms,
+                                         cache_size=self._cache_size,
+                                         window_reduction=self._window_reduction,
+                                         warmup=self._warmup,
                                          **self._kwargs)
@@ -24,8 +24,10 @@ import neo
 import pandas as pd
 from neo.core import operators as ops
 
+import morpheus._lib.stages as neos
 from morpheus.config import Config
 from morpheus.messages.message_meta import AppShieldMessageMeta
+from morpheus.messages.message_meta import MessageMeta
 from morpheus.pipeline import SingleOutputSource
 from morpheus.pipeline import StreamPair
 from morpheus.utils.directory_watcher import DirectoryWatcher
@@ -68,6 +70,12 @@ class AppShieldSourceStage(SingleOutputSource):
         Timeout to retrieve batch messages from the queue.
     encoding: str, default = latin1
         Encoding to read a file.
+
+    Notes
+    -----
+    When C++ execution is enabled, and `encoding` is Latin-1 or UTF-8, the files are parsed by a C++ node which reads
+    the files of a batch in parallel without going through pandas. It emits `MessageMeta`s rather than
+    `AppShieldMessageMeta`s, the source of every row being available in the `source` column.
     """
 
     def __init__(self,
@@ -91,6 +99,8 @@ class AppShieldSourceStage(SingleOutputSource):
         self._cols_exclude = cols_exclude
         self._encoding = encoding
 
+        self._num_threads = c.num_threads
+
         self._input_count = None
 
         self._watcher = DirectoryWatcher(input_glob=input_glob,
@@ -110,6 +120,10 @@ class AppShieldSourceStage(SingleOutputSource):
         """Return None for no max intput count"""
         return self._input_count
 
+    def supports_cpp_node(self):
+        encoding = self._encoding.lower()
+        return encoding.startswith('utf') or encoding in ('latin1', 'latin-1', 'iso-8859-1', 'iso8859-1')
+
     @staticmethod
     def fill_interested_cols(plugin_df: pd.DataFrame, cols_include: typing.List[str]):
         """
@@ -360,6 +374,18 @@ class AppShieldSourceStage(SingleOutputSource):
 
         out_stream = out_pair[0]
 
+        if (self._build_cpp_node()):
+            post_node = neos.AppShieldSourceStage(seg,
+                                                  self.unique_name + "-post",
+                                                  self._plugins_include,
+                                                  self._cols_include,
+                                                  self._cols_exclude,
+                                                  self._encoding,
+                                                  self._num_threads)
+            seg.make_edge(out_stream, post_node)
+
+            return super()._post_build_single(seg, (post_node, MessageMeta))
+
         def node_fn(input: neo.Observable, output: neo.Subscriber):
             input.pipe(
                 # At this point, we have batches of filenames to process. Make a node for processing batches of
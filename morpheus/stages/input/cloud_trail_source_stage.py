@@ -22,6 +22,7 @@ import numpy as np
 import pandas as pd
 from neo.core import operators as ops
 
+import morpheus._lib.stages as neos
 from morpheus._lib.file_types import FileTypes
 from morpheus._lib.file_types import determine_file_type
 from morpheus.config import Config
@@ -39,6 +40,9 @@ class CloudTrailSourceStage(SingleOutputSource):
     Source stage is used to load AWS CloudTrail messages from a file and dumping the contents into the pipeline
     immediately. Useful for testing performance and accuracy of a pipeline.
 
+    When using C++ execution, JSON files, optionally gzipped, are read on `Config.num_threads` threads and parsed,
+    sorted and split by user on the GPU. CSV files are always read in Python.
+
     Parameters
     ----------
     c : `morpheus.config.Config`
@@ -81,12 +85,15 @@ class CloudTrailSourceStage(SingleOutputSource):
 
         SingleOutputSource.__init__(self, c)
 
+        self._input_glob = input_glob
         self._file_type = file_type
 
         self._feature_columns = c.ae.feature_columns
         self._user_column_name = c.ae.userid_column_name
         self._userid_filter = c.ae.userid_filter
 
+        self._num_threads = c.num_threads
+
         self._input_count = None
 
         # Hold the max index we have seen to ensure sequential and increasing indexes
@@ -113,6 +120,12 @@ class CloudTrailSourceStage(SingleOutputSource):
         """Return None for no max intput count"""
         return self._input_count
 
+    def supports_cpp_node(self):
+        if (self._file_type == FileTypes.Auto):
+            return not self._input_glob.endswith(".csv")
+
+        return self._file_type == FileTypes.JSON
+
     def get_match_pattern(self, glob_split):
         """Return a file match pattern"""
         dir_to_watch = os.path.dirname(glob_split[0])
@@ -328,6 +341,31 @@ class CloudTrailSourceStage(SingleOutputSource):
         out_stream = out_pair[0]
         out_type = out_pair[1]
 
+        if (self._build_cpp_node()):
+            cpp_node = neos.CloudTrailSourceStage(seg,
+                                                  self.unique_name + "-cpp",
+                                                  self._user_column_name,
+                                                  self._userid_filter or "",
+                                                  self._repeat_count,
+                                                  self._num_threads)
+            seg.make_edge(out_stream, cpp_node)
+
+            user_column_name = self._user_column_name
+
+            def to_user_meta(meta):
+                # Downstream stages need the user of each message
+                df = meta.df.to_pandas()
+
+                return UserMessageMeta(df, df[user_column_name].iloc[0])
+
+            def cpp_node_fn(input: neo.Observable, output: neo.Subscriber):
+                input.pipe(ops.map(to_user_meta)).subscribe(output)
+
+            post_node = seg.make_node_full(self.unique_name + "-post", cpp_node_fn)
+            seg.make_edge(cpp_node, post_node)
+
+            return super()._post_build_single(seg, (post_node, UserMessageMeta))
+
         def node_fn(input: neo.Observable, output: neo.Subscriber):
 
             input.pipe(
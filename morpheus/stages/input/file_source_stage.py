@@ -13,14 +13,19 @@
 # limitations under the License.
 
 import logging
+import os
 import typing
 
 import neo
+import pandas as pd
 import typing_utils
 from neo.core import operators as ops
 
+import cudf
+
 import morpheus._lib.stages as neos
 from morpheus._lib.file_types import FileTypes
+from morpheus._lib.file_types import determine_file_type
 from morpheus.config import Config
 from morpheus.config import CppConfig
 from morpheus.io.deserializers import read_file_to_df
@@ -57,6 +62,15 @@ class FileSourceStage(SingleOutputSource):
         keyword args passed to underlying cuDF I/O function. See the cuDF documentation for `cudf.read_csv()` and
         `cudf.read_json()` for the available options. With `file_type` == 'json', this defaults to ``{ "lines": True }``
         and with `file_type` == 'csv', this defaults to ``{}``.
+    chunk_bytes: int, default = 0
+        When greater than 0 the file is read in byte ranges of this size, emitting each range as its own message as
+        soon as it has been read, so device memory use is proportional to `chunk_bytes` rather than the size of the
+        file. Rows are never split, the index continues across chunks and repeats, and every chunk is cast to the
+        column types of the first one. 0 reads the whole file at once.
+    use_mmap: bool, default = False
+        Read through a read only memory mapping of the file instead of buffered reads. The file is mapped once for all
+        repeats and chunks and parsed straight from the mapped pages, so a file replayed repeatedly is served from the
+        page cache without an intermediate host copy. Only used by the C++ implementation.
     """
 
     def __init__(self,
@@ -66,7 +80,9 @@ class FileSourceStage(SingleOutputSource):
                  file_type: FileTypes = FileTypes.Auto,
                  repeat: int = 1,
                  filter_null: bool = True,
-                 cudf_kwargs: dict = None):
+                 cudf_kwargs: dict = None,
+                 chunk_bytes: int = 0,
+                 use_mmap: bool = False):
 
         super().__init__(c)
 
@@ -85,6 +101,12 @@ class FileSourceStage(SingleOutputSource):
         self._iterative = iterative
         self._repeat_count = repeat
 
+        if (chunk_bytes < 0):
+            raise ValueError("chunk_bytes must be greater than or equal to 0")
+
+        self._chunk_bytes = chunk_bytes
+        self._use_mmap = use_mmap
+
     @property
     def name(self) -> str:
         return "from-file"
@@ -97,7 +119,15 @@ class FileSourceStage(SingleOutputSource):
     def _build_source(self, seg: neo.Segment) -> StreamPair:
 
         if CppConfig.get_should_use_cpp():
-            out_stream = neos.FileSourceStage(seg, self.unique_name, self._filename, self._repeat_count)
+            out_stream = neos.FileSourceStage(seg,
+                                              self.unique_name,
+                                              self._filename,
+                                              self._repeat_count,
+                                              self._chunk_bytes,
+                                              self._use_mmap,
+                                              self._config.output_column_types())
+        elif (self._chunk_bytes > 0):
+            out_stream = seg.make_source(self.unique_name, self._generate_chunks())
         else:
             out_stream = seg.make_source(self.unique_name, self._generate_frames())
 
@@ -149,3 +179,53 @@ class FileSourceStage(SingleOutputSource):
                 df = prev_df.copy()
 
                 df.index += len(df)
+
+    def _generate_chunks(self):
+
+        file_type = self._file_type
+
+        if (file_type == FileTypes.Auto):
+            file_type = determine_file_type(self._filename)
+
+        file_size = os.path.getsize(self._filename)
+
+        # Only the first chunk of a CSV file holds the header
+        header_names = list(pd.read_csv(self._filename, nrows=0).columns) if file_type == FileTypes.CSV else None
+
+        dtypes = None
+        rows_emitted = 0
+
+        for _ in range(self._repeat_count):
+
+            repeat_start = rows_emitted
+
+            for offset in range(0, file_size, self._chunk_bytes):
+
+                parser_kwargs = {"byte_range": (offset, self._chunk_bytes)}
+
+                if (file_type == FileTypes.CSV and offset > 0):
+                    parser_kwargs.update({"header": None, "names": header_names})
+
+                df = read_file_to_df(self._filename,
+                                     file_type,
+                                     parser_kwargs=parser_kwargs,
+                                     filter_nulls=self._filter_null,
+                                     df_type="cudf")
+
+                if (len(df) == 0):
+                    # No row starts within this byte range
+                    continue
+
+                if (dtypes is None):
+                    dtypes = df.dtypes
+                elif (not df.dtypes.equals(dtypes)):
+                    df = df.astype(dtypes.to_dict())
+
+                if (isinstance(df.index, cudf.RangeIndex)):
+                    df.index = cudf.RangeIndex(rows_emitted, rows_emitted + len(df))
+                else:
+                    df.index += repeat_start
+
+                rows_emitted += len(df)
+
+                yield MessageMeta(df)
@@ -14,6 +14,7 @@
 
 import logging
 import time
+import typing
 import weakref
 
 import neo
@@ -41,8 +42,10 @@ class KafkaSourceStage(SingleOutputSource):
         Pipeline configuration instance.
     bootstrap_servers : str
         Kafka cluster bootstrap servers separated by a comma.
-    input_topic : str
-        Input kafka topic.
+    input_topic : typing.Union[str, typing.List[str]]
+        Input kafka topic, or several topics as a list or a comma separated string. Topics starting with '^' are
+        regular expressions matched against every topic of the cluster. Several topics and regular expressions are
+        only supported by the C++ implementation.
     group_id : str
         Specifies the name of the consumer group a Kafka consumer belongs to.
     poll_interval : str
@@ -50,32 +53,164 @@ class KafkaSourceStage(SingleOutputSource):
     disable_commit: bool, default = False
         Enabling this option will skip committing messages as they are pulled off the server. This is only useful for
         debugging, allowing the user to process the same messages multiple times.
+    disable_pre_filtering : bool, default = False
+        Enabling this option will skip pre-filtering of json messages. This is only useful when inputs are known to be
+        valid json.
+    max_batch_bytes : int, default = 0
+        Maximum number of message payload bytes to accumulate in a batch. A value of 0 disables the limit. Only used by
+        the C++ implementation.
+    adaptive_batching : bool, default = False
+        When enabled, the batch size grows up to `c.pipeline_batch_size` while downstream stages apply backpressure
+        and shrinks again when they keep up. Only used by the C++ implementation.
+    commit_on_completion : bool, default = False
+        When enabled, the C++ implementation commits the offsets of a batch once every message created from it has
+        been released by the pipeline, rather than as soon as it was emitted, so a crash only replays unfinished
+        batches. Offsets are committed in order, a batch which failed downstream is logged and committed past. The
+        python implementation always commits once a message is released.
+    topic_column : str, default = None
+        When set, every row gets a string column of this name holding the topic it was read from, so one pipeline can
+        serve several topics.
+    start_timestamp_ms : int, default = None
+        When set, every assigned partition starts at its first message stamped at or after this time, in milliseconds
+        since the epoch, instead of its committed offset. Only supported by the C++ implementation.
+    start_offsets : typing.Dict[typing.Union[str, typing.Tuple[str, int]], int], default = None
+        Offsets to start at, keyed by `(topic, partition)` tuples or `"topic:partition"` strings. Takes precedence over
+        `start_timestamp_ms` for the partitions listed. Only supported by the C++ implementation.
+    stop_timestamp_ms : int, default = None
+        When set, a partition stops at its first message stamped at or after this time, or once it is caught up when
+        that time has passed. The stage completes once every partition stopped. Setting any of the replay options
+        disables commits. Only supported by the C++ implementation.
+    device_id : int, default = None
+        When set, the C++ implementation binds the threads consuming and parsing partitions to the NUMA node closest to
+        this GPU and makes it their current CUDA device, keeping host staging buffers on the same socket as the GPU.
+        Ignored by the python implementation.
+    drop_null_column : str, default = None
+        When set, rows where this column is null are dropped while each batch is read, replacing a `DropNullStage`
+        directly after this stage. The C++ implementation does not emit batches left without rows.
+    schema : typing.Dict[str, str], default = None
+        Column types, mapping names to type names like "int64", "float64", "bool" or "str", used when reading each
+        batch instead of inferring the types. Every batch has these columns, columns missing from a batch hold nulls.
+    schema_batches : int, default = 0
+        When `schema` is not set and this is above 0, the C++ implementation learns the schema from the first
+        `schema_batches` batches and then freezes it. Columns seen with different types are widened.
+    message_format : str, default = "json"
+        Format of the message payloads. One of "json", "avro" for bare Avro datums written with `avro_schema`, or
+        "avro-confluent" for datums framed by the Confluent serializer. Avro payloads are decoded a batch at a time on
+        the GPU by the C++ implementation.
+    avro_schema : str, default = None
+        Writer schema of Avro payloads, as Avro JSON. Required for "avro". Used for every schema id of
+        "avro-confluent" payloads when `schema_registry_url` is not set.
+    schema_registry_url : str, default = None
+        Base URL of a Confluent schema registry, like "http://localhost:8081", used to look up the writer schema of
+        each "avro-confluent" payload.
+    metadata_columns : typing.List[str], default = None
+        Columns filled from the metadata of each message instead of its payload, any of "_key", "_ts" (timestamp in
+        milliseconds), "_partition" and "_offset". Keys and timestamps are null when a message has none. Only
+        supported by the C++ implementation.
+    max_in_flight_batches : int, default = 0
+        When above 0, the C++ implementation pauses fetching for its partitions once this many emitted batches are
+        still held downstream, and resumes once half of them were released, keeping host memory bounded under overload.
+        Must be above the number of batches downstream stages hold on to. Ignored by the python implementation.
     """
 
     def __init__(self,
                  c: Config,
                  bootstrap_servers: str,
-                 input_topic: str = "test_pcap",
+                 input_topic: typing.Union[str, typing.List[str]] = "test_pcap",
                  group_id: str = "custreamz",
                  poll_interval: str = "10millis",
                  disable_commit: bool = False,
-                 disable_pre_filtering: bool = False):
+                 disable_pre_filtering: bool = False,
+                 max_batch_bytes: int = 0,
+                 adaptive_batching: bool = False,
+                 commit_on_completion: bool = False,
+                 topic_column: str = None,
+                 start_timestamp_ms: int = None,
+                 start_offsets: typing.Dict[typing.Union[str, typing.Tuple[str, int]], int] = None,
+                 stop_timestamp_ms: int = None,
+                 device_id: int = None,
+                 drop_null_column: str = None,
+                 schema: typing.Dict[str, str] = None,
+                 schema_batches: int = 0,
+                 message_format: str = "json",
+                 avro_schema: str = None,
+                 schema_registry_url: str = None,
+                 metadata_columns: typing.List[str] = None,
+                 max_in_flight_batches: int = 0):
         super().__init__(c)
 
+        if (message_format not in ("json", "avro", "avro-confluent")):
+            raise ValueError("Unknown message format '{}'. Must be one of 'json', 'avro' or "
+                             "'avro-confluent'".format(message_format))
+
+        if (message_format == "avro" and not avro_schema):
+            raise ValueError("The 'avro' message format requires an Avro schema")
+
+        if (message_format == "avro-confluent" and not (avro_schema or schema_registry_url)):
+            raise ValueError("The 'avro-confluent' message format requires an Avro schema or a schema registry URL")
+
+        unknown_metadata_columns = set(metadata_columns or []) - {"_key", "_ts", "_partition", "_offset"}
+
+        if (unknown_metadata_columns):
+            raise ValueError("Unknown Kafka metadata columns {}. Must be any of '_key', '_ts', '_partition' or "
+                             "'_offset'".format(sorted(unknown_metadata_columns)))
+
         self._consumer_conf = {
             'bootstrap.servers': bootstrap_servers, 'group.id': group_id, 'session.timeout.ms': "60000"
         }
 
         self._input_topic = input_topic
+
+        if (isinstance(input_topic, str)):
+            self._topics = [topic.strip() for topic in input_topic.split(",") if topic.strip()]
+        else:
+            self._topics = list(input_topic)
+
+        if (len(self._topics) == 0):
+            raise ValueError("At least one input topic is required")
+
         self._poll_interval = poll_interval
         self._max_batch_size = c.pipeline_batch_size
         self._max_concurrent = c.num_threads
         self._disable_commit = disable_commit
         self._disable_pre_filtering = disable_pre_filtering
+        self._max_batch_bytes = max_batch_bytes
+        self._adaptive_batching = adaptive_batching
+        self._commit_on_completion = commit_on_completion
+        self._topic_column = topic_column
+        self._start_timestamp_ms = start_timestamp_ms
+        self._start_offsets = {}
+        self._stop_timestamp_ms = stop_timestamp_ms
+        self._device_id = device_id
+        self._drop_null_column = drop_null_column
+        self._schema = dict(schema) if schema else {}
+        self._schema_batches = schema_batches
+        self._message_format = message_format
+        self._avro_schema = avro_schema
+        self._schema_registry_url = schema_registry_url
+        self._metadata_columns = list(metadata_columns or [])
+        self._max_in_flight_batches = max_in_flight_batches
+
+        for (key, offset) in (start_offsets or {}).items():
+            if (isinstance(key, str)):
+                (offset_topic, _, partition) = key.rpartition(":")
+            else:
+                (offset_topic, partition) = key
+
+            if (not offset_topic or not str(partition).isdigit()):
+                raise ValueError("Start offsets must be keyed by (topic, partition) or 'topic:partition', "
+                                 "got {}".format(key))
+
+            self._start_offsets["{}:{}".format(offset_topic, int(partition))] = int(offset)
+
+        if (start_timestamp_ms is not None and stop_timestamp_ms is not None
+                and stop_timestamp_ms <= start_timestamp_ms):
+            raise ValueError("stop_timestamp_ms must be after start_timestamp_ms")
+
         self._client = None
 
         # What gets passed to streamz kafka
-        topic = self._input_topic
+        topic = self._topics[0]
         consumer_params = self._consumer_conf
         poll_interval = self._poll_interval
         npartitions = None
@@ -270,7 +405,23 @@ class KafkaSourceStage(SingleOutputSource):
         # Unpack
         kafka_params, topic, partition, keys, low, high = x
 
-        gdf = self._read_gdf(kafka_params, topic=topic, partition=partition, lines=True, start=low, end=high + 1)
+        gdf = self._read_gdf(kafka_params,
+                             topic=topic,
+                             partition=partition,
+                             lines=True,
+                             start=low,
+                             end=high + 1,
+                             dtype=self._schema or None)
+
+        for (name, dtype) in self._schema.items():
+            if (name not in gdf.columns):
+                gdf[name] = cudf.Series([None] * len(gdf), dtype=dtype)
+
+        if (self._topic_column is not None):
+            gdf[self._topic_column] = topic
+
+        if (self._drop_null_column is not None):
+            gdf = gdf[~gdf[self._drop_null_column].isna()]
 
         return MessageMeta(gdf)
 
@@ -283,7 +434,8 @@ class KafkaSourceStage(SingleOutputSource):
                   end=0,
                   batch_timeout=10000,
                   delimiter="\n",
-                  message_format="json"):
+                  message_format="json",
+                  dtype=None):
         """
         Replicates `custreamz.Consumer.read_gdf` function which does not work for some reason.
         """
@@ -315,7 +467,12 @@ class KafkaSourceStage(SingleOutputSource):
                 "parquet": cudf.io.read_parquet,
             }
 
-            result = cudf_readers[message_format](kafka_datasource, engine="cudf", lines=lines)
+            reader_kwargs = {}
+
+            if (dtype is not None):
+                reader_kwargs["dtype"] = dtype
+
+            result = cudf_readers[message_format](kafka_datasource, engine="cudf", lines=lines, **reader_kwargs)
 
             return cudf.DataFrame(data=result._data, index=result._index)
         except Exception:
@@ -334,13 +491,42 @@ class KafkaSourceStage(SingleOutputSource):
             source = neos.KafkaSourceStage(seg,
                                            self.unique_name,
                                            self._max_batch_size,
-                                           self._topic,
+                                           self._topics,
                                            int(self._poll_interval * 1000),
                                            self._consumer_params,
                                            self._disable_commit,
-                                           self._disable_pre_filtering)
+                                           self._disable_pre_filtering,
+                                           self._max_batch_bytes,
+                                           self._adaptive_batching,
+                                           self._commit_on_completion,
+                                           self._topic_column or "",
+                                           -1 if self._start_timestamp_ms is None else self._start_timestamp_ms,
+                                           self._start_offsets,
+                                           -1 if self._stop_timestamp_ms is None else self._stop_timestamp_ms,
+                                           -1 if self._device_id is None else self._device_id,
+                                           self._drop_null_column or "",
+                                           self._config.output_column_types(),
+                                           self._schema,
+                                           self._schema_batches,
+                                           self._message_format,
+                                           self._avro_schema or "",
+                                           self._schema_registry_url or "",
+                                           self._metadata_columns,
+                                           self._max_in_flight_batches)
             source.concurrency = self._max_concurrent
         else:
+            if (len(self._topics) > 1 or self._topics[0].startswith("^")):
+                raise NotImplementedError("Reading several topics requires the C++ implementation")
+
+            if (self._start_timestamp_ms is not None or self._start_offsets or self._stop_timestamp_ms is not None):
+                raise NotImplementedError("Replaying from a timestamp or offsets requires the C++ implementation")
+
+            if (self._message_format != "json"):
+                raise NotImplementedError("Decoding Avro messages requires the C++ implementation")
+
+            if (self._metadata_columns):
+                raise NotImplementedError("Kafka metadata columns require the C++ implementation")
+
             source = seg.make_source(self.unique_name, self._source_generator)
 
         source.concurrency = self._max_concurrent
@@ -0,0 +1,145 @@
+# Copyright (c) 2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import typing
+
+import neo
+
+import cudf
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.config import CppConfig
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.single_output_source import SingleOutputSource
+from morpheus.pipeline.stream_pair import StreamPair
+
+logger = logging.getLogger(__name__)
+
+BATCH_SIZE_DISTRIBUTIONS = ["fixed", "uniform", "exponential"]
+
+
+class LoadGeneratorSourceStage(SingleOutputSource):
+    """
+    Emit synthetic batches of rows at a target rate, cycling through the rows of a template, to measure the latency and
+    throughput of a pipeline under a known load.
+
+    Batches are due at fixed points of a schedule set by `rows_per_second`. When the pipeline falls behind, batches are
+    emitted as soon as it accepts them and their trace is stamped with the time they were due, so the reported latency
+    includes the time spent waiting. Each batch gets a fresh index counting the generated rows. Requires the C++
+    implementation.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    filename : str, default = None
+        File whose rows are used as the template. Exactly one of `filename` and `template` must be given.
+    template : `cudf.DataFrame` or `morpheus.messages.MessageMeta`, default = None
+        Rows used as the template, copied once when the pipeline is built.
+    rows_per_second : float, default = 0
+        Target rate. Zero emits batches as fast as the pipeline accepts them.
+    batch_size : int, default = None
+        Mean number of rows per batch. Defaults to `pipeline_batch_size`.
+    distribution : str, default = "fixed"
+        Distribution of the batch sizes, one of "fixed", "uniform" or "exponential".
+    jitter : float, default = 0
+        Fraction, between 0 and 1, of its own interval by which each batch is randomly early or late.
+    mutate_columns : typing.List[str], default = None
+        String columns made unique in every batch by appending the row index, so caches keyed on values never hit.
+    total_rows : int, default = 0
+        Number of rows to emit before completing, zero for no limit.
+    duration_sec : float, default = 0
+        Seconds after which the stage completes, zero for no limit.
+    trace_all : bool, default = False
+        Trace every batch, rather than following the trace sample interval.
+    seed : int, default = 0
+        Seed of the batch sizes and jitter, zero picks a random seed.
+
+    """
+
+    def __init__(self,
+                 c: Config,
+                 filename: str = None,
+                 template: typing.Union[cudf.DataFrame, MessageMeta] = None,
+                 rows_per_second: float = 0,
+                 batch_size: int = None,
+                 distribution: str = "fixed",
+                 jitter: float = 0,
+                 mutate_columns: typing.List[str] = None,
+                 total_rows: int = 0,
+                 duration_sec: float = 0,
+                 trace_all: bool = False,
+                 seed: int = 0):
+        super().__init__(c)
+
+        if ((filename is None) == (template is None)):
+            raise ValueError("Exactly one of filename and template must be given")
+
+        if (distribution not in BATCH_SIZE_DISTRIBUTIONS):
+            raise ValueError("distribution must be one of {}".format(BATCH_SIZE_DISTRIBUTIONS))
+
+        if (rows_per_second < 0 or total_rows < 0 or duration_sec < 0):
+            raise ValueError("rows_per_second, total_rows and duration_sec must not be negative")
+
+        if (jitter < 0 or jitter > 1):
+            raise ValueError("jitter must be between 0 and 1")
+
+        self._filename = filename
+        self._template = template
+        self._rows_per_second = rows_per_second
+        self._batch_size = batch_size if batch_size is not None else c.pipeline_batch_size
+        self._distribution = distribution
+        self._jitter = jitter
+        self._mutate_columns = list(mutate_columns) if mutate_columns is not None else []
+        self._total_rows = total_rows
+        self._duration_sec = duration_sec
+        self._trace_all = trace_all
+        self._seed = seed
+
+        if (self._batch_size < 1):
+            raise ValueError("batch_size must be greater than 0")
+
+    @property
+    def name(self) -> str:
+        return "from-load-generator"
+
+    def _build_source(self, seg: neo.Segment) -> StreamPair:
+
+        if (not CppConfig.get_should_use_cpp()):
+            raise NotImplementedError("Generating load requires the C++ implementation")
+
+        kwargs = dict(rows_per_second=float(self._rows_per_second),
+                      batch_size=self._batch_size,
+                      distribution=self._distribution,
+                      jitter=float(self._jitter),
+                      mutate_columns=self._mutate_columns,
+                      total_rows=self._total_rows,
+                      duration_sec=float(self._duration_sec),
+                      trace_all=self._trace_all,
+                      seed=self._seed,
+                      output_columns=self._config.output_column_types())
+
+        if (self._filename is not None):
+            out_stream = neos.LoadGeneratorSourceStage(seg, self.unique_name, filename=self._filename, **kwargs)
+        else:
+            template = self._template
+
+            if (isinstance(template, cudf.DataFrame)):
+                template = MessageMeta(template)
+
+            out_stream = neos.LoadGeneratorSourceStage(seg, self.unique_name, template=template, **kwargs)
+
+        return out_stream, MessageMeta
@@ -0,0 +1,144 @@
+# Copyright (c) 2021-2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import concurrent.futures
+import glob
+import logging
+import typing
+
+import neo
+
+import morpheus._lib.stages as neos
+from morpheus._lib.file_types import FileTypes
+from morpheus.config import Config
+from morpheus.config import CppConfig
+from morpheus.io.deserializers import read_file_to_df
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.single_output_source import SingleOutputSource
+from morpheus.pipeline.stream_pair import StreamPair
+
+logger = logging.getLogger(__name__)
+
+
+class MultiFileSourceStage(SingleOutputSource):
+    """
+    Source stage which reads many files, emitting one message per file. Several files are read concurrently so
+    replaying a directory of small files is limited by the storage rather than by reading one file at a time.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    filenames : typing.List[str]
+        Files to read. Entries containing `*`, `?` or `[` are expanded as globs, in sorted order. A glob which matches
+        no files is an error.
+    file_type : `morpheus._lib.file_types.FileTypes`, default = 'auto'
+        Indicates what type of file to read. Specifying 'auto' will determine the file type from the extension.
+        Supported extensions: 'json', 'csv'
+    prefetch : int, default = 4
+        Number of files read concurrently, which is also the most files held in memory before being emitted.
+    ordered : bool, default = True
+        Emit the files in the order of `filenames`. Otherwise each file is emitted as soon as it has been read.
+    filter_null : bool, default = True
+        Whether or not to filter rows with null 'data' column. Null values in the 'data' column can cause issues down
+        the line with processing. Setting this to True is recommended.
+    """
+
+    def __init__(self,
+                 c: Config,
+                 filenames: typing.List[str],
+                 file_type: FileTypes = FileTypes.Auto,
+                 prefetch: int = 4,
+                 ordered: bool = True,
+                 filter_null: bool = True):
+
+        super().__init__(c)
+
+        if (prefetch < 1):
+            raise ValueError("prefetch must be greater than 0")
+
+        self._filenames = self._expand_filenames(filenames)
+        self._file_type = file_type
+        self._prefetch = prefetch
+        self._ordered = ordered
+        self._filter_null = filter_null
+
+    @property
+    def name(self) -> str:
+        return "from-multi-file"
+
+    @staticmethod
+    def _expand_filenames(patterns: typing.List[str]) -> typing.List[str]:
+
+        filenames = []
+
+        for pattern in patterns:
+
+            if (not glob.has_magic(pattern)):
+                filenames.append(pattern)
+                continue
+
+            matches = sorted(glob.glob(pattern))
+
+            if (len(matches) == 0):
+                raise ValueError("No files match '{}'".format(pattern))
+
+            filenames.extend(matches)
+
+        return filenames
+
+    def _build_source(self, seg: neo.Segment) -> StreamPair:
+
+        if CppConfig.get_should_use_cpp():
+            out_stream = neos.MultiFileSourceStage(seg,
+                                                   self.unique_name,
+                                                   self._filenames,
+                                                   self._prefetch,
+                                                   self._ordered,
+                                                   self._config.output_column_types())
+        else:
+            out_stream = seg.make_source(self.unique_name, self._generate_frames())
+
+        return out_stream, MessageMeta
+
+    def _read_file(self, filename: str):
+        return read_file_to_df(filename, self._file_type, filter_nulls=self._filter_null, df_type="cudf")
+
+    def _generate_frames(self):
+
+        with concurrent.futures.ThreadPoolExecutor(max_workers=self._prefetch) as executor:
+
+            remaining = iter(self._filenames)
+            pending = []
+
+            def submit_next():
+                filename = next(remaining, None)
+
+                if (filename is not None):
+                    pending.append(executor.submit(self._read_file, filename))
+
+            for _ in range(self._prefetch):
+                submit_next()
+
+            while (len(pending) > 0):
+
+                if (self._ordered):
+                    done = pending.pop(0)
+                else:
+                    done = next(concurrent.futures.as_completed(pending))
+                    pending.remove(done)
+
+                submit_next()
+
+                yield MessageMeta(done.result())
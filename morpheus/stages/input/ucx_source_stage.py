@@ -0,0 +1,76 @@
+# Copyright (c) 2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+
+import neo
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.config import CppConfig
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.single_output_source import SingleOutputSource
+from morpheus.pipeline.stream_pair import StreamPair
+
+logger = logging.getLogger(__name__)
+
+
+class UcxSourceStage(SingleOutputSource):
+    """
+    Receive the messages sent by the `WriteToUcxStage` of pipelines in other processes or on other hosts.
+
+    Every received table is emitted as its own `MessageMeta` as soon as it arrives. The stage completes once every
+    sender has completed, and fails if a sender disconnects first. Requires the C++ implementation and a library built
+    with UCX, see `morpheus._lib.common.ucx_available`.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    port : int
+        Port to listen on.
+    address : str, default = "0.0.0.0"
+        Local address to listen on, "0.0.0.0" listens on every interface.
+    num_senders : int, default = 1
+        Number of sending pipelines.
+
+    """
+
+    def __init__(self, c: Config, port: int, address: str = "0.0.0.0", num_senders: int = 1):
+        super().__init__(c)
+
+        if (num_senders < 1):
+            raise ValueError("num_senders must be greater than 0")
+
+        self._port = port
+        self._address = address
+        self._num_senders = num_senders
+
+    @property
+    def name(self) -> str:
+        return "from-ucx"
+
+    def _build_source(self, seg: neo.Segment) -> StreamPair:
+
+        if (not CppConfig.get_should_use_cpp()):
+            raise NotImplementedError("Receiving messages with UCX requires the C++ implementation")
+
+        out_stream = neos.UcxSourceStage(seg,
+                                         self.unique_name,
+                                         self._address,
+                                         self._port,
+                                         self._num_senders,
+                                         self._config.output_column_types())
+
+        return out_stream, MessageMeta
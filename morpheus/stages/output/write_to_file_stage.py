@@ -12,8 +12,12 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import gzip
 import os
+import shutil
+import time
 import typing
+from concurrent.futures import ThreadPoolExecutor
 
 import neo
 import neo.core.operators as ops
@@ -31,6 +35,31 @@ from morpheus.pipeline.single_port_stage import SinglePortStage
 from morpheus.pipeline.stream_pair import StreamPair
 
 
+def _rotation_pattern(filename: str) -> str:
+    """
+    Filenames without an `{index}` or `{timestamp}` placeholder get `.{index}` inserted before the extension.
+    """
+    if ("{index}" in filename or "{timestamp}" in filename):
+        return filename
+
+    root, ext = os.path.splitext(filename)
+
+    return root + ".{index}" + ext
+
+
+def _expand_rotation_pattern(pattern: str, index: int) -> str:
+    timestamp = time.strftime("%Y%m%dT%H%M%SZ", time.gmtime())
+
+    return pattern.replace("{index}", "{:05d}".format(index)).replace("{timestamp}", timestamp)
+
+
+def _gzip_file(filename: str):
+    with open(filename, "rb") as in_file, gzip.open(filename + ".gz", "wb") as out_file:
+        shutil.copyfileobj(in_file, out_file)
+
+    os.remove(filename)
+
+
 class WriteToFileStage(SinglePortStage):
     """
     This class writes messages to a file. This class does not buffer or keep the file open between messages.
@@ -45,11 +74,49 @@ class WriteToFileStage(SinglePortStage):
     overwrite : bool
         Overwrite file if exists. Will generate an error otherwise.
     file_type : `morpheus._lib.file_types.FileTypes`, optional
-        File type of output (FileTypes.JSON, FileTypes.CSV, FileTypes.Auto), by default FileTypes.Auto.
+        File type of output (FileTypes.JSON, FileTypes.CSV, FileTypes.PARQUET, FileTypes.ORC, FileTypes.ARROW,
+        FileTypes.Auto), by default FileTypes.Auto. The columnar types keep a single writer open for the whole
+        pipeline, appending each message as a row group (stripe, record batch), and do not write the index.
+    compression : str, optional
+        Compression codec. One of "none" or "snappy" for PARQUET and ORC, "none", "lz4" or "zstd" for ARROW. By
+        default None, which uses the writer's default. CSV and JSON accept "none", "gzip" or "zstd", and are
+        compressed on the GPU before being copied back to the host. This requires the C++ implementation built with
+        nvCOMP, and cannot be combined with `rotate_compression`. `rotate_bytes` then counts compressed bytes.
+    queue_size : int, optional
+        CSV and JSON only. When greater than 0 the C++ stage formats each message on the pipeline thread and hands it
+        to a dedicated writer thread through a queue of this many messages, so a slow disk only stalls upstream stages
+        once the queue is full. By default 0, which writes synchronously.
+    flush_policy : str, optional
+        One of "none" (only write full blocks), "flush" (also write whenever the queue runs empty) or "fsync" (flush
+        followed by an fdatasync). Only used when `queue_size` is greater than 0, by default "flush". The Python
+        implementation writes synchronously and applies the policy after every message.
+    rotate_bytes : int, optional
+        When greater than 0, a new file is started once the current one holds at least this many bytes. Messages are
+        never split between files and every CSV file gets its own header. By default 0.
+    rotate_seconds : int, optional
+        When greater than 0, a new file is started once the current one has been open this long. Only checked when a
+        message arrives. By default 0.
+    rotate_compression : str, optional
+        "gzip" compresses every finished file to `<filename>.gz` on a background thread, by default None.
+
+    When rotating, `filename` is a template: `{index}` is replaced by the zero padded index of the file and
+    `{timestamp}` by the UTC time the file was started. Without either placeholder `.{index}` is inserted before the
+    extension, e.g. `alerts.csv` becomes `alerts.00000.csv`, `alerts.00001.csv`, etc. The Python implementation only
+    supports rotating CSV and JSON files.
 
     """
 
-    def __init__(self, c: Config, filename: str, overwrite: bool, file_type: FileTypes = FileTypes.Auto):
+    def __init__(self,
+                 c: Config,
+                 filename: str,
+                 overwrite: bool,
+                 file_type: FileTypes = FileTypes.Auto,
+                 compression: str = None,
+                 queue_size: int = 0,
+                 flush_policy: str = "flush",
+                 rotate_bytes: int = 0,
+                 rotate_seconds: int = 0,
+                 rotate_compression: str = None):
 
         super().__init__(c)
 
@@ -68,6 +135,37 @@ class WriteToFileStage(SinglePortStage):
         if (self._file_type == FileTypes.Auto):
             self._file_type = determine_file_type(self._output_file)
 
+        self._compression = compression if compression is not None else ""
+
+        is_text = self._file_type in (FileTypes.CSV, FileTypes.JSON)
+
+        if (is_text and self._compression not in ("", "none", "gzip", "zstd")):
+            raise ValueError("Unknown GPU compression codec '{}'. Must be one of 'gzip' or 'zstd'".format(
+                self._compression))
+
+        if (queue_size < 0):
+            raise ValueError("queue_size must be greater than or equal to 0")
+
+        if (flush_policy not in ("none", "flush", "fsync")):
+            raise ValueError("Unknown flush policy '{}'. Must be one of 'none', 'flush' or 'fsync'".format(flush_policy))
+
+        self._queue_size = queue_size
+        self._flush_policy = flush_policy
+
+        if (rotate_bytes < 0 or rotate_seconds < 0):
+            raise ValueError("rotate_bytes and rotate_seconds must be greater than or equal to 0")
+
+        self._rotate_bytes = rotate_bytes
+        self._rotate_seconds = rotate_seconds
+        self._rotate_compression = rotate_compression if rotate_compression is not None else ""
+
+        if (self._rotate_compression not in ("", "none", "gzip")):
+            raise ValueError("Unsupported rotate_compression '{}'. Must be one of 'none' or 'gzip'".format(
+                self._rotate_compression))
+
+        if (self._compression in ("gzip", "zstd") and self._rotate_compression == "gzip"):
+            raise ValueError("rotate_compression cannot be combined with compression")
+
         self._is_first = True
 
     @property
@@ -104,34 +202,160 @@ class WriteToFileStage(SinglePortStage):
 
         return output_strs
 
+    def _open_columnar_writer(self, schema):
+        compression = self._compression if self._compression != "" else None
+
+        if (self._file_type == FileTypes.PARQUET):
+            import pyarrow.parquet
+
+            return pyarrow.parquet.ParquetWriter(self._output_file, schema, compression=compression or "snappy")
+        elif (self._file_type == FileTypes.ORC):
+            import pyarrow.orc
+
+            # Older versions of pyarrow don't accept a compression argument
+            if (compression is None):
+                return pyarrow.orc.ORCWriter(self._output_file)
+
+            return pyarrow.orc.ORCWriter(self._output_file, compression=compression)
+        else:
+            import pyarrow.ipc
+
+            options = pyarrow.ipc.IpcWriteOptions(compression=None if compression == "none" else compression)
+
+            return pyarrow.ipc.new_file(self._output_file, schema, options=options)
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
         stream = input_stream[0]
 
         # Sink to file
         if (self._build_cpp_node()):
-            to_file = neos.WriteToFileStage(seg, self.unique_name, self._output_file, "w", self._file_type)
+            to_file = neos.WriteToFileStage(seg,
+                                            self.unique_name,
+                                            self._output_file,
+                                            "w",
+                                            self._file_type,
+                                            self._compression,
+                                            self._queue_size,
+                                            self._flush_policy,
+                                            self._rotate_bytes,
+                                            self._rotate_seconds,
+                                            self._rotate_compression)
+        elif (self._file_type in (FileTypes.PARQUET, FileTypes.ORC, FileTypes.ARROW)):
+
+            if (self._rotate_bytes > 0 or self._rotate_seconds > 0 or self._rotate_compression == "gzip"):
+                raise NotImplementedError("Rotating parquet, orc and arrow files requires the C++ implementation")
+
+            def node_fn(input: neo.Observable, output: neo.Subscriber):
+
+                os.makedirs(os.path.realpath(os.path.dirname(self._output_file)), exist_ok=True)
+
+                writer = None
+
+                def write_to_file(x: MessageMeta):
+                    nonlocal writer
+
+                    table = x.df.to_arrow(preserve_index=False)
+
+                    if (writer is None):
+                        writer = self._open_columnar_writer(table.schema)
+
+                    if (self._file_type == FileTypes.ORC):
+                        writer.write(table)
+                    else:
+                        writer.write_table(table)
+
+                    return x
+
+                try:
+                    input.pipe(ops.map(write_to_file)).subscribe(output)
+                finally:
+                    if (writer is not None):
+                        writer.close()
+
+            to_file = seg.make_node_full(self.unique_name, node_fn)
         else:
 
+            if (self._compression in ("gzip", "zstd")):
+                raise NotImplementedError("Compressing csv and json files requires the C++ implementation")
+
             def node_fn(input: neo.Observable, output: neo.Subscriber):
 
                 # Ensure our directory exists
                 os.makedirs(os.path.realpath(os.path.dirname(self._output_file)), exist_ok=True)
 
-                # Open up the file handle
-                with open(self._output_file, "a") as out_file:
+                is_rotating = self._rotate_bytes > 0 or self._rotate_seconds > 0
+                pattern = _rotation_pattern(self._output_file) if is_rotating else self._output_file
+
+                compressor = ThreadPoolExecutor(max_workers=1) if self._rotate_compression == "gzip" else None
+                compressed = []
+
+                file_index = 0
 
-                    def write_to_file(x: MessageMeta):
+                def open_next():
+                    nonlocal file_index
 
-                        lines = self._convert_to_strings(x.df)
+                    filename = _expand_rotation_pattern(pattern, file_index) if is_rotating else pattern
+                    file_index += 1
 
-                        out_file.writelines(lines)
+                    # The constructor only checked the template, every rotated file is checked as it is opened
+                    if (is_rotating and os.path.exists(filename) and not self._overwrite):
+                        raise FileExistsError(
+                            "Cannot output classifications to '{}'. File exists and overwrite = False".format(filename))
 
-                        return x
+                    # Every file gets its own header
+                    self._is_first = True
 
+                    return filename, open(filename, "w"), time.monotonic(), 0
+
+                filename, out_file, opened, messages_written = open_next()
+
+                def close_current():
+                    out_file.close()
+
+                    if (compressor is not None):
+                        compressed.append(compressor.submit(_gzip_file, filename))
+
+                def should_rotate():
+                    if (messages_written == 0):
+                        return False
+
+                    if (self._rotate_bytes > 0 and out_file.tell() >= self._rotate_bytes):
+                        return True
+
+                    return self._rotate_seconds > 0 and time.monotonic() - opened >= self._rotate_seconds
+
+                def write_to_file(x: MessageMeta):
+                    nonlocal filename, out_file, opened, messages_written
+
+                    if (should_rotate()):
+                        close_current()
+                        filename, out_file, opened, messages_written = open_next()
+
+                    lines = self._convert_to_strings(x.df)
+
+                    out_file.writelines(lines)
+                    messages_written += 1
+
+                    if (self._queue_size > 0 and self._flush_policy != "none"):
+                        out_file.flush()
+
+                        if (self._flush_policy == "fsync"):
+                            os.fdatasync(out_file.fileno())
+
+                    return x
+
+                try:
                     input.pipe(ops.map(write_to_file)).subscribe(output)
+                finally:
+                    close_current()
+
+                    if (compressor is not None):
+                        compressor.shutdown(wait=True)
 
-                # File should be closed by here
+                        # Raise any compression error
+                        for future in compressed:
+                            future.result()
 
             to_file = seg.make_node_full(self.unique_name, node_fn)
 
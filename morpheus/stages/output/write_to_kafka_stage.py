@@ -20,6 +20,7 @@ import confluent_kafka as ck
 import neo
 from neo.core import operators as ops
 
+import morpheus._lib.stages as neos
 from morpheus.config import Config
 from morpheus.io import serializers
 from morpheus.messages import MessageMeta
@@ -41,13 +42,17 @@ class WriteToKafkaStage(SinglePortStage):
         Kafka cluster bootstrap servers separated by comma.
     output_topic : str
         Output kafka topic.
+    kafka_conf : dict, default = None
+        Additional producer configuration, passed to librdkafka. With the C++ implementation 'linger.ms' and
+        'batch.num.messages' default to values favoring throughput.
 
     """
 
-    def __init__(self, c: Config, bootstrap_servers: str, output_topic: str):
+    def __init__(self, c: Config, bootstrap_servers: str, output_topic: str, kafka_conf: dict = None):
         super().__init__(c)
 
-        self._kafka_conf = {'bootstrap.servers': bootstrap_servers}
+        self._kafka_conf = {} if kafka_conf is None else dict(kafka_conf)
+        self._kafka_conf['bootstrap.servers'] = bootstrap_servers
 
         self._output_topic = output_topic
         self._poll_time = 0.2
@@ -69,11 +74,27 @@ class WriteToKafkaStage(SinglePortStage):
         """
         return (MessageMeta, )
 
+    def supports_cpp_node(self):
+        return True
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
         # Convert the messages to rows of strings
         stream = input_stream[0]
 
+        if (self._build_cpp_node()):
+            # Rows are formatted, produced and their deliveries tracked in C++. librdkafka takes every setting as a
+            # string
+            kafka_conf = {
+                key: (str(value).lower() if isinstance(value, bool) else str(value))
+                for (key, value) in self._kafka_conf.items()
+            }
+
+            node = neos.WriteToKafkaStage(seg, self.unique_name, self._output_topic, kafka_conf)
+            seg.make_edge(stream, node)
+
+            return node, input_stream[1]
+
         def node_fn(input: neo.Observable, output: neo.Subscriber):
 
             producer = ck.Producer(self._kafka_conf)
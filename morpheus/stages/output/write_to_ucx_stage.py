@@ -0,0 +1,83 @@
+# Copyright (c) 2022, NVIDIA CORPORATION.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import logging
+import typing
+
+import neo
+
+import morpheus._lib.stages as neos
+from morpheus.config import Config
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.single_port_stage import SinglePortStage
+from morpheus.pipeline.stream_pair import StreamPair
+
+logger = logging.getLogger(__name__)
+
+
+class WriteToUcxStage(SinglePortStage):
+    """
+    Send messages to a pipeline in another process or on another host, received by a `UcxSourceStage`.
+
+    The columns are sent straight from device memory over the transports UCX selects, NVLink between devices of the
+    same host, RDMA with GPUDirect between hosts, TCP otherwise. Transports can be restricted with the UCX environment
+    variables, e.g. `UCX_TLS`. Messages are passed through unchanged once sent. Requires the C++ implementation and a
+    library built with UCX, see `morpheus._lib.common.ucx_available`.
+
+    Parameters
+    ----------
+    c : `morpheus.config.Config`
+        Pipeline configuration instance.
+    host : str
+        Host of the receiving pipeline.
+    port : int
+        Port the `UcxSourceStage` of the receiving pipeline listens on.
+
+    """
+
+    def __init__(self, c: Config, host: str, port: int):
+        super().__init__(c)
+
+        self._host = host
+        self._port = port
+
+    @property
+    def name(self) -> str:
+        return "to-ucx"
+
+    def accepted_types(self) -> typing.Tuple:
+        """
+        Returns accepted input types for this stage.
+
+        Returns
+        -------
+        typing.Tuple(`morpheus.pipeline.messages.MessageMeta`, )
+            Accepted input types.
+
+        """
+        return (MessageMeta, )
+
+    def supports_cpp_node(self):
+        return True
+
+    def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
+
+        if (not self._build_cpp_node()):
+            raise NotImplementedError("Sending messages with UCX requires the C++ implementation")
+
+        node = neos.WriteToUcxStage(seg, self.unique_name, self._host, self._port)
+        seg.make_edge(input_stream[0], node)
+
+        # Return input unchanged
+        return node, input_stream[1]
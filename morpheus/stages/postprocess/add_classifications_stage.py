@@ -15,7 +15,9 @@
 import logging
 import typing
 
+import cupy as cp
 import neo
+from neo.core import operators as ops
 
 import morpheus._lib.stages as neos
 from morpheus.config import Config
@@ -44,14 +46,24 @@ class AddClassificationsStage(SinglePortStage):
         the Config.class_labels property.
     prefix: str, default = ""
         A prefix to append to each label.
+    filter_threshold: float, default = None
+        When set, also filter the output like `FilterDetectionsStage` using this threshold. This replaces a following
+        `FilterDetectionsStage` and, with the C++ implementation, finds both the labels and the detections in a single
+        pass over the probabilities.
 
     """
 
-    def __init__(self, c: Config, threshold: float = 0.5, labels: typing.List[str] = None, prefix: str = ""):
+    def __init__(self,
+                 c: Config,
+                 threshold: float = 0.5,
+                 labels: typing.List[str] = None,
+                 prefix: str = "",
+                 filter_threshold: float = None):
         super().__init__(c)
 
         self._feature_length = c.feature_length
         self._threshold = threshold
+        self._filter_threshold = filter_threshold
         self._prefix = prefix
         self._class_labels = c.class_labels
         self._labels = labels if labels is not None and len(labels) > 0 else c.class_labels
@@ -69,6 +81,10 @@ class AddClassificationsStage(SinglePortStage):
 
         assert len(self._idx2label) > 0, "No labels were added to the stage"
 
+        # The labels are always bool, so the sources of this pipeline can create them up front. Scoped to this Config
+        for label in self._idx2label.values():
+            c.output_columns.setdefault(label, "bool")
+
     @property
     def name(self) -> str:
         return "add-class"
@@ -104,15 +120,63 @@ class AddClassificationsStage(SinglePortStage):
         # Return passthrough
         return x
 
+    def _add_labels_and_filter(self, x: MultiResponseProbsMessage) -> typing.List[MultiResponseProbsMessage]:
+
+        x = self._add_labels(x)
+
+        # Same as FilterDetectionsStage.filter
+        output_list = []
+
+        detections = (x.probs > self._filter_threshold).any(axis=1)
+
+        # Surround in False to ensure we get an even number of pairs
+        detections = cp.concatenate([cp.array([False]), detections, cp.array([False])])
+
+        true_pairs = cp.where(detections[1:] != detections[:-1])[0].reshape((-1, 2))
+
+        for pair in true_pairs:
+            pair = tuple(pair.tolist())
+            mess_count = pair[1] - pair[0]
+
+            # Filter empty message groups
+            if (mess_count == 0):
+                continue
+
+            output_list.append(
+                MultiResponseProbsMessage(x.meta,
+                                          mess_offset=x.mess_offset + pair[0],
+                                          mess_count=mess_count,
+                                          memory=x.memory,
+                                          offset=pair[0],
+                                          count=mess_count))
+
+        return output_list
+
+    def supports_fusion(self) -> bool:
+        return CppConfig.get_should_use_cpp()
+
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        node = neos.AddClassificationsStage(seg,
+                                            self.unique_name,
+                                            self._threshold,
+                                            len(self._class_labels),
+                                            self._idx2label,
+                                            self._filter_threshold)
+
+        return node, MultiResponseProbsMessage
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
+        # Convert list back to single MultiResponseProbsMessage
+        def flatten_fn(input: neo.Observable, output: neo.Subscriber):
+
+            input.pipe(ops.map(self._add_labels_and_filter), ops.flatten()).subscribe(output)
+
         # Convert the messages to rows of strings
         if CppConfig.get_should_use_cpp():
-            stream = neos.AddClassificationsStage(seg,
-                                                  self.unique_name,
-                                                  self._threshold,
-                                                  len(self._class_labels),
-                                                  self._idx2label)
+            stream = self._build_fusable_node(seg, input_stream[1])[0]
+        elif self._filter_threshold is not None:
+            stream = seg.make_node_full(self.unique_name, flatten_fn)
         else:
             stream = seg.make_node(self.unique_name, self._add_labels)
 
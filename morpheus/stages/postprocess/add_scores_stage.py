@@ -101,11 +101,18 @@ class AddScoresStage(SinglePortStage):
         # Return passthrough
         return x
 
+    def supports_fusion(self) -> bool:
+        return CppConfig.get_should_use_cpp()
+
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        # Return input type unchanged
+        return neos.AddScoresStage(seg, self.unique_name, len(self._class_labels), self._idx2label), input_type
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
         # Convert the messages to rows of strings
         if CppConfig.get_should_use_cpp():
-            stream = neos.AddScoresStage(seg, self.unique_name, len(self._class_labels), self._idx2label)
+            stream = self._build_fusable_node(seg, input_stream[1])[0]
         else:
             stream = seg.make_node(self.unique_name, self._add_labels)
 
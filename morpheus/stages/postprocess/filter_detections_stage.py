@@ -22,7 +22,9 @@ from neo.core import operators as ops
 import morpheus._lib.stages as neos
 from morpheus.config import Config
 from morpheus.config import CppConfig
+from morpheus.messages import MessageMeta
 from morpheus.messages import MultiResponseProbsMessage
+from morpheus.messages import ResponseMemoryProbs
 from morpheus.pipeline.single_port_stage import SinglePortStage
 from morpheus.pipeline.stream_pair import StreamPair
 
@@ -39,14 +41,18 @@ class FilterDetectionsStage(SinglePortStage):
         Pipeline configuration instance.
     threshold : float
         Threshold to classify, default is 0.5.
+    copy : bool
+        When True, the detected rows are copied into a single new message instead of emitting a slice of the input
+        for each contiguous run of detections. Default is False.
 
     """
 
-    def __init__(self, c: Config, threshold: float = 0.5):
+    def __init__(self, c: Config, threshold: float = 0.5, copy: bool = False):
         super().__init__(c)
 
         # Probability to consider a detection
         self._threshold = threshold
+        self._copy = copy
 
     @property
     def name(self) -> str:
@@ -114,15 +120,58 @@ class FilterDetectionsStage(SinglePortStage):
 
         return output_list
 
+    def filter_copy(self, x: MultiResponseProbsMessage) -> typing.List[MultiResponseProbsMessage]:
+        """
+        This function uses a threshold value to filter the messages, copying the detected rows into a new message.
+
+        Parameters
+        ----------
+        x : `morpheus.pipeline.messages.MultiResponseProbsMessage`
+            Response message with probabilities calculated from inference results.
+
+        Returns
+        -------
+        typing.List[`morpheus.pipeline.messages.MultiResponseProbsMessage`]
+            List containing the single filtered message, or empty if nothing was detected.
+
+        """
+        detections = (x.probs > self._threshold).any(axis=1)
+
+        count = int(detections.sum())
+
+        if (count == 0):
+            return []
+
+        memory = ResponseMemoryProbs(count=count, probs=x.probs[detections])
+
+        for name, output in x.memory.outputs.items():
+            if (name != "probs"):
+                memory.outputs[name] = output[x.offset:x.offset + x.count][detections]
+
+        return [
+            MultiResponseProbsMessage(MessageMeta(x.get_meta()[detections]),
+                                      mess_offset=0,
+                                      mess_count=count,
+                                      memory=memory,
+                                      offset=0,
+                                      count=count)
+        ]
+
+    def supports_fusion(self) -> bool:
+        return CppConfig.get_should_use_cpp()
+
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        return neos.FilterDetectionsStage(seg, self.unique_name, self._threshold, self._copy), MultiResponseProbsMessage
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
         # Convert list back to single MultiResponseProbsMessage
         def flatten_fn(input: neo.Observable, output: neo.Subscriber):
 
-            input.pipe(ops.map(self.filter), ops.flatten()).subscribe(output)
+            input.pipe(ops.map(self.filter_copy if self._copy else self.filter), ops.flatten()).subscribe(output)
 
         if CppConfig.get_should_use_cpp():
-            stream = neos.FilterDetectionsStage(seg, self.unique_name, self._threshold)
+            stream = self._build_fusable_node(seg, input_stream[1])[0]
         else:
             stream = seg.make_node_full(self.unique_name, flatten_fn)
 
@@ -22,6 +22,7 @@ import neo
 import numpy as np
 import pandas as pd
 
+import morpheus._lib.stages as neos
 from morpheus.config import Config
 from morpheus.messages import MultiResponseProbsMessage
 from morpheus.pipeline.single_port_stage import SinglePortStage
@@ -40,14 +41,46 @@ class GenerateVizFramesStage(SinglePortStage):
         Output directory to write visualization frames.
     overwrite : bool
         Overwrite file if exists.
+    frame_type : str, default = 'csv'
+        Format of the frames, 'csv' or 'arrow'. Arrow IPC frames are written by the C++ stage, without pandas, when C++
+        execution is enabled.
+    out_socket : str, default = None
+        When set, the arrow frames are streamed to this 'host:port' as a single Arrow IPC stream, one record batch per
+        frame, instead of being written to `out_dir`. Requires C++ execution.
 
     """
 
-    def __init__(self, c: Config, out_dir: str = "./viz_frames", overwrite: bool = False):
+    LABELS = [
+        'address',
+        'bank_acct',
+        'credit_card',
+        'email',
+        'govt_id',
+        'name',
+        'password',
+        'phone_num',
+        'secret_keys',
+        'user',
+    ]
+
+    def __init__(self,
+                 c: Config,
+                 out_dir: str = "./viz_frames",
+                 overwrite: bool = False,
+                 frame_type: str = "csv",
+                 out_socket: str = None):
         super().__init__(c)
 
         self._out_dir = out_dir
         self._overwrite = overwrite
+        self._frame_type = frame_type.lower()
+        self._out_socket = out_socket
+
+        if (self._frame_type not in ("csv", "arrow")):
+            raise ValueError("Unsupported frame type '{}'. Must be one of 'csv' or 'arrow'".format(frame_type))
+
+        if (self._out_socket is not None and self._frame_type != "arrow"):
+            raise ValueError("Streaming to a socket requires `frame_type='arrow'`")
 
         if (os.path.exists(self._out_dir)):
             if (self._overwrite):
@@ -77,6 +110,9 @@ class GenerateVizFramesStage(SinglePortStage):
         """
         return (MultiResponseProbsMessage, )
 
+    def supports_cpp_node(self):
+        return self._frame_type == "arrow"
+
     @staticmethod
     def round_to_sec(x):
         """
@@ -97,18 +133,7 @@ class GenerateVizFramesStage(SinglePortStage):
 
     def _to_vis_df(self, x: MultiResponseProbsMessage):
 
-        idx2label = {
-            0: 'address',
-            1: 'bank_acct',
-            2: 'credit_card',
-            3: 'email',
-            4: 'govt_id',
-            5: 'name',
-            6: 'password',
-            7: 'phone_num',
-            8: 'secret_keys',
-            9: 'user'
-        }
+        idx2label = dict(enumerate(self.LABELS))
 
         df = x.get_meta(["timestamp", "src_ip", "dest_ip", "src_port", "dest_port", "data"])
 
@@ -149,16 +174,35 @@ class GenerateVizFramesStage(SinglePortStage):
 
         offset = (curr_timestamp - self._first_timestamp) / 1000
 
-        fn = os.path.join(self._out_dir, "{}.csv".format(offset))
+        columns = ["timestamp", "src_ip", "dest_ip", "src_port", "dest_port", "si", "data"]
+
+        fn = os.path.join(self._out_dir, "{}.{}".format(offset, self._frame_type))
 
         assert not os.path.exists(fn)
 
-        in_df.to_csv(fn, columns=["timestamp", "src_ip", "dest_ip", "src_port", "dest_port", "si", "data"])
+        if (self._frame_type == "arrow"):
+            in_df[columns].reset_index(drop=True).to_feather(fn)
+        else:
+            in_df.to_csv(fn, columns=columns)
 
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
         stream = input_stream[0]
 
+        if (self._build_cpp_node()):
+            node = neos.GenerateVizFramesStage(seg,
+                                               self.unique_name,
+                                               self._out_dir,
+                                               self._out_socket or "",
+                                               self.LABELS)
+            seg.make_edge(stream, node)
+
+            # Messages are passed through unchanged
+            return node, input_stream[1]
+
+        if (self._out_socket is not None):
+            raise RuntimeError("Streaming viz frames to a socket requires C++ execution")
+
         # Convert stream to dataframes
         stream = stream.map(self._to_vis_df)  # Convert group to dataframe
 
@@ -42,19 +42,25 @@ class SerializeStage(SinglePortStage):
     fixed_columns: bool
         When `True` `SerializeStage` will assume that the Dataframe in all messages contain the same columns as the
         first message received.
+    compact_fraction : float, default = 0.0
+        When the C++ stages are in use, output messages holding fewer than this fraction of the rows of the table they
+        were sliced from are copied into a table of their own, so the rest of that table can be freed. 0 disables
+        compaction.
     """
 
     def __init__(self,
                  c: Config,
                  include: typing.List[str] = None,
                  exclude: typing.List[str] = [r'^ID$', r'^_ts_'],
-                 fixed_columns: bool = True):
+                 fixed_columns: bool = True,
+                 compact_fraction: float = 0.0):
         super().__init__(c)
 
         # Make copies of the arrays to prevent changes after the Regex is compiled
         self._include_columns = copy.copy(include)
         self._exclude_columns = copy.copy(exclude)
         self._fixed_columns = fixed_columns
+        self._compact_fraction = compact_fraction
         self._columns = None
 
     @property
@@ -116,13 +122,22 @@ class SerializeStage(SinglePortStage):
 
         return MessageMeta(df=df)
 
+    def supports_fusion(self) -> bool:
+        return self._build_cpp_node()
+
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        node = neos.SerializeStage(seg,
+                                   self.unique_name,
+                                   self._include_columns or [],
+                                   self._exclude_columns,
+                                   self._fixed_columns,
+                                   self._compact_fraction)
+
+        return node, MessageMeta
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
         if (self._build_cpp_node()):
-            stream = neos.SerializeStage(seg,
-                                         self.unique_name,
-                                         self._include_columns or [],
-                                         self._exclude_columns,
-                                         self._fixed_columns)
+            stream = self._build_fusable_node(seg, input_stream[1])[0]
         else:
             include_columns = None
 
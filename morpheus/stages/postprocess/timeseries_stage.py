@@ -25,6 +25,7 @@ import neo
 import pandas as pd
 from neo.core import operators as ops
 
+import morpheus._lib.stages as neos
 from morpheus.config import Config
 from morpheus.messages import MultiResponseAEMessage
 from morpheus.messages import MultiResponseMessage
@@ -418,6 +419,8 @@ class TimeSeriesStage(SinglePortStage):
         self._filter_percent = filter_percent
         self._zscore_threshold = zscore_threshold
 
+        self._user_column = c.ae.userid_column_name if c.ae is not None else ""
+
         self._timeseries_per_user: typing.Dict[str, UserTimeSeries] = {}
 
     @property
@@ -436,6 +439,9 @@ class TimeSeriesStage(SinglePortStage):
         """
         return (MultiResponseMessage, )
 
+    def supports_cpp_node(self):
+        return True
+
     def _call_timeseries_user(self, x: MultiResponseAEMessage):
 
         if (x.user_id not in self._timeseries_per_user):
@@ -454,6 +460,21 @@ class TimeSeriesStage(SinglePortStage):
         stream = input_stream[0]
         out_type = input_stream[1]
 
+        # `MultiResponseAEMessage` only exists in python, the C++ node reads the user from `userid_column_name`
+        if (self._build_cpp_node() and not issubclass(out_type, MultiResponseAEMessage)):
+            stream = neos.TimeSeriesStage(seg,
+                                          self.unique_name,
+                                          int(round(pd.Timedelta(self._resolution).total_seconds())),
+                                          pd.Timedelta(self._min_window).total_seconds(),
+                                          self._hot_start,
+                                          self._cold_end,
+                                          self._filter_percent,
+                                          self._zscore_threshold,
+                                          self._user_column)
+            seg.make_edge(input_stream[0], stream)
+
+            return stream, out_type
+
         def node_fn(input: neo.Observable, output: neo.Subscriber):
 
             def on_next(x: MultiResponseAEMessage):
@@ -25,6 +25,7 @@ from neo.core import operators as ops
 
 import cudf
 
+import morpheus._lib.stages as neos
 from morpheus._lib.file_types import FileTypes
 from morpheus.config import Config
 from morpheus.io.deserializers import read_file_to_df
@@ -61,7 +62,12 @@ class ValidationStage(MultiMessageStage):
         Absolute tolerance to use when comparing float columns.
     rel_tol : float, default = 0.05
         Relative tolerance to use when comparing float columns.
+    max_mismatch_samples : int, default = 20
+        C++ stage only. Most mismatched rows written, with their expected and actual values, to the results.
 
+    The C++ stage compares each message as it arrives, joining it on the GPU with the validation dataset by
+    `index_col`, or by the index of the messages, and only keeps running counts and a sample of the mismatched rows.
+    The python stage holds every message until the input completes.
     Raises
     ------
     FileExistsError
@@ -79,6 +85,7 @@ class ValidationStage(MultiMessageStage):
         index_col: str = None,
         abs_tol: float = 0.001,
         rel_tol: float = 0.005,
+        max_mismatch_samples: int = 20,
     ):
 
         super().__init__(c)
@@ -91,6 +98,7 @@ class ValidationStage(MultiMessageStage):
         self._results_file_name = results_file_name
         self._abs_tol = abs_tol
         self._rel_tol = rel_tol
+        self._max_mismatch_samples = max_mismatch_samples
 
         if (os.path.exists(self._results_file_name)):
             if (overwrite):
@@ -118,6 +126,9 @@ class ValidationStage(MultiMessageStage):
         """
         return (MultiMessage, )
 
+    def supports_cpp_node(self):
+        return True
+
     def _filter_df(self, df):
         include_columns = None
 
@@ -221,6 +232,21 @@ class ValidationStage(MultiMessageStage):
 
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
+        if (self._build_cpp_node()):
+            node = neos.ValidationStage(seg,
+                                        self.unique_name,
+                                        self._val_file_name,
+                                        self._results_file_name,
+                                        list(self._include_columns or []),
+                                        list(self._exclude_columns or []),
+                                        self._index_col or "",
+                                        self._abs_tol,
+                                        self._rel_tol,
+                                        self._max_mismatch_samples)
+            seg.make_edge(input_stream[0], node)
+
+            return node, input_stream[1]
+
         self._val_df: pd.DataFrame = read_file_to_df(self._val_file_name, FileTypes.Auto, df_type="pandas")
 
         # Store all messages until on_complete is called and then build the dataframe and compare
@@ -88,6 +88,12 @@ class DeserializeStage(MultiMessageStage):
 
         return output
 
+    def supports_fusion(self) -> bool:
+        return CppConfig.get_should_use_cpp()
+
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        return neos.DeserializeStage(seg, self.unique_name, self._batch_size), MultiMessage
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
 
         stream = input_stream[0]
@@ -99,7 +105,7 @@ class DeserializeStage(MultiMessageStage):
                        ops.flatten()).subscribe(output)
 
         if CppConfig.get_should_use_cpp():
-            stream = neos.DeserializeStage(seg, self.unique_name, self._batch_size)
+            stream, out_type = self._build_fusable_node(seg, input_stream[1])
         else:
             stream = seg.make_node_full(self.unique_name, node_fn)
 
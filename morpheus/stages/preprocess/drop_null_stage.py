@@ -17,7 +17,9 @@ import typing
 import neo
 from neo.core import operators as ops
 
+import morpheus._lib.stages as neos
 from morpheus.config import Config
+from morpheus.config import CppConfig
 from morpheus.messages import MessageMeta
 from morpheus.pipeline.single_port_stage import SinglePortStage
 from morpheus.pipeline.stream_pair import StreamPair
@@ -25,7 +27,8 @@ from morpheus.pipeline.stream_pair import StreamPair
 
 class DropNullStage(SinglePortStage):
     """
-    Drop null/empty data input entries.
+    Drop null/empty data input entries. When C++ execution is enabled the rows are dropped on the device with
+    `cudf::drop_nulls`, and the stage can be fused with a following `DeserializeStage`.
 
     Parameters
     ----------
@@ -60,9 +63,21 @@ class DropNullStage(SinglePortStage):
         """
         return (MessageMeta, )
 
+    def supports_fusion(self) -> bool:
+        return CppConfig.get_should_use_cpp()
+
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        return neos.DropNullStage(seg, self.unique_name, self._column), MessageMeta
+
     def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
         stream = input_stream[0]
 
+        if CppConfig.get_should_use_cpp():
+            node, out_type = self._build_fusable_node(seg, input_stream[1])
+            seg.make_edge(stream, node)
+
+            return node, out_type
+
         # Finally, flatten to a single stream
         def node_fn(input: neo.Observable, output: neo.Subscriber):
 
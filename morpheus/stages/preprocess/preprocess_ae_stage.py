@@ -16,9 +16,12 @@ import logging
 import typing
 from functools import partial
 
+import json
+
 import cupy as cp
 import neo
 
+import morpheus._lib.stages as neos
 from morpheus.config import Config
 from morpheus.messages import InferenceMemoryAE
 from morpheus.messages import MultiInferenceMessage
@@ -38,14 +41,27 @@ class PreprocessAEStage(PreprocessBaseStage):
     ----------
     c : morpheus.config.Config
         Pipeline configuration instance.
+    scaling_file : str, default = None
+        JSON file of per-feature statistics, mapping feature names to either `{"mean": m, "std": s}` or
+        `{"min": a, "max": b}` under a top level `"features"` key. When set, the feature columns are packed into the
+        `input` tensor and normalized with these statistics instead of being prepared by the model, which allows the
+        stage to run in C++. Features without statistics are packed unscaled and must all be numeric. The C++ stage
+        emits a `MultiInferenceMessage` without the model, for models served outside of the pipeline.
 
     """
 
-    def __init__(self, c: Config):
+    def __init__(self, c: Config, scaling_file: str = None):
         super().__init__(c)
 
         self._fea_length = c.feature_length
         self._feature_columns = c.ae.feature_columns
+        self._scaling_file = scaling_file
+
+        self._shift = None
+        self._scale = None
+
+        if (scaling_file is not None):
+            (self._shift, self._scale) = PreprocessAEStage.load_scaling(scaling_file, self._feature_columns)
 
     @property
     def name(self) -> str:
@@ -58,11 +74,44 @@ class PreprocessAEStage(PreprocessBaseStage):
         return (MultiAEMessage, )
 
     def supports_cpp_node(self):
-        return False
+        # Preparing the features with the model requires python
+        return self._scaling_file is not None
 
     @staticmethod
-    def pre_process_batch(x: MultiAEMessage, fea_len: int,
-                          feature_columns: typing.List[str]) -> MultiInferenceAEMessage:
+    def load_scaling(scaling_file: str, feature_columns: typing.List[str]) -> typing.Tuple[cp.ndarray, cp.ndarray]:
+        """
+        Reads the per-feature statistics of `scaling_file`, returning the shift and scale of every feature column such
+        that the normalized value is `(x - shift) * scale`. Matches `FeatureScaler` in the C++ stage.
+        """
+        with open(scaling_file, encoding='UTF-8') as f:
+            features = json.load(f)["features"]
+
+        shift = []
+        scale = []
+
+        for col in feature_columns:
+            stats = features.get(col)
+
+            if (stats is None):
+                (col_shift, col_range) = (0.0, 1.0)
+            elif ("mean" in stats and "std" in stats):
+                (col_shift, col_range) = (stats["mean"], stats["std"])
+            elif ("min" in stats and "max" in stats):
+                (col_shift, col_range) = (stats["min"], stats["max"] - stats["min"])
+            else:
+                raise ValueError(f"Feature '{col}' needs either 'mean' and 'std' or 'min' and 'max'")
+
+            shift.append(col_shift)
+            scale.append(1.0 / col_range if col_range != 0 else 1.0)
+
+        return (cp.asarray(shift, dtype=cp.float32), cp.asarray(scale, dtype=cp.float32))
+
+    @staticmethod
+    def pre_process_batch(x: MultiAEMessage,
+                          fea_len: int,
+                          feature_columns: typing.List[str],
+                          shift: cp.ndarray = None,
+                          scale: cp.ndarray = None) -> MultiInferenceAEMessage:
         """
         This function performs pre-processing for autoencoder.
 
@@ -78,12 +127,18 @@ class PreprocessAEStage(PreprocessBaseStage):
 
         """
 
-        meta_df = x.get_meta(x.meta.df.columns.intersection(feature_columns))
         autoencoder = x.model
 
-        data = autoencoder.prepare_df(meta_df)
-        input = autoencoder.build_input_tensor(data)
-        input = cp.asarray(input.detach())
+        if (shift is not None):
+            # Same layout as the C++ stage, every feature column in order
+            input = cp.asarray(x.get_meta(feature_columns).astype("float32").as_gpu_matrix(order='C'))
+            input = (input - shift) * scale
+        else:
+            meta_df = x.get_meta(x.meta.df.columns.intersection(feature_columns))
+
+            data = autoencoder.prepare_df(meta_df)
+            input = autoencoder.build_input_tensor(data)
+            input = cp.asarray(input.detach())
 
         count = input.shape[0]
 
@@ -106,7 +161,15 @@ class PreprocessAEStage(PreprocessBaseStage):
     def _get_preprocess_fn(self) -> typing.Callable[[MultiMessage], MultiInferenceMessage]:
         return partial(PreprocessAEStage.pre_process_batch,
                        fea_len=self._fea_length,
-                       feature_columns=self._feature_columns)
+                       feature_columns=self._feature_columns,
+                       shift=self._shift,
+                       scale=self._scale)
+
+    def _get_output_type(self, preprocess_fn: typing.Callable[[MultiMessage], MultiInferenceMessage]) -> type:
+        if (self._build_cpp_node()):
+            return MultiInferenceMessage
+
+        return super()._get_output_type(preprocess_fn)
 
     def _get_preprocess_node(self, seg: neo.Segment):
-        raise NotImplementedError("No C++ node for AE")
+        return neos.PreprocessAEStage(seg, self.unique_name, self._feature_columns, self._scaling_file)
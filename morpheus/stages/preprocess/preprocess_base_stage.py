@@ -20,7 +20,6 @@ import neo
 import typing_utils
 
 from morpheus.config import Config
-from morpheus.config import CppConfig
 from morpheus.messages import MultiInferenceMessage
 from morpheus.messages import MultiMessage
 from morpheus.pipeline.multi_message_stage import MultiMessageStage
@@ -58,20 +57,33 @@ class PreprocessBaseStage(MultiMessageStage):
     def _get_preprocess_node(self, seg: neo.Segment):
         pass
 
-    def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
-
-        stream = input_stream[0]
+    def _get_output_type(self, preprocess_fn: typing.Callable[[MultiMessage], MultiInferenceMessage]) -> type:
         out_type = MultiInferenceMessage
 
-        preprocess_fn = self._get_preprocess_fn()
-
         preproc_sig = inspect.signature(preprocess_fn)
 
         # If the innerfunction returns a type annotation, update the output type
         if (preproc_sig.return_annotation and typing_utils.issubtype(preproc_sig.return_annotation, out_type)):
             out_type = preproc_sig.return_annotation
 
-        if CppConfig.get_should_use_cpp():
+        return out_type
+
+    def supports_cpp_node(self):
+        return True
+
+    def supports_fusion(self) -> bool:
+        return self._build_cpp_node()
+
+    def _build_fusable_node(self, seg: neo.Segment, input_type: type) -> StreamPair:
+        return self._get_preprocess_node(seg), self._get_output_type(self._get_preprocess_fn())
+
+    def _build_single(self, seg: neo.Segment, input_stream: StreamPair) -> StreamPair:
+
+        preprocess_fn = self._get_preprocess_fn()
+
+        out_type = self._get_output_type(preprocess_fn)
+
+        if self._build_cpp_node():
             stream = self._get_preprocess_node(seg)
         else:
             stream = seg.make_node(self.unique_name, preprocess_fn)
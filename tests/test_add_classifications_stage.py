@@ -79,3 +79,47 @@ def test_build_single(config):
 
     mock_segment.make_node.assert_called_once()
     mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_python
+def test_add_labels_and_filter(config):
+    mock_message = mock.MagicMock()
+    mock_message.mess_offset = 8
+    mock_message.probs = cp.array([
+        [0.2, 0.4, 0.3],
+        [0.1, 0.5, 0.8],
+        [0.2, 0.4, 0.3],
+    ])
+
+    config.class_labels = ['frogs', 'lizards', 'toads']
+
+    ac = AddClassificationsStage(config, threshold=0.35, filter_threshold=0.5)
+    output_list = ac._add_labels_and_filter(mock_message)
+
+    # Labels are set on every row, only detected rows are emitted
+    mock_message.set_meta.assert_has_calls([
+        mock.call('frogs', [False, False, False]),
+        mock.call('lizards', [True, True, True]),
+        mock.call('toads', [False, True, False]),
+    ])
+
+    assert len(output_list) == 1
+    assert output_list[0].offset == 1
+    assert output_list[0].mess_offset == 9
+    assert output_list[0].mess_count == 1
+
+
+@pytest.mark.use_python
+def test_build_single_filter(config):
+    mock_stream = mock.MagicMock()
+    mock_segment = mock.MagicMock()
+    mock_segment.make_node_full.return_value = mock_stream
+    mock_input = mock.MagicMock()
+
+    config.class_labels = ['frogs', 'lizards', 'toads']
+
+    ac = AddClassificationsStage(config, filter_threshold=0.5)
+    ac._build_single(mock_segment, mock_input)
+
+    mock_segment.make_node_full.assert_called_once()
+    mock_segment.make_edge.assert_called_once()
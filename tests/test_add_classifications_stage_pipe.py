@@ -14,6 +14,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import copy
 import os
 
 import numpy as np
@@ -61,3 +62,42 @@ def test_add_classifications_stage_pipe(config, tmp_path):
     output_np = output_data[idx].to_numpy()
 
     assert output_np.tolist() == expected.tolist()
+
+
+def test_output_columns_scoped_to_pipeline(config, tmp_path):
+    config.class_labels = ['frogs', 'lizards', 'toads', 'turtles']
+    config.num_threads = 1
+
+    # Shares nothing with the first pipeline but the process
+    other_config = copy.deepcopy(config)
+
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+    labeled_file = os.path.join(tmp_path, 'labeled.csv')
+    plain_file = os.path.join(tmp_path, 'plain.csv')
+
+    labeled_pipe = LinearPipeline(config)
+    labeled_pipe.set_source(FileSourceStage(config, filename=input_file, iterative=False))
+    labeled_pipe.add_stage(DeserializeStage(config))
+    labeled_pipe.add_stage(ConvMsg(config, input_file))
+    labeled_pipe.add_stage(AddClassificationsStage(config, threshold=0.75))
+    labeled_pipe.add_stage(SerializeStage(config))
+    labeled_pipe.add_stage(WriteToFileStage(config, filename=labeled_file, overwrite=False))
+
+    # Built while the classification stage of the first pipeline is alive
+    plain_pipe = LinearPipeline(other_config)
+    plain_pipe.set_source(FileSourceStage(other_config, filename=input_file, iterative=False))
+    plain_pipe.add_stage(WriteToFileStage(other_config, filename=plain_file, overwrite=False))
+
+    labeled_pipe.build()
+    plain_pipe.run()
+    labeled_pipe.run()
+
+    assert config.output_columns == {label: "bool" for label in config.class_labels}
+    assert other_config.output_columns == {}
+
+    labeled_columns = pd.read_csv(labeled_file).columns
+    assert all(label in labeled_columns for label in config.class_labels)
+
+    plain_columns = pd.read_csv(plain_file).columns
+    assert not any(label in plain_columns for label in config.class_labels)
+    assert plain_columns.to_list()[1:] == pd.read_csv(input_file).columns.to_list()
@@ -18,6 +18,7 @@ import os
 
 import numpy as np
 import pandas as pd
+import pytest
 
 from morpheus.pipeline import LinearPipeline
 from morpheus.stages.input.file_source_stage import FileSourceStage
@@ -29,7 +30,7 @@ from utils import TEST_DIRS
 from utils import ConvMsg
 
 
-def test_add_scores_stage_pipe(config, tmp_path):
+def _run_add_scores_pipe(config, tmp_path):
     config.class_labels = ['frogs', 'lizards', 'toads', 'turtles']
 
     input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
@@ -57,3 +58,14 @@ def test_add_scores_stage_pipe(config, tmp_path):
     output_np = np.around(output_data[idx].to_numpy(), 2)
 
     assert output_np.tolist() == expected.tolist()
+
+
+def test_add_scores_stage_pipe(config, tmp_path):
+    _run_add_scores_pipe(config, tmp_path)
+
+
+@pytest.mark.use_cpp
+def test_add_scores_stage_pipe_fused(config, tmp_path):
+    # AddScoresStage and SerializeStage are fused into a single C++ node, the output must be unchanged
+    config.fuse_cpp_stages = True
+    _run_add_scores_pipe(config, tmp_path)
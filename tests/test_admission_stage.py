@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+from unittest import mock
+
+import pytest
+
+from morpheus.stages.general.admission_stage import AdmissionStage
+
+
+def test_constructor(config):
+    stage = AdmissionStage(config, key_column="severity", lanes=["critical", "high"])
+    assert stage.name == "admission"
+    assert stage._key_column == "severity"
+    assert stage._lanes == ["critical", "high"]
+    assert stage._lane_capacity == 16
+    assert stage._protected_lanes == 1
+    assert stage._latency_slo_ms == 0
+    assert stage._shed_policy == "drop"
+
+    # Just ensure that we get a valid non-empty tuple
+    accepted_types = stage.accepted_types()
+    assert isinstance(accepted_types, tuple)
+    assert len(accepted_types) > 0
+
+    # One count per lane plus the lane of unmatched rows
+    assert stage.shed_counts == [0, 0, 0]
+
+    # Integer keys are passed to C++ as strings
+    stage = AdmissionStage(config, key_column="level", lanes=[1, 2], shed_policy="sample", sample_fraction=0.5)
+    assert stage._lanes == ["1", "2"]
+    assert stage._sample_fraction == 0.5
+
+    pytest.raises(ValueError, AdmissionStage, config, key_column="level", lanes=["1"], lane_capacity=0)
+    pytest.raises(ValueError, AdmissionStage, config, key_column="level", lanes=["1"], shed_policy="lifo")
+    pytest.raises(ValueError, AdmissionStage, config, key_column="level", lanes=["1"], sample_fraction=1.5)
+
+
+@pytest.mark.use_python
+def test_build_single(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = AdmissionStage(config, key_column="severity", lanes=["critical"])
+    pytest.raises(NotImplementedError, stage._build_single, mock_segment, mock_input)
+
+    mock_segment.make_edge.assert_not_called()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = AdmissionStage(config,
+                           key_column="severity",
+                           lanes=["critical", "high"],
+                           lane_capacity=4,
+                           latency_slo_ms=250,
+                           shed_policy="sample",
+                           sample_fraction=0.25)
+
+    with mock.patch('morpheus.stages.general.admission_stage.neos') as mock_neos:
+        mock_neos.AdmissionStage.return_value.shed_counts = [0, 3, 7]
+
+        stage._build_single(mock_segment, mock_input)
+
+        mock_neos.AdmissionStage.assert_called_once_with(mock_segment,
+                                                         stage.unique_name,
+                                                         "severity", ["critical", "high"],
+                                                         4,
+                                                         1,
+                                                         250,
+                                                         "sample",
+                                                         0.25)
+
+    mock_segment.make_edge.assert_called_once()
+    assert stage.shed_counts == [0, 3, 7]
@@ -17,6 +17,7 @@
 import glob
 import json
 import os
+import typing
 from unittest import mock
 
 import pandas as pd
@@ -362,3 +363,32 @@ def test_post_build_single(config, input_glob, cols_include, cols_exclude, plugi
 
     mock_segment.make_node_full.assert_called_once()
     mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_cpp
+@pytest.mark.parametrize('input_glob', [os.path.join(TEST_DIRS.tests_data_dir, 'appshield', 'snapshot-1', '*.json')])
+def test_post_build_single_cpp(config, input_glob):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    source = AppShieldSourceStage(config, input_glob, ['envars'], ['PID', 'Process'], ['SHA256'])
+    assert source.supports_cpp_node()
+
+    with mock.patch('morpheus.stages.input.appshield_source_stage.neos') as mock_neos:
+        source._post_build_single(mock_segment, (mock_input, typing.List[str]))
+
+        mock_neos.AppShieldSourceStage.assert_called_once_with(mock_segment,
+                                                               source.unique_name + "-post",
+                                                               ['envars'],
+                                                               ['PID', 'Process'],
+                                                               ['SHA256'],
+                                                               'latin1',
+                                                               config.num_threads)
+
+    mock_segment.make_node_full.assert_not_called()
+    mock_segment.make_edge.assert_called_once()
+
+
+def test_supports_cpp_node(config):
+    assert AppShieldSourceStage(config, '*.json', ['envars'], ['PID'], encoding='utf-8').supports_cpp_node()
+    assert not AppShieldSourceStage(config, '*.json', ['envars'], ['PID'], encoding='cp1252').supports_cpp_node()
@@ -0,0 +1,140 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+import os
+import time
+from unittest import mock
+
+import pytest
+
+from morpheus.messages import MessageMeta
+from morpheus.pipeline.linear_pipeline import LinearPipeline
+from morpheus.pipeline.single_port_stage import SinglePortStage
+from morpheus.stages.general.buffer_stage import BufferStage
+from morpheus.stages.input.file_source_stage import FileSourceStage
+from utils import TEST_DIRS
+
+
+class SlowTraceSink(SinglePortStage):
+    """
+    Records the trace of every message, slowly enough for the buffer stage upstream to fill up and spill
+    """
+
+    def __init__(self, c):
+        super().__init__(c)
+        self.traces = []
+
+    @property
+    def name(self):
+        return "slow-trace-sink"
+
+    def accepted_types(self):
+        return (MessageMeta, )
+
+    def _record(self, m):
+        time.sleep(0.05)
+        self.traces.append(m.trace)
+        return m
+
+    def _build_single(self, seg, input_stream):
+        stream = seg.make_node(self.unique_name, self._record)
+        seg.make_edge(input_stream[0], stream)
+
+        return stream, input_stream[1]
+
+
+def test_constructor(config):
+    bs = BufferStage(config, count=10, device_memory_budget=1024, host_memory_budget=4096)
+    assert bs.name == "buffer"
+    assert bs._buffer_count == 10
+    assert bs._device_memory_budget == 1024
+    assert bs._host_memory_budget == 4096
+
+    with pytest.raises(ValueError):
+        BufferStage(config, count=0)
+
+
+@pytest.mark.use_python
+def test_build_single_pass_thru(config):
+    mock_segment = mock.MagicMock()
+    input_stream = (mock.MagicMock(), MessageMeta)
+
+    bs = BufferStage(config, device_memory_budget=1024)
+
+    assert bs._build_single(mock_segment, input_stream) is input_stream
+
+    mock_segment.make_edge.assert_not_called()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    bs = BufferStage(config, count=10, device_memory_budget=1024, host_memory_budget=4096)
+
+    with mock.patch('morpheus.stages.general.buffer_stage.neos') as mock_neos:
+        stream, out_type = bs._build_single(mock_segment, (mock_input, MessageMeta))
+
+        mock_neos.BufferStage.assert_called_once_with(mock_segment, bs.unique_name, 10, 1024, 4096, 0.0)
+
+    assert stream is mock_neos.BufferStage.return_value
+    assert out_type is MessageMeta
+    mock_segment.make_edge.assert_called_once_with(mock_input, stream)
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp_no_budget(config):
+    mock_segment = mock.MagicMock()
+    input_stream = (mock.MagicMock(), MessageMeta)
+
+    bs = BufferStage(config)
+
+    with mock.patch('morpheus.stages.general.buffer_stage.neos') as mock_neos:
+        assert bs._build_single(mock_segment, input_stream) is input_stream
+
+        mock_neos.BufferStage.assert_not_called()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp_compact_only(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    bs = BufferStage(config, count=10, compact_fraction=0.25)
+
+    with mock.patch('morpheus.stages.general.buffer_stage.neos') as mock_neos:
+        stream, _ = bs._build_single(mock_segment, (mock_input, MessageMeta))
+
+        mock_neos.BufferStage.assert_called_once_with(mock_segment, bs.unique_name, 10, 0, 0, 0.25)
+
+    assert stream is mock_neos.BufferStage.return_value
+
+
+@pytest.mark.use_cpp
+def test_trace_survives_spill(config):
+    config.trace_sample_interval = 1
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file, iterative=False, repeat=20))
+    # Every message held behind another is over the budget and spilled
+    pipe.add_stage(BufferStage(config, count=20, device_memory_budget=1))
+    sink = SlowTraceSink(config)
+    pipe.add_stage(sink)
+    pipe.run()
+
+    assert len(sink.traces) == 20
+    assert all(trace is not None for trace in sink.traces)
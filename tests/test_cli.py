@@ -27,6 +27,8 @@ from morpheus.config import ConfigAutoEncoder
 from morpheus.config import CppConfig
 from morpheus.config import PipelineModes
 from morpheus.stages.general.monitor_stage import MonitorStage
+from morpheus.stages.general.prefilter_merge_stage import PrefilterMergeStage
+from morpheus.stages.general.prefilter_stage import PrefilterStage
 from morpheus.stages.inference.auto_encoder_inference_stage import AutoEncoderInferenceStage
 from morpheus.stages.inference.identity_inference_stage import IdentityInferenceStage
 from morpheus.stages.inference.pytorch_inference_stage import PyTorchInferenceStage
@@ -34,8 +36,11 @@ from morpheus.stages.inference.triton_inference_stage import TritonInferenceStag
 from morpheus.stages.input.cloud_trail_source_stage import CloudTrailSourceStage
 from morpheus.stages.input.file_source_stage import FileSourceStage
 from morpheus.stages.input.kafka_source_stage import KafkaSourceStage
+from morpheus.stages.input.load_generator_source_stage import LoadGeneratorSourceStage
+from morpheus.stages.input.ucx_source_stage import UcxSourceStage
 from morpheus.stages.output.write_to_file_stage import WriteToFileStage
 from morpheus.stages.output.write_to_kafka_stage import WriteToKafkaStage
+from morpheus.stages.output.write_to_ucx_stage import WriteToUcxStage
 from morpheus.stages.postprocess.add_classifications_stage import AddClassificationsStage
 from morpheus.stages.postprocess.add_scores_stage import AddScoresStage
 from morpheus.stages.postprocess.filter_detections_stage import FilterDetectionsStage
@@ -790,3 +795,229 @@ class TestCLI:
         [file_source, deserialize, process_nlp, triton_inf, monitor, add_class, validation, serialize, to_file] = stages
 
         assert process_nlp._vocab_hash_file == vocab_file_name
+
+    @pytest.mark.replace_callback('pipeline_nlp')
+    def test_from_kafka_schema(self, config, callback_values, tmp_path):
+        args = (GENERAL_ARGS + ['pipeline-nlp'] + FROM_KAFKA_ARGS +
+                ['--schema', 'count=int64', '--schema', 'user=str', '--schema_batches', '3'] + TO_FILE_ARGS)
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        [from_kafka, to_file] = callback_values['stages']
+
+        assert isinstance(from_kafka, KafkaSourceStage)
+        assert from_kafka._schema == {'count': 'int64', 'user': 'str'}
+        assert from_kafka._schema_batches == 3
+
+        bad_args = (GENERAL_ARGS + ['pipeline-nlp'] + FROM_KAFKA_ARGS + ['--schema', 'count'] + TO_FILE_ARGS)
+        result = runner.invoke(cli.cli, bad_args, obj={})
+        assert result.exit_code == 2, result.output
+
+    @pytest.mark.replace_callback('pipeline_nlp')
+    def test_from_kafka_avro(self, config, callback_values, tmp_path):
+        avro_schema = '{"type": "record", "name": "event", "fields": [{"name": "user", "type": "string"}]}'
+        avro_schema_file = os.path.join(tmp_path, 'event.avsc')
+
+        with open(avro_schema_file, 'w') as fh:
+            fh.write(avro_schema)
+
+        args = (GENERAL_ARGS + ['pipeline-nlp'] + FROM_KAFKA_ARGS + [
+            '--message_format',
+            'avro-confluent',
+            '--avro_schema_file',
+            avro_schema_file,
+            '--schema_registry_url',
+            'http://localhost:8081'
+        ] + TO_FILE_ARGS)
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        [from_kafka, to_file] = callback_values['stages']
+
+        assert isinstance(from_kafka, KafkaSourceStage)
+        assert from_kafka._message_format == 'avro-confluent'
+        assert from_kafka._avro_schema == avro_schema
+        assert from_kafka._schema_registry_url == 'http://localhost:8081'
+
+        bad_args = (GENERAL_ARGS + ['pipeline-nlp'] + FROM_KAFKA_ARGS + ['--message_format', 'avro'] + TO_FILE_ARGS)
+        result = runner.invoke(cli.cli, bad_args, obj={})
+        assert result.exit_code != 0, result.output
+
+    @pytest.mark.replace_callback('pipeline_nlp')
+    def test_from_kafka_metadata_columns(self, config, callback_values, tmp_path):
+        args = (GENERAL_ARGS + ['pipeline-nlp'] + FROM_KAFKA_ARGS +
+                ['--metadata_column', '_ts', '--metadata_column', '_offset', '--max_in_flight_batches', '8'] +
+                TO_FILE_ARGS)
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        [from_kafka, to_file] = callback_values['stages']
+
+        assert isinstance(from_kafka, KafkaSourceStage)
+        assert from_kafka._metadata_columns == ['_ts', '_offset']
+        assert from_kafka._max_in_flight_batches == 8
+
+        bad_args = (GENERAL_ARGS + ['pipeline-nlp'] + FROM_KAFKA_ARGS + ['--metadata_column', '_value'] + TO_FILE_ARGS)
+        result = runner.invoke(cli.cli, bad_args, obj={})
+        assert result.exit_code == 2, result.output
+
+    @pytest.mark.replace_callback('pipeline_nlp')
+    def test_trace_sample_interval(self, config, callback_values, tmp_path):
+        args = (GENERAL_ARGS + ['--trace_sample_interval=100', 'pipeline-nlp'] + FROM_KAFKA_ARGS + TO_FILE_ARGS)
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        config = obj["config"]
+        assert config.trace_sample_interval == 100
+
+        bad_args = (GENERAL_ARGS + ['--trace_sample_interval=-1', 'pipeline-nlp'] + FROM_KAFKA_ARGS + TO_FILE_ARGS)
+        result = runner.invoke(cli.cli, bad_args, obj={})
+        assert result.exit_code == 2, result.output
+
+    @pytest.mark.replace_callback('pipeline_nlp')
+    def test_prefilter(self, config, callback_values, tmp_path):
+        args = (GENERAL_ARGS + ['pipeline-nlp'] + FROM_KAFKA_ARGS + [
+            'deserialize',
+            'prefilter',
+            '--column',
+            'data',
+            '--pattern',
+            '^GET /health',
+            '--literal',
+            'heartbeat',
+            'prefilter-merge',
+            'serialize'
+        ] + TO_FILE_ARGS)
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        [from_kafka, deserialize, prefilter, prefilter_merge, serialize, to_file] = callback_values['stages']
+
+        assert isinstance(prefilter, PrefilterStage)
+        assert prefilter._column == 'data'
+        assert prefilter._patterns == ['^GET /health']
+        assert prefilter._literals == ['heartbeat']
+        assert prefilter._label_columns == obj["config"].class_labels
+
+        assert isinstance(prefilter_merge, PrefilterMergeStage)
+        assert prefilter_merge._prefilter is prefilter
+        assert prefilter._merge_stage is prefilter_merge
+
+        bad_args = (GENERAL_ARGS + ['pipeline-nlp'] + FROM_KAFKA_ARGS + ['prefilter', '--column', 'data'] +
+                    TO_FILE_ARGS)
+        result = runner.invoke(cli.cli, bad_args, obj={})
+        assert result.exit_code == 2, result.output
+
+    @pytest.mark.replace_callback('pipeline_fil')
+    def test_cuda_graphs(self, config, callback_values, tmp_path):
+        args = (GENERAL_ARGS + ['--cuda_graphs=True', 'pipeline-fil'] + FILE_SRC_ARGS + TO_FILE_ARGS)
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        config = obj["config"]
+        assert config.cuda_graphs
+
+    @pytest.mark.replace_callback('pipeline_fil')
+    def test_drain_timeout(self, config, callback_values, tmp_path):
+        args = (GENERAL_ARGS + ['--drain_timeout=30', 'pipeline-fil'] + FILE_SRC_ARGS + TO_FILE_ARGS)
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        config = obj["config"]
+        assert config.drain_timeout == 30
+
+        bad_args = (GENERAL_ARGS + ['--drain_timeout=-1', 'pipeline-fil'] + FILE_SRC_ARGS + TO_FILE_ARGS)
+        result = runner.invoke(cli.cli, bad_args, obj={})
+        assert result.exit_code == 2, result.output
+
+    @pytest.mark.replace_callback('pipeline_fil')
+    def test_load_generator(self, config, callback_values, tmp_path):
+        template_file = os.path.join(TEST_DIRS.validation_data_dir, 'abp-validation-data.jsonlines')
+        args = (GENERAL_ARGS + [
+            'pipeline-fil',
+            'from-load-generator',
+            '--filename',
+            template_file,
+            '--rows_per_second',
+            '5000',
+            '--batch_size',
+            '128',
+            '--distribution',
+            'Exponential',
+            '--jitter',
+            '0.2',
+            '--mutate_column',
+            'data',
+            '--total_rows',
+            '100000',
+            '--trace_all'
+        ] + TO_FILE_ARGS)
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        [load_generator, _] = callback_values['stages']
+
+        assert isinstance(load_generator, LoadGeneratorSourceStage)
+        assert load_generator._filename == template_file
+        assert load_generator._rows_per_second == 5000
+        assert load_generator._batch_size == 128
+        assert load_generator._distribution == 'exponential'
+        assert load_generator._jitter == 0.2
+        assert load_generator._mutate_columns == ['data']
+        assert load_generator._total_rows == 100000
+        assert load_generator._duration_sec == 0
+        assert load_generator._trace_all
+
+        bad_args = (GENERAL_ARGS + ['pipeline-fil', 'from-load-generator', '--filename', template_file] +
+                    ['--jitter', '1.5'] + TO_FILE_ARGS)
+        result = runner.invoke(cli.cli, bad_args, obj={})
+        assert result.exit_code == 2, result.output
+
+    @pytest.mark.replace_callback('pipeline_fil')
+    def test_ucx(self, config, callback_values, tmp_path):
+        args = (GENERAL_ARGS + ['pipeline-fil', 'from-ucx', '--port', '13337', '--num_senders', '2'] +
+                ['to-ucx', '--host', 'inference-host', '--port', '13338'])
+
+        obj = {}
+        runner = CliRunner()
+        result = runner.invoke(cli.cli, args, obj=obj)
+        assert result.exit_code == 47, result.output
+
+        [from_ucx, to_ucx] = callback_values['stages']
+
+        assert isinstance(from_ucx, UcxSourceStage)
+        assert from_ucx._address == '0.0.0.0'
+        assert from_ucx._port == 13337
+        assert from_ucx._num_senders == 2
+
+        assert isinstance(to_ucx, WriteToUcxStage)
+        assert to_ucx._host == 'inference-host'
+        assert to_ucx._port == 13338
+
+        bad_args = (GENERAL_ARGS + ['pipeline-fil', 'from-ucx', '--port', '0'] + TO_FILE_ARGS)
+        result = runner.invoke(cli.cli, bad_args, obj={})
+        assert result.exit_code == 2, result.output
@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+import typing
+from unittest import mock
+
+import pytest
+
+from morpheus._lib.file_types import FileTypes
+from morpheus.stages.input.cloud_trail_source_stage import CloudTrailSourceStage
+
+
+def test_supports_cpp_node(config):
+    assert CloudTrailSourceStage(config, '/tmp/cloudtrail/*.json').supports_cpp_node()
+    assert CloudTrailSourceStage(config, '/tmp/cloudtrail/*.json.gz').supports_cpp_node()
+    assert not CloudTrailSourceStage(config, '/tmp/cloudtrail/*.csv').supports_cpp_node()
+    assert CloudTrailSourceStage(config, '/tmp/cloudtrail/*', file_type=FileTypes.JSON).supports_cpp_node()
+    assert not CloudTrailSourceStage(config, '/tmp/cloudtrail/*', file_type=FileTypes.CSV).supports_cpp_node()
+
+
+@pytest.mark.use_python
+def test_post_build_single(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    source = CloudTrailSourceStage(config, '/tmp/cloudtrail/*.json')
+
+    with mock.patch('morpheus.stages.input.cloud_trail_source_stage.neos') as mock_neos:
+        source._post_build_single(mock_segment, (mock_input, typing.List[str]))
+
+        mock_neos.CloudTrailSourceStage.assert_not_called()
+
+    mock_segment.make_node_full.assert_called_once()
+    mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_cpp
+def test_post_build_single_cpp(config):
+    config.ae.userid_filter = 'user123'
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    source = CloudTrailSourceStage(config, '/tmp/cloudtrail/*.json', repeat=3)
+
+    with mock.patch('morpheus.stages.input.cloud_trail_source_stage.neos') as mock_neos:
+        source._post_build_single(mock_segment, (mock_input, typing.List[str]))
+
+        mock_neos.CloudTrailSourceStage.assert_called_once_with(mock_segment,
+                                                                source.unique_name + "-cpp",
+                                                                config.ae.userid_column_name,
+                                                                'user123',
+                                                                3,
+                                                                config.num_threads)
+
+    # The C++ node is followed by the node attaching the user to each message
+    mock_segment.make_node_full.assert_called_once()
+    assert mock_segment.make_edge.call_count == 2
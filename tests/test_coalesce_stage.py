@@ -0,0 +1,164 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+import os
+from unittest import mock
+
+import pandas as pd
+import pytest
+
+import cudf
+
+from morpheus.messages import MessageMeta
+from morpheus.messages import MultiMessage
+from morpheus.pipeline.linear_pipeline import LinearPipeline
+from morpheus.stages.general.coalesce_stage import CoalesceStage
+from morpheus.stages.input.multi_file_source_stage import MultiFileSourceStage
+from morpheus.stages.output.write_to_file_stage import WriteToFileStage
+from morpheus.stages.postprocess.serialize_stage import SerializeStage
+from morpheus.stages.preprocess.deserialize_stage import DeserializeStage
+
+
+def _make_message(start: int, count: int) -> MultiMessage:
+    # Every message starts at index 0, as each batch of a source does
+    df = cudf.DataFrame({"v": list(range(start, start + count))})
+
+    return MultiMessage(meta=MessageMeta(df), mess_offset=0, mess_count=count)
+
+
+def test_constructor(config):
+    cs = CoalesceStage(config)
+    assert cs.name == "coalesce"
+    assert cs._batch_size == config.pipeline_batch_size
+
+    # Just ensure that we get a valid non-empty tuple
+    accepted_types = cs.accepted_types()
+    assert isinstance(accepted_types, tuple)
+    assert len(accepted_types) > 0
+
+    cs = CoalesceStage(config, batch_size=10, timeout_ms=5)
+    assert cs._batch_size == 10
+    assert cs._timeout_ms == 5
+
+    pytest.raises(ValueError, CoalesceStage, config, batch_size=0)
+
+
+@pytest.mark.use_python
+def test_on_next(config):
+    cs = CoalesceStage(config, batch_size=10, timeout_ms=0)
+
+    # Small messages are held until the batch is full
+    assert cs.on_next(_make_message(0, 4)) == []
+    assert cs.on_next(_make_message(4, 4)) == []
+
+    output = cs.on_next(_make_message(8, 2))
+    assert len(output) == 1
+    assert output[0].mess_count == 10
+    assert output[0].get_meta("v").values_host.tolist() == list(range(10))
+
+    # Index labels are unique again, so every merged row is selected exactly once
+    merged_df = output[0].get_meta()
+    assert len(merged_df) == 10
+    assert merged_df.index.values_host.tolist() == list(range(10))
+    assert merged_df["v"].values_host.tolist() == list(range(10))
+
+    # A message which would overfill the batch flushes the buffer first
+    assert cs.on_next(_make_message(10, 6)) == []
+
+    output = cs.on_next(_make_message(16, 6))
+    assert len(output) == 1
+    assert output[0].mess_count == 6
+
+    # Full messages pass through untouched, after the buffered rows
+    full_message = _make_message(22, 12)
+    output = cs.on_next(full_message)
+    assert len(output) == 2
+    assert output[0].mess_count == 6
+    assert output[1] is full_message
+
+    assert cs._flush() == []
+
+
+@pytest.mark.use_python
+def test_on_next_timeout(config):
+    cs = CoalesceStage(config, batch_size=10, timeout_ms=50)
+
+    with mock.patch('morpheus.stages.general.coalesce_stage.time') as mock_time:
+        mock_time.monotonic.return_value = 1.0
+        assert cs.on_next(_make_message(0, 2)) == []
+
+        # The oldest buffered message has waited past the timeout
+        mock_time.monotonic.return_value = 1.1
+        output = cs.on_next(_make_message(2, 2))
+        assert len(output) == 1
+        assert output[0].mess_count == 2
+
+    assert len(cs._flush()) == 1
+
+
+@pytest.mark.use_python
+def test_build_single(config):
+    mock_stream = mock.MagicMock()
+    mock_segment = mock.MagicMock()
+    mock_segment.make_node.return_value = mock_stream
+    mock_input = mock.MagicMock()
+
+    cs = CoalesceStage(config)
+    cs._build_single(mock_segment, mock_input)
+
+    mock_segment.make_node_full.assert_called_once()
+    mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config):
+    mock_stream = mock.MagicMock()
+    mock_segment = mock.MagicMock()
+    mock_segment.make_node.return_value = mock_stream
+    mock_input = mock.MagicMock()
+
+    cs = CoalesceStage(config)
+    with mock.patch('morpheus.stages.general.coalesce_stage.neos') as mock_neos:
+        cs._build_single(mock_segment, mock_input)
+
+        mock_neos.CoalesceStage.assert_called_once_with(mock_segment, cs.unique_name, cs._batch_size, cs._timeout_ms)
+
+    mock_segment.make_node_full.assert_not_called()
+    mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_cpp
+def test_coalesce_cpp_new_index(tmp_path, config):
+    """
+    Every input file starts at index 0, the coalesced messages must not repeat index labels
+    """
+    out_file = os.path.join(tmp_path, 'results.csv')
+
+    for i in range(2):
+        pd.DataFrame({"v": list(range(i * 5, i * 5 + 5))}).to_csv(os.path.join(tmp_path, 'input_{}.csv'.format(i)),
+                                                                 index=False)
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(MultiFileSourceStage(config, filenames=[os.path.join(tmp_path, 'input_*.csv')]))
+    pipe.add_stage(DeserializeStage(config))
+    pipe.add_stage(CoalesceStage(config, batch_size=64, timeout_ms=0))
+    pipe.add_stage(SerializeStage(config))
+    pipe.add_stage(WriteToFileStage(config, filename=out_file, overwrite=False))
+    pipe.run()
+
+    output_df = pd.read_csv(out_file, index_col=0)
+
+    assert output_df.index.tolist() == list(range(10))
+    assert output_df["v"].tolist() == list(range(10))
@@ -102,3 +102,11 @@ def test_to_string(config):
     s = config.to_string()
     assert isinstance(s, str)
     assert isinstance(json.loads(s), dict)
+
+
+def test_output_column_types():
+    c = morpheus.config.Config()
+    assert c.output_column_types() == {}
+
+    c.output_columns = {'score': 'float32', 'flagged': 'bool', 'count': 'i8'}
+    assert c.output_column_types() == {'score': '<f4', 'flagged': '|b1', 'count': '<i8'}
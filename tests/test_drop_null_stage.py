@@ -0,0 +1,66 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+from unittest import mock
+
+import pytest
+
+from morpheus.stages.preprocess.drop_null_stage import DropNullStage
+
+
+def test_constructor(config):
+    ds = DropNullStage(config, "data")
+    assert ds.name == "dropna"
+    assert ds._column == "data"
+
+    # Just ensure that we get a valid non-empty tuple
+    accepted_types = ds.accepted_types()
+    assert isinstance(accepted_types, tuple)
+    assert len(accepted_types) > 0
+
+
+@pytest.mark.use_python
+def test_build_single(config):
+    mock_stream = mock.MagicMock()
+    mock_segment = mock.MagicMock()
+    mock_segment.make_node.return_value = mock_stream
+    mock_input = mock.MagicMock()
+
+    ds = DropNullStage(config, "data")
+    assert not ds.supports_fusion()
+
+    ds._build_single(mock_segment, mock_input)
+
+    mock_segment.make_node_full.assert_called_once()
+    mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config):
+    mock_stream = mock.MagicMock()
+    mock_segment = mock.MagicMock()
+    mock_segment.make_node.return_value = mock_stream
+    mock_input = mock.MagicMock()
+
+    ds = DropNullStage(config, "data")
+    assert ds.supports_fusion()
+
+    with mock.patch('morpheus.stages.preprocess.drop_null_stage.neos') as mock_neos:
+        ds._build_single(mock_segment, mock_input)
+
+        mock_neos.DropNullStage.assert_called_once_with(mock_segment, ds.unique_name, "data")
+
+    mock_segment.make_node_full.assert_not_called()
+    mock_segment.make_edge.assert_called_once()
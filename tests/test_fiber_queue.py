@@ -0,0 +1,162 @@
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import queue
+import threading
+import time
+
+import pytest
+
+import cudf
+
+import morpheus._lib.messages as neom
+from morpheus._lib.common import FiberQueue
+from morpheus.utils.producer_consumer_queue import Closed
+
+
+def test_put_many_get_many():
+    q = FiberQueue(8)
+
+    # A queue of size 8 holds 7 items, the rest are not put without blocking
+    assert q.put_many(range(10), block=False) == 7
+
+    assert q.get_many(5) == [0, 1, 2, 3, 4]
+    assert q.get_many(5) == [5, 6]
+
+    pytest.raises(queue.Empty, q.get_many, 5, block=False)
+    pytest.raises(queue.Empty, q.get_many, 5, timeout=0.1)
+
+
+def test_put_many_full():
+    q = FiberQueue(2)
+
+    assert q.put_many([1]) == 1
+
+    pytest.raises(queue.Full, q.put_many, [2, 3], block=False)
+    pytest.raises(queue.Full, q.put, 2, block=False)
+
+
+def test_many_across_threads():
+    q = FiberQueue(64)
+    count = 1000
+
+    def produce():
+        for start in range(0, count, 100):
+            q.put_many(list(range(start, start + 100)))
+
+        q.close()
+
+    producer = threading.Thread(target=produce)
+    producer.start()
+
+    received = []
+
+    try:
+        while True:
+            received.extend(q.get_many(32))
+    except Closed:
+        pass
+
+    producer.join()
+
+    assert received == list(range(count))
+
+
+def test_sub_second_timeout():
+    q = FiberQueue(2)
+
+    start = time.monotonic()
+    pytest.raises(queue.Empty, q.get, timeout=0.005)
+    elapsed = time.monotonic() - start
+
+    # Previously truncated to a zero second timeout, which waited forever
+    assert 0.004 <= elapsed < 1.0
+
+    q.put(1)
+    pytest.raises(queue.Full, q.put, 2, timeout=0.005)
+
+    pytest.raises(ValueError, q.get, timeout=-1)
+
+
+@pytest.mark.parametrize("timeout", [0, None])
+def test_zero_timeout_blocks(timeout):
+    q = FiberQueue(2)
+
+    def put_later():
+        time.sleep(0.05)
+        q.put(1)
+
+    producer = threading.Thread(target=put_later)
+    producer.start()
+
+    start = time.monotonic()
+
+    # Waits for the item rather than raising queue.Empty straight away
+    assert q.get(timeout=timeout) == 1
+    assert time.monotonic() - start >= 0.04
+
+    producer.join()
+
+
+def test_non_blocking():
+    q = FiberQueue(2)
+
+    start = time.monotonic()
+    pytest.raises(queue.Empty, q.get, block=False)
+    pytest.raises(queue.Empty, q.get_many, 4, block=False)
+
+    q.put(1, block=False)
+    pytest.raises(queue.Full, q.put, 2, block=False)
+    pytest.raises(queue.Full, q.put_many, [2], block=False)
+
+    # A timeout is ignored without blocking
+    pytest.raises(queue.Full, q.put, 2, block=False, timeout=0)
+
+    assert time.monotonic() - start < 1.0
+    assert q.get(block=False) == 1
+
+
+def test_close_wakes_blocked_get():
+    q = FiberQueue(2)
+
+    def close_later():
+        time.sleep(0.05)
+        q.close()
+
+    closer = threading.Thread(target=close_later)
+    closer.start()
+
+    start = time.monotonic()
+    pytest.raises(Closed, q.get)
+
+    assert time.monotonic() - start < 1.0
+
+    closer.join()
+
+
+def test_message_meta_queue():
+    q = neom.MessageMetaFiberQueue(4)
+
+    metas = [neom.MessageMeta(cudf.DataFrame({"v": [i]})) for i in range(3)]
+
+    assert q.put_many(metas) == 3
+
+    received = q.get_many(8)
+
+    assert [meta.df["v"].iloc[0] for meta in received] == [0, 1, 2]
+
+    q.close()
+
+    pytest.raises(Closed, q.get)
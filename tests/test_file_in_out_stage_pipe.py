@@ -17,12 +17,17 @@
 import os
 
 import numpy as np
+import pandas as pd
 import pytest
 
+import cudf
+
+import morpheus._lib.common as neoc
 from morpheus._lib.file_types import FileTypes
 from morpheus.io.deserializers import read_file_to_df
 from morpheus.pipeline import LinearPipeline
 from morpheus.stages.input.file_source_stage import FileSourceStage
+from morpheus.stages.input.multi_file_source_stage import MultiFileSourceStage
 from morpheus.stages.output.write_to_file_stage import WriteToFileStage
 from utils import TEST_DIRS
 
@@ -54,6 +59,242 @@ def test_file_rw_pipe(tmp_path, config, output_type):
     assert output_data.tolist() == input_data.tolist()
 
 
+@pytest.mark.parametrize("output_type", ["csv", "jsonlines"])
+@pytest.mark.parametrize("flush_policy", ["none", "flush", "fsync"])
+def test_file_rw_queued(tmp_path, config, output_type, flush_policy):
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+    out_file = os.path.join(tmp_path, 'results.{}'.format(output_type))
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file, repeat=5))
+    pipe.add_stage(
+        WriteToFileStage(config, filename=out_file, overwrite=False, queue_size=2, flush_policy=flush_policy))
+    pipe.run()
+
+    input_df = pd.read_csv(input_file)
+    output_df = read_file_to_df(out_file, file_type=FileTypes.Auto, df_type="pandas")
+
+    # Every repeat must be written, in order
+    assert len(output_df) == len(input_df) * 5
+    assert np.allclose(output_df[input_df.columns].values, np.tile(input_df.values, (5, 1)))
+
+
+@pytest.mark.parametrize("output_type", ["csv", "jsonlines"])
+@pytest.mark.parametrize("rotate_compression", [None, "gzip"])
+def test_file_rw_rotation(tmp_path, config, output_type, rotate_compression):
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+    out_file = os.path.join(tmp_path, 'results.{}'.format(output_type))
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file, repeat=5))
+    pipe.add_stage(
+        WriteToFileStage(config,
+                         filename=out_file,
+                         overwrite=False,
+                         rotate_bytes=1,
+                         rotate_compression=rotate_compression))
+    pipe.run()
+
+    input_df = pd.read_csv(input_file)
+
+    # Rotating after every byte starts a new file for every message
+    for i in range(5):
+        rotated_file = os.path.join(tmp_path, 'results.{:05d}.{}'.format(i, output_type))
+
+        if rotate_compression == "gzip":
+            assert not os.path.exists(rotated_file)
+            rotated_file += ".gz"
+
+        if output_type == "csv":
+            # Every file has its own header
+            output_df = pd.read_csv(rotated_file, index_col=0)
+        else:
+            output_df = pd.read_json(rotated_file, lines=True)
+
+        assert np.allclose(output_df[input_df.columns].values, input_df.values)
+
+    assert not os.path.exists(os.path.join(tmp_path, 'results.{:05d}.{}'.format(5, output_type)))
+
+
+@pytest.mark.use_python
+def test_file_rw_rotation_overwrite(tmp_path, config):
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+    out_file = os.path.join(tmp_path, 'results.csv')
+    rotated_file = os.path.join(tmp_path, 'results.00000.csv')
+
+    with open(rotated_file, "w") as f:
+        f.write("stale\n")
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file))
+    pipe.add_stage(WriteToFileStage(config, filename=out_file, overwrite=True, rotate_bytes=1))
+    pipe.run()
+
+    input_df = pd.read_csv(input_file)
+    output_df = pd.read_csv(rotated_file, index_col=0)
+
+    # The existing file is replaced, not appended to
+    assert np.allclose(output_df[input_df.columns].values, input_df.values)
+
+
+@pytest.mark.parametrize("input_type", ["csv", "jsonlines"])
+@pytest.mark.parametrize("chunk_bytes", [0, 256])
+@pytest.mark.parametrize("use_mmap", [False, True])
+def test_file_rw_chunked(tmp_path, config, input_type, chunk_bytes, use_mmap):
+    input_df = pd.read_csv(os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv"))
+
+    input_file = os.path.join(tmp_path, 'input.{}'.format(input_type))
+    out_file = os.path.join(tmp_path, 'results.csv')
+
+    if input_type == "csv":
+        input_df.to_csv(input_file, index=False)
+    else:
+        input_df.to_json(input_file, orient="records", lines=True)
+
+    # 256 is small enough to split the file into many chunks
+    pipe = LinearPipeline(config)
+    pipe.set_source(
+        FileSourceStage(config, filename=input_file, repeat=2, chunk_bytes=chunk_bytes, use_mmap=use_mmap))
+    pipe.add_stage(WriteToFileStage(config, filename=out_file, overwrite=False))
+    pipe.run()
+
+    output_df = pd.read_csv(out_file, index_col=0)
+
+    # The index continues across chunks and repeats
+    assert output_df.index.tolist() == list(range(len(input_df) * 2))
+    assert np.allclose(output_df[input_df.columns].values, np.tile(input_df.values, (2, 1)))
+
+
+@pytest.mark.parametrize("prefetch", [1, 3])
+def test_file_rw_multi_file(tmp_path, config, prefetch):
+    input_df = pd.read_csv(os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv"))
+    out_file = os.path.join(tmp_path, 'results.csv')
+
+    parts = np.array_split(input_df, 5)
+
+    for (i, part) in enumerate(parts):
+        part.to_csv(os.path.join(tmp_path, 'input_{}.csv'.format(i)), index=False)
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(MultiFileSourceStage(config, filenames=[os.path.join(tmp_path, 'input_*.csv')], prefetch=prefetch))
+    pipe.add_stage(WriteToFileStage(config, filename=out_file, overwrite=False))
+    pipe.run()
+
+    output_df = pd.read_csv(out_file, index_col=0)
+
+    # Every file keeps its own index, files are emitted in sorted order
+    assert output_df.index.tolist() == [i for part in parts for i in range(len(part))]
+    assert np.allclose(output_df[input_df.columns].values, input_df.values)
+
+
+def test_multi_file_no_match(tmp_path, config):
+    with pytest.raises(ValueError):
+        MultiFileSourceStage(config, filenames=[os.path.join(tmp_path, 'missing_*.csv')])
+
+
+def test_file_rw_json_escaping(tmp_path, config):
+    """
+    Strings which need escaping and missing values must round trip through the JSON writer
+    """
+    input_file = os.path.join(tmp_path, 'input.csv')
+    out_file = os.path.join(tmp_path, 'results.jsonlines')
+
+    expected = pd.DataFrame({
+        "text": ['plain', 'with "quotes"', 'back\\slash', 'tab\tand/slash', None],
+        "score": [0.5, np.nan, 1.25, -2.0, 3.5],
+        "count": [1, 2, 3, 4, 5],
+        "flag": [True, False, True, False, True],
+    })
+    expected.to_csv(input_file, index=False)
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file))
+    pipe.add_stage(WriteToFileStage(config, filename=out_file, overwrite=False))
+    pipe.run()
+
+    with open(out_file) as fh:
+        lines = [line for line in fh.read().split("\n") if len(line) > 0]
+
+    assert len(lines) == len(expected)
+
+    output = pd.read_json(out_file, lines=True)
+
+    assert output["text"].tolist()[:-1] == expected["text"].tolist()[:-1]
+    assert pd.isna(output["text"].iloc[-1])
+    assert np.allclose(output["score"].values, expected["score"].values, equal_nan=True)
+    assert output["count"].tolist() == expected["count"].tolist()
+    assert output["flag"].tolist() == expected["flag"].tolist()
+
+
+@pytest.mark.parametrize("output_type, compression", [("parquet", None), ("parquet", "none"), ("orc", "snappy"),
+                                                     ("arrow", None), ("arrow", "lz4")])
+def test_file_rw_columnar(tmp_path, config, output_type, compression):
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+    out_file = os.path.join(tmp_path, 'results.{}'.format(output_type))
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file))
+    pipe.add_stage(WriteToFileStage(config, filename=out_file, overwrite=False, compression=compression))
+    pipe.run()
+
+    assert os.path.exists(out_file)
+
+    input_df = pd.read_csv(input_file)
+
+    if output_type == "parquet":
+        output_df = pd.read_parquet(out_file)
+    elif output_type == "orc":
+        output_df = pd.read_orc(out_file)
+    else:
+        import pyarrow.feather
+        output_df = pyarrow.feather.read_table(out_file).to_pandas()
+
+    # The index is not written to columnar files
+    assert list(output_df.columns) == list(input_df.columns)
+    assert np.allclose(output_df.values, input_df.values)
+
+
+def test_file_rw_compression_rejected(tmp_path, config):
+    out_file = os.path.join(tmp_path, 'results.csv')
+
+    with pytest.raises(ValueError):
+        WriteToFileStage(config, filename=out_file, overwrite=False, compression="snappy")
+
+    with pytest.raises(ValueError):
+        WriteToFileStage(config, filename=out_file, overwrite=False, compression="gzip", rotate_compression="gzip")
+
+
+@pytest.mark.use_cpp
+@pytest.mark.skipif(not neoc.gpu_compression_available, reason="Morpheus was built without nvCOMP")
+@pytest.mark.parametrize("output_type", ["csv", "jsonlines"])
+@pytest.mark.parametrize("queue_size", [0, 4])
+def test_file_rw_gpu_compression(tmp_path, config, output_type, queue_size):
+    input_file = os.path.join(TEST_DIRS.tests_data_dir, "filter_probs.csv")
+    out_file = os.path.join(tmp_path, 'results.{}.gz'.format(output_type))
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file, repeat=2))
+    pipe.add_stage(
+        WriteToFileStage(config,
+                         filename=out_file,
+                         overwrite=False,
+                         file_type=FileTypes.CSV if output_type == "csv" else FileTypes.JSON,
+                         compression="gzip",
+                         queue_size=queue_size))
+    pipe.run()
+
+    input_df = pd.read_csv(input_file)
+    expected = np.concatenate([input_df.values, input_df.values])
+
+    # Every message is appended as its own gzip members
+    if output_type == "csv":
+        output_df = pd.read_csv(out_file, index_col=0)
+    else:
+        output_df = pd.read_json(out_file, lines=True)
+
+    assert np.allclose(output_df[input_df.columns].values, expected)
+
+
 @pytest.mark.use_python
 @pytest.mark.usefixtures("chdir_tmpdir")
 def test_to_file_no_path(tmp_path, config):
@@ -72,3 +313,32 @@ def test_to_file_no_path(tmp_path, config):
     pipe.run()
 
     assert os.path.exists(tmp_path / out_file)
+
+
+@pytest.mark.use_cpp
+def test_file_rw_json_matches_pandas(tmp_path, config):
+    """
+    The C++ JSON lines writer must write byte for byte what `DataFrame.to_json` does, floats included
+    """
+    input_file = os.path.join(tmp_path, 'input.csv')
+    out_file = os.path.join(tmp_path, 'results.jsonlines')
+
+    pd.DataFrame({
+        "score": [0.1, 1.0, 0.0, -2.5, 0.3333333333333, 2.0 / 3.0, 12345678.9, 1e20, 1.5e-20, 1e-12, np.nan],
+        "count": list(range(-5, 6)),
+        "text": ['plain', 'with "quotes"', 'back\\slash', 'a/b', 'tab\t', None, '', 'x', 'y', 'z', 'end'],
+    }).to_csv(input_file, index=False)
+
+    pipe = LinearPipeline(config)
+    pipe.set_source(FileSourceStage(config, filename=input_file))
+    pipe.add_stage(WriteToFileStage(config, filename=out_file, overwrite=False))
+    pipe.run()
+
+    # Read the same way the source does, so both sides format the same doubles
+    expected = cudf.read_csv(input_file).to_pandas().to_json(orient="records", lines=True)
+
+    if (not expected.endswith("\n")):
+        expected += "\n"
+
+    with open(out_file) as fh:
+        assert fh.read() == expected
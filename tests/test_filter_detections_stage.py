@@ -106,3 +106,31 @@ def test_build_single(config):
 
     mock_segment.make_node_full.assert_called_once()
     mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_python
+def test_filter_copy(config):
+    fds = FilterDetectionsStage(config, threshold=0.5, copy=True)
+
+    mock_message = mock.MagicMock()
+    mock_message.mess_offset = 8
+    mock_message.probs = cp.array([[0.1, 0.5, 0.3], [0.2, 0.3, 0.4]])
+
+    # All values are below the threshold
+    assert fds.filter_copy(mock_message) == []
+
+    # Two non-adjacent rows have a value above the threashold, they end up in a single message
+    mock_message.probs = cp.array([
+        [0.2, 0.4, 0.3],
+        [0.1, 0.5, 0.8],
+        [0.2, 0.4, 0.3],
+        [0.1, 0.9, 0.2],
+    ])
+
+    output_list = fds.filter_copy(mock_message)
+    assert len(output_list) == 1
+    assert output_list[0].offset == 0
+    assert output_list[0].mess_offset == 0
+    assert output_list[0].mess_count == 2
+    assert output_list[0].count == 2
+    assert cp.all(output_list[0].memory.probs == cp.array([[0.1, 0.5, 0.8], [0.1, 0.9, 0.2]]))
@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+import json
+import math
+
+import cupy as cp
+import pytest
+
+from morpheus.stages.inference.forest_inference_stage import ForestInferenceStage
+from morpheus.stages.inference.forest_inference_stage import ForestModel
+
+
+def _make_tree(feature: int, threshold: float, left_value: float, right_value: float, default_left: bool) -> dict:
+    # A single split on `feature` with two leaves
+    return {
+        "left_children": [1, -1, -1],
+        "right_children": [2, -1, -1],
+        "split_indices": [feature, 0, 0],
+        "split_conditions": [threshold, left_value, right_value],
+        "default_left": [int(default_left), 0, 0],
+    }
+
+
+def _write_model(tmp_path, objective: str, trees: list, tree_info: list, num_class: int = 0) -> str:
+    model = {
+        "learner": {
+            "gradient_booster": {
+                "name": "gbtree", "model": {
+                    "trees": trees, "tree_info": tree_info
+                }
+            },
+            "learner_model_param": {
+                "base_score": "5E-1", "num_class": str(num_class), "num_feature": "2"
+            },
+            "objective": {
+                "name": objective
+            },
+        }
+    }
+
+    filename = str(tmp_path / "model.json")
+
+    with open(filename, "w") as f:
+        json.dump(model, f)
+
+    return filename
+
+
+def _sigmoid(x: float) -> float:
+    return 1.0 / (1.0 + math.exp(-x))
+
+
+def test_constructor(config, tmp_path):
+    model_filename = _write_model(tmp_path, "binary:logistic", [_make_tree(0, 1.0, -1.0, 1.0, True)], [0])
+
+    stage = ForestInferenceStage(config, model_filename=model_filename)
+    assert stage._model_filename == model_filename
+    assert stage.supports_cpp_node()
+
+
+def test_binary_logistic(tmp_path):
+    trees = [_make_tree(0, 1.0, -1.0, 1.0, True), _make_tree(1, 0.0, 0.5, -0.5, False)]
+    model = ForestModel(_write_model(tmp_path, "binary:logistic", trees, [0, 0]))
+
+    assert model.num_features == 2
+    assert model.num_outputs == 1
+
+    inputs = cp.array([[0.0, -1.0], [2.0, 1.0], [float("nan"), float("nan")]], dtype=cp.float32)
+    probs = model.predict(inputs).get()
+
+    assert probs.shape == (3, 1)
+
+    # A base score of 0.5 is a margin of 0, NaN follows the default direction of each split
+    expected = [_sigmoid(-1.0 + 0.5), _sigmoid(1.0 - 0.5), _sigmoid(-1.0 - 0.5)]
+    assert probs[:, 0].tolist() == pytest.approx(expected, rel=1e-5)
+
+
+def test_multi_softprob(tmp_path):
+    trees = [_make_tree(0, 1.0, 2.0, 0.0, True), _make_tree(0, 1.0, 0.0, 2.0, True)]
+    model = ForestModel(_write_model(tmp_path, "multi:softprob", trees, [0, 1], num_class=2))
+
+    assert model.num_outputs == 2
+
+    probs = model.predict(cp.array([[0.0, 0.0], [5.0, 0.0]], dtype=cp.float32)).get()
+
+    low = math.exp(0.0) / (math.exp(0.0) + math.exp(2.0))
+    assert probs.tolist() == [pytest.approx([1.0 - low, low], rel=1e-5), pytest.approx([low, 1.0 - low], rel=1e-5)]
+
+
+def test_unsupported_objective(tmp_path):
+    model_filename = _write_model(tmp_path, "rank:pairwise", [_make_tree(0, 1.0, -1.0, 1.0, True)], [0])
+
+    pytest.raises(ValueError, ForestModel, model_filename)
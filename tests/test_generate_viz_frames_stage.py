@@ -0,0 +1,65 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+from unittest import mock
+
+import pytest
+
+from morpheus.messages import MultiResponseProbsMessage
+from morpheus.stages.postprocess.generate_viz_frames_stage import GenerateVizFramesStage
+
+
+def test_constructor(config, tmp_path):
+    out_dir = str(tmp_path / 'viz_frames')
+
+    stage = GenerateVizFramesStage(config, out_dir=out_dir)
+    assert stage.name == "gen_viz"
+    assert stage.accepted_types() == (MultiResponseProbsMessage, )
+    assert not stage.supports_cpp_node()
+
+    assert GenerateVizFramesStage(config, out_dir=out_dir, frame_type='arrow').supports_cpp_node()
+
+    pytest.raises(ValueError, GenerateVizFramesStage, config, out_dir=out_dir, frame_type='json')
+    pytest.raises(ValueError, GenerateVizFramesStage, config, out_dir=out_dir, out_socket='localhost:9000')
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config, tmp_path):
+    out_dir = str(tmp_path / 'viz_frames')
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = GenerateVizFramesStage(config, out_dir=out_dir, frame_type='arrow', out_socket='localhost:9000')
+
+    with mock.patch('morpheus.stages.postprocess.generate_viz_frames_stage.neos') as mock_neos:
+        stage._build_single(mock_segment, (mock_input, MultiResponseProbsMessage))
+
+        mock_neos.GenerateVizFramesStage.assert_called_once_with(mock_segment,
+                                                                 stage.unique_name,
+                                                                 out_dir,
+                                                                 'localhost:9000',
+                                                                 GenerateVizFramesStage.LABELS)
+
+    mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_python
+def test_build_single_socket_requires_cpp(config, tmp_path):
+    stage = GenerateVizFramesStage(config,
+                                   out_dir=str(tmp_path / 'viz_frames'),
+                                   frame_type='arrow',
+                                   out_socket='localhost:9000')
+
+    pytest.raises(RuntimeError, stage._build_single, mock.MagicMock(), (mock.MagicMock(), MultiResponseProbsMessage))
@@ -21,6 +21,7 @@ import pytest
 
 import cudf
 
+from morpheus.messages import MessageMeta
 from morpheus.messages import MultiMessage
 from morpheus.stages.general.monitor_stage import MonitorStage
 
@@ -114,6 +115,50 @@ def test_build_single(mock_morph_tqdm, config):
     mock_morph_tqdm.stop.assert_called_once()
 
 
+@pytest.mark.use_cpp
+@pytest.mark.parametrize("in_type, cpp_class", [(MessageMeta, "MonitorMessageMetaStage"),
+                                                (MultiMessage, "MonitorMultiMessageStage")])
+@mock.patch('morpheus.stages.general.monitor_stage.MorpheusTqdm')
+def test_build_single_cpp(mock_morph_tqdm, config, in_type, cpp_class):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    m = MonitorStage(config, description="Test Description", unit="rows", log_interval_ms=500)
+
+    with mock.patch('morpheus.stages.general.monitor_stage.neos') as mock_neos:
+        stream, out_type = m._build_single(mock_segment, (mock_input, in_type))
+
+        getattr(mock_neos, cpp_class).assert_called_once_with(mock_segment,
+                                                              m.unique_name,
+                                                              "Test Description",
+                                                              "rows",
+                                                              500)
+        assert stream is getattr(mock_neos, cpp_class).return_value
+
+    assert out_type is in_type
+    mock_segment.make_sink.assert_not_called()
+    mock_segment.make_edge.assert_called_once_with(mock_input, stream)
+
+    # The C++ node replaces the progress bar
+    m.on_start()
+    mock_morph_tqdm.assert_not_called()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp_count_fn(config):
+    mock_segment = mock.MagicMock()
+
+    # A custom count function can only run in python
+    m = MonitorStage(config, determine_count_fn=lambda x: 1)
+
+    with mock.patch('morpheus.stages.general.monitor_stage.neos') as mock_neos:
+        m._build_single(mock_segment, (mock.MagicMock(), MessageMeta))
+
+        mock_neos.MonitorMessageMetaStage.assert_not_called()
+
+    mock_segment.make_sink.assert_called_once()
+
+
 def test_auto_count_fn(config):
     m = MonitorStage(config)
 
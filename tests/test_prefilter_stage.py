@@ -0,0 +1,114 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+from unittest import mock
+
+import pytest
+
+from morpheus.stages.general.prefilter_merge_stage import PrefilterMergeStage
+from morpheus.stages.general.prefilter_stage import PrefilterStage
+
+
+def test_constructor(config):
+    config.class_labels = ["si_password", "si_email"]
+
+    stage = PrefilterStage(config, column="data", patterns=["^GET /health"], literals=["heartbeat"])
+    assert stage.name == "prefilter"
+    assert stage._column == "data"
+    assert stage._patterns == ["^GET /health"]
+    assert stage._literals == ["heartbeat"]
+    assert stage._label_columns == ["si_password", "si_email"]
+    assert stage._merge_stage is None
+    assert stage.benign_count == 0
+
+    # Just ensure that we get a valid non-empty tuple
+    accepted_types = stage.accepted_types()
+    assert isinstance(accepted_types, tuple)
+    assert len(accepted_types) > 0
+
+    stage = PrefilterStage(config, column="data", literals=["heartbeat"], label_columns=["benign"])
+    assert stage._patterns == []
+    assert stage._label_columns == ["benign"]
+
+    pytest.raises(ValueError, PrefilterStage, config, column="data")
+
+    merge = PrefilterMergeStage(config, stage)
+    assert merge.name == "prefilter-merge"
+    assert stage._merge_stage is merge
+
+    # Only merged back once
+    pytest.raises(ValueError, PrefilterMergeStage, config, stage)
+
+
+@pytest.mark.use_python
+def test_build_single(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = PrefilterStage(config, column="data", patterns=["health"])
+    pytest.raises(NotImplementedError, stage._build_single, mock_segment, mock_input)
+
+    merge = PrefilterMergeStage(config, stage)
+    pytest.raises(NotImplementedError, merge._build_single, mock_segment, mock_input)
+
+    mock_segment.make_edge.assert_not_called()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = PrefilterStage(config, column="data", patterns=["health"], label_columns=["benign"])
+
+    with mock.patch('morpheus.stages.general.prefilter_stage.neos') as mock_neos:
+        mock_neos.PrefilterStage.return_value.benign_count = 5
+
+        # Without a merge stage the matched rows are dropped
+        stage._build_single(mock_segment, mock_input)
+
+        mock_neos.PrefilterStage.assert_called_once_with(mock_segment,
+                                                         stage.unique_name,
+                                                         "data", ["health"], [], ["benign"],
+                                                         False,
+                                                         config.edge_buffer_size)
+
+    mock_segment.make_edge.assert_called_once()
+    assert stage.benign_count == 5
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp_merge(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = PrefilterStage(config, column="data", literals=["heartbeat"])
+    merge = PrefilterMergeStage(config, stage)
+
+    # The prefilter must be built first
+    pytest.raises(RuntimeError, merge._build_single, mock_segment, mock_input)
+
+    with mock.patch('morpheus.stages.general.prefilter_stage.neos') as mock_neos:
+        stage._build_single(mock_segment, mock_input)
+
+        assert mock_neos.PrefilterStage.call_args[0][6] is True
+        mock_prefilter = mock_neos.PrefilterStage.return_value
+
+    with mock.patch('morpheus.stages.general.prefilter_merge_stage.neos') as mock_neos:
+        merge._build_single(mock_segment, mock_input)
+
+        mock_neos.PrefilterMergeStage.assert_called_once_with(mock_segment, merge.unique_name, mock_prefilter)
+
+    assert mock_segment.make_edge.call_count == 2
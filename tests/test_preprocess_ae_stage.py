@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+import json
+import os
+from unittest import mock
+
+import pytest
+
+from morpheus.config import ConfigAutoEncoder
+from morpheus.messages import MultiInferenceMessage
+from morpheus.stages.preprocess.preprocess_ae_stage import PreprocessAEStage
+
+
+def _write_scaling_file(tmp_path) -> str:
+    scaling_file = os.path.join(tmp_path, "scaling.json")
+
+    features = {"a": {"mean": 2.0, "std": 0.5}, "b": {"min": 10, "max": 30}, "c": {"min": 1, "max": 1}}
+
+    with open(scaling_file, "w", encoding='UTF-8') as f:
+        json.dump({"features": features}, f)
+
+    return scaling_file
+
+
+def test_constructor(config):
+    config.ae = ConfigAutoEncoder()
+    config.ae.feature_columns = ["a", "b"]
+
+    ps = PreprocessAEStage(config)
+    assert ps.name == "preprocess-ae"
+    assert not ps.supports_cpp_node()
+
+    # Just ensure that we get a valid non-empty tuple
+    accepted_types = ps.accepted_types()
+    assert isinstance(accepted_types, tuple)
+    assert len(accepted_types) > 0
+
+
+def test_load_scaling(config, tmp_path):
+    config.ae = ConfigAutoEncoder()
+    config.ae.feature_columns = ["a", "b", "c", "d"]
+
+    ps = PreprocessAEStage(config, scaling_file=_write_scaling_file(tmp_path))
+    assert ps.supports_cpp_node()
+
+    # Constant features are only shifted, features without statistics are left as they are
+    assert ps._shift.tolist() == [2.0, 10.0, 1.0, 0.0]
+    assert ps._scale.tolist() == pytest.approx([2.0, 0.05, 1.0, 1.0])
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config, tmp_path):
+    config.ae = ConfigAutoEncoder()
+    config.ae.feature_columns = ["a", "b"]
+
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    scaling_file = _write_scaling_file(tmp_path)
+    ps = PreprocessAEStage(config, scaling_file=scaling_file)
+
+    with mock.patch('morpheus.stages.preprocess.preprocess_ae_stage.neos') as mock_neos:
+        (_, out_type) = ps._build_single(mock_segment, mock_input)
+
+        mock_neos.PreprocessAEStage.assert_called_once_with(mock_segment, ps.unique_name, ["a", "b"], scaling_file)
+
+    assert out_type is MultiInferenceMessage
+    mock_segment.make_node.assert_not_called()
+    mock_segment.make_edge.assert_called_once()
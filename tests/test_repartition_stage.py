@@ -0,0 +1,80 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+from unittest import mock
+
+import pytest
+
+from morpheus.messages import MultiMessage
+from morpheus.stages.general.repartition_stage import RepartitionStage
+
+
+def test_constructor(config):
+    stage = RepartitionStage(config, key_column="userid", num_shards=4)
+    assert stage.name == "repartition"
+    assert stage._key_column == "userid"
+    assert stage._num_shards == 4
+    assert stage._shard_queue_size == config.edge_buffer_size
+
+    # One output port per shard
+    assert len(stage.input_ports) == 1
+    assert len(stage.output_ports) == 4
+
+    # Just ensure that we get a valid non-empty tuple
+    accepted_types = stage.accepted_types()
+    assert isinstance(accepted_types, tuple)
+    assert len(accepted_types) > 0
+
+    stage = RepartitionStage(config, key_column="userid", num_shards=2, shard_queue_size=8)
+    assert stage._shard_queue_size == 8
+
+    pytest.raises(ValueError, RepartitionStage, config, key_column="userid", num_shards=0)
+    pytest.raises(ValueError, RepartitionStage, config, key_column="userid", num_shards=2, shard_queue_size=6)
+
+
+@pytest.mark.use_python
+def test_build(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = RepartitionStage(config, key_column="userid", num_shards=2)
+    pytest.raises(NotImplementedError, stage._build, mock_segment, [(mock_input, MultiMessage)])
+
+    mock_segment.make_edge.assert_not_called()
+
+
+@pytest.mark.use_cpp
+def test_build_cpp(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = RepartitionStage(config, key_column="userid", num_shards=3, shard_queue_size=4)
+
+    with mock.patch('morpheus.stages.general.repartition_stage.neos') as mock_neos:
+        out_pairs = stage._build(mock_segment, [(mock_input, MultiMessage)])
+
+        mock_neos.RepartitionStage.assert_called_once_with(mock_segment, stage.unique_name, "userid", 3, 4)
+
+        mock_stage = mock_neos.RepartitionStage.return_value
+        mock_neos.RepartitionShardSource.assert_has_calls([
+            mock.call(mock_segment, "{}-shard-1".format(stage.unique_name), mock_stage, 1),
+            mock.call(mock_segment, "{}-shard-2".format(stage.unique_name), mock_stage, 2)
+        ])
+
+    mock_segment.make_edge.assert_called_once_with(mock_input, mock_stage)
+
+    assert len(out_pairs) == 3
+    assert out_pairs[0] == (mock_stage, MultiMessage)
+    assert all(out_type is MultiMessage for (_, out_type) in out_pairs)
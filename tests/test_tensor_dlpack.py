@@ -0,0 +1,64 @@
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import cupy as cp
+
+import morpheus._lib.messages as neom
+from morpheus._lib.common import Tensor
+
+
+def test_response_memory_round_trip():
+    probs = cp.arange(12, dtype=cp.float32).reshape(4, 3)
+    memory = neom.ResponseMemoryProbs(4, probs)
+
+    result = memory.probs
+    assert result.dtype == cp.float32
+    assert result.shape == (4, 3)
+    cp.testing.assert_array_equal(result, probs)
+
+    # Exported without a copy, both views share the tensor's memory
+    assert memory.probs.data.ptr == result.data.ptr
+
+
+def test_strided_input():
+    probs = cp.arange(24, dtype=cp.float32).reshape(4, 6)[:, ::2]
+    memory = neom.ResponseMemoryProbs(4, probs)
+
+    cp.testing.assert_array_equal(memory.probs, probs)
+
+
+def test_half_precision():
+    probs = cp.linspace(0, 1, 8, dtype=cp.float16).reshape(4, 2)
+    memory = neom.ResponseMemoryProbs(4, probs)
+
+    assert memory.probs.dtype == cp.float16
+    cp.testing.assert_array_equal(memory.probs, probs)
+
+
+def test_bool_keeps_dtype():
+    labels = cp.array([[True, False], [False, True]])
+    memory = neom.ResponseMemoryProbs(2, labels)
+
+    assert memory.probs.dtype == cp.bool_
+    cp.testing.assert_array_equal(memory.probs, labels)
+
+
+def test_tensor_dlpack_protocol():
+    tensor = Tensor.from_dlpack(cp.arange(6, dtype=cp.int64).reshape(2, 3).toDlpack())
+
+    device_type, _ = tensor.__dlpack_device__()
+    assert device_type == 2  # kDLCUDA
+
+    cp.testing.assert_array_equal(cp.fromDlpack(tensor.__dlpack__()), cp.arange(6, dtype=cp.int64).reshape(2, 3))
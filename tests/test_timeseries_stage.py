@@ -0,0 +1,89 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+from unittest import mock
+
+import pytest
+
+from morpheus.config import ConfigAutoEncoder
+from morpheus.messages import MultiResponseAEMessage
+from morpheus.messages import MultiResponseMessage
+from morpheus.stages.postprocess.timeseries_stage import TimeSeriesStage
+
+
+def _make_stage(config):
+    config.ae = ConfigAutoEncoder()
+    config.ae.userid_column_name = "user"
+
+    return TimeSeriesStage(config,
+                           resolution="10m",
+                           min_window="1h",
+                           hot_start=False,
+                           cold_end=True,
+                           filter_percent=90.0,
+                           zscore_threshold=8.0)
+
+
+@pytest.mark.use_python
+def test_build_single(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = _make_stage(config)
+    stage._build_single(mock_segment, (mock_input, MultiResponseMessage))
+
+    mock_segment.make_node_full.assert_called_once()
+    mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = _make_stage(config)
+    assert stage.supports_cpp_node()
+
+    with mock.patch('morpheus.stages.postprocess.timeseries_stage.neos') as mock_neos:
+        stage._build_single(mock_segment, (mock_input, MultiResponseMessage))
+
+        mock_neos.TimeSeriesStage.assert_called_once_with(mock_segment,
+                                                          stage.unique_name,
+                                                          600,
+                                                          3600.0,
+                                                          False,
+                                                          True,
+                                                          90.0,
+                                                          8.0,
+                                                          "user")
+
+    mock_segment.make_node_full.assert_not_called()
+    mock_segment.make_edge.assert_called_once()
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp_ae_message(config):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+
+    stage = _make_stage(config)
+
+    # The user id of `MultiResponseAEMessage` is only available in python
+    with mock.patch('morpheus.stages.postprocess.timeseries_stage.neos') as mock_neos:
+        stage._build_single(mock_segment, (mock_input, MultiResponseAEMessage))
+
+        mock_neos.TimeSeriesStage.assert_not_called()
+
+    mock_segment.make_node_full.assert_called_once()
@@ -0,0 +1,79 @@
+#!/usr/bin/env python
+# SPDX-FileCopyrightText: Copyright (c) 2022 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+
+import os
+from unittest import mock
+
+import pytest
+
+from morpheus.stages.postprocess.validation_stage import ValidationStage
+
+
+def test_constructor(config, tmp_path):
+    results_file_name = os.path.join(tmp_path, 'results.json')
+
+    vs = ValidationStage(config, val_file_name="val.csv", results_file_name=results_file_name, index_col="ID")
+    assert vs.name == "validation"
+    assert vs._index_col == "ID"
+    assert vs._max_mismatch_samples == 20
+
+    # Just ensure that we get a valid non-empty tuple
+    accepted_types = vs.accepted_types()
+    assert isinstance(accepted_types, tuple)
+    assert len(accepted_types) > 0
+
+
+def test_constructor_results_exist(config, tmp_path):
+    results_file_name = os.path.join(tmp_path, 'results.json')
+
+    with open(results_file_name, 'w') as f:
+        f.write("{}")
+
+    with pytest.raises(FileExistsError):
+        ValidationStage(config, val_file_name="val.csv", results_file_name=results_file_name)
+
+    ValidationStage(config, val_file_name="val.csv", results_file_name=results_file_name, overwrite=True)
+    assert not os.path.exists(results_file_name)
+
+
+@pytest.mark.use_cpp
+def test_build_single_cpp(config, tmp_path):
+    mock_segment = mock.MagicMock()
+    mock_input = mock.MagicMock()
+    results_file_name = os.path.join(tmp_path, 'results.json')
+
+    vs = ValidationStage(config,
+                         val_file_name="val.csv",
+                         results_file_name=results_file_name,
+                         include=['^v'],
+                         abs_tol=0.1,
+                         rel_tol=0.2,
+                         max_mismatch_samples=5)
+
+    with mock.patch('morpheus.stages.postprocess.validation_stage.neos') as mock_neos:
+        node, _ = vs._build_single(mock_segment, (mock_input, mock.MagicMock()))
+
+        mock_neos.ValidationStage.assert_called_once_with(mock_segment,
+                                                          vs.unique_name,
+                                                          "val.csv",
+                                                          results_file_name, ['^v'], [r'^ID$', r'^_ts_'],
+                                                          "",
+                                                          0.1,
+                                                          0.2,
+                                                          5)
+
+    assert node is mock_neos.ValidationStage.return_value
+    mock_segment.make_node_full.assert_not_called()
+    mock_segment.make_edge.assert_called_once_with(mock_input, node)